@@ -0,0 +1,138 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "games/bullet_vm.h"
+
+// Boss bullet-pattern throughput. Every built-in pattern plus two stress
+// scripts is compiled once, then stepped by many emitters at once: the
+// report gives the cost of one pattern-frame, how many patterns fit in a
+// 33 ms game frame, bullets spawned per millisecond of interpreter time,
+// and the cost of moving a full pool. A script that loops without waiting
+// must stay bounded by the per-frame instruction budget.
+
+#define EMITTERS 64
+#define FRAMES 20000
+#define FRAME_BUDGET_NS 33000000.0
+
+static BulletField field;
+static BulletVm vms[EMITTERS];
+
+static double elapsed_ns(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// Returns the worst single pattern-frame in nanoseconds
+static double run(const char* name, const BulletProgram* program) {
+    struct timespec start, end, step_start, step_end;
+    long long spawned = 0;
+    double worst = 0;
+
+    bullet_field_init(&field, 80, 24);
+    for (int i = 0; i < EMITTERS; i++) {
+        bullet_vm_start(&vms[i], program, 10 + i % 60, 4 + i % 4);
+        vms[i].aspect = 2 << BULLET_FIX_SHIFT;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        int target = 10 + frame % 60;
+        for (int i = 0; i < EMITTERS; i++) {
+            if ((frame & 1023) == 0 && i == 0) {
+                clock_gettime(CLOCK_MONOTONIC, &step_start);
+                spawned += bullet_vm_step(&vms[i], &field, target, 21);
+                clock_gettime(CLOCK_MONOTONIC, &step_end);
+                double ns = elapsed_ns(step_start, step_end);
+                if (ns > worst) worst = ns;
+            } else {
+                spawned += bullet_vm_step(&vms[i], &field, target, 21);
+            }
+            if (field.count > BULLET_FIELD_MAX - 1024) field.count = 0;    // Keep room to spawn
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double per_step = elapsed_ns(start, end) / ((double)FRAMES * EMITTERS);
+    printf("%-10s %4d B  %7.1f ns/pattern  %10.0f patterns/frame  %8.0f bullets/ms  worst %6.1f us\n",
+           name, program->length, per_step, FRAME_BUDGET_NS / per_step,
+           spawned / (elapsed_ns(start, end) / 1e6), worst / 1000.0);
+    return worst;
+}
+
+int main(void) {
+    static BulletProgram program;
+    static const char* const firehose =
+        "loop\n"
+        "  ring 64 1\n"
+        "  turn 3\n"
+        "  wait 1\n"
+        "end\n";
+    static const char* const runaway =     // Never waits: cut off by the budget
+        "loop\n"
+        "  fire 255 360 2\n"
+        "end\n";
+    static const struct {
+        const char* source;
+        int line;
+    } broken[] = {
+        {"fire 3 40\n", 1},
+        {"loop\n  wait 1\n", 2},
+        {"repeat 2\n  wait 1\nend\nend\n", 4},
+        {"aim\nspin 10\n", 2},
+    };
+    struct timespec start, end;
+    int failures = 0;
+    double worst = 0;
+
+    printf("Bullet patterns, %d emitters x %d frames\n", EMITTERS, FRAMES);
+    for (int i = 0; i < bullet_pattern_count; i++) {
+        if (!bullet_program_compile(&program, bullet_patterns[i].source)) {
+            printf("%s: %s\n", bullet_patterns[i].name, program.error);
+            return 1;
+        }
+        double ns = run(bullet_patterns[i].name, &program);
+        if (ns > worst) worst = ns;
+    }
+    bullet_program_compile(&program, firehose);
+    double ns = run("firehose", &program);
+    if (ns > worst) worst = ns;
+    bullet_program_compile(&program, runaway);
+    ns = run("runaway", &program);
+    if (ns > worst) worst = ns;
+
+    // Moving a full pool: every bullet stays on a large field
+    bullet_field_init(&field, 30000, 30000);
+    for (int i = 0; i < BULLET_FIELD_MAX; i++) {
+        field.x[i] = field.y[i] = 15000 << BULLET_FIX_SHIFT;
+        field.vx[i] = (i % 7) - 3;
+        field.vy[i] = (i % 5) - 2;
+    }
+    field.count = BULLET_FIELD_MAX;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int frame = 0; frame < FRAMES; frame++) bullet_field_step(&field);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double move_ns = elapsed_ns(start, end) / FRAMES;
+    printf("field      %d bullets moved and culled in %.1f us per frame\n", BULLET_FIELD_MAX, move_ns / 1000.0);
+
+    printf("Checks\n");
+    for (size_t i = 0; i < sizeof(broken) / sizeof(broken[0]); i++) {
+        char expected[16], label[160];
+        snprintf(expected, sizeof(expected), "line %d:", broken[i].line);
+        int rejected = !bullet_program_compile(&program, broken[i].source) &&
+                       strncmp(program.error, expected, strlen(expected)) == 0;
+        snprintf(label, sizeof(label), "rejects bad script (%s)", rejected ? program.error : "accepted");
+        failures += check(label, rejected);
+    }
+    failures += check("worst pattern-frame under 1% of a 33 ms frame", worst < FRAME_BUDGET_NS / 100);
+    failures += check("full pool update under 1% of a 33 ms frame", move_ns < FRAME_BUDGET_NS / 100);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "games/coroutine.h"
+#include "games/games.h"
+
+// Hosting many sessions on a few threads. 10,000 Guess the Number rounds
+// are spread over a handful of loops, each on its own thread, and played
+// by bots that read the hints and binary-search the number, answering
+// from the output callback. Then 10,000 sessions that only yield, and
+// 10,000 that sleep 1 ms at a time, measure the bare resume and timer
+// costs. Input addressed to a finished session must not reach the next
+// one in its slot, and each round's number must come from its own seed
+// whichever loop thread plays it. For scale, a thread handoff through a condition variable is
+// timed too, along with the stack each thread would reserve.
+
+#define SESSIONS 10000
+#define LOOPS 4
+#define YIELDS 1000
+#define NAPS 20
+
+typedef struct {
+    CoLoop* loop;
+    int low, high, guess;
+    int won, finished;
+} Bot;
+
+typedef struct {
+    int remaining;
+} Counter;
+
+static Bot bots[SESSIONS];
+static CoLoop* loops[LOOPS];
+
+// guess_number.c's menu uses this from main.c, which is not linked here
+void clear_input_buffer(void) {
+}
+
+static double elapsed_ns(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static void bot_output(CoSession* session, const char* text, size_t length) {
+    Bot* bot = session->user;
+    char chunk[CO_OUTBOX_SIZE + 1];
+    char answer[16];
+
+    if (!text) {
+        bot->finished = 1;
+        return;
+    }
+    memcpy(chunk, text, length);
+    chunk[length] = '\0';
+    if (strstr(chunk, "Too LOW")) bot->low = bot->guess + 1;
+    if (strstr(chunk, "Too HIGH")) bot->high = bot->guess - 1;
+    if (strstr(chunk, "CONGRATULATIONS")) bot->won = 1;
+    if (length >= 18 && strcmp(chunk + length - 18, "Enter your guess: ") == 0) {
+        bot->guess = (bot->low + bot->high) / 2;
+        snprintf(answer, sizeof(answer), "%d\n", bot->guess);
+        co_deliver(bot->loop, session->id, session->generation, answer);
+    }
+}
+
+static void ignore_output(CoSession* session, const char* text, size_t length) {
+    (void)session;
+    (void)text;
+    (void)length;
+}
+
+static int yielder(CoSession* session) {
+    Counter* counter = CO_LOCALS(session, Counter);
+    CO_BEGIN(session);
+    while (counter->remaining-- > 0) CO_YIELD(session);
+    CO_END(session);
+}
+
+static int napper(CoSession* session) {
+    Counter* counter = CO_LOCALS(session, Counter);
+    CO_BEGIN(session);
+    while (counter->remaining-- > 0) CO_SLEEP(session, 1);
+    CO_END(session);
+}
+
+static char reused_line[CO_LINE_MAX];
+
+static int reader(CoSession* session) {
+    CO_BEGIN(session);
+    CO_READ_LINE(session);
+    memcpy(reused_line, session->line, sizeof(reused_line));
+    CO_END(session);
+}
+
+static void* run_loop(void* arg) {
+    co_loop_run((CoLoop*)arg);
+    return NULL;
+}
+
+// Runs every loop on its own thread; returns wall time in ns
+static double run_all(void) {
+    struct timespec start, end;
+    pthread_t threads[LOOPS];
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < LOOPS; i++) pthread_create(&threads[i], NULL, run_loop, loops[i]);
+    for (int i = 0; i < LOOPS; i++) pthread_join(threads[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return elapsed_ns(start, end);
+}
+
+static uint64_t total_steps(uint32_t* peak) {
+    uint64_t steps = 0;
+    *peak = 0;
+    for (int i = 0; i < LOOPS; i++) {
+        CoStats stats;
+        co_loop_stats(loops[i], &stats);
+        steps += stats.steps;
+        *peak += stats.peak_live;
+    }
+    return steps;
+}
+
+static pthread_mutex_t handoff_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t handoff_cond = PTHREAD_COND_INITIALIZER;
+static int handoff_turn;
+
+static void* handoff_partner(void* arg) {
+    int rounds = *(int*)arg;
+    pthread_mutex_lock(&handoff_lock);
+    for (int i = 0; i < rounds; i++) {
+        while (handoff_turn != 1) pthread_cond_wait(&handoff_cond, &handoff_lock);
+        handoff_turn = 0;
+        pthread_cond_signal(&handoff_cond);
+    }
+    pthread_mutex_unlock(&handoff_lock);
+    return NULL;
+}
+
+int main(void) {
+    struct timespec start, end;
+    uint32_t peak;
+    int failures = 0;
+
+    srand(42);
+    printf("Session record %zu bytes, %zu bytes per pooled slot; %d sessions on %d loops\n",
+           sizeof(CoSession), co_bytes_per_session(), SESSIONS, LOOPS);
+
+    // Guess the Number, Medium: 1-100 in 15 attempts
+    for (int i = 0; i < LOOPS; i++) co_loop_init(&loops[i], SESSIONS / LOOPS, bot_output);
+    for (int i = 0; i < SESSIONS; i++) {
+        Bot* bot = &bots[i];
+        bot->loop = loops[i % LOOPS];
+        bot->low = 1;
+        bot->high = 100;
+        // Neighbours share a seed but not a loop
+        guess_number_session_setup(co_spawn(bot->loop, guess_number_session, bot), 100, 15,
+                                   (unsigned long long)(i / 2));
+    }
+    double ns = run_all();
+    uint64_t steps = total_steps(&peak);
+    int won = 0, finished = 0;
+    int paired = 0, distinct = 0;
+    char seen[101] = {0};
+    for (int i = 0; i < SESSIONS; i++) {
+        won += bots[i].won;
+        finished += bots[i].finished;
+        if (i % 2) paired += bots[i].guess == bots[i - 1].guess;
+        if (!seen[bots[i].guess]) distinct++;
+        seen[bots[i].guess] = 1;
+    }
+    printf("guess-the-number  %6u live  %8llu resumes  %7.1f ms  %6.0f ns/resume incl. game and bot\n",
+           peak, (unsigned long long)steps, ns / 1e6, ns / (double)steps);
+    for (int i = 0; i < LOOPS; i++) co_loop_free(loops[i]);
+    failures += check("every hosted round finished and was won", finished == SESSIONS && won == SESSIONS);
+    failures += check("10,000 sessions were live at once", peak == SESSIONS);
+    failures += check("each round's number follows its own seed",
+                      paired == SESSIONS / 2 && distinct == 100);
+
+    // Bare resume cost: every session yields YIELDS times
+    for (int i = 0; i < LOOPS; i++) co_loop_init(&loops[i], SESSIONS / LOOPS, ignore_output);
+    for (int i = 0; i < SESSIONS; i++) {
+        CO_LOCALS(co_spawn(loops[i % LOOPS], yielder, NULL), Counter)->remaining = YIELDS;
+    }
+    ns = run_all();
+    steps = total_steps(&peak);
+    double resume_ns = ns / (double)steps;
+    printf("yield             %6u live  %8llu resumes  %7.1f ms  %6.1f ns/resume\n",
+           peak, (unsigned long long)steps, ns / 1e6, resume_ns);
+    for (int i = 0; i < LOOPS; i++) co_loop_free(loops[i]);
+    failures += check("yielders all ran to the end", steps == (uint64_t)SESSIONS * (YIELDS + 1));
+
+    // Timers: every session sleeps 1 ms NAPS times
+    for (int i = 0; i < LOOPS; i++) co_loop_init(&loops[i], SESSIONS / LOOPS, ignore_output);
+    for (int i = 0; i < SESSIONS; i++) {
+        CO_LOCALS(co_spawn(loops[i % LOOPS], napper, NULL), Counter)->remaining = NAPS;
+    }
+    ns = run_all();
+    steps = total_steps(&peak);
+    printf("sleep 1 ms x %d   %6u live  %8llu resumes  %7.1f ms  for %d ms of naps each\n",
+           NAPS, peak, (unsigned long long)steps, ns / 1e6, NAPS);
+    for (int i = 0; i < LOOPS; i++) co_loop_free(loops[i]);
+    failures += check("sleepers all woke and finished", steps == (uint64_t)SESSIONS * (NAPS + 1));
+
+    // A one-slot loop: the first session ends, the second takes its slot
+    // and must only see input addressed to it
+    co_loop_init(&loops[0], 1, ignore_output);
+    CoSession* first = co_spawn(loops[0], yielder, NULL);
+    uint32_t first_id = first->id, first_generation = first->generation;
+    co_loop_run(loops[0]);
+    CoSession* second = co_spawn(loops[0], reader, NULL);
+    int same_slot = second->id == first_id;
+    co_deliver(loops[0], first_id, first_generation, "stale\n");
+    co_deliver(loops[0], second->id, second->generation, "fresh\n");
+    co_loop_run(loops[0]);
+    co_loop_free(loops[0]);
+    failures += check("input for a finished session skips its slot's next one",
+                      same_slot && strcmp(reused_line, "fresh") == 0);
+
+    // For scale: handing control between two threads
+    int rounds = 20000;
+    pthread_t partner;
+    pthread_create(&partner, NULL, handoff_partner, &rounds);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_mutex_lock(&handoff_lock);
+    for (int i = 0; i < rounds; i++) {
+        handoff_turn = 1;
+        pthread_cond_signal(&handoff_cond);
+        while (handoff_turn != 0) pthread_cond_wait(&handoff_cond, &handoff_lock);
+    }
+    pthread_mutex_unlock(&handoff_lock);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_join(partner, NULL);
+    double handoff_ns = elapsed_ns(start, end) / (2.0 * rounds);
+
+    pthread_attr_t attributes;
+    size_t stack_size = 0;
+    pthread_attr_init(&attributes);
+    pthread_attr_getstacksize(&attributes, &stack_size);
+    pthread_attr_destroy(&attributes);
+    printf("thread handoff    %6.0f ns per switch; each thread reserves a %zu KB stack\n",
+           handoff_ns, stack_size / 1024);
+    printf("10,000 sessions: %.1f MB as coroutines vs %.0f MB of thread stacks reserved\n",
+           SESSIONS * (double)co_bytes_per_session() / (1024 * 1024),
+           SESSIONS * (double)stack_size / (1024 * 1024));
+
+    failures += check("a session costs under 1 KB", co_bytes_per_session() < 1024);
+    failures += check("resuming a session is cheaper than a thread handoff", resume_ns < handoff_ns);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
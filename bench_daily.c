@@ -0,0 +1,142 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "games/daily.h"
+
+// Daily-challenge content. Generates two months of days one by one to
+// show what the solver work costs (average and worst day), then writes
+// the same range as a pack on every core and loads each day back from
+// the mapped file. Loaded records must match fresh generation exactly,
+// every board must clear without guessing, every stored optimal length
+// must be confirmed by a new search, and a load must take well under a
+// microsecond. Days outside the pack are never solved at play time: with
+// the pack gone, a load reports pending and the pack comes back from a
+// background thread.
+
+#define DAYS 60
+#define LOADS_PER_DAY 10000
+#define LOAD_BUDGET_NS 1000.0
+#define BACKGROUND_BUDGET_MS 60000.0
+
+static DailyChallenge generated[DAYS];
+
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-daily-XXXXXX";
+    char path[300], date[16];
+    struct timespec start, end;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    int first_day = daily_today();
+    daily_date(first_day, date, sizeof(date));
+    printf("Daily challenges: %d days from %s, %zu-byte records\n", DAYS, date, sizeof(DailyChallenge));
+
+    double total_ms = 0, worst_ms = 0;
+    int tries = 0, shortest = 255, longest = 0;
+    for (int i = 0; i < DAYS; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tries += daily_generate(first_day + i, &generated[i]);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ms = elapsed_ms(start, end);
+        total_ms += ms;
+        if (ms > worst_ms) worst_ms = ms;
+        if (generated[i].optimal_moves < shortest) shortest = generated[i].optimal_moves;
+        if (generated[i].optimal_moves > longest) longest = generated[i].optimal_moves;
+    }
+    printf("generate, 1 thread      %8.1f ms  (%.1f ms/day, worst %.1f ms, %.1f tries/day)\n",
+           total_ms, total_ms / DAYS, worst_ms, (double)tries / DAYS);
+    printf("puzzle optimal lengths  %d-%d moves\n", shortest, longest);
+
+    if (!daily_pack_path(path, sizeof(path))) return 1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int written = daily_pack_write(path, first_day, DAYS, 0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("pack, all cores         %8.1f ms\n", elapsed_ms(start, end));
+
+    DailyChallenge loaded;
+    int from_pack = 0, matching = 0;
+    for (int i = 0; i < DAYS; i++) {
+        from_pack += daily_load(first_day + i, &loaded) == DAILY_FROM_PACK;
+        matching += memcmp(&loaded, &generated[i], sizeof(loaded)) == 0;
+    }
+
+    long long starts = 0, expected_starts = 0;
+    for (int i = 0; i < DAYS; i++) expected_starts += (long long)LOADS_PER_DAY * generated[i].mine_start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < LOADS_PER_DAY; n++) {
+        for (int i = 0; i < DAYS; i++) {
+            daily_load(first_day + i, &loaded);
+            starts += loaded.mine_start;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double load_ns = elapsed_ms(start, end) * 1e6 / ((double)LOADS_PER_DAY * DAYS);
+    printf("load from pack          %8.1f ns/day\n", load_ns);
+
+    int solvable = 0, optimal = 0, mine_totals = 0;
+    for (int i = 0; i < DAYS; i++) {
+        int mines = 0;
+        for (int cell = 0; cell < DAILY_MINE_WIDTH * DAILY_MINE_HEIGHT; cell++) {
+            mines += daily_is_mine(&generated[i], cell);
+        }
+        mine_totals += mines == DAILY_MINE_COUNT;
+        solvable += daily_mines_solvable(generated[i].mines, generated[i].mine_start);
+        optimal += daily_puzzle_optimal(generated[i].tiles, 80) == generated[i].optimal_moves;
+    }
+    int outside = daily_load(first_day + DAYS, &loaded) == DAILY_PENDING && loaded.day == 0;
+
+    // Without a pack, loads wait for the one written in the background
+    daily_close();
+    unlink(path);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int pending = daily_load(first_day, &loaded) == DAILY_PENDING;
+    int background = 0;
+    double background_ms = 0;
+    while (!background && background_ms < BACKGROUND_BUDGET_MS) {
+        usleep(10000);
+        background = daily_load(first_day, &loaded) == DAILY_FROM_PACK;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        background_ms = elapsed_ms(start, end);
+    }
+    background = background && memcmp(&loaded, &generated[0], sizeof(loaded)) == 0 &&
+                 daily_load(first_day + DAILY_PACK_DAYS - 1, &loaded) == DAILY_FROM_PACK &&
+                 memcmp(&loaded, &generated[DAILY_PACK_DAYS - 1], sizeof(loaded)) == 0;
+    printf("pack, background        %8.1f ms  (%d days, 1 thread)\n", background_ms, DAILY_PACK_DAYS);
+
+    printf("Checks\n");
+    failures += check("pack written", written);
+    failures += check("every day loaded from the pack", from_pack == DAYS);
+    failures += check("pack records match fresh generation", matching == DAYS);
+    failures += check("every board has its mine count", mine_totals == DAYS);
+    failures += check("every board clears from its opening without guessing", solvable == DAYS);
+    failures += check("every stored optimal length is confirmed", optimal == DAYS);
+    failures += check("repeated loads return the same days", starts == expected_starts);
+    failures += check("days outside the pack are pending, not solved", outside);
+    failures += check("a missing pack is pending, not solved", pending);
+    failures += check("the background pack matches fresh generation", background);
+    failures += check("seeds differ between games and days",
+                      generated[0].seeds[DAILY_2048] != generated[0].seeds[DAILY_YAHTZEE] &&
+                      generated[0].seeds[DAILY_2048] != generated[1].seeds[DAILY_2048]);
+    failures += check("loading a day takes under a microsecond", load_ns < LOAD_BUDGET_NS);
+
+    daily_close();
+    unlink(path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "games/dino_course.h"
+
+// Dino Runner obstacle courses. Writes a four-million-obstacle course
+// (weeks of play) and a ten-obstacle one, then times opening each: only
+// the header is read, so the long one must still open in microseconds.
+// Streams the whole course back and checks every obstacle, then seeks to
+// random positions: each seek must land on the last checkpoint at or
+// before the target and decode exactly the stored obstacles from there. Last, a cut-short file is refused and a damaged index entry
+// falls back to the start instead of reading out of bounds.
+
+#define OBSTACLES 4000000
+#define OPENS 2000
+#define SEEKS 200000
+#define OPEN_BUDGET_US 100.0
+#define SEEK_BUDGET_US 5.0
+#define BYTES_BUDGET 2.5                    // Per obstacle, index included
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t next_random(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static long file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static double open_us(const char* path, int* ok) {
+    struct timespec start, end;
+    DinoCourse course;
+
+    *ok = 1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < OPENS; i++) {
+        *ok &= dino_course_open(&course, path);
+        dino_course_close(&course);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return seconds(start, end) * 1e6 / OPENS;
+}
+
+// Writes a copy of src with its last cut bytes dropped, or with one byte changed at poke
+static int copy_file(const char* src, const char* dst, long cut, long poke, unsigned char value) {
+    long size = file_size(src);
+    unsigned char* data = size > 0 ? malloc((size_t)size) : NULL;
+    FILE* in = fopen(src, "rb");
+    FILE* out = fopen(dst, "wb");
+    int ok = data && in && out && fread(data, 1, (size_t)size, in) == (size_t)size;
+    if (ok && poke >= 0) data[poke] = value;
+    ok = ok && fwrite(data, 1, (size_t)(size - cut), out) == (size_t)(size - cut);
+    if (in) fclose(in);
+    if (out) fclose(out);
+    free(data);
+    return ok;
+}
+
+int main(void) {
+    char dir[] = "/tmp/dino-course-XXXXXX";
+    char long_path[256], short_path[256], cut_path[256], damaged_path[256];
+    struct timespec start, end;
+    DinoCourseWriter writer;
+    DinoCourse course;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    snprintf(long_path, sizeof(long_path), "%s/long.course", dir);
+    snprintf(short_path, sizeof(short_path), "%s/short.course", dir);
+    snprintf(cut_path, sizeof(cut_path), "%s/cut.course", dir);
+    snprintf(damaged_path, sizeof(damaged_path), "%s/damaged.course", dir);
+
+    uint32_t* positions = malloc(OBSTACLES * sizeof(uint32_t));
+    uint8_t* types = malloc(OBSTACLES);
+    if (!positions || !types) return 1;
+    uint32_t position = 0;
+    for (int i = 0; i < OBSTACLES; i++) {
+        position += 30 + next_random() % 670;
+        positions[i] = position;
+        types[i] = (uint8_t)(next_random() % 12);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int written = dino_course_writer_begin(&writer, long_path, "Bench", 70);
+    for (int i = 0; written && i < OBSTACLES; i++) written = dino_course_writer_add(&writer, types[i], positions[i]);
+    written = written && dino_course_writer_finish(&writer, position + 80);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long size = file_size(long_path);
+    double bytes_per_obstacle = (double)size / OBSTACLES;
+    printf("Dino course: %d obstacles, %ld bytes\n", OBSTACLES, size);
+    printf("write course                 %8.1f M obstacles/s\n", OBSTACLES / seconds(start, end) / 1e6);
+    printf("bytes per obstacle           %8.2f (with the index)\n", bytes_per_obstacle);
+
+    int short_written = dino_course_writer_begin(&writer, short_path, "Short", 70);
+    for (int i = 0; short_written && i < 10; i++) short_written = dino_course_writer_add(&writer, types[i], positions[i]);
+    short_written = short_written && dino_course_writer_finish(&writer, positions[9] + 80);
+
+    int long_opens, short_opens;
+    double long_open = open_us(long_path, &long_opens);
+    double short_open = open_us(short_path, &short_opens);
+    printf("open, 10 obstacles           %8.2f us\n", short_open);
+    printf("open, %d obstacles      %8.2f us\n", OBSTACLES, long_open);
+    printf("reader state                 %8zu bytes, any length\n", sizeof(DinoCourse));
+
+    // Stream everything back
+    int streamed = dino_course_open(&course, long_path) && course.obstacle_count == OBSTACLES;
+    int type, count = 0;
+    uint32_t at;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (streamed && dino_course_peek(&course, &type, &at)) {
+        if (count >= OBSTACLES || at != positions[count] || type != types[count]) {
+            streamed = 0;
+            break;
+        }
+        dino_course_advance(&course);
+        count++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    streamed = streamed && count == OBSTACLES;
+    printf("stream whole course          %8.1f M obstacles/s\n", count / seconds(start, end) / 1e6);
+
+    // Random checkpoint seeks: timed alone, then checked against the stored course
+    static uint32_t targets[SEEKS];
+    for (int i = 0; i < SEEKS; i++) targets[i] = next_random() % (position + 1000);
+    uint64_t sink = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < SEEKS; i++) {
+        sink += dino_course_seek(&course, targets[i]);
+        dino_course_peek(&course, &type, &at);
+        sink += at;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seek_us = seconds(start, end) * 1e6 / SEEKS;
+    printf("seek to a checkpoint         %8.3f us\n", seek_us);
+
+    int seeks_ok = 1;
+    for (int i = 0; i < SEEKS && seeks_ok; i++) {
+        uint32_t base = dino_course_seek(&course, targets[i]);
+        uint32_t first = course.number;
+        seeks_ok = first % DINO_COURSE_SECTION == 0 && base <= targets[i] &&
+                   base == (first ? positions[first - 1] : 0) &&
+                   (first + DINO_COURSE_SECTION >= OBSTACLES || positions[first + DINO_COURSE_SECTION - 1] > targets[i]);
+        for (uint32_t k = first; seeks_ok && k < first + 40 && k < OBSTACLES; k++) {
+            seeks_ok = dino_course_peek(&course, &type, &at) && at == positions[k] && type == types[k];
+            dino_course_advance(&course);
+        }
+    }
+    dino_course_close(&course);
+
+    // A cut-short file fails the size check; a bad index entry is not followed
+    copy_file(short_path, cut_path, 6, -1, 0);
+    int cut_refused = !dino_course_open(&course, cut_path);
+    copy_file(short_path, damaged_path, 0, file_size(short_path) - 8, 0xFF);
+    int damaged_safe = dino_course_open(&course, damaged_path) && dino_course_seek(&course, positions[5]) == 0 &&
+                       dino_course_peek(&course, &type, &at) && at == positions[0];
+    dino_course_close(&course);
+
+    printf("Checks\n");
+    failures += check("4M-obstacle course written", written && short_written);
+    failures += check("under 2.5 bytes per obstacle, index included", bytes_per_obstacle < BYTES_BUDGET);
+    failures += check("opening a 4M-obstacle course takes under 100 us",
+                      long_opens && short_opens && long_open < OPEN_BUDGET_US);
+    failures += check("every obstacle streams back as written", streamed);
+    failures += check("seeks land on the checkpoint and decode from it", seeks_ok && sink > 0);
+    failures += check("a checkpoint seek is an index lookup (< 5 us)", seek_us < SEEK_BUDGET_US);
+    failures += check("a cut-short course is refused", cut_refused);
+    failures += check("a damaged index entry falls back to the start", damaged_safe);
+
+    unlink(long_path);
+    unlink(short_path);
+    unlink(cut_path);
+    unlink(damaged_path);
+    rmdir(dir);
+    free(positions);
+    free(types);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
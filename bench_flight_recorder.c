@@ -0,0 +1,196 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "games/flight_recorder.h"
+
+// Measures the flight recorder's cost on a headless Dino-style tick
+// (physics, sprite drawing into a 24x81 buffer, ANSI frame composition)
+// and checks that a crashing process leaves a complete dump behind, and
+// that a forked session's dump holds only its own events.
+
+#define ROWS 24
+#define COLS 80
+#define OBSTACLES 20
+#define TICKS 200000
+#define TICK_PERIOD_US 16667.0
+
+static char screen[ROWS][COLS + 1];
+static char output[ROWS * (COLS + 16)];
+static float obstacle_x[OBSTACLES];
+static float dino_y, dino_velocity;
+static unsigned int rng_state = 12345;
+
+static int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (int)((rng_state >> 8) & 0x7FFF);
+}
+
+static void draw_text(int x, int y, const char* text) {
+    int col = x;
+    for (; *text; text++) {
+        if (*text == '\n') {
+            y++;
+            col = x;
+            continue;
+        }
+        if (y >= 0 && y < ROWS && col >= 0 && col < COLS) screen[y][col] = *text;
+        col++;
+    }
+}
+
+static size_t headless_tick(int tick, int record) {
+    // Input and physics
+    int key = (tick % 40 == 0) ? ' ' : -1;
+    if (key == ' ' && dino_y >= 15.0f) dino_velocity = -6.0f;
+    dino_velocity += 0.6f;
+    dino_y += dino_velocity;
+    if (dino_y > 15.0f) {
+        dino_y = 15.0f;
+        dino_velocity = 0.0f;
+    }
+    for (int i = 0; i < OBSTACLES; i++) {
+        obstacle_x[i] -= 1.5f;
+        if (obstacle_x[i] < -6.0f) {
+            int roll = next_random();
+            if (record) flight_recorder_rng(roll);
+            obstacle_x[i] = (float)(COLS + roll % 60);
+        }
+    }
+    if (record && key >= 0) flight_recorder_input(key);
+
+    // Draw into the screen buffer
+    for (int y = 0; y < ROWS; y++) {
+        memset(screen[y], ' ', COLS);
+        screen[y][COLS] = '\0';
+    }
+    for (int x = 0; x < COLS; x++) screen[18][x] = (x + tick) % 7 ? '_' : '.';
+    for (int i = 0; i < OBSTACLES; i++) draw_text((int)obstacle_x[i], 16, " | \n-+-");
+    draw_text(8, (int)dino_y, "  >o)\n /_/|\n  / \\");
+    char hud[64];
+    snprintf(hud, sizeof(hud), "HI: %05d  SCORE: %05d", 1234, tick / 6);
+    draw_text(2, 1, hud);
+    if (record) flight_recorder_frame(&screen[0][0], ROWS, COLS + 1);
+
+    // Compose the terminal frame the game would write
+    size_t used = 0;
+    for (int y = 0; y < ROWS; y++) {
+        used += (size_t)snprintf(output + used, sizeof(output) - used, "\033[%d;1H%s", y + 4, screen[y]);
+    }
+    return used;
+}
+
+static double run_ticks(int record) {
+    struct timespec start, end;
+    size_t checksum = 0;
+
+    dino_y = 15.0f;
+    for (int i = 0; i < OBSTACLES; i++) obstacle_x[i] = (float)(i * 12);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int tick = 0; tick < TICKS; tick++) {
+        uint64_t tick_start = record ? flight_recorder_now_us() : 0;
+        checksum += headless_tick(tick, record);
+        if (record) flight_recorder_tick(flight_recorder_now_us() - tick_start);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (checksum == 0) printf("(empty frames)\n");
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / TICKS;
+}
+
+static int check_crash_dump(void) {
+    static char text[1 << 20];
+    char dir[] = "/tmp/cli-games-flight-XXXXXX";
+    char path[256];
+    int status;
+
+    if (!mkdtemp(dir)) return 0;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+
+    pid_t child = fork();
+    if (child == 0) {
+        flight_recorder_install();
+        flight_recorder_mark("crash test");
+        for (int tick = 0; tick < 5000; tick++) headless_tick(tick, 1);
+        flight_recorder_input('Q');
+        raise(SIGSEGV);
+        _exit(0);
+    }
+    waitpid(child, &status, 0);
+
+    snprintf(path, sizeof(path), "%s/flight-%d.log", dir, (int)child);
+    FILE* file = fopen(path, "r");
+    size_t length = file ? fread(text, 1, sizeof(text) - 1, file) : 0;
+    if (file) fclose(file);
+    text[length] = '\0';
+    unlink(path);
+    rmdir(dir);
+
+    int killed = WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+    int ok = killed && strstr(text, "signal: SIGSEGV") && strstr(text, "INPUT  81 'Q'") &&
+             strstr(text, "--- frame ") && strstr(text, "SCORE:");
+    printf("Crash dump:        %s (%zu bytes, child %s)\n", ok ? "ok" : "MISSING OR INCOMPLETE",
+           length, killed ? "died of SIGSEGV" : "did not die of SIGSEGV");
+    return ok;
+}
+
+// The parent has recorded a few hundred thousand ticks; a forked session
+// must dump only its own two events, and a second install is refused
+static int check_forked_session(void) {
+    static char text[1 << 16];
+    int channel[2], status;
+
+    if (pipe(channel) != 0) return 0;
+    pid_t child = fork();
+    if (child == 0) {
+        close(channel[0]);
+        int claimed = flight_recorder_install();
+        int again = flight_recorder_install();
+        flight_recorder_mark("forked session");
+        if (claimed && !again) flight_recorder_dump(channel[1], 0);
+        _exit(0);
+    }
+    close(channel[1]);
+    size_t length = 0;
+    ssize_t got;
+    while (length < sizeof(text) - 1 && (got = read(channel[0], text + length, sizeof(text) - 1 - length)) > 0) {
+        length += (size_t)got;
+    }
+    close(channel[0]);
+    text[length] = '\0';
+    waitpid(child, &status, 0);
+
+    int ok = strstr(text, "events: 2 of 2 recorded") && strstr(text, "session start") &&
+             strstr(text, "forked session") && !strstr(text, "--- frame ");
+    printf("Forked session:    %s\n", ok ? "ok (own events only, second install refused)"
+                                          : "INHERITED EVENTS OR SECOND INSTALL ALLOWED");
+    return ok;
+}
+
+int main(void) {
+    int failures = 0;
+
+    flight_recorder_install();
+    run_ticks(0);   // Warm up
+
+    double plain_ns = run_ticks(0);
+    double recorded_ns = run_ticks(1);
+    double cost_ns = recorded_ns > plain_ns ? recorded_ns - plain_ns : 0.0;
+    double tick_share = cost_ns / (TICK_PERIOD_US * 1000.0) * 100.0;
+
+    printf("Headless tick:     %.0f ns without recorder, %.0f ns with\n", plain_ns, recorded_ns);
+    printf("Recorder cost:     %.0f ns/tick = %.3f%% of a 60 FPS tick (%.1f%% of tick compute)\n",
+           cost_ns, tick_share, cost_ns / plain_ns * 100.0);
+    if (tick_share >= 1.0) failures++;
+
+    if (!check_crash_dump()) failures++;
+    if (!check_forked_session()) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
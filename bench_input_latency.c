@@ -0,0 +1,414 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+
+// Key-to-frame latency of the real-time games, end to end. The real
+// cli-games binary runs in a 40x100 pseudo-terminal and everything it
+// writes goes through a small VT emulator, so no display is needed. The
+// harness drives the menus into a game, finds the player on the emulated
+// screen (the racing car, the snake's head, the dino, the bird, the
+// cannon) and presses keys at random moments on the monotonic clock. A
+// press counts as shown when the output that moves the player the way
+// the key asks has been read. Players only move this way on input, so the
+// time from the write to that read is what a player would wait. A game
+// that ends is relaunched until it has given enough presses.
+
+#define ROWS 40
+#define COLS 100
+#define PRESSES 30                      // Measured presses per game
+#define MAX_LAUNCHES 12
+#define SHOW_TIMEOUT_MS 3000            // A press not shown by then is lost
+#define START_TIMEOUT_MS 3000
+#define ALIVE_MS 1000                   // Output this recent means the game still runs
+#define RACING_BUDGET_MS 10.0           // Racing redraws as soon as a key arrives
+#define FRAME_SLACK_MS 10.0
+
+typedef struct {
+    int row, col;
+} Position;
+
+typedef struct {
+    const char* name;
+    const char* start[3];               // Typed one at a time from the main menu
+    double frame_ms;                    // How often it draws; 0 when it draws on input
+    const char* keys;                   // Pressed in turn
+    const char* moves;                  // What each key does: Up, Left or Right
+    int gap_min_ms, gap_max_ms;         // Wait between a press showing and the next
+    int (*locate)(Position* at);
+} Probe;
+
+static char screen[ROWS][COLS + 1];     // Rows stay NUL-terminated
+static int cursor_row, cursor_col;
+
+static uint64_t now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+static void clear_cells(int row, int from_col, int to_row) {
+    for (int r = row; r <= to_row && r < ROWS; r++) {
+        int start = r == row ? from_col : 0;
+        if (start < COLS) memset(screen[r] + start, ' ', (size_t)(COLS - start));
+    }
+}
+
+static void new_line(void) {
+    if (++cursor_row == ROWS) {
+        memmove(screen[0], screen[1], sizeof(screen) - sizeof(screen[0]));
+        memset(screen[ROWS - 1], ' ', COLS);
+        cursor_row = ROWS - 1;
+    }
+}
+
+// Understands the sequences the games emit: cursor moves, erases, clears
+static void emulate(const unsigned char* data, size_t length) {
+    static int state = 0;       // 0 text, 1 after ESC, 2 inside CSI
+    static int params[4], count;
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = data[i];
+        if (state == 1) {
+            state = c == '[' ? 2 : 0;
+            count = 0;
+            params[0] = 0;
+            continue;
+        }
+        if (state == 2) {
+            if (c >= '0' && c <= '9') {
+                params[count] = params[count] * 10 + (c - '0');
+            } else if (c == ';') {
+                if (count < 3) params[++count] = 0;
+            } else if (c != '?') {
+                int first = params[0];
+                state = 0;
+                switch (c) {
+                    case 'H':
+                        cursor_row = (first ? first : 1) - 1;
+                        cursor_col = (count > 0 && params[1] ? params[1] : 1) - 1;
+                        break;
+                    case 'G': cursor_col = (first ? first : 1) - 1; break;
+                    case 'A': cursor_row -= first ? first : 1; break;
+                    case 'K': clear_cells(cursor_row, cursor_col, cursor_row); break;
+                    case 'J':
+                        if (first == 0) clear_cells(cursor_row, cursor_col, ROWS - 1);
+                        else if (first == 2) clear_cells(0, 0, ROWS - 1);
+                        break;
+                    default: break;
+                }
+                if (cursor_row < 0) cursor_row = 0;
+                if (cursor_row >= ROWS) cursor_row = ROWS - 1;
+                if (cursor_col < 0) cursor_col = 0;
+            }
+            continue;
+        }
+        if (c == 033) {
+            state = 1;
+        } else if (c == '\n') {
+            new_line();
+        } else if (c == '\r') {
+            cursor_col = 0;
+        } else if (c == '\b') {
+            if (cursor_col > 0) cursor_col--;
+        } else if (c >= ' ') {
+            if (cursor_col >= COLS) {
+                cursor_col = 0;
+                new_line();
+            }
+            screen[cursor_row][cursor_col++] = (char)c;
+        }
+    }
+}
+
+// Top-most place the text appears, optionally only inside a '|' border
+static int find_text(const char* text, int bordered, Position* at) {
+    for (int row = 0; row < ROWS; row++) {
+        if (bordered && screen[row][0] != '|') continue;
+        const char* found = strstr(screen[row], text);
+        if (found) {
+            at->row = row;
+            at->col = (int)(found - screen[row]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int locate_car(Position* at) { return find_text("A", 1, at); }
+static int locate_snake(Position* at) { return find_text("@", 1, at); }
+static int locate_dino(Position* at) { return find_text(">o)", 0, at); }
+// Below the four-row HUD, which counts lives in cannons too
+static int locate_cannon(Position* at) {
+    for (int row = ROWS - 1; row >= 4; row--) {
+        const char* found = strstr(screen[row], "^^^");
+        if (found) {
+            at->row = row;
+            at->col = (int)(found - screen[row]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int locate_bird(Position* at) {
+    static const char* sprites[] = {"<o>", "\\o/", "-o-", "/o\\"};
+    Position found;
+    int any = 0;
+    for (int i = 0; i < 4; i++) {
+        if (find_text(sprites[i], 0, &found) && (!any || found.row < at->row)) {
+            *at = found;
+            any = 1;
+        }
+    }
+    return any;
+}
+
+static const Probe probes[] = {
+    {"ascii_racing", {"9\n", "\n", NULL}, 0.0, "ad", "LR", 100, 300, locate_car},
+    {"snake", {"11\n", "\n", NULL}, 200.0, "wasd", "ULDR", 210, 390, locate_snake},
+    {"dino_runner", {"18\n", "1\n", NULL}, 1000.0 / 60, " ", "U", 450, 700, locate_dino},
+    {"flappy_bird", {"17\n", "1\n", "\n"}, 1000.0 / 60, " ", "U", 60, 160, locate_bird},
+    {"space_invaders", {"15\n", "1\n", "\n"}, 33.0, "ad", "LR", 100, 300, locate_cannon},
+};
+
+// The player's last position and the direction of its last move
+typedef struct {
+    int master;
+    pid_t child;
+    const Probe* probe;
+    int seen;
+    Position at;
+    char last_move;
+    uint64_t last_output_us;
+} Session;
+
+static char move_between(Position from, Position to) {
+    if (to.row < from.row && to.col == from.col) return 'U';
+    if (to.row > from.row && to.col == from.col) return 'D';
+    if (to.row == from.row && to.col < from.col) return 'L';
+    if (to.row == from.row && to.col > from.col) return 'R';
+    return '?';
+}
+
+// Reads and emulates output until the deadline, or until the player
+// makes the wanted move; returns 1 and when it was read in the latter case
+static int pump(Session* session, uint64_t deadline_us, char wanted, uint64_t* shown_us) {
+    unsigned char buffer[65536];
+
+    for (;;) {
+        uint64_t now = now_us();
+        if (now >= deadline_us) return 0;
+
+        struct pollfd pfd = {session->master, POLLIN, 0};
+        if (poll(&pfd, 1, (int)((deadline_us - now + 999) / 1000)) <= 0) continue;
+        ssize_t got = read(session->master, buffer, sizeof(buffer));
+        uint64_t read_us = now_us();
+        if (got <= 0) return 0;
+        emulate(buffer, (size_t)got);
+        session->last_output_us = read_us;
+
+        Position at;
+        if (!session->probe->locate(&at)) continue;
+        if (session->seen && (at.row != session->at.row || at.col != session->at.col)) {
+            session->last_move = move_between(session->at, at);
+            session->at = at;
+            if (wanted && session->last_move == wanted) {
+                *shown_us = read_us;
+                return 1;
+            }
+        }
+        session->at = at;
+        session->seen = 1;
+    }
+}
+
+static int launch(Session* session, const Probe* probe) {
+    struct winsize size = {ROWS, COLS, 0, 0};
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        exit(1);
+    }
+    ioctl(master, TIOCSWINSZ, &size);
+
+    for (int row = 0; row < ROWS; row++) {
+        memset(screen[row], ' ', COLS);
+        screen[row][COLS] = '\0';
+    }
+    cursor_row = cursor_col = 0;
+
+    pid_t child = fork();
+    if (child == 0) {
+        setsid();
+        int slave = open(ptsname(master), O_RDWR);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        close(master);
+        execl("./cli-games", "cli-games", (char*)NULL);
+        _exit(127);
+    }
+
+    memset(session, 0, sizeof(*session));
+    session->master = master;
+    session->child = child;
+    session->probe = probe;
+    pump(session, now_us() + 400000, 0, NULL);
+    for (int i = 0; i < 3 && probe->start[i]; i++) {
+        if (i > 0) pump(session, now_us() + 300000, 0, NULL);
+        if (write(master, probe->start[i], strlen(probe->start[i])) < 0) perror("write");
+    }
+
+    // The bird falls from the first frame, so play starts as soon as the
+    // player is drawn; the first gap lets any menu text be overwritten
+    session->seen = 0;
+    session->last_move = 0;
+    uint64_t deadline = now_us() + START_TIMEOUT_MS * 1000u;
+    while (!session->seen && now_us() < deadline) {
+        pump(session, now_us() + 10000, 0, NULL);
+    }
+    return session->seen;
+}
+
+static void finish(Session* session) {
+    kill(session->child, SIGKILL);
+    waitpid(session->child, NULL, 0);
+    close(session->master);
+}
+
+typedef struct {
+    double samples[PRESSES];
+    int count;
+    int lost;
+    int launches;
+} GameResult;
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const GameResult* result, int percent) {
+    return result->samples[(result->count - 1) * percent / 100];
+}
+
+static void measure(const Probe* probe, GameResult* result) {
+    Session session;
+    size_t key_count = strlen(probe->keys);
+
+    memset(result, 0, sizeof(*result));
+    while (result->count < PRESSES && result->launches < MAX_LAUNCHES) {
+        result->launches++;
+        if (!launch(&session, probe)) {
+            finish(&session);
+            continue;
+        }
+
+        for (size_t press = 0; result->count < PRESSES; press++) {
+            int gap_ms = probe->gap_min_ms + rand() % (probe->gap_max_ms - probe->gap_min_ms + 1);
+            pump(&session, now_us() + (uint64_t)gap_ms * 1000u, 0, NULL);
+
+            // Something still rising from the last press would look like an
+            // answer to this one
+            char wanted = probe->moves[press % key_count];
+            uint64_t settle = now_us() + SHOW_TIMEOUT_MS * 1000u;
+            while (wanted == 'U' && session.last_move == 'U' && now_us() < settle) {
+                pump(&session, now_us() + 5000, 0, NULL);
+            }
+            if (now_us() - session.last_output_us > ALIVE_MS * 1000u) break;   // Game over
+
+            char key = probe->keys[press % key_count];
+            uint64_t shown, pressed = now_us();
+            if (write(session.master, &key, 1) != 1) break;
+            if (pump(&session, pressed + SHOW_TIMEOUT_MS * 1000u, wanted, &shown)) {
+                result->samples[result->count++] = (double)(shown - pressed) / 1000.0;
+                continue;
+            }
+
+            // Not shown: lost if the game is still drawing the player,
+            // otherwise it ended under the key
+            Position at;
+            if (now_us() - session.last_output_us < ALIVE_MS * 1000u && probe->locate(&at)) result->lost++;
+            break;
+        }
+        finish(&session);
+    }
+    qsort(result->samples, (size_t)result->count, sizeof(double), compare_doubles);
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    enum { GAMES = sizeof(probes) / sizeof(probes[0]) };
+    GameResult results[GAMES];
+    char dir[] = "/tmp/cli-games-latency-XXXXXX";
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    setenv("CLI_GAMES_ZYGOTE", "0", 1);
+    setenv("TERM", "xterm", 1);
+    srand(12345);
+
+    for (int game = 0; game < GAMES; game++) {
+        measure(&probes[game], &results[game]);
+    }
+
+    printf("Key-to-frame latency through a pty (ms), %d presses per game\n", PRESSES);
+    printf("  game              frame     p50     p90     max  lost  launches\n");
+    for (int game = 0; game < GAMES; game++) {
+        const GameResult* result = &results[game];
+        char frame[16];
+        if (probes[game].frame_ms > 0) {
+            snprintf(frame, sizeof(frame), "%7.1f", probes[game].frame_ms);
+        } else {
+            snprintf(frame, sizeof(frame), "%7s", "on key");
+        }
+        if (result->count == 0) {
+            printf("  %-16s %s  no presses measured %5d %9d\n", probes[game].name, frame, result->lost,
+                   result->launches);
+            continue;
+        }
+        printf("  %-16s %s %7.1f %7.1f %7.1f %5d %9d\n", probes[game].name, frame, percentile(result, 50),
+               percentile(result, 90), result->samples[result->count - 1], result->lost, result->launches);
+    }
+
+    printf("Checks\n");
+    int all_measured = 1, none_lost = 1, within_frame = 1;
+    for (int game = 0; game < GAMES; game++) {
+        const GameResult* result = &results[game];
+        all_measured &= result->count == PRESSES;
+        none_lost &= result->lost == 0;
+        if (probes[game].frame_ms > 0 && result->count > 0) {
+            within_frame &= percentile(result, 50) < probes[game].frame_ms + FRAME_SLACK_MS;
+        }
+    }
+    char label[128];
+    snprintf(label, sizeof(label), "every game gave %d measured presses", PRESSES);
+    failures += check(label, all_measured);
+    failures += check("no press lost while the game was running", none_lost);
+    failures += check("racing p90 under 10 ms (redraws on input)",
+                      results[0].count > 0 && percentile(&results[0], 90) < RACING_BUDGET_MS);
+    failures += check("frame-driven games: p50 within a frame plus 10 ms", within_frame);
+
+    char cleanup[128];
+    snprintf(cleanup, sizeof(cleanup), "rm -rf %s", dir);
+    if (system(cleanup) != 0) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
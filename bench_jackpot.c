@@ -0,0 +1,210 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "games/jackpot.h"
+
+// Shared progressive jackpot under contention. One session spins alone
+// for a second to time a spin (one contribution, and a claim one spin in
+// 20,000). Then the segment is deleted and 64 processes start at once:
+// they race to rebuild it from the checkpoint and spin auto-play for a
+// few seconds, longer than the checkpoint period. The segment's totals
+// must match what the processes added and won, and the money must add
+// up (amount + paid = seeds + contributions), which fails if two winners
+// ever took the same jackpot. Last, restarts: the segment is deleted and
+// rebuilt from the checkpoint, then from its older record when the newer
+// one is torn, then from the seed when neither is whole.
+
+#define PROCESSES 64
+#define SPIN_SECONDS 3.0
+#define CLAIM_ODDS 20000
+
+typedef struct {
+    uint64_t spins;
+    uint64_t contributed_cents;
+    uint64_t won_cents;
+    uint64_t claims;
+    uint64_t largest_win;
+} SessionResult;
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// Spins with bets of 1-25 credits (1% of a bet is its bet in hundredths)
+static void spin_for(double duration, uint64_t seed, SessionResult* result) {
+    struct timespec start, now;
+    uint64_t rng = seed * 0x9E3779B97F4A7C15ull + 1;
+
+    memset(result, 0, sizeof(*result));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (int i = 0; i < 1024; i++) {
+            rng ^= rng >> 12;
+            rng ^= rng << 25;
+            rng ^= rng >> 27;
+            uint32_t roll = (uint32_t)((rng * 0x2545F4914F6CDD1Dull) >> 32);
+            uint32_t bet = 1 + roll % 25;
+            jackpot_contribute(bet);
+            result->contributed_cents += bet;
+            if ((roll >> 8) % CLAIM_ODDS == 0) {
+                uint64_t won = jackpot_claim();
+                result->won_cents += won * 100;
+                result->claims++;
+                if (won > result->largest_win) result->largest_win = won;
+            }
+        }
+        result->spins += 1024;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while (seconds(start, now) < duration);
+}
+
+static int delete_segment(const char* dir) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/jackpot.seg", dir);
+    return unlink(path) == 0;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-jackpot-XXXXXX";
+    char checkpoint_path[512];
+    struct timespec start, end;
+    JackpotTotals before, after;
+    SessionResult alone;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    jackpot_checkpoint_path(checkpoint_path, sizeof(checkpoint_path));
+
+    int shared = jackpot_open();
+    int fresh = jackpot_amount() == (uint64_t)JACKPOT_SEED * 100;
+    spin_for(1.0, 1, &alone);
+    printf("Jackpot: %s segment\n", shared ? "shared" : "per-process");
+    printf("one session                  %8.1f ns per spin\n", 1e9 / alone.spins);
+
+    // A clean close checkpoints; the processes rebuild from it
+    jackpot_totals(&before);
+    jackpot_close();
+    int deleted = delete_segment(dir);
+
+    SessionResult* results = mmap(NULL, PROCESSES * sizeof(SessionResult), PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (results == MAP_FAILED) return 1;
+    memset(results, 0, PROCESSES * sizeof(SessionResult));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int p = 0; p < PROCESSES; p++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            int ok = jackpot_open();
+            spin_for(SPIN_SECONDS, (uint64_t)p + 2, &results[p]);
+            jackpot_close();
+            _exit(ok ? 0 : 1);
+        }
+        if (pid < 0) return 1;
+    }
+    int all_shared = 1;
+    for (int p = 0; p < PROCESSES; p++) {
+        int status;
+        wait(&status);
+        all_shared &= WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = seconds(start, end);
+
+    SessionResult sum;
+    memset(&sum, 0, sizeof(sum));
+    for (int p = 0; p < PROCESSES; p++) {
+        sum.spins += results[p].spins;
+        sum.contributed_cents += results[p].contributed_cents;
+        sum.won_cents += results[p].won_cents;
+        sum.claims += results[p].claims;
+        if (results[p].largest_win > sum.largest_win) sum.largest_win = results[p].largest_win;
+    }
+
+    jackpot_open();
+    jackpot_totals(&after);
+    printf("%d sessions                  %8.1f M spins/s (%llu spins in %.1f s)\n", PROCESSES,
+           sum.spins / elapsed / 1e6, (unsigned long long)sum.spins, elapsed);
+    printf("jackpots won                 %8llu (largest %llu credits)\n", (unsigned long long)sum.claims,
+           (unsigned long long)sum.largest_win);
+    printf("checkpoints written          %8llu\n", (unsigned long long)(after.checkpoints - before.checkpoints));
+
+    int totals_match = after.contributed_cents - before.contributed_cents == sum.contributed_cents &&
+                       after.paid_cents - before.paid_cents == sum.won_cents &&
+                       after.wins - before.wins == sum.claims;
+    int conserved = after.amount_cents + after.paid_cents == after.seeded_cents + after.contributed_cents;
+    // A second build mid-play would have reset the totals to the checkpoint
+    int rebuilt_once = totals_match && after.seeded_cents - before.seeded_cents == sum.claims * JACKPOT_SEED * 100;
+    // Each process closes with a checkpoint; more means the period fired
+    int periodic = after.checkpoints - before.checkpoints > PROCESSES;
+
+    // Restart: the closing checkpoint has everything
+    jackpot_close();
+    delete_segment(dir);
+    jackpot_open();
+    JackpotTotals restored;
+    jackpot_totals(&restored);
+    int restarted = restored.amount_cents == after.amount_cents && restored.wins == after.wins &&
+                    restored.paid_cents == after.paid_cents;
+
+    // Tear the newer record; the older one (the sequence before) remains
+    jackpot_close();
+    uint64_t newest = restored.checkpoints + 1;
+    FILE* file = fopen(checkpoint_path, "r+b");
+    int torn_ok = 0, seeded_ok = 0;
+    if (file) {
+        size_t record = 64;
+        fseek(file, (long)((newest & 1) * record + 20), SEEK_SET);
+        fputc(0x5A, file);
+        fclose(file);
+        delete_segment(dir);
+        jackpot_open();
+        JackpotTotals torn;
+        jackpot_totals(&torn);
+        torn_ok = torn.checkpoints == newest - 1;
+        jackpot_close();
+
+        // Neither record whole: back to the seed
+        file = fopen(checkpoint_path, "r+b");
+        if (file) {
+            for (int r = 0; r < 2; r++) {
+                fseek(file, (long)(r * record + 20), SEEK_SET);
+                fputc(0xA5, file);
+            }
+            fclose(file);
+        }
+        delete_segment(dir);
+        seeded_ok = jackpot_amount() == (uint64_t)JACKPOT_SEED * 100;
+    }
+
+    printf("Checks\n");
+    failures += check("segment mapped and starts at the seed", shared && fresh && deleted);
+    failures += check("all 64 sessions attached to the shared segment", all_shared);
+    failures += check("totals match what the sessions added and won", totals_match);
+    failures += check("money adds up: one winner per jackpot", conserved);
+    failures += check("64 racing sessions rebuilt the segment once", rebuilt_once);
+    failures += check("periodic checkpoints written during play", periodic);
+    failures += check("jackpot survives a restart from the checkpoint", restarted);
+    failures += check("a torn checkpoint falls back to the older record", torn_ok);
+    failures += check("no whole checkpoint starts again from the seed", seeded_ok);
+
+    jackpot_close();
+    delete_segment(dir);
+    unlink(checkpoint_path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
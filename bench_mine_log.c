@@ -0,0 +1,230 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "games/mine_log.h"
+
+// Minesweeper click logs. A bot plays boards of all three presets the
+// way a perfect player would (one click per 3BV, some flagging every
+// mine, some hitting one) and logs each game. The 3BV of every board
+// is checked against a plain breadth-first count, then the logs are
+// verified over and over until a million games have been replayed.
+// Tampered copies (time, clicks, mines) and a cut-off log must fail; a
+// copy marked as a daily board must still verify, marked.
+
+#define DISTINCT_GAMES 10000
+#define PASSES 100
+#define VERIFY_BUDGET_S 30.0
+
+static uint8_t logs[DISTINCT_GAMES * 1024];
+static size_t log_length;
+static int bot_bv[DISTINCT_GAMES];
+static int bot_won[DISTINCT_GAMES];
+
+static const int presets[3][3] = {{9, 9, 10}, {16, 16, 40}, {30, 16, 99}};
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t next_random(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 3BV by definition: breadth-first over zero regions, then lone numbers
+static int reference_3bv(const GridNeighbors* grid, const unsigned char* mines, const unsigned char* numbers) {
+    unsigned char seen[GRID_MAX_CELLS] = {0};
+    int queue[GRID_MAX_CELLS];
+    int bv = 0;
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        if (mines[cell] || numbers[cell] != 0 || seen[cell]) continue;
+        int head = 0, tail = 0;
+        queue[tail++] = cell;
+        seen[cell] = 1;
+        while (head < tail) {
+            int current = queue[head++];
+            if (numbers[current] != 0) continue;
+            for (int k = grid->neighbor_start[current]; k < grid->neighbor_start[current + 1]; k++) {
+                int next = grid->neighbors[k];
+                if (!seen[next] && !mines[next]) {
+                    seen[next] = 1;
+                    queue[tail++] = next;
+                }
+            }
+        }
+        bv++;
+    }
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        bv += !mines[cell] && !seen[cell];
+    }
+    return bv;
+}
+
+// Plays one board and appends its record; returns the record length
+static size_t bot_game(const GridNeighbors* grid, int mine_count, int index, int* bv_ok) {
+    static MineLogRecorder recorder;
+    unsigned char mines[GRID_MAX_CELLS] = {0}, numbers[GRID_MAX_CELLS], state[GRID_MAX_CELLS] = {0};
+    unsigned char scratch[GRID_MAX_CELLS];
+    int cells = grid->cell_count;
+
+    for (int placed = 0; placed < mine_count;) {
+        int cell = (int)(next_random() % (uint32_t)cells);
+        if (!mines[cell]) {
+            mines[cell] = 1;
+            placed++;
+        }
+    }
+    grid_count_adjacent(grid, mines, numbers);
+    int bv = mine_log_3bv(grid, mines, numbers, scratch);
+    *bv_ok = bv == reference_3bv(grid, mines, numbers);
+
+    int flagger = next_random() % 3 == 0;
+    int doomed_click = next_random() % 10 == 0 ? (int)(next_random() % (uint32_t)bv) : -1;
+    uint64_t now = 1000;
+    int clicks = 0, won = 0, safe_left = cells - mine_count;
+    mine_log_begin(&recorder);
+
+    // Openings first, then every number they left hidden: exactly 3BV clicks
+    for (int pass = 0; pass < 2; pass++) {
+        for (int cell = 0; cell < cells; cell++) {
+            if (mines[cell] || state[cell] != 0 || (pass == 0 && numbers[cell] != 0)) continue;
+            now += 80 + next_random() % 800;
+            if (clicks++ == doomed_click) {
+                // Every mine may already be flagged; then the bot survives
+                for (int mine = 0; mine < cells; mine++) {
+                    if (mines[mine] && state[mine] == 0) {
+                        mine_log_click(&recorder, mine, 0, now);
+                        goto finished;
+                    }
+                }
+            }
+            mine_log_click(&recorder, cell, 0, now);
+            safe_left -= grid_flood_reveal(grid, cell, numbers, state, NULL);
+            if (safe_left == 0) {
+                won = 1;
+                goto finished;
+            }
+            if (flagger) {
+                for (int k = grid->neighbor_start[cell]; k < grid->neighbor_start[cell + 1]; k++) {
+                    int next = grid->neighbors[k];
+                    if (mines[next] && state[next] == 0) {
+                        now += 60 + next_random() % 300;
+                        mine_log_click(&recorder, next, 1, now);
+                        state[next] = 2;
+                    }
+                }
+            }
+        }
+    }
+finished:
+    bot_bv[index] = bv;
+    bot_won[index] = won;
+    return mine_log_encode(&recorder, grid, mines, mine_count, won, 0, logs + log_length,
+                           sizeof(logs) - log_length);
+}
+
+// Verifies a copy of one record after tamper() has changed it
+static int verifies(MineLogVerifier* verifier, const uint8_t* record, size_t length) {
+    MineLogGame game;
+    return mine_log_verify(verifier, record, length, &game) == length && game.valid;
+}
+
+int main(void) {
+    static GridNeighbors grids[3];
+    static MineLogVerifier verifier;
+    size_t offsets[DISTINCT_GAMES + 1];
+    struct timespec start, end;
+    int failures = 0, bv_matches = 0;
+
+    for (int p = 0; p < 3; p++) grid_build_neighbors(&grids[p], GRID_SQUARE, presets[p][0], presets[p][1], 1);
+
+    for (int i = 0; i < DISTINCT_GAMES; i++) {
+        int p = i % 3, bv_ok;
+        offsets[i] = log_length;
+        log_length += bot_game(&grids[p], presets[p][2], i, &bv_ok);
+        bv_matches += bv_ok;
+    }
+    offsets[DISTINCT_GAMES] = log_length;
+    printf("Minesweeper click logs: %d games, %.1f bytes per game\n", DISTINCT_GAMES,
+           (double)log_length / DISTINCT_GAMES);
+
+    // First pass checks every record against what the bot played
+    MineLogGame game;
+    int valid = 0, agree = 0, records = 0;
+    for (size_t at = 0; at < log_length; records++) {
+        size_t length = mine_log_verify(&verifier, logs + at, log_length - at, &game);
+        if (length == 0) break;
+        valid += game.valid;
+        agree += game.bv == bot_bv[records] && game.won == bot_won[records] && !game.daily;
+        at += length;
+    }
+
+    long long verified = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int pass = 0; pass < PASSES; pass++) {
+        for (size_t at = 0, length; at < log_length; at += length) {
+            length = mine_log_verify(&verifier, logs + at, log_length - at, &game);
+            if (length == 0) break;
+            verified += game.valid;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = seconds(start, end);
+    printf("verify %lld games         %8.2f s  (%.2f us per game)\n", verified, elapsed,
+           elapsed * 1e6 / ((double)DISTINCT_GAMES * PASSES));
+
+    // Tampering: record 1 is an intermediate board
+    uint8_t copy[MINE_LOG_MAX_RECORD];
+    size_t length = offsets[2] - offsets[1];
+    const uint8_t* original = logs + offsets[1];
+    int body = 2;
+    while (original[body - 1] & 0x80) body++;
+
+    memcpy(copy, original, length);
+    copy[body + 6]++;                       // Elapsed ms, low varint byte
+    int time_caught = !verifies(&verifier, copy, length);
+    memcpy(copy, original, length);
+    copy[length - 1] ^= 1;                  // Last click's gap
+    int gap_caught = !verifies(&verifier, copy, length);
+    memcpy(copy, original, length);
+    int bitmap = body + 4;
+    while (copy[bitmap] & 0x80) bitmap++;
+    bitmap += 2;
+    for (int field = 0; field < 2; field++) {
+        while (copy[bitmap] & 0x80) bitmap++;
+        bitmap++;
+    }
+    copy[bitmap] ^= 0x18;                   // Move a mine or add two
+    int mines_caught = !verifies(&verifier, copy, length);
+    int cut_caught = mine_log_verify(&verifier, original, length - 1, &game) == 0;
+    memcpy(copy, original, length);
+    copy[body + 5] |= 2;                    // Flags: daily board
+    int daily_kept = mine_log_verify(&verifier, copy, length, &game) == length && game.valid && game.daily;
+
+    printf("Checks\n");
+    failures += check("3BV matches a breadth-first reference count", bv_matches == DISTINCT_GAMES);
+    failures += check("every logged game replays to its claimed result", valid == DISTINCT_GAMES);
+    failures += check("replayed 3BV and results match what the bot played", agree == DISTINCT_GAMES);
+    failures += check("a million games verified", verified == (long long)DISTINCT_GAMES * PASSES);
+    failures += check("an edited claimed time is rejected", time_caught);
+    failures += check("an edited click gap is rejected", gap_caught);
+    failures += check("an edited mine bitmap is rejected", mines_caught);
+    failures += check("a record cut short ends the log", cut_caught);
+    failures += check("a daily board's flag survives the replay", daily_kept);
+    failures += check("a million verifications take seconds, not minutes", elapsed < VERIFY_BUDGET_S);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
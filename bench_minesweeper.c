@@ -0,0 +1,140 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "games/grid_topology.h"
+
+// Compares the CSR neighbour-table board code in grid_topology.c against
+// the bounds-checked 8-neighbour code Minesweeper used before, on expert
+// boards (30x16, 99 mines). Both must produce identical numbers and reveals.
+
+#define WIDTH 30
+#define HEIGHT 16
+#define MINES 99
+#define BOARDS 200000
+
+static unsigned char ref_mines[HEIGHT][WIDTH];
+static unsigned char ref_numbers[HEIGHT][WIDTH];
+static unsigned char ref_state[HEIGHT][WIDTH];
+static int ref_revealed;
+
+static int ref_valid(int row, int col) {
+    return row >= 0 && row < HEIGHT && col >= 0 && col < WIDTH;
+}
+
+static void ref_count(void) {
+    for (int i = 0; i < HEIGHT; i++) {
+        for (int j = 0; j < WIDTH; j++) {
+            int count = 0;
+            for (int dr = -1; dr <= 1; dr++) {
+                for (int dc = -1; dc <= 1; dc++) {
+                    if (dr == 0 && dc == 0) continue;
+                    if (ref_valid(i + dr, j + dc) && ref_mines[i + dr][j + dc]) count++;
+                }
+            }
+            ref_numbers[i][j] = (unsigned char)count;
+        }
+    }
+}
+
+static void ref_reveal(int row, int col) {
+    if (!ref_valid(row, col) || ref_state[row][col] != 0) return;
+    ref_state[row][col] = 1;
+    ref_revealed++;
+    if (ref_numbers[row][col] != 0) return;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            if (dr == 0 && dc == 0) continue;
+            if (ref_valid(row + dr, col + dc) && ref_state[row + dr][col + dc] == 0) {
+                ref_reveal(row + dr, col + dc);
+            }
+        }
+    }
+}
+
+static double seconds_since(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static void place_mines(unsigned char* mines, unsigned int seed, int* safe_cell) {
+    srand(seed);
+    memset(mines, 0, WIDTH * HEIGHT);
+    for (int placed = 0; placed < MINES;) {
+        int cell = rand() % (WIDTH * HEIGHT);
+        if (!mines[cell]) {
+            mines[cell] = 1;
+            placed++;
+        }
+    }
+    do {
+        *safe_cell = rand() % (WIDTH * HEIGHT);
+    } while (mines[*safe_cell]);
+}
+
+int main(void) {
+    static GridNeighbors grid;
+    static unsigned char boards[64][WIDTH * HEIGHT];
+    static int safe_cells[64];
+    unsigned char numbers[WIDTH * HEIGHT];
+    unsigned char state[WIDTH * HEIGHT];
+    long long ref_total = 0, csr_total = 0;
+    struct timespec start;
+    int failures = 0;
+
+    grid_build_neighbors(&grid, GRID_SQUARE, WIDTH, HEIGHT, 1);
+    for (int b = 0; b < 64; b++) {
+        place_mines(boards[b], (unsigned int)b + 1, &safe_cells[b]);
+    }
+
+    // Correctness: identical numbers and reveal sets on every board
+    for (int b = 0; b < 64; b++) {
+        memcpy(ref_mines, boards[b], sizeof(ref_mines));
+        memset(ref_state, 0, sizeof(ref_state));
+        ref_revealed = 0;
+        ref_count();
+        ref_reveal(safe_cells[b] / WIDTH, safe_cells[b] % WIDTH);
+
+        memset(state, 0, sizeof(state));
+        grid_count_adjacent(&grid, boards[b], numbers);
+        int revealed = grid_flood_reveal(&grid, safe_cells[b], numbers, state, NULL);
+
+        if (memcmp(numbers, ref_numbers, sizeof(numbers)) != 0 ||
+            memcmp(state, ref_state, sizeof(state)) != 0 || revealed != ref_revealed) {
+            printf("Board %d: CSR result differs from reference\n", b);
+            failures++;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < BOARDS; i++) {
+        int b = i & 63;
+        memcpy(ref_mines, boards[b], sizeof(ref_mines));
+        memset(ref_state, 0, sizeof(ref_state));
+        ref_revealed = 0;
+        ref_count();
+        ref_reveal(safe_cells[b] / WIDTH, safe_cells[b] % WIDTH);
+        ref_total += ref_revealed;
+    }
+    double ref_time = seconds_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < BOARDS; i++) {
+        int b = i & 63;
+        memset(state, 0, sizeof(state));
+        grid_count_adjacent(&grid, boards[b], numbers);
+        csr_total += grid_flood_reveal(&grid, safe_cells[b], numbers, state, NULL);
+    }
+    double csr_time = seconds_since(start);
+
+    printf("Expert boards (count + first reveal), %d boards:\n", BOARDS);
+    printf("  Bounds-checked: %8.1f ns/board\n", ref_time / BOARDS * 1e9);
+    printf("  CSR table:      %8.1f ns/board (%.2fx)\n", csr_time / BOARDS * 1e9, ref_time / csr_time);
+    if (ref_total != csr_total) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "games/poker_eval.h"
+
+// Benchmarks the Texas Hold'em hand evaluator and equity calculator.
+// Enumerates all 133,784,560 seven-card hands and checks the category
+// counts against the known distribution, then times equity queries.
+
+static const long long expected_counts[POKER_CATEGORY_COUNT] = {
+    23294460, 58627800, 31433400, 6461620, 6180020,
+    4047644, 3473184, 224848, 41584
+};
+
+static double seconds_since(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(void) {
+    long long counts[POKER_CATEGORY_COUNT] = {0};
+    long long total = 0;
+    int cards[7];
+    struct timespec start;
+    int failures = 0;
+
+    srand((unsigned int)time(NULL));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    poker_eval_init();
+    printf("Table build:       %.2f ms\n", seconds_since(start) * 1000.0);
+
+    // Array interface: every hand built from scratch
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (cards[0] = 0; cards[0] < 46; cards[0]++)
+    for (cards[1] = cards[0] + 1; cards[1] < 47; cards[1]++)
+    for (cards[2] = cards[1] + 1; cards[2] < 48; cards[2]++)
+    for (cards[3] = cards[2] + 1; cards[3] < 49; cards[3]++)
+    for (cards[4] = cards[3] + 1; cards[4] < 50; cards[4]++)
+    for (cards[5] = cards[4] + 1; cards[5] < 51; cards[5]++)
+    for (cards[6] = cards[5] + 1; cards[6] < 52; cards[6]++) {
+        counts[poker_hand_category(poker_evaluate(cards, 7))]++;
+        total++;
+    }
+    double elapsed = seconds_since(start);
+    printf("7-card hands:      %lld in %.2f s (%.1f M hands/s, array)\n",
+           total, elapsed, total / elapsed / 1e6);
+
+    // Incremental interface: outer cards shared across the inner loops
+    PokerHand h[8];
+    long long incremental_total = 0;
+    unsigned long long checksum = 0;
+    poker_hand_clear(&h[0]);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int a = 0; a < 46; a++) { h[1] = h[0]; poker_hand_add(&h[1], a);
+    for (int b = a + 1; b < 47; b++) { h[2] = h[1]; poker_hand_add(&h[2], b);
+    for (int c = b + 1; c < 48; c++) { h[3] = h[2]; poker_hand_add(&h[3], c);
+    for (int d = c + 1; d < 49; d++) { h[4] = h[3]; poker_hand_add(&h[4], d);
+    for (int e = d + 1; e < 50; e++) { h[5] = h[4]; poker_hand_add(&h[5], e);
+    for (int f = e + 1; f < 51; f++) { h[6] = h[5]; poker_hand_add(&h[6], f);
+    for (int g = f + 1; g < 52; g++) { h[7] = h[6]; poker_hand_add(&h[7], g);
+        checksum += poker_hand_value(&h[7]);
+        incremental_total++;
+    }}}}}}}
+    elapsed = seconds_since(start);
+    printf("7-card hands:      %lld in %.2f s (%.1f M hands/s, incremental, checksum %llx)\n",
+           incremental_total, elapsed, incremental_total / elapsed / 1e6, checksum);
+
+    for (int c = POKER_CATEGORY_COUNT - 1; c >= 0; c--) {
+        int ok = counts[c] == expected_counts[c];
+        printf("  %-16s %10lld %s\n", poker_category_name((PokerCategory)c), counts[c], ok ? "ok" : "MISMATCH");
+        if (!ok) failures++;
+    }
+
+    // Equity latency: AhKh against random hands
+    int hole[2] = {12 * 4 + 0, 11 * 4 + 0};
+    int flop[3] = {10 * 4 + 0, 3 * 4 + 1, 0 * 4 + 2};
+    int threads = poker_default_threads();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PokerEquity pre = poker_equity(hole, NULL, 0, 1, 200000, threads);
+    printf("Preflop vs 1 (MC): %.1f%% equity, %lld boards, %.2f ms\n",
+           pre.equity * 100, pre.boards, seconds_since(start) * 1000.0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PokerEquity multi = poker_equity(hole, NULL, 0, 5, 200000, threads);
+    printf("Preflop vs 5 (MC): %.1f%% equity, %lld boards, %.2f ms\n",
+           multi.equity * 100, multi.boards, seconds_since(start) * 1000.0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PokerEquity post = poker_equity(hole, flop, 3, 1, 0, threads);
+    printf("Flop vs 1 (exact): %.1f%% equity, %lld boards, %.2f ms\n",
+           post.equity * 100, post.boards, seconds_since(start) * 1000.0);
+
+    // Hold'em AI decisions: many small queries back to back on the worker pool
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < 200; i++) poker_equity(hole, flop, 3, 3, 4000, threads);
+    printf("AI decision (4000):%.1f us each\n", seconds_since(start) * 1e6 / 200);
+
+    printf("Threads:           %d\n", threads);
+
+    if (pre.equity < 0.64 || pre.equity > 0.69) failures++; // AKs vs random is ~66.2%
+    if (post.boards != 1070190) failures++;                 // C(47,2) * C(45,2)
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
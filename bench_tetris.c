@@ -0,0 +1,218 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "games/tetris_engine.h"
+
+// Tetris engine. Checks the piece tables against a box rotation, two SRS
+// kicks that only the right table entry gets right, and line clears
+// that remove rows which are not next to each other. Then the AI plays
+// seeded seven-piece bags, on its own and with one piece of lookahead.
+// Every placement it is offered must rest where a hard drop would leave
+// it. It must not top out, and it must score over a million placements a
+// second.
+
+#define GAME_PIECES 2000
+#define LOOKAHEAD_PIECES 300
+#define PLACEMENTS_PER_SECOND 1000000.0
+
+static uint32_t seed_state;
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static uint32_t next_random(void) {
+    seed_state = seed_state * 1664525u + 1013904223u;
+    return seed_state >> 8;
+}
+
+// Seven-piece bags, shuffled
+static int next_piece(int* bag, int* left) {
+    if (*left == 0) {
+        for (int i = 0; i < TETRIS_PIECE_COUNT; i++) bag[i] = i;
+        for (int i = TETRIS_PIECE_COUNT - 1; i > 0; i--) {
+            int j = (int)(next_random() % (uint32_t)(i + 1));
+            int swap = bag[i];
+            bag[i] = bag[j];
+            bag[j] = swap;
+        }
+        *left = TETRIS_PIECE_COUNT;
+    }
+    return bag[--*left];
+}
+
+// Each state must be the previous one turned clockwise in its box
+static int shapes_rotate(void) {
+    for (int piece = 0; piece < TETRIS_PIECE_COUNT; piece++) {
+        int size = piece == TETRIS_I ? 4 : 3;
+        for (int rotation = 0; rotation < 4; rotation++) {
+            int cells = 0;
+            for (int row = 0; row < 4; row++) {
+                uint16_t mask = tetris_piece_row(piece, rotation, row);
+                cells += __builtin_popcount(mask);
+                if (piece == TETRIS_O) {
+                    if (mask != tetris_piece_row(piece, 0, row)) return 0;
+                    continue;
+                }
+                for (int col = 0; col < 4; col++) {
+                    int set = mask >> col & 1;
+                    // (col, row) comes from (size - 1 - row, col) of the state before
+                    int from_col = size - 1 - row, from_row = col;
+                    int was = from_row < size && from_col >= 0 &&
+                              (tetris_piece_row(piece, rotation + 3, from_row) >> from_col & 1);
+                    if (set != was) return 0;
+                }
+            }
+            if (cells != 4) return 0;
+        }
+    }
+    return 1;
+}
+
+static void fill_row(TetrisBoard* board, int row, int gap) {
+    board->rows[row] = (uint16_t)(TETRIS_FULL & ~(1u << (gap + 3)));
+}
+
+typedef struct {
+    int pieces;
+    long lines;
+    long scored;
+    double search_seconds;
+    int topped_out;
+    int misplaced;
+    int max_height;
+} GameResult;
+
+static int stack_height(const TetrisBoard* board) {
+    int top = TETRIS_HEIGHT;
+    while (top > 0 && board->rows[top - 1] == TETRIS_WALLS) top--;
+    return top;
+}
+
+// Every offered placement fits and cannot fall any further
+static int placements_rest(const TetrisBoard* board, int piece) {
+    TetrisMove moves[TETRIS_MAX_PLACEMENTS];
+    int count = tetris_placements(board, piece, moves), bad = 0;
+    for (int i = 0; i < count; i++) {
+        TetrisPosition at = {piece, moves[i].rotation, moves[i].x, moves[i].y};
+        bad += !tetris_fits(board, &at) || tetris_drop_distance(board, &at) != 0;
+    }
+    return bad;
+}
+
+static void play_game(uint32_t seed, int pieces, int lookahead, GameResult* result) {
+    TetrisBoard board;
+    TetrisMove best;
+    struct timespec start, end;
+    int bag[TETRIS_PIECE_COUNT], left = 0;
+
+    memset(result, 0, sizeof(*result));
+    seed_state = seed;
+    tetris_board_clear(&board);
+    int piece = next_piece(bag, &left), next = next_piece(bag, &left);
+    for (int i = 0; i < pieces; i++) {
+        result->misplaced += placements_rest(&board, piece);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        long scored = tetris_ai_choose(&board, piece, lookahead ? next : -1, &best);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        result->search_seconds += seconds(start, end);
+        result->scored += scored;
+        TetrisPosition at = {piece, best.rotation, best.x, best.y};
+        if (scored == 0 || stack_height(&board) > TETRIS_VISIBLE) {
+            result->topped_out = 1;
+            break;
+        }
+        result->lines += tetris_lock(&board, &at);
+        int height = stack_height(&board);
+        if (height > result->max_height) result->max_height = height;
+        result->pieces++;
+        piece = next;
+        next = next_piece(bag, &left);
+    }
+}
+
+int main(void) {
+    TetrisBoard board;
+    int failures = 0;
+
+    // T on the floor turning clockwise: tests 1 and 2 hit the floor, test 3
+    // lifts it one row and left one column
+    tetris_board_clear(&board);
+    TetrisPosition t = {TETRIS_T, 0, 3, -1};
+    int t_test = tetris_rotate(&board, &t, 1);
+    int t_kick = t_test == 3 && t.rotation == 1 && t.x == 2 && t.y == 0;
+
+    // Upright I against the left wall turning clockwise: the I table's
+    // third test pushes it two columns right
+    TetrisPosition i_piece = {TETRIS_I, 1, -2, 0};
+    int i_test = tetris_rotate(&board, &i_piece, 1);
+    int i_kick = i_test == 3 && i_piece.rotation == 2 && i_piece.x == 0 && i_piece.y == 0;
+
+    // Out in the open every turn is undone by the opposite turn
+    int round_trips = 1;
+    for (int piece = 0; piece < TETRIS_PIECE_COUNT; piece++) {
+        for (int rotation = 0; rotation < 4; rotation++) {
+            TetrisPosition at = {piece, rotation, 3, 8}, before = at;
+            round_trips &= tetris_rotate(&board, &at, 1) == 1 && tetris_rotate(&board, &at, -1) == 1 &&
+                           memcmp(&at, &before, sizeof(at)) == 0;
+        }
+    }
+
+    // Four rows open in column 9 and an upright I dropped into it
+    tetris_board_clear(&board);
+    for (int row = 0; row < 4; row++) fill_row(&board, row, 9);
+    TetrisPosition well = {TETRIS_I, 1, 7, 10};
+    well.y -= tetris_drop_distance(&board, &well);
+    int tetris_lines = tetris_lock(&board, &well);
+    int emptied = stack_height(&board) == 0;
+
+    // Rows 0 and 2 open in column 0, row 1 elsewhere: the I clears 0 and
+    // 2, and row 1 and the I's top cell come down to rows 0 and 1
+    tetris_board_clear(&board);
+    fill_row(&board, 0, 0);
+    fill_row(&board, 1, 5);
+    fill_row(&board, 2, 0);
+    TetrisPosition split = {TETRIS_I, 3, -1, 0};
+    int split_lines = tetris_lock(&board, &split);
+    int split_rows = split_lines == 2 && board.rows[0] == (uint16_t)(TETRIS_FULL & ~(1u << 8)) &&
+                     board.rows[1] == (uint16_t)(TETRIS_WALLS | (1u << 3)) && board.rows[2] == TETRIS_WALLS;
+
+    GameResult plain, ahead;
+    play_game(12345, GAME_PIECES, 0, &plain);
+    play_game(777, LOOKAHEAD_PIECES, 1, &ahead);
+
+    double plain_rate = plain.scored / plain.search_seconds;
+    double ahead_rate = ahead.scored / ahead.search_seconds;
+    printf("Tetris AI, seven-piece bags\n");
+    printf("                       pieces  lines  peak  placements   per piece  per second\n");
+    printf("  one piece          %8d %6ld %5d %11ld %8.1f us %10.2fM\n", plain.pieces, plain.lines,
+           plain.max_height, plain.scored, plain.search_seconds * 1e6 / plain.pieces, plain_rate / 1e6);
+    printf("  one-piece lookahead%8d %6ld %5d %11ld %8.1f us %10.2fM\n", ahead.pieces, ahead.lines,
+           ahead.max_height, ahead.scored, ahead.search_seconds * 1e6 / ahead.pieces, ahead_rate / 1e6);
+
+    printf("Checks\n");
+    failures += check("every state is the one before turned clockwise", shapes_rotate());
+    failures += check("T on the floor kicks up with SRS test 3", t_kick);
+    failures += check("upright I on the left wall kicks right with I test 3", i_kick);
+    failures += check("turns in open space round-trip on test 1", round_trips);
+    failures += check("I into a four-row well clears all four", tetris_lines == 4 && emptied);
+    failures += check("split clear removes rows 0 and 2 only", split_rows);
+    failures += check("every placement offered rests where it drops",
+                      plain.misplaced == 0 && ahead.misplaced == 0);
+    failures += check("AI places 2,000 pieces without topping out", !plain.topped_out);
+    failures += check("lookahead AI places 300 pieces without topping out", !ahead.topped_out);
+    failures += check("AI clears at least 3 lines per 10 pieces", plain.lines * 10 >= plain.pieces * 3L);
+    failures += check("AI scores over 1M placements a second", plain_rate > PLACEMENTS_PER_SECOND);
+    failures += check("lookahead scores over 1M placements a second", ahead_rate > PLACEMENTS_PER_SECOND);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "games/word_grades.h"
+
+// Word difficulty grading. A synthetic 300,000-word dictionary (letters
+// drawn at English frequencies, lengths 4-14, one word in ten an anagram
+// of an earlier one) is graded for Hangman and Word Scramble on every
+// core and written as an index, which must take well under a minute.
+// A sample of words is then replayed one by one against the whole
+// dictionary by a plain guesser and a plain anagram count, which must
+// give the same scores. Last, picks from the mapped index: each bucket's
+// words must have scores in its range, and a pick must cost nanoseconds.
+
+#define WORDS 300000
+#define SAMPLE 200
+#define PICKS 10000000
+#define GRADE_BUDGET_S 60.0
+
+static char storage[WORDS][16];
+static const char* words[WORDS];
+static uint16_t hangman_scores[WORDS];
+static uint16_t scramble_scores[WORDS];
+
+// English letter frequencies in hundredths of a percent, A-Z
+static const int frequencies[26] = {
+    817, 149, 278, 425, 1270, 223, 202, 609, 697, 15, 77, 403, 241,
+    675, 751, 193, 10, 599, 633, 906, 276, 98, 236, 15, 197, 7
+};
+
+static uint64_t rng = 0x2545F4914F6CDD1Dull;
+
+static uint32_t next_random(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static char random_letter(void) {
+    int roll = (int)(next_random() % 10000);
+    for (int l = 0; l < 26; l++) {
+        if (roll < frequencies[l]) return (char)('A' + l);
+        roll -= frequencies[l];
+    }
+    return 'E';
+}
+
+static int compare_words(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// The guesser played the slow way: filter the whole length class each turn
+static uint16_t reference_hangman(int target, int count) {
+    static int candidates[WORDS];
+    const char* answer = words[target];
+    size_t length = strlen(answer);
+    int n = 0, misses = 0, guesses = 0;
+    uint32_t guessed = 0;
+    for (int i = 0; i < count; i++) {
+        if (strlen(words[i]) == length) candidates[n++] = i;
+    }
+    while (n > 1) {
+        int counts[26] = {0};
+        for (int i = 0; i < n; i++) {
+            uint32_t seen = 0;
+            for (const char* c = words[candidates[i]]; *c; c++) seen |= 1u << (*c - 'A');
+            for (int l = 0; l < 26; l++) counts[l] += (seen & ~guessed) >> l & 1;
+        }
+        int letter = 0;
+        for (int l = 1; l < 26; l++) {
+            if (counts[l] > counts[letter]) letter = l;
+        }
+        guessed |= 1u << letter;
+        guesses++;
+        misses += strchr(answer, 'A' + letter) == NULL;
+
+        int kept = 0;
+        for (int i = 0; i < n; i++) {
+            const char* word = words[candidates[i]];
+            int same = 1;
+            for (size_t c = 0; c < length && same; c++) {
+                same = (word[c] == 'A' + letter) == (answer[c] == 'A' + letter);
+            }
+            if (same) candidates[kept++] = candidates[i];
+        }
+        n = kept;
+    }
+    uint32_t remaining = 0;
+    for (const char* c = answer; *c; c++) remaining |= 1u << (*c - 'A');
+    return (uint16_t)(misses << 5 | (guesses + __builtin_popcount(remaining & ~guessed)));
+}
+
+static uint16_t reference_scramble(int target, int count) {
+    int letters[26] = {0}, anagrams = 0;
+    size_t length = strlen(words[target]);
+    for (const char* c = words[target]; *c; c++) letters[*c - 'A']++;
+    for (int i = 0; i < count; i++) {
+        if (i == target || strlen(words[i]) != length) continue;
+        int other[26] = {0};
+        for (const char* c = words[i]; *c; c++) other[*c - 'A']++;
+        anagrams += memcmp(letters, other, sizeof(letters)) == 0;
+    }
+    return (uint16_t)(anagrams << 5 | (int)length);
+}
+
+static int find_word(const char* word, int count) {
+    const char** found = bsearch(&word, words, (size_t)count, sizeof(char*), compare_words);
+    return found ? (int)(found - words) : -1;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-grades-XXXXXX";
+    char path[300];
+    struct timespec start, end;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+
+    int count = 0;
+    for (int i = 0; i < WORDS; i++) {
+        char* word = storage[i];
+        if (i >= 10 && next_random() % 10 == 0) {
+            // An anagram of an earlier word
+            strcpy(word, storage[next_random() % (uint32_t)i]);
+            size_t length = strlen(word);
+            for (size_t c = length - 1; c > 0; c--) {
+                size_t other = next_random() % (c + 1);
+                char swap = word[c];
+                word[c] = word[other];
+                word[other] = swap;
+            }
+        } else {
+            int roll = (int)(next_random() % 100);
+            int length = roll < 10 ? 4 + roll % 2 : roll < 85 ? 6 + roll % 4 : 10 + roll % 5;
+            for (int c = 0; c < length; c++) word[c] = random_letter();
+            word[length] = '\0';
+        }
+        words[count++] = word;
+    }
+    qsort(words, (size_t)count, sizeof(char*), compare_words);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || strcmp(words[i], words[unique - 1]) != 0) words[unique++] = words[i];
+    }
+    count = unique;
+    printf("Word grades: %d distinct synthetic words\n", count);
+
+    // Without an index the game's own list is graded on the spot
+    static const char* const builtin[] = {"PROGRAMMING", "COMPUTER", "ALGORITHM", "FUNCTION", "VARIABLE",
+                                          "ARRAY", "LIBRARY", "COMPILER", "POINTER", "MEMORY"};
+    int fallback = word_grades_open(WORD_POOL_HANGMAN, builtin, 10) == 0;
+    const char* fallback_word = word_grades_pick(WORD_POOL_HANGMAN, WORD_GRADE_HARD, 3);
+    int fallback_picked = 0;
+    for (int i = 0; fallback_word && i < 10; i++) fallback_picked |= strcmp(builtin[i], fallback_word) == 0;
+    word_grades_close();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    word_grades_hangman(words, count, 0, hangman_scores);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double hangman_s = seconds(start, end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    word_grades_scramble(words, count, 0, scramble_scores);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double scramble_s = seconds(start, end);
+    printf("hangman guesser, all cores   %8.3f s\n", hangman_s);
+    printf("scramble anagrams, all cores %8.3f s\n", scramble_s);
+
+    if (!word_grades_path(path, sizeof(path))) return 1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int written = word_grades_write(path, words, count, 0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double write_s = seconds(start, end);
+    printf("grade and write index        %8.3f s\n", write_s);
+
+    int hangman_agree = 0, scramble_agree = 0;
+    for (int s = 0; s < SAMPLE; s++) {
+        int target = (int)(next_random() % (uint32_t)count);
+        hangman_agree += reference_hangman(target, count) == hangman_scores[target];
+        scramble_agree += reference_scramble(target, count) == scramble_scores[target];
+    }
+
+    int mapped = word_grades_open(WORD_POOL_HANGMAN, NULL, 0) == 1 && word_grades_open(WORD_POOL_SCRAMBLE, NULL, 0) == 1;
+    int in_range = 1, ordered = 1, thirds = 1;
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) {
+        const uint16_t* scores = pool == WORD_POOL_HANGMAN ? hangman_scores : scramble_scores;
+        uint32_t total = 0;
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) total += word_grades_bucket(pool, grade)->count;
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) {
+            const WordGradeBucket* bucket = word_grades_bucket(pool, grade);
+            if (bucket->count < total / 3 || bucket->count > total / 3 + 1) thirds = 0;
+            if (grade > 0 && bucket->min_score < word_grades_bucket(pool, grade - 1)->max_score) ordered = 0;
+            for (int p = 0; p < 1000; p++) {
+                int index = find_word(word_grades_pick(pool, grade, next_random()), count);
+                if (index < 0 || scores[index] < bucket->min_score || scores[index] > bucket->max_score) in_range = 0;
+            }
+        }
+        printf("%-8s pool %6u words:", pool == WORD_POOL_HANGMAN ? "hangman" : "scramble", total);
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) {
+            const WordGradeBucket* bucket = word_grades_bucket(pool, grade);
+            if (pool == WORD_POOL_HANGMAN) {
+                printf("  %s %d-%d misses", word_grades_name(grade), WORD_GRADES_MISSES(bucket->min_score),
+                       WORD_GRADES_MISSES(bucket->max_score));
+            } else {
+                printf("  %s %d-%d anagrams", word_grades_name(grade), bucket->min_score >> 5, bucket->max_score >> 5);
+            }
+        }
+        printf("\n");
+    }
+
+    size_t letters = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t p = 0; p < PICKS; p++) {
+        letters += (size_t)word_grades_pick(WORD_POOL_HANGMAN, (WordGrade)(p % 3), p * 2654435761u)[0];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double pick_ns = seconds(start, end) * 1e9 / PICKS;
+    printf("pick from a bucket           %8.1f ns\n", pick_ns);
+
+    printf("Checks\n");
+    failures += check("built-in list graded when there is no index", fallback && fallback_picked);
+    failures += check("index written", written);
+    failures += check("index mapped for both pools", mapped);
+    failures += check("hangman scores match a word-by-word guesser", hangman_agree == SAMPLE);
+    failures += check("scramble scores match a word-by-word anagram count", scramble_agree == SAMPLE);
+    failures += check("each pool is cut into thirds", thirds);
+    failures += check("buckets are ordered easy to hard", ordered);
+    failures += check("picked words score within their bucket", in_range);
+    failures += check("grading 300k words takes under a minute", write_s < GRADE_BUDGET_S);
+    failures += check("a pick takes nanoseconds", pick_ns < 1000.0 && letters > 0);
+
+    word_grades_close();
+    unlink(path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
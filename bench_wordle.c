@@ -0,0 +1,165 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "games/wordle_solver.h"
+
+// Wordle feedback matrix and solver. Reports the time to build the matrix
+// on one thread and on every core, to build-and-cache it and to map the
+// cached copy, and the cost of a suggestion over the full word list. Then
+// the solver plays every word in the list as the answer, in normal and
+// hard mode, and the average time per suggestion and guesses per game are
+// reported. The matrix must agree with direct scoring, and a suggestion
+// over the full list must take milliseconds.
+
+#define SUGGESTION_BUDGET_MS 50.0
+#define TOP 5
+
+static uint8_t built[(size_t)WORDLE_WORD_COUNT * WORDLE_WORD_COUNT];
+static uint8_t single[(size_t)WORDLE_WORD_COUNT * WORDLE_WORD_COUNT];
+static uint16_t candidates[WORDLE_WORD_COUNT];
+
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static int reset_candidates(void) {
+    for (int i = 0; i < WORDLE_WORD_COUNT; i++) candidates[i] = (uint16_t)i;
+    return WORDLE_WORD_COUNT;
+}
+
+// Plays every answer; returns the number of games not solved in six
+static int play_all(const uint8_t* matrix, int hard, int opening) {
+    struct timespec start, end;
+    WordleTurn turns[16];
+    WordleHardRules rules;
+    WordleSuggestion best;
+    long long guesses = 0, suggestions = 0;
+    int failed = 0, worst = 0;
+    double suggest_ms = 0;
+
+    for (int answer = 0; answer < WORDLE_WORD_COUNT; answer++) {
+        int count = reset_candidates();
+        int turn = 0, guess = opening;
+        while (1) {
+            int code = matrix[(size_t)guess * WORDLE_WORD_COUNT + answer];
+            turns[turn].guess = guess;
+            turns[turn].code = code;
+            turn++;
+            if (code == WORDLE_ALL_GREEN || turn == 16) break;
+            count = wordle_filter(matrix, candidates, count, guess, code);
+            if (hard) wordle_hard_rules(&rules, turns, turn);
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            wordle_suggest(matrix, candidates, count, hard ? &rules : NULL, &best, 1);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            suggest_ms += elapsed_ms(start, end);
+            suggestions++;
+            guess = best.word;
+        }
+        guesses += turn;
+        if (turn > worst) worst = turn;
+        if (turn > WORDLE_MAX_TURNS) failed++;
+    }
+
+    printf("%-6s solver: %.3f guesses/game, worst %d, %d over six, %.3f ms/suggestion\n",
+           hard ? "hard" : "normal", (double)guesses / WORDLE_WORD_COUNT, worst, failed,
+           suggest_ms / (double)suggestions);
+    return failed;
+}
+
+int main(void) {
+    static const struct {
+        const char* guess;
+        const char* answer;
+        const char* expected;           // g/y/. per letter
+    } cases[] = {
+        {"SPEED", "ABIDE", "..y.y"},
+        {"EERIE", "THEME", "y...g"},
+        {"ALLOW", "LOYAL", "yyyy."},
+        {"CRANE", "CRANE", "ggggg"},
+        {"GEESE", "ELITE", ".y..g"},
+    };
+    char dir[] = "/tmp/cli-games-wordle-XXXXXX";
+    char path[300];
+    struct timespec start, end;
+    WordleSuggestion top[TOP];
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    snprintf(path, sizeof(path), "%s/wordle_feedback.mat", dir);
+
+    printf("Wordle matrix: %d x %d words, %.1f MB\n", WORDLE_WORD_COUNT, WORDLE_WORD_COUNT,
+           (double)sizeof(built) / (1024 * 1024));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    wordle_matrix_build(single, 1);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("build, 1 thread         %8.2f ms\n", elapsed_ms(start, end));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    wordle_matrix_build(built, 0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("build, all cores        %8.2f ms\n", elapsed_ms(start, end));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    const uint8_t* matrix = wordle_matrix_open(0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    int first_source = wordle_matrix_source();
+    printf("first open (build+save) %8.2f ms\n", elapsed_ms(start, end));
+    wordle_matrix_close();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    matrix = wordle_matrix_open(0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    int second_source = wordle_matrix_source();
+    printf("cached open (mmap)      %8.3f ms\n", elapsed_ms(start, end));
+
+    int count = reset_candidates();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int shown = wordle_suggest(matrix, candidates, count, NULL, top, TOP);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double opening_ms = elapsed_ms(start, end);
+    printf("opening suggestion      %8.2f ms:", opening_ms);
+    for (int i = 0; i < shown; i++) printf(" %s %.2f", wordle_words[top[i].word], top[i].bits);
+    printf("\n");
+
+    int normal_failures = play_all(matrix, 0, top[0].word);
+    play_all(matrix, 1, top[0].word);
+
+    printf("Checks\n");
+    int mismatches = 0;
+    for (int guess = 0; guess < WORDLE_WORD_COUNT; guess += 7) {
+        for (int answer = 0; answer < WORDLE_WORD_COUNT; answer++) {
+            size_t cell = (size_t)guess * WORDLE_WORD_COUNT + answer;
+            if (matrix[cell] != wordle_feedback(wordle_words[guess], wordle_words[answer])) mismatches++;
+        }
+    }
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        int code = wordle_feedback(cases[i].guess, cases[i].answer);
+        for (int j = 0; j < WORDLE_LENGTH; j++) {
+            if (".yg"[wordle_code_digit(code, j)] != cases[i].expected[j]) mismatches++;
+        }
+    }
+    failures += check("repeated letters scored like the game", mismatches == 0);
+    failures += check("threaded build matches single-threaded build", memcmp(single, built, sizeof(built)) == 0);
+    failures += check("cached matrix matches the build", memcmp(matrix, built, sizeof(built)) == 0);
+    failures += check("first open builds the cache, second maps it",
+                      first_source == WORDLE_MATRIX_BUILT && second_source == WORDLE_MATRIX_MAPPED);
+    failures += check("full-list suggestion within 50 ms", opening_ms < SUGGESTION_BUDGET_MS);
+    failures += check("normal-mode solver wins every game in six", normal_failures == 0);
+
+    wordle_matrix_close();
+    remove(path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
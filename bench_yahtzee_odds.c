@@ -0,0 +1,190 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "games/yahtzee_odds.h"
+
+// Yahtzee category odds. Builds the 32 reroll matrices and the best-keep
+// vectors, then times the live panel over a million random dice, keeps
+// and roll counts: an update must stay well under a millisecond. The
+// odds are checked against a plain solver that rolls every die in order
+// and re-sorts the result, against the known 2,783,176 / 6^10 chance of
+// a Yahtzee in three rolls, and every matrix row must add up to 6^n.
+
+#define UPDATES 1000000
+#define SAMPLES 3000
+#define UPDATE_BUDGET_US 100.0
+
+#define CATEGORIES YAHTZEE_ODDS_CATEGORIES
+
+// Plain solver: best[r] for each sorted hand, by base-6 code
+static double reference[YAHTZEE_ODDS_MAX_ROLLS][7776][CATEGORIES];
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t next_random(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static int sorted_code(const int* dice) {
+    int sorted[5];
+    memcpy(sorted, dice, sizeof(sorted));
+    for (int i = 1; i < 5; i++) {
+        for (int j = i; j > 0 && sorted[j - 1] > sorted[j]; j--) {
+            int swap = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = swap;
+        }
+    }
+    int code = 0;
+    for (int i = 0; i < 5; i++) code = code * 6 + sorted[i] - 1;
+    return code;
+}
+
+// Average of reference[rolls_after] over every ordered roll of the free dice
+static void reference_roll(const int* dice, unsigned keep, int rolls_after, double out[CATEGORIES]) {
+    int free_dice[5], n = 0, rolled[5];
+    for (int i = 0; i < 5; i++) {
+        if (!(keep >> i & 1)) free_dice[n++] = i;
+    }
+    int outcomes = 1;
+    for (int i = 0; i < n; i++) outcomes *= 6;
+
+    for (int c = 0; c < CATEGORIES; c++) out[c] = 0;
+    for (int outcome = 0; outcome < outcomes; outcome++) {
+        memcpy(rolled, dice, sizeof(rolled));
+        for (int i = 0, rest = outcome; i < n; i++, rest /= 6) rolled[free_dice[i]] = rest % 6 + 1;
+        const double* next = reference[rolls_after][sorted_code(rolled)];
+        for (int c = 0; c < CATEGORIES; c++) out[c] += next[c];
+    }
+    for (int c = 0; c < CATEGORIES; c++) out[c] /= outcomes;
+}
+
+static void build_reference(void) {
+    int dice[5];
+    for (int rolls = 0; rolls < YAHTZEE_ODDS_MAX_ROLLS; rolls++) {
+        for (int code = 0; code < 7776; code++) {
+            int rest = code, sorted = 1;
+            for (int i = 4; i >= 0; i--, rest /= 6) dice[i] = rest % 6 + 1;
+            for (int i = 1; i < 5; i++) sorted &= dice[i - 1] <= dice[i];
+            if (!sorted) continue;
+
+            for (int c = 0; c < CATEGORIES; c++) {
+                reference[rolls][code][c] = rolls == 0 ? yahtzee_odds_target(c, dice) : 0.0;
+            }
+            for (unsigned keep = 0; rolls > 0 && keep < 32; keep++) {
+                double odds[CATEGORIES];
+                reference_roll(dice, keep, rolls - 1, odds);
+                for (int c = 0; c < CATEGORIES; c++) {
+                    if (odds[c] > reference[rolls][code][c]) reference[rolls][code][c] = odds[c];
+                }
+            }
+        }
+    }
+}
+
+int main(void) {
+    struct timespec start, end;
+    int failures = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int built = yahtzee_odds_init();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double init_ms = seconds(start, end) * 1e3;
+    printf("Yahtzee odds: %d hands, %d keep patterns\n", YAHTZEE_ODDS_HANDS, YAHTZEE_ODDS_PATTERNS);
+    printf("build matrices and best keeps %8.2f ms\n", init_ms);
+    if (!built) return 1;
+
+    // Every row is a distribution over distinct hands
+    int rows_ok = 1;
+    long entries = 0;
+    for (int pattern = 0; pattern < YAHTZEE_ODDS_PATTERNS; pattern++) {
+        for (int hand = 0; hand < YAHTZEE_ODDS_HANDS; hand++) {
+            const uint8_t *next, *ways;
+            uint32_t total, sum = 0;
+            unsigned char seen[YAHTZEE_ODDS_HANDS] = {0};
+            int count = yahtzee_odds_row(pattern, hand, &next, &ways, &total);
+            for (int k = 0; k < count; k++) {
+                sum += ways[k];
+                if (next[k] >= YAHTZEE_ODDS_HANDS || seen[next[k]]++) rows_ok = 0;
+            }
+            rows_ok &= sum == total;
+            entries += count;
+        }
+    }
+    printf("matrix entries               %8ld\n", entries);
+
+    // Random dice, keeps and rolls; the accumulator keeps the work live
+    static int dice[4096][5];
+    static unsigned keeps[4096];
+    static int rolls[4096];
+    for (int i = 0; i < 4096; i++) {
+        for (int d = 0; d < 5; d++) dice[i][d] = (int)(next_random() % 6) + 1;
+        keeps[i] = next_random() % 31;
+        rolls[i] = 1 + (int)(next_random() % YAHTZEE_ODDS_MAX_ROLLS);
+    }
+    double odds[CATEGORIES], total = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < UPDATES; i++) {
+        yahtzee_odds_panel(dice[i & 4095], keeps[i & 4095], rolls[i & 4095], odds);
+        total += odds[i % CATEGORIES];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double update_us = seconds(start, end) * 1e6 / UPDATES;
+    printf("panel update, all categories %8.2f us\n", update_us);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    build_reference();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("plain solver                 %8.2f ms\n", seconds(start, end) * 1e3);
+
+    double worst = 0;
+    for (int s = 0; s < SAMPLES; s++) {
+        int sample[5];
+        double expected[CATEGORIES];
+        for (int d = 0; d < 5; d++) sample[d] = (int)(next_random() % 6) + 1;
+        unsigned keep = next_random() % 31;
+        int left = 1 + (int)(next_random() % YAHTZEE_ODDS_MAX_ROLLS);
+        yahtzee_odds_panel(sample, keep, left, odds);
+        reference_roll(sample, keep, left - 1, expected);
+        for (int c = 0; c < CATEGORIES; c++) worst = fmax(worst, fabs(odds[c] - expected[c]));
+    }
+    printf("largest difference           %8.1e\n", worst);
+
+    int nothing[5] = {1, 2, 3, 4, 6};
+    yahtzee_odds_panel(nothing, 0, 3, odds);
+    double yahtzee = odds[11];
+    printf("Yahtzee in three rolls       %8.4f %%\n", yahtzee * 100);
+    printf("Lg. Straight in three rolls  %8.4f %%\n", odds[10] * 100);
+
+    int full[5] = {3, 3, 3, 5, 5};
+    yahtzee_odds_panel(full, 0x1F, 2, odds);
+    int kept_all = odds[8] == 1.0 && odds[11] == 0.0;
+
+    printf("Checks\n");
+    failures += check("every matrix row adds up to 6^rerolled", rows_ok);
+    failures += check("1,683 entries per hand over all patterns", entries == 1683L * YAHTZEE_ODDS_HANDS);
+    failures += check("odds match a solver that rolls every die", worst < 1e-12);
+    failures += check("Yahtzee in three rolls is 2,783,176 / 6^10",
+                      fabs(yahtzee - 2783176.0 / 60466176.0) < 1e-12);
+    failures += check("keeping every die leaves the dice as they are", kept_all);
+    failures += check("a panel update takes well under a millisecond", update_us < UPDATE_BUDGET_US && total > 0);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,308 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+// Zygote launcher against cold launches of the real cli-games binary.
+// Starts eight sessions through pseudo-terminals, one after another, and
+// drives each to the main menu and then to Yahtzee's first odds panel,
+// which follows the first roll (the first use of a precomputed table; the
+// roll's animation is the same either way). With all eight open, it reads
+// every process's memory from /proc: unique RSS (pages no other process
+// maps) and PSS (shared pages split between their users). The same is
+// then done with `cli-games --zygote` running, counting each session and
+// the launch that relays for it, plus the zygote's own share for PSS.
+// Last, killing a launch must end its session, and a different build of
+// the binary must be turned away and start cold.
+
+#define SESSIONS 8
+#define STEP_TIMEOUT_MS 10000
+#define READY_TIMEOUT_MS 30000          // The zygote builds the Wordle matrix on first start
+#define MENU_BUDGET_MS 100.0
+#define MENU_PROMPT "Please enter your choice"
+#define YAHTZEE_PROMPT "Choose:"
+#define TURN_PROMPT "What would you like to do?"
+#define ODDS_PANEL "ODDS BY END OF TURN"
+
+typedef struct {
+    int master;
+    pid_t pid;                          // The launch; for a cold launch also the session
+    size_t length;
+    char output[1 << 16];
+} Session;
+
+typedef struct {
+    double menu_ms[SESSIONS];
+    double odds_ms[SESSIONS];
+    long uss_kb;                        // Totals over the sessions
+    long pss_kb;
+    int reached;
+} Phase;
+
+static Session sessions[SESSIONS + 1];
+
+static double elapsed_ms(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) * 1e3 + (now.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median(const double* values, int count) {
+    double sorted[SESSIONS];
+    memcpy(sorted, values, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_doubles);
+    return sorted[count / 2];
+}
+
+static int launch(Session* session, const char* program) {
+    session->length = 0;
+    session->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (session->master < 0 || grantpt(session->master) != 0 || unlockpt(session->master) != 0) {
+        perror("pty");
+        return 0;
+    }
+
+    session->pid = fork();
+    if (session->pid == 0) {
+        setsid();
+        int slave = open(ptsname(session->master), O_RDWR);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        close(session->master);
+        execl(program, "cli-games", (char*)NULL);
+        _exit(127);
+    }
+    return session->pid > 0;
+}
+
+// Milliseconds from start until text shows up in new output, or -1
+static double wait_for(Session* session, const char* text, struct timespec start) {
+    session->length = 0;
+    session->output[0] = '\0';
+    for (;;) {
+        double elapsed = elapsed_ms(start);
+        if (elapsed >= STEP_TIMEOUT_MS) return -1;
+
+        struct pollfd pfd = {session->master, POLLIN, 0};
+        if (poll(&pfd, 1, STEP_TIMEOUT_MS - (int)elapsed) <= 0) continue;
+        if (session->length > sizeof(session->output) / 2) {
+            size_t keep = 256;          // Enough for a prompt split across reads
+            memmove(session->output, session->output + session->length - keep, keep);
+            session->length = keep;
+        }
+        ssize_t got = read(session->master, session->output + session->length,
+                           sizeof(session->output) - 1 - session->length);
+        if (got <= 0) return -1;
+        session->length += (size_t)got;
+        session->output[session->length] = '\0';
+        if (strstr(session->output, text)) return elapsed_ms(start);
+    }
+}
+
+static double type_and_wait(Session* session, const char* keys, const char* text) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (write(session->master, keys, strlen(keys)) < 0) return -1;
+    return wait_for(session, text, start);
+}
+
+static void close_session(Session* session) {
+    if (session->pid > 0) {
+        kill(session->pid, SIGKILL);
+        waitpid(session->pid, NULL, 0);
+    }
+    if (session->master >= 0) close(session->master);
+    session->pid = 0;
+    session->master = -1;
+}
+
+// Unique (Private_Clean + Private_Dirty) and proportional set size, in kB
+static int memory_kb(pid_t pid, long* uss, long* pss) {
+    char path[64], line[256];
+    long value;
+
+    snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int)pid);
+    FILE* file = fopen(path, "r");
+    if (!file) return 0;
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "Private_Clean: %ld", &value) == 1 || sscanf(line, "Private_Dirty: %ld", &value) == 1) {
+            *uss += value;
+        } else if (sscanf(line, "Pss: %ld", &value) == 1) {
+            *pss += value;
+        }
+    }
+    fclose(file);
+    return 1;
+}
+
+static int children_of(pid_t parent, pid_t* children, int max) {
+    char path[300], line[512];
+    int count = 0;
+
+    DIR* proc = opendir("/proc");
+    if (!proc) return 0;
+    for (struct dirent* entry; (entry = readdir(proc)) != NULL;) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+        snprintf(path, sizeof(path), "/proc/%s/stat", entry->d_name);
+        FILE* file = fopen(path, "r");
+        if (!file) continue;
+        char* name_end = fgets(line, sizeof(line), file) ? strrchr(line, ')') : NULL;
+        fclose(file);
+        int ppid;
+        char state;
+        if (name_end && sscanf(name_end + 1, " %c %d", &state, &ppid) == 2 && ppid == parent &&
+            state != 'Z' && count < max) {
+            children[count++] = (pid_t)atoi(entry->d_name);
+        }
+    }
+    closedir(proc);
+    return count;
+}
+
+// Launches every session, then measures memory with all of them open
+static void run_phase(Phase* phase, pid_t zygote) {
+    memset(phase, 0, sizeof(*phase));
+    for (int i = 0; i < SESSIONS; i++) {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        phase->menu_ms[i] = launch(&sessions[i], "./cli-games") ? wait_for(&sessions[i], MENU_PROMPT, start) : -1;
+        double title_ms = type_and_wait(&sessions[i], "21\n", YAHTZEE_PROMPT);
+        double turn_ms = title_ms >= 0 ? type_and_wait(&sessions[i], "r\n", TURN_PROMPT) : -1;
+        phase->odds_ms[i] = turn_ms >= 0 ? type_and_wait(&sessions[i], "r\n", ODDS_PANEL) : -1;
+        if (phase->menu_ms[i] >= 0 && phase->odds_ms[i] >= 0) phase->reached++;
+    }
+
+    for (int i = 0; i < SESSIONS; i++) memory_kb(sessions[i].pid, &phase->uss_kb, &phase->pss_kb);
+    if (zygote > 0) {
+        pid_t forked[SESSIONS + 4];
+        int count = children_of(zygote, forked, SESSIONS + 4);
+        for (int i = 0; i < count; i++) memory_kb(forked[i], &phase->uss_kb, &phase->pss_kb);
+        long zygote_uss = 0;
+        memory_kb(zygote, &zygote_uss, &phase->pss_kb);
+    }
+}
+
+static int zygote_ready(const char* dir) {
+    struct sockaddr_un address;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s/zygote-%ld.sock", dir, (long)getuid());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    int ready = fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+    if (fd >= 0) close(fd);
+    return ready;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-zygote-XXXXXX";
+    char command[256], copy[128];
+    struct timespec start;
+    Phase cold, zygote;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    setenv("TERM", "xterm", 1);
+    unsetenv("CLI_GAMES_ZYGOTE");
+    for (int i = 0; i <= SESSIONS; i++) sessions[i].master = -1;
+
+    // No zygote yet: every launch falls back to a cold start
+    run_phase(&cold, 0);
+    for (int i = 0; i < SESSIONS; i++) close_session(&sessions[i]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pid_t server = fork();
+    if (server == 0) {
+        int null_fd = open("/dev/null", O_RDWR);
+        dup2(null_fd, STDIN_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        execl("./cli-games", "cli-games", "--zygote", (char*)NULL);
+        _exit(127);
+    }
+    while (server > 0 && !zygote_ready(dir) && elapsed_ms(start) < READY_TIMEOUT_MS) usleep(2000);
+    double ready_ms = elapsed_ms(start);
+    run_phase(&zygote, server);
+
+    pid_t forked[SESSIONS + 4];
+    int served = children_of(server, forked, SESSIONS + 4);
+
+    // Killing a launch hangs up its session, as closing a terminal does
+    close_session(&sessions[0]);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int left = served;
+    while (left >= served && elapsed_ms(start) < 2000) {
+        usleep(5000);
+        left = children_of(server, forked, SESSIONS + 4);
+    }
+    int hung_up = served == SESSIONS && left == SESSIONS - 1;
+
+    // A rebuilt binary is a different file: it must not get an old zygote's session
+    snprintf(copy, sizeof(copy), "%s/cli-games-copy", dir);
+    snprintf(command, sizeof(command), "cp ./cli-games %s", copy);
+    int copied = system(command) == 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double copy_menu_ms = copied && launch(&sessions[SESSIONS], copy) ?
+                          wait_for(&sessions[SESSIONS], MENU_PROMPT, start) : -1;
+    int stale_cold = copy_menu_ms >= 0 && children_of(server, forked, SESSIONS + 4) == left;
+
+    for (int i = 0; i <= SESSIONS; i++) close_session(&sessions[i]);
+    int remaining = children_of(server, forked, SESSIONS + 4);
+    for (int i = 0; i < remaining; i++) kill(forked[i], SIGKILL);
+    if (server > 0) {
+        kill(server, SIGTERM);
+        waitpid(server, NULL, 0);
+    }
+
+    printf("Zygote launcher: %d sessions, to the menu then a Yahtzee odds panel\n", SESSIONS);
+    printf("                                   cold      zygote\n");
+    printf("time to menu (median)          %7.1f ms %7.1f ms\n", median(cold.menu_ms, SESSIONS),
+           median(zygote.menu_ms, SESSIONS));
+    printf("roll to first odds (median)    %7.1f ms %7.1f ms\n", median(cold.odds_ms, SESSIONS),
+           median(zygote.odds_ms, SESSIONS));
+    printf("unique RSS per session         %7ld kB %7ld kB  (zygote: session + launch)\n",
+           cold.uss_kb / SESSIONS, zygote.uss_kb / SESSIONS);
+    printf("PSS per session                %7ld kB %7ld kB  (zygote: its share included)\n",
+           cold.pss_kb / SESSIONS, zygote.pss_kb / SESSIONS);
+    printf("zygote ready after             %7.1f ms (tables built once)\n", ready_ms);
+
+    printf("Checks\n");
+    failures += check("every cold launch reached the menu and the odds", cold.reached == SESSIONS);
+    failures += check("every zygote launch ran as a forked session", zygote.reached == SESSIONS && served == SESSIONS);
+    failures += check("less unique memory per session from the zygote", zygote.uss_kb < cold.uss_kb);
+    failures += check("first odds panel sooner: the tables are already built",
+                      median(zygote.odds_ms, SESSIONS) < median(cold.odds_ms, SESSIONS));
+    failures += check("time to menu under 100 ms either way",
+                      median(cold.menu_ms, SESSIONS) < MENU_BUDGET_MS && median(zygote.menu_ms, SESSIONS) < MENU_BUDGET_MS);
+    failures += check("killing a launch ends its session", hung_up);
+    failures += check("another build of the binary starts cold", stale_cold);
+
+    snprintf(command, sizeof(command), "rm -rf %s", dir);
+    if (system(command) != 0) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
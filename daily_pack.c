@@ -0,0 +1,37 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "games/daily.h"
+
+// Batch job for the daily challenges: generates the next days' content on
+// every core and writes the pack the games load from the shared directory.
+//
+//   ./daily_pack [days] [threads]      (make daily: 30 days from today)
+
+int main(int argc, char** argv) {
+    int days = argc > 1 ? atoi(argv[1]) : 30;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    int first_day = daily_today();
+    char path[512], first[16], last[16];
+    struct timespec start, end;
+
+    if (days <= 0 || !daily_pack_path(path, sizeof(path))) {
+        fprintf(stderr, "usage: %s [days] [threads]\n", argv[0]);
+        return 1;
+    }
+    daily_date(first_day, first, sizeof(first));
+    daily_date(first_day + days - 1, last, sizeof(last));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ok = daily_pack_write(path, first_day, days, threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (!ok) {
+        fprintf(stderr, "could not write %s\n", path);
+        return 1;
+    }
+    printf("Daily challenges %s to %s (%d days) written to %s in %.2f s\n", first, last, days, path,
+           (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include "games.h"
+#include "daily.h"
+#include "screen.h"
 #include <time.h>
 #include <stdlib.h>
 
@@ -14,10 +16,12 @@ typedef struct {
     int moved;
     int game_won;
     int game_over;
+    int daily;                  // Tiles come from today's shared stream
+    uint64_t spawn_stream;
 } Game2048;
 
 // Function prototypes
-void init_2048_game(Game2048* game);
+void init_2048_game(Game2048* game, int daily);
 void display_2048_grid(const Game2048* game);
 void display_2048_rules(void);
 void add_random_tile(Game2048* game);
@@ -33,32 +37,35 @@ int can_merge(const Game2048* game);
 void play_2048(void) {
     Game2048 game;
     char input;
+    char line[16];
     
     display_2048_rules();
-    printf("Press Enter to start...\n");
-    getchar();
+    printf("Press Enter to start, or D then Enter for today's daily challenge...\n");
+    int daily = fgets(line, sizeof(line), stdin) && toupper((unsigned char)line[0]) == 'D';
     
-    init_2048_game(&game);
+    init_2048_game(&game, daily);
+    screen_invalidate();
     
     while (!game.game_over) {
-        #ifdef _WIN32
-            system("cls");
-        #else
-            system("clear");
-        #endif
-        
+        // Each frame is composed in full; only the tiles and score that
+        // changed reach the terminal
+        screen_begin();
         display_2048_grid(&game);
         
         if (game.game_won && !game.game_over) {
-            printf("\n*** CONGRATULATIONS! You reached 2048! ***\n");
-            printf("Continue playing? (y/n): ");
+            screen_printf("\n*** CONGRATULATIONS! You reached 2048! ***\n");
+            screen_printf("Continue playing? (y/n): ");
+            screen_present();
             input = getchar();
             getchar(); // consume newline
             if (input == 'n' || input == 'N') break;
             game.game_won = 0; // Continue playing
+            screen_begin();
+            display_2048_grid(&game);
         }
         
-        printf("\nUse WASD to move tiles (Q to quit): ");
+        screen_printf("\nUse WASD to move tiles (Q to quit): ");
+        screen_present();
         input = getchar();
         if (input != '\n') {
             getchar(); // consume newline if needed
@@ -100,32 +107,29 @@ void play_2048(void) {
     }
     
     // Game over screen
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
-    
+    screen_begin();
     display_2048_grid(&game);
-    printf("\n");
-    printf("+==========================================+\n");
-    printf("|               GAME OVER!                 |\n");
-    printf("+==========================================+\n");
-    printf("| Final Score: %-27d |\n", game.score);
+    screen_printf("\n");
+    screen_printf("+==========================================+\n");
+    screen_printf("|               GAME OVER!                 |\n");
+    screen_printf("+==========================================+\n");
+    screen_printf("| Final Score: %-27d |\n", game.score);
     if (game.game_won) {
-        printf("| Status: YOU WON! [TROPHY]                |\n");
+        screen_printf("| Status: YOU WON! [TROPHY]                |\n");
     } else {
-        printf("| Status: No more moves possible           |\n");
+        screen_printf("| Status: No more moves possible           |\n");
     }
-    printf("| Thanks for playing 2048!                 |\n");
-    printf("+==========================================+\n");
+    screen_printf("| Thanks for playing 2048!                 |\n");
+    screen_printf("+==========================================+\n");
     
-    printf("\nPress Enter to return to main menu...");
+    screen_printf("\nPress Enter to return to main menu...");
+    screen_present();
     getchar();
 }
 
-// Initialize the game
-void init_2048_game(Game2048* game) {
+// Initialize the game; a daily game draws every tile from today's stream,
+// so the same moves give everyone the same board
+void init_2048_game(Game2048* game, int daily) {
     // Clear the grid
     for (int i = 0; i < GRID_SIZE; i++) {
         for (int j = 0; j < GRID_SIZE; j++) {
@@ -137,6 +141,8 @@ void init_2048_game(Game2048* game) {
     game->moved = 0;
     game->game_won = 0;
     game->game_over = 0;
+    game->daily = daily;
+    game->spawn_stream = daily_seed(DAILY_2048, daily_today());
     
     // Seed random number generator
     srand(time(NULL));
@@ -165,28 +171,28 @@ void display_2048_rules(void) {
     printf("+==========================================+\n\n");
 }
 
-// Display the current grid
+// Compose the current grid into the screen model
 void display_2048_grid(const Game2048* game) {
-    printf("\n+==========================================+\n");
-    printf("|               2048 GAME                  |\n");
-    printf("+==========================================+\n");
-    printf("| Score: %-30d |\n", game->score);
-    printf("+==========================================+\n");
+    screen_printf("\n+==========================================+\n");
+    screen_printf("|               2048 %-22s|\n", game->daily ? "DAILY" : "GAME");
+    screen_printf("+==========================================+\n");
+    screen_printf("| Score: %-30d |\n", game->score);
+    screen_printf("+==========================================+\n");
     
-    printf("\n");
+    screen_printf("\n");
     for (int i = 0; i < GRID_SIZE; i++) {
-        printf("+------+------+------+------+\n");
-        printf("|");
+        screen_printf("+------+------+------+------+\n");
+        screen_printf("|");
         for (int j = 0; j < GRID_SIZE; j++) {
             if (game->grid[i][j] == EMPTY_CELL) {
-                printf("      |");
+                screen_printf("      |");
             } else {
-                printf(" %4d |", game->grid[i][j]);
+                screen_printf(" %4d |", game->grid[i][j]);
             }
         }
-        printf("\n");
+        screen_printf("\n");
     }
-    printf("+------+------+------+------+\n");
+    screen_printf("+------+------+------+------+\n");
 }
 
 // Add a random tile (2 or 4) to an empty cell
@@ -206,12 +212,13 @@ void add_random_tile(Game2048* game) {
     }
     
     if (empty_count > 0) {
-        int random_index = rand() % empty_count;
+        int random_index = game->daily ? daily_below(&game->spawn_stream, empty_count) : rand() % empty_count;
         int row = empty_cells[random_index][0];
         int col = empty_cells[random_index][1];
         
         // 90% chance for 2, 10% chance for 4
-        game->grid[row][col] = (rand() % 10 == 0) ? 4 : 2;
+        int roll = game->daily ? daily_below(&game->spawn_stream, 10) : rand() % 10;
+        game->grid[row][col] = (roll == 0) ? 4 : 2;
     }
 }
 
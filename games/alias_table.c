@@ -0,0 +1,92 @@
+/*
+ * Alias Tables for Weighted Sampling
+ * Part of CLI Games Pack v2.1
+ *
+ * Vose's construction: scale every weight by the outcome count so the
+ * average column is exactly "full" (the weight total), then repeatedly pair
+ * an under-full column with an over-full one. The under-full column keeps
+ * its own share and borrows the rest from the over-full outcome, whose
+ * remaining mass goes back on the appropriate worklist. Scaled weights are
+ * integers, so the worklists always drain together.
+ */
+
+#include "games.h"
+#include "alias_table.h"
+
+void fast_rng_seed(FastRng* rng, uint64_t seed) {
+    rng->state = seed;
+    fast_rng_next(rng);     // Step once so nearby seeds diverge immediately
+}
+
+void fast_rng_seed_from_rand(FastRng* rng) {
+    uint64_t seed = 0;
+    for (int i = 0; i < 4; i++) {
+        seed = (seed << 16) ^ (uint64_t)rand();     // RAND_MAX may be only 15 bits
+    }
+    fast_rng_seed(rng, seed);
+}
+
+int alias_table_build(AliasTable* table, const uint32_t* weights, int count) {
+    uint64_t scaled[ALIAS_MAX_OUTCOMES];
+    uint8_t small[ALIAS_MAX_OUTCOMES];
+    uint8_t large[ALIAS_MAX_OUTCOMES];
+    int small_count = 0;
+    int large_count = 0;
+    uint64_t total = 0;
+
+    if (count <= 0 || count > ALIAS_MAX_OUTCOMES) return 0;
+    for (int i = 0; i < count; i++) total += weights[i];
+    if (total == 0) return 0;
+
+    table->count = count;
+    for (int i = 0; i < count; i++) {
+        scaled[i] = (uint64_t)weights[i] * (uint64_t)count;
+        if (scaled[i] < total) {
+            small[small_count++] = (uint8_t)i;
+        } else {
+            large[large_count++] = (uint8_t)i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int lender = large[large_count - 1];
+        int column = small[--small_count];
+
+        table->threshold[column] = (uint32_t)((double)scaled[column] / (double)total * 4294967296.0);
+        table->alias[column] = (uint8_t)lender;
+
+        scaled[lender] -= total - scaled[column];
+        if (scaled[lender] < total) {
+            large_count--;
+            small[small_count++] = (uint8_t)lender;
+        }
+    }
+
+    // Whatever is left is exactly full: the column always keeps its outcome
+    while (large_count > 0) {
+        int column = large[--large_count];
+        table->threshold[column] = UINT32_MAX;
+        table->alias[column] = (uint8_t)column;
+    }
+    return 1;
+}
+
+void alias_table_sample_batch(const AliasTable* table, FastRng* rng, uint8_t* out, int count) {
+    FastRng local = *rng;       // Keep the state in a register for the loop
+    for (int i = 0; i < count; i++) {
+        out[i] = (uint8_t)alias_table_sample(table, &local);
+    }
+    *rng = local;
+}
+
+double alias_table_probability(const AliasTable* table, int outcome) {
+    double probability = 0.0;
+
+    if (outcome < 0 || outcome >= table->count) return 0.0;
+    for (int column = 0; column < table->count; column++) {
+        double keep = (double)table->threshold[column] / 4294967296.0;
+        if (column == outcome) probability += keep;
+        if (table->alias[column] == outcome) probability += 1.0 - keep;
+    }
+    return probability / table->count;
+}
@@ -0,0 +1,61 @@
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <stdint.h>
+
+/*
+ * O(1) weighted sampling with Walker/Vose alias tables.
+ *
+ * A table is built once per distribution from integer weights. Every
+ * column holds its own outcome with some probability and an alias outcome
+ * otherwise, so a draw is one 64-bit random number: the high half picks the
+ * column and the low half decides between the column and its alias. The
+ * build uses exact integer arithmetic; the only error is rounding each
+ * column's threshold to 32 bits (below 2^-32 per outcome).
+ *
+ * FastRng is SplitMix64: one 64-bit word of state, a few multiplies per
+ * draw, and no hidden global state, so simulators can own one per thread.
+ */
+
+#define ALIAS_MAX_OUTCOMES 64
+
+typedef struct {
+    uint64_t state;
+} FastRng;
+
+typedef struct {
+    int count;
+    uint32_t threshold[ALIAS_MAX_OUTCOMES];    // Keep the column when low word < threshold
+    uint8_t alias[ALIAS_MAX_OUTCOMES];
+} AliasTable;
+
+void fast_rng_seed(FastRng* rng, uint64_t seed);
+void fast_rng_seed_from_rand(FastRng* rng);    // Follows srand() so games stay reproducible
+
+static inline uint64_t fast_rng_next(FastRng* rng) {
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform integer in [0, bound) without modulo bias worth measuring (bound <= 2^32)
+static inline uint32_t fast_rng_below(FastRng* rng, uint32_t bound) {
+    return (uint32_t)(((fast_rng_next(rng) >> 32) * (uint64_t)bound) >> 32);
+}
+
+// Returns 1 on success, 0 for an empty table, too many outcomes or all-zero weights
+int alias_table_build(AliasTable* table, const uint32_t* weights, int count);
+
+static inline int alias_table_sample(const AliasTable* table, FastRng* rng) {
+    uint64_t bits = fast_rng_next(rng);
+    int column = (int)(((bits >> 32) * (uint64_t)table->count) >> 32);
+    return (uint32_t)bits < table->threshold[column] ? column : table->alias[column];
+}
+
+void alias_table_sample_batch(const AliasTable* table, FastRng* rng, uint8_t* out, int count);
+
+// Probability the table actually assigns to an outcome (for tests and displays)
+double alias_table_probability(const AliasTable* table, int outcome);
+
+#endif // ALIAS_TABLE_H
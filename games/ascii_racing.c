@@ -1,14 +1,13 @@
 #include "games.h"
+#include "flight_recorder.h"
+#include "metrics.h"
+#include "terminal.h"
 #ifdef _WIN32
     #include <windows.h>
     #include <conio.h>
-    #define SLEEP(ms) Sleep(ms)
     #define CLEAR_SCREEN() system("cls")
 #else
     #include <unistd.h>
-    #include <termios.h>
-    #include <fcntl.h>
-    #define SLEEP(ms) usleep(ms * 1000)
     #define CLEAR_SCREEN() system("clear")
 #endif
 
@@ -18,6 +17,9 @@
 #define MAX_OBSTACLES 5
 #define INITIAL_SPEED 300
 #define SPEED_INCREASE 10
+#define MAX_CATCH_UP_TICKS 3    // Ticks replayed after a stall before resyncing
+#define JITTER_WINDOW 64
+#define FRAME_LINE 64           // Info lines are padded so each frame overwrites the last
 
 // Game structures
 typedef struct {
@@ -30,36 +32,25 @@ typedef struct {
     int y;
 } Car;
 
+// Tick timing for the debug overlay (all in microseconds)
+typedef struct {
+    uint32_t lateness[JITTER_WINDOW];   // How far past its deadline each tick started
+    int count;
+    int next;
+    uint32_t last_render;
+    int resyncs;
+} TickStats;
+
 // Global game variables
 static Car player_car;
 static Obstacle obstacles[MAX_OBSTACLES];
 static int game_speed;
 static int score;
+static int score_threshold;
 static int game_running;
-
-// Function to check if a key is pressed (cross-platform)
-#ifdef _WIN32
-int kbhit(void) {
-    return _kbhit();
-}
-
-int get_key(void) {
-    return _getch();
-}
-#else
-int kbhit(void) {
-    int ch = getchar();
-    if (ch != EOF) {
-        ungetc(ch, stdin);
-        return 1;
-    }
-    return 0;
-}
-
-int get_key(void) {
-    return getchar();
-}
-#endif
+static int show_overlay;
+static TickStats tick_stats;
+static char frame[(TRACK_HEIGHT + 10) * (FRAME_LINE + 2)];
 
 // Function to move cursor to specific position
 void goto_xy(int x, int y) {
@@ -103,7 +94,9 @@ void init_racing_game(void) {
     player_car.y = TRACK_HEIGHT - 2;
     game_speed = INITIAL_SPEED;
     score = 0;
+    score_threshold = 100;
     game_running = 1;
+    memset(&tick_stats, 0, sizeof(tick_stats));
     
     // Initialize all obstacles as inactive
     for (int i = 0; i < MAX_OBSTACLES; i++) {
@@ -115,58 +108,79 @@ void init_racing_game(void) {
     srand(time(NULL));
 }
 
-// Draw the game track with borders
+// Append one padded line to the frame buffer
+static int frame_line(int used, const char* text) {
+    return used + snprintf(frame + used, sizeof(frame) - (size_t)used, "%-*s\n", FRAME_LINE, text);
+}
+
+// Draw the game track with borders. The whole frame is composed in memory
+// and written in one go over the previous one, so a frame costs a single
+// write instead of a screen clear plus hundreds of tiny printf calls.
 void draw_track(void) {
-    CLEAR_SCREEN();
+    char line[FRAME_LINE + 1];
+    int used = 0;
     
-    // Draw top border
-    printf("+");
-    for (int i = 0; i < TRACK_WIDTH; i++) {
-        printf("-");
-    }
-    printf("+\n");
+    // Draw top and bottom border
+    char border[TRACK_WIDTH + 3];
+    border[0] = '+';
+    memset(border + 1, '-', TRACK_WIDTH);
+    border[TRACK_WIDTH + 1] = '+';
+    border[TRACK_WIDTH + 2] = '\0';
+    used = frame_line(used, border);
     
     // Draw track with side borders
     for (int y = 0; y < TRACK_HEIGHT; y++) {
-        printf("|");
+        line[0] = '|';
+        memset(line + 1, ' ', TRACK_WIDTH);
+        line[TRACK_WIDTH + 1] = '|';
+        line[TRACK_WIDTH + 2] = '\0';
         
-        for (int x = 0; x < TRACK_WIDTH; x++) {
-            int is_car = (x == player_car.x && y == player_car.y);
-            int is_obstacle = 0;
-            
-            // Check if there's an obstacle at this position
-            for (int i = 0; i < MAX_OBSTACLES; i++) {
-                if (obstacles[i].active && obstacles[i].x == x && obstacles[i].y == y) {
-                    is_obstacle = 1;
-                    break;
-                }
-            }
-            
-            if (is_car) {
-                printf("A");  // Player car
-            } else if (is_obstacle) {
-                printf("X");  // Obstacle
-            } else {
-                printf(" ");  // Empty space
+        for (int i = 0; i < MAX_OBSTACLES; i++) {
+            if (obstacles[i].active && obstacles[i].y == y) {
+                line[obstacles[i].x + 1] = 'X';  // Obstacle
             }
         }
-        
-        printf("|\n");
+        if (player_car.y == y) {
+            line[player_car.x + 1] = 'A';  // Player car
+        }
+        used = frame_line(used, line);
     }
+    used = frame_line(used, border);
+    
+    // Display game info
+    used = frame_line(used, "");
+    used = frame_line(used, "ASCII RACING GAME");
+    snprintf(line, sizeof(line), "Score: %d", score);
+    used = frame_line(used, line);
+    snprintf(line, sizeof(line), "Speed Level: %d", (INITIAL_SPEED - game_speed) / SPEED_INCREASE + 1);
+    used = frame_line(used, line);
+    used = frame_line(used, "");
+    used = frame_line(used, "Controls: A/D or Left/Right arrows to move, Q to quit");
+    used = frame_line(used, "Avoid the obstacles (X)! J toggles the timing overlay.");
     
-    // Draw bottom border
-    printf("+");
-    for (int i = 0; i < TRACK_WIDTH; i++) {
-        printf("-");
+    // Debug overlay: how late ticks start relative to their deadlines
+    if (show_overlay && tick_stats.count > 0) {
+        uint32_t worst = 0;
+        uint64_t sum = 0;
+        for (int i = 0; i < tick_stats.count; i++) {
+            sum += tick_stats.lateness[i];
+            if (tick_stats.lateness[i] > worst) worst = tick_stats.lateness[i];
+        }
+        uint32_t last = tick_stats.lateness[(tick_stats.next + JITTER_WINDOW - 1) % JITTER_WINDOW];
+        snprintf(line, sizeof(line), "[tick %dms] jitter last %.2fms avg %.2fms max %.2fms",
+                 game_speed, last / 1000.0, (double)sum / tick_stats.count / 1000.0, worst / 1000.0);
+        used = frame_line(used, line);
+        snprintf(line, sizeof(line), "[render %.2fms] resyncs %d (last %d ticks)",
+                 tick_stats.last_render / 1000.0, tick_stats.resyncs, tick_stats.count);
+        used = frame_line(used, line);
+    } else {
+        used = frame_line(used, "");
+        used = frame_line(used, "");
     }
-    printf("+\n");
     
-    // Display game info
-    printf("\nASCII RACING GAME\n");
-    printf("Score: %d\n", score);
-    printf("Speed Level: %d\n", (INITIAL_SPEED - game_speed) / SPEED_INCREASE + 1);
-    printf("\nControls: A/D or Left/Right arrows to move, Q to quit\n");
-    printf("Avoid the obstacles (X) and survive as long as possible!\n");
+    goto_xy(0, 0);
+    fwrite(frame, 1, (size_t)used, stdout);
+    fflush(stdout);
 }
 
 // Spawn new obstacles randomly
@@ -211,76 +225,49 @@ int check_collision(void) {
     return 0;  // No collision
 }
 
-// Handle player input
-void handle_input(void) {
-    if (kbhit()) {
-        int key = get_key();
-        
-        // Handle different key inputs
+// Handle every key that is waiting; returns 1 if anything changed on screen
+int handle_input(void) {
+    int changed = 0;
+    int key;
+    
+    while ((key = terminal_read_key()) != TERM_KEY_NONE) {
+        flight_recorder_input(key);
         switch (key) {
             case 'a':
             case 'A':
+            case TERM_KEY_LEFT:
                 if (player_car.x > 0) {
                     player_car.x--;
+                    changed = 1;
                 }
                 break;
                 
             case 'd':
             case 'D':
+            case TERM_KEY_RIGHT:
                 if (player_car.x < TRACK_WIDTH - 1) {
                     player_car.x++;
+                    changed = 1;
                 }
                 break;
                 
+            case 'j':
+            case 'J':
+                show_overlay = !show_overlay;
+                changed = 1;
+                break;
+                
             case 'q':
             case 'Q':
                 game_running = 0;
                 break;
-                
-            // Handle arrow keys (platform specific)
-#ifdef _WIN32
-            case 224:  // Arrow key prefix on Windows
-                key = get_key();
-                switch (key) {
-                    case 75:  // Left arrow
-                        if (player_car.x > 0) {
-                            player_car.x--;
-                        }
-                        break;
-                    case 77:  // Right arrow
-                        if (player_car.x < TRACK_WIDTH - 1) {
-                            player_car.x++;
-                        }
-                        break;
-                }
-                break;
-#else
-            case 27:  // ESC sequence for arrow keys on Unix
-                if (kbhit() && get_key() == 91) {  // [
-                    key = get_key();
-                    switch (key) {
-                        case 68:  // Left arrow
-                            if (player_car.x > 0) {
-                                player_car.x--;
-                            }
-                            break;
-                        case 67:  // Right arrow
-                            if (player_car.x < TRACK_WIDTH - 1) {
-                                player_car.x++;
-                            }
-                            break;
-                    }
-                }
-                break;
-#endif
         }
     }
+    return changed;
 }
 
 // Increase game difficulty over time
 void increase_difficulty(void) {
-    static int score_threshold = 100;
-    
     if (score >= score_threshold && game_speed > 100) {
         game_speed -= SPEED_INCREASE;
         score_threshold += 100;
@@ -349,29 +336,61 @@ void play_ascii_racing(void) {
     // Initialize game
     init_racing_game();
     hide_cursor();
+    CLEAR_SCREEN();
+    terminal_raw_begin();
+    flight_recorder_mark("racing: game loop");
     
-    // Main game loop
+    // Main game loop: obstacles advance on absolute deadlines, so the tick
+    // rate stays exactly game_speed no matter how long input or drawing take
+    uint64_t next_tick = terminal_now_us() + (uint64_t)game_speed * 1000u;
+    draw_track();
     while (game_running) {
-        // Handle player input
-        handle_input();
+        // Sleep until a key arrives or the next tick is due
+        if (terminal_wait_input(next_tick)) {
+            if (handle_input()) {
+                if (check_collision()) {
+                    game_running = 0;
+                    break;
+                }
+                draw_track();
+            }
+            continue;
+        }
         
-        // Update game state
-        spawn_obstacles();
-        update_obstacles();
-        increase_difficulty();
+        uint64_t now = terminal_now_us();
+        uint32_t lateness = (uint32_t)(now - next_tick);
+        tick_stats.lateness[tick_stats.next] = lateness;
+        tick_stats.next = (tick_stats.next + 1) % JITTER_WINDOW;
+        if (tick_stats.count < JITTER_WINDOW) tick_stats.count++;
         
-        // Check for collisions
-        if (check_collision()) {
-            game_running = 0;
-            break;
+        // Run every tick that is due (after a stall, at most a few)
+        int ticks = 0;
+        while (game_running && now >= next_tick && ticks < MAX_CATCH_UP_TICKS) {
+            spawn_obstacles();
+            update_obstacles();
+            increase_difficulty();
+            
+            // Check for collisions
+            if (check_collision()) {
+                game_running = 0;
+            }
+            next_tick += (uint64_t)game_speed * 1000u;
+            ticks++;
+        }
+        if (!game_running) break;
+        if (now >= next_tick) {
+            next_tick = now + (uint64_t)game_speed * 1000u;   // Too far behind: resync
+            tick_stats.resyncs++;
         }
         
         // Draw the current game state
         draw_track();
-        
-        // Control game speed
-        SLEEP(game_speed);
+        uint32_t tick_us = (uint32_t)(terminal_now_us() - now);
+        tick_stats.last_render = tick_us;
+        flight_recorder_tick(tick_us);
+        metrics_observe(METRICS_TICK_US, tick_us);
     }
+    terminal_raw_end();
     
     // Show cursor again and display game over
     show_cursor();
@@ -1,22 +1,10 @@
 #include "games.h"
+#include "cards.h"
+#include "ratings.h"
 
-#define DECK_SIZE 52
 #define MAX_HAND_SIZE 10
 #define STARTING_CHIPS 100
 
-typedef enum {
-    HEARTS, DIAMONDS, CLUBS, SPADES
-} Suit;
-
-typedef enum {
-    ACE = 1, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING
-} Rank;
-
-typedef struct {
-    Suit suit;
-    Rank rank;
-} Card;
-
 typedef struct {
     Card cards[MAX_HAND_SIZE];
     int card_count;
@@ -26,12 +14,6 @@ typedef struct {
     int is_blackjack;
 } Hand;
 
-typedef struct {
-    Card deck[DECK_SIZE];
-    int cards_left;
-    int current_card;
-} Deck;
-
 typedef struct {
     Hand player_hand;
     Hand dealer_hand;
@@ -43,10 +25,6 @@ typedef struct {
     int blackjacks;
 } BlackjackGame;
 
-const char* suit_names[] = {"Hearts", "Diamonds", "Clubs", "Spades"};
-const char* suit_symbols[] = {"H", "D", "C", "S"};
-const char* rank_names[] = {"", "A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
-
 void display_blackjack_rules(void) {
     printf("\n===========================================\n");
     printf("             BLACKJACK (21)\n");
@@ -61,42 +39,6 @@ void display_blackjack_rules(void) {
     printf("-------------------------------------------\n");
 }
 
-void initialize_deck(Deck* deck) {
-    int index = 0;
-    for (int suit = 0; suit < 4; suit++) {
-        for (int rank = 1; rank <= 13; rank++) {
-            deck->deck[index].suit = (Suit)suit;
-            deck->deck[index].rank = (Rank)rank;
-            index++;
-        }
-    }
-    deck->cards_left = DECK_SIZE;
-    deck->current_card = 0;
-}
-
-void shuffle_deck(Deck* deck) {
-    for (int i = 0; i < DECK_SIZE; i++) {
-        int j = rand() % DECK_SIZE;
-        Card temp = deck->deck[i];
-        deck->deck[i] = deck->deck[j];
-        deck->deck[j] = temp;
-    }
-    deck->current_card = 0;
-    deck->cards_left = DECK_SIZE;
-}
-
-Card deal_card(Deck* deck) {
-    if (deck->cards_left <= 0) {
-        printf("*** Reshuffling deck... ***\n");
-        shuffle_deck(deck);
-    }
-    
-    Card card = deck->deck[deck->current_card];
-    deck->current_card++;
-    deck->cards_left--;
-    return card;
-}
-
 int get_card_value(Rank rank) {
     if (rank >= JACK) return 10;
     if (rank == ACE) return 11; // Will be adjusted in calculate_hand_value
@@ -135,10 +77,6 @@ void add_card_to_hand(Hand* hand, Card card) {
     }
 }
 
-void display_card(Card card) {
-    printf("[%s%s]", rank_names[card.rank], suit_symbols[card.suit]);
-}
-
 void display_hand(const Hand* hand, const char* owner, int hide_first) {
     printf("%s's hand: ", owner);
     
@@ -278,6 +216,8 @@ void determine_blackjack_winner(BlackjackGame* game) {
     }
     
     game->player_chips += payout;
+    ratings_record_match(RATING_GAME_BLACKJACK, ratings_local_player(), "Blackjack Dealer",
+                         payout > 0 ? RATING_WIN : payout < 0 ? RATING_LOSS : RATING_DRAW);
     
     if (payout > 0) {
         printf("You won %d chips!\n", payout);
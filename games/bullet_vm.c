@@ -0,0 +1,365 @@
+/*
+ * Bullet-Pattern Scripts
+ * Part of CLI Games Pack v2.1
+ *
+ * The compiler reads a pattern a line at a time and emits one opcode byte
+ * plus little-endian 16-bit operands per statement, converting degrees to
+ * binary angle units and speeds and positions to 8.8 fixed point as it
+ * goes. Open repeat/loop blocks sit on a small stack so each "end" can be
+ * emitted with the address of its body already filled in.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "bullet_vm.h"
+#include <math.h>
+
+enum {
+    OP_HALT,
+    OP_WAIT,        // u16 frames
+    OP_FACE,        // i16 angle
+    OP_TURN,        // i16 angle
+    OP_AIM,
+    OP_FIRE,        // u8 count, i16 spread, i16 speed
+    OP_MOVE,        // i16 x, i16 y, u16 frames
+    OP_REPEAT,      // u16 passes (0 = forever)
+    OP_END          // u16 body address
+};
+
+#define FIX_ONE (1 << BULLET_FIX_SHIFT)
+#define SINE_SHIFT 14
+#define QUARTER_TURN (BULLET_ANGLE_STEPS / 4)
+#define TWO_PI 6.283185307179586
+
+static int16_t sine[BULLET_ANGLE_STEPS];
+static int sine_ready = 0;
+
+const BulletPattern bullet_patterns[] = {
+    {"burst",
+     "# Aimed four-shot bursts while strafing the top of the screen\n"
+     "loop\n"
+     "  move 15 6 25\n"
+     "  repeat 3\n"
+     "    aim\n"
+     "    repeat 4\n"
+     "      fire 1 0 0.6\n"
+     "      wait 3\n"
+     "    end\n"
+     "    wait 12\n"
+     "  end\n"
+     "  move 64 6 25\n"
+     "  repeat 3\n"
+     "    aim\n"
+     "    repeat 4\n"
+     "      fire 1 0 0.6\n"
+     "      wait 3\n"
+     "    end\n"
+     "    wait 12\n"
+     "  end\n"
+     "end\n"},
+    {"fan",
+     "# Fans aimed at the player, then a slow ring\n"
+     "loop\n"
+     "  repeat 4\n"
+     "    aim\n"
+     "    fire 5 60 0.4\n"
+     "    wait 18\n"
+     "  end\n"
+     "  ring 16 0.25\n"
+     "  move 40 7 20\n"
+     "  wait 10\n"
+     "end\n"},
+    {"spiral",
+     "# Two-armed spiral, reversing each time the emitter crosses over\n"
+     "loop\n"
+     "  repeat 36\n"
+     "    fire 2 180 0.35\n"
+     "    turn 11\n"
+     "    wait 2\n"
+     "  end\n"
+     "  move 22 6 30\n"
+     "  repeat 36\n"
+     "    fire 2 180 0.35\n"
+     "    turn -11\n"
+     "    wait 2\n"
+     "  end\n"
+     "  move 58 6 30\n"
+     "end\n"},
+};
+
+const int bullet_pattern_count = (int)(sizeof(bullet_patterns) / sizeof(bullet_patterns[0]));
+
+static void build_sine(void) {
+    if (sine_ready) return;
+    for (int i = 0; i < BULLET_ANGLE_STEPS; i++) {
+        sine[i] = (int16_t)lround(sin(i * TWO_PI / BULLET_ANGLE_STEPS) * (1 << SINE_SHIFT));
+    }
+    sine_ready = 1;
+}
+
+static int emit_byte(BulletProgram* program, int value) {
+    if (program->length >= BULLET_PROGRAM_MAX) return 0;
+    program->code[program->length++] = (uint8_t)value;
+    return 1;
+}
+
+static int emit_word(BulletProgram* program, int value) {
+    return emit_byte(program, value & 0xFF) && emit_byte(program, (value >> 8) & 0xFF);
+}
+
+static int compile_fail(BulletProgram* program, int line, const char* message) {
+    snprintf(program->error, sizeof(program->error), "line %d: %s", line, message);
+    program->length = 0;
+    return 0;
+}
+
+// Reads the statement's numeric arguments; returns how many were present
+static int read_numbers(const char* text, double* values, int max) {
+    int count = 0;
+    for (;;) {
+        char* end;
+        while (*text == ' ' || *text == '\t') text++;
+        if (*text == '\0') return count;
+        if (count == max) return -1;
+        values[count] = strtod(text, &end);
+        if (end == text) return -1;
+        count++;
+        text = end;
+    }
+}
+
+static int angle_units(double degrees) {
+    return (int)lround(degrees * BULLET_ANGLE_STEPS / 360.0);
+}
+
+static int fixed(double value) {
+    return (int)lround(value * FIX_ONE);
+}
+
+int bullet_program_compile(BulletProgram* program, const char* source) {
+    uint16_t open_blocks[BULLET_VM_MAX_DEPTH];
+    int depth = 0;
+    int line_number = 0;
+
+    build_sine();
+    program->length = 0;
+    program->error[0] = '\0';
+
+    while (*source) {
+        char line[128], word[16];
+        double arg[3];
+        size_t length = strcspn(source, "\n");
+        int used = 0;
+
+        line_number++;
+        if (length >= sizeof(line)) return compile_fail(program, line_number, "line too long");
+        memcpy(line, source, length);
+        line[length] = '\0';
+        source += length + (source[length] == '\n');
+
+        line[strcspn(line, "#\r")] = '\0';
+        if (sscanf(line, " %15s%n", word, &used) != 1) continue;       // Blank or comment
+        int count = read_numbers(line + used, arg, 3);
+        int ok = 1;
+
+        if (strcmp(word, "wait") == 0) {
+            if (count != 1 || arg[0] < 1 || arg[0] > 65535) return compile_fail(program, line_number, "wait takes 1-65535 frames");
+            ok = emit_byte(program, OP_WAIT) && emit_word(program, (int)arg[0]);
+        } else if (strcmp(word, "face") == 0 || strcmp(word, "turn") == 0) {
+            if (count != 1 || fabs(arg[0]) > 3600) return compile_fail(program, line_number, "expected an angle in degrees");
+            ok = emit_byte(program, word[0] == 'f' ? OP_FACE : OP_TURN) && emit_word(program, angle_units(arg[0]));
+        } else if (strcmp(word, "aim") == 0) {
+            if (count != 0) return compile_fail(program, line_number, "aim takes no arguments");
+            ok = emit_byte(program, OP_AIM);
+        } else if (strcmp(word, "fire") == 0 || strcmp(word, "ring") == 0) {
+            int ring = word[0] == 'r';
+            if (count != (ring ? 2 : 3)) return compile_fail(program, line_number, ring ? "usage: ring COUNT SPEED" : "usage: fire COUNT SPREAD SPEED");
+            double speed = arg[ring ? 1 : 2];
+            if (arg[0] < 1 || arg[0] > 255) return compile_fail(program, line_number, "bullet count must be 1-255");
+            if (speed <= 0 || speed > 8) return compile_fail(program, line_number, "speed must be above 0 and at most 8");
+            if (!ring && (arg[1] < 0 || arg[1] > 360)) return compile_fail(program, line_number, "spread must be 0-360 degrees");
+            // A ring is a fan whose last bullet stops one gap short of the first
+            double spread = ring ? 360.0 - 360.0 / (int)arg[0] : arg[1];
+            ok = emit_byte(program, OP_FIRE) && emit_byte(program, (int)arg[0]) &&
+                 emit_word(program, angle_units(spread)) && emit_word(program, fixed(speed));
+        } else if (strcmp(word, "move") == 0) {
+            if (count != 3 || arg[0] < 0 || arg[0] >= 127 || arg[1] < 0 || arg[1] >= 127 ||
+                arg[2] < 1 || arg[2] > 65535) {
+                return compile_fail(program, line_number, "usage: move X Y FRAMES (cells 0-126)");
+            }
+            ok = emit_byte(program, OP_MOVE) && emit_word(program, fixed(arg[0])) &&
+                 emit_word(program, fixed(arg[1])) && emit_word(program, (int)arg[2]);
+        } else if (strcmp(word, "repeat") == 0 || strcmp(word, "loop") == 0) {
+            int forever = word[0] == 'l';
+            if (forever ? count != 0 : (count != 1 || arg[0] < 1 || arg[0] > 65535)) {
+                return compile_fail(program, line_number, forever ? "loop takes no arguments" : "repeat takes 1-65535 passes");
+            }
+            if (depth == BULLET_VM_MAX_DEPTH) return compile_fail(program, line_number, "blocks nested too deeply");
+            ok = emit_byte(program, OP_REPEAT) && emit_word(program, forever ? 0 : (int)arg[0]);
+            open_blocks[depth++] = (uint16_t)program->length;
+        } else if (strcmp(word, "end") == 0) {
+            if (count != 0 || depth == 0) return compile_fail(program, line_number, "end without repeat or loop");
+            ok = emit_byte(program, OP_END) && emit_word(program, open_blocks[--depth]);
+        } else {
+            return compile_fail(program, line_number, "unknown statement");
+        }
+        if (!ok) return compile_fail(program, line_number, "pattern too long");
+    }
+
+    if (depth > 0) return compile_fail(program, line_number, "missing end");
+    if (!emit_byte(program, OP_HALT)) return compile_fail(program, line_number, "pattern too long");
+    return 1;
+}
+
+void bullet_vm_start(BulletVm* vm, const BulletProgram* program, int x, int y) {
+    memset(vm, 0, sizeof(*vm));
+    build_sine();
+    vm->program = program;
+    vm->x = x * FIX_ONE;
+    vm->y = y * FIX_ONE;
+    vm->aspect = FIX_ONE;
+    vm->halted = program->length == 0;
+}
+
+static inline int read_word(const uint8_t* code) {
+    return (int16_t)(code[0] | (code[1] << 8));
+}
+
+static inline int read_count(const uint8_t* code) {
+    return code[0] | (code[1] << 8);
+}
+
+static int fire(BulletVm* vm, BulletField* field, int count, int spread, int speed) {
+    int room = BULLET_FIELD_MAX - field->count;
+    if (count > room) count = room;
+
+    int angle = vm->heading - spread / 2;
+    int step = count > 1 ? spread * 256 / (count - 1) : 0;     // Angle units, 8 fraction bits
+    int32_t sx = (int32_t)((int64_t)speed * vm->aspect >> BULLET_FIX_SHIFT);
+    int n = field->count;
+
+    for (int i = 0; i < count; i++) {
+        int a = (angle + ((i * step) >> 8)) & (BULLET_ANGLE_STEPS - 1);
+        field->x[n] = vm->x;
+        field->y[n] = vm->y;
+        field->vx[n] = (sine[a] * sx) >> SINE_SHIFT;
+        field->vy[n] = (sine[(a + QUARTER_TURN) & (BULLET_ANGLE_STEPS - 1)] * speed) >> SINE_SHIFT;
+        n++;
+    }
+    field->count = n;
+    return count;
+}
+
+int bullet_vm_step(BulletVm* vm, BulletField* field, int target_x, int target_y) {
+    if (vm->halted) return 0;
+    if (vm->wait > 0) {
+        vm->wait--;
+        return 0;
+    }
+    if (vm->move_frames > 0) {
+        if (--vm->move_frames == 0) {
+            vm->x = vm->move_to_x;
+            vm->y = vm->move_to_y;
+        } else {
+            vm->x += vm->move_dx;
+            vm->y += vm->move_dy;
+        }
+        return 0;
+    }
+
+    const uint8_t* code = vm->program->code;
+    int pc = vm->pc;
+    int spawned = 0;
+
+    for (int budget = BULLET_VM_STEP_BUDGET; budget > 0; budget--) {
+        const uint8_t* op = code + pc;
+        switch (op[0]) {
+            case OP_WAIT:
+                vm->wait = read_count(op + 1) - 1;
+                vm->pc = pc + 3;
+                return spawned;
+            case OP_FACE:
+                vm->heading = (uint16_t)(read_word(op + 1) & (BULLET_ANGLE_STEPS - 1));
+                pc += 3;
+                break;
+            case OP_TURN:
+                vm->heading = (uint16_t)((vm->heading + read_word(op + 1)) & (BULLET_ANGLE_STEPS - 1));
+                pc += 3;
+                break;
+            case OP_AIM: {
+                // Undo the horizontal stretch so the bullet path meets the target
+                double dx = (target_x * FIX_ONE + FIX_ONE / 2 - vm->x) * (double)FIX_ONE / vm->aspect;
+                double dy = target_y * FIX_ONE + FIX_ONE / 2 - vm->y;
+                long angle = lround(atan2(dx, dy) * BULLET_ANGLE_STEPS / TWO_PI);
+                vm->heading = (uint16_t)(angle & (BULLET_ANGLE_STEPS - 1));
+                pc += 1;
+                break;
+            }
+            case OP_FIRE:
+                spawned += fire(vm, field, op[1], read_word(op + 2), read_word(op + 4));
+                pc += 6;
+                break;
+            case OP_MOVE: {
+                int frames = read_count(op + 5);
+                vm->move_to_x = read_word(op + 1);
+                vm->move_to_y = read_word(op + 3);
+                vm->move_dx = (vm->move_to_x - vm->x) / frames;
+                vm->move_dy = (vm->move_to_y - vm->y) / frames;
+                vm->move_frames = frames;
+                vm->pc = pc + 7;
+                // The first frame of the glide is this one
+                return spawned + bullet_vm_step(vm, field, target_x, target_y);
+            }
+            case OP_REPEAT:
+                vm->loop_left[vm->depth++] = (uint16_t)read_count(op + 1);
+                pc += 3;
+                break;
+            case OP_END: {
+                uint16_t* left = &vm->loop_left[vm->depth - 1];
+                if (*left == 0 || --*left > 0) {
+                    pc = read_count(op + 1);
+                } else {
+                    vm->depth--;
+                    pc += 3;
+                }
+                break;
+            }
+            default:
+                vm->halted = 1;
+                vm->pc = pc;
+                return spawned;
+        }
+    }
+
+    vm->pc = pc;        // Out of budget: resume here next frame
+    return spawned;
+}
+
+void bullet_field_init(BulletField* field, int width, int height) {
+    field->count = 0;
+    field->width = width;
+    field->height = height;
+}
+
+void bullet_field_step(BulletField* field) {
+    uint32_t width = (uint32_t)field->width << BULLET_FIX_SHIFT;
+    uint32_t height = (uint32_t)field->height << BULLET_FIX_SHIFT;
+    int kept = 0;
+
+    // Move and compact in one pass; negative positions wrap to huge unsigned values
+    for (int i = 0; i < field->count; i++) {
+        int32_t x = field->x[i] + field->vx[i];
+        int32_t y = field->y[i] + field->vy[i];
+        if ((uint32_t)x < width && (uint32_t)y < height) {
+            field->x[kept] = x;
+            field->y[kept] = y;
+            field->vx[kept] = field->vx[i];
+            field->vy[kept] = field->vy[i];
+            kept++;
+        }
+    }
+    field->count = kept;
+}
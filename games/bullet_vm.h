@@ -0,0 +1,98 @@
+#ifndef BULLET_VM_H
+#define BULLET_VM_H
+
+#include <stdint.h>
+
+/*
+ * Bullet-pattern scripts for boss fights.
+ *
+ * A pattern is a few lines of text, one statement per line ('#' starts a
+ * comment). Angles are in degrees with 0 pointing straight down the screen
+ * and 90 pointing right; speeds are in cells per frame.
+ *
+ *   face DEG              set the firing heading
+ *   turn DEG              rotate the heading
+ *   aim                   point the heading at the target (the player)
+ *   fire COUNT SPREAD SPEED   fan of COUNT bullets across SPREAD degrees
+ *   ring COUNT SPEED      COUNT bullets evenly around a full circle
+ *   move X Y FRAMES       glide the emitter to cell (X, Y) over FRAMES
+ *   wait FRAMES           do nothing for FRAMES frames
+ *   repeat N ... end      run the body N times
+ *   loop ... end          run the body forever
+ *
+ * Scripts are compiled once into compact bytecode (an opcode byte followed
+ * by 16-bit operands in fixed point, loop ends already resolved to jump
+ * targets) and run by a switch loop that never parses text again. Bullets
+ * live in a struct-of-arrays pool with 8.8 fixed-point positions, so a
+ * frame of movement is four integer arrays walked in step.
+ *
+ * A frame runs until the script waits or moves. A script that loops
+ * without waiting is cut off after BULLET_VM_STEP_BUDGET instructions and
+ * resumes next frame, so no script can stall the game loop.
+ */
+
+#define BULLET_PROGRAM_MAX 512          // Bytes of bytecode per pattern
+#define BULLET_VM_MAX_DEPTH 8           // Nested repeat/loop blocks
+#define BULLET_VM_STEP_BUDGET 256       // Instructions per frame
+#define BULLET_FIELD_MAX 4096
+#define BULLET_FIX_SHIFT 8              // Positions and speeds are 8.8 fixed point
+#define BULLET_ANGLE_STEPS 1024         // Binary angle units per full turn
+
+typedef struct {
+    uint8_t code[BULLET_PROGRAM_MAX];
+    int length;
+    char error[96];                     // Set when compiling fails
+} BulletProgram;
+
+typedef struct {
+    int count;
+    int width, height;                  // Bullets leaving [0, width) x [0, height) are culled
+    int32_t x[BULLET_FIELD_MAX];
+    int32_t y[BULLET_FIELD_MAX];
+    int32_t vx[BULLET_FIELD_MAX];
+    int32_t vy[BULLET_FIELD_MAX];
+} BulletField;
+
+typedef struct {
+    const BulletProgram* program;
+    int pc;
+    int wait;
+    int halted;
+    uint16_t heading;                   // Binary angle units
+    int32_t x, y;                       // Emitter position, 8.8 fixed point
+    int32_t move_dx, move_dy;
+    int move_frames;
+    int32_t move_to_x, move_to_y;
+    int aspect;                         // Horizontal speed scale, 8.8 (cells are ~2:1 tall)
+    int depth;
+    uint16_t loop_left[BULLET_VM_MAX_DEPTH];   // Passes left per open block, 0 = forever
+} BulletVm;
+
+typedef struct {
+    const char* name;
+    const char* source;
+} BulletPattern;
+
+extern const BulletPattern bullet_patterns[];
+extern const int bullet_pattern_count;
+
+// Returns 1 on success, 0 with program->error naming the line on failure
+int bullet_program_compile(BulletProgram* program, const char* source);
+
+void bullet_vm_start(BulletVm* vm, const BulletProgram* program, int x, int y);
+
+// Runs one frame of the script against a target cell; returns bullets spawned
+int bullet_vm_step(BulletVm* vm, BulletField* field, int target_x, int target_y);
+
+void bullet_field_init(BulletField* field, int width, int height);
+void bullet_field_step(BulletField* field);
+
+static inline void bullet_field_remove(BulletField* field, int index) {
+    int last = --field->count;
+    field->x[index] = field->x[last];
+    field->y[index] = field->y[last];
+    field->vx[index] = field->vx[last];
+    field->vy[index] = field->vy[last];
+}
+
+#endif // BULLET_VM_H
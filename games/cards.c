@@ -0,0 +1,46 @@
+#include "games.h"
+#include "cards.h"
+
+const char* suit_names[] = {"Hearts", "Diamonds", "Clubs", "Spades"};
+const char* suit_symbols[] = {"H", "D", "C", "S"};
+const char* rank_names[] = {"", "A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
+
+void initialize_deck(Deck* deck) {
+    int index = 0;
+    for (int suit = 0; suit < 4; suit++) {
+        for (int rank = 1; rank <= 13; rank++) {
+            deck->deck[index].suit = (Suit)suit;
+            deck->deck[index].rank = (Rank)rank;
+            index++;
+        }
+    }
+    deck->cards_left = DECK_SIZE;
+    deck->current_card = 0;
+}
+
+void shuffle_deck(Deck* deck) {
+    for (int i = 0; i < DECK_SIZE; i++) {
+        int j = rand() % DECK_SIZE;
+        Card temp = deck->deck[i];
+        deck->deck[i] = deck->deck[j];
+        deck->deck[j] = temp;
+    }
+    deck->current_card = 0;
+    deck->cards_left = DECK_SIZE;
+}
+
+Card deal_card(Deck* deck) {
+    if (deck->cards_left <= 0) {
+        printf("*** Reshuffling deck... ***\n");
+        shuffle_deck(deck);
+    }
+    
+    Card card = deck->deck[deck->current_card];
+    deck->current_card++;
+    deck->cards_left--;
+    return card;
+}
+
+void display_card(Card card) {
+    printf("[%s%s]", rank_names[card.rank], suit_symbols[card.suit]);
+}
@@ -0,0 +1,36 @@
+#ifndef CARDS_H
+#define CARDS_H
+
+// Shared playing-card types used by Blackjack and Texas Hold'em
+
+#define DECK_SIZE 52
+
+typedef enum {
+    HEARTS, DIAMONDS, CLUBS, SPADES
+} Suit;
+
+typedef enum {
+    ACE = 1, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING
+} Rank;
+
+typedef struct {
+    Suit suit;
+    Rank rank;
+} Card;
+
+typedef struct {
+    Card deck[DECK_SIZE];
+    int cards_left;
+    int current_card;
+} Deck;
+
+extern const char* suit_names[];
+extern const char* suit_symbols[];
+extern const char* rank_names[];
+
+void initialize_deck(Deck* deck);
+void shuffle_deck(Deck* deck);
+Card deal_card(Deck* deck);
+void display_card(Card card);
+
+#endif // CARDS_H
@@ -1,4 +1,5 @@
 #include "games.h"
+#include "ratings.h"
 
 typedef enum {
     HEADS = 1,
@@ -185,6 +186,12 @@ void play_coin_flip_tournament(CoinFlipGame* game) {
     }
     
     // Tournament results
+    if (game->player_score >= 5 || game->computer_score >= 5) {
+        RatingResult result = game->player_score == game->computer_score ? RATING_DRAW :
+                              game->player_score > game->computer_score ? RATING_WIN : RATING_LOSS;
+        ratings_record_match(RATING_GAME_COIN_FLIP, ratings_local_player(), "Coin Flip Bot", result);
+    }
+    
     if (game->player_score >= 5) {
         printf("\n*** TOURNAMENT CHAMPION! ***\n");
         printf("You won the tournament %d-%d!\n", game->player_score, game->computer_score);
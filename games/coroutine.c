@@ -0,0 +1,441 @@
+/*
+ * Stackless Coroutine Runtime
+ * Part of CLI Games Pack v2.1
+ *
+ * A loop keeps three structures over its session pool, all arrays of
+ * session ids sized to the pool: a free list, a ready ring and a binary
+ * min-heap of sleepers keyed by wake time. A session is in at most one of
+ * them, so none of them can overflow. Resuming a session is one indirect
+ * call and a switch on its saved resume point.
+ *
+ * Delivered input goes into a mailbox under the loop's lock. The loop
+ * thread swaps the mailbox for its spare one and applies the messages
+ * without holding the lock, waking sessions that were waiting for a line.
+ * With nothing ready the thread sleeps on a condition variable until the
+ * next timer is due or a message arrives.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "coroutine.h"
+#include "terminal.h"
+#include "metrics.h"
+#include <stdarg.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+typedef struct {
+    uint64_t sent_us;
+    uint32_t id, generation;
+    uint16_t length;                    // Bytes of text; 0 with closed set
+    uint8_t closed;
+    char text[CO_INBOX_SIZE];
+} CoMessage;
+
+typedef struct {
+    CoMessage* messages;
+    uint32_t count, capacity;
+} CoMailbox;
+
+struct CoLoop {
+    CoSession* sessions;
+    uint32_t capacity;
+    uint32_t* free_ids;
+    uint32_t free_count;
+    uint32_t* ready;
+    uint32_t ready_head, ready_count;
+    uint32_t* timers;
+    uint32_t timer_count;
+    CoOutput output;
+    CoStats stats;
+    CoMailbox mailbox, spare;
+    int stop;
+#ifndef _WIN32
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+#endif
+};
+
+uint64_t co_now_us(void) {
+    return terminal_now_us();
+}
+
+static void inbox_append(CoSession* session, const char* text, size_t length) {
+    size_t room = CO_INBOX_SIZE - session->inbox_length;
+    if (length > room) length = room;              // Typed too far ahead: the rest is dropped
+    memcpy(session->inbox + session->inbox_length, text, length);
+    session->inbox_length = (uint16_t)(session->inbox_length + length);
+}
+
+int co_take_line(CoSession* session) {
+    char* newline = memchr(session->inbox, '\n', session->inbox_length);
+    size_t taken, consumed;
+
+    if (newline) {
+        taken = (size_t)(newline - session->inbox);
+        consumed = taken + 1;
+    } else if (session->inbox_length == CO_INBOX_SIZE || (session->closed && session->inbox_length > 0)) {
+        taken = consumed = session->inbox_length;  // A full inbox or a last unterminated line
+    } else if (session->closed) {
+        session->line[0] = '\0';
+        return 1;
+    } else {
+        return 0;
+    }
+
+    if (taken > CO_LINE_MAX - 1) taken = CO_LINE_MAX - 1;
+    memcpy(session->line, session->inbox, taken);
+    session->line[taken] = '\0';
+    session->inbox_length = (uint16_t)(session->inbox_length - consumed);
+    memmove(session->inbox, session->inbox + consumed, session->inbox_length);
+    return 1;
+}
+
+static void flush_output(CoSession* session) {
+    if (session->outbox_length == 0) return;
+    if (session->loop) {
+        session->loop->output(session, session->outbox, session->outbox_length);
+    } else {
+        fwrite(session->outbox, 1, session->outbox_length, stdout);
+    }
+    session->outbox_length = 0;
+}
+
+void co_printf(CoSession* session, const char* format, ...) {
+    char text[512];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length >= (int)sizeof(text)) length = (int)sizeof(text) - 1;
+
+    for (int written = 0; written < length;) {
+        if (session->outbox_length == CO_OUTBOX_SIZE) flush_output(session);
+        int chunk = length - written;
+        if (chunk > CO_OUTBOX_SIZE - session->outbox_length) chunk = CO_OUTBOX_SIZE - session->outbox_length;
+        memcpy(session->outbox + session->outbox_length, text + written, (size_t)chunk);
+        session->outbox_length = (uint16_t)(session->outbox_length + chunk);
+        written += chunk;
+    }
+}
+
+static void make_ready(CoLoop* loop, CoSession* session) {
+    session->state = CO_READY;
+    loop->ready[(loop->ready_head + loop->ready_count++) % loop->capacity] = session->id;
+}
+
+static int wakes_before(const CoLoop* loop, uint32_t a, uint32_t b) {
+    return loop->sessions[a].wake_us < loop->sessions[b].wake_us;
+}
+
+static void timer_push(CoLoop* loop, uint32_t id) {
+    uint32_t slot = loop->timer_count++;
+    while (slot > 0) {
+        uint32_t parent = (slot - 1) / 2;
+        if (!wakes_before(loop, id, loop->timers[parent])) break;
+        loop->timers[slot] = loop->timers[parent];
+        slot = parent;
+    }
+    loop->timers[slot] = id;
+}
+
+static uint32_t timer_pop(CoLoop* loop) {
+    uint32_t top = loop->timers[0];
+    uint32_t last = loop->timers[--loop->timer_count];
+    uint32_t slot = 0;
+
+    for (;;) {
+        uint32_t child = slot * 2 + 1;
+        if (child >= loop->timer_count) break;
+        if (child + 1 < loop->timer_count && wakes_before(loop, loop->timers[child + 1], loop->timers[child])) child++;
+        if (!wakes_before(loop, loop->timers[child], last)) break;
+        loop->timers[slot] = loop->timers[child];
+        slot = child;
+    }
+    if (loop->timer_count > 0) loop->timers[slot] = last;
+    return top;
+}
+
+int co_loop_init(CoLoop** out, uint32_t capacity, CoOutput output) {
+    CoLoop* loop = calloc(1, sizeof(CoLoop));
+    *out = NULL;
+    if (!loop || capacity == 0) {
+        free(loop);
+        return 0;
+    }
+    loop->capacity = capacity;
+    loop->output = output;
+    loop->sessions = calloc(capacity, sizeof(CoSession));
+    loop->free_ids = malloc(capacity * sizeof(uint32_t));
+    loop->ready = malloc(capacity * sizeof(uint32_t));
+    loop->timers = malloc(capacity * sizeof(uint32_t));
+    if (!loop->sessions || !loop->free_ids || !loop->ready || !loop->timers) {
+        co_loop_free(loop);
+        return 0;
+    }
+    // Lowest ids first, so a lightly used pool touches few pages
+    for (uint32_t i = 0; i < capacity; i++) loop->free_ids[i] = capacity - 1 - i;
+    loop->free_count = capacity;
+#ifndef _WIN32
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&loop->wake, &attributes);
+    pthread_condattr_destroy(&attributes);
+    pthread_mutex_init(&loop->lock, NULL);
+#endif
+    *out = loop;
+    return 1;
+}
+
+void co_loop_free(CoLoop* loop) {
+    if (!loop) return;
+#ifndef _WIN32
+    if (loop->sessions && loop->free_ids && loop->ready && loop->timers) {
+        pthread_mutex_destroy(&loop->lock);
+        pthread_cond_destroy(&loop->wake);
+    }
+#endif
+    free(loop->sessions);
+    free(loop->free_ids);
+    free(loop->ready);
+    free(loop->timers);
+    free(loop->mailbox.messages);
+    free(loop->spare.messages);
+    free(loop);
+}
+
+CoSession* co_spawn(CoLoop* loop, CoStep step, void* user) {
+    if (loop->free_count == 0) return NULL;
+
+    uint32_t id = loop->free_ids[--loop->free_count];
+    CoSession* session = &loop->sessions[id];
+    uint32_t generation = session->generation + 1;
+    memset(session, 0, sizeof(*session));
+    session->generation = generation;
+    session->step = step;
+    session->loop = loop;
+    session->user = user;
+    session->id = id;
+    make_ready(loop, session);
+    if (++loop->stats.live > loop->stats.peak_live) loop->stats.peak_live = loop->stats.live;
+    return session;
+}
+
+static void lock_loop(CoLoop* loop) {
+#ifndef _WIN32
+    pthread_mutex_lock(&loop->lock);
+#else
+    (void)loop;
+#endif
+}
+
+static void unlock_loop(CoLoop* loop) {
+#ifndef _WIN32
+    pthread_mutex_unlock(&loop->lock);
+#else
+    (void)loop;
+#endif
+}
+
+static int post(CoLoop* loop, uint32_t id, uint32_t generation, const char* text, size_t length, int closed,
+                uint64_t now) {
+    CoMailbox* mailbox = &loop->mailbox;
+    if (mailbox->count == mailbox->capacity) {
+        uint32_t capacity = mailbox->capacity ? mailbox->capacity * 2 : 64;
+        CoMessage* grown = realloc(mailbox->messages, capacity * sizeof(CoMessage));
+        if (!grown) return 0;
+        mailbox->messages = grown;
+        mailbox->capacity = capacity;
+    }
+    CoMessage* message = &mailbox->messages[mailbox->count++];
+    message->sent_us = now;
+    message->id = id;
+    message->generation = generation;
+    message->length = (uint16_t)length;
+    message->closed = (uint8_t)closed;
+    memcpy(message->text, text, length);
+    return 1;
+}
+
+void co_deliver(CoLoop* loop, uint32_t id, uint32_t generation, const char* text) {
+    if (id >= loop->capacity) return;
+
+    uint64_t now = co_now_us();
+    lock_loop(loop);
+    int was_empty = loop->mailbox.count == 0;
+    if (!text) {
+        post(loop, id, generation, "", 0, 1, now);
+    } else {
+        // Split long text into inbox-sized messages
+        size_t length = strlen(text);
+        do {
+            size_t chunk = length > CO_INBOX_SIZE ? CO_INBOX_SIZE : length;
+            if (!post(loop, id, generation, text, chunk, 0, now)) break;
+            text += chunk;
+            length -= chunk;
+        } while (length > 0);
+    }
+#ifndef _WIN32
+    if (was_empty) pthread_cond_signal(&loop->wake);
+#else
+    (void)was_empty;
+#endif
+    unlock_loop(loop);
+}
+
+void co_loop_stop(CoLoop* loop) {
+    lock_loop(loop);
+    loop->stop = 1;
+#ifndef _WIN32
+    pthread_cond_signal(&loop->wake);
+#endif
+    unlock_loop(loop);
+}
+
+static void apply_mail(CoLoop* loop) {
+    lock_loop(loop);
+    CoMailbox incoming = loop->mailbox;
+    loop->mailbox = loop->spare;
+    loop->mailbox.count = 0;
+    unlock_loop(loop);
+
+    for (uint32_t i = 0; i < incoming.count; i++) {
+        const CoMessage* message = &incoming.messages[i];
+        CoSession* session = &loop->sessions[message->id];
+        if (session->state == CO_FREE || session->state == CO_DONE) continue;
+        if (session->generation != message->generation) continue;   // Meant for the slot's last session
+        inbox_append(session, message->text, message->length);
+        if (message->closed) session->closed = 1;
+        if (session->state == CO_WAIT_INPUT) {
+            session->input_us = message->sent_us;
+            make_ready(loop, session);
+        }
+    }
+    incoming.count = 0;
+    loop->spare = incoming;
+}
+
+// Sleeps until a message arrives, the stop flag is set or deadline_us passes
+static void wait_for_work(CoLoop* loop, uint64_t deadline_us) {
+#ifndef _WIN32
+    pthread_mutex_lock(&loop->lock);
+    if (loop->mailbox.count == 0 && !loop->stop) {
+        if (deadline_us == TERMINAL_NO_DEADLINE) {
+            pthread_cond_wait(&loop->wake, &loop->lock);
+        } else {
+            struct timespec until;
+            until.tv_sec = (time_t)(deadline_us / 1000000u);
+            until.tv_nsec = (long)(deadline_us % 1000000u) * 1000L;
+            pthread_cond_timedwait(&loop->wake, &loop->lock, &until);
+        }
+    }
+    pthread_mutex_unlock(&loop->lock);
+#else
+    // Without threads, input can only come from inside the loop
+    if (deadline_us != TERMINAL_NO_DEADLINE) {
+        terminal_sleep_until(deadline_us);
+    } else {
+        loop->stop = 1;
+    }
+#endif
+}
+
+static void finish_step(CoLoop* loop, CoSession* session, int state) {
+    flush_output(session);
+    switch (state) {
+        case CO_WAIT_INPUT:
+            session->state = CO_WAIT_INPUT;
+            loop->stats.input_waits++;
+            break;
+        case CO_SLEEPING:
+            session->state = CO_SLEEPING;
+            timer_push(loop, session->id);
+            loop->stats.sleeps++;
+            break;
+        case CO_READY:
+            make_ready(loop, session);
+            loop->stats.yields++;
+            break;
+        default:
+            session->state = CO_DONE;
+            loop->output(session, NULL, 0);
+            session->state = CO_FREE;
+            loop->free_ids[loop->free_count++] = session->id;
+            loop->stats.live--;
+            break;
+    }
+}
+
+void co_loop_run(CoLoop* loop) {
+    while (loop->stats.live > 0) {
+        apply_mail(loop);
+        if (loop->stop) break;
+
+        uint64_t now = co_now_us();
+        while (loop->timer_count > 0 && loop->sessions[loop->timers[0]].wake_us <= now) {
+            make_ready(loop, &loop->sessions[timer_pop(loop)]);
+        }
+
+        if (loop->ready_count == 0) {
+            wait_for_work(loop, loop->timer_count > 0 ? loop->sessions[loop->timers[0]].wake_us : TERMINAL_NO_DEADLINE);
+            continue;
+        }
+
+        // One pass over what is ready now; sessions that yield go to the back
+        for (uint32_t batch = loop->ready_count; batch > 0; batch--) {
+            CoSession* session = &loop->sessions[loop->ready[loop->ready_head]];
+            loop->ready_head = (loop->ready_head + 1) % loop->capacity;
+            loop->ready_count--;
+            loop->stats.steps++;
+            if (session->input_us) {
+                metrics_observe(METRICS_INPUT_LATENCY_US, co_now_us() - session->input_us);
+                session->input_us = 0;
+            }
+            finish_step(loop, session, session->step(session));
+        }
+    }
+}
+
+void co_loop_stats(const CoLoop* loop, CoStats* stats) {
+    *stats = loop->stats;
+}
+
+size_t co_bytes_per_session(void) {
+    return sizeof(CoSession) + 3 * sizeof(uint32_t);
+}
+
+void co_run_local(CoStep step, void (*prepare)(CoSession* session, void* arg), void* arg) {
+    CoSession session;
+    char text[CO_INBOX_SIZE];
+
+    memset(&session, 0, sizeof(session));
+    session.step = step;
+    if (prepare) prepare(&session, arg);
+
+    for (;;) {
+        int state = step(&session);
+        flush_output(&session);
+        fflush(stdout);
+        if (state == CO_WAIT_INPUT) {
+            size_t room = CO_INBOX_SIZE - session.inbox_length;
+            if (room > sizeof(text) - 1) room = sizeof(text) - 1;
+            if (fgets(text, (int)room + 1, stdin)) {
+                inbox_append(&session, text, strlen(text));
+            } else {
+                session.closed = 1;
+            }
+        } else if (state == CO_SLEEPING) {
+            terminal_sleep_until(session.wake_us);
+        } else if (state != CO_READY) {
+            return;
+        }
+    }
+}
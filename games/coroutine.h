@@ -0,0 +1,158 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Stackless coroutines for hosting many game sessions on a few threads.
+ *
+ * A session is a step function plus a small fixed-size record. The step
+ * function is written as an ordinary loop between CO_BEGIN and CO_END;
+ * where a blocking game would call getchar() or sleep, it uses
+ * CO_READ_LINE or CO_SLEEP instead, which save the resume point and
+ * return to the event loop. Because nothing lives on a C stack across a
+ * wait, every local that must survive one is kept in the session's
+ * locals area (CO_LOCALS), and a suspended session costs only its record.
+ *
+ * Each CoLoop owns a pool of sessions, a ready queue and a timer heap,
+ * and is run by one thread. Input for a session may be delivered from
+ * any thread; it is queued in a locked mailbox and picked up by the
+ * loop's thread. Input is addressed by slot id and generation, so it
+ * never reaches a later session that reused the slot. Output written with
+ * co_printf is collected per session and handed to the loop's output
+ * callback after each step, or earlier if the buffer fills.
+ *
+ * co_run_local() runs one session on the calling thread against stdin
+ * and stdout, which is how the single-player menu plays the same code.
+ * Hosted sessions share their loop's process, so they do not record to
+ * the flight recorder, which keeps one session per process.
+ */
+
+#define CO_LINE_MAX 64                  // Longest line a session reads
+#define CO_INBOX_SIZE 128               // Typed-ahead input per session
+#define CO_OUTBOX_SIZE 256              // Output gathered before a flush
+#define CO_LOCALS_SIZE 64               // Game state kept across waits
+
+typedef enum {
+    CO_FREE,
+    CO_READY,
+    CO_WAIT_INPUT,
+    CO_SLEEPING,
+    CO_DONE
+} CoState;
+
+typedef struct CoSession CoSession;
+typedef struct CoLoop CoLoop;
+
+// Runs the session until it waits or finishes; returns the new CoState
+typedef int (*CoStep)(CoSession* session);
+
+// Receives a session's output, then NULL once the session has finished;
+// runs on the loop's thread and may deliver input to any loop
+typedef void (*CoOutput)(CoSession* session, const char* text, size_t length);
+
+struct CoSession {
+    CoStep step;
+    CoLoop* loop;
+    void* user;                         // Owner's per-session pointer
+    uint64_t wake_us;                   // Deadline while sleeping
+    uint64_t input_us;                  // When the input that woke it was delivered
+    uint32_t id;                        // Index in the loop's pool
+    uint32_t generation;                // Bumped each time the slot is reused
+    uint16_t resume_point;              // Where CO_BEGIN jumps back to
+    uint8_t state;
+    uint8_t closed;                     // Input ended: no more lines will come
+    uint16_t inbox_length, outbox_length;
+    char line[CO_LINE_MAX];             // The line CO_READ_LINE returned
+    char inbox[CO_INBOX_SIZE];
+    char outbox[CO_OUTBOX_SIZE];
+    union {
+        long long align;
+        double align_double;
+        unsigned char bytes[CO_LOCALS_SIZE];
+    } locals;
+};
+
+// Typed view of a session's locals; fails to compile if the type is too big
+#define CO_LOCALS(session, type)                                \
+    ((type*)(void*)(session)->locals.bytes +                    \
+     0 * sizeof(char[sizeof(type) <= CO_LOCALS_SIZE ? 1 : -1]))
+
+// Entering a resume point from the code above it is intended
+#if defined(__GNUC__) && __GNUC__ >= 7
+    #define CO_FALLTHROUGH __attribute__((fallthrough))
+#else
+    #define CO_FALLTHROUGH ((void)0)
+#endif
+
+#define CO_BEGIN(session) switch ((session)->resume_point) { case 0:
+
+#define CO_END(session) } (session)->resume_point = 0; return CO_DONE
+
+// Suspends until a whole line (or end of input) is available in session->line
+#define CO_READ_LINE(session)                                   \
+    do {                                                        \
+        (session)->resume_point = __LINE__;                     \
+        CO_FALLTHROUGH;                                         \
+        case __LINE__:                                          \
+        if (!co_take_line(session)) return CO_WAIT_INPUT;       \
+    } while (0)
+
+// Suspends for at least ms milliseconds
+#define CO_SLEEP(session, ms)                                   \
+    do {                                                        \
+        (session)->wake_us = co_now_us() + (uint64_t)(ms) * 1000u; \
+        (session)->resume_point = __LINE__;                     \
+        return CO_SLEEPING;                                     \
+        case __LINE__:;                                         \
+    } while (0)
+
+// Gives other sessions a turn
+#define CO_YIELD(session)                                       \
+    do {                                                        \
+        (session)->resume_point = __LINE__;                     \
+        return CO_READY;                                        \
+        case __LINE__:;                                         \
+    } while (0)
+
+uint64_t co_now_us(void);
+
+// Moves the next complete line from the inbox into session->line; at end
+// of input an empty line is returned and session->closed is set
+int co_take_line(CoSession* session);
+
+void co_printf(CoSession* session, const char* format, ...);
+
+// Allocates a loop of capacity sessions; returns 0 when out of memory
+int co_loop_init(CoLoop** loop, uint32_t capacity, CoOutput output);
+void co_loop_free(CoLoop* loop);
+
+// Starts a session in a free slot (locals zeroed) from the loop's own thread
+// or before it runs; returns it for setting up, or NULL when the pool is full
+CoSession* co_spawn(CoLoop* loop, CoStep step, void* user);
+
+// Queues text (one or more lines) for session id of that generation; safe
+// from any thread. Passing NULL marks the session's input as closed.
+void co_deliver(CoLoop* loop, uint32_t id, uint32_t generation, const char* text);
+
+// Runs sessions until none are left alive or co_loop_stop() is called
+void co_loop_run(CoLoop* loop);
+void co_loop_stop(CoLoop* loop);
+
+typedef struct {
+    uint64_t steps;                     // Step function calls (resumes)
+    uint64_t input_waits, sleeps, yields;
+    uint32_t live, peak_live;
+} CoStats;
+
+void co_loop_stats(const CoLoop* loop, CoStats* stats);
+
+// Bytes a loop uses per session slot, including its queue and heap entries
+size_t co_bytes_per_session(void);
+
+// Plays one session to completion on stdin/stdout. Locals start zeroed;
+// prepare, when given, fills them in before the first step.
+void co_run_local(CoStep step, void (*prepare)(CoSession* session, void* arg), void* arg);
+
+#endif // COROUTINE_H
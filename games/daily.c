@@ -0,0 +1,610 @@
+/*
+ * Daily Challenge Content
+ * Part of CLI Games Pack v2.1
+ *
+ * Layout of daily.pack: a 64-byte header {magic, record size, first day,
+ * day count}, then one DailyChallenge per day in order. The header is
+ * written last, so a pack whose generation was cut short never validates.
+ *
+ * The Minesweeper check plays the board the way a careful player would:
+ * from the opening it reveals and flags only what single numbers, pairs
+ * of overlapping numbers or the mine total prove, and the board is kept
+ * only if that clears it. The 15-puzzle scramble is a random walk from the
+ * solved position, solved optimally by IDA* with Manhattan distance plus
+ * linear conflicts.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "daily.h"
+#include "grid_topology.h"
+#include "highscores.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <errno.h>
+#endif
+
+#define PACK_MAGIC 0x31594C44u          // "DLY1"
+#define PACK_FILE "daily.pack"
+#define SEED_SALT 0xD1B54A32D192ED03ull
+#define MINE_CELLS (DAILY_MINE_WIDTH * DAILY_MINE_HEIGHT)
+#define PUZZLE_CELLS (DAILY_PUZZLE_SIZE * DAILY_PUZZLE_SIZE)
+#define SCRAMBLE_MOVES 50               // Random-walk length before solving
+#define MIN_OPTIMAL_MOVES 24            // Re-scramble puzzles shorter than this
+#define MAX_OPTIMAL_MOVES 50
+#define SEARCH_NODE_BUDGET 2000000u     // Give up on a scramble past this
+
+typedef char daily_record_is_128_bytes[sizeof(DailyChallenge) == 128 ? 1 : -1];
+
+typedef struct {
+    uint32_t magic;
+    uint32_t record_size;
+    int32_t first_day;
+    int32_t day_count;
+    uint8_t reserved[48];
+} PackHeader;
+
+static const PackHeader* pack;
+static size_t pack_size;
+static int pack_tried;
+static int generating;                  // A background pack is being written
+static int pack_replaced;               // It is in place; remap on the next load
+
+int daily_today(void) {
+    return (int)(time(NULL) / 86400);
+}
+
+void daily_date(int day, char* text, size_t size) {
+    time_t when = (time_t)day * 86400;
+    struct tm* utc = gmtime(&when);
+    if (!utc || strftime(text, size, "%Y-%m-%d", utc) == 0) snprintf(text, size, "day %d", day);
+}
+
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t daily_seed(DailyGame game, int day) {
+    return mix(((uint64_t)(uint32_t)day << 8 | (uint64_t)game) ^ SEED_SALT);
+}
+
+uint32_t daily_random(uint64_t* state) {
+    // xorshift64*: a zero state would stick, so it is nudged off zero
+    uint64_t x = *state ? *state : SEED_SALT;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+int daily_below(uint64_t* state, int bound) {
+    return (int)(((uint64_t)daily_random(state) * (uint32_t)bound) >> 32);
+}
+
+// Collects the hidden neighbours of cell; returns how many, and the flags around it
+static int hidden_around(const GridNeighbors* grid, const unsigned char* state, int cell,
+                         unsigned short* hidden, int* flags) {
+    int count = 0;
+    *flags = 0;
+    for (int k = grid->neighbor_start[cell]; k < grid->neighbor_start[cell + 1]; k++) {
+        int n = grid->neighbors[k];
+        if (state[n] == 0) hidden[count++] = (unsigned short)n;
+        *flags += state[n] == 2;
+    }
+    return count;
+}
+
+typedef struct {
+    const GridNeighbors* grid;
+    const unsigned char* mines;
+    unsigned char numbers[GRID_MAX_CELLS];
+    unsigned char state[GRID_MAX_CELLS];        // 0 hidden, 1 revealed, 2 flagged
+    int safe_left, flags;
+} MineSolver;
+
+// Applies a deduction; returns 0 if it contradicts the board (never expected)
+static int settle(MineSolver* solver, const unsigned short* cells, int count, int mine) {
+    for (int i = 0; i < count; i++) {
+        int cell = cells[i];
+        if (solver->state[cell] != 0) continue;
+        if (solver->mines[cell] != mine) return 0;
+        if (mine) {
+            solver->state[cell] = 2;
+            solver->flags++;
+        } else {
+            solver->safe_left -= grid_flood_reveal(solver->grid, cell, solver->numbers, solver->state, NULL);
+        }
+    }
+    return 1;
+}
+
+// One round of single-number rules; returns 1 on progress, -1 on contradiction
+static int single_rules(MineSolver* solver) {
+    unsigned short hidden[GRID_MAX_NEIGHBORS];
+    int progress = 0;
+
+    for (int cell = 0; cell < solver->grid->cell_count; cell++) {
+        if (solver->state[cell] != 1 || solver->numbers[cell] == 0) continue;
+        int flags;
+        int count = hidden_around(solver->grid, solver->state, cell, hidden, &flags);
+        if (count == 0) continue;
+        int need = solver->numbers[cell] - flags;
+        if (need == 0 || need == count) {
+            if (!settle(solver, hidden, count, need != 0)) return -1;
+            progress = 1;
+        }
+    }
+    return progress;
+}
+
+// Two numbers whose hidden cells nest: the difference holds need_b - need_a mines
+static int pair_rules(MineSolver* solver) {
+    const GridNeighbors* grid = solver->grid;
+    unsigned short inner[GRID_MAX_NEIGHBORS], outer[GRID_MAX_NEIGHBORS], rest[GRID_MAX_NEIGHBORS];
+
+    for (int a = 0; a < grid->cell_count; a++) {
+        if (solver->state[a] != 1 || solver->numbers[a] == 0) continue;
+        int flags_a;
+        int count_a = hidden_around(grid, solver->state, a, inner, &flags_a);
+        if (count_a == 0) continue;
+        int need_a = solver->numbers[a] - flags_a;
+
+        for (int j = grid->neighbor_start[a]; j < grid->neighbor_start[a + 1]; j++) {
+            int middle = grid->neighbors[j];
+            for (int k = grid->neighbor_start[middle]; k < grid->neighbor_start[middle + 1]; k++) {
+                int b = grid->neighbors[k];
+                if (b == a || solver->state[b] != 1 || solver->numbers[b] == 0) continue;
+                int flags_b;
+                int count_b = hidden_around(grid, solver->state, b, outer, &flags_b);
+                if (count_b <= count_a) continue;
+
+                int extra = 0, shared = 0;
+                for (int x = 0; x < count_b; x++) {
+                    int found = 0;
+                    for (int y = 0; y < count_a && !found; y++) found = outer[x] == inner[y];
+                    if (found) {
+                        shared++;
+                    } else {
+                        rest[extra++] = outer[x];
+                    }
+                }
+                if (shared != count_a) continue;
+
+                int mines = solver->numbers[b] - flags_b - need_a;
+                if (mines == 0 || mines == extra) {
+                    return settle(solver, rest, extra, mines != 0) ? 1 : -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int count_rule(MineSolver* solver, int mine_count) {
+    unsigned short cell_list[GRID_MAX_CELLS];
+    int hidden = 0;
+    for (int cell = 0; cell < solver->grid->cell_count; cell++) {
+        if (solver->state[cell] == 0) cell_list[hidden++] = (unsigned short)cell;
+    }
+    int remaining = mine_count - solver->flags;
+    if (hidden == 0 || (remaining != 0 && remaining != hidden)) return 0;
+    return settle(solver, cell_list, hidden, remaining != 0) ? 1 : -1;
+}
+
+static int solve_mines(const GridNeighbors* grid, const unsigned char* mines, int start) {
+    MineSolver solver;
+    int mine_count = 0;
+
+    memset(&solver, 0, sizeof(solver));
+    solver.grid = grid;
+    solver.mines = mines;
+    grid_count_adjacent(grid, mines, solver.numbers);
+    for (int cell = 0; cell < grid->cell_count; cell++) mine_count += mines[cell];
+    if (mines[start] || solver.numbers[start] != 0) return 0;      // Must open a region
+
+    solver.safe_left = grid->cell_count - mine_count;
+    solver.safe_left -= grid_flood_reveal(grid, start, solver.numbers, solver.state, NULL);
+    while (solver.safe_left > 0) {
+        int progress = single_rules(&solver);
+        if (progress == 0) progress = pair_rules(&solver);
+        if (progress == 0) progress = count_rule(&solver, mine_count);
+        if (progress <= 0) return 0;
+    }
+    return 1;
+}
+
+int daily_mines_solvable(const uint8_t* bits, int start) {
+    GridNeighbors grid;
+    unsigned char mines[GRID_MAX_CELLS] = {0};
+
+    if (start < 0 || start >= MINE_CELLS ||
+        grid_build_neighbors(&grid, GRID_SQUARE, DAILY_MINE_WIDTH, DAILY_MINE_HEIGHT, 1) != 0) {
+        return 0;
+    }
+    for (int cell = 0; cell < MINE_CELLS; cell++) mines[cell] = (bits[cell >> 3] >> (cell & 7)) & 1;
+    return solve_mines(&grid, mines, start);
+}
+
+// Places mines away from the opening until a board solves; returns tries
+static int generate_mines(uint64_t* rng, DailyChallenge* out) {
+    GridNeighbors grid;
+    unsigned char mines[GRID_MAX_CELLS];
+    unsigned char keep_clear[GRID_MAX_CELLS];
+
+    grid_build_neighbors(&grid, GRID_SQUARE, DAILY_MINE_WIDTH, DAILY_MINE_HEIGHT, 1);
+    for (int tries = 1;; tries++) {
+        int start = daily_below(rng, MINE_CELLS);
+        memset(mines, 0, sizeof(mines));
+        memset(keep_clear, 0, sizeof(keep_clear));
+        keep_clear[start] = 1;
+        for (int k = grid.neighbor_start[start]; k < grid.neighbor_start[start + 1]; k++) {
+            keep_clear[grid.neighbors[k]] = 1;
+        }
+        for (int placed = 0; placed < DAILY_MINE_COUNT;) {
+            int cell = daily_below(rng, MINE_CELLS);
+            if (keep_clear[cell] || mines[cell]) continue;
+            mines[cell] = 1;
+            placed++;
+        }
+        if (!solve_mines(&grid, mines, start)) continue;
+
+        memset(out->mines, 0, sizeof(out->mines));
+        for (int cell = 0; cell < MINE_CELLS; cell++) out->mines[cell >> 3] |= (uint8_t)(mines[cell] << (cell & 7));
+        out->mine_start = (uint16_t)start;
+        return tries;
+    }
+}
+
+typedef struct {
+    uint8_t tiles[PUZZLE_CELLS];
+    uint32_t nodes;
+    int bound;
+} PuzzleSearch;
+
+// 2 x (tiles in the line minus its longest run already in goal order)
+static int line_conflicts(const int* goals, int count) {
+    int longest[DAILY_PUZZLE_SIZE], best = 0;
+    for (int i = 0; i < count; i++) {
+        longest[i] = 1;
+        for (int j = 0; j < i; j++) {
+            if (goals[j] < goals[i] && longest[j] + 1 > longest[i]) longest[i] = longest[j] + 1;
+        }
+        if (longest[i] > best) best = longest[i];
+    }
+    return 2 * (count - best);
+}
+
+static int puzzle_estimate(const uint8_t* tiles) {
+    int estimate = 0;
+    for (int line = 0; line < DAILY_PUZZLE_SIZE; line++) {
+        int row_goals[DAILY_PUZZLE_SIZE], column_goals[DAILY_PUZZLE_SIZE];
+        int in_row = 0, in_column = 0;
+        for (int i = 0; i < DAILY_PUZZLE_SIZE; i++) {
+            int row_tile = tiles[line * DAILY_PUZZLE_SIZE + i];
+            int column_tile = tiles[i * DAILY_PUZZLE_SIZE + line];
+            if (row_tile) {
+                int goal = row_tile - 1;
+                estimate += abs(goal / DAILY_PUZZLE_SIZE - line) + abs(goal % DAILY_PUZZLE_SIZE - i);
+                if (goal / DAILY_PUZZLE_SIZE == line) row_goals[in_row++] = goal % DAILY_PUZZLE_SIZE;
+            }
+            if (column_tile && (column_tile - 1) % DAILY_PUZZLE_SIZE == line) {
+                column_goals[in_column++] = (column_tile - 1) / DAILY_PUZZLE_SIZE;
+            }
+        }
+        estimate += line_conflicts(row_goals, in_row) + line_conflicts(column_goals, in_column);
+    }
+    return estimate;
+}
+
+static const int step_row[4] = {-1, 1, 0, 0};
+static const int step_col[4] = {0, 0, -1, 1};
+
+// Depth-first to the bound; returns 1 when solved, -1 when over budget
+static int puzzle_search(PuzzleSearch* search, int blank, int depth, int came_from) {
+    int estimate = puzzle_estimate(search->tiles);
+    if (estimate == 0) return 1;
+    if (depth + estimate > search->bound) return 0;
+    if (++search->nodes > SEARCH_NODE_BUDGET) return -1;
+
+    for (int dir = 0; dir < 4; dir++) {
+        if ((dir ^ 1) == came_from) continue;       // Never undo the last move
+        int row = blank / DAILY_PUZZLE_SIZE + step_row[dir];
+        int col = blank % DAILY_PUZZLE_SIZE + step_col[dir];
+        if (row < 0 || row >= DAILY_PUZZLE_SIZE || col < 0 || col >= DAILY_PUZZLE_SIZE) continue;
+        int next = row * DAILY_PUZZLE_SIZE + col;
+        search->tiles[blank] = search->tiles[next];
+        search->tiles[next] = 0;
+        int result = puzzle_search(search, next, depth + 1, dir);
+        search->tiles[next] = search->tiles[blank];
+        search->tiles[blank] = 0;
+        if (result != 0) return result;
+    }
+    return 0;
+}
+
+int daily_puzzle_optimal(const uint8_t* tiles, int max_moves) {
+    PuzzleSearch search;
+    int blank = -1;
+
+    memcpy(search.tiles, tiles, PUZZLE_CELLS);
+    for (int i = 0; i < PUZZLE_CELLS; i++) {
+        if (tiles[i] == 0) blank = i;
+    }
+    if (blank < 0) return -1;
+    search.nodes = 0;
+    for (search.bound = puzzle_estimate(tiles); search.bound <= max_moves; search.bound += 2) {
+        int result = puzzle_search(&search, blank, 0, -1);
+        if (result > 0) return search.bound;
+        if (result < 0) return -1;
+    }
+    return -1;
+}
+
+// Scrambles until the optimal length is in range; returns tries
+static int generate_puzzle(uint64_t* rng, DailyChallenge* out) {
+    for (int tries = 1;; tries++) {
+        uint8_t tiles[PUZZLE_CELLS];
+        int blank = PUZZLE_CELLS - 1, came_from = -1;
+        for (int i = 0; i < PUZZLE_CELLS; i++) tiles[i] = (uint8_t)((i + 1) % PUZZLE_CELLS);
+
+        for (int move = 0; move < SCRAMBLE_MOVES;) {
+            int dir = daily_below(rng, 4);
+            int row = blank / DAILY_PUZZLE_SIZE + step_row[dir];
+            int col = blank % DAILY_PUZZLE_SIZE + step_col[dir];
+            if ((dir ^ 1) == came_from || row < 0 || row >= DAILY_PUZZLE_SIZE || col < 0 || col >= DAILY_PUZZLE_SIZE) {
+                continue;
+            }
+            int next = row * DAILY_PUZZLE_SIZE + col;
+            tiles[blank] = tiles[next];
+            tiles[next] = 0;
+            blank = next;
+            came_from = dir;
+            move++;
+        }
+
+        int optimal = daily_puzzle_optimal(tiles, MAX_OPTIMAL_MOVES);
+        if (optimal < MIN_OPTIMAL_MOVES) continue;
+        memcpy(out->tiles, tiles, PUZZLE_CELLS);
+        out->optimal_moves = (uint8_t)optimal;
+        return tries;
+    }
+}
+
+int daily_generate(int day, DailyChallenge* out) {
+    memset(out, 0, sizeof(*out));
+    out->day = day;
+    for (int game = 0; game < DAILY_GAME_COUNT; game++) out->seeds[game] = daily_seed((DailyGame)game, day);
+
+    uint64_t mine_rng = out->seeds[DAILY_MINESWEEPER];
+    uint64_t puzzle_rng = out->seeds[DAILY_SLIDING_PUZZLE];
+    return generate_mines(&mine_rng, out) + generate_puzzle(&puzzle_rng, out);
+}
+
+typedef struct {
+    DailyChallenge* records;
+    int first_day, days;
+    int* next;
+} PackJob;
+
+static void* pack_worker(void* arg) {
+    PackJob* job = (PackJob*)arg;
+    // Days differ a lot in cost, so threads take the next one as they finish
+    for (;;) {
+        int index = __atomic_fetch_add(job->next, 1, __ATOMIC_RELAXED);
+        if (index >= job->days) break;
+        daily_generate(job->first_day + index, &job->records[index]);
+    }
+    return NULL;
+}
+
+static int default_threads(void) {
+#ifdef _WIN32
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > DAILY_MAX_THREADS) cores = DAILY_MAX_THREADS;
+    return (int)cores;
+#endif
+}
+
+static void generate_range(DailyChallenge* records, int first_day, int days, int threads) {
+    int next = 0;
+    PackJob job = {records, first_day, days, &next};
+
+    if (threads <= 0) threads = default_threads();
+    if (threads > DAILY_MAX_THREADS) threads = DAILY_MAX_THREADS;
+#ifndef _WIN32
+    pthread_t handles[DAILY_MAX_THREADS];
+    int started[DAILY_MAX_THREADS] = {0};
+    for (int t = 1; t < threads; t++) {
+        started[t] = (pthread_create(&handles[t], NULL, pack_worker, &job) == 0);
+    }
+    pack_worker(&job);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(handles[t], NULL);
+    }
+#else
+    (void)threads;
+    pack_worker(&job);
+#endif
+}
+
+int daily_pack_path(char* path, int size) {
+    return highscore_shared_path(PACK_FILE, path, size);
+}
+
+// Writes the pack file only; the mapped pack is left to the caller
+static int write_pack(const char* path, int first_day, int days, int threads) {
+    PackHeader header;
+    char temp_path[600];
+
+    if (days <= 0) return 0;
+    memset(&header, 0, sizeof(header));
+    header.magic = PACK_MAGIC;
+    header.record_size = sizeof(DailyChallenge);
+    header.first_day = first_day;
+    header.day_count = days;
+    size_t size = sizeof(header) + (size_t)days * sizeof(DailyChallenge);
+
+#ifndef _WIN32
+    const char* dir = highscore_shared_dir();
+    if (strncmp(path, dir, strlen(dir)) == 0 && !highscore_make_shared_dir()) return 0;
+
+    // Generated straight into the file's pages
+    int fd = highscore_create_temp(path, temp_path, sizeof(temp_path));
+    if (fd < 0) return 0;
+    fchmod(fd, 0644);
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        remove(temp_path);
+        return 0;
+    }
+    generate_range((DailyChallenge*)((char*)mapped + sizeof(header)), first_day, days, threads);
+    memcpy(mapped, &header, sizeof(header));    // Header last: a torn pack never validates
+    int ok = munmap(mapped, size) == 0;
+#else
+    if (snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(temp_path)) {
+        return 0;
+    }
+    DailyChallenge* records = calloc((size_t)days, sizeof(DailyChallenge));
+    FILE* file = records ? fopen(temp_path, "wb") : NULL;
+    int ok = file != NULL;
+    if (ok) {
+        generate_range(records, first_day, days, threads);
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(records, sizeof(DailyChallenge), (size_t)days, file) == (size_t)days;
+    }
+    if (file) ok = fclose(file) == 0 && ok;
+    free(records);
+#endif
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+int daily_pack_write(const char* path, int first_day, int days, int threads) {
+    if (!write_pack(path, first_day, days, threads)) return 0;
+    if (pack) daily_close();                    // Pick up the new pack on next load
+    pack_tried = 0;
+    return 1;
+}
+
+#ifndef _WIN32
+static void map_pack(void) {
+    char path[512];
+    struct stat st;
+    PackHeader header;
+
+    if (!daily_pack_path(path, sizeof(path))) return;
+    int fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) return;
+    if (fstat(fd, &st) != 0 || read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        header.magic != PACK_MAGIC || header.record_size != sizeof(DailyChallenge) || header.day_count <= 0 ||
+        st.st_size != (off_t)(sizeof(header) + (size_t)header.day_count * sizeof(DailyChallenge))) {
+        close(fd);
+        return;
+    }
+    void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return;
+    pack = (const PackHeader*)mapped;
+    pack_size = (size_t)st.st_size;
+}
+
+// Days the pack covers from day onward
+static int pack_days_left(int day) {
+    if (__atomic_exchange_n(&pack_replaced, 0, __ATOMIC_ACQUIRE)) daily_close();
+    if (!pack_tried) {
+        pack_tried = 1;
+        map_pack();
+    }
+    if (!pack || day < pack->first_day) return 0;
+    int left = pack->first_day + pack->day_count - day;
+    return left > 0 ? left : 0;
+}
+
+static void* background_main(void* arg) {
+    char path[512];
+    int first_day = (int)(intptr_t)arg;
+
+    if (daily_pack_path(path, sizeof(path)) && write_pack(path, first_day, DAILY_PACK_DAYS, 1)) {
+        __atomic_store_n(&pack_replaced, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&generating, 0, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int daily_prepare(void) {
+    int today = daily_today();
+    if (pack_days_left(today) > DAILY_REFRESH_DAYS) return 0;
+
+    int idle = 0;
+    if (!__atomic_compare_exchange_n(&generating, &idle, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return 1;
+
+    // Detached, on one core, with signals left to the game thread
+    pthread_t thread;
+    pthread_attr_t attributes;
+    sigset_t all, previous;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    int started = pthread_create(&thread, &attributes, background_main, (void*)(intptr_t)today) == 0;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    pthread_attr_destroy(&attributes);
+    if (!started) __atomic_store_n(&generating, 0, __ATOMIC_RELEASE);
+    return started;
+}
+#else
+int daily_prepare(void) {
+    return 0;                           // No packs: days are generated on the spot
+}
+#endif
+
+int daily_load(int day, DailyChallenge* out) {
+#ifndef _WIN32
+    if (pack_days_left(day) > 0) {
+        const DailyChallenge* records = (const DailyChallenge*)(pack + 1);
+        const DailyChallenge* record = &records[day - pack->first_day];
+        if (record->day == day) {
+            *out = *record;
+            return DAILY_FROM_PACK;
+        }
+    }
+    // Never solved at play time: a pack from today on is made in the
+    // background and the day can be loaded once it is in
+    daily_prepare();
+    memset(out, 0, sizeof(*out));
+    return DAILY_PENDING;
+#else
+    daily_generate(day, out);
+    return DAILY_GENERATED;
+#endif
+}
+
+void daily_close(void) {
+#ifndef _WIN32
+    if (pack) munmap((void*)pack, pack_size);
+#endif
+    pack = NULL;
+    pack_size = 0;
+    pack_tried = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef DAILY_H
+#define DAILY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Daily challenges: the same content for every player on a given UTC day.
+ *
+ * Each day has a seed per game, derived from the day number alone, and
+ * everything is generated from those seeds deterministically. Cheap
+ * content (the hangman and scramble words, 2048 tile spawns, Yahtzee
+ * dice) is drawn from a small stream generator seeded at play time. The
+ * expensive parts are solved ahead of time: a Minesweeper board that can
+ * be cleared from its opening without guessing, and a 15-puzzle scramble
+ * with its optimal solution length found by IDA*.
+ *
+ * A batch job (make daily) generates a range of days on several threads
+ * into a content pack in the shared directory: a header and one fixed-size
+ * record per day, so today's challenge is found by index in the mapped
+ * file. Nothing is solved at play time: when the pack is missing, or runs
+ * out within DAILY_REFRESH_DAYS, a background thread writes a new one from
+ * today on, and until it is in a load reports DAILY_PENDING. Windows has
+ * no packs and generates each day on the spot, with identical results.
+ */
+
+#define DAILY_MINE_WIDTH 16
+#define DAILY_MINE_HEIGHT 16
+#define DAILY_MINE_COUNT 40
+#define DAILY_PUZZLE_SIZE 4
+#define DAILY_MAX_THREADS 64
+#define DAILY_PACK_DAYS 30              // Days in a pack made in the background
+#define DAILY_REFRESH_DAYS 7            // Renew a pack with this few days left
+
+typedef enum {
+    DAILY_MINESWEEPER,
+    DAILY_SLIDING_PUZZLE,
+    DAILY_2048,
+    DAILY_HANGMAN,
+    DAILY_WORD_SCRAMBLE,
+    DAILY_YAHTZEE,
+    DAILY_GAME_COUNT
+} DailyGame;
+
+typedef enum {
+    DAILY_FROM_PACK,
+    DAILY_GENERATED,
+    DAILY_PENDING                       // Not in the pack yet: being generated
+} DailySource;
+
+// One day's content: 128 bytes, stored as-is in the pack
+typedef struct {
+    uint64_t seeds[DAILY_GAME_COUNT];
+    int32_t day;                        // Days since 1970-01-01 (UTC)
+    uint16_t mine_start;                // Cell that opens the board
+    uint8_t optimal_moves;              // Shortest solution of tiles
+    uint8_t reserved;
+    uint8_t mines[DAILY_MINE_WIDTH * DAILY_MINE_HEIGHT / 8];
+    uint8_t tiles[DAILY_PUZZLE_SIZE * DAILY_PUZZLE_SIZE];   // Row-major, 0 = blank
+    uint8_t padding[24];
+} DailyChallenge;
+
+int daily_today(void);
+void daily_date(int day, char* text, size_t size);      // "YYYY-MM-DD"
+uint64_t daily_seed(DailyGame game, int day);
+
+// Stream generator for cheap content; state starts as a day's seed
+uint32_t daily_random(uint64_t* state);
+int daily_below(uint64_t* state, int bound);
+
+static inline int daily_is_mine(const DailyChallenge* challenge, int cell) {
+    return (challenge->mines[cell >> 3] >> (cell & 7)) & 1;
+}
+
+// Generates one day from scratch; returns how many boards and scrambles
+// were tried before the checks passed
+int daily_generate(int day, DailyChallenge* out);
+
+// Generates days [first_day, first_day + days) into a pack at path;
+// threads <= 0 uses one per core. Returns 1 on success.
+int daily_pack_write(const char* path, int first_day, int days, int threads);
+int daily_pack_path(char* path, int size);
+
+// Starts writing a pack in the background when today's is missing or
+// about to run out; returns 1 while one is being written
+int daily_prepare(void);
+
+// Today's (or any day's) challenge from the pack. When the pack does not
+// cover the day, out is zeroed and DAILY_PENDING returned while a pack is
+// made in the background. Returns the DailySource.
+int daily_load(int day, DailyChallenge* out);
+void daily_close(void);
+
+// The checks the generator applies, for verifying a pack
+int daily_mines_solvable(const uint8_t* mines, int start);
+int daily_puzzle_optimal(const uint8_t* tiles, int max_moves);
+
+#endif // DAILY_H
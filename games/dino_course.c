@@ -0,0 +1,294 @@
+/*
+ * Dino Runner Obstacle Courses
+ * Part of CLI Games Pack v2.1
+ *
+ * File layout: a 48-byte header {magic, obstacle count, section count,
+ * finish position, index offset, speed, name}, then the obstacle varints
+ * described in dino_course.h (padded to a multiple of four bytes), then
+ * one 12-byte DinoCourseSection per section.
+ *
+ * The writer keeps only the section index in memory (twelve bytes per
+ * 32 obstacles) and streams the body to a temp file, then seeks back to
+ * fill in the header once the counts are known.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "dino_course.h"
+#include "highscores.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#define COURSE_MAGIC 0x31524344u        // "DCR1"
+#define MAX_VARINT_BYTES 5
+
+typedef struct {
+    uint32_t magic;
+    uint32_t obstacle_count;
+    uint32_t section_count;
+    uint32_t length;
+    uint32_t index_offset;              // From the start of the file
+    uint32_t speed_tenths;
+    char name[DINO_COURSE_NAME];
+} DinoCourseHeader;
+
+int dino_course_writer_begin(DinoCourseWriter* writer, const char* path, const char* name, uint32_t speed_tenths) {
+    DinoCourseHeader header;
+
+    memset(writer, 0, sizeof(*writer));
+    if (snprintf(writer->path, sizeof(writer->path), "%s", path) >= (int)sizeof(writer->path)) return 0;
+    snprintf(writer->name, sizeof(writer->name), "%s", name);
+    writer->speed_tenths = speed_tenths;
+
+    // The header is rewritten with the real counts at the end
+#ifndef _WIN32
+    int fd = highscore_create_temp(path, writer->temp_path, sizeof(writer->temp_path));
+    if (fd < 0) return 0;
+    writer->file = fdopen(fd, "wb");
+    if (!writer->file) {
+        close(fd);
+        remove(writer->temp_path);
+        return 0;
+    }
+#else
+    if (snprintf(writer->temp_path, sizeof(writer->temp_path), "%s.%ld.tmp", path, (long)getpid()) >=
+        (int)sizeof(writer->temp_path)) {
+        return 0;
+    }
+    writer->file = fopen(writer->temp_path, "wb");
+    if (!writer->file) return 0;
+#endif
+    memset(&header, 0, sizeof(header));
+    if (fwrite(&header, sizeof(header), 1, writer->file) != 1) {
+        dino_course_writer_abort(writer);
+        return 0;
+    }
+    return 1;
+}
+
+int dino_course_writer_add(DinoCourseWriter* writer, int type, uint32_t position) {
+    uint8_t bytes[MAX_VARINT_BYTES];
+    int length = 0;
+
+    if (writer->failed || !writer->file) return 0;
+    if (type < 0 || type >= DINO_COURSE_TYPES || position < writer->position ||
+        position - writer->position >= DINO_COURSE_MAX_GAP) {
+        return 0;
+    }
+
+    if (writer->count % DINO_COURSE_SECTION == 0) {
+        if (writer->section_count == writer->section_capacity) {
+            uint32_t capacity = writer->section_capacity ? writer->section_capacity * 2 : 256;
+            DinoCourseSection* grown = realloc(writer->sections, capacity * sizeof(DinoCourseSection));
+            if (!grown) {
+                writer->failed = 1;
+                return 0;
+            }
+            writer->sections = grown;
+            writer->section_capacity = capacity;
+        }
+        DinoCourseSection* section = &writer->sections[writer->section_count++];
+        section->base = writer->position;
+        section->offset = writer->bytes;
+        section->obstacle = writer->count;
+    }
+
+    uint32_t value = (position - writer->position) << 4 | (uint32_t)type;
+    while (value >= 0x80) {
+        bytes[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = (uint8_t)value;
+    if (fwrite(bytes, 1, (size_t)length, writer->file) != (size_t)length) {
+        writer->failed = 1;
+        return 0;
+    }
+
+    writer->bytes += (uint32_t)length;
+    writer->position = position;
+    writer->count++;
+    return 1;
+}
+
+int dino_course_writer_finish(DinoCourseWriter* writer, uint32_t length) {
+    static const uint8_t padding[4] = {0};
+    DinoCourseHeader header;
+
+    if (!writer->file) return 0;
+    size_t pad = (4 - writer->bytes % 4) % 4;
+    memset(&header, 0, sizeof(header));
+    header.magic = COURSE_MAGIC;
+    header.obstacle_count = writer->count;
+    header.section_count = writer->section_count;
+    header.length = length > writer->position ? length : writer->position;
+    header.index_offset = (uint32_t)(sizeof(header) + writer->bytes + pad);
+    header.speed_tenths = writer->speed_tenths;
+    memcpy(header.name, writer->name, sizeof(header.name));
+
+    int ok = !writer->failed && fwrite(padding, 1, pad, writer->file) == pad &&
+             fwrite(writer->sections, sizeof(DinoCourseSection), writer->section_count, writer->file) ==
+                 writer->section_count &&
+             fseek(writer->file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, writer->file) == 1;
+    ok = fclose(writer->file) == 0 && ok;
+    writer->file = NULL;
+    free(writer->sections);
+    writer->sections = NULL;
+
+    // A course being played keeps reading the old file
+#ifdef _WIN32
+    if (ok) remove(writer->path);
+#endif
+    if (!ok || rename(writer->temp_path, writer->path) != 0) {
+        remove(writer->temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+void dino_course_writer_abort(DinoCourseWriter* writer) {
+    if (writer->file) {
+        fclose(writer->file);
+        remove(writer->temp_path);
+    }
+    free(writer->sections);
+    writer->file = NULL;
+    writer->sections = NULL;
+}
+
+static void decode_next(DinoCourse* course) {
+    uint32_t value = 0;
+    int shift = 0;
+    uint8_t part;
+
+    course->has_pending = 0;
+    if (course->number >= course->obstacle_count) return;
+    do {
+        if (course->next >= course->end || shift > 28) return;    // Cut short: the course ends here
+        part = *course->next++;
+        value |= (uint32_t)(part & 0x7F) << shift;
+        shift += 7;
+    } while (part & 0x80);
+
+    course->pending_position += value >> 4;
+    course->pending_type = (int)(value & 15);
+    course->has_pending = 1;
+}
+
+int dino_course_peek(const DinoCourse* course, int* type, uint32_t* position) {
+    if (!course->has_pending) return 0;
+    *type = course->pending_type;
+    *position = course->pending_position;
+    return 1;
+}
+
+void dino_course_advance(DinoCourse* course) {
+    if (!course->has_pending) return;
+    course->number++;
+    decode_next(course);
+}
+
+uint32_t dino_course_seek(DinoCourse* course, uint32_t position) {
+    uint32_t low = 0, high = course->section_count;
+
+    // Last section whose base is at or before position
+    while (high - low > 1) {
+        uint32_t middle = low + (high - low) / 2;
+        if (course->index[middle].base <= position) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    const DinoCourseSection* section = course->section_count ? &course->index[low] : NULL;
+    uint32_t base = 0;
+    if (!section || section->offset > (size_t)(course->end - course->body) ||
+        section->obstacle > course->obstacle_count) {
+        // No index (an empty course) or a damaged entry: from the start
+        course->next = course->body;
+        course->number = 0;
+    } else {
+        course->next = course->body + section->offset;
+        course->number = section->obstacle;
+        base = section->base;
+    }
+    course->pending_position = base;
+    decode_next(course);
+    return base;
+}
+
+int dino_course_open(DinoCourse* course, const char* path) {
+    DinoCourseHeader header;
+    const uint8_t* bytes;
+    size_t size;
+
+    memset(course, 0, sizeof(*course));
+#ifdef _WIN32
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = file_size > 0 ? malloc((size_t)file_size) : NULL;
+    size = data ? fread(data, 1, (size_t)file_size, file) : 0;
+    fclose(file);
+    if (!data) return 0;
+    course->mapping = data;
+    course->mapping_size = size;
+    bytes = data;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(header)) {
+        close(fd);
+        return 0;
+    }
+    size = (size_t)st.st_size;
+    void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return 0;
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    course->mapping = mapped;
+    course->mapping_size = size;
+    bytes = mapped;
+#endif
+
+    // Only the header and the index bounds: sections are checked when used
+    if (size >= sizeof(header)) memcpy(&header, bytes, sizeof(header));
+    if (size < sizeof(header) || header.magic != COURSE_MAGIC || header.index_offset % 4 != 0 ||
+        header.index_offset < sizeof(header) || header.index_offset > size ||
+        header.section_count != (header.obstacle_count + DINO_COURSE_SECTION - 1) / DINO_COURSE_SECTION ||
+        (size - header.index_offset) / sizeof(DinoCourseSection) != header.section_count ||
+        (size - header.index_offset) % sizeof(DinoCourseSection) != 0) {
+        dino_course_close(course);
+        return 0;
+    }
+
+    course->body = bytes + sizeof(header);
+    course->end = bytes + header.index_offset;
+    course->index = (const DinoCourseSection*)(bytes + header.index_offset);
+    course->obstacle_count = header.obstacle_count;
+    course->section_count = header.section_count;
+    course->length = header.length;
+    course->speed_tenths = header.speed_tenths;
+    memcpy(course->name, header.name, sizeof(course->name));
+    course->name[DINO_COURSE_NAME - 1] = '\0';
+    dino_course_seek(course, 0);
+    return 1;
+}
+
+void dino_course_close(DinoCourse* course) {
+#ifndef _WIN32
+    if (course->mapping) munmap(course->mapping, course->mapping_size);
+#else
+    free(course->mapping);
+#endif
+    memset(course, 0, sizeof(*course));
+}
@@ -0,0 +1,89 @@
+#ifndef DINO_COURSE_H
+#define DINO_COURSE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Authored obstacle courses for Dino Runner, streamed as the dino runs.
+ *
+ * A course is a list of obstacles at absolute positions along the track,
+ * in columns. Each obstacle is one varint holding the distance from the
+ * obstacle before it, shifted left four bits, with the type in the low
+ * bits: two bytes for the usual gaps of a few hundred columns. Every
+ * DINO_COURSE_SECTION obstacles start a section, and a section index at
+ * the end of the file holds where each one starts (byte offset, obstacle
+ * number and the position its first gap counts from). Sections are the
+ * checkpoints: retrying from one is a binary search of the index and
+ * decoding starts right there, with nothing replayed.
+ *
+ * Playing maps the file read-only and checks only the header and the
+ * index bounds, so opening costs the same for any length of course, and
+ * the reader is a fixed-size struct that decodes forward as the dino
+ * advances. On Windows the file is read into memory instead.
+ */
+
+#define DINO_COURSE_SECTION 32              // Obstacles per checkpoint
+#define DINO_COURSE_TYPES 16                // Type field of an obstacle
+#define DINO_COURSE_MAX_GAP (1u << 27)      // Largest distance between two obstacles
+#define DINO_COURSE_NAME 24
+
+typedef struct {
+    uint32_t base;                      // Position the section's first gap counts from
+    uint32_t offset;                    // Byte offset of its first obstacle in the body
+    uint32_t obstacle;                  // Obstacles before it
+} DinoCourseSection;
+
+typedef struct {
+    FILE* file;
+    char path[512];
+    char temp_path[600];
+    char name[DINO_COURSE_NAME];
+    uint32_t speed_tenths;
+    uint32_t count;
+    uint32_t position;                  // Position of the last obstacle added
+    uint32_t bytes;                     // Body bytes written
+    DinoCourseSection* sections;
+    uint32_t section_count, section_capacity;
+    int failed;
+} DinoCourseWriter;
+
+typedef struct {
+    const uint8_t* body;
+    const uint8_t* next;                // Next undecoded byte
+    const uint8_t* end;
+    const DinoCourseSection* index;
+    void* mapping;
+    size_t mapping_size;
+    char name[DINO_COURSE_NAME];
+    uint32_t obstacle_count;
+    uint32_t section_count;
+    uint32_t length;                    // Position of the finish line
+    uint32_t speed_tenths;              // Columns per frame, in tenths
+    uint32_t number;                    // Obstacles before the pending one
+    uint32_t pending_position;
+    int pending_type;
+    int has_pending;
+} DinoCourse;
+
+// Obstacles must be added in order of position; finish writes the index
+// and renames the temp file over path. Returns 1 on success
+int dino_course_writer_begin(DinoCourseWriter* writer, const char* path, const char* name, uint32_t speed_tenths);
+int dino_course_writer_add(DinoCourseWriter* writer, int type, uint32_t position);
+int dino_course_writer_finish(DinoCourseWriter* writer, uint32_t length);
+void dino_course_writer_abort(DinoCourseWriter* writer);
+
+// Returns 1 when path holds a valid course; reading starts at the first obstacle
+int dino_course_open(DinoCourse* course, const char* path);
+void dino_course_close(DinoCourse* course);
+
+// The next obstacle, if any, without consuming it
+int dino_course_peek(const DinoCourse* course, int* type, uint32_t* position);
+void dino_course_advance(DinoCourse* course);
+
+// Moves to the last checkpoint at or before position and returns the
+// position its first gap counts from (0 for the start of the course)
+uint32_t dino_course_seek(DinoCourse* course, uint32_t position);
+
+#endif // DINO_COURSE_H
@@ -25,13 +25,21 @@
 #include <stdbool.h>
 #include <math.h>
 #include "games.h"
+#include "alias_table.h"
+#include "dino_course.h"
+#include "flight_recorder.h"
+#include "ghost_trace.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "ratings.h"
+#include "terminal.h"
+#include "write_behind.h"
 
 #ifdef _WIN32
     #include <windows.h>
     #include <conio.h>
     #define CLEAR_SCREEN() system("cls")
     #define SLEEP_MS(ms) Sleep(ms)
-    #define DINO_KBHIT() games_kbhit()
     #define GETCH() _getch()
 #else
     #include <unistd.h>
@@ -39,7 +47,6 @@
     #include <fcntl.h>
     #define CLEAR_SCREEN() system("clear")
     #define SLEEP_MS(ms) usleep((ms) * 1000)
-    #define DINO_KBHIT() games_kbhit()
     #define GETCH() getchar()
 #endif
 
@@ -53,6 +60,16 @@
 #define MAX_OBSTACLES 20
 #define MAX_CLOUDS 10
 #define MAX_ACHIEVEMENTS 20
+#define COURSE_SLOTS 9
+#define COURSE_EDIT_MAX 4096   // Obstacles the editor holds; longer courses are play-only
+#define COURSE_EDIT_LEAD 20    // Columns shown behind the editor cursor
+#define COURSE_EDIT_STEP 40    // Columns per [A]/[D] and between ruler marks
+#define COURSE_STARTER_OBSTACLES 96
+#define COURSE_GENERATE_MAX 1000000
+#define COURSE_SPEED_TENTHS 70
+#define COURSE_MIN_SPEED_TENTHS 30
+#define COURSE_MIN_GAP_FRAMES 40   // Random courses: 40-89 frames between obstacles
+#define COURSE_GAP_SPREAD 50
 
 // Enhanced Physics Constants
 #define GRAVITY 0.6f           // Slightly increased gravity for better jump feel
@@ -174,6 +191,11 @@ typedef struct {
     // Game variables
     int score;
     int high_score;
+    int hall_of_fame_rank;     // Rank of the last run in the shared table
+    bool ghost_saved;          // The last run became the new ghost
+    double distance;           // Columns run since the start (obstacle course)
+    bool course_finished;      // Crossed the finish line
+    bool course_resumed;       // Started at a checkpoint: no ghost, no hall of fame
     float game_speed;
     bool game_running;
     bool game_over;
@@ -234,6 +256,40 @@ static char* obstacle_sprites[OBSTACLE_COUNT] = {
 
 static int obstacle_widths[OBSTACLE_COUNT] = {1, 3, 3, 3, 3, 3, 4, 6, 3, 3, 3, 4};
 static int obstacle_heights[OBSTACLE_COUNT] = {2, 2, 2, 1, 1, 2, 2, 1, 2, 3, 1, 2};
+static const char* obstacle_names[OBSTACLE_COUNT] = {
+    "Small cactus", "Large cactus", "Rock", "Bird high", "Bird low", "Double cactus",
+    "Triple cactus", "Bird swarm", "Rolling rock", "Tall tree", "Low branch", "Spike trap"
+};
+
+// Obstacle mix per difficulty tier (score < 100, < 300, < 600, expert)
+#define OBSTACLE_TIERS 4
+static const uint32_t obstacle_tier_weights[OBSTACLE_TIERS][OBSTACLE_COUNT] = {
+    {1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // Small cactus, large cactus, rock
+    {1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0},   // Add birds and double cactus
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0},   // Add triple cactus, swarms, rolling rocks
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},   // Everything
+};
+static AliasTable obstacle_tables[OBSTACLE_TIERS];
+static FastRng obstacle_rng;
+
+// Personal-best ghost: the current run is recorded while the best one for
+// this player and mode plays back beside it
+static GhostRecorder ghost_recorder;
+static GhostPlayer ghost;
+static bool ghost_loaded = false;
+static uint32_t ghost_tick = 0;
+static bool ghost_save_queued = false;     // The last run's ghost may not be on disk yet
+
+// Obstacle course being played, streamed from its mapped file, and the
+// one being edited, held whole
+typedef struct {
+    uint32_t position;
+    int type;
+} CourseMark;
+
+static DinoCourse course;
+static bool course_loaded = false;
+static CourseMark course_marks[COURSE_EDIT_MAX];
 
 // Function Declarations
 void dino_runner_init_game(void);
@@ -251,11 +307,20 @@ void dino_runner_update_obstacles(void);
 void dino_runner_update_clouds(void);
 void dino_runner_check_collisions(void);
 void dino_runner_spawn_obstacle(void);
+void dino_runner_place_obstacle(Obstacle* obstacle, int type, float x);
+void dino_runner_course_stream(void);
+void dino_runner_course_resume(double reached);
+void dino_runner_course_finish(void);
+void dino_runner_ghost_start(void);
+void dino_runner_ghost_tick(uint32_t tick);
+void dino_runner_ghost_finish(uint32_t tick);
 
 // Rendering Functions
 void dino_runner_clear_screen_buffer(void);
 void dino_runner_draw_to_buffer(int x, int y, const char* text);
 void dino_runner_draw_dino(void);
+void dino_runner_draw_ghost(void);
+void dino_runner_draw_obstacle(const Obstacle* obstacle);
 void dino_runner_draw_obstacles(void);
 void dino_runner_draw_clouds(void);
 void dino_runner_draw_ground(void);
@@ -267,6 +332,9 @@ void dino_runner_classic_mode(void);
 void dino_runner_sprint_mode(void);
 void dino_runner_marathon_mode(void);
 void dino_runner_obstacle_course_mode(void);
+void dino_runner_course_play(int slot);
+void dino_runner_course_generate(int slot);
+void dino_runner_course_editor(int slot);
 void dino_runner_custom_mode(void);
 
 // UI Functions
@@ -317,6 +385,10 @@ void dino_runner_init_game(void) {
     
     dino_runner_load_statistics();
     srand((unsigned int)time(NULL));
+    fast_rng_seed_from_rand(&obstacle_rng);
+    for (int tier = 0; tier < OBSTACLE_TIERS; tier++) {
+        alias_table_build(&obstacle_tables[tier], obstacle_tier_weights[tier], OBSTACLE_COUNT);
+    }
 }
 
 void dino_runner_main_menu(void) {
@@ -476,27 +548,360 @@ void dino_runner_marathon_mode(void) {
     dino_runner_game_loop();
 }
 
+static int dino_runner_course_path(int slot, char* path, int size) {
+    char file_name[40];
+    snprintf(file_name, sizeof(file_name), "dino_course_%d.course", slot);
+    highscore_open();
+    return highscore_shared_path(file_name, path, size);
+}
+
+// Random course on the endless modes' obstacle mix, ramping through the
+// tiers over its length, with gaps that leave time to land and react
+static int dino_runner_course_write_random(const char* path, const char* name, uint32_t count) {
+    DinoCourseWriter writer;
+    uint32_t position = 0;
+    
+    if (!dino_course_writer_begin(&writer, path, name, COURSE_SPEED_TENTHS)) return 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int tier = (int)((uint64_t)i * OBSTACLE_TIERS / count);
+        position += (COURSE_MIN_GAP_FRAMES + fast_rng_below(&obstacle_rng, COURSE_GAP_SPREAD)) * COURSE_SPEED_TENTHS / 10;
+        if (!dino_course_writer_add(&writer, alias_table_sample(&obstacle_tables[tier], &obstacle_rng), position)) {
+            dino_course_writer_abort(&writer);
+            return 0;
+        }
+    }
+    return dino_course_writer_finish(&writer, position + SCREEN_WIDTH);
+}
+
 void dino_runner_obstacle_course_mode(void) {
-    CLEAR_SCREEN();
-    dino_runner_display_header("OBSTACLE COURSE");
+    char path[512];
+    int choice, action;
     
-    printf("+===========================================+\n");
-    printf("|          PRECISION CHALLENGE             |\n");
-    printf("+===========================================+\n");
-    printf("|                                           |\n");
-    printf("|  * 20 handcrafted levels                  |\n");
-    printf("|  * Precise timing required                |\n");
-    printf("|  * Star rating system                     |\n");
-    printf("|  * Perfect jumps and ducks                |\n");
-    printf("|  * Unlock new courses                     |\n");
-    printf("|                                           |\n");
-    printf("|  Coming Soon in v2.0!                     |\n");
-    printf("|                                           |\n");
-    printf("+===========================================+\n");
-    printf("\nPress any key to return...");
+    // Slot 1 holds a short starter course until someone replaces it
+    if (dino_runner_course_path(1, path, sizeof(path)) && !dino_course_open(&course, path)) {
+        dino_runner_course_write_random(path, "Starter", COURSE_STARTER_OBSTACLES);
+    }
+    dino_course_close(&course);
+    
+    while (1) {
+        CLEAR_SCREEN();
+        dino_runner_display_header("OBSTACLE COURSE");
+        
+        printf("+===========================================+\n");
+        printf("|  Slot  Course                 Obstacles   |\n");
+        printf("+-------------------------------------------+\n");
+        for (int slot = 1; slot <= COURSE_SLOTS; slot++) {
+            DinoCourse info;
+            if (dino_runner_course_path(slot, path, sizeof(path)) && dino_course_open(&info, path)) {
+                printf("|  %d.    %-20.20s %11u   |\n", slot, info.name, (unsigned)info.obstacle_count);
+                dino_course_close(&info);
+            } else {
+                printf("|  %d.    %-20s %11s   |\n", slot, "(empty)", "");
+            }
+        }
+        printf("|                                           |\n");
+        printf("|  0. Back                                  |\n");
+        printf("+===========================================+\n");
+        printf("\n> Choose a course slot (0-%d): ", COURSE_SLOTS);
+        
+        if (scanf("%d", &choice) != 1) {
+            dino_runner_clear_input_buffer();
+            continue;
+        }
+        if (choice == 0) return;
+        if (choice < 1 || choice > COURSE_SLOTS) continue;
+        
+        printf("\n  1. Play   2. Edit   3. Generate a random course   0. Back\n");
+        printf("> ");
+        if (scanf("%d", &action) != 1) {
+            dino_runner_clear_input_buffer();
+            continue;
+        }
+        switch (action) {
+            case 1: dino_runner_course_play(choice); break;
+            case 2: dino_runner_course_editor(choice); break;
+            case 3: dino_runner_course_generate(choice); break;
+            default: break;
+        }
+    }
+}
+
+// Opening maps the file and reads its header, so even a course of
+// millions of obstacles starts at once
+void dino_runner_course_play(int slot) {
+    char path[512];
+    
+    if (!dino_runner_course_path(slot, path, sizeof(path)) || !dino_course_open(&course, path)) {
+        printf("\n[!] Slot %d is empty: edit or generate a course first.\n", slot);
+        printf("Press Enter to continue...");
+        dino_runner_clear_input_buffer();
+        GETCH();
+        return;
+    }
+    course_loaded = true;
+    dino_runner_reset_game();
+    dino_runner_game_loop();
+    dino_course_close(&course);
+    course_loaded = false;
+}
+
+void dino_runner_course_generate(int slot) {
+    char path[512], name[DINO_COURSE_NAME];
+    int count;
+    
+    printf("\n> How many obstacles? (1-%d): ", COURSE_GENERATE_MAX);
+    if (scanf("%d", &count) != 1 || count < 1 || count > COURSE_GENERATE_MAX) {
+        dino_runner_clear_input_buffer();
+        return;
+    }
+    snprintf(name, sizeof(name), "Random %d", count);
+    uint64_t start = terminal_now_us();
+    if (dino_runner_course_path(slot, path, sizeof(path)) &&
+        dino_runner_course_write_random(path, name, (uint32_t)count)) {
+        printf("\n  Wrote %d obstacles in %.1f ms.\n", count, (terminal_now_us() - start) / 1000.0);
+    } else {
+        printf("\n[!] Could not write the course.\n");
+    }
+    printf("Press Enter to continue...");
+    dino_runner_clear_input_buffer();
     GETCH();
 }
 
+// Retries from the checkpoint at or before where the last run got to:
+// the index names the section, decoding starts there, and its first
+// obstacle enters from the right edge after a clear screen of run-up
+void dino_runner_course_resume(double reached) {
+    int type;
+    uint32_t first;
+    
+    dino_course_seek(&course, reached > 0 ? (uint32_t)reached : 0);
+    if (course.number == 0 || !dino_course_peek(&course, &type, &first)) {
+        dino_course_seek(&course, 0);              // Still in the first section: a plain restart
+        return;
+    }
+    game.distance = first > SCREEN_WIDTH ? first - SCREEN_WIDTH : 0;
+    game.score = (int)course.number * 10;
+    game.course_resumed = true;
+    if (ghost_loaded) {
+        ghost_player_close(&ghost);
+        ghost_loaded = false;
+    }
+    dino_runner_play_sound("Back to the checkpoint!");
+}
+
+void dino_runner_course_finish(void) {
+    game.course_finished = true;
+    game.game_over = true;
+    dino_runner_play_sound("FINISH LINE!");
+    
+    if (game.score > game.high_score) {
+        game.high_score = game.score;
+    }
+    if (!game.course_resumed) {
+        game.hall_of_fame_rank = highscore_submit(HIGHSCORE_DINO_RUNNER, game.current_mode,
+                                                  ratings_local_player(), (uint32_t)game.score);
+    }
+}
+
+// Editor: the course drawn 1:1 around a cursor on the track, with a ruler
+// of positions under the ground
+static void dino_runner_course_editor_render(int slot, const char* name, int count, uint32_t cursor,
+                                             int type, uint32_t speed_tenths, bool dirty, const char* status) {
+    char text[100];
+    uint32_t view = cursor > COURSE_EDIT_LEAD ? cursor - COURSE_EDIT_LEAD : 0;
+    
+    game.is_night = false;
+    game.ground_offset = (int)(view % 4);
+    dino_runner_clear_screen_buffer();
+    
+    for (int i = 0; i < count; i++) {
+        uint32_t position = course_marks[i].position;
+        if (position + 10 < view) continue;
+        if (position >= view + SCREEN_WIDTH) break;
+        Obstacle mark;
+        dino_runner_place_obstacle(&mark, course_marks[i].type, (float)position - (float)view);
+        dino_runner_draw_obstacle(&mark);
+    }
+    dino_runner_draw_ground();
+    for (uint32_t x = 0; x < SCREEN_WIDTH; x++) {
+        if ((view + x) % COURSE_EDIT_STEP == 0) {
+            sprintf(text, "|%u", (unsigned)(view + x));
+            dino_runner_draw_to_buffer((int)x, GROUND_Y + 3, text);
+        }
+    }
+    dino_runner_draw_to_buffer((int)(cursor - view), GROUND_Y + 2, "^");
+    
+    sprintf(text, "EDIT SLOT %d: %.20s%s", slot, name, dirty ? " (unsaved)" : "");
+    dino_runner_draw_to_buffer(2, 1, text);
+    sprintf(text, "POS: %u  OBSTACLES: %d/%d  SPEED: %.1f  TYPE: < %s >", (unsigned)cursor, count,
+            COURSE_EDIT_MAX, speed_tenths / 10.0, obstacle_names[type]);
+    dino_runner_draw_to_buffer(2, 2, text);
+    dino_runner_draw_to_buffer(2, 3, status);
+    dino_runner_draw_to_buffer(2, SCREEN_HEIGHT - 2, "[<- ->] Move [A/D] Move 40 [UP/DOWN] Type [SPACE] Place [X] Delete");
+    dino_runner_draw_to_buffer(2, SCREEN_HEIGHT - 1, "[,/.] Prev/next obstacle [+/-] Speed [W] Save [ESC] Done");
+    
+    printf("\033[H");
+    dino_runner_display_header("COURSE EDITOR");
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        printf("\033[%d;1H%s", y + 4, screen_buffer[y]);
+    }
+    fflush(stdout);
+}
+
+static bool dino_runner_course_save(int slot, const char* name, int count, uint32_t speed_tenths) {
+    char path[512];
+    DinoCourseWriter writer;
+    
+    if (!dino_runner_course_path(slot, path, sizeof(path)) ||
+        !dino_course_writer_begin(&writer, path, name, speed_tenths)) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!dino_course_writer_add(&writer, course_marks[i].type, course_marks[i].position)) {
+            dino_course_writer_abort(&writer);
+            return false;
+        }
+    }
+    uint32_t last = count > 0 ? course_marks[count - 1].position : 0;
+    return dino_course_writer_finish(&writer, last + SCREEN_WIDTH);
+}
+
+void dino_runner_course_editor(int slot) {
+    char path[512], name[DINO_COURSE_NAME];
+    char status[80] = "";
+    uint32_t speed_tenths = COURSE_SPEED_TENTHS;
+    uint32_t cursor = 0;
+    int count = 0, type = 0;
+    bool dirty = false, editing = true;
+    
+    // Existing courses are read whole; generated marathons are play-only
+    snprintf(name, sizeof(name), "Course %d", slot);
+    if (dino_runner_course_path(slot, path, sizeof(path)) && dino_course_open(&course, path)) {
+        uint32_t position;
+        int skipped = 0;
+        if (course.obstacle_count > COURSE_EDIT_MAX) {
+            printf("\n[!] %u obstacles: too long for the editor (up to %d).\n",
+                   (unsigned)course.obstacle_count, COURSE_EDIT_MAX);
+            dino_course_close(&course);
+            printf("Press Enter to continue...");
+            dino_runner_clear_input_buffer();
+            GETCH();
+            return;
+        }
+        memcpy(name, course.name, sizeof(name));
+        speed_tenths = course.speed_tenths;
+        // Types this build has no sprite for are dropped, as in a run
+        while (count < COURSE_EDIT_MAX && dino_course_peek(&course, &course_marks[count].type, &position)) {
+            dino_course_advance(&course);
+            if (course_marks[count].type >= OBSTACLE_COUNT) {
+                skipped++;
+                continue;
+            }
+            course_marks[count++].position = position;
+        }
+        dino_course_close(&course);
+        if (skipped > 0) {
+            snprintf(status, sizeof(status), "Loaded %d obstacles, skipped %d of unknown type", count, skipped);
+        } else {
+            snprintf(status, sizeof(status), "Loaded %d obstacles", count);
+        }
+    }
+    
+    CLEAR_SCREEN();
+    terminal_raw_begin();
+    while (editing) {
+        dino_runner_course_editor_render(slot, name, count, cursor, type, speed_tenths, dirty, status);
+        if (!terminal_wait_input(TERMINAL_NO_DEADLINE)) break;       // Input closed
+        
+        int key = terminal_read_key();
+        int at = 0;
+        while (at < count && course_marks[at].position < cursor) at++;  // First mark at or after the cursor
+        status[0] = '\0';
+        
+        switch (key) {
+            case TERM_KEY_LEFT:
+                if (cursor > 0) cursor--;
+                break;
+            case TERM_KEY_RIGHT:
+                cursor++;
+                break;
+            case 'a':
+            case 'A':
+                cursor = cursor > COURSE_EDIT_STEP ? cursor - COURSE_EDIT_STEP : 0;
+                break;
+            case 'd':
+            case 'D':
+                cursor += COURSE_EDIT_STEP;
+                break;
+            case TERM_KEY_UP:
+                type = (type + 1) % OBSTACLE_COUNT;
+                break;
+            case TERM_KEY_DOWN:
+                type = (type + OBSTACLE_COUNT - 1) % OBSTACLE_COUNT;
+                break;
+            case ',':
+                if (at > 0) cursor = course_marks[at - 1].position;
+                break;
+            case '.':
+                if (at < count && course_marks[at].position == cursor) at++;
+                if (at < count) cursor = course_marks[at].position;
+                break;
+            case ' ':
+                if (at < count && course_marks[at].position == cursor) {
+                    course_marks[at].type = type;          // Replace the one here
+                } else if (count < COURSE_EDIT_MAX) {
+                    memmove(&course_marks[at + 1], &course_marks[at], (size_t)(count - at) * sizeof(CourseMark));
+                    course_marks[at].position = cursor;
+                    course_marks[at].type = type;
+                    count++;
+                } else {
+                    snprintf(status, sizeof(status), "The editor holds %d obstacles", COURSE_EDIT_MAX);
+                    break;
+                }
+                dirty = true;
+                break;
+            case 'x':
+            case 'X': {
+                // The last obstacle whose sprite covers the cursor
+                int hit = -1;
+                for (int i = 0; i < count && course_marks[i].position <= cursor; i++) {
+                    if (cursor < course_marks[i].position + (uint32_t)obstacle_widths[course_marks[i].type]) hit = i;
+                }
+                if (hit >= 0) {
+                    memmove(&course_marks[hit], &course_marks[hit + 1], (size_t)(count - hit - 1) * sizeof(CourseMark));
+                    count--;
+                    dirty = true;
+                }
+                break;
+            }
+            case '+':
+            case '=':
+                if (speed_tenths < MAX_GAME_SPEED * 10) speed_tenths += 5;
+                dirty = true;
+                break;
+            case '-':
+                if (speed_tenths > COURSE_MIN_SPEED_TENTHS) speed_tenths -= 5;
+                dirty = true;
+                break;
+            case 'w':
+            case 'W':
+                if (dino_runner_course_save(slot, name, count, speed_tenths)) {
+                    dirty = false;
+                    snprintf(status, sizeof(status), "Saved %d obstacles to slot %d", count, slot);
+                } else {
+                    snprintf(status, sizeof(status), "[!] Could not save the course");
+                }
+                break;
+            case 'q':
+            case 'Q':
+            case TERM_KEY_ESCAPE:
+                editing = false;
+                break;
+        }
+    }
+    terminal_raw_end();
+}
+
 void dino_runner_custom_mode(void) {
     CLEAR_SCREEN();
     dino_runner_display_header("CUSTOM MODE");
@@ -548,6 +953,7 @@ void dino_runner_reset_game(void) {
     
     // Reset game state
     game.score = 0;
+    game.hall_of_fame_rank = 0;
     if (game.current_mode != MODE_SPRINT) {
         game.game_speed = 6;
     }
@@ -557,47 +963,70 @@ void dino_runner_reset_game(void) {
     game.day_night_timer = 0;
     game.is_night = false;
     game.ground_offset = 0;
+    game.distance = 0;
+    game.course_finished = false;
+    game.course_resumed = false;
+    if (game.current_mode == MODE_OBSTACLE_COURSE && course_loaded) {
+        dino_course_seek(&course, 0);
+        game.game_speed = course.speed_tenths / 10.0f;
+    }
     
+    dino_runner_ghost_start();
     game.games_played++;
 }
 
 void dino_runner_game_loop(void) {
-    clock_t start_time = clock();
+    // Fixed 60 FPS ticks on absolute monotonic deadlines; play time counts
+    // simulated frames, so time spent paused is not included
+    const uint64_t frame_us = 1000000u / TARGET_FPS;
+    long run_frames = 0;
     
-    // Enhanced 60 FPS Game Loop with Delta Timing
-    clock_t last_frame_time = clock();
-    float frame_accumulator = 0.0f;
-    const float target_frame_time = 1000.0f / TARGET_FPS; // ~16.67ms for 60 FPS
+    terminal_raw_begin();
+    flight_recorder_mark("dino: game loop");
+    uint64_t next_frame = terminal_now_us();
     
     while (game.game_running) {
-        clock_t current_time = clock();
-        float delta_time = (float)(current_time - last_frame_time) / CLOCKS_PER_SEC * 1000.0f;
-        last_frame_time = current_time;
+        // Idle after a crash: the game-over screen is static until R or ESC,
+        // so sleep until a key arrives instead of redrawing it every frame
+        if (game.game_over) {
+            if (!terminal_wait_input(TERMINAL_NO_DEADLINE)) break;   // Input closed
+            dino_runner_handle_input();
+            if (game.game_running && !game.game_over) {
+                run_frames = 0;                    // Restarted
+                dino_runner_render_screen();
+            }
+            next_frame = terminal_now_us() + frame_us;
+            continue;
+        }
         
-        frame_accumulator += delta_time;
+        terminal_sleep_until(next_frame);
+        next_frame += frame_us;
+        uint64_t tick_start = terminal_now_us();
+        if (next_frame < tick_start) next_frame = tick_start;   // Fell behind or was paused: resync
         
-        // Handle input at 60 FPS rate
+        // Handle input once per frame
         dino_runner_handle_input();
+        if (!game.game_running) break;
         
-        // Update game logic at consistent rate
-        if (frame_accumulator >= target_frame_time) {
-            if (!game.game_over) {
-                dino_runner_update_game();
-            }
-            
-            // Smooth rendering with minimal flicker
-            dino_runner_render_screen();
-            
-            frame_accumulator -= target_frame_time;
+        if (!game.game_over) {
+            dino_runner_update_game();
+            game.play_time = (float)++run_frames / TARGET_FPS;
+            dino_runner_ghost_tick((uint32_t)run_frames);
         }
         
-        // Calculate play time
-        game.play_time = (float)(clock() - start_time) / CLOCKS_PER_SEC;
-        
-        // Sleep for smooth 60 FPS (reduced from 50ms to ~16ms)
-        SLEEP_MS(16);
+        // Smooth rendering with minimal flicker (the last frame shows the crash)
+        dino_runner_render_screen();
+        uint64_t tick_us = terminal_now_us() - tick_start;
+        flight_recorder_tick(tick_us);
+        metrics_observe(METRICS_TICK_US, tick_us);
     }
+    terminal_raw_end();
     
+    if (!game.game_over) dino_runner_ghost_finish((uint32_t)run_frames);
+    if (ghost_loaded) {
+        ghost_player_close(&ghost);
+        ghost_loaded = false;
+    }
     dino_runner_save_statistics();
 }
 
@@ -614,38 +1043,55 @@ void dino_runner_handle_input(void) {
     bool duck_pressed = false;
     bool duck_released = false;
     
-    if (DINO_KBHIT()) {
-        int key = GETCH();
+    int key = terminal_read_key();
+    if (key != TERM_KEY_NONE) {
+        flight_recorder_input(key);
         
         switch (key) {
             case ' ': // Space - Jump
             case 'w': // W key for jump (alternative)
             case 'W':
+            case TERM_KEY_UP:
                 jump_pressed = true;
                 game.dino.jump_buffer = JUMP_BUFFER_TIME; // Buffer the jump input
                 break;
                 
             case 's': // Down arrow - Duck
             case 'S':
+            case TERM_KEY_DOWN:
                 duck_pressed = true;
                 duck_key_held = true;
                 break;
                 
-            case 27: // ESC - Pause/Exit
+            case TERM_KEY_ESCAPE: // ESC - Pause/Exit
                 if (game.game_over) {
                     game.game_running = false;
                 } else {
+                    // Paused: nothing moves, so block until the next key
                     printf("\n\n[PAUSED] Press any key to continue or ESC to exit...");
-                    int pause_key = GETCH();
-                    if (pause_key == 27) {
+                    fflush(stdout);
+                    if (!terminal_wait_input(TERMINAL_NO_DEADLINE) ||
+                        terminal_read_key() == TERM_KEY_ESCAPE) {
                         game.game_running = false;
                     }
                 }
                 return;
                 
-            case 'r': // Restart when game over
+            case 'r': // Restart when game over (a course retries from its checkpoint)
             case 'R':
                 if (game.game_over) {
+                    double reached = game.course_finished ? 0 : game.distance + DINO_X;
+                    dino_runner_reset_game();
+                    if (game.current_mode == MODE_OBSTACLE_COURSE && course_loaded) {
+                        dino_runner_course_resume(reached);
+                    }
+                    return;
+                }
+                break;
+                
+            case 'n': // Course from the start
+            case 'N':
+                if (game.game_over && game.current_mode == MODE_OBSTACLE_COURSE) {
                     dino_runner_reset_game();
                     return;
                 }
@@ -697,6 +1143,45 @@ void dino_runner_handle_input(void) {
     }
 }
 
+static int dino_runner_ghost_path(char* path, int size) {
+    char file_name[80], key[41];
+    ratings_local_file_key(key, sizeof(key));
+    snprintf(file_name, sizeof(file_name), "dino_ghost_%s_%d.trace", key, (int)game.current_mode);
+    highscore_open();
+    return highscore_shared_path(file_name, path, size);
+}
+
+// Maps the best run for this mode (if any) and starts recording a new one
+void dino_runner_ghost_start(void) {
+    char path[512];
+    
+    if (ghost_loaded) ghost_player_close(&ghost);
+    if (ghost_save_queued) {
+        write_behind_flush();           // Race the new run against the ghost just saved
+        ghost_save_queued = false;
+    }
+    ghost_loaded = dino_runner_ghost_path(path, sizeof(path)) && ghost_player_open(&ghost, path);
+    ghost_tick = 0;
+    game.ghost_saved = false;
+    ghost_recorder_begin(&ghost_recorder, (int)game.dino.y, game.dino.state);
+}
+
+void dino_runner_ghost_tick(uint32_t tick) {
+    ghost_tick = tick;
+    ghost_recorder_tick(&ghost_recorder, tick, (int)game.dino.y, game.dino.state);
+    if (ghost_loaded) ghost_player_advance(&ghost, tick);
+    if (game.game_over) dino_runner_ghost_finish(tick);
+}
+
+// A run that crashed or was quit becomes the ghost if it beat the old one
+void dino_runner_ghost_finish(uint32_t tick) {
+    char path[512];
+    if (tick == 0 || game.course_resumed || (ghost_loaded && (uint32_t)game.score <= ghost.score)) return;
+    game.ghost_saved = dino_runner_ghost_path(path, sizeof(path)) &&
+                       ghost_recorder_save_behind(&ghost_recorder, path, (uint32_t)game.score, tick);
+    ghost_save_queued = ghost_save_queued || game.ghost_saved;
+}
+
 void dino_runner_update_game(void) {
     dino_runner_update_dino();
     dino_runner_update_obstacles();
@@ -827,8 +1312,27 @@ void dino_runner_update_obstacles(void) {
         }
     }
     
-    // Spawn new obstacles
-    dino_runner_spawn_obstacle();
+    // Spawn new obstacles: from the course file, or at random
+    game.distance += game.game_speed;
+    if (game.current_mode == MODE_OBSTACLE_COURSE && course_loaded) {
+        dino_runner_course_stream();
+    } else {
+        dino_runner_spawn_obstacle();
+    }
+}
+
+// rand() with each draw logged to the flight recorder, so a crash dump
+// shows exactly which obstacles were rolled
+static int dino_runner_random(void) {
+    int value = rand();
+    flight_recorder_rng(value);
+    return value;
+}
+
+static int dino_runner_pick_obstacle(int tier) {
+    int type = alias_table_sample(&obstacle_tables[tier], &obstacle_rng);
+    flight_recorder_rng(type);
+    return type;
 }
 
 void dino_runner_spawn_obstacle(void) {
@@ -842,25 +1346,21 @@ void dino_runner_spawn_obstacle(void) {
         // Find empty obstacle slot
         for (int i = 0; i < MAX_OBSTACLES; i++) {
             if (!game.obstacles[i].active) {
-                game.obstacles[i].x = SCREEN_WIDTH;
-                game.obstacles[i].active = true;
-                game.obstacles[i].scored = false;
-                
                 // Enhanced obstacle selection based on score and patterns
                 int obstacle_type;
                 
                 if (game.score < 100) {
                     // Early game: Simple obstacles only
-                    obstacle_type = rand() % 3; // Small cactus, large cactus, rock
+                    obstacle_type = dino_runner_pick_obstacle(0);
                 } else if (game.score < 300) {
                     // Mid game: Add birds and double cactus
-                    obstacle_type = rand() % 6; // Include basic bird types
+                    obstacle_type = dino_runner_pick_obstacle(1);
                 } else if (game.score < 600) {
                     // Advanced game: Add triple cactus and more variety
-                    obstacle_type = rand() % 9; // More complex obstacles
+                    obstacle_type = dino_runner_pick_obstacle(2);
                 } else {
                     // Expert game: All obstacle types with strategic patterns
-                    obstacle_type = rand() % OBSTACLE_COUNT;
+                    obstacle_type = dino_runner_pick_obstacle(3);
                     
                     // Create challenging patterns at high scores
                     if (pattern_counter % 3 == 0) {
@@ -874,37 +1374,13 @@ void dino_runner_spawn_obstacle(void) {
                 }
                 
                 // Avoid consecutive identical obstacles for variety
-                if (obstacle_type == last_obstacle_type && rand() % 3 == 0) {
-                    obstacle_type = (obstacle_type + 1 + rand() % 3) % OBSTACLE_COUNT;
+                if (obstacle_type == last_obstacle_type && dino_runner_random() % 3 == 0) {
+                    obstacle_type = (obstacle_type + 1 + dino_runner_random() % 3) % OBSTACLE_COUNT;
                 }
                 
-                game.obstacles[i].type = obstacle_type;
+                dino_runner_place_obstacle(&game.obstacles[i], obstacle_type, SCREEN_WIDTH);
                 last_obstacle_type = obstacle_type;
                 pattern_counter++;
-                
-                // Enhanced position setting based on obstacle type
-                switch (game.obstacles[i].type) {
-                    case OBSTACLE_BIRD_HIGH:
-                    case OBSTACLE_BIRD_SWARM:
-                        game.obstacles[i].y = GROUND_Y - 8;
-                        break;
-                    case OBSTACLE_BIRD_LOW:
-                        game.obstacles[i].y = GROUND_Y - 4;
-                        break;
-                    case OBSTACLE_LOW_BRANCH:
-                        game.obstacles[i].y = GROUND_Y - 6;
-                        break;
-                    case OBSTACLE_TALL_TREE:
-                        game.obstacles[i].y = GROUND_Y - 1; // Taller obstacle
-                        break;
-                    default:
-                        game.obstacles[i].y = GROUND_Y; // Ground level
-                        break;
-                }
-                
-                game.obstacles[i].width = obstacle_widths[game.obstacles[i].type];
-                game.obstacles[i].height = obstacle_heights[game.obstacles[i].type];
-                
                 break;
             }
         }
@@ -918,16 +1394,68 @@ void dino_runner_spawn_obstacle(void) {
         if (base_spawn_time > 120) base_spawn_time = 120; // Maximum gap
         
         // Add controlled randomness for unpredictability
-        int randomness = 15 + rand() % 25; // 15-40 frames of variance
+        int randomness = 15 + dino_runner_random() % 25; // 15-40 frames of variance
         spawn_timer = base_spawn_time + randomness;
         
         // Special patterns at higher scores
-        if (game.score > 1000 && rand() % 5 == 0) {
+        if (game.score > 1000 && dino_runner_random() % 5 == 0) {
             spawn_timer /= 2; // Occasionally create tight spacing
         }
     }
 }
 
+void dino_runner_place_obstacle(Obstacle* obstacle, int type, float x) {
+    obstacle->x = x;
+    obstacle->active = true;
+    obstacle->scored = false;
+    obstacle->type = type;
+    
+    // Enhanced position setting based on obstacle type
+    switch (obstacle->type) {
+        case OBSTACLE_BIRD_HIGH:
+        case OBSTACLE_BIRD_SWARM:
+            obstacle->y = GROUND_Y - 8;
+            break;
+        case OBSTACLE_BIRD_LOW:
+            obstacle->y = GROUND_Y - 4;
+            break;
+        case OBSTACLE_LOW_BRANCH:
+            obstacle->y = GROUND_Y - 6;
+            break;
+        case OBSTACLE_TALL_TREE:
+            obstacle->y = GROUND_Y - 1; // Taller obstacle
+            break;
+        default:
+            obstacle->y = GROUND_Y; // Ground level
+            break;
+    }
+    
+    obstacle->width = obstacle_widths[obstacle->type];
+    obstacle->height = obstacle_heights[obstacle->type];
+}
+
+// Places every course obstacle that has come within a screen of the dino,
+// at its exact column; a full set of slots drops the rest of the batch
+void dino_runner_course_stream(void) {
+    int type;
+    uint32_t position;
+    
+    while (dino_course_peek(&course, &type, &position) && position <= game.distance + SCREEN_WIDTH) {
+        dino_course_advance(&course);
+        if (type >= OBSTACLE_COUNT) continue;
+        for (int i = 0; i < MAX_OBSTACLES; i++) {
+            if (!game.obstacles[i].active) {
+                dino_runner_place_obstacle(&game.obstacles[i], type, position - game.distance);
+                break;
+            }
+        }
+    }
+    
+    if (!dino_course_peek(&course, &type, &position) && game.distance >= course.length) {
+        dino_runner_course_finish();
+    }
+}
+
 void dino_runner_update_clouds(void) {
     for (int i = 0; i < MAX_CLOUDS; i++) {
         if (game.clouds[i].active) {
@@ -943,6 +1471,8 @@ void dino_runner_update_clouds(void) {
 }
 
 void dino_runner_check_collisions(void) {
+    if (game.game_over) return;    // Crossed the finish line this frame
+    
     for (int i = 0; i < MAX_OBSTACLES; i++) {
         if (game.obstacles[i].active) {
             float obs_x = game.obstacles[i].x;
@@ -984,6 +1514,10 @@ void dino_runner_check_collisions(void) {
                     game.high_score = game.score;
                     dino_runner_play_sound("NEW HIGH SCORE!");
                 }
+                if (!game.course_resumed) {
+                    game.hall_of_fame_rank = highscore_submit(HIGHSCORE_DINO_RUNNER, game.current_mode,
+                                                              ratings_local_player(), (uint32_t)game.score);
+                }
                 
                 dino_runner_game_over_screen();
                 return;
@@ -1081,23 +1615,56 @@ void dino_runner_draw_dino(void) {
     }
 }
 
+// Drawn first and only into empty cells, so everything shows through it
+void dino_runner_draw_ghost(void) {
+    if (!ghost_loaded || ghost_tick > ghost.ticks + TARGET_FPS) return;
+    
+    const char* sprite;
+    switch (ghost.state) {
+        case DINO_JUMPING: sprite = dino_jumping_sprite; break;
+        case DINO_DUCKING: sprite = dino_ducking_sprites[0]; break;
+        case DINO_DEAD:    sprite = dino_dead_sprite; break;
+        default:           sprite = dino_running_sprites[(ghost_tick / 8) % 2]; break;
+    }
+    
+    int x = DINO_X;
+    int y = ghost.row;
+    char background = game.is_night ? '.' : ' ';
+    for (const char* c = sprite; *c; c++) {
+        if (*c == '\n') {
+            y++;
+            x = DINO_X;
+            continue;
+        }
+        if (*c != ' ' && y >= 0 && y < SCREEN_HEIGHT && x >= 0 && x < SCREEN_WIDTH &&
+            screen_buffer[y][x] == background) {
+            screen_buffer[y][x] = ':';
+        }
+        x++;
+    }
+}
+
+void dino_runner_draw_obstacle(const Obstacle* obstacle) {
+    char* sprite = obstacle_sprites[obstacle->type];
+    
+    // Draw multi-line sprite
+    char sprite_copy[64];
+    strcpy(sprite_copy, sprite);
+    
+    char* line = strtok(sprite_copy, "\n");
+    int line_y = (int)obstacle->y - obstacle->height + 1;
+    
+    while (line != NULL && line_y < SCREEN_HEIGHT) {
+        dino_runner_draw_to_buffer((int)obstacle->x, line_y, line);
+        line = strtok(NULL, "\n");
+        line_y++;
+    }
+}
+
 void dino_runner_draw_obstacles(void) {
     for (int i = 0; i < MAX_OBSTACLES; i++) {
         if (game.obstacles[i].active && game.obstacles[i].x >= -10 && game.obstacles[i].x < SCREEN_WIDTH + 10) {
-            char* sprite = obstacle_sprites[game.obstacles[i].type];
-            
-            // Draw multi-line sprite
-            char sprite_copy[64];
-            strcpy(sprite_copy, sprite);
-            
-            char* line = strtok(sprite_copy, "\n");
-            int line_y = (int)game.obstacles[i].y - game.obstacles[i].height + 1;
-            
-            while (line != NULL && line_y < SCREEN_HEIGHT) {
-                dino_runner_draw_to_buffer((int)game.obstacles[i].x, line_y, line);
-                line = strtok(NULL, "\n");
-                line_y++;
-            }
+            dino_runner_draw_obstacle(&game.obstacles[i]);
         }
     }
 }
@@ -1117,8 +1684,9 @@ void dino_runner_draw_ground(void) {
 void dino_runner_draw_hud(void) {
     char hud_text[100];
     
-    // Score
-    sprintf(hud_text, "HI: %05d", game.high_score);
+    // Score (the shared record for this mode when it beats ours)
+    int record = (int)highscore_best(HIGHSCORE_DINO_RUNNER, game.current_mode);
+    sprintf(hud_text, "HI: %05d", record > game.high_score ? record : game.high_score);
     dino_runner_draw_to_buffer(2, 1, hud_text);
     
     sprintf(hud_text, "SCORE: %05d", game.score);
@@ -1136,13 +1704,35 @@ void dino_runner_draw_hud(void) {
     char* time_indicator[] = {"DAY", "SUNSET", "NIGHT", "SUNRISE"};
     dino_runner_draw_to_buffer(60, 1, time_indicator[game.time_of_day]);
     
+    // Ghost of the best run: its score, and how it ended once it has
+    if (ghost_loaded) {
+        const char* outcome = "";
+        if (ghost_tick >= ghost.ticks) {
+            outcome = (uint32_t)game.score > ghost.score ? "  BEATEN!" : "  OUT";
+        }
+        sprintf(hud_text, "GHOST: %05u%s", (unsigned)ghost.score, outcome);
+        dino_runner_draw_to_buffer(15, 2, hud_text);
+    }
+    
+    // Course progress, by section: a retry starts from the section's checkpoint
+    if (game.current_mode == MODE_OBSTACLE_COURSE && course_loaded) {
+        uint32_t section = course.number / DINO_COURSE_SECTION + 1;
+        if (section > course.section_count) section = course.section_count;
+        int percent = course.length ? (int)(game.distance * 100 / course.length) : 100;
+        sprintf(hud_text, "%.20s %3d%%  SECTION %u/%u", course.name, percent > 100 ? 100 : percent,
+                (unsigned)section, (unsigned)course.section_count);
+        dino_runner_draw_to_buffer(40, 2, hud_text);
+    }
+    
     // Game mode
     char* mode_names[] = {"CLASSIC", "SPRINT", "MARATHON", "COURSE", "CUSTOM"};
     sprintf(hud_text, "Mode: %s", mode_names[game.current_mode]);
     dino_runner_draw_to_buffer(2, SCREEN_HEIGHT - 2, hud_text);
     
     // Controls
-    if (game.game_over) {
+    if (game.game_over && game.current_mode == MODE_OBSTACLE_COURSE) {
+        dino_runner_draw_to_buffer(25, SCREEN_HEIGHT - 2, "[R] Checkpoint [N] From start [ESC] Exit");
+    } else if (game.game_over) {
         dino_runner_draw_to_buffer(25, SCREEN_HEIGHT - 2, "[SPACE] Jump [S] Duck [R] Restart [ESC] Exit");
     } else {
         dino_runner_draw_to_buffer(25, SCREEN_HEIGHT - 2, "[SPACE] Jump [S] Duck [ESC] Pause");
@@ -1155,10 +1745,12 @@ void dino_runner_render_screen(void) {
     
     // Draw all game elements to buffer first
     dino_runner_draw_clouds();
+    dino_runner_draw_ghost();
     dino_runner_draw_obstacles();
     dino_runner_draw_dino();
     dino_runner_draw_ground();
     dino_runner_draw_hud();
+    flight_recorder_frame(&screen_buffer[0][0], SCREEN_HEIGHT, SCREEN_WIDTH + 1);
     
     // Optimized screen rendering - minimal flicker using ANSI escape sequences
     printf("\033[H"); // Move cursor to home position instead of clearing
@@ -1179,13 +1771,27 @@ void dino_runner_render_screen(void) {
     if (game.game_over) {
         printf("\033[%d;1H", SCREEN_HEIGHT + 5); // Position for game over screen
         printf("+===========================================+\n");
-        printf("|              GAME OVER!                  |\n");
+        if (game.course_finished) {
+            printf("|           COURSE COMPLETE!               |\n");
+        } else {
+            printf("|              GAME OVER!                  |\n");
+        }
         printf("+===========================================+\n");
         printf("|  Final Score: %-24d   |\n", game.score);
         printf("|  Obstacles Dodged: %-18d   |\n", game.obstacles_dodged);
         printf("|  Play Time: %.1f seconds                |\n", game.play_time);
+        if (game.hall_of_fame_rank > 0) {
+            printf("|  HALL OF FAME: #%-2d for this mode         |\n", game.hall_of_fame_rank);
+        }
+        if (game.ghost_saved) {
+            printf("|  New personal best: saved as your ghost   |\n");
+        }
         printf("|                                           |\n");
-        printf("|  [R] Restart  [ESC] Exit                  |\n");
+        if (game.current_mode == MODE_OBSTACLE_COURSE && !game.course_finished) {
+            printf("|  [R] Checkpoint  [N] From start  [ESC]    |\n");
+        } else {
+            printf("|  [R] Restart  [ESC] Exit                  |\n");
+        }
         printf("+===========================================+\n");
     }
     
@@ -1343,6 +1949,8 @@ void dino_runner_display_statistics(void) {
     printf("|  Completion: %.1f%%                     |\n", (float)achievements_unlocked / ACH_COUNT * 100);
     printf("|                                           |\n");
     printf("+===========================================+\n");
+    printf("\n");
+    highscore_display(HIGHSCORE_DINO_RUNNER, MODE_CLASSIC, "DINO CLASSIC");
     printf("\nPress any key to return to menu...");
     GETCH();
 }
@@ -1459,23 +2067,35 @@ void dino_runner_play_sound(const char* sound) {
     fflush(stdout);
 }
 
+// Per-user stats file in the shared directory, so players on the same
+// machine no longer overwrite each other's dino_stats.dat
+static int dino_runner_stats_path(char* path, int size) {
+    char file_name[64], key[41];
+    ratings_local_file_key(key, sizeof(key));
+    snprintf(file_name, sizeof(file_name), "dino_stats_%s.dat", key);
+    highscore_open();
+    return highscore_shared_path(file_name, path, size);
+}
+
 void dino_runner_save_statistics(void) {
-    // Simple file save (basic implementation)
-    FILE* file = fopen("dino_stats.dat", "wb");
-    if (file) {
-        fwrite(&game.high_score, sizeof(int), 1, file);
-        fwrite(&game.games_played, sizeof(int), 1, file);
-        fwrite(&game.total_jumps, sizeof(int), 1, file);
-        fwrite(&game.total_ducks, sizeof(int), 1, file);
-        fwrite(&game.obstacles_dodged, sizeof(int), 1, file);
-        fwrite(&game.close_calls, sizeof(int), 1, file);
-        fwrite(&game.achievements, sizeof(Achievement), ACH_COUNT, file);
-        fclose(file);
-    }
+    char path[512];
+    if (!dino_runner_stats_path(path, sizeof(path))) return;
+    WriteBehindPart parts[] = {
+        {&game.high_score, sizeof(int)},
+        {&game.games_played, sizeof(int)},
+        {&game.total_jumps, sizeof(int)},
+        {&game.total_ducks, sizeof(int)},
+        {&game.obstacles_dodged, sizeof(int)},
+        {&game.close_calls, sizeof(int)},
+        {&game.achievements, sizeof(Achievement) * ACH_COUNT},
+    };
+    write_behind_replacev(path, parts, (int)(sizeof(parts) / sizeof(parts[0])));
 }
 
 void dino_runner_load_statistics(void) {
-    FILE* file = fopen("dino_stats.dat", "rb");
+    char path[512];
+    if (!dino_runner_stats_path(path, sizeof(path))) return;
+    FILE* file = fopen(path, "rb");
     if (file) {
         fread(&game.high_score, sizeof(int), 1, file);
         fread(&game.games_played, sizeof(int), 1, file);
@@ -1505,6 +2125,5 @@ float dino_runner_calculate_distance(float x1, float y1, float x2, float y2) {
 
 void play_dino_runner(void) {
     dino_runner_init_game();
-    game.current_mode = MODE_CLASSIC;
-    dino_runner_classic_mode();
+    dino_runner_main_menu();
 }
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <string.h>
 #include <time.h>
 #include <stdbool.h>
+#include "ratings.h"
+#include "terminal.h"
 
 // Platform-specific includes and definitions
 #ifdef _WIN32
@@ -290,37 +292,19 @@ void f1_reaction_display_lights(int lights_on) {
 }
 
 bool f1_reaction_wait_for_space(TimeValue* reaction_time) {
-#ifdef _WIN32
-    while (!_kbhit()) {
-        SLEEP_MS(1);
-    }
-    char key = _getch();
-    GET_TIME(*reaction_time);
-    return (key == ' ');
-#else
-    // Set terminal to non-blocking mode
-    struct termios old_termios, new_termios;
-    tcgetattr(STDIN_FILENO, &old_termios);
-    new_termios = old_termios;
-    new_termios.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
-    
-    int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
-    
-    char key;
-    while (read(STDIN_FILENO, &key, 1) <= 0) {
-        usleep(1000);
+    // Sleep in the kernel until the key arrives: no polling interval adds
+    // to the measured reaction time, and nothing runs while waiting
+    terminal_raw_begin();
+    int key = TERM_KEY_NONE;
+    if (terminal_wait_input(TERMINAL_NO_DEADLINE)) {
+        GET_TIME(*reaction_time);
+        key = terminal_read_key();
+    } else {
+        GET_TIME(*reaction_time);             // Input closed
     }
-    
-    GET_TIME(*reaction_time);
-    
-    // Restore terminal settings
-    tcsetattr(STDIN_FILENO, TCSANOW, &old_termios);
-    fcntl(STDIN_FILENO, F_SETFL, flags);
+    terminal_raw_end();
     
     return (key == ' ');
-#endif
 }
 
 // Core game logic
@@ -837,6 +821,9 @@ void f1_reaction_multiplayer_mode(void) {
            player1, p1_wins, p2_wins, player2);
     printf("|                                            |\n");
     
+    ratings_record_match(RATING_GAME_F1_REACTION, player1, player2,
+                         p1_wins > p2_wins ? RATING_WIN : RATING_LOSS);
+    
     if (p1_wins > p2_wins) {
         printf("|  [GOLD] WINNER: %-25s |\n", player1);
     } else {
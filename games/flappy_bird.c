@@ -23,22 +23,23 @@
 #include <ctype.h>
 #include <stdbool.h>
 #include "games.h"
+#include "alias_table.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "ratings.h"
+#include "terminal.h"
 
 #ifdef _WIN32
     #include <windows.h>
     #include <conio.h>
     #define CLEAR_SCREEN() system("cls")
     #define SLEEP_MS(ms) Sleep(ms)
-    #define FLAPPY_KBHIT() games_kbhit()
-    #define GETCH() _getch()
 #else
     #include <unistd.h>
     #include <termios.h>
     #include <fcntl.h>
     #define CLEAR_SCREEN() system("clear")
     #define SLEEP_MS(ms) usleep((ms) * 1000)
-    #define FLAPPY_KBHIT() games_kbhit()
-    #define GETCH() getchar()
 #endif
 
 // Game Constants
@@ -168,6 +169,12 @@ static GameState game;
 static bool game_running = true;
 static char screen_buffer[SCREEN_HEIGHT][SCREEN_WIDTH + 1];
 
+// Pipe gap placement: triangular weights over every legal gap row, peaked
+// at the centre. Rebuilt only when the legal range changes (gap size setting).
+static AliasTable gap_table;
+static int gap_table_range = -1;
+static FastRng pipe_rng;
+
 // Bird Animation Frames
 static char* bird_sprites[4] = {
     "<o>",  // Flapping up
@@ -244,6 +251,7 @@ void flappy_bird_play_sound(const char* sound);
 // Main Entry Point
 void play_flappy_bird(void) {
     srand((unsigned int)time(NULL));
+    fast_rng_seed_from_rand(&pipe_rng);
     flappy_bird_init_game();
     flappy_bird_load_statistics();
     
@@ -402,29 +410,38 @@ void flappy_bird_classic_mode(void) {
 
 // Main Game Loop (Enhanced for smooth 60 FPS)
 void flappy_bird_game_loop(void) {
-    clock_t last_frame_time = clock();
+    const uint64_t frame_us = 1000000u / TARGET_FPS;
+    
+    terminal_raw_begin();
+    uint64_t next_frame = terminal_now_us();
     
     while (game.bird.alive && !game.game_over) {
-        clock_t current_time = clock();
-        double delta_time = ((double)(current_time - last_frame_time)) / CLOCKS_PER_SEC;
-        
-        // Target frame rate control
-        if (delta_time < (1.0 / TARGET_FPS)) {
-            SLEEP_MS(1);
-            continue;
+        // Handle input (non-blocking) until the next frame is due
+        while (terminal_wait_input(next_frame)) {
+            flappy_bird_handle_input();
         }
-        
-        last_frame_time = current_time;
-        
-        // Handle input (non-blocking)
-        flappy_bird_handle_input();
+        if (game.game_over) break;
         
         if (game.paused) {
+            // Idle: show the banner once, then sleep until a key arrives
             printf("\n>>> PAUSED - Press P to continue <<<\n");
-            SLEEP_MS(100);
+            fflush(stdout);
+            while (game.paused && !game.game_over) {
+                if (!terminal_wait_input(TERMINAL_NO_DEADLINE)) {
+                    game.game_over = true;     // Input closed
+                    break;
+                }
+                flappy_bird_handle_input();
+            }
+            next_frame = terminal_now_us();
             continue;
         }
         
+        // Target frame rate control: fixed deadlines on the monotonic clock
+        next_frame += frame_us;
+        uint64_t now = terminal_now_us();
+        if (next_frame < now) next_frame = now;
+        
         // Update game logic
         flappy_bird_update_bird();
         flappy_bird_update_pipes();
@@ -449,24 +466,27 @@ void flappy_bird_game_loop(void) {
         flappy_bird_draw_bird();
         flappy_bird_draw_hud();
         flappy_bird_render_screen();
+        metrics_observe(METRICS_TICK_US, terminal_now_us() - now);
     }
+    terminal_raw_end();
     
     flappy_bird_game_over_screen();
 }
 
 // Handle Input
 void flappy_bird_handle_input(void) {
-    if (FLAPPY_KBHIT()) {
-        char key = GETCH();
+    int key;
+    while ((key = terminal_read_key()) != TERM_KEY_NONE) {
         switch (key) {
             case ' ':  // Space - Flap
-                flappy_bird_bird_flap();
+            case TERM_KEY_UP:
+                if (!game.paused) flappy_bird_bird_flap();
                 break;
             case 'p':
             case 'P':  // Pause
                 game.paused = !game.paused;
                 break;
-            case 27:   // ESC - Exit
+            case TERM_KEY_ESCAPE:   // ESC - Exit
                 game.game_over = true;
                 break;
         }
@@ -586,10 +606,19 @@ void flappy_bird_spawn_pipe(void) {
             
             // Use weighted random for more balanced pipe placement
             int range = max_gap_y - min_gap_y;
-            int center = min_gap_y + range / 2;
-            int offset = (rand() % (range * 2 / 3)) - (range / 3); // Bias toward center
+            if (range >= ALIAS_MAX_OUTCOMES) range = ALIAS_MAX_OUTCOMES - 1;
+            if (range < 0) range = 0;
+            if (range != gap_table_range) {
+                uint32_t weights[ALIAS_MAX_OUTCOMES];
+                for (int row = 0; row <= range; row++) {
+                    int edge = row < range - row ? row : range - row;
+                    weights[row] = (uint32_t)(edge + 1);   // Bias toward center
+                }
+                alias_table_build(&gap_table, weights, range + 1);
+                gap_table_range = range;
+            }
             
-            game.pipes[i].gap_y = center + offset;
+            game.pipes[i].gap_y = min_gap_y + alias_table_sample(&gap_table, &pipe_rng);
             
             // Ensure gap is within bounds
             if (game.pipes[i].gap_y < min_gap_y) game.pipes[i].gap_y = min_gap_y;
@@ -790,6 +819,12 @@ void flappy_bird_game_over_screen(void) {
         game.classic_best = game.score;
     }
     
+    int rank = highscore_submit(HIGHSCORE_FLAPPY_BIRD, game.current_mode,
+                                ratings_local_player(), (uint32_t)game.score);
+    if (rank > 0) {
+        printf("| >>> HALL OF FAME: #%-2d for this mode <<<   |\n", rank);
+    }
+    
     printf("|                                           |\n");
     
     // Update statistics
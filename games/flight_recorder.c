@@ -0,0 +1,330 @@
+/*
+ * Crash Flight Recorder
+ * Part of CLI Games Pack v2.1
+ *
+ * Events live in a fixed ring indexed by a free-running counter. A writer
+ * claims a slot with one atomic increment, clears the slot's sequence
+ * number, fills it in and publishes the sequence number last, so the dump
+ * can tell a complete slot from one that was being overwritten when the
+ * signal arrived. Frames use the same scheme with a 4-deep ring of
+ * fixed-size text buffers.
+ *
+ * Everything reachable from the signal handler avoids stdio and malloc:
+ * numbers are formatted by hand into a stack buffer and written with
+ * write(2). The dump path and terminal settings are captured up front by
+ * flight_recorder_install().
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "flight_recorder.h"
+#include "highscores.h"
+#include <signal.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <process.h>
+    #define write _write
+    #define getpid _getpid
+#else
+    #include <sys/stat.h>
+    #include <errno.h>
+#endif
+
+#define EVENT_MASK (FLIGHT_EVENT_CAPACITY - 1)
+#define FRAME_MASK (FLIGHT_FRAME_CAPACITY - 1)
+#define ALT_STACK_SIZE (64 * 1024)
+
+typedef struct {
+    uint32_t seq;           // Published last; 0 = slot being written
+    uint16_t rows;
+    uint16_t cols;
+    uint64_t time_us;
+    char text[FLIGHT_FRAME_ROWS][FLIGHT_FRAME_COLS];
+} FlightFrame;
+
+static FlightEvent events[FLIGHT_EVENT_CAPACITY];
+static uint32_t event_next = 0;
+static FlightFrame frames[FLIGHT_FRAME_CAPACITY];
+static uint32_t frame_next = 0;
+
+static const char* event_names[FLIGHT_EVENT_TYPE_COUNT] = {
+    "MARK ", "INPUT", "TICK ", "RNG  ", "FRAME"
+};
+
+#ifndef _WIN32
+static pid_t owner_pid = 0;             // Process whose session owns the ring
+static struct timespec start_time;
+static struct termios saved_terminal;
+static int terminal_saved = 0;
+static int saved_stdin_flags = -1;
+static char dump_path[512];
+static volatile sig_atomic_t handling_signal = 0;
+static char alt_stack[ALT_STACK_SIZE];
+static const int fatal_signals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGABRT, SIGINT, SIGTERM};
+#else
+static int installed = 0;
+static clock_t start_clock;
+#endif
+
+uint64_t flight_recorder_now_us(void) {
+#ifndef _WIN32
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - start_time.tv_sec) * 1000000u +
+           (uint64_t)((now.tv_nsec - start_time.tv_nsec) / 1000);
+#else
+    return (uint64_t)(clock() - start_clock) * 1000000u / CLOCKS_PER_SEC;
+#endif
+}
+
+void flight_recorder_event(FlightEventType type, uint64_t value) {
+    uint32_t index = __atomic_fetch_add(&event_next, 1, __ATOMIC_RELAXED);
+    FlightEvent* event = &events[index & EVENT_MASK];
+
+    __atomic_store_n(&event->seq, 0, __ATOMIC_RELAXED);
+    event->time_us = flight_recorder_now_us();
+    event->value = value;
+    event->type = (uint16_t)type;
+    __atomic_store_n(&event->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+void flight_recorder_mark(const char* label) {
+    flight_recorder_event(FLIGHT_EVENT_MARK, (uint64_t)(uintptr_t)label);
+}
+
+void flight_recorder_frame(const char* rows, int row_count, int row_stride) {
+    uint32_t index = __atomic_fetch_add(&frame_next, 1, __ATOMIC_RELAXED);
+    FlightFrame* frame = &frames[index & FRAME_MASK];
+    int cols = 0;
+
+    if (row_count > FLIGHT_FRAME_ROWS) row_count = FLIGHT_FRAME_ROWS;
+    __atomic_store_n(&frame->seq, 0, __ATOMIC_RELAXED);
+    int limit = row_stride < FLIGHT_FRAME_COLS - 1 ? row_stride : FLIGHT_FRAME_COLS - 1;
+    for (int r = 0; r < row_count; r++) {
+        const char* src = rows + (size_t)r * (size_t)row_stride;
+        const char* end = memchr(src, '\0', (size_t)limit);
+        int c = end ? (int)(end - src) : limit;
+        memcpy(frame->text[r], src, (size_t)c);
+        frame->text[r][c] = '\0';
+        if (c > cols) cols = c;
+    }
+    frame->rows = (uint16_t)row_count;
+    frame->cols = (uint16_t)cols;
+    frame->time_us = flight_recorder_now_us();
+    __atomic_store_n(&frame->seq, index + 1, __ATOMIC_RELEASE);
+
+    flight_recorder_event(FLIGHT_EVENT_FRAME, index + 1);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Async-signal-safe dump                                                 */
+/* ---------------------------------------------------------------------- */
+
+typedef struct {
+    int fd;
+    int used;
+    char data[512];
+} DumpBuffer;
+
+static void dump_flush(DumpBuffer* out) {
+    int offset = 0;
+    while (offset < out->used) {
+        int written = (int)write(out->fd, out->data + offset, (unsigned int)(out->used - offset));
+        if (written <= 0) break;
+        offset += written;
+    }
+    out->used = 0;
+}
+
+static void dump_char(DumpBuffer* out, char c) {
+    if (out->used == (int)sizeof(out->data)) dump_flush(out);
+    out->data[out->used++] = c;
+}
+
+static void dump_str(DumpBuffer* out, const char* text) {
+    while (*text) dump_char(out, *text++);
+}
+
+static void dump_u64(DumpBuffer* out, uint64_t value, int width) {
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (int pad = count; pad < width; pad++) dump_char(out, ' ');
+    while (count > 0) dump_char(out, digits[--count]);
+}
+
+static const char* signal_name(int signal_number) {
+    switch (signal_number) {
+        case 0: return "manual dump";
+        case SIGSEGV: return "SIGSEGV";
+        case SIGABRT: return "SIGABRT";
+        case SIGINT: return "SIGINT";
+        case SIGTERM: return "SIGTERM";
+        case SIGFPE: return "SIGFPE";
+#ifndef _WIN32
+        case SIGBUS: return "SIGBUS";
+#endif
+        default: return "signal";
+    }
+}
+
+void flight_recorder_dump(int fd, int signal_number) {
+    DumpBuffer out;
+    out.fd = fd;
+    out.used = 0;
+
+    uint32_t next = __atomic_load_n(&event_next, __ATOMIC_ACQUIRE);
+    uint32_t first = next > FLIGHT_EVENT_CAPACITY ? next - FLIGHT_EVENT_CAPACITY : 0;
+
+    dump_str(&out, "CLI Games Pack flight recorder\nsignal: ");
+    dump_str(&out, signal_name(signal_number));
+    dump_str(&out, " (");
+    dump_u64(&out, (uint64_t)signal_number, 0);
+    dump_str(&out, ")\npid: ");
+    dump_u64(&out, (uint64_t)getpid(), 0);
+    dump_str(&out, "\nuptime_us: ");
+    dump_u64(&out, flight_recorder_now_us(), 0);
+    dump_str(&out, "\nevents: ");
+    dump_u64(&out, next - first, 0);
+    dump_str(&out, " of ");
+    dump_u64(&out, next, 0);
+    dump_str(&out, " recorded (oldest first)\n\n");
+
+    for (uint32_t i = first; i != next; i++) {
+        const FlightEvent* event = &events[i & EVENT_MASK];
+        if (__atomic_load_n(&event->seq, __ATOMIC_ACQUIRE) != i + 1) continue;   // Torn slot
+
+        dump_char(&out, '+');
+        dump_u64(&out, event->time_us, 12);
+        dump_str(&out, "us  ");
+        dump_str(&out, event->type < FLIGHT_EVENT_TYPE_COUNT ? event_names[event->type] : "?    ");
+        dump_str(&out, "  ");
+        if (event->type == FLIGHT_EVENT_MARK) {
+            dump_str(&out, (const char*)(uintptr_t)event->value);
+        } else {
+            dump_u64(&out, event->value, 0);
+            if (event->type == FLIGHT_EVENT_INPUT && event->value >= 32 && event->value < 127) {
+                dump_str(&out, " '");
+                dump_char(&out, (char)event->value);
+                dump_char(&out, '\'');
+            }
+        }
+        dump_char(&out, '\n');
+    }
+
+    uint32_t frames_done = __atomic_load_n(&frame_next, __ATOMIC_ACQUIRE);
+    uint32_t first_frame = frames_done > FLIGHT_FRAME_CAPACITY ? frames_done - FLIGHT_FRAME_CAPACITY : 0;
+    for (uint32_t i = first_frame; i != frames_done; i++) {
+        const FlightFrame* frame = &frames[i & FRAME_MASK];
+        if (__atomic_load_n(&frame->seq, __ATOMIC_ACQUIRE) != i + 1) continue;
+
+        dump_str(&out, "\n--- frame ");
+        dump_u64(&out, i + 1, 0);
+        dump_str(&out, " at +");
+        dump_u64(&out, frame->time_us, 0);
+        dump_str(&out, "us ---\n");
+        for (int r = 0; r < frame->rows && r < FLIGHT_FRAME_ROWS; r++) {
+            for (int c = 0; c < FLIGHT_FRAME_COLS && frame->text[r][c]; c++) {
+                dump_char(&out, frame->text[r][c]);
+            }
+            dump_char(&out, '\n');
+        }
+    }
+    dump_flush(&out);
+}
+
+#ifndef _WIN32
+static void write_stderr(const char* text) {
+    size_t length = strlen(text);
+    while (length > 0) {
+        ssize_t written = write(STDERR_FILENO, text, length);
+        if (written <= 0) return;
+        text += written;
+        length -= (size_t)written;
+    }
+}
+
+static void flight_recorder_signal(int signal_number) {
+    if (!handling_signal) {
+        handling_signal = 1;
+
+        // Put the terminal back first so the shell is usable whatever happens next
+        if (terminal_saved) tcsetattr(STDIN_FILENO, TCSANOW, &saved_terminal);
+        if (saved_stdin_flags >= 0) fcntl(STDIN_FILENO, F_SETFL, saved_stdin_flags);
+        write_stderr("\033[0m\033[?25h\n");
+
+        if (dump_path[0]) {
+            // Never through a planted file or link: a stale dump of ours
+            // (a reused pid) is unlinked, anyone else's makes us skip the dump
+            int flags = O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW;
+            int fd = open(dump_path, flags, 0600);
+            if (fd < 0 && errno == EEXIST && unlink(dump_path) == 0) fd = open(dump_path, flags, 0600);
+            if (fd >= 0) {
+                flight_recorder_dump(fd, signal_number);
+                close(fd);
+                write_stderr("Flight recorder saved to ");
+                write_stderr(dump_path);
+                write_stderr("\n");
+            }
+        }
+    }
+
+    // SA_RESETHAND restored the default action; let it run
+    raise(signal_number);
+}
+#endif
+
+int flight_recorder_install(void) {
+#ifndef _WIN32
+    pid_t self = getpid();
+    if (owner_pid == self) return 0;       // One session per process
+    owner_pid = self;
+
+    // A forked session starts from an empty ring, not its parent's events
+    if (event_next || frame_next) {
+        for (int i = 0; i < FLIGHT_EVENT_CAPACITY; i++) events[i].seq = 0;
+        for (int i = 0; i < FLIGHT_FRAME_CAPACITY; i++) frames[i].seq = 0;
+        event_next = 0;
+        frame_next = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &saved_terminal) == 0) {
+        terminal_saved = 1;
+    }
+    saved_stdin_flags = fcntl(STDIN_FILENO, F_GETFL, 0);
+
+    highscore_make_shared_dir();
+    char file_name[64];
+    snprintf(file_name, sizeof(file_name), "flight-%ld.log", (long)getpid());
+    if (!highscore_shared_path(file_name, dump_path, sizeof(dump_path))) dump_path[0] = '\0';
+
+    stack_t stack;
+    stack.ss_sp = alt_stack;
+    stack.ss_size = sizeof(alt_stack);
+    stack.ss_flags = 0;
+    sigaltstack(&stack, NULL);     // Lets the handler run after a stack overflow
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = flight_recorder_signal;
+    action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < sizeof(fatal_signals) / sizeof(fatal_signals[0]); i++) {
+        sigaction(fatal_signals[i], &action, NULL);
+    }
+#else
+    if (installed) return 0;
+    installed = 1;
+    start_clock = clock();
+#endif
+    flight_recorder_mark("session start");
+    return 1;
+}
@@ -0,0 +1,66 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+
+/*
+ * Crash flight recorder.
+ *
+ * An always-on ring of the most recent events (key presses, tick timings,
+ * RNG draws, markers) plus the last few rendered frames. Recording is a
+ * relaxed atomic increment and a small store, so it is safe from any
+ * thread and cheap enough to leave on in every game loop.
+ *
+ * There is one ring per process, so it holds one session: the cold
+ * process's, or a zygote child's, whose install empties the ring it
+ * inherited. A second install in the same process is refused, and
+ * sessions hosted on a CoLoop (many to a process) do not record.
+ *
+ * flight_recorder_install() hooks SIGSEGV, SIGBUS, SIGFPE, SIGABRT, SIGINT
+ * and SIGTERM. The handler (async-signal-safe: only open/write/tcsetattr)
+ * restores the terminal saved at install time, writes the ring to
+ * <shared dir>/flight-<pid>.log and then re-raises the signal.
+ */
+
+#define FLIGHT_EVENT_CAPACITY 4096      // Power of two
+#define FLIGHT_FRAME_CAPACITY 4         // Power of two
+#define FLIGHT_FRAME_ROWS 32
+#define FLIGHT_FRAME_COLS 96
+
+typedef enum {
+    FLIGHT_EVENT_MARK,      // value: pointer to a string literal
+    FLIGHT_EVENT_INPUT,     // value: key code
+    FLIGHT_EVENT_TICK,      // value: tick duration in microseconds
+    FLIGHT_EVENT_RNG,       // value: random value drawn
+    FLIGHT_EVENT_FRAME,     // value: frame sequence number
+    FLIGHT_EVENT_TYPE_COUNT
+} FlightEventType;
+
+typedef struct {
+    uint64_t time_us;       // Microseconds since install
+    uint64_t value;
+    uint32_t seq;           // Published last; 0 = slot never written
+    uint16_t type;
+    uint16_t reserved;
+} FlightEvent;
+
+// Claims the recorder for this process's session; returns 0 if a session
+// in this process already has it
+int flight_recorder_install(void);
+uint64_t flight_recorder_now_us(void);
+
+void flight_recorder_event(FlightEventType type, uint64_t value);
+void flight_recorder_mark(const char* label);   // label must outlive the process
+
+// Copies up to FLIGHT_FRAME_ROWS rows of a rendered screen buffer
+void flight_recorder_frame(const char* rows, int row_count, int row_stride);
+
+// Writes the current ring to fd in the crash-dump text format
+// (async-signal-safe; also used for manual dumps and tests)
+void flight_recorder_dump(int fd, int signal_number);
+
+#define flight_recorder_input(key) flight_recorder_event(FLIGHT_EVENT_INPUT, (uint64_t)(key))
+#define flight_recorder_tick(us) flight_recorder_event(FLIGHT_EVENT_TICK, (uint64_t)(us))
+#define flight_recorder_rng(value) flight_recorder_event(FLIGHT_EVENT_RNG, (uint64_t)(value))
+
+#endif // FLIGHT_RECORDER_H
@@ -37,6 +37,17 @@ void play_dino_runner(void);
 void play_russian_roulette(void);
 void play_sliding_puzzle(void);
 void yahtzee_game(void);
+void play_texas_holdem(void);
+void show_rating_ladder(void);
+void play_wordle(void);
+void play_tetris(void);
+
+// Coroutine sessions for hosting many players (see coroutine.h)
+struct CoSession;
+int guess_number_session(struct CoSession* session);
+// Each hosted session draws from its own generator, seeded here
+void guess_number_session_setup(struct CoSession* session, int max_number, int max_attempts,
+                                unsigned long long seed);
 
 // Utility functions
 void clear_input_buffer(void);
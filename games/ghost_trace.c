@@ -0,0 +1,211 @@
+/*
+ * Ghost Trajectory Traces
+ * Part of CLI Games Pack v2.1
+ *
+ * File layout: a 24-byte header (magic, score, ticks, event byte count,
+ * starting row and state) followed by the change bytes described in
+ * ghost_trace.h. Row deltas wider than the 5-bit field are split into
+ * several changes with a zero tick gap, so any trajectory can be stored.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "ghost_trace.h"
+#include "write_behind.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#define GHOST_MAGIC 0x31544847u         // "GHT1"
+#define GAP_FOLLOWS 0x80
+#define MAX_CHANGE_BYTES 6              // Change byte plus a 32-bit varint
+
+typedef struct {
+    uint32_t magic;
+    uint32_t score;
+    uint32_t ticks;
+    uint32_t length;                    // Event bytes after the header
+    int32_t start_row;
+    uint32_t start_state;
+} GhostFileHeader;
+
+#ifdef _WIN32
+static uint8_t file_buffer[sizeof(GhostFileHeader) + GHOST_TRACE_MAX_BYTES];
+#endif
+
+void ghost_recorder_begin(GhostRecorder* recorder, int row, int state) {
+    recorder->length = 0;
+    recorder->last_tick = 0;
+    recorder->row = recorder->start_row = row;
+    recorder->state = recorder->start_state = state & 3;
+    recorder->truncated = 0;
+}
+
+static int append_change(GhostRecorder* recorder, uint32_t gap, int dy, int state) {
+    if (recorder->length + MAX_CHANGE_BYTES > GHOST_TRACE_MAX_BYTES) return 0;
+
+    uint32_t zigzag = dy >= 0 ? (uint32_t)dy * 2 : (uint32_t)(-dy) * 2 - 1;
+    uint8_t* out = recorder->data + recorder->length;
+    *out++ = (uint8_t)((gap != 1 ? GAP_FOLLOWS : 0) | zigzag << 2 | (uint32_t)state);
+    if (gap != 1) {
+        while (gap >= 0x80) {
+            *out++ = (uint8_t)(gap | 0x80);
+            gap >>= 7;
+        }
+        *out++ = (uint8_t)gap;
+    }
+    recorder->length = (uint32_t)(out - recorder->data);
+    return 1;
+}
+
+void ghost_recorder_tick(GhostRecorder* recorder, uint32_t tick, int row, int state) {
+    state &= 3;
+    if (recorder->truncated || (row == recorder->row && state == recorder->state)) return;
+
+    uint32_t gap = tick - recorder->last_tick;
+    int dy = row - recorder->row;
+    do {
+        int step = dy < -16 ? -16 : dy > 15 ? 15 : dy;
+        if (!append_change(recorder, gap, step, state)) {
+            recorder->truncated = 1;
+            return;
+        }
+        dy -= step;
+        gap = 0;
+    } while (dy != 0);
+
+    recorder->row = row;
+    recorder->state = state;
+    recorder->last_tick = tick;
+}
+
+int ghost_recorder_save(const GhostRecorder* recorder, const char* path, uint32_t score, uint32_t ticks) {
+    char temp_path[600];
+    GhostFileHeader header = {GHOST_MAGIC, score, ticks, recorder->length,
+                              recorder->start_row, (uint32_t)recorder->start_state};
+
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) return 0;
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) return 0;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(recorder->data, 1, recorder->length, file) == recorder->length;
+    ok = fclose(file) == 0 && ok;
+
+    // A player mapping the old trace keeps reading the old file
+#ifdef _WIN32
+    if (ok) remove(path);
+#endif
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+int ghost_recorder_save_behind(const GhostRecorder* recorder, const char* path, uint32_t score, uint32_t ticks) {
+    GhostFileHeader header = {GHOST_MAGIC, score, ticks, recorder->length,
+                              recorder->start_row, (uint32_t)recorder->start_state};
+    WriteBehindPart parts[2] = {{&header, sizeof(header)}, {recorder->data, recorder->length}};
+    return write_behind_replacev(path, parts, 2);
+}
+
+static void decode_next(GhostPlayer* player) {
+    player->has_pending = 0;
+    if (player->next >= player->end) return;
+
+    uint8_t byte = *player->next++;
+    uint32_t gap = 1;
+    if (byte & GAP_FOLLOWS) {
+        uint8_t part;
+        int shift = 0;
+        gap = 0;
+        do {
+            if (player->next >= player->end || shift > 28) return;    // Cut short: stop here
+            part = *player->next++;
+            gap |= (uint32_t)(part & 0x7F) << shift;
+            shift += 7;
+        } while (part & 0x80);
+    }
+
+    int zigzag = (byte >> 2) & 31;
+    player->pending_tick += gap;
+    player->pending_row += (zigzag >> 1) ^ -(zigzag & 1);
+    player->pending_state = byte & 3;
+    player->has_pending = 1;
+}
+
+void ghost_player_rewind(GhostPlayer* player) {
+    player->next = player->events;
+    player->pending_tick = 0;
+    player->pending_row = player->row = player->start_row;
+    player->state = player->start_state;
+    decode_next(player);
+}
+
+void ghost_player_advance(GhostPlayer* player, uint32_t tick) {
+    while (player->has_pending && player->pending_tick <= tick) {
+        player->row = player->pending_row;
+        player->state = player->pending_state;
+        decode_next(player);
+    }
+}
+
+int ghost_player_open(GhostPlayer* player, const char* path) {
+    GhostFileHeader header;
+    const uint8_t* bytes;
+    size_t size;
+
+    memset(player, 0, sizeof(*player));
+#ifdef _WIN32
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    size = fread(file_buffer, 1, sizeof(file_buffer), file);
+    fclose(file);
+    bytes = file_buffer;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(header) ||
+        st.st_size > (off_t)(sizeof(header) + GHOST_TRACE_MAX_BYTES)) {
+        close(fd);
+        return 0;
+    }
+    size = (size_t)st.st_size;
+    void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return 0;
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    player->mapping = mapped;
+    player->mapping_size = size;
+    bytes = mapped;
+#endif
+
+    if (size >= sizeof(header)) memcpy(&header, bytes, sizeof(header));
+    if (size < sizeof(header) || header.magic != GHOST_MAGIC ||
+        header.length != size - sizeof(header) || header.start_state > 3) {
+        ghost_player_close(player);
+        return 0;
+    }
+
+    player->events = bytes + sizeof(header);
+    player->end = player->events + header.length;
+    player->score = header.score;
+    player->ticks = header.ticks;
+    player->start_row = header.start_row;
+    player->start_state = (int)header.start_state;
+    ghost_player_rewind(player);
+    return 1;
+}
+
+void ghost_player_close(GhostPlayer* player) {
+#ifndef _WIN32
+    if (player->mapping) munmap(player->mapping, player->mapping_size);
+#endif
+    memset(player, 0, sizeof(*player));
+}
@@ -0,0 +1,67 @@
+#ifndef GHOST_TRACE_H
+#define GHOST_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Per-tick trajectory traces for racing against a recorded run.
+ *
+ * A run is a sequence of (row, state) samples, one per game tick, where
+ * state is a 2-bit sprite state. Only changes are stored. Each change is
+ * one byte: the low two bits hold the new state, the next five hold the
+ * row delta zigzag-encoded (-16..15), and the top bit says a varint tick
+ * gap follows; without it the change is exactly one tick after the last.
+ * A jump costs about one byte per row it crosses and running along the
+ * ground costs nothing, so an hour of play is tens of kilobytes.
+ *
+ * Playback maps the file read-only and decodes forward as the ticks
+ * advance: no allocation and no copying after the file is opened. On
+ * Windows the file is read into a static buffer instead, so only one
+ * trace can be playing at a time there.
+ */
+
+#define GHOST_TRACE_MAX_BYTES (1 << 20)     // Several hours of constant jumping
+
+typedef struct {
+    uint8_t data[GHOST_TRACE_MAX_BYTES];
+    uint32_t length;
+    uint32_t last_tick;                 // Tick of the last stored change
+    int row, state;
+    int start_row, start_state;
+    int truncated;                      // Ran out of room; later ticks were dropped
+} GhostRecorder;
+
+typedef struct {
+    const uint8_t* next;                // Next undecoded byte
+    const uint8_t* end;
+    const uint8_t* events;              // First event byte, for rewinding
+    void* mapping;
+    size_t mapping_size;
+    uint32_t score;                     // What the recorded run scored
+    uint32_t ticks;                     // How long it lasted
+    uint32_t pending_tick;              // Tick the decoded change applies at
+    int pending_row, pending_state;
+    int has_pending;
+    int start_row, start_state;
+    int row, state;                     // Position as of the last advance
+} GhostPlayer;
+
+void ghost_recorder_begin(GhostRecorder* recorder, int row, int state);
+void ghost_recorder_tick(GhostRecorder* recorder, uint32_t tick, int row, int state);
+
+// Writes the trace atomically (temp file, then rename); returns 1 on success
+int ghost_recorder_save(const GhostRecorder* recorder, const char* path, uint32_t score, uint32_t ticks);
+
+// The same file, handed to the write-behind writer; returns 1 once queued
+int ghost_recorder_save_behind(const GhostRecorder* recorder, const char* path, uint32_t score, uint32_t ticks);
+
+// Returns 1 when path holds a valid trace; the player starts at tick 0
+int ghost_player_open(GhostPlayer* player, const char* path);
+void ghost_player_close(GhostPlayer* player);
+void ghost_player_rewind(GhostPlayer* player);
+
+// Applies every change up to and including tick (ticks must not go backwards)
+void ghost_player_advance(GhostPlayer* player, uint32_t tick);
+
+#endif // GHOST_TRACE_H
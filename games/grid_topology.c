@@ -0,0 +1,113 @@
+#include <stddef.h>
+#include "grid_topology.h"
+
+static const char* topology_names[GRID_TOPOLOGY_COUNT] = {
+    "Square", "Hexagonal", "Torus", "3D Cube"
+};
+
+const char* grid_topology_name(GridTopology topology) {
+    if (topology < 0 || topology >= GRID_TOPOLOGY_COUNT) return "Unknown";
+    return topology_names[topology];
+}
+
+// Odd-row offset layout: odd rows sit half a cell to the right
+static const int hex_even_row[6][2] = {{-1, -1}, {-1, 0}, {0, -1}, {0, 1}, {1, -1}, {1, 0}};
+static const int hex_odd_row[6][2] = {{-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, 0}, {1, 1}};
+
+int grid_build_neighbors(GridNeighbors* grid, GridTopology topology, int width, int height, int depth) {
+    if (topology != GRID_CUBE) depth = 1;
+    if (width < 1 || height < 1 || depth < 1 || width * height * depth > GRID_MAX_CELLS) {
+        return -1;
+    }
+
+    grid->topology = topology;
+    grid->width = width;
+    grid->height = height;
+    grid->depth = depth;
+    grid->cell_count = width * height * depth;
+
+    int count = 0;
+    for (int layer = 0; layer < depth; layer++) {
+        for (int row = 0; row < height; row++) {
+            for (int col = 0; col < width; col++) {
+                int cell = (layer * height + row) * width + col;
+                grid->neighbor_start[cell] = (unsigned short)count;
+
+                if (topology == GRID_HEX) {
+                    const int (*offsets)[2] = (row & 1) ? hex_odd_row : hex_even_row;
+                    for (int i = 0; i < 6; i++) {
+                        int nr = row + offsets[i][0];
+                        int nc = col + offsets[i][1];
+                        if (nr >= 0 && nr < height && nc >= 0 && nc < width) {
+                            grid->neighbors[count++] = (unsigned short)(nr * width + nc);
+                        }
+                    }
+                    continue;
+                }
+
+                int layer_reach = (topology == GRID_CUBE) ? 1 : 0;
+                for (int dl = -layer_reach; dl <= layer_reach; dl++) {
+                    for (int dr = -1; dr <= 1; dr++) {
+                        for (int dc = -1; dc <= 1; dc++) {
+                            if (dl == 0 && dr == 0 && dc == 0) continue;
+                            int nl = layer + dl;
+                            int nr = row + dr;
+                            int nc = col + dc;
+
+                            if (topology == GRID_TORUS) {
+                                nr = (nr + height) % height;
+                                nc = (nc + width) % width;
+                            }
+                            if (nl < 0 || nl >= depth || nr < 0 || nr >= height || nc < 0 || nc >= width) {
+                                continue;
+                            }
+                            grid->neighbors[count++] = (unsigned short)((nl * height + nr) * width + nc);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    grid->neighbor_start[grid->cell_count] = (unsigned short)count;
+    return 0;
+}
+
+void grid_count_adjacent(const GridNeighbors* grid, const unsigned char* mines, unsigned char* numbers) {
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        int sum = 0;
+        for (int k = grid->neighbor_start[cell]; k < grid->neighbor_start[cell + 1]; k++) {
+            sum += mines[grid->neighbors[k]];
+        }
+        numbers[cell] = (unsigned char)sum;
+    }
+}
+
+int grid_flood_reveal(const GridNeighbors* grid, int start, const unsigned char* numbers,
+                      unsigned char* state, unsigned short* revealed) {
+    unsigned short stack[GRID_MAX_CELLS];
+    int top = 0;
+    int count = 0;
+
+    if (state[start] != 0) return 0;
+
+    // Cells are marked when pushed, so each one enters the stack once
+    state[start] = 1;
+    stack[top++] = (unsigned short)start;
+
+    while (top > 0) {
+        int cell = stack[--top];
+        if (revealed != NULL) revealed[count] = (unsigned short)cell;
+        count++;
+
+        if (numbers[cell] != 0) continue;
+
+        for (int k = grid->neighbor_start[cell]; k < grid->neighbor_start[cell + 1]; k++) {
+            int next = grid->neighbors[k];
+            if (state[next] == 0) {
+                state[next] = 1;
+                stack[top++] = (unsigned short)next;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,47 @@
+#ifndef GRID_TOPOLOGY_H
+#define GRID_TOPOLOGY_H
+
+/*
+ * Board topologies for grid games, stored as flat cell arrays plus a
+ * precomputed CSR (compressed sparse row) neighbour table. Neighbours of
+ * cell c are neighbors[neighbor_start[c] .. neighbor_start[c + 1] - 1],
+ * so board logic never needs per-access bounds checks.
+ *
+ * Cell index = (layer * height + row) * width + col
+ */
+
+#define GRID_MAX_CELLS 512
+#define GRID_MAX_NEIGHBORS 26
+
+typedef enum {
+    GRID_SQUARE,    // 8 neighbours, hard edges
+    GRID_HEX,       // 6 neighbours, odd rows shifted right
+    GRID_TORUS,     // 8 neighbours, edges wrap around
+    GRID_CUBE,      // 26 neighbours across stacked layers
+    GRID_TOPOLOGY_COUNT
+} GridTopology;
+
+typedef struct {
+    GridTopology topology;
+    int width;
+    int height;
+    int depth;
+    int cell_count;
+    unsigned short neighbor_start[GRID_MAX_CELLS + 1];
+    unsigned short neighbors[GRID_MAX_CELLS * GRID_MAX_NEIGHBORS];
+} GridNeighbors;
+
+int grid_build_neighbors(GridNeighbors* grid, GridTopology topology, int width, int height, int depth);
+const char* grid_topology_name(GridTopology topology);
+
+// numbers[c] = how many neighbours of c have mines[n] == 1 (mines holds 0/1)
+void grid_count_adjacent(const GridNeighbors* grid, const unsigned char* mines, unsigned char* numbers);
+
+// Reveals 'start' and cascades through zero cells. state holds 0 (hidden),
+// 1 (revealed) or 2 (flagged); only hidden cells are revealed. The caller
+// must handle a mine at 'start' itself. Newly revealed cells are written
+// to 'revealed' when it is not NULL. Returns the number of cells revealed.
+int grid_flood_reveal(const GridNeighbors* grid, int start, const unsigned char* numbers,
+                      unsigned char* state, unsigned short* revealed);
+
+#endif // GRID_TOPOLOGY_H
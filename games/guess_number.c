@@ -1,4 +1,6 @@
 #include "games.h"
+#include "coroutine.h"
+#include "alias_table.h"
 
 void display_guess_rules(void) {
     printf("\n===========================================\n");
@@ -32,87 +34,125 @@ int get_difficulty_level(void) {
     return difficulty;
 }
 
-void play_single_round(int max_number, int max_attempts) {
-    int secret_number = (rand() % max_number) + 1;
-    int guess, attempts = 0;
-    int won = 0;
+typedef struct {
+    FastRng rng;                        // The session's own: rand() is not thread-safe
+    int max_number, max_attempts;
+    int secret_number, guess, attempts, won;
+} GuessRound;
+
+// One round as a coroutine: the same code is played at the menu through
+// co_run_local and can be hosted many times over on a CoLoop, where loops
+// on several threads draw from their sessions' generators, never rand()
+int guess_number_session(CoSession* session) {
+    GuessRound* round = CO_LOCALS(session, GuessRound);
+
+    CO_BEGIN(session);
+    round->secret_number = (int)fast_rng_below(&round->rng, (uint32_t)round->max_number) + 1;
     
-    printf("\n>>> I've picked a number between 1 and %d!\n", max_number);
-    if (max_attempts > 0) {
-        printf("You have %d attempts to guess it.\n", max_attempts);
+    co_printf(session, "\n>>> I've picked a number between 1 and %d!\n", round->max_number);
+    if (round->max_attempts > 0) {
+        co_printf(session, "You have %d attempts to guess it.\n", round->max_attempts);
     } else {
-        printf("You have unlimited attempts to guess it.\n");
+        co_printf(session, "You have unlimited attempts to guess it.\n");
     }
-    printf("Good luck!\n");
+    co_printf(session, "Good luck!\n");
     
-    while (!won && (max_attempts == 0 || attempts < max_attempts)) {
-        printf("\nAttempt #%d", attempts + 1);
-        if (max_attempts > 0) {
-            printf(" (Remaining: %d)", max_attempts - attempts);
+    while (!round->won && (round->max_attempts == 0 || round->attempts < round->max_attempts)) {
+        co_printf(session, "\nAttempt #%d", round->attempts + 1);
+        if (round->max_attempts > 0) {
+            co_printf(session, " (Remaining: %d)", round->max_attempts - round->attempts);
         }
-        printf("\nEnter your guess: ");
+        co_printf(session, "\nEnter your guess: ");
         
-        if (scanf("%d", &guess) != 1) {
-            printf("Invalid input! Please enter a number.\n");
-            clear_input_buffer();
+        // Blank lines are skipped, as scanf did
+        do {
+            CO_READ_LINE(session);
+        } while (!session->closed && session->line[strspn(session->line, " \t\r")] == '\0');
+        if (session->closed && session->line[0] == '\0') {
+            co_printf(session, "\nThe number was: %d\n", round->secret_number);
+            break;
+        }
+        if (sscanf(session->line, "%d", &round->guess) != 1) {
+            co_printf(session, "Invalid input! Please enter a number.\n");
             continue;
         }
         
-        clear_input_buffer();
-        attempts++;
+        round->attempts++;
         
-        if (guess < 1 || guess > max_number) {
-            printf("Please enter a number between 1 and %d!\n", max_number);
-            attempts--; // Don't count invalid guesses
+        if (round->guess < 1 || round->guess > round->max_number) {
+            co_printf(session, "Please enter a number between 1 and %d!\n", round->max_number);
+            round->attempts--; // Don't count invalid guesses
             continue;
         }
         
-        if (guess == secret_number) {
-            won = 1;
-            printf("\n*** CONGRATULATIONS! ***\n");
-            printf("You guessed the number %d correctly!\n", secret_number);
-            printf("It took you %d attempt%s.\n", attempts, (attempts == 1) ? "" : "s");
+        if (round->guess == round->secret_number) {
+            round->won = 1;
+            co_printf(session, "\n*** CONGRATULATIONS! ***\n");
+            co_printf(session, "You guessed the number %d correctly!\n", round->secret_number);
+            co_printf(session, "It took you %d attempt%s.\n", round->attempts, (round->attempts == 1) ? "" : "s");
             
             // Calculate and display score based on efficiency
-            int efficiency_score = max_number / attempts;
-            printf("\n*** Your efficiency score: %d points ***\n", efficiency_score);
+            int efficiency_score = round->max_number / round->attempts;
+            co_printf(session, "\n*** Your efficiency score: %d points ***\n", efficiency_score);
             
-            if (attempts == 1) {
-                printf("*** INCREDIBLE! First try! You must be psychic! ***\n");
-            } else if (attempts <= 3) {
-                printf("*** AMAZING! Outstanding guessing skills! ***\n");
-            } else if (attempts <= 6) {
-                printf("*** Great job! Well done! ***\n");
-            } else if (attempts <= 10) {
-                printf("*** Good work! ***\n");
+            if (round->attempts == 1) {
+                co_printf(session, "*** INCREDIBLE! First try! You must be psychic! ***\n");
+            } else if (round->attempts <= 3) {
+                co_printf(session, "*** AMAZING! Outstanding guessing skills! ***\n");
+            } else if (round->attempts <= 6) {
+                co_printf(session, "*** Great job! Well done! ***\n");
+            } else if (round->attempts <= 10) {
+                co_printf(session, "*** Good work! ***\n");
             } else {
-                printf("*** You got it! Practice makes perfect! ***\n");
+                co_printf(session, "*** You got it! Practice makes perfect! ***\n");
             }
             
-        } else if (guess < secret_number) {
-            printf(">>> Too LOW! Try a HIGHER number.\n");
+        } else if (round->guess < round->secret_number) {
+            co_printf(session, ">>> Too LOW! Try a HIGHER number.\n");
         } else {
-            printf(">>> Too HIGH! Try a LOWER number.\n");
+            co_printf(session, ">>> Too HIGH! Try a LOWER number.\n");
         }
         
         // Give additional hints for harder difficulties
-        if (max_attempts > 0 && attempts >= max_attempts / 2 && !won) {
-            int diff = abs(guess - secret_number);
+        if (round->max_attempts > 0 && round->attempts >= round->max_attempts / 2 && !round->won) {
+            int diff = abs(round->guess - round->secret_number);
             if (diff <= 5) {
-                printf("*** You're very close! (Within 5) ***\n");
+                co_printf(session, "*** You're very close! (Within 5) ***\n");
             } else if (diff <= 15) {
-                printf("*** You're getting warmer! (Within 15) ***\n");
+                co_printf(session, "*** You're getting warmer! (Within 15) ***\n");
             } else if (diff <= 30) {
-                printf("*** You're still quite far... (Within 30) ***\n");
+                co_printf(session, "*** You're still quite far... (Within 30) ***\n");
             }
         }
     }
     
-    if (!won) {
-        printf("\n*** Game Over! You've used all %d attempts. ***\n", max_attempts);
-        printf("The number was: %d\n", secret_number);
-        printf("Better luck next time!\n");
+    if (!round->won && round->max_attempts > 0 && round->attempts == round->max_attempts) {
+        co_printf(session, "\n*** Game Over! You've used all %d attempts. ***\n", round->max_attempts);
+        co_printf(session, "The number was: %d\n", round->secret_number);
+        co_printf(session, "Better luck next time!\n");
     }
+    CO_END(session);
+}
+
+void guess_number_session_setup(CoSession* session, int max_number, int max_attempts, unsigned long long seed) {
+    GuessRound* round = CO_LOCALS(session, GuessRound);
+    fast_rng_seed(&round->rng, seed);
+    round->max_number = max_number;
+    round->max_attempts = max_attempts;
+}
+
+// The menu plays on the main thread, so its seed can follow srand()
+static void prepare_round(CoSession* session, void* arg) {
+    const int* limits = (const int*)arg;
+    FastRng seeder;
+    fast_rng_seed_from_rand(&seeder);
+    guess_number_session_setup(session, limits[0], limits[1], seeder.state);
+}
+
+void play_single_round(int max_number, int max_attempts) {
+    int limits[2] = {max_number, max_attempts};
+    fflush(stdout);
+    co_run_local(guess_number_session, prepare_round, limits);
 }
 
 void play_guess_number(void) {
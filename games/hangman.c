@@ -1,4 +1,6 @@
 #include "games.h"
+#include "daily.h"
+#include "word_grades.h"
 
 #define MAX_WORD_LENGTH 20
 #define MAX_WRONG_GUESSES 6
@@ -81,10 +83,10 @@ void draw_hangman(int wrong_guesses) {
     printf("+---+    \n");
 }
 
-void init_game(HangmanGame* game) {
-    // Select random word
-    int word_index = rand() % WORD_COUNT;
-    strcpy(game->word, word_list[word_index]);
+// word == NULL picks a random word from the built-in list
+void init_game(HangmanGame* game, const char* word) {
+    if (word == NULL) word = word_list[rand() % WORD_COUNT];
+    snprintf(game->word, sizeof(game->word), "%s", word);
     game->word_length = strlen(game->word);
     
     // Initialize guessed word with underscores
@@ -132,7 +134,9 @@ void display_hangman_rules(void) {
     printf("How to play:\n");
     printf("* Guess the hidden word one letter at a time\n");
     printf("* You have 6 wrong guesses before you lose\n");
-    printf("* All words are related to computers/programming\n");
+    printf("* Random and daily words are about computers/programming\n");
+    printf("* Easy, medium and hard words are graded by how often an\n");
+    printf("  expert guesser who knows the whole dictionary misses\n");
     printf("* Good luck!\n");
     printf("-------------------------------------------\n");
 }
@@ -228,13 +232,35 @@ void play_hangman(void) {
     HangmanGame game;
     char guess;
     int guess_result;
+    char line[16];
     
     display_hangman_rules();
+    printf("Press Enter for a random word, E/M/H for an easy, medium or hard one,\n");
+    printf("or D for today's daily word: ");
+    char choice = fgets(line, sizeof(line), stdin) ? (char)toupper((unsigned char)line[0]) : '\n';
+    int daily = choice == 'D';
+    int grade = choice == 'E' ? WORD_GRADE_EASY : choice == 'M' ? WORD_GRADE_MEDIUM :
+                choice == 'H' ? WORD_GRADE_HARD : -1;
+    if (grade >= 0) {
+        word_grades_open(WORD_POOL_HANGMAN, (const char* const*)word_list, WORD_COUNT);
+    }
     
     while (1) {
-        init_game(&game);
+        // The daily word is the same for everyone today; later games keep the chosen level
+        uint64_t stream = daily_seed(DAILY_HANGMAN, daily_today());
+        if (daily) {
+            init_game(&game, word_list[daily_below(&stream, WORD_COUNT)]);
+        } else {
+            init_game(&game, grade >= 0 ? word_grades_pick(WORD_POOL_HANGMAN, (WordGrade)grade, (uint32_t)rand())
+                                        : NULL);
+        }
         
-        printf("\n🎮 New game started!\n");
+        if (!daily && grade >= 0) {
+            printf("\n🎮 New game started! (%s word)\n", word_grades_name((WordGrade)grade));
+        } else {
+            printf("\n🎮 New %sgame started!\n", daily ? "daily " : "");
+        }
+        daily = 0;
         printf("Word length: %d letters\n", game.word_length);
         
         while (game.wrong_guesses < MAX_WRONG_GUESSES && !is_word_complete(&game)) {
@@ -0,0 +1,367 @@
+/*
+ * Shared High Score Table
+ * Part of CLI Games Pack v2.1
+ *
+ * Layout of highscores.tbl (fixed size, zero-filled is a valid empty table):
+ * - header with magic/version and the name registry count
+ * - one 128-byte slot per (game, mode): writer count, sequence number and
+ *   HIGHSCORE_TOP_K packed entries (unsorted)
+ * - an append-only registry of player names
+ *
+ * Submitting: scan the slot for its smallest entry and CAS the new entry
+ * over it; if another process changed that word first, rescan and retry.
+ * Entries only ever increase, so the slot always holds the best K scores
+ * submitted so far. Writers bump 'writers' around the CAS and 'seq' after
+ * it; readers copy the entries and retry while a write overlapped the copy.
+ * A reader gives up retrying after a bounded number of attempts (a process
+ * killed mid-submit leaves 'writers' raised) and uses the last copy, which
+ * is still made of whole entries.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "highscores.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <errno.h>
+    #include <sched.h>
+#endif
+
+#define HIGHSCORE_MAGIC 0x31305348u     // "HS01"
+#define HIGHSCORE_FILE "highscores.tbl"
+#define HIGHSCORE_EPOCH 1704067200L     // 2024-01-01 00:00:00 UTC
+#define SNAPSHOT_ATTEMPTS 64
+#define NO_NAME 0xFFFFu
+
+typedef struct {
+    uint32_t writers;                   // Submits in progress
+    uint32_t seq;                       // Completed submits
+    uint64_t entries[HIGHSCORE_TOP_K];  // score << 32 | (name id + 1) << 16 | day
+    char padding[128 - 8 - 8 * HIGHSCORE_TOP_K];
+} HighScoreSlot;
+
+typedef struct {
+    uint32_t ready;
+    char name[HIGHSCORE_NAME_LEN];
+} HighScoreName;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t name_count;
+    char padding[120];
+    HighScoreSlot slots[HIGHSCORE_GAME_COUNT][HIGHSCORE_MAX_MODES];
+    HighScoreName names[HIGHSCORE_MAX_NAMES];
+} HighScoreTable;
+
+static HighScoreTable local_table;
+static HighScoreTable* table = NULL;
+static int table_shared = 0;
+
+// Last name registered by this process, so repeat submits skip the scan
+static char cached_name[HIGHSCORE_NAME_LEN];
+static uint32_t cached_name_id = NO_NAME;
+
+const char* highscore_shared_dir(void) {
+    const char* dir = getenv("CLI_GAMES_SHARED_DIR");
+    if (dir && *dir) return dir;
+#ifdef _WIN32
+    return ".";
+#else
+    return "/tmp/cli-games";
+#endif
+}
+
+// World-writable and sticky like /tmp, so every user can create files
+int highscore_make_shared_dir(void) {
+#ifndef _WIN32
+    const char* dir = highscore_shared_dir();
+    if (mkdir(dir, 01777) == 0) {
+        chmod(dir, 01777);                      // Past the umask
+        return 1;
+    }
+    return errno == EEXIST;
+#else
+    return 1;
+#endif
+}
+
+int highscore_shared_path(const char* file_name, char* path, int size) {
+    int written = snprintf(path, (size_t)size, "%s/%s", highscore_shared_dir(), file_name);
+    return written > 0 && written < size;
+}
+
+#ifndef _WIN32
+#define TEMP_ATTEMPTS 64
+
+int highscore_create_temp(const char* path, char* temp_path, int size) {
+    static uint32_t counter;
+    struct timespec now;
+
+    for (int attempt = 0; attempt < TEMP_ATTEMPTS; attempt++) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint32_t salt = (uint32_t)now.tv_nsec * 2654435761u ^ (uint32_t)now.tv_sec ^
+                        __atomic_add_fetch(&counter, 0x9E3779B9u, __ATOMIC_RELAXED);
+        int written = snprintf(temp_path, (size_t)size, "%s.%ld.%08x.tmp", path, (long)getpid(), salt);
+        if (written <= 0 || written >= size) break;
+        int fd = open(temp_path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+        if (fd >= 0) return fd;
+        if (errno != EEXIST) break;
+    }
+    if (size > 0) temp_path[0] = '\0';           // Nothing of ours to remove
+    return -1;
+}
+
+// Says once per file that this process keeps its own copy
+static void warn_unshared(const char* file_name, const char* reason) {
+    static const char* warned[8];
+    for (int i = 0; i < 8; i++) {
+        if (warned[i] && strcmp(warned[i], file_name) == 0) return;
+        if (!warned[i]) {
+            warned[i] = file_name;
+            break;
+        }
+    }
+    fprintf(stderr, "cli-games: %s/%s is not shared (%s); keeping this session's own copy\n",
+            highscore_shared_dir(), file_name, reason);
+}
+
+void* highscore_map_shared(const char* file_name, size_t size) {
+    char path[512];
+
+    if (!highscore_make_shared_dir() || !highscore_shared_path(file_name, path, sizeof(path))) {
+        warn_unshared(file_name, "no shared directory");
+        return NULL;
+    }
+
+    // Never opened through a link planted in the directory
+    int fd = open(path, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        warn_unshared(file_name, strerror(errno));
+        return NULL;
+    }
+
+    // Every user reads and writes it; a file that is not a plain, singly
+    // linked one is left alone
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_nlink != 1) {
+        close(fd);
+        warn_unshared(file_name, "not a regular file");
+        return NULL;
+    }
+    if (st.st_uid == geteuid() && (st.st_mode & 0777) != 0666) fchmod(fd, 0666);    // Past the umask
+    if (st.st_size < (off_t)size && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        warn_unshared(file_name, strerror(errno));
+        return NULL;
+    }
+
+    void* mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        warn_unshared(file_name, strerror(errno));
+        return NULL;
+    }
+    return mapped;
+}
+
+void highscore_unmap_shared(const char* file_name, void* mapped, size_t size, const char* reason) {
+    munmap(mapped, size);
+    warn_unshared(file_name, reason);
+}
+#endif
+
+int highscore_open(void) {
+    if (table) return table_shared;
+
+#ifndef _WIN32
+    HighScoreTable* shared = highscore_map_shared(HIGHSCORE_FILE, sizeof(HighScoreTable));
+    if (shared) {
+        uint32_t expected = 0;
+        __atomic_compare_exchange_n(&shared->magic, &expected, HIGHSCORE_MAGIC, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        if (expected == 0 || expected == HIGHSCORE_MAGIC) {
+            table = shared;
+            table_shared = 1;
+            return 1;
+        }
+        highscore_unmap_shared(HIGHSCORE_FILE, shared, sizeof(HighScoreTable), "another table version");
+    }
+#endif
+
+    local_table.magic = HIGHSCORE_MAGIC;
+    table = &local_table;
+    table_shared = 0;
+    return 0;
+}
+
+void highscore_close(void) {
+#ifndef _WIN32
+    if (table && table_shared) munmap(table, sizeof(HighScoreTable));
+#endif
+    table = NULL;
+    table_shared = 0;
+    cached_name_id = NO_NAME;
+}
+
+static HighScoreSlot* get_slot(HighScoreGame game, int mode) {
+    if ((int)game < 0 || game >= HIGHSCORE_GAME_COUNT || mode < 0 || mode >= HIGHSCORE_MAX_MODES) {
+        return NULL;
+    }
+    highscore_open();
+    return &table->slots[game][mode];
+}
+
+static uint32_t register_name(const char* name) {
+    char key[HIGHSCORE_NAME_LEN] = {0};
+    strncpy(key, name, HIGHSCORE_NAME_LEN - 1);
+
+    if (cached_name_id != NO_NAME && strcmp(cached_name, key) == 0) return cached_name_id;
+
+    uint32_t count = __atomic_load_n(&table->name_count, __ATOMIC_ACQUIRE);
+    if (count > HIGHSCORE_MAX_NAMES) count = HIGHSCORE_MAX_NAMES;
+    for (uint32_t i = 0; i < count; i++) {
+        if (__atomic_load_n(&table->names[i].ready, __ATOMIC_ACQUIRE) &&
+            strncmp(table->names[i].name, key, HIGHSCORE_NAME_LEN) == 0) {
+            memcpy(cached_name, key, sizeof(key));
+            cached_name_id = i;
+            return i;
+        }
+    }
+
+    // Two processes adding the same new name at once may both succeed;
+    // that only costs a duplicate registry entry.
+    uint32_t id = __atomic_fetch_add(&table->name_count, 1, __ATOMIC_SEQ_CST);
+    if (id >= HIGHSCORE_MAX_NAMES) return NO_NAME;
+    memcpy(table->names[id].name, key, sizeof(key));
+    __atomic_store_n(&table->names[id].ready, 1, __ATOMIC_RELEASE);
+
+    memcpy(cached_name, key, sizeof(key));
+    cached_name_id = id;
+    return id;
+}
+
+static uint16_t current_day(void) {
+    long elapsed = (long)time(NULL) - HIGHSCORE_EPOCH;
+    return (uint16_t)(elapsed > 0 ? elapsed / 86400 : 0);
+}
+
+int highscore_submit(HighScoreGame game, int mode, const char* name, uint32_t score) {
+    HighScoreSlot* slot = get_slot(game, mode);
+    if (!slot || score == 0) return 0;
+
+    uint32_t name_id = register_name(name);
+    uint64_t entry = ((uint64_t)score << 32) | ((uint64_t)((name_id + 1) & 0xFFFF) << 16) | current_day();
+    int replaced = 0;
+
+    __atomic_fetch_add(&slot->writers, 1, __ATOMIC_SEQ_CST);
+    while (!replaced) {
+        int min_index = 0;
+        uint64_t min_entry = __atomic_load_n(&slot->entries[0], __ATOMIC_SEQ_CST);
+        for (int i = 1; i < HIGHSCORE_TOP_K; i++) {
+            uint64_t current = __atomic_load_n(&slot->entries[i], __ATOMIC_SEQ_CST);
+            if (current < min_entry) {
+                min_entry = current;
+                min_index = i;
+            }
+        }
+        if (entry <= min_entry) break;
+
+        replaced = __atomic_compare_exchange_n(&slot->entries[min_index], &min_entry, entry, 0,
+                                               __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+    if (replaced) __atomic_fetch_add(&slot->seq, 1, __ATOMIC_SEQ_CST);
+    __atomic_fetch_sub(&slot->writers, 1, __ATOMIC_SEQ_CST);
+
+    if (!replaced) return 0;
+
+    int rank = 1;
+    for (int i = 0; i < HIGHSCORE_TOP_K; i++) {
+        if (__atomic_load_n(&slot->entries[i], __ATOMIC_SEQ_CST) > entry) rank++;
+    }
+    return rank <= HIGHSCORE_TOP_K ? rank : 0;
+}
+
+static void snapshot_slot(HighScoreSlot* slot, uint64_t* words) {
+    for (int attempt = 0; attempt < SNAPSHOT_ATTEMPTS; attempt++) {
+        uint32_t seq_before = __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST);
+        uint32_t writers_before = __atomic_load_n(&slot->writers, __ATOMIC_SEQ_CST);
+        for (int i = 0; i < HIGHSCORE_TOP_K; i++) {
+            words[i] = __atomic_load_n(&slot->entries[i], __ATOMIC_SEQ_CST);
+        }
+        uint32_t writers_after = __atomic_load_n(&slot->writers, __ATOMIC_SEQ_CST);
+        uint32_t seq_after = __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST);
+
+        if (writers_before == 0 && writers_after == 0 && seq_before == seq_after) return;
+#ifndef _WIN32
+        sched_yield();
+#endif
+    }
+}
+
+static int compare_entries_desc(const void* a, const void* b) {
+    uint64_t wa = *(const uint64_t*)a;
+    uint64_t wb = *(const uint64_t*)b;
+    return wa < wb ? 1 : wa > wb ? -1 : 0;
+}
+
+// Fills entries (HIGHSCORE_TOP_K capacity) best first; returns the count
+int highscore_read(HighScoreGame game, int mode, HighScoreEntry* entries) {
+    HighScoreSlot* slot = get_slot(game, mode);
+    uint64_t words[HIGHSCORE_TOP_K];
+    int count = 0;
+
+    if (!slot) return 0;
+    snapshot_slot(slot, words);
+    qsort(words, HIGHSCORE_TOP_K, sizeof(uint64_t), compare_entries_desc);
+
+    for (int i = 0; i < HIGHSCORE_TOP_K && words[i] != 0; i++) {
+        uint32_t name_id = (uint32_t)((words[i] >> 16) & 0xFFFF) - 1;
+        HighScoreEntry* entry = &entries[count++];
+
+        entry->score = (uint32_t)(words[i] >> 32);
+        entry->day = (uint16_t)(words[i] & 0xFFFF);
+        if (name_id < HIGHSCORE_MAX_NAMES && __atomic_load_n(&table->names[name_id].ready, __ATOMIC_ACQUIRE)) {
+            memcpy(entry->name, table->names[name_id].name, HIGHSCORE_NAME_LEN);
+            entry->name[HIGHSCORE_NAME_LEN - 1] = '\0';
+        } else {
+            strcpy(entry->name, "???");
+        }
+    }
+    return count;
+}
+
+uint32_t highscore_best(HighScoreGame game, int mode) {
+    HighScoreSlot* slot = get_slot(game, mode);
+    uint64_t best = 0;
+
+    if (!slot) return 0;
+    for (int i = 0; i < HIGHSCORE_TOP_K; i++) {
+        uint64_t current = __atomic_load_n(&slot->entries[i], __ATOMIC_SEQ_CST);
+        if (current > best) best = current;
+    }
+    return (uint32_t)(best >> 32);
+}
+
+void highscore_display(HighScoreGame game, int mode, const char* title) {
+    HighScoreEntry entries[HIGHSCORE_TOP_K];
+    int count = highscore_read(game, mode, entries);
+
+    printf("================================================\n");
+    printf("|  HALL OF FAME: %-29s |\n", title);
+    printf("================================================\n");
+    if (count == 0) {
+        printf("|  No records yet - be the first!              |\n");
+    }
+    for (int i = 0; i < count; i++) {
+        printf("|  %2d. %-16s %10u              |\n", i + 1, entries[i].name, entries[i].score);
+    }
+    printf("================================================\n");
+    if (!table_shared) {
+        printf("(Shared table unavailable - showing this session only)\n");
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef HIGHSCORES_H
+#define HIGHSCORES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Shared high-score table.
+ *
+ * One memory-mapped file in the shared directory ($CLI_GAMES_SHARED_DIR,
+ * default /tmp/cli-games) holds a fixed top-K slot for every game and mode,
+ * so every running cli-games process sees new records the moment they are
+ * made. Each entry is a single 64-bit word (score | name id | day):
+ * submitting a score is a compare-and-swap that replaces the slot's lowest
+ * entry, and readers take sequence-checked snapshots instead of locking.
+ *
+ * Higher scores are better. Falls back to a per-process table when the
+ * shared file cannot be mapped (and always on Windows).
+ *
+ * The shared files are read-write for every user, like the directory, so
+ * players under different accounts share one table. Whoever maps one
+ * checks its header before trusting it.
+ */
+
+#define HIGHSCORE_TOP_K 10
+#define HIGHSCORE_MAX_MODES 8
+#define HIGHSCORE_NAME_LEN 16
+#define HIGHSCORE_MAX_NAMES 2048
+
+typedef enum {
+    HIGHSCORE_DINO_RUNNER,
+    HIGHSCORE_SNAKE,
+    HIGHSCORE_FLAPPY_BIRD,
+    HIGHSCORE_STRESS_TEST,      // Reserved for test_highscores
+    HIGHSCORE_TETRIS,
+    HIGHSCORE_GAME_COUNT = 16
+} HighScoreGame;
+
+typedef struct {
+    uint32_t score;
+    uint16_t day;               // Days since 2024-01-01
+    char name[HIGHSCORE_NAME_LEN];
+} HighScoreEntry;
+
+int highscore_open(void);       // Returns 1 when the shared table is mapped
+void highscore_close(void);
+const char* highscore_shared_dir(void);
+int highscore_make_shared_dir(void);    // Returns 0 if it is missing and cannot be made
+int highscore_shared_path(const char* file_name, char* path, int size);
+
+// Creates a fresh temp file next to path, to be renamed over it, and
+// returns it open read-write (or -1). The name is unguessable and opened
+// with O_EXCL | O_NOFOLLOW: a file or link already planted there is never
+// written through, another name is tried instead. Not on Windows.
+int highscore_create_temp(const char* path, char* temp_path, int size);
+
+// Maps file_name in the shared directory read-write, creating it for every
+// user and growing it to size. On failure it warns once per file on stderr
+// and returns NULL, and the caller keeps a per-process copy. Not on Windows.
+void* highscore_map_shared(const char* file_name, size_t size);
+// Unmaps a file whose header did not check out, warning as above
+void highscore_unmap_shared(const char* file_name, void* mapped, size_t size, const char* reason);
+
+// Returns the new entry's rank (1 = best) or 0 if it did not make the top K
+int highscore_submit(HighScoreGame game, int mode, const char* name, uint32_t score);
+int highscore_read(HighScoreGame game, int mode, HighScoreEntry* entries);
+uint32_t highscore_best(HighScoreGame game, int mode);
+void highscore_display(HighScoreGame game, int mode, const char* title);
+
+#endif // HIGHSCORES_H
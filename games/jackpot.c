@@ -0,0 +1,307 @@
+/*
+ * Shared Progressive Jackpot
+ * Part of CLI Games Pack v2.1
+ *
+ * jackpot.seg (256 bytes, zero-filled is "not built yet") holds a state
+ * word, the checkpoint schedule and the counters. The jackpot amount and
+ * the contribution total, which every spin adds to, sit on cache lines of
+ * their own. The first session to find the segment unbuilt swaps its pid
+ * into the state word, fills the counters from the checkpoint and then
+ * publishes the magic; the others wait for it, and take over the build
+ * if the builder died.
+ *
+ * Both files are read-write for every user, so sessions under different
+ * accounts share one jackpot. jackpot.ckpt holds two checkpoint records,
+ * written alternately in place (renaming over another user's file is not
+ * allowed in the sticky shared directory). Each record carries a sequence
+ * number and a checksum, so a torn write leaves the other record to
+ * restore from.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include <stddef.h>
+#include "jackpot.h"
+#include "highscores.h"
+#include "terminal.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <errno.h>
+    #include <signal.h>
+#endif
+
+#define JACKPOT_MAGIC 0x3154504Au         // "JPT1"
+#define CHECKPOINT_MAGIC 0x314B504Au      // "JPK1"
+#define BUILDING 0x80000000u              // State while a pid is building
+#define SEGMENT_FILE "jackpot.seg"
+#define CHECKPOINT_FILE "jackpot.ckpt"
+#define ATTACH_ATTEMPTS 2000              // About two seconds of waiting
+
+typedef struct {
+    uint32_t state;                       // 0, BUILDING | pid, or JACKPOT_MAGIC
+    uint32_t reserved;
+    uint64_t checkpoint_due_ms;
+    uint64_t checkpoints;
+    char padding0[40];
+    uint64_t amount_cents;
+    char padding1[56];
+    uint64_t contributed_cents;
+    char padding2[56];
+    uint64_t seeded_cents;
+    uint64_t paid_cents;
+    uint64_t wins;
+    char padding3[40];
+} JackpotSegment;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    uint64_t sequence;
+    uint64_t amount_cents;
+    uint64_t contributed_cents;
+    uint64_t seeded_cents;
+    uint64_t paid_cents;
+    uint64_t wins;
+    uint64_t checksum;                    // FNV-1a of everything above
+} JackpotCheckpoint;
+
+static JackpotSegment local_segment;
+static JackpotSegment* segment = NULL;
+static int segment_shared = 0;
+
+static uint64_t now_ms(void) {
+    return terminal_now_us() / 1000;
+}
+
+static uint64_t checksum(const JackpotCheckpoint* record) {
+    const unsigned char* bytes = (const unsigned char*)record;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < offsetof(JackpotCheckpoint, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+int jackpot_checkpoint_path(char* path, int size) {
+    return highscore_shared_path(CHECKPOINT_FILE, path, size);
+}
+
+// The newer of the two records that are whole
+static int read_checkpoint(JackpotCheckpoint* latest) {
+    char path[512];
+    JackpotCheckpoint records[2];
+    int found = 0;
+
+    memset(latest, 0, sizeof(*latest));
+    if (!jackpot_checkpoint_path(path, sizeof(path))) return 0;
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    size_t count = fread(records, sizeof(JackpotCheckpoint), 2, file);
+    fclose(file);
+
+    for (size_t i = 0; i < count; i++) {
+        const JackpotCheckpoint* record = &records[i];
+        if (record->magic != CHECKPOINT_MAGIC || record->size != sizeof(JackpotCheckpoint) ||
+            record->checksum != checksum(record)) {
+            continue;
+        }
+        if (!found || record->sequence > latest->sequence) *latest = *record;
+        found = 1;
+    }
+    return found;
+}
+
+static int write_checkpoint(const JackpotCheckpoint* record) {
+    char path[512];
+
+    if (!jackpot_checkpoint_path(path, sizeof(path))) return 0;
+#ifndef _WIN32
+    // Never through a link planted in the shared directory
+    int fd = open(path, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0666);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_nlink != 1) {
+        close(fd);
+        return 0;
+    }
+    if (st.st_uid == geteuid() && (st.st_mode & 0777) != 0666) fchmod(fd, 0666);    // Past the umask
+    FILE* file = fdopen(fd, "r+b");
+    if (!file) {
+        close(fd);
+        return 0;
+    }
+#else
+    FILE* file = fopen(path, "r+b");
+    if (!file) file = fopen(path, "w+b");
+    if (!file) return 0;
+#endif
+    long offset = (long)(record->sequence & 1) * (long)sizeof(JackpotCheckpoint);
+    int ok = fseek(file, offset, SEEK_SET) == 0 && fwrite(record, sizeof(*record), 1, file) == 1 &&
+             fflush(file) == 0;
+#ifndef _WIN32
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    return fclose(file) == 0 && ok;
+}
+
+// Counters from the latest checkpoint, or a fresh jackpot
+static void build(JackpotSegment* built) {
+    JackpotCheckpoint record;
+
+    if (read_checkpoint(&record)) {
+        built->amount_cents = record.amount_cents;
+        built->contributed_cents = record.contributed_cents;
+        built->seeded_cents = record.seeded_cents;
+        built->paid_cents = record.paid_cents;
+        built->wins = record.wins;
+        built->checkpoints = record.sequence;
+    } else {
+        built->amount_cents = (uint64_t)JACKPOT_SEED * 100;
+        built->contributed_cents = 0;
+        built->seeded_cents = (uint64_t)JACKPOT_SEED * 100;
+        built->paid_cents = 0;
+        built->wins = 0;
+        built->checkpoints = 0;
+    }
+    built->checkpoint_due_ms = now_ms() + JACKPOT_CHECKPOINT_MS;
+}
+
+#ifndef _WIN32
+static int process_alive(uint32_t pid) {
+    return kill((pid_t)pid, 0) == 0 || errno != ESRCH;
+}
+
+// Waits for the segment to be built, building it if nobody is
+static int attach(JackpotSegment* shared) {
+    uint32_t building = BUILDING | (uint32_t)getpid();
+
+    for (int attempt = 0; attempt < ATTACH_ATTEMPTS; attempt++) {
+        uint32_t state = __atomic_load_n(&shared->state, __ATOMIC_ACQUIRE);
+        if (state == JACKPOT_MAGIC) return 1;
+        if (state != 0 && !(state & BUILDING)) return 0;       // Another segment version
+        if (state == 0 || !process_alive(state & ~BUILDING)) {
+            if (__atomic_compare_exchange_n(&shared->state, &state, building, 0,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                build(shared);
+                __atomic_store_n(&shared->state, JACKPOT_MAGIC, __ATOMIC_RELEASE);
+                return 1;
+            }
+            continue;
+        }
+        usleep(1000);
+    }
+    return 0;
+}
+#endif
+
+int jackpot_open(void) {
+    if (segment) return segment_shared;
+
+#ifndef _WIN32
+    JackpotSegment* shared = highscore_map_shared(SEGMENT_FILE, sizeof(JackpotSegment));
+    if (shared) {
+        if (attach(shared)) {
+            segment = shared;
+            segment_shared = 1;
+            return 1;
+        }
+        highscore_unmap_shared(SEGMENT_FILE, shared, sizeof(JackpotSegment), "another version or never built");
+    }
+#endif
+
+    build(&local_segment);
+    local_segment.state = JACKPOT_MAGIC;
+    segment = &local_segment;
+    segment_shared = 0;
+    return 0;
+}
+
+void jackpot_close(void) {
+    if (!segment) return;
+    jackpot_checkpoint(1);
+#ifndef _WIN32
+    if (segment_shared) munmap(segment, sizeof(JackpotSegment));
+#endif
+    segment = NULL;
+    segment_shared = 0;
+}
+
+int jackpot_checkpoint(int force) {
+    if (!segment) jackpot_open();
+
+    // One session per period wins the due time and writes
+    uint64_t now = now_ms();
+    uint64_t due = __atomic_load_n(&segment->checkpoint_due_ms, __ATOMIC_RELAXED);
+    if (force) {
+        __atomic_store_n(&segment->checkpoint_due_ms, now + JACKPOT_CHECKPOINT_MS, __ATOMIC_RELAXED);
+    } else if (now < due || !__atomic_compare_exchange_n(&segment->checkpoint_due_ms, &due,
+                                                         now + JACKPOT_CHECKPOINT_MS, 0,
+                                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+
+    JackpotCheckpoint record;
+    memset(&record, 0, sizeof(record));
+    record.magic = CHECKPOINT_MAGIC;
+    record.size = sizeof(record);
+    record.sequence = __atomic_add_fetch(&segment->checkpoints, 1, __ATOMIC_RELAXED);
+    record.amount_cents = __atomic_load_n(&segment->amount_cents, __ATOMIC_RELAXED);
+    record.contributed_cents = __atomic_load_n(&segment->contributed_cents, __ATOMIC_RELAXED);
+    record.seeded_cents = __atomic_load_n(&segment->seeded_cents, __ATOMIC_RELAXED);
+    record.paid_cents = __atomic_load_n(&segment->paid_cents, __ATOMIC_RELAXED);
+    record.wins = __atomic_load_n(&segment->wins, __ATOMIC_RELAXED);
+    record.checksum = checksum(&record);
+    return write_checkpoint(&record);
+}
+
+static void checkpoint_if_due(void) {
+    if (now_ms() >= __atomic_load_n(&segment->checkpoint_due_ms, __ATOMIC_RELAXED)) jackpot_checkpoint(0);
+}
+
+uint64_t jackpot_contribute(uint32_t cents) {
+    if (!segment) jackpot_open();
+    uint64_t amount = __atomic_add_fetch(&segment->amount_cents, cents, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&segment->contributed_cents, cents, __ATOMIC_RELAXED);
+    checkpoint_if_due();
+    return amount;
+}
+
+uint64_t jackpot_amount(void) {
+    if (!segment) jackpot_open();
+    return __atomic_load_n(&segment->amount_cents, __ATOMIC_RELAXED);
+}
+
+uint64_t jackpot_claim(void) {
+    if (!segment) jackpot_open();
+
+    // Contributions landing between the load and the swap fail it, and
+    // the retry takes them too
+    uint64_t amount = __atomic_load_n(&segment->amount_cents, __ATOMIC_RELAXED);
+    uint64_t reset;
+    do {
+        reset = (uint64_t)JACKPOT_SEED * 100 + amount % 100;
+    } while (!__atomic_compare_exchange_n(&segment->amount_cents, &amount, reset, 0,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    uint64_t won = amount - amount % 100;
+    __atomic_fetch_add(&segment->paid_cents, won, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&segment->seeded_cents, (uint64_t)JACKPOT_SEED * 100, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&segment->wins, 1, __ATOMIC_RELAXED);
+    checkpoint_if_due();
+    return won / 100;
+}
+
+void jackpot_totals(JackpotTotals* totals) {
+    if (!segment) jackpot_open();
+    totals->amount_cents = __atomic_load_n(&segment->amount_cents, __ATOMIC_RELAXED);
+    totals->contributed_cents = __atomic_load_n(&segment->contributed_cents, __ATOMIC_RELAXED);
+    totals->seeded_cents = __atomic_load_n(&segment->seeded_cents, __ATOMIC_RELAXED);
+    totals->paid_cents = __atomic_load_n(&segment->paid_cents, __ATOMIC_RELAXED);
+    totals->wins = __atomic_load_n(&segment->wins, __ATOMIC_RELAXED);
+    totals->checkpoints = __atomic_load_n(&segment->checkpoints, __ATOMIC_RELAXED);
+}
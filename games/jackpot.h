@@ -0,0 +1,56 @@
+#ifndef JACKPOT_H
+#define JACKPOT_H
+
+#include <stdint.h>
+
+/*
+ * Shared progressive jackpot for the slot machine.
+ *
+ * Every slot session on the machine feeds one jackpot, kept in hundredths
+ * of a credit as a 64-bit word in a memory-mapped segment in the shared
+ * directory (like the high-score table). A bet adds its share with one
+ * atomic fetch-add. Winning swaps the whole amount for the seed with a
+ * compare-and-swap, so exactly one winner takes each jackpot: a
+ * concurrent winner's swap fails and takes the fresh one instead.
+ *
+ * Every few seconds one session (whichever claims the due time first)
+ * writes a checkpoint file next to the segment, and closing a session
+ * writes one too. A missing or unreadable segment is rebuilt from the
+ * latest checkpoint, so the jackpot survives restarts.
+ *
+ * Falls back to a per-process jackpot when the segment cannot be mapped
+ * (and always on Windows); it still starts from the checkpoint.
+ */
+
+#define JACKPOT_SEED 1000                   // Credits after every win
+#define JACKPOT_CHECKPOINT_MS 2000
+
+typedef struct {
+    uint64_t amount_cents;                  // Current jackpot
+    uint64_t contributed_cents;             // Every share ever added
+    uint64_t seeded_cents;                  // Every seed ever put in
+    uint64_t paid_cents;                    // Every win ever paid out
+    uint64_t wins;
+    uint64_t checkpoints;                   // Checkpoints written
+} JackpotTotals;
+
+int jackpot_open(void);                     // Returns 1 when the segment is shared
+void jackpot_close(void);                   // Writes a last checkpoint
+
+// Adds a share of a bet and returns the new jackpot, in hundredths
+uint64_t jackpot_contribute(uint32_t cents);
+uint64_t jackpot_amount(void);
+
+// Takes the whole jackpot and puts the seed back; returns the credits
+// won (the odd hundredths stay in the pot)
+uint64_t jackpot_claim(void);
+
+// Writes the checkpoint now (force) or only if it is due and no other
+// session took the turn; returns 1 when one was written
+int jackpot_checkpoint(int force);
+int jackpot_checkpoint_path(char* path, int size);
+
+// Counters are read one by one, so a concurrent claim can show half done
+void jackpot_totals(JackpotTotals* totals);
+
+#endif // JACKPOT_H
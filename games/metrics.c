@@ -0,0 +1,436 @@
+/*
+ * Hosted-Play Metrics
+ * Part of CLI Games Pack v2.1
+ *
+ * Layout of metrics.shards (fixed size, zero-filled is valid): a 64-byte
+ * header, then METRICS_MAX_SHARDS shards of one owner word (the pid of the
+ * process whose thread claimed it) and a row of 64-bit values: the active
+ * gauge and the session counter of every game, then per histogram its
+ * buckets and its sum. A histogram's count is the total of its buckets,
+ * so an observation is exactly two relaxed adds.
+ *
+ * Shard 0 is never claimed: a thread that finds every shard taken adds
+ * into it, still atomically, so recording never fails.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "highscores.h"
+#include "metrics.h"
+#include <stdarg.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <errno.h>
+#endif
+
+#define METRICS_MAGIC 0x3153544Du       // "MTS1"
+#define METRICS_FILE "metrics.shards"
+#define SLOT_ACTIVE 0
+#define SLOT_SESSIONS METRICS_GAME_COUNT
+#define SLOT_HISTOGRAMS (2 * METRICS_GAME_COUNT)
+#define HISTOGRAM_SLOTS (METRICS_BUCKETS + 1)       // Buckets, then the sum
+#define SLOT_COUNT (SLOT_HISTOGRAMS + METRICS_HISTOGRAM_COUNT * HISTOGRAM_SLOTS)
+#define SHARD_VALUES ((SLOT_COUNT + 1 + 7) / 8 * 8 - 1)    // Shards fill whole cache lines
+#define RENDER_BUFFER_SIZE 32768
+
+typedef struct {
+    uint32_t owner;                     // Claiming pid, 0 when free
+    uint32_t reserved;
+    uint64_t values[SHARD_VALUES];
+} MetricsShard;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t shard_count;
+    uint8_t reserved[56];
+    MetricsShard shards[METRICS_MAX_SHARDS];
+} MetricsTable;
+
+static const char* const game_names[METRICS_GAME_COUNT] = {
+    "rock_paper_scissors", "guess_number", "tic_tac_toe", "hangman", "word_scramble",
+    "coin_flip", "blackjack", "bulls_and_cows", "ascii_racing", "2048", "snake",
+    "slot_machine", "minesweeper", "f1_reaction", "space_invaders", "simon_says",
+    "flappy_bird", "dino_runner", "russian_roulette", "sliding_puzzle", "yahtzee",
+    "texas_holdem", "rating_ladder", "wordle", "tetris"
+};
+
+static const struct {
+    const char* name;
+    const char* help;
+} histograms[METRICS_HISTOGRAM_COUNT] = {
+    {"cli_games_tick_duration_microseconds", "Work done per real-time game frame."},
+    {"cli_games_frame_bytes", "Bytes written to the terminal per redraw."},
+    {"cli_games_input_latency_microseconds", "Time from input being delivered to a hosted session to it being handled."},
+    {"cli_games_stats_write_microseconds", "Time to save a statistics, match log or ghost file."},
+};
+
+static MetricsTable* table;
+static int table_shared;
+static MetricsTable local_table;
+static __thread MetricsShard* thread_shard;
+
+#ifndef _WIN32
+// The child of a fork must not keep adding into its parent's shard
+static void forget_shard_in_child(void) {
+    thread_shard = NULL;
+}
+
+static int process_alive(uint32_t pid) {
+    return kill((pid_t)pid, 0) == 0 || errno != ESRCH;
+}
+#endif
+
+int metrics_open(void) {
+    if (table) return table_shared;
+
+#ifndef _WIN32
+    static int fork_handler_installed;
+    if (!fork_handler_installed) {
+        pthread_atfork(NULL, NULL, forget_shard_in_child);
+        fork_handler_installed = 1;
+    }
+
+    MetricsTable* shared = highscore_map_shared(METRICS_FILE, sizeof(MetricsTable));
+    if (shared) {
+        uint32_t expected = 0;
+        __atomic_compare_exchange_n(&shared->magic, &expected, METRICS_MAGIC, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        if (expected == 0 || expected == METRICS_MAGIC) {
+            shared->shard_count = METRICS_MAX_SHARDS;
+            table = shared;
+            table_shared = 1;
+            return 1;
+        }
+        highscore_unmap_shared(METRICS_FILE, shared, sizeof(MetricsTable), "another table version");
+    }
+#endif
+
+    local_table.magic = METRICS_MAGIC;
+    local_table.shard_count = METRICS_MAX_SHARDS;
+    table = &local_table;
+    table_shared = 0;
+    return 0;
+}
+
+void metrics_close(void) {
+#ifndef _WIN32
+    if (table && table_shared) {
+        // Hand back this process's shards; their counters stay for the next
+        // owner, but sessions still open here end with the process
+        uint32_t pid = (uint32_t)getpid();
+        for (int i = 1; i < METRICS_MAX_SHARDS; i++) {
+            if (__atomic_load_n(&table->shards[i].owner, __ATOMIC_SEQ_CST) != pid) continue;
+            for (int game = 0; game < METRICS_GAME_COUNT; game++) {
+                __atomic_store_n(&table->shards[i].values[SLOT_ACTIVE + game], 0, __ATOMIC_RELAXED);
+            }
+            uint32_t expected = pid;
+            __atomic_compare_exchange_n(&table->shards[i].owner, &expected, 0, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        }
+        munmap(table, sizeof(MetricsTable));
+    }
+#endif
+    table = NULL;
+    table_shared = 0;
+    thread_shard = NULL;
+}
+
+static MetricsShard* claim_shard(void) {
+    metrics_open();
+#ifndef _WIN32
+    uint32_t pid = (uint32_t)getpid();
+#else
+    uint32_t pid = 1;
+#endif
+
+    for (int i = 1; i < METRICS_MAX_SHARDS; i++) {
+        uint32_t expected = 0;
+        if (__atomic_compare_exchange_n(&table->shards[i].owner, &expected, pid, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return &table->shards[i];
+        }
+    }
+#ifndef _WIN32
+    // Every shard is claimed: take over one whose process has exited
+    for (int i = 1; table_shared && i < METRICS_MAX_SHARDS; i++) {
+        uint32_t owner = __atomic_load_n(&table->shards[i].owner, __ATOMIC_SEQ_CST);
+        if (owner == pid || process_alive(owner)) continue;
+        if (__atomic_compare_exchange_n(&table->shards[i].owner, &owner, pid, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            for (int game = 0; game < METRICS_GAME_COUNT; game++) {
+                __atomic_store_n(&table->shards[i].values[SLOT_ACTIVE + game], 0, __ATOMIC_RELAXED);
+            }
+            return &table->shards[i];
+        }
+    }
+#endif
+    return &table->shards[0];
+}
+
+static inline void add(int slot, uint64_t amount) {
+    MetricsShard* shard = thread_shard;
+    if (!shard) shard = thread_shard = claim_shard();
+    __atomic_fetch_add(&shard->values[slot], amount, __ATOMIC_RELAXED);
+}
+
+void metrics_session_begin(MetricsGame game) {
+    if ((int)game < 0 || game >= METRICS_GAME_COUNT) return;
+    add(SLOT_ACTIVE + game, 1);
+    add(SLOT_SESSIONS + game, 1);
+}
+
+void metrics_session_end(MetricsGame game) {
+    if ((int)game < 0 || game >= METRICS_GAME_COUNT) return;
+    add(SLOT_ACTIVE + game, (uint64_t)-1);     // Wraps: the sum over shards is exact
+}
+
+void metrics_observe(MetricsHistogram histogram, uint64_t value) {
+    if ((int)histogram < 0 || histogram >= METRICS_HISTOGRAM_COUNT) return;
+
+    // Bucket b counts values up to 2^b; the last one is +Inf
+    int bucket = 0;
+    if (value > 1) bucket = 64 - __builtin_clzll(value - 1);
+    if (bucket > METRICS_BUCKETS - 1) bucket = METRICS_BUCKETS - 1;
+
+    int base = SLOT_HISTOGRAMS + histogram * HISTOGRAM_SLOTS;
+    add(base + bucket, 1);
+    add(base + METRICS_BUCKETS, value);
+}
+
+static void sum_shards(uint64_t* totals) {
+    metrics_open();
+    memset(totals, 0, SLOT_COUNT * sizeof(uint64_t));
+    for (int i = 0; i < METRICS_MAX_SHARDS; i++) {
+        const MetricsShard* shard = &table->shards[i];
+        uint32_t owner = __atomic_load_n(&shard->owner, __ATOMIC_RELAXED);
+#ifndef _WIN32
+        // A crashed process never ended its sessions: leave them out
+        int live = i == 0 || owner == 0 || !table_shared || process_alive(owner);
+#else
+        int live = 1;
+        (void)owner;
+#endif
+        for (int slot = 0; slot < SLOT_COUNT; slot++) {
+            if (!live && slot < SLOT_SESSIONS) continue;
+            totals[slot] += __atomic_load_n(&shard->values[slot], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+typedef struct {
+    char* out;
+    size_t size, length;
+} RenderBuffer;
+
+static void emit(RenderBuffer* buffer, const char* format, ...) {
+    va_list args;
+    size_t room = buffer->length < buffer->size ? buffer->size - buffer->length : 0;
+
+    va_start(args, format);
+    int written = vsnprintf(room ? buffer->out + buffer->length : NULL, room, format, args);
+    va_end(args);
+    if (written > 0) buffer->length += (size_t)written;
+}
+
+size_t metrics_render(char* out, size_t size) {
+    uint64_t totals[SLOT_COUNT];
+    RenderBuffer buffer = {out, size, 0};
+
+    sum_shards(totals);
+
+    emit(&buffer, "# HELP cli_games_active_sessions Sessions being played right now.\n");
+    emit(&buffer, "# TYPE cli_games_active_sessions gauge\n");
+    for (int game = 0; game < METRICS_GAME_COUNT; game++) {
+        if (!game_names[game]) continue;
+        emit(&buffer, "cli_games_active_sessions{game=\"%s\"} %lld\n", game_names[game],
+             (long long)totals[SLOT_ACTIVE + game]);
+    }
+    emit(&buffer, "# HELP cli_games_sessions_total Sessions started.\n");
+    emit(&buffer, "# TYPE cli_games_sessions_total counter\n");
+    for (int game = 0; game < METRICS_GAME_COUNT; game++) {
+        if (!game_names[game]) continue;
+        emit(&buffer, "cli_games_sessions_total{game=\"%s\"} %llu\n", game_names[game],
+             (unsigned long long)totals[SLOT_SESSIONS + game]);
+    }
+
+    for (int h = 0; h < METRICS_HISTOGRAM_COUNT; h++) {
+        const uint64_t* values = totals + SLOT_HISTOGRAMS + h * HISTOGRAM_SLOTS;
+        uint64_t cumulative = 0;
+        emit(&buffer, "# HELP %s %s\n", histograms[h].name, histograms[h].help);
+        emit(&buffer, "# TYPE %s histogram\n", histograms[h].name);
+        for (int bucket = 0; bucket < METRICS_BUCKETS - 1; bucket++) {
+            cumulative += values[bucket];
+            emit(&buffer, "%s_bucket{le=\"%llu\"} %llu\n", histograms[h].name,
+                 1ull << bucket, (unsigned long long)cumulative);
+        }
+        cumulative += values[METRICS_BUCKETS - 1];
+        emit(&buffer, "%s_bucket{le=\"+Inf\"} %llu\n", histograms[h].name, (unsigned long long)cumulative);
+        emit(&buffer, "%s_sum %llu\n", histograms[h].name, (unsigned long long)values[METRICS_BUCKETS]);
+        emit(&buffer, "%s_count %llu\n", histograms[h].name, (unsigned long long)cumulative);
+    }
+
+    int claimed = 0;
+    for (int i = 1; i < METRICS_MAX_SHARDS; i++) claimed += __atomic_load_n(&table->shards[i].owner, __ATOMIC_RELAXED) != 0;
+    emit(&buffer, "# HELP cli_games_metric_shards Recording threads holding a shard.\n");
+    emit(&buffer, "# TYPE cli_games_metric_shards gauge\n");
+    emit(&buffer, "cli_games_metric_shards %d\n", claimed);
+    return buffer.length;
+}
+
+#ifndef _WIN32
+static pthread_t exporter;
+static int exporter_running;
+static int stop_pipe[2] = {-1, -1};
+static int listen_fd = -1;
+static char export_path[512];
+static char render_buffer[RENDER_BUFFER_SIZE];
+
+static void write_file(void) {
+    char temp_path[600];
+    size_t length = metrics_render(render_buffer, sizeof(render_buffer));
+    if (length >= sizeof(render_buffer)) length = sizeof(render_buffer) - 1;
+
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", export_path, (long)getpid());
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) return;
+    int ok = fwrite(render_buffer, 1, length, file) == length;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_path, export_path) != 0) remove(temp_path);
+}
+
+static void serve_client(int client) {
+    static const char header[] = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n\r\n";
+    size_t length = metrics_render(render_buffer, sizeof(render_buffer));
+    if (length >= sizeof(render_buffer)) length = sizeof(render_buffer) - 1;
+
+    // Answer at once whatever was asked, then wait briefly for the client
+    // to finish sending so closing does not reset the connection
+    if (send(client, header, sizeof(header) - 1, MSG_NOSIGNAL) > 0) {
+        for (size_t sent = 0; sent < length;) {
+            ssize_t n = send(client, render_buffer + sent, length - sent, MSG_NOSIGNAL);
+            if (n <= 0) break;
+            sent += (size_t)n;
+        }
+    }
+    shutdown(client, SHUT_WR);
+    struct pollfd readable = {client, POLLIN, 0};
+    char discard[256];
+    while (poll(&readable, 1, 200) > 0 && read(client, discard, sizeof(discard)) > 0) {
+    }
+    close(client);
+}
+
+static void* exporter_main(void* arg) {
+    (void)arg;
+    const char* interval_text = getenv("CLI_GAMES_METRICS_INTERVAL");
+    int interval = interval_text ? atoi(interval_text) : METRICS_EXPORT_INTERVAL_MS;
+    if (interval < 10) interval = METRICS_EXPORT_INTERVAL_MS;
+
+    struct pollfd fds[2] = {{stop_pipe[0], POLLIN, 0}, {listen_fd, POLLIN, 0}};
+    for (;;) {
+        if (listen_fd < 0) write_file();
+        // A socket only wakes the thread when scraped; a file every interval
+        if (poll(fds, listen_fd >= 0 ? 2 : 1, listen_fd >= 0 ? -1 : interval) < 0 && errno != EINTR) break;
+        if (fds[0].revents) break;
+        if (listen_fd >= 0 && (fds[1].revents & POLLIN)) {
+            int client = accept(listen_fd, NULL, NULL);
+            if (client >= 0) serve_client(client);
+        }
+    }
+    if (listen_fd < 0) write_file();
+    return NULL;
+}
+
+static int open_socket(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        // In use by a live exporter: that one already serves the shared totals
+        if (errno != EADDRINUSE || connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0) {
+            close(fd);
+            return -1;
+        }
+        close(fd);
+        unlink(path);                                // Left behind by a crash
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+    }
+    if (listen(fd, 16) != 0) {
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+    return fd;
+}
+#endif
+
+int metrics_export_start(void) {
+#ifndef _WIN32
+    const char* target = getenv("CLI_GAMES_METRICS");
+    if (exporter_running || !target || !*target) return 0;
+
+    metrics_open();
+    int socket_mode = strncmp(target, "unix:", 5) == 0;
+    if (socket_mode) target += 5;
+    if (snprintf(export_path, sizeof(export_path), "%s", target) >= (int)sizeof(export_path)) return 0;
+    listen_fd = socket_mode ? open_socket(export_path) : -1;
+    if (socket_mode && listen_fd < 0) return 0;
+
+    if (pipe(stop_pipe) != 0) {
+        if (listen_fd >= 0) close(listen_fd);
+        listen_fd = -1;
+        return 0;
+    }
+    // The exporter must not see signals meant for the game loop
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    exporter_running = pthread_create(&exporter, NULL, exporter_main, NULL) == 0;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    if (!exporter_running) {
+        close(stop_pipe[0]);
+        close(stop_pipe[1]);
+        if (listen_fd >= 0) close(listen_fd);
+        listen_fd = -1;
+    }
+    return exporter_running;
+#else
+    return 0;
+#endif
+}
+
+void metrics_export_stop(void) {
+#ifndef _WIN32
+    if (!exporter_running) return;
+    ssize_t ignored = write(stop_pipe[1], "x", 1);
+    (void)ignored;
+    pthread_join(exporter, NULL);
+    close(stop_pipe[0]);
+    close(stop_pipe[1]);
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        unlink(export_path);
+    }
+    listen_fd = -1;
+    exporter_running = 0;
+#endif
+}
@@ -0,0 +1,86 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Runtime metrics for hosted play.
+ *
+ * Every recording thread owns a shard: a row of 64-bit counters that
+ * only it adds to, with relaxed atomic adds, so recording never contends
+ * and never locks. The shards live in one memory-mapped file in the
+ * shared directory (like the high-score table), so the numbers of every
+ * cli-games process on the machine are added up together. A shard whose
+ * process has died is reused by the next thread that needs one; its
+ * cumulative counters carry on, and its active-session gauges are cleared.
+ *
+ * Readers sum the shards. Setting $CLI_GAMES_METRICS starts a background
+ * exporter that publishes the sums in Prometheus text format, either on
+ * a Unix socket ("unix:/path/metrics.sock", served as HTTP to each
+ * connection) or by rewriting a plain file every few seconds.
+ *
+ * Falls back to per-process shards when the file cannot be mapped (and
+ * always on Windows, where the exporter is not available).
+ */
+
+#define METRICS_MAX_SHARDS 128
+#define METRICS_BUCKETS 24              // Powers of two, then +Inf
+#define METRICS_EXPORT_INTERVAL_MS 5000
+
+// Menu order: the id of a game is its menu number minus one
+typedef enum {
+    METRICS_ROCK_PAPER_SCISSORS,
+    METRICS_GUESS_NUMBER,
+    METRICS_TIC_TAC_TOE,
+    METRICS_HANGMAN,
+    METRICS_WORD_SCRAMBLE,
+    METRICS_COIN_FLIP,
+    METRICS_BLACKJACK,
+    METRICS_BULLS_AND_COWS,
+    METRICS_ASCII_RACING,
+    METRICS_2048,
+    METRICS_SNAKE,
+    METRICS_SLOT_MACHINE,
+    METRICS_MINESWEEPER,
+    METRICS_F1_REACTION,
+    METRICS_SPACE_INVADERS,
+    METRICS_SIMON_SAYS,
+    METRICS_FLAPPY_BIRD,
+    METRICS_DINO_RUNNER,
+    METRICS_RUSSIAN_ROULETTE,
+    METRICS_SLIDING_PUZZLE,
+    METRICS_YAHTZEE,
+    METRICS_TEXAS_HOLDEM,
+    METRICS_RATING_LADDER,
+    METRICS_WORDLE,
+    METRICS_TETRIS,
+    METRICS_GAME_COUNT = 32
+} MetricsGame;
+
+typedef enum {
+    METRICS_TICK_US,                    // Work done per real-time frame
+    METRICS_FRAME_BYTES,                // Bytes written per redraw
+    METRICS_INPUT_LATENCY_US,           // Input delivered to input handled
+    METRICS_STATS_WRITE_US,             // Saving a stats, log or trace file
+    METRICS_HISTOGRAM_COUNT
+} MetricsHistogram;
+
+int metrics_open(void);                 // Returns 1 when the shared shards are mapped
+void metrics_close(void);
+
+// Active-session gauge and session counter for one game
+void metrics_session_begin(MetricsGame game);
+void metrics_session_end(MetricsGame game);
+
+void metrics_observe(MetricsHistogram histogram, uint64_t value);
+
+// Writes every metric in Prometheus text format; returns the length, or
+// the length it would have needed when size is too small
+size_t metrics_render(char* out, size_t size);
+
+// Starts the exporter named by $CLI_GAMES_METRICS; returns 1 if one started
+int metrics_export_start(void);
+void metrics_export_stop(void);
+
+#endif // METRICS_H
@@ -0,0 +1,245 @@
+/*
+ * Minesweeper Click Logs
+ * Part of CLI Games Pack v2.1
+ *
+ * Record layout (all counts are LEB128 varints):
+ *
+ *   0xB5, body length,
+ *   topology, width, height, depth (one byte each),
+ *   mine count, flags (one byte: bit 0 won, bit 1 daily board),
+ *   elapsed ms, click count,
+ *   mine bitmap (one bit per cell, cell 0 in bit 0 of the first byte),
+ *   clicks: (cell << 1 | flag), gap in ms
+ *
+ * The leading length lets a reader skip a record it cannot replay and
+ * still find the next one; a record cut short by a crash ends the log.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "mine_log.h"
+#include "highscores.h"
+#include "ratings.h"
+
+#define RECORD_MAGIC 0xB5
+#define MAX_VARINT_BYTES 5
+
+static uint8_t* put_varint(uint8_t* out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+// Returns 0 when the varint runs past end or does not fit 32 bits
+static int get_varint(const uint8_t** in, const uint8_t* end, uint32_t* value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && *in < end; shift += 7) {
+        uint8_t byte = *(*in)++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void mine_log_begin(MineLogRecorder* recorder) {
+    recorder->length = 0;
+    recorder->click_count = 0;
+    recorder->last_ms = 0;
+    recorder->elapsed_ms = 0;
+    recorder->truncated = 0;
+}
+
+void mine_log_click(MineLogRecorder* recorder, int cell, int flag, uint64_t now_ms) {
+    if (recorder->truncated) return;
+    if (recorder->click_count == MINE_LOG_MAX_CLICKS ||
+        recorder->length + 2 * MAX_VARINT_BYTES > MINE_LOG_MAX_BYTES) {
+        recorder->truncated = 1;
+        return;
+    }
+
+    uint32_t gap = recorder->click_count ? (uint32_t)(now_ms - recorder->last_ms) : 0;
+    uint8_t* out = recorder->clicks + recorder->length;
+    out = put_varint(out, (uint32_t)cell << 1 | (flag ? 1 : 0));
+    out = put_varint(out, gap);
+    recorder->length = (uint32_t)(out - recorder->clicks);
+    recorder->click_count++;
+    recorder->last_ms = now_ms;
+    recorder->elapsed_ms += gap;
+}
+
+int mine_log_3bv(const GridNeighbors* grid, const unsigned char* mines, const unsigned char* numbers,
+                 unsigned char* scratch) {
+    int bv = 0;
+
+    // Mines start out "flagged" so the flood never opens them
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        scratch[cell] = mines[cell] ? 2 : 0;
+    }
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        if (scratch[cell] == 0 && numbers[cell] == 0) {
+            grid_flood_reveal(grid, cell, numbers, scratch, NULL);
+            bv++;
+        }
+    }
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        bv += scratch[cell] == 0;
+    }
+    return bv;
+}
+
+size_t mine_log_encode(const MineLogRecorder* recorder, const GridNeighbors* grid,
+                       const unsigned char* mines, int mine_count, int won, int daily, uint8_t* out,
+                       size_t size) {
+    uint8_t body[MINE_LOG_MAX_RECORD];
+    uint8_t* p = body;
+    int bitmap_bytes = (grid->cell_count + 7) / 8;
+
+    if (recorder->truncated) return 0;
+    *p++ = (uint8_t)grid->topology;
+    *p++ = (uint8_t)grid->width;
+    *p++ = (uint8_t)grid->height;
+    *p++ = (uint8_t)grid->depth;
+    p = put_varint(p, (uint32_t)mine_count);
+    *p++ = (uint8_t)((won ? 1 : 0) | (daily ? 2 : 0));
+    p = put_varint(p, recorder->elapsed_ms);
+    p = put_varint(p, recorder->click_count);
+    memset(p, 0, (size_t)bitmap_bytes);
+    for (int cell = 0; cell < grid->cell_count; cell++) {
+        if (mines[cell]) p[cell >> 3] |= (uint8_t)(1 << (cell & 7));
+    }
+    p += bitmap_bytes;
+    memcpy(p, recorder->clicks, recorder->length);
+    p += recorder->length;
+
+    size_t body_length = (size_t)(p - body);
+    uint8_t prefix[1 + MAX_VARINT_BYTES];
+    prefix[0] = RECORD_MAGIC;
+    size_t prefix_length = (size_t)(put_varint(prefix + 1, (uint32_t)body_length) - prefix);
+    if (prefix_length + body_length > size) return 0;
+    memcpy(out, prefix, prefix_length);
+    memcpy(out + prefix_length, body, body_length);
+    return prefix_length + body_length;
+}
+
+// Neighbour table for the record's board, built on first sight of its shape
+static const GridNeighbors* shape_table(MineLogVerifier* verifier, const MineLogGame* game) {
+    for (int i = 0; i < verifier->built; i++) {
+        const GridNeighbors* grid = &verifier->grids[i];
+        if (grid->topology == (GridTopology)game->topology && grid->width == game->width &&
+            grid->height == game->height && grid->depth == game->depth) {
+            return grid;
+        }
+    }
+
+    GridNeighbors* grid = &verifier->grids[verifier->next];
+    if (grid_build_neighbors(grid, (GridTopology)game->topology, game->width, game->height, game->depth) != 0) {
+        return NULL;
+    }
+    verifier->next = (verifier->next + 1) % MINE_LOG_SHAPES;
+    if (verifier->built < MINE_LOG_SHAPES) verifier->built++;
+    return grid;
+}
+
+size_t mine_log_verify(MineLogVerifier* verifier, const uint8_t* data, size_t size, MineLogGame* game) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint32_t body_length, mine_count, elapsed_ms, click_count;
+
+    memset(game, 0, sizeof(*game));
+    if (size < 2 || *p++ != RECORD_MAGIC || !get_varint(&p, end, &body_length) ||
+        body_length > (size_t)(end - p)) {
+        return 0;
+    }
+    end = p + body_length;
+    size_t record_length = (size_t)(end - data);
+
+    // From here on a bad record is still skippable: it is just not valid
+    if (end - p < 4) return record_length;
+    game->topology = p[0];
+    game->width = p[1];
+    game->height = p[2];
+    game->depth = p[3];
+    p += 4;
+    if (!get_varint(&p, end, &mine_count) || p >= end) return record_length;
+    game->won = *p & 1;
+    game->daily = (*p++ >> 1) & 1;
+    if (!get_varint(&p, end, &elapsed_ms) || !get_varint(&p, end, &click_count)) return record_length;
+    game->mine_count = (int)mine_count;
+    game->elapsed_ms = elapsed_ms;
+    game->clicks = click_count;
+
+    if (game->topology >= GRID_TOPOLOGY_COUNT) return record_length;
+    const GridNeighbors* grid = shape_table(verifier, game);
+    if (!grid) return record_length;
+
+    int cells = grid->cell_count;
+    int bitmap_bytes = (cells + 7) / 8;
+    if (end - p < bitmap_bytes) return record_length;
+    unsigned char mines[GRID_MAX_CELLS], numbers[GRID_MAX_CELLS], state[GRID_MAX_CELLS];
+    unsigned short mine_cells[GRID_MAX_CELLS];
+    int mines_found = 0;
+    for (int byte = 0; byte < bitmap_bytes; byte++) {
+        for (unsigned bits = p[byte]; bits; bits &= bits - 1) {
+            int cell = byte * 8 + __builtin_ctz(bits);
+            if (cell >= cells) return record_length;
+            mine_cells[mines_found++] = (unsigned short)cell;
+        }
+    }
+    p += bitmap_bytes;
+    if (mines_found != game->mine_count || mines_found >= cells) return record_length;
+
+    // Numbers are scattered from the mines, which are a small part of the board
+    memset(mines, 0, (size_t)cells);
+    memset(numbers, 0, (size_t)cells);
+    for (int i = 0; i < mines_found; i++) {
+        int mine = mine_cells[i];
+        mines[mine] = 1;
+        for (int k = grid->neighbor_start[mine]; k < grid->neighbor_start[mine + 1]; k++) {
+            numbers[grid->neighbors[k]]++;
+        }
+    }
+    game->bv = mine_log_3bv(grid, mines, numbers, state);
+
+    // Replay: the game must end exactly on the last click
+    memset(state, 0, (size_t)cells);
+    int safe_left = cells - mines_found;
+    int over = 0, won = 0;
+    uint32_t clock_ms = 0;
+    for (uint32_t i = 0; i < click_count; i++) {
+        uint32_t action, gap;
+        if (over || !get_varint(&p, end, &action) || !get_varint(&p, end, &gap)) return record_length;
+        int cell = (int)(action >> 1);
+        if (cell >= cells) return record_length;
+        clock_ms += gap;
+
+        if (action & 1) {
+            if (state[cell] != 1) state[cell] = state[cell] == 2 ? 0 : 2;
+        } else if (state[cell] == 0) {
+            if (mines[cell]) {
+                over = 1;
+            } else {
+                safe_left -= grid_flood_reveal(grid, cell, numbers, state, NULL);
+                over = won = safe_left == 0;
+            }
+        }
+    }
+    game->valid = p == end && over && won == game->won && clock_ms == game->elapsed_ms;
+    return record_length;
+}
+
+int mine_log_path(char* path, int size) {
+    char file_name[64], key[41];
+    ratings_local_file_key(key, sizeof(key));
+    snprintf(file_name, sizeof(file_name), "minesweeper_%s.log", key);
+    highscore_open();
+    return highscore_shared_path(file_name, path, size);
+}
@@ -0,0 +1,83 @@
+#ifndef MINE_LOG_H
+#define MINE_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "grid_topology.h"
+
+/*
+ * Minesweeper click logs, board difficulty and replay verification.
+ *
+ * Every finished game is appended to the player's log as one compact
+ * record: the board shape, the mine bitmap, the claimed result and time,
+ * then one entry per click. A click is two varints, (cell << 1 | flag)
+ * and the milliseconds since the previous click, so a typical click
+ * costs three bytes. The clock starts at the first click, and the claimed
+ * time is the sum of the gaps.
+ *
+ * Verification needs nothing but the record: it rebuilds the board,
+ * replays the clicks and checks that they really end the game with the
+ * claimed result at the claimed time. It cannot tell whether the gaps
+ * were measured honestly, only that the log is self-consistent.
+ *
+ * 3BV (Bechtel's Board Benchmark Value) is the fewest clicks that clear
+ * a board: one per opening (connected region of zero cells, revealed
+ * with its border) plus one per numbered cell outside every opening.
+ */
+
+#define MINE_LOG_MAX_CLICKS 4096
+#define MINE_LOG_MAX_BYTES (MINE_LOG_MAX_CLICKS * 6)    // Two varints per click
+#define MINE_LOG_MAX_RECORD (64 + GRID_MAX_CELLS / 8 + MINE_LOG_MAX_BYTES)
+
+typedef struct {
+    uint8_t clicks[MINE_LOG_MAX_BYTES];
+    uint32_t length;
+    uint32_t click_count;
+    uint64_t last_ms;                   // Time of the previous click
+    uint32_t elapsed_ms;                // Sum of the gaps so far
+    int truncated;                      // Ran out of room; the record is not saved
+} MineLogRecorder;
+
+// One record as decoded and replayed by the verifier
+typedef struct {
+    int topology, width, height, depth;
+    int mine_count;
+    int won;                            // Claimed result
+    int daily;                          // A daily board, not one of the presets
+    uint32_t elapsed_ms;                // Claimed time
+    uint32_t clicks;
+    int bv;                             // 3BV of the board
+    int valid;                          // The replay agrees with the claims
+} MineLogGame;
+
+#define MINE_LOG_SHAPES 4
+
+// Keeps the neighbour tables of recent board shapes between records
+typedef struct {
+    GridNeighbors grids[MINE_LOG_SHAPES];
+    int built;                          // Tables in use
+    int next;                           // Slot the next new shape replaces
+} MineLogVerifier;
+
+void mine_log_begin(MineLogRecorder* recorder);
+void mine_log_click(MineLogRecorder* recorder, int cell, int flag, uint64_t now_ms);
+
+// 3BV in one linear pass: each opening is flood-labelled once, then every
+// unlabelled safe cell counts one. scratch needs grid->cell_count bytes.
+int mine_log_3bv(const GridNeighbors* grid, const unsigned char* mines, const unsigned char* numbers,
+                 unsigned char* scratch);
+
+// Encodes a finished game, daily set for a daily board; returns the record
+// length, or 0 if it does not fit
+size_t mine_log_encode(const MineLogRecorder* recorder, const GridNeighbors* grid,
+                       const unsigned char* mines, int mine_count, int won, int daily, uint8_t* out,
+                       size_t size);
+
+// Decodes and replays the record at data. Returns its length, or 0 when
+// the bytes are not a well-formed record (the rest of the log is unusable).
+size_t mine_log_verify(MineLogVerifier* verifier, const uint8_t* data, size_t size, MineLogGame* game);
+
+// Player's log in the shared directory
+int mine_log_path(char* path, int size);
+
+#endif // MINE_LOG_H
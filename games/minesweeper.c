@@ -4,6 +4,15 @@
 #include <time.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include "daily.h"
+#include "grid_topology.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "mine_log.h"
+#include "ratings.h"
+#include "screen.h"
+#include "terminal.h"
+#include "write_behind.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -20,6 +29,8 @@
 #define MAX_HEIGHT 16
 #define MIN_WIDTH 5
 #define MIN_HEIGHT 5
+#define MAX_DEPTH 8
+#define MIN_DEPTH 3
 
 // Difficulty presets
 typedef enum {
@@ -46,18 +57,23 @@ typedef struct {
     int flags_placed;
     bool game_over;
     bool victory;
-    time_t start_time;
+    uint64_t start_ms;                      // Monotonic time of the first click
     int games_played;
     int games_won;
-    int best_time_beginner;
-    int best_time_intermediate;
-    int best_time_expert;
+    uint32_t best_ms[3];                    // Per preset difficulty, 0 = none yet
+    uint32_t best_rate[3];                  // Best 3BV/s, in thousandths
+    int bv;                                 // 3BV of the finished board
     
-    // Grid data
-    bool mines[MAX_HEIGHT][MAX_WIDTH];
-    CellState state[MAX_HEIGHT][MAX_WIDTH];
-    int numbers[MAX_HEIGHT][MAX_WIDTH];
+    // Board data: flat cell arrays indexed through the neighbour table
+    GridTopology topology;
+    int depth;
+    GridNeighbors grid;
+    unsigned char mines[GRID_MAX_CELLS];
+    unsigned char state[GRID_MAX_CELLS];    // CellState values
+    unsigned char numbers[GRID_MAX_CELLS];
     bool first_click;
+    char daily_date[16];                    // Set while playing a daily board
+    MineLogRecorder log;                    // Clicks of the current game
 } MinesweeperGame;
 
 // Global game instance
@@ -66,55 +82,89 @@ static MinesweeperGame game;
 // Function declarations
 void init_minesweeper(void);
 void setup_difficulty(Difficulty diff);
-void generate_mines(int start_row, int start_col);
+bool reset_board(void);
+void generate_mines(int start_cell);
 void calculate_numbers(void);
-int count_adjacent_mines(int row, int col);
+int count_adjacent_mines(int cell);
 void display_game(void);
 void display_minesweeper_instructions(void);
 void display_minesweeper_statistics(void);
-char get_cell_display(int row, int col);
-bool is_valid_position(int row, int col);
-void reveal_cell(int row, int col);
-void reveal_adjacent_cells(int row, int col);
-void toggle_flag(int row, int col);
+char get_cell_display(int cell);
+bool is_valid_position(int row, int col, int layer);
+void reveal_cell(int cell);
+void toggle_flag(int cell);
 bool check_victory(void);
 void game_over_sequence(bool won);
 void play_game_loop(void);
-bool parse_input(char* input, int* row, int* col, char* action);
+bool parse_input(char* input, int* cell, char* action);
+void select_topology(void);
+void play_daily_minesweeper(void);
 void minesweeper_clear_input_buffer(void);
+void minesweeper_save_statistics(void);
+void minesweeper_load_statistics(void);
 
 // Initialize the minesweeper game
 void init_minesweeper(void) {
     memset(&game, 0, sizeof(MinesweeperGame));
     game.first_click = true;
-    game.best_time_beginner = -1;
-    game.best_time_intermediate = -1;
-    game.best_time_expert = -1;
+    minesweeper_load_statistics();
+}
+
+static uint64_t now_ms(void) {
+    return terminal_now_us() / 1000;
+}
+
+// Index into best_ms for the classic square presets, or -1. A daily board
+// is the same for everyone that day, so it never counts toward a preset.
+static int preset_index(void) {
+    if (game.topology != GRID_SQUARE || game.daily_date[0]) return -1;
+    if (game.width == 9 && game.height == 9 && game.mine_count == 10) return DIFFICULTY_BEGINNER;
+    if (game.width == 16 && game.height == 16 && game.mine_count == 40) return DIFFICULTY_INTERMEDIATE;
+    if (game.width == 30 && game.height == 16 && game.mine_count == 99) return DIFFICULTY_EXPERT;
+    return -1;
 }
 
 // Setup game based on difficulty
 void setup_difficulty(Difficulty diff) {
+    // 3D boards grow in depth instead of width so every layer fits on screen
+    bool cube = (game.topology == GRID_CUBE);
+    
     switch (diff) {
         case DIFFICULTY_BEGINNER:
-            game.width = 9;
-            game.height = 9;
-            game.mine_count = 10;
+            game.width = cube ? 4 : 9;
+            game.height = cube ? 4 : 9;
+            game.depth = cube ? 4 : 1;
+            game.mine_count = cube ? 6 : 10;
             break;
         case DIFFICULTY_INTERMEDIATE:
-            game.width = 16;
-            game.height = 16;
-            game.mine_count = 40;
+            game.width = cube ? 6 : 16;
+            game.height = cube ? 6 : 16;
+            game.depth = cube ? 6 : 1;
+            game.mine_count = cube ? 24 : 40;
             break;
         case DIFFICULTY_EXPERT:
-            game.width = 30;
-            game.height = 16;
-            game.mine_count = 99;
+            game.width = cube ? 8 : 30;
+            game.height = cube ? 8 : 16;
+            game.depth = cube ? 8 : 1;
+            game.mine_count = cube ? 60 : 99;
             break;
         case DIFFICULTY_CUSTOM:
             // Custom settings will be handled separately
             break;
     }
     
+    reset_board();
+}
+
+// Build the neighbour table for the current shape and clear all cells
+bool reset_board(void) {
+    if (game.topology != GRID_CUBE) {
+        game.depth = 1;
+    }
+    if (grid_build_neighbors(&game.grid, game.topology, game.width, game.height, game.depth) != 0) {
+        return false;
+    }
+    
     // Initialize game state
     game.revealed_count = 0;
     game.flag_count = game.mine_count;
@@ -122,32 +172,31 @@ void setup_difficulty(Difficulty diff) {
     game.game_over = false;
     game.victory = false;
     game.first_click = true;
+    game.daily_date[0] = '\0';
+    game.bv = 0;
+    mine_log_begin(&game.log);
     
     // Clear grids
-    for (int i = 0; i < game.height; i++) {
-        for (int j = 0; j < game.width; j++) {
-            game.mines[i][j] = false;
-            game.state[i][j] = CELL_HIDDEN;
-            game.numbers[i][j] = 0;
-        }
-    }
+    memset(game.mines, 0, sizeof(game.mines));
+    memset(game.state, CELL_HIDDEN, sizeof(game.state));
+    memset(game.numbers, 0, sizeof(game.numbers));
+    return true;
 }
 
 // Generate mines randomly, avoiding the first click position
-void generate_mines(int start_row, int start_col) {
+void generate_mines(int start_cell) {
     srand(time(NULL));
     int mines_placed = 0;
     
     while (mines_placed < game.mine_count) {
-        int row = rand() % game.height;
-        int col = rand() % game.width;
+        int cell = rand() % game.grid.cell_count;
         
         // Don't place mine on first click or if already has mine
-        if ((row == start_row && col == start_col) || game.mines[row][col]) {
+        if (cell == start_cell || game.mines[cell]) {
             continue;
         }
         
-        game.mines[row][col] = true;
+        game.mines[cell] = 1;
         mines_placed++;
     }
     
@@ -156,108 +205,127 @@ void generate_mines(int start_row, int start_col) {
 
 // Calculate number of adjacent mines for each cell
 void calculate_numbers(void) {
-    for (int i = 0; i < game.height; i++) {
-        for (int j = 0; j < game.width; j++) {
-            if (!game.mines[i][j]) {
-                game.numbers[i][j] = count_adjacent_mines(i, j);
-            }
-        }
-    }
+    grid_count_adjacent(&game.grid, game.mines, game.numbers);
 }
 
-// Count mines adjacent to a position
-int count_adjacent_mines(int row, int col) {
+// Count mines adjacent to a cell
+int count_adjacent_mines(int cell) {
     int count = 0;
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            if (dr == 0 && dc == 0) continue;
-            int nr = row + dr;
-            int nc = col + dc;
-            if (is_valid_position(nr, nc) && game.mines[nr][nc]) {
-                count++;
-            }
-        }
+    for (int k = game.grid.neighbor_start[cell]; k < game.grid.neighbor_start[cell + 1]; k++) {
+        count += game.mines[game.grid.neighbors[k]];
     }
     return count;
 }
 
 // Check if position is within grid bounds
-bool is_valid_position(int row, int col) {
-    return row >= 0 && row < game.height && col >= 0 && col < game.width;
+bool is_valid_position(int row, int col, int layer) {
+    return row >= 0 && row < game.height && col >= 0 && col < game.width &&
+           layer >= 0 && layer < game.depth;
 }
 
 // Get display character for a cell
-char get_cell_display(int row, int col) {
-    if (game.state[row][col] == CELL_FLAGGED) {
+char get_cell_display(int cell) {
+    if (game.state[cell] == CELL_FLAGGED) {
         return 'F';
-    } else if (game.state[row][col] == CELL_HIDDEN) {
+    } else if (game.state[cell] == CELL_HIDDEN) {
         return '.';
-    } else if (game.mines[row][col]) {
+    } else if (game.mines[cell]) {
         return '*';
-    } else if (game.numbers[row][col] == 0) {
+    } else if (game.numbers[cell] == 0) {
         return ' ';
+    } else if (game.numbers[cell] < 10) {
+        return '0' + game.numbers[cell];
     } else {
-        return '0' + game.numbers[row][col];
+        return 'A' + game.numbers[cell] - 10; // 3D cells can have up to 26 neighbours
     }
 }
 
-// Display the game board
+// Compose the game board and bring the terminal up to date
 void display_game(void) {
-    CLEAR_SCREEN();
-    
-    printf("\n+==========================================+\n");
-    printf("|            MINESWEEPER v1.0              |\n");
-    printf("+==========================================+\n");
+    screen_begin();
+    screen_printf("\n+==========================================+\n");
+    screen_printf("|            MINESWEEPER v1.0              |\n");
+    screen_printf("+==========================================+\n");
     
     // Game statistics
-    int elapsed = game.first_click ? 0 : (int)(time(NULL) - game.start_time);
-    printf("| Mines: %-3d  Flags: %-3d  Time: %02d:%02d    |\n", 
+    uint32_t elapsed_ms = game.first_click ? 0 :
+                          game.game_over ? game.log.elapsed_ms : (uint32_t)(now_ms() - game.start_ms);
+    int elapsed = (int)(elapsed_ms / 1000);
+    screen_printf("| Mines: %-3d  Flags: %-3d  Time: %02d:%02d    |\n", 
            game.mine_count, game.flags_placed, elapsed / 60, elapsed % 60);
-    printf("| Size: %dx%-2d  Remaining: %-3d            |\n", 
-           game.width, game.height, game.flag_count - game.flags_placed);
-    printf("+==========================================+\n\n");
-    
-    // Column headers
-    printf("     ");
-    for (int j = 0; j < game.width; j++) {
-        printf("%c ", 'A' + j);
+    if (game.topology == GRID_CUBE) {
+        screen_printf("| Size: %dx%dx%-2d  Remaining: %-3d          |\n", 
+               game.width, game.height, game.depth, game.flag_count - game.flags_placed);
+    } else {
+        screen_printf("| Size: %dx%-2d  Remaining: %-3d            |\n", 
+               game.width, game.height, game.flag_count - game.flags_placed);
     }
-    printf("\n");
-    
-    printf("   +");
-    for (int j = 0; j < game.width; j++) {
-        printf("--");
+    screen_printf("| Shape: %-34s|\n", grid_topology_name(game.topology));
+    if (game.daily_date[0]) {
+        screen_printf("| Daily challenge %-10s (no guessing) |\n", game.daily_date);
     }
-    printf("+\n");
+    screen_printf("+==========================================+\n");
     
-    // Game grid
-    for (int i = 0; i < game.height; i++) {
-        printf("%2d |", i + 1);
+    for (int layer = 0; layer < game.depth; layer++) {
+        if (game.topology == GRID_CUBE) {
+            screen_printf("\n   Layer %d\n", layer + 1);
+        } else {
+            screen_printf("\n");
+        }
+        
+        // Column headers
+        screen_printf("     ");
         for (int j = 0; j < game.width; j++) {
-            printf("%c ", get_cell_display(i, j));
+            screen_printf("%c ", 'A' + j);
         }
-        printf("|\n");
-    }
-    
-    printf("   +");
-    for (int j = 0; j < game.width; j++) {
-        printf("--");
+        screen_printf("\n");
+        
+        screen_printf("   +");
+        for (int j = 0; j < game.width; j++) {
+            screen_printf("--");
+        }
+        screen_printf("%s+\n", (game.topology == GRID_HEX) ? "-" : "");
+        
+        // Game grid (hex boards shift odd rows half a cell right)
+        for (int i = 0; i < game.height; i++) {
+            bool shifted = (game.topology == GRID_HEX && (i & 1));
+            screen_printf("%2d |%s", i + 1, shifted ? " " : "");
+            for (int j = 0; j < game.width; j++) {
+                screen_printf("%c ", get_cell_display((layer * game.height + i) * game.width + j));
+            }
+            screen_printf("%s|\n", (game.topology == GRID_HEX && !shifted) ? " " : "");
+        }
+        
+        screen_printf("   +");
+        for (int j = 0; j < game.width; j++) {
+            screen_printf("--");
+        }
+        screen_printf("%s+\n", (game.topology == GRID_HEX) ? "-" : "");
     }
-    printf("+\n");
     
     // Game status
     if (game.game_over) {
         if (game.victory) {
-            printf("\n*** CONGRATULATIONS! YOU WON! ***\n");
-            printf("All mines found in %02d:%02d!\n", elapsed / 60, elapsed % 60);
+            screen_printf("\n*** CONGRATULATIONS! YOU WON! ***\n");
+            screen_printf("All mines found in %02d:%02d.%03u!\n", elapsed / 60, elapsed % 60,
+                          (unsigned)(elapsed_ms % 1000));
+            screen_printf("3BV: %d  3BV/s: %.2f  Clicks: %u\n", game.bv,
+                          elapsed_ms ? game.bv * 1000.0 / elapsed_ms : 0.0, (unsigned)game.log.click_count);
         } else {
-            printf("\n*** GAME OVER! ***\n");
-            printf("You hit a mine! Better luck next time.\n");
+            screen_printf("\n*** GAME OVER! ***\n");
+            screen_printf("You hit a mine! Better luck next time.\n");
         }
     } else {
-        printf("\nCommands: R A1 (reveal), F A1 (flag), H (help), Q (quit)\n");
-        printf("Enter command: ");
+        if (game.topology == GRID_CUBE) {
+            screen_printf("\nCommands: R A1 2 or RA1:2 (reveal A1 on layer 2), F A1 2 (flag), H (help), Q (quit)\n");
+        } else {
+            screen_printf("\nCommands: R A1 (reveal), F A1 (flag), H (help), Q (quit)\n");
+        }
+        screen_printf("Enter command: ");
     }
+    
+    // Only the cells that changed since the last frame are sent
+    screen_present();
 }
 
 // Display game instructions
@@ -287,6 +355,13 @@ void display_minesweeper_instructions(void) {
     printf("| Intermediate: 16x16, 40 mines\n");
     printf("| Expert:       30x16, 99 mines\n");
     printf("|\n");
+    printf("| BOARD SHAPES:\n");
+    printf("| Square:    classic 8 neighbours\n");
+    printf("| Hexagonal: 6 neighbours, odd rows offset\n");
+    printf("| Torus:     edges wrap around\n");
+    printf("| 3D Cube:   26 neighbours across layers,\n");
+    printf("|            add the layer: R A1 2 or RA1:2\n");
+    printf("|\n");
     printf("| TIPS:\n");
     printf("| • First click is always safe\n");
     printf("| • Numbers reveal mine patterns\n");
@@ -313,21 +388,16 @@ void display_minesweeper_statistics(void) {
         printf("| Win Rate:     N/A\n");
     }
     printf("|\n");
-    printf("| BEST TIMES:\n");
-    if (game.best_time_beginner >= 0) {
-        printf("| Beginner:     %02d:%02d\n", game.best_time_beginner / 60, game.best_time_beginner % 60);
-    } else {
-        printf("| Beginner:     --:--\n");
-    }
-    if (game.best_time_intermediate >= 0) {
-        printf("| Intermediate: %02d:%02d\n", game.best_time_intermediate / 60, game.best_time_intermediate % 60);
-    } else {
-        printf("| Intermediate: --:--\n");
-    }
-    if (game.best_time_expert >= 0) {
-        printf("| Expert:       %02d:%02d\n", game.best_time_expert / 60, game.best_time_expert % 60);
-    } else {
-        printf("| Expert:       --:--\n");
+    printf("| BEST TIMES:               Best 3BV/s\n");
+    static const char* names[3] = {"Beginner:", "Intermediate:", "Expert:"};
+    for (int i = 0; i < 3; i++) {
+        uint32_t ms = game.best_ms[i];
+        if (ms > 0) {
+            printf("| %-13s %02u:%02u.%03u   %6.2f\n", names[i], (unsigned)(ms / 60000),
+                   (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000), game.best_rate[i] / 1000.0);
+        } else {
+            printf("| %-13s --:--.---      ---\n", names[i]);
+        }
     }
     printf("|\n");
     printf("+==========================================+\n");
@@ -336,32 +406,30 @@ void display_minesweeper_statistics(void) {
 }
 
 // Reveal a cell and handle cascading reveals
-void reveal_cell(int row, int col) {
-    if (!is_valid_position(row, col) || game.state[row][col] != CELL_HIDDEN) {
+void reveal_cell(int cell) {
+    if (game.state[cell] != CELL_HIDDEN) {
         return;
     }
     
-    // Handle first click
+    // Handle first click: the clock starts here
+    uint64_t now = now_ms();
     if (game.first_click) {
-        generate_mines(row, col);
-        game.start_time = time(NULL);
+        generate_mines(cell);
+        game.start_ms = now;
         game.first_click = false;
     }
-    
-    game.state[row][col] = CELL_REVEALED;
-    game.revealed_count++;
+    mine_log_click(&game.log, cell, 0, now);
     
     // Check if hit a mine
-    if (game.mines[row][col]) {
-        game.game_over = true;
-        game.victory = false;
+    if (game.mines[cell]) {
+        game.state[cell] = CELL_REVEALED;
+        game.revealed_count++;
+        game_over_sequence(false);
         return;
     }
     
-    // If cell has no adjacent mines, reveal surrounding cells
-    if (game.numbers[row][col] == 0) {
-        reveal_adjacent_cells(row, col);
-    }
+    // Zero cells cascade through the neighbour table
+    game.revealed_count += grid_flood_reveal(&game.grid, cell, game.numbers, game.state, NULL);
     
     // Check for victory
     if (check_victory()) {
@@ -369,38 +437,28 @@ void reveal_cell(int row, int col) {
     }
 }
 
-// Reveal all adjacent cells (for auto-reveal)
-void reveal_adjacent_cells(int row, int col) {
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            if (dr == 0 && dc == 0) continue;
-            int nr = row + dr;
-            int nc = col + dc;
-            if (is_valid_position(nr, nc) && game.state[nr][nc] == CELL_HIDDEN) {
-                reveal_cell(nr, nc);
-            }
-        }
-    }
-}
-
 // Toggle flag on a cell
-void toggle_flag(int row, int col) {
-    if (!is_valid_position(row, col) || game.state[row][col] == CELL_REVEALED) {
+void toggle_flag(int cell) {
+    // Nothing can be deduced before the first reveal starts the clock
+    if (game.first_click || game.state[cell] == CELL_REVEALED) {
         return;
     }
     
-    if (game.state[row][col] == CELL_FLAGGED) {
-        game.state[row][col] = CELL_HIDDEN;
+    if (game.state[cell] == CELL_FLAGGED) {
+        game.state[cell] = CELL_HIDDEN;
         game.flags_placed--;
     } else if (game.flags_placed < game.mine_count) {
-        game.state[row][col] = CELL_FLAGGED;
+        game.state[cell] = CELL_FLAGGED;
         game.flags_placed++;
+    } else {
+        return;
     }
+    mine_log_click(&game.log, cell, 1, now_ms());
 }
 
 // Check if player has won
 bool check_victory(void) {
-    int non_mine_cells = game.width * game.height - game.mine_count;
+    int non_mine_cells = game.grid.cell_count - game.mine_count;
     return game.revealed_count == non_mine_cells;
 }
 
@@ -410,38 +468,47 @@ void game_over_sequence(bool won) {
     game.victory = won;
     game.games_played++;
     
+    // The time is the sum of the logged click gaps, as the verifier sees it
+    unsigned char scratch[GRID_MAX_CELLS];
+    uint32_t elapsed_ms = game.log.elapsed_ms;
+    game.bv = mine_log_3bv(&game.grid, game.mines, game.numbers, scratch);
+    
     if (won) {
         game.games_won++;
-        int elapsed = (int)(time(NULL) - game.start_time);
         
-        // Update best times
-        if (game.width == 9 && game.height == 9) { // Beginner
-            if (game.best_time_beginner < 0 || elapsed < game.best_time_beginner) {
-                game.best_time_beginner = elapsed;
+        // Update best times (classic presets only; other shapes have no standard to compare against)
+        int preset = preset_index();
+        uint32_t rate = elapsed_ms ? (uint32_t)(game.bv * 1000000ull / elapsed_ms) : 0;
+        if (preset >= 0) {
+            if (game.best_ms[preset] == 0 || elapsed_ms < game.best_ms[preset]) {
+                game.best_ms[preset] = elapsed_ms > 0 ? elapsed_ms : 1;
             }
-        } else if (game.width == 16 && game.height == 16) { // Intermediate
-            if (game.best_time_intermediate < 0 || elapsed < game.best_time_intermediate) {
-                game.best_time_intermediate = elapsed;
-            }
-        } else if (game.width == 30 && game.height == 16) { // Expert
-            if (game.best_time_expert < 0 || elapsed < game.best_time_expert) {
-                game.best_time_expert = elapsed;
+            if (rate > game.best_rate[preset]) {
+                game.best_rate[preset] = rate;
             }
         }
     }
     
+    // Append the game to the player's click log
+    uint8_t record[MINE_LOG_MAX_RECORD];
+    char path[512];
+    size_t length = mine_log_encode(&game.log, &game.grid, game.mines, game.mine_count, won,
+                                    game.daily_date[0] != '\0', record, sizeof(record));
+    if (length > 0 && mine_log_path(path, sizeof(path))) {
+        write_behind_append(path, record, length);
+    }
+    minesweeper_save_statistics();
+    
     // Reveal all mines
-    for (int i = 0; i < game.height; i++) {
-        for (int j = 0; j < game.width; j++) {
-            if (game.mines[i][j]) {
-                game.state[i][j] = CELL_REVEALED;
-            }
+    for (int cell = 0; cell < game.grid.cell_count; cell++) {
+        if (game.mines[cell]) {
+            game.state[cell] = CELL_REVEALED;
         }
     }
 }
 
 // Parse user input
-bool parse_input(char* input, int* row, int* col, char* action) {
+bool parse_input(char* input, int* cell, char* action) {
     // Remove newline if present
     char* newline = strchr(input, '\n');
     if (newline) *newline = '\0';
@@ -461,26 +528,34 @@ bool parse_input(char* input, int* row, int* col, char* action) {
     if (strlen(input) >= 3 && (input[0] == 'R' || input[0] == 'F')) {
         *action = input[0];
         
-        // Find column letter and row number
+        // Find column letter, row number and (3D only) layer number
         char col_char = 0;
         int row_num = 0;
+        int layer_num = 1;
+        char* rest = NULL;
         
-        // Parse format like "R A1" or "RA1"
+        // Parse format like "R A1" or "RA1"; cube boards add the layer
+        // the same way, "R A1 2" or "RA1:2"
         if (input[1] == ' ') {
             if (strlen(input) >= 4) {
                 col_char = input[2];
-                row_num = atoi(&input[3]);
+                row_num = (int)strtol(&input[3], &rest, 10);
             }
         } else {
             col_char = input[1];
-            row_num = atoi(&input[2]);
+            row_num = (int)strtol(&input[2], &rest, 10);
+        }
+        if (rest != NULL && game.topology == GRID_CUBE) {
+            if (*rest != ' ' && *rest != ':') return false;
+            char* end;
+            layer_num = (int)strtol(rest + 1, &end, 10);
+            if (end == rest + 1) return false;
         }
         
-        // Validate column and row
-        if (col_char >= 'A' && col_char < 'A' + game.width && 
-            row_num >= 1 && row_num <= game.height) {
-            *col = col_char - 'A';
-            *row = row_num - 1;
+        // Validate column, row and layer
+        int col = col_char - 'A';
+        if (is_valid_position(row_num - 1, col, layer_num - 1)) {
+            *cell = ((layer_num - 1) * game.height + (row_num - 1)) * game.width + col;
             return true;
         }
     }
@@ -497,9 +572,10 @@ void minesweeper_clear_input_buffer(void) {
 // Main game loop
 void play_game_loop(void) {
     char input[20];
-    int row, col;
+    int cell;
     char action;
     
+    screen_invalidate();
     while (!game.game_over) {
         display_game();
         
@@ -507,21 +583,23 @@ void play_game_loop(void) {
             break;
         }
         
-        if (parse_input(input, &row, &col, &action)) {
+        if (parse_input(input, &cell, &action)) {
             switch (action) {
                 case 'R':
-                    reveal_cell(row, col);
+                    reveal_cell(cell);
                     break;
                 case 'F':
-                    toggle_flag(row, col);
+                    toggle_flag(cell);
                     break;
                 case 'H':
                     display_minesweeper_instructions();
+                    screen_invalidate();
                     break;
                 case 'Q':
                     return;
                 case 'S':
                     display_minesweeper_statistics();
+                    screen_invalidate();
                     break;
             }
         } else {
@@ -536,6 +614,90 @@ void play_game_loop(void) {
     getchar();
 }
 
+// Choose the board shape used by the next game
+void select_topology(void) {
+    printf("\nBoard shapes:\n");
+    for (int i = 0; i < GRID_TOPOLOGY_COUNT; i++) {
+        printf("%d. %s\n", i + 1, grid_topology_name((GridTopology)i));
+    }
+    printf("Choice (1-%d): ", GRID_TOPOLOGY_COUNT);
+    
+    int choice;
+    if (scanf("%d", &choice) == 1 && choice >= 1 && choice <= GRID_TOPOLOGY_COUNT) {
+        game.topology = (GridTopology)(choice - 1);
+    }
+    minesweeper_clear_input_buffer();
+}
+
+// Today's shared board, solved ahead of time so it never needs a guess.
+// Everyone starts from the same opening, which is revealed for them.
+void play_daily_minesweeper(void) {
+    DailyChallenge daily;
+    GridTopology chosen = game.topology;
+    int today = daily_today();
+    
+    if (daily_load(today, &daily) == DAILY_PENDING) {
+        printf("\nToday's board is still being prepared - try again in a moment.\n");
+        Sleep(1500);
+        return;
+    }
+    game.topology = GRID_SQUARE;
+    game.width = DAILY_MINE_WIDTH;
+    game.height = DAILY_MINE_HEIGHT;
+    game.mine_count = DAILY_MINE_COUNT;
+    if (reset_board()) {
+        for (int cell = 0; cell < game.grid.cell_count; cell++) {
+            game.mines[cell] = (unsigned char)daily_is_mine(&daily, cell);
+        }
+        calculate_numbers();
+        daily_date(today, game.daily_date, sizeof(game.daily_date));
+        game.first_click = false;
+        game.start_ms = now_ms();
+        reveal_cell(daily.mine_start);
+        play_game_loop();
+    }
+    game.topology = chosen;
+}
+
+// Per-user stats file in the shared directory, next to the click log
+static int minesweeper_stats_path(char* path, int size) {
+    char file_name[64], key[41];
+    ratings_local_file_key(key, sizeof(key));
+    snprintf(file_name, sizeof(file_name), "minesweeper_stats_%s.dat", key);
+    highscore_open();
+    return highscore_shared_path(file_name, path, size);
+}
+
+void minesweeper_save_statistics(void) {
+    char path[512];
+    if (!minesweeper_stats_path(path, sizeof(path))) return;
+    WriteBehindPart parts[] = {
+        {&game.games_played, sizeof(int)},
+        {&game.games_won, sizeof(int)},
+        {game.best_ms, sizeof(uint32_t) * 3},
+        {game.best_rate, sizeof(uint32_t) * 3},
+    };
+    write_behind_replacev(path, parts, (int)(sizeof(parts) / sizeof(parts[0])));
+}
+
+void minesweeper_load_statistics(void) {
+    char path[512];
+    if (!minesweeper_stats_path(path, sizeof(path))) return;
+    FILE* file = fopen(path, "rb");
+    if (file) {
+        int played = 0, won = 0;
+        uint32_t best_ms[3], best_rate[3];
+        if (fread(&played, sizeof(int), 1, file) == 1 && fread(&won, sizeof(int), 1, file) == 1 &&
+            fread(best_ms, sizeof(uint32_t), 3, file) == 3 && fread(best_rate, sizeof(uint32_t), 3, file) == 3) {
+            game.games_played = played;
+            game.games_won = won;
+            memcpy(game.best_ms, best_ms, sizeof(best_ms));
+            memcpy(game.best_rate, best_rate, sizeof(best_rate));
+        }
+        fclose(file);
+    }
+}
+
 // Main minesweeper function
 void play_minesweeper(void) {
     init_minesweeper();
@@ -552,12 +714,14 @@ void play_minesweeper(void) {
         printf("| 2. Intermediate (16x16, 40 mines)       |\n");
         printf("| 3. Expert      (30x16, 99 mines)        |\n");
         printf("| 4. Custom      (Choose your own)        |\n");
-        printf("| 5. Statistics                            |\n");
-        printf("| 6. Instructions                          |\n");
-        printf("| 7. Return to Main Menu                   |\n");
+        printf("| 5. Daily Challenge (16x16, no guessing)  |\n");
+        printf("| 6. Board Shape (%-10s)              |\n", grid_topology_name(game.topology));
+        printf("| 7. Statistics                            |\n");
+        printf("| 8. Instructions                          |\n");
+        printf("| 9. Return to Main Menu                   |\n");
         printf("|\n");
         printf("+==========================================+\n");
-        printf("\nChoice (1-7): ");
+        printf("\nChoice (1-9): ");
         
         int choice;
         if (scanf("%d", &choice) != 1) {
@@ -579,22 +743,37 @@ void play_minesweeper(void) {
                 setup_difficulty(DIFFICULTY_EXPERT);
                 play_game_loop();
                 break;
-            case 4:
-                printf("Enter width (5-%d): ", MAX_WIDTH);
-                if (scanf("%d", &game.width) != 1 || game.width < MIN_WIDTH || game.width > MAX_WIDTH) {
+            case 4: {
+                bool cube = (game.topology == GRID_CUBE);
+                int min_side = cube ? MIN_DEPTH : MIN_WIDTH;
+                int max_width = cube ? MAX_DEPTH : MAX_WIDTH;
+                int max_height = cube ? MAX_DEPTH : MAX_HEIGHT;
+                
+                printf("Enter width (%d-%d): ", min_side, max_width);
+                if (scanf("%d", &game.width) != 1 || game.width < min_side || game.width > max_width) {
                     printf("Invalid width!\n");
                     minesweeper_clear_input_buffer();
                     Sleep(1000);
                     continue;
                 }
-                printf("Enter height (5-%d): ", MAX_HEIGHT);
-                if (scanf("%d", &game.height) != 1 || game.height < MIN_HEIGHT || game.height > MAX_HEIGHT) {
+                printf("Enter height (%d-%d): ", min_side, max_height);
+                if (scanf("%d", &game.height) != 1 || game.height < min_side || game.height > max_height) {
                     printf("Invalid height!\n");
                     minesweeper_clear_input_buffer();
                     Sleep(1000);
                     continue;
                 }
-                int max_mines = (game.width * game.height) / 4;
+                game.depth = 1;
+                if (cube) {
+                    printf("Enter layers (%d-%d): ", MIN_DEPTH, MAX_DEPTH);
+                    if (scanf("%d", &game.depth) != 1 || game.depth < MIN_DEPTH || game.depth > MAX_DEPTH) {
+                        printf("Invalid layer count!\n");
+                        minesweeper_clear_input_buffer();
+                        Sleep(1000);
+                        continue;
+                    }
+                }
+                int max_mines = (game.width * game.height * game.depth) / 4;
                 printf("Enter mine count (1-%d): ", max_mines);
                 if (scanf("%d", &game.mine_count) != 1 || game.mine_count < 1 || game.mine_count > max_mines) {
                     printf("Invalid mine count!\n");
@@ -604,31 +783,23 @@ void play_minesweeper(void) {
                 }
                 minesweeper_clear_input_buffer();
                 
-                game.revealed_count = 0;
-                game.flag_count = game.mine_count;
-                game.flags_placed = 0;
-                game.game_over = false;
-                game.victory = false;
-                game.first_click = true;
-                
-                // Clear grids
-                for (int i = 0; i < game.height; i++) {
-                    for (int j = 0; j < game.width; j++) {
-                        game.mines[i][j] = false;
-                        game.state[i][j] = CELL_HIDDEN;
-                        game.numbers[i][j] = 0;
-                    }
-                }
-                
+                reset_board();
                 play_game_loop();
                 break;
+            }
             case 5:
-                display_minesweeper_statistics();
+                play_daily_minesweeper();
                 break;
             case 6:
-                display_minesweeper_instructions();
+                select_topology();
                 break;
             case 7:
+                display_minesweeper_statistics();
+                break;
+            case 8:
+                display_minesweeper_instructions();
+                break;
+            case 9:
                 return;
             default:
                 printf("Invalid choice! Press Enter to continue...");
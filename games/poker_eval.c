@@ -0,0 +1,635 @@
+/*
+ * Poker Hand Evaluator - Lookup Table Edition
+ * Part of CLI Games Pack v2.1
+ *
+ * Evaluates 5, 6 and 7 card hands with two precomputed tables:
+ * - A flush table indexed by the 13-bit rank mask of the flush suit
+ * - A rank-multiset table indexed by a perfect hash of the rank counts
+ *
+ * The rank counts of a hand form a "quinary" (13 digits, each 0-4), kept
+ * as an additive base-5 key so adding a card is a single add. Every
+ * quinary with a given card total is ranked lexicographically (high ranks
+ * first), which gives a dense, collision-free index into the value table
+ * (49205 entries for 7 cards). The rank is split into a prefix offset for
+ * the six high ranks, which depends on the card total, and a suffix offset
+ * for the seven low ranks, which does not - so hashing a hand is one
+ * division by a constant and two small table lookups.
+ *
+ * Evaluating a hand is therefore a handful of adds, one flush test and
+ * three lookups - no sorting, no loops and no branching on hand type.
+ *
+ * Equity queries split their boards across a pool of worker threads that
+ * is started on the first query and then sleeps between queries, so an
+ * AI deciding every few seconds does not create and join threads each
+ * time. The calling thread runs the first share itself.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "poker_eval.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
+#define RANK_COUNT 13
+#define LOW_RANKS 7
+#define LOW_KEY_SPAN 78125    // 5^7 base-5 keys for ranks 2-8
+#define HIGH_KEY_SPAN 15625   // 5^6 base-5 keys for ranks 9-A
+#define MAX_QUINARY_CARDS 7
+#define QUINARY_5_SIZE 6175
+#define QUINARY_6_SIZE 18395
+#define QUINARY_7_SIZE 49205
+
+// Combinatorial tables for the quinary perfect hash
+static int quinary_ways[RANK_COUNT + 1][MAX_QUINARY_CARDS + 1];
+static unsigned int quinary_offset[RANK_COUNT][MAX_QUINARY_CARDS + 1][5];
+static unsigned short high_prefix[MAX_QUINARY_CARDS + 1][HIGH_KEY_SPAN];
+static unsigned short low_suffix[LOW_KEY_SPAN];
+
+// Value tables
+static unsigned int flush_table[1 << RANK_COUNT];
+static unsigned int quinary_5_table[QUINARY_5_SIZE];
+static unsigned int quinary_6_table[QUINARY_6_SIZE];
+static unsigned int quinary_7_table[QUINARY_7_SIZE];
+static unsigned int* quinary_tables[MAX_QUINARY_CARDS + 1];
+
+static int tables_ready = 0;
+
+static const char* category_names[POKER_CATEGORY_COUNT] = {
+    "High Card", "One Pair", "Two Pair", "Three of a Kind", "Straight",
+    "Flush", "Full House", "Four of a Kind", "Straight Flush"
+};
+
+// Value layout: category in bits 20-23, five kicker ranks in 4-bit fields
+static unsigned int make_value(int category, const int* kickers, int count) {
+    unsigned int value = (unsigned int)category << 20;
+    for (int i = 0; i < 5; i++) {
+        int rank = (i < count) ? kickers[i] : 0;
+        value |= (unsigned int)rank << (16 - 4 * i);
+    }
+    return value;
+}
+
+// Returns the rank index of the top card of the best straight, or -1
+static int straight_top(unsigned int mask) {
+    unsigned int extended = (mask << 1) | ((mask >> 12) & 1); // Ace plays low
+    for (int top = RANK_COUNT; top >= 4; top--) {
+        if (((extended >> (top - 4)) & 0x1F) == 0x1F) {
+            return top - 1;
+        }
+    }
+    return -1;
+}
+
+static unsigned int evaluate_flush_mask(unsigned int mask) {
+    int kickers[5];
+    int count = 0;
+
+    int top = straight_top(mask);
+    if (top >= 0) {
+        return make_value(POKER_STRAIGHT_FLUSH, &top, 1);
+    }
+
+    for (int rank = RANK_COUNT - 1; rank >= 0 && count < 5; rank--) {
+        if (mask & (1u << rank)) {
+            kickers[count++] = rank;
+        }
+    }
+    return make_value(POKER_FLUSH, kickers, count);
+}
+
+// Collects up to 'limit' ranks (high to low) holding at least 'min_count' cards
+static int collect_ranks(const int* counts, int min_count, int exclude_a, int exclude_b,
+                         int* out, int limit) {
+    int found = 0;
+    for (int rank = RANK_COUNT - 1; rank >= 0 && found < limit; rank--) {
+        if (counts[rank] >= min_count && rank != exclude_a && rank != exclude_b) {
+            out[found++] = rank;
+        }
+    }
+    return found;
+}
+
+// Best non-flush hand for a multiset of ranks
+static unsigned int evaluate_rank_counts(const int* counts) {
+    int kickers[5];
+    int quads[1], trips[2], pairs[3];
+    unsigned int mask = 0;
+
+    for (int rank = 0; rank < RANK_COUNT; rank++) {
+        if (counts[rank] > 0) mask |= 1u << rank;
+    }
+
+    if (collect_ranks(counts, 4, -1, -1, quads, 1)) {
+        kickers[0] = quads[0];
+        collect_ranks(counts, 1, quads[0], -1, &kickers[1], 1);
+        return make_value(POKER_FOUR_OF_A_KIND, kickers, 2);
+    }
+
+    int trip_count = collect_ranks(counts, 3, -1, -1, trips, 2);
+    if (trip_count > 0 && collect_ranks(counts, 2, trips[0], -1, pairs, 1)) {
+        kickers[0] = trips[0];
+        kickers[1] = pairs[0];
+        return make_value(POKER_FULL_HOUSE, kickers, 2);
+    }
+
+    int top = straight_top(mask);
+    if (top >= 0) {
+        return make_value(POKER_STRAIGHT, &top, 1);
+    }
+
+    if (trip_count > 0) {
+        kickers[0] = trips[0];
+        collect_ranks(counts, 1, trips[0], -1, &kickers[1], 2);
+        return make_value(POKER_THREE_OF_A_KIND, kickers, 3);
+    }
+
+    int pair_count = collect_ranks(counts, 2, -1, -1, pairs, 2);
+    if (pair_count == 2) {
+        kickers[0] = pairs[0];
+        kickers[1] = pairs[1];
+        collect_ranks(counts, 1, pairs[0], pairs[1], &kickers[2], 1);
+        return make_value(POKER_TWO_PAIR, kickers, 3);
+    }
+    if (pair_count == 1) {
+        kickers[0] = pairs[0];
+        collect_ranks(counts, 1, pairs[0], -1, &kickers[1], 3);
+        return make_value(POKER_ONE_PAIR, kickers, 4);
+    }
+
+    int high_count = collect_ranks(counts, 1, -1, -1, kickers, 5);
+    return make_value(POKER_HIGH_CARD, kickers, high_count);
+}
+
+static inline int quinary_index(unsigned int rank_key, int total) {
+    return high_prefix[total][rank_key / LOW_KEY_SPAN] + low_suffix[rank_key % LOW_KEY_SPAN];
+}
+
+// Lexicographic rank (high ranks first) of the base-5 digits of 'key',
+// which cover ranks low..high, with 'remaining' cards still to place.
+// Returns -1 when the digits need more cards than remain.
+static int quinary_partial_rank(unsigned int key, int low, int high, int remaining) {
+    int digits[RANK_COUNT];
+    int index = 0;
+
+    for (int rank = low; rank <= high; rank++) {
+        digits[rank] = (int)(key % 5);
+        key /= 5;
+    }
+
+    for (int rank = high; rank >= low; rank--) {
+        if (digits[rank] > remaining) return -1;
+        index += quinary_offset[rank][remaining][digits[rank]];
+        remaining -= digits[rank];
+    }
+    return index;
+}
+
+// Walks every rank multiset with 'remaining' cards left to place
+static void fill_quinary_table(unsigned int* table, int total, int* counts, int rank, int remaining) {
+    if (rank == RANK_COUNT) {
+        if (remaining == 0) {
+            unsigned int key = 0;
+            for (int r = RANK_COUNT - 1; r >= 0; r--) {
+                key = key * 5 + (unsigned int)counts[r];
+            }
+            table[quinary_index(key, total)] = evaluate_rank_counts(counts);
+        }
+        return;
+    }
+
+    for (int digit = 0; digit <= 4 && digit <= remaining; digit++) {
+        counts[rank] = digit;
+        fill_quinary_table(table, total, counts, rank + 1, remaining - digit);
+    }
+    counts[rank] = 0;
+}
+
+void poker_eval_init(void) {
+    if (tables_ready) return;
+
+    // quinary_ways[n][k]: ways to place k cards over n ranks, at most 4 per rank
+    quinary_ways[0][0] = 1;
+    for (int n = 1; n <= RANK_COUNT; n++) {
+        for (int k = 0; k <= MAX_QUINARY_CARDS; k++) {
+            quinary_ways[n][k] = 0;
+            for (int digit = 0; digit <= 4 && digit <= k; digit++) {
+                quinary_ways[n][k] += quinary_ways[n - 1][k - digit];
+            }
+        }
+    }
+
+    // quinary_offset[r][k][d]: multisets ranked before digit d at rank r,
+    // where the 'r' lower ranks still have to absorb the remaining cards
+    for (int rank = 0; rank < RANK_COUNT; rank++) {
+        for (int k = 0; k <= MAX_QUINARY_CARDS; k++) {
+            unsigned int offset = 0;
+            for (int digit = 0; digit < 5; digit++) {
+                quinary_offset[rank][k][digit] = offset;
+                if (digit <= k) offset += quinary_ways[rank][k - digit];
+            }
+        }
+    }
+
+    // Split the rank into a total-dependent high part and a low part
+    for (int total = 5; total <= MAX_QUINARY_CARDS; total++) {
+        for (unsigned int key = 0; key < HIGH_KEY_SPAN; key++) {
+            int index = quinary_partial_rank(key, LOW_RANKS, RANK_COUNT - 1, total);
+            high_prefix[total][key] = (unsigned short)(index < 0 ? 0 : index);
+        }
+    }
+    for (unsigned int key = 0; key < LOW_KEY_SPAN; key++) {
+        int cards = 0;
+        for (unsigned int rest = key; rest > 0; rest /= 5) cards += (int)(rest % 5);
+        int index = (cards <= MAX_QUINARY_CARDS) ? quinary_partial_rank(key, 0, LOW_RANKS - 1, cards) : -1;
+        low_suffix[key] = (unsigned short)(index < 0 ? 0 : index);
+    }
+
+    for (unsigned int mask = 0; mask < (1u << RANK_COUNT); mask++) {
+        int bits = 0;
+        for (int rank = 0; rank < RANK_COUNT; rank++) {
+            if (mask & (1u << rank)) bits++;
+        }
+        flush_table[mask] = (bits >= 5) ? evaluate_flush_mask(mask) : 0;
+    }
+
+    int counts[RANK_COUNT] = {0};
+    quinary_tables[5] = quinary_5_table;
+    quinary_tables[6] = quinary_6_table;
+    quinary_tables[7] = quinary_7_table;
+    for (int total = 5; total <= MAX_QUINARY_CARDS; total++) {
+        fill_quinary_table(quinary_tables[total], total, counts, 0, total);
+    }
+
+    tables_ready = 1;
+}
+
+void poker_hand_clear(PokerHand* hand) {
+    memset(hand, 0, sizeof(*hand));
+}
+
+unsigned int poker_hand_value(const PokerHand* hand) {
+    // A nibble reaches 8 after adding 3 only when that suit holds 5+ cards.
+    // With at most 7 cards a flush always outranks the best non-flush hand.
+    unsigned int flush_bits = (hand->suit_key + 0x3333u) & 0x8888u;
+    if (flush_bits) {
+        int suit = 0;
+        while (!(flush_bits & (0x8u << (4 * suit)))) suit++;
+        return flush_table[hand->suit_masks[suit]];
+    }
+
+    return quinary_tables[hand->count][quinary_index(hand->rank_key, hand->count)];
+}
+
+unsigned int poker_evaluate(const int* cards, int count) {
+    PokerHand hand;
+    poker_hand_clear(&hand);
+    for (int i = 0; i < count; i++) {
+        poker_hand_add(&hand, cards[i]);
+    }
+    return poker_hand_value(&hand);
+}
+
+PokerCategory poker_hand_category(unsigned int value) {
+    return (PokerCategory)(value >> 20);
+}
+
+const char* poker_category_name(PokerCategory category) {
+    if (category < 0 || category >= POKER_CATEGORY_COUNT) return "Unknown";
+    return category_names[category];
+}
+
+int poker_card_index(Card card) {
+    int rank_index = (card.rank == ACE) ? 12 : (int)card.rank - 2;
+    return rank_index * 4 + (int)card.suit;
+}
+
+Card poker_card_from_index(int index) {
+    Card card;
+    int rank_index = index >> 2;
+    card.rank = (rank_index == 12) ? ACE : (Rank)(rank_index + 2);
+    card.suit = (Suit)(index & 3);
+    return card;
+}
+
+// ============================================================================
+// EQUITY CALCULATOR
+// ============================================================================
+
+typedef struct {
+    int hole[2];
+    int board[5];
+    int board_count;
+    int opponents;
+    int deck[POKER_CARD_COUNT];
+    int deck_count;
+    int samples;                 // Monte Carlo samples for this worker
+    int worker;                  // Exact mode: this worker's stride offset
+    int workers;
+    unsigned long long rng;
+    long long wins, ties, losses;
+    double share;
+    long long boards;
+} EquityJob;
+
+static unsigned long long equity_next_random(unsigned long long* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+static void equity_record(EquityJob* job, unsigned int hero, const unsigned int* villains, int count) {
+    int tied = 0;
+    for (int i = 0; i < count; i++) {
+        if (villains[i] > hero) {
+            job->losses++;
+            job->boards++;
+            return;
+        }
+        if (villains[i] == hero) tied++;
+    }
+    if (tied) {
+        job->ties++;
+        job->share += 1.0 / (tied + 1);
+    } else {
+        job->wins++;
+        job->share += 1.0;
+    }
+    job->boards++;
+}
+
+static void equity_monte_carlo(EquityJob* job) {
+    int deck[POKER_CARD_COUNT];
+    int missing = 5 - job->board_count;
+    int needed = missing + 2 * job->opponents;
+    PokerHand known, board, hand;
+    unsigned int villains[POKER_MAX_OPPONENTS];
+
+    memcpy(deck, job->deck, sizeof(int) * job->deck_count);
+
+    poker_hand_clear(&known);
+    for (int i = 0; i < job->board_count; i++) {
+        poker_hand_add(&known, job->board[i]);
+    }
+
+    for (int sample = 0; sample < job->samples; sample++) {
+        // Partial Fisher-Yates: the first 'needed' slots become the draw
+        for (int i = 0; i < needed; i++) {
+            unsigned int span = (unsigned int)(job->deck_count - i);
+            unsigned int pick = i + (unsigned int)(((equity_next_random(&job->rng) >> 32) * span) >> 32);
+            int temp = deck[i];
+            deck[i] = deck[pick];
+            deck[pick] = temp;
+        }
+
+        board = known;
+        for (int i = 0; i < missing; i++) {
+            poker_hand_add(&board, deck[i]);
+        }
+
+        hand = board;
+        poker_hand_add(&hand, job->hole[0]);
+        poker_hand_add(&hand, job->hole[1]);
+        unsigned int hero = poker_hand_value(&hand);
+
+        for (int v = 0; v < job->opponents; v++) {
+            hand = board;
+            poker_hand_add(&hand, deck[missing + 2 * v]);
+            poker_hand_add(&hand, deck[missing + 2 * v + 1]);
+            villains[v] = poker_hand_value(&hand);
+        }
+
+        equity_record(job, hero, villains, job->opponents);
+    }
+}
+
+// Heads-up from the flop onward: every runout against every opponent holding
+static void equity_exhaustive(EquityJob* job) {
+    int missing = 5 - job->board_count;
+    int n = job->deck_count;
+    int runout = 0;
+    PokerHand known, board, hand, partial;
+
+    poker_hand_clear(&known);
+    for (int i = 0; i < job->board_count; i++) {
+        poker_hand_add(&known, job->board[i]);
+    }
+
+    int first_end = (missing >= 1) ? n : 1;
+    for (int a = 0; a < first_end; a++) {
+        int second_start = (missing == 2) ? a + 1 : 0;
+        int second_end = (missing == 2) ? n : second_start + 1;
+
+        for (int b = second_start; b < second_end; b++) {
+            if (runout++ % job->workers != job->worker) continue;
+
+            board = known;
+            if (missing >= 1) poker_hand_add(&board, job->deck[a]);
+            if (missing == 2) poker_hand_add(&board, job->deck[b]);
+
+            hand = board;
+            poker_hand_add(&hand, job->hole[0]);
+            poker_hand_add(&hand, job->hole[1]);
+            unsigned int hero = poker_hand_value(&hand);
+
+            for (int x = 0; x < n; x++) {
+                if ((missing >= 1 && x == a) || (missing == 2 && x == b)) continue;
+                partial = board;
+                poker_hand_add(&partial, job->deck[x]);
+                for (int y = x + 1; y < n; y++) {
+                    if ((missing >= 1 && y == a) || (missing == 2 && y == b)) continue;
+                    hand = partial;
+                    poker_hand_add(&hand, job->deck[y]);
+                    unsigned int villain = poker_hand_value(&hand);
+                    equity_record(job, hero, &villain, 1);
+                }
+            }
+        }
+    }
+}
+
+static void* equity_worker(void* arg) {
+    EquityJob* job = (EquityJob*)arg;
+    if (job->samples > 0) {
+        equity_monte_carlo(job);
+    } else {
+        equity_exhaustive(job);
+    }
+    return NULL;
+}
+
+#ifndef _WIN32
+// Pool worker w runs jobs[w] of each query that has that many jobs
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t pool_query = PTHREAD_MUTEX_INITIALIZER;     // One query at a time
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static int pool_workers;                 // Started so far; worker ids are 1..pool_workers
+static EquityJob* pool_jobs;
+static int pool_job_count;
+static int pool_pending;
+static unsigned int pool_generation;
+static int pool_atfork_installed;
+
+static void* pool_worker(void* arg) {
+    int worker = (int)(intptr_t)arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (pool_generation == seen) pthread_cond_wait(&pool_work, &pool_lock);
+        seen = pool_generation;
+        if (worker >= pool_job_count) continue;
+        EquityJob* job = &pool_jobs[worker];
+        pthread_mutex_unlock(&pool_lock);
+
+        equity_worker(job);
+
+        pthread_mutex_lock(&pool_lock);
+        if (--pool_pending == 0) pthread_cond_signal(&pool_done);
+    }
+    return NULL;
+}
+
+// The workers stay with the parent; a child starts its own
+static void pool_forget_in_child(void) {
+    pthread_mutex_init(&pool_lock, NULL);
+    pthread_mutex_init(&pool_query, NULL);
+    pthread_cond_init(&pool_work, NULL);
+    pthread_cond_init(&pool_done, NULL);
+    pool_workers = 0;
+    pool_pending = 0;
+    pool_job_count = 0;
+}
+
+// Under pool_query
+static void pool_grow(int wanted) {
+    if (!pool_atfork_installed) {
+        pthread_atfork(NULL, NULL, pool_forget_in_child);
+        pool_atfork_installed = 1;
+    }
+
+    // Signals stay with the game thread
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    while (pool_workers < wanted) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, pool_worker, (void*)(intptr_t)(pool_workers + 1)) != 0) break;
+        pthread_detach(thread);
+        pool_workers++;
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+static void pool_run(EquityJob* jobs, int count) {
+    pthread_mutex_lock(&pool_query);
+    if (pool_workers < count - 1) pool_grow(count - 1);
+    int pooled = count - 1 < pool_workers ? count - 1 : pool_workers;
+
+    pthread_mutex_lock(&pool_lock);
+    pool_jobs = jobs;
+    pool_job_count = pooled + 1;
+    pool_pending = pooled;
+    pool_generation++;
+    pthread_cond_broadcast(&pool_work);
+    pthread_mutex_unlock(&pool_lock);
+
+    // Ours, plus any a worker could not be started for
+    equity_worker(&jobs[0]);
+    for (int t = pooled + 1; t < count; t++) equity_worker(&jobs[t]);
+
+    pthread_mutex_lock(&pool_lock);
+    while (pool_pending > 0) pthread_cond_wait(&pool_done, &pool_lock);
+    pool_job_count = 0;
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&pool_query);
+}
+#endif
+
+int poker_default_threads(void) {
+#ifdef _WIN32
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > POKER_MAX_THREADS) cores = POKER_MAX_THREADS;
+    return (int)cores;
+#endif
+}
+
+PokerEquity poker_equity(const int hole[2], const int* board, int board_count,
+                         int opponents, int samples, int threads) {
+    PokerEquity result = {0, 0, 0, 0, 0, 0};
+    EquityJob jobs[POKER_MAX_THREADS];
+    int used[POKER_CARD_COUNT] = {0};
+
+    poker_eval_init();
+
+    if (opponents < 1) opponents = 1;
+    if (opponents > POKER_MAX_OPPONENTS) opponents = POKER_MAX_OPPONENTS;
+    if (threads < 1) threads = 1;
+    if (threads > POKER_MAX_THREADS) threads = POKER_MAX_THREADS;
+    if (samples <= 0) samples = 20000;
+
+    int exact = (opponents == 1 && board_count >= 3);
+
+    EquityJob base;
+    memset(&base, 0, sizeof(base));
+    base.hole[0] = hole[0];
+    base.hole[1] = hole[1];
+    base.board_count = board_count;
+    base.opponents = opponents;
+    used[hole[0]] = used[hole[1]] = 1;
+    for (int i = 0; i < board_count; i++) {
+        base.board[i] = board[i];
+        used[board[i]] = 1;
+    }
+    for (int card = 0; card < POKER_CARD_COUNT; card++) {
+        if (!used[card]) base.deck[base.deck_count++] = card;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = base;
+        jobs[t].worker = t;
+        jobs[t].workers = threads;
+        jobs[t].samples = exact ? 0 : samples / threads + (t < samples % threads);
+        jobs[t].rng = ((unsigned long long)rand() << 32) ^ (unsigned long long)rand()
+                      ^ (0x9E3779B97F4A7C15ULL * (unsigned long long)(t + 1));
+        if (jobs[t].rng == 0) jobs[t].rng = 0x2545F4914F6CDD1DULL;
+    }
+
+#ifndef _WIN32
+    pool_run(jobs, threads);
+#else
+    for (int t = 0; t < threads; t++) {
+        equity_worker(&jobs[t]);
+    }
+#endif
+
+    long long wins = 0, ties = 0, losses = 0;
+    double share = 0;
+    for (int t = 0; t < threads; t++) {
+        wins += jobs[t].wins;
+        ties += jobs[t].ties;
+        losses += jobs[t].losses;
+        share += jobs[t].share;
+        result.boards += jobs[t].boards;
+    }
+
+    if (result.boards > 0) {
+        result.win = (double)wins / result.boards;
+        result.tie = (double)ties / result.boards;
+        result.lose = (double)losses / result.boards;
+        result.equity = share / result.boards;
+    }
+    result.exact = exact;
+    return result;
+}
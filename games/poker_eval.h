@@ -0,0 +1,78 @@
+#ifndef POKER_EVAL_H
+#define POKER_EVAL_H
+
+#include "cards.h"
+
+/*
+ * Table-driven poker hand evaluator and equity calculator.
+ *
+ * Cards are packed as integers 0-51: (rank_index * 4) + suit, where
+ * rank_index 0 is a deuce and 12 is an ace. Hand values compare directly:
+ * a larger value is always the stronger hand.
+ */
+
+#define POKER_CARD_COUNT 52
+#define POKER_MAX_OPPONENTS 8
+#define POKER_MAX_THREADS 16
+
+typedef enum {
+    POKER_HIGH_CARD,
+    POKER_ONE_PAIR,
+    POKER_TWO_PAIR,
+    POKER_THREE_OF_A_KIND,
+    POKER_STRAIGHT,
+    POKER_FLUSH,
+    POKER_FULL_HOUSE,
+    POKER_FOUR_OF_A_KIND,
+    POKER_STRAIGHT_FLUSH,
+    POKER_CATEGORY_COUNT
+} PokerCategory;
+
+// Incrementally built hand: adding a card is three adds/ors, so loops that
+// enumerate boards can share the partial state of their outer cards.
+typedef struct {
+    unsigned int rank_key;        // Base-5 count of each rank
+    unsigned int suit_key;        // Four 4-bit suit counts
+    unsigned int suit_masks[4];   // Rank bitmask held in each suit
+    int count;
+} PokerHand;
+
+static const unsigned int poker_rank_powers[13] = {
+    1, 5, 25, 125, 625, 3125, 15625, 78125, 390625,
+    1953125, 9765625, 48828125, 244140625
+};
+
+static inline void poker_hand_add(PokerHand* hand, int card) {
+    hand->rank_key += poker_rank_powers[card >> 2];
+    hand->suit_key += 1u << (4 * (card & 3));
+    hand->suit_masks[card & 3] |= 1u << (card >> 2);
+    hand->count++;
+}
+
+typedef struct {
+    double win;         // Fraction of boards won outright
+    double tie;         // Fraction of boards split
+    double lose;        // Fraction of boards lost
+    double equity;      // Expected share of the pot (ties split evenly)
+    long long boards;   // Boards evaluated
+    int exact;          // 1 when every remaining board was enumerated
+} PokerEquity;
+
+// Evaluator
+void poker_eval_init(void);
+unsigned int poker_evaluate(const int* cards, int count);  // 5 to 7 cards
+unsigned int poker_hand_value(const PokerHand* hand);   // 5 to 7 cards
+void poker_hand_clear(PokerHand* hand);
+PokerCategory poker_hand_category(unsigned int value);
+const char* poker_category_name(PokerCategory category);
+
+// Card conversion
+int poker_card_index(Card card);
+Card poker_card_from_index(int index);
+
+// Equity calculator
+int poker_default_threads(void);
+PokerEquity poker_equity(const int hole[2], const int* board, int board_count,
+                         int opponents, int samples, int threads);
+
+#endif // POKER_EVAL_H
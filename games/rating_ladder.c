@@ -0,0 +1,127 @@
+/*
+ * Rating Ladder - Cross-Game Leaderboard
+ * Part of CLI Games Pack v2.1
+ *
+ * Shows the Glicko-2 ladder built from every rated game (see ratings.c):
+ * - Top 20 leaderboard with rating deviation and W-L-D records
+ * - Player lookup by name
+ * - Full re-rate of the match log with a new volatility constraint
+ */
+
+#include "games.h"
+#include "ratings.h"
+
+#define LADDER_SHOWN 20
+#define PROVISIONAL_RD 110.0f
+
+static void display_leaderboard(void) {
+    RatingEntry entries[LADDER_SHOWN];
+    char names[LADDER_SHOWN][RATINGS_NAME_LEN];
+    RatingLadderInfo info;
+    int shown = ratings_leaderboard(entries, names, LADDER_SHOWN, &info);
+
+    printf("\n===========================================\n");
+    printf("          CROSS-GAME RATING LADDER\n");
+    printf("===========================================\n");
+    if (shown == 0) {
+        printf("No rated matches yet! Play RPS, Coin Flip, Tic Tac Toe,\n");
+        printf("F1 Reaction multiplayer or Blackjack to get on the ladder.\n");
+        return;
+    }
+
+    printf("Rank Player               Rating   RD  Games  W-L-D\n");
+    printf("-------------------------------------------\n");
+    for (int i = 0; i < shown; i++) {
+        printf("%3d  %-20.20s %6.0f %c%4.0f %6u  %u-%u-%u\n", i + 1, names[i],
+               entries[i].rating, entries[i].rd > PROVISIONAL_RD ? '?' : ' ',
+               entries[i].rd, entries[i].games, entries[i].wins,
+               entries[i].losses, entries[i].draws);
+    }
+    printf("-------------------------------------------\n");
+    printf("%u players, %u matches, tau %.2f (? = provisional)\n",
+           info.players, info.matches, info.tau);
+}
+
+static void lookup_player(void) {
+    char name[RATINGS_NAME_LEN];
+    RatingEntry entry;
+
+    printf("\nPlayer name (Enter for %s): ", ratings_local_player());
+    if (!fgets(name, sizeof(name), stdin)) return;
+    if (!strchr(name, '\n')) clear_input_buffer();
+    name[strcspn(name, "\n")] = '\0';
+    if (!name[0]) {
+        strncpy(name, ratings_local_player(), sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+    }
+
+    if (!ratings_lookup(name, &entry)) {
+        printf("No rated matches found for '%s'.\n", name);
+        return;
+    }
+    printf("\n%s: rating %.0f (RD %.0f, volatility %.4f), rank #%u\n",
+           name, entry.rating, entry.rd, entry.volatility, entry.rank);
+    printf("%u games: %u wins, %u losses, %u draws\n",
+           entry.games, entry.wins, entry.losses, entry.draws);
+}
+
+static void rerate_all(void) {
+    RatingParams params = ratings_default_params();
+    double tau;
+
+    printf("\nVolatility constraint tau (0.3 - 1.2, default %.1f): ", params.tau);
+    if (scanf("%lf", &tau) == 1 && tau >= 0.3 && tau <= 1.2) {
+        params.tau = tau;
+    } else {
+        printf("Using default tau %.1f\n", params.tau);
+    }
+    clear_input_buffer();
+
+    clock_t start = clock();
+    if (ratings_rerate(&params)) {
+        printf("Re-rated %ld matches in %.1f ms.\n", ratings_match_count(),
+               (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    } else {
+        printf("Could not re-rate the match log.\n");
+    }
+}
+
+void show_rating_ladder(void) {
+    int choice;
+
+    while (1) {
+        printf("\n===========================================\n");
+        printf("              RATING LADDER\n");
+        printf("===========================================\n");
+        printf("1. Leaderboard\n");
+        printf("2. Look up a player\n");
+        printf("3. Re-rate all matches\n");
+        printf("0. Return to main menu\n");
+        printf("\nSelect option (0-3): ");
+
+        if (scanf("%d", &choice) != 1) {
+            if (feof(stdin)) return;
+            clear_input_buffer();
+            printf("Invalid input! Please enter a number.\n");
+            continue;
+        }
+        clear_input_buffer();
+
+        switch (choice) {
+            case 0:
+                return;
+            case 1:
+                display_leaderboard();
+                break;
+            case 2:
+                lookup_player();
+                break;
+            case 3:
+                rerate_all();
+                break;
+            default:
+                printf("Invalid selection! Please choose 0-3.\n");
+                break;
+        }
+    }
+}
@@ -0,0 +1,709 @@
+/*
+ * Glicko-2 Rating Ladder
+ * Part of CLI Games Pack v2.1
+ *
+ * Implements Glickman's Glicko-2 system over a shared match log. A re-rate
+ * replays the whole log period by period:
+ *
+ * 1. Players who appear in the period are "touched": any idle periods since
+ *    they last played are applied in closed form (phi^2 += k * sigma^2),
+ *    so players who sit out never cost a pass of their own.
+ * 2. g(phi) is computed once per touched player.
+ * 3. Every match adds g^2 E (1 - E) and g (s - E) into both players'
+ *    accumulators, using only pre-period ratings.
+ * 4. All touched players are updated together (volatility by the Illinois
+ *    root finder, then phi and mu).
+ *
+ * The work per match is two exp() calls and four adds, so replaying
+ * millions of matches takes a fraction of a second per million.
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "ratings.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "terminal.h"
+#include <math.h>
+#include <fcntl.h>
+#ifndef _WIN32
+#include <sys/file.h>
+#include <sys/stat.h>
+#endif
+
+#define GLICKO_SCALE 173.7178
+#define GLICKO_PI 3.14159265358979323846
+#define GLICKO_EPSILON 0.000001
+#define RATINGS_EPOCH 1704067200L   // 2024-01-01 00:00:00 UTC
+#define RATINGS_UNSEEN 0xFFFFFFFFu
+#define LADDER_MAGIC 0x324B4C47u    // "GLK2"
+#define LADDER_VERSION 1
+#define NAME_SLOTS 2048             // Open-addressed name index, 2x players
+
+#define PLAYERS_FILE "ratings_players.dat"
+#define MATCHES_FILE "ratings_matches.dat"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t match_count;
+    uint32_t player_count;
+    uint32_t final_period;
+    uint32_t reserved;
+    double tau;
+} LadderHeader;
+
+static const char* game_names[RATING_GAME_COUNT] = {
+    "Rock Paper Scissors", "Coin Flip", "Tic Tac Toe", "F1 Reaction", "Blackjack"
+};
+
+// Player registry: names in file order, id = position
+static char player_names[RATINGS_MAX_PLAYERS][RATINGS_NAME_LEN];
+static int player_count = 0;
+static short name_slots[NAME_SLOTS];
+static int registry_loaded = 0;
+
+/* ---------------------------------------------------------------------- */
+/* Rating engine                                                          */
+/* ---------------------------------------------------------------------- */
+
+RatingParams ratings_default_params(void) {
+    RatingParams params = {0.5, 1500.0, 350.0, 0.06};
+    return params;
+}
+
+int ratings_pool_init(RatingPool* pool, int players, const RatingParams* params) {
+    size_t n = players > 0 ? (size_t)players : 1;
+
+    memset(pool, 0, sizeof(*pool));
+    pool->mu = malloc(n * sizeof(double));
+    pool->phi = malloc(n * sizeof(double));
+    pool->sigma = malloc(n * sizeof(double));
+    pool->g = malloc(n * sizeof(double));
+    pool->v_inv = malloc(n * sizeof(double));
+    pool->delta_sum = malloc(n * sizeof(double));
+    pool->last_period = malloc(n * sizeof(uint32_t));
+    pool->games = calloc(n, sizeof(uint32_t));
+    pool->wins = calloc(n, sizeof(uint32_t));
+    pool->losses = calloc(n, sizeof(uint32_t));
+    pool->draws = calloc(n, sizeof(uint32_t));
+    if (!pool->mu || !pool->phi || !pool->sigma || !pool->g || !pool->v_inv ||
+        !pool->delta_sum || !pool->last_period || !pool->games || !pool->wins ||
+        !pool->losses || !pool->draws) {
+        ratings_pool_free(pool);
+        return 0;
+    }
+
+    pool->count = players;
+    double mu0 = (params->initial_rating - 1500.0) / GLICKO_SCALE;
+    double phi0 = params->initial_rd / GLICKO_SCALE;
+    for (int i = 0; i < players; i++) {
+        pool->mu[i] = mu0;
+        pool->phi[i] = phi0;
+        pool->sigma[i] = params->initial_volatility;
+        pool->v_inv[i] = 0.0;
+        pool->delta_sum[i] = 0.0;
+        pool->last_period[i] = RATINGS_UNSEEN;
+    }
+    return 1;
+}
+
+void ratings_pool_free(RatingPool* pool) {
+    free(pool->mu);
+    free(pool->phi);
+    free(pool->sigma);
+    free(pool->g);
+    free(pool->v_inv);
+    free(pool->delta_sum);
+    free(pool->last_period);
+    free(pool->games);
+    free(pool->wins);
+    free(pool->losses);
+    free(pool->draws);
+    memset(pool, 0, sizeof(*pool));
+}
+
+typedef struct {
+    double a;
+    double phi2_v;      // phi^2 + v
+    double delta2;
+    double tau2;
+} VolatilityTerms;
+
+static inline double volatility_f(const VolatilityTerms* t, double x) {
+    double ex = exp(x);
+    double denom = t->phi2_v + ex;
+    return ex * (t->delta2 - t->phi2_v - ex) / (2.0 * denom * denom) - (x - t->a) / t->tau2;
+}
+
+// Illinois-method solve for the new volatility (step 5 of the paper)
+static double glicko2_volatility(double phi, double sigma, double v, double delta, double tau) {
+    VolatilityTerms t = {log(sigma * sigma), phi * phi + v, delta * delta, tau * tau};
+    double A = t.a, B;
+
+    if (t.delta2 > t.phi2_v) {
+        B = log(t.delta2 - t.phi2_v);
+    } else {
+        int k = 1;
+        while (volatility_f(&t, t.a - k * tau) < 0.0) k++;
+        B = t.a - k * tau;
+    }
+
+    double fA = volatility_f(&t, A);
+    double fB = volatility_f(&t, B);
+    for (int iter = 0; fabs(B - A) > GLICKO_EPSILON && iter < 100; iter++) {
+        double C = A + (A - B) * fA / (fB - fA);
+        double fC = volatility_f(&t, C);
+        if (fC * fB <= 0.0) {
+            A = B;
+            fA = fB;
+        } else {
+            fA /= 2.0;
+        }
+        B = C;
+        fB = fC;
+    }
+
+    return exp(A / 2.0);
+}
+
+static inline double glicko2_g(double phi) {
+    return 1.0 / sqrt(1.0 + 3.0 * phi * phi / (GLICKO_PI * GLICKO_PI));
+}
+
+// Applies 'periods' rating periods without games: only uncertainty grows
+static inline void apply_idle_periods(RatingPool* pool, int player, uint32_t periods, double phi_max) {
+    double phi = sqrt(pool->phi[player] * pool->phi[player] +
+                      periods * pool->sigma[player] * pool->sigma[player]);
+    pool->phi[player] = phi < phi_max ? phi : phi_max;
+}
+
+static inline void touch_player(RatingPool* pool, uint32_t player, uint32_t period,
+                                uint32_t* touched, int* touched_count, double phi_max) {
+    uint32_t last = pool->last_period[player];
+    if (last == period) return;
+    if (last != RATINGS_UNSEEN && period > last + 1) {
+        apply_idle_periods(pool, (int)player, period - last - 1, phi_max);
+    }
+    pool->last_period[player] = period;
+    touched[(*touched_count)++] = player;
+}
+
+void ratings_rate_matches(RatingPool* pool, const RatingParams* params,
+                          const RatingMatch* matches, long count, uint32_t final_period) {
+    uint32_t* touched = malloc((pool->count > 0 ? pool->count : 1) * sizeof(uint32_t));
+    double phi_max = params->initial_rd / GLICKO_SCALE;
+    if (!touched) return;
+
+    long start = 0;
+    while (start < count) {
+        uint32_t period = matches[start].period;
+        long end = start;
+        int touched_count = 0;
+
+        while (end < count && matches[end].period == period) {
+            touch_player(pool, matches[end].player_a, period, touched, &touched_count, phi_max);
+            touch_player(pool, matches[end].player_b, period, touched, &touched_count, phi_max);
+            end++;
+        }
+
+        for (int t = 0; t < touched_count; t++) {
+            uint32_t p = touched[t];
+            pool->g[p] = glicko2_g(pool->phi[p]);
+            pool->v_inv[p] = 0.0;
+            pool->delta_sum[p] = 0.0;
+        }
+
+        for (long m = start; m < end; m++) {
+            uint32_t a = matches[m].player_a;
+            uint32_t b = matches[m].player_b;
+            double diff = pool->mu[a] - pool->mu[b];
+            double ga = pool->g[a], gb = pool->g[b];
+            double ea = 1.0 / (1.0 + exp(-gb * diff));
+            double eb = 1.0 / (1.0 + exp(ga * diff));
+            double sa = matches[m].result * 0.5;
+
+            pool->v_inv[a] += gb * gb * ea * (1.0 - ea);
+            pool->delta_sum[a] += gb * (sa - ea);
+            pool->v_inv[b] += ga * ga * eb * (1.0 - eb);
+            pool->delta_sum[b] += ga * ((1.0 - sa) - eb);
+
+            pool->games[a]++;
+            pool->games[b]++;
+            if (matches[m].result == RATING_WIN) {
+                pool->wins[a]++;
+                pool->losses[b]++;
+            } else if (matches[m].result == RATING_LOSS) {
+                pool->losses[a]++;
+                pool->wins[b]++;
+            } else {
+                pool->draws[a]++;
+                pool->draws[b]++;
+            }
+        }
+
+        for (int t = 0; t < touched_count; t++) {
+            uint32_t p = touched[t];
+            double v = 1.0 / pool->v_inv[p];
+            double delta = v * pool->delta_sum[p];
+            double sigma = glicko2_volatility(pool->phi[p], pool->sigma[p], v, delta, params->tau);
+            double phi_star2 = pool->phi[p] * pool->phi[p] + sigma * sigma;
+            double phi = 1.0 / sqrt(1.0 / phi_star2 + pool->v_inv[p]);
+
+            pool->mu[p] += phi * phi * pool->delta_sum[p];
+            pool->phi[p] = phi;
+            pool->sigma[p] = sigma;
+        }
+
+        start = end;
+    }
+
+    // Bring everyone up to the final period
+    for (int p = 0; p < pool->count; p++) {
+        uint32_t last = pool->last_period[p];
+        if (last != RATINGS_UNSEEN && final_period > last) {
+            apply_idle_periods(pool, p, final_period - last, phi_max);
+            pool->last_period[p] = final_period;
+        }
+    }
+
+    free(touched);
+}
+
+void ratings_pool_entry(const RatingPool* pool, int player, RatingEntry* entry) {
+    entry->rating = (float)(pool->mu[player] * GLICKO_SCALE + 1500.0);
+    entry->rd = (float)(pool->phi[player] * GLICKO_SCALE);
+    entry->volatility = (float)pool->sigma[player];
+    entry->games = pool->games[player];
+    entry->wins = pool->wins[player];
+    entry->losses = pool->losses[player];
+    entry->draws = pool->draws[player];
+    entry->rank = 0;
+}
+
+static const double* rank_sort_mu;
+
+static int compare_by_rating(const void* a, const void* b) {
+    double ra = rank_sort_mu[*(const uint32_t*)a];
+    double rb = rank_sort_mu[*(const uint32_t*)b];
+    if (ra != rb) return ra < rb ? 1 : -1;
+    return *(const uint32_t*)a < *(const uint32_t*)b ? -1 : 1;
+}
+
+// order[0] is the highest rated player
+void ratings_rank_order(const RatingPool* pool, uint32_t* order) {
+    for (int i = 0; i < pool->count; i++) order[i] = (uint32_t)i;
+    rank_sort_mu = pool->mu;
+    qsort(order, (size_t)pool->count, sizeof(uint32_t), compare_by_rating);
+}
+
+void ratings_glicko2_update(const RatingParams* params, double* rating, double* rd,
+                            double* volatility, int opponents, const double* opp_rating,
+                            const double* opp_rd, const double* score) {
+    double mu = (*rating - 1500.0) / GLICKO_SCALE;
+    double phi = *rd / GLICKO_SCALE;
+    double v_inv = 0.0, delta_sum = 0.0;
+
+    if (opponents == 0) {
+        *rd = sqrt(phi * phi + *volatility * *volatility) * GLICKO_SCALE;
+        return;
+    }
+
+    for (int j = 0; j < opponents; j++) {
+        double mu_j = (opp_rating[j] - 1500.0) / GLICKO_SCALE;
+        double g = glicko2_g(opp_rd[j] / GLICKO_SCALE);
+        double e = 1.0 / (1.0 + exp(-g * (mu - mu_j)));
+        v_inv += g * g * e * (1.0 - e);
+        delta_sum += g * (score[j] - e);
+    }
+
+    double v = 1.0 / v_inv;
+    double sigma = glicko2_volatility(phi, *volatility, v, v * delta_sum, params->tau);
+    double phi_new = 1.0 / sqrt(1.0 / (phi * phi + sigma * sigma) + v_inv);
+
+    *rating = (mu + phi_new * phi_new * delta_sum) * GLICKO_SCALE + 1500.0;
+    *rd = phi_new * GLICKO_SCALE;
+    *volatility = sigma;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Player registry                                                        */
+/* ---------------------------------------------------------------------- */
+
+static unsigned int hash_name(const char* name) {
+    unsigned int h = 2166136261u;   // FNV-1a
+    while (*name) {
+        h ^= (unsigned char)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void index_name(int id) {
+    unsigned int slot = hash_name(player_names[id]) & (NAME_SLOTS - 1);
+    while (name_slots[slot] >= 0) slot = (slot + 1) & (NAME_SLOTS - 1);
+    name_slots[slot] = (short)id;
+}
+
+// A ratings file in the shared directory. The players file and the match
+// log are read and appended in place by every user; opening never follows
+// a link planted there.
+static FILE* open_shared(const char* file_name, int flags, const char* mode) {
+    char path[512];
+    if (!highscore_make_shared_dir() || !highscore_shared_path(file_name, path, sizeof(path))) return NULL;
+#ifndef _WIN32
+    int fd = open(path, flags | O_NOFOLLOW | O_CLOEXEC, 0666);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return NULL;
+    }
+    if ((flags & O_CREAT) && st.st_uid == geteuid() && (st.st_mode & 0777) != 0666) fchmod(fd, 0666);
+    FILE* file = fdopen(fd, mode);
+    if (!file) close(fd);
+    return file;
+#else
+    FILE* file = fopen(path, mode);
+    if (!file && (flags & O_CREAT) && strcmp(mode, "r+b") == 0) file = fopen(path, "w+b");
+    return file;
+#endif
+}
+
+// The ladder is rebuilt from the shared log at will, so each user keeps
+// their own copy and can replace it by rename in the sticky directory
+static int ladder_path(char* path, int size) {
+    char file_name[64], key[41];
+    ratings_local_file_key(key, sizeof(key));
+    snprintf(file_name, sizeof(file_name), "ratings_ladder_%s.dat", key);
+    return highscore_make_shared_dir() && highscore_shared_path(file_name, path, size);
+}
+
+static FILE* open_ladder_file(void) {
+    char path[512];
+    if (!ladder_path(path, sizeof(path))) return NULL;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    FILE* file = fdopen(fd, "rb");
+    if (!file) close(fd);
+    return file;
+#else
+    return fopen(path, "rb");
+#endif
+}
+
+// Names in file order from the start of file; id = record position
+static void read_registry(FILE* file) {
+    player_count = 0;
+    for (int i = 0; i < NAME_SLOTS; i++) name_slots[i] = -1;
+    if (!file) return;
+    while (player_count < RATINGS_MAX_PLAYERS &&
+           fread(player_names[player_count], RATINGS_NAME_LEN, 1, file) == 1) {
+        player_names[player_count][RATINGS_NAME_LEN - 1] = '\0';
+        index_name(player_count);
+        player_count++;
+    }
+}
+
+static void load_registry(void) {
+    if (registry_loaded) return;
+    registry_loaded = 1;
+    FILE* file = open_shared(PLAYERS_FILE, O_RDONLY, "rb");
+    read_registry(file);
+    if (file) fclose(file);
+}
+
+// The players file opened for update and held exclusively until closed,
+// so two processes cannot both append a name at the same position
+static FILE* open_registry_locked(void) {
+    FILE* file = open_shared(PLAYERS_FILE, O_RDWR | O_CREAT, "r+b");
+#ifndef _WIN32
+    if (file && flock(fileno(file), LOCK_EX) != 0) {
+        fclose(file);
+        return NULL;
+    }
+#endif
+    return file;
+}
+
+static int find_player(const char* name) {
+    unsigned int slot = hash_name(name) & (NAME_SLOTS - 1);
+    load_registry();
+    while (name_slots[slot] >= 0) {
+        if (strcmp(player_names[name_slots[slot]], name) == 0) return name_slots[slot];
+        slot = (slot + 1) & (NAME_SLOTS - 1);
+    }
+    return -1;
+}
+
+// Ids are positions in the players file, and other processes may have
+// appended since it was read: a new name is looked up again and written
+// under the lock, and takes the id of the record it actually landed in
+static int register_player(const char* name) {
+    int id = find_player(name);
+    if (id >= 0) return id;
+
+    char record[RATINGS_NAME_LEN] = {0};
+    strncpy(record, name, RATINGS_NAME_LEN - 1);
+
+    FILE* file = open_registry_locked();
+    if (!file) return -1;
+    read_registry(file);
+    id = find_player(record);
+    if (id < 0 && player_count < RATINGS_MAX_PLAYERS && fseek(file, 0, SEEK_END) == 0) {
+        long end = ftell(file);
+        long slot = (end + RATINGS_NAME_LEN - 1) / RATINGS_NAME_LEN;   // Past any torn record
+        if (end >= 0 && slot < RATINGS_MAX_PLAYERS && fseek(file, slot * RATINGS_NAME_LEN, SEEK_SET) == 0 &&
+            fwrite(record, RATINGS_NAME_LEN, 1, file) == 1 && fflush(file) == 0) {
+            rewind(file);
+            read_registry(file);
+            id = find_player(record);
+        }
+    }
+    fclose(file);
+    return id;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Ladder service                                                         */
+/* ---------------------------------------------------------------------- */
+
+const char* ratings_game_name(RatingGame game) {
+    return (game >= 0 && game < RATING_GAME_COUNT) ? game_names[game] : "Unknown";
+}
+
+const char* ratings_local_player(void) {
+    const char* name = getenv("USER");
+    if (!name || !*name) name = getenv("USERNAME");
+    if (!name || !*name) name = "Player";
+    return name;
+}
+
+void ratings_local_file_key(char* key, int size) {
+    const char* name = ratings_local_player();
+    int length = 0;
+    if (size <= 0) return;
+    for (; name[length] && length < 40 && length < size - 1; length++) {
+        char c = name[length];
+        key[length] = isalnum((unsigned char)c) || c == '_' || c == '-' ? c : '_';
+    }
+    key[length] = '\0';
+}
+
+uint16_t ratings_current_period(void) {
+    long elapsed = (long)time(NULL) - RATINGS_EPOCH;
+    return (uint16_t)(elapsed > 0 ? elapsed / RATINGS_PERIOD_SECONDS : 0);
+}
+
+int ratings_record_match(RatingGame game, const char* player_a, const char* player_b,
+                         RatingResult result) {
+    char name_a[RATINGS_NAME_LEN] = {0}, name_b[RATINGS_NAME_LEN] = {0};
+    strncpy(name_a, player_a, RATINGS_NAME_LEN - 1);
+    strncpy(name_b, player_b, RATINGS_NAME_LEN - 1);
+    if (!name_a[0] || !name_b[0] || strcmp(name_a, name_b) == 0) return 0;
+
+    int a = register_player(name_a);
+    int b = register_player(name_b);
+    if (a < 0 || b < 0) return 0;
+
+    RatingMatch match;
+    match.player_a = (uint32_t)a;
+    match.player_b = (uint32_t)b;
+    match.period = ratings_current_period();
+    match.game = (uint8_t)game;
+    match.result = (uint8_t)result;
+
+    uint64_t start = terminal_now_us();
+    FILE* file = open_shared(MATCHES_FILE, O_WRONLY | O_CREAT | O_APPEND, "ab");
+    if (!file) return 0;
+    int ok = fwrite(&match, sizeof(match), 1, file) == 1;
+    fclose(file);
+    metrics_observe(METRICS_STATS_WRITE_US, terminal_now_us() - start);
+    return ok;
+}
+
+static long logged_match_count(void) {
+    FILE* file = open_shared(MATCHES_FILE, O_RDONLY, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long count = ftell(file) / (long)sizeof(RatingMatch);
+    fclose(file);
+    return count;
+}
+
+static int compare_by_period(const void* a, const void* b) {
+    const RatingMatch* ma = a;
+    const RatingMatch* mb = b;
+    return (int)ma->period - (int)mb->period;
+}
+
+// Written to a temp file and renamed over the old ladder, so a crash
+// leaves the previous one whole
+static int write_ladder(const LadderHeader* header, const RatingEntry* entries, const uint32_t* order) {
+    char path[512], temp_path[600];
+    if (!ladder_path(path, sizeof(path))) return 0;
+#ifndef _WIN32
+    int fd = highscore_create_temp(path, temp_path, sizeof(temp_path));
+    if (fd < 0) return 0;
+    FILE* file = fdopen(fd, "wb");
+    if (!file) {
+        close(fd);
+        remove(temp_path);
+        return 0;
+    }
+#else
+    if (snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(temp_path)) {
+        return 0;
+    }
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) return 0;
+#endif
+    uint32_t count = header->player_count;
+    int ok = fwrite(header, sizeof(*header), 1, file) == 1 &&
+             fwrite(entries, sizeof(RatingEntry), count, file) == count &&
+             fwrite(order, sizeof(uint32_t), count, file) == count;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+// Replays the whole match log and rewrites the ladder file
+int ratings_rerate(const RatingParams* params) {
+    long count = logged_match_count();
+    RatingMatch* matches = NULL;
+    RatingPool pool;
+    uint32_t final_period = ratings_current_period();
+    int sorted = 1;
+
+    registry_loaded = 0;                        // Others may have registered since
+    load_registry();
+    if (count > 0) {
+        matches = malloc((size_t)count * sizeof(RatingMatch));
+        FILE* file = open_shared(MATCHES_FILE, O_RDONLY, "rb");
+        if (!matches || !file || fread(matches, sizeof(RatingMatch), (size_t)count, file) != (size_t)count) {
+            if (file) fclose(file);
+            free(matches);
+            return 0;
+        }
+        fclose(file);
+    }
+
+    for (long i = 0; i < count; i++) {
+        if (matches[i].player_a >= (uint32_t)player_count || matches[i].player_b >= (uint32_t)player_count) {
+            free(matches);
+            return 0;
+        }
+        if (i > 0 && matches[i].period < matches[i - 1].period) sorted = 0;
+        if (matches[i].period > final_period) final_period = matches[i].period;
+    }
+    if (!sorted) qsort(matches, (size_t)count, sizeof(RatingMatch), compare_by_period);
+
+    if (!ratings_pool_init(&pool, player_count, params)) {
+        free(matches);
+        return 0;
+    }
+    ratings_rate_matches(&pool, params, matches, count, final_period);
+    free(matches);
+
+    uint32_t order[RATINGS_MAX_PLAYERS];
+    RatingEntry entries[RATINGS_MAX_PLAYERS];
+    ratings_rank_order(&pool, order);
+    for (int i = 0; i < player_count; i++) {
+        ratings_pool_entry(&pool, (int)order[i], &entries[order[i]]);
+        entries[order[i]].rank = (uint32_t)i + 1;
+    }
+    ratings_pool_free(&pool);
+
+    LadderHeader header = {LADDER_MAGIC, LADDER_VERSION, (uint32_t)count,
+                           (uint32_t)player_count, final_period, 0, params->tau};
+    return write_ladder(&header, entries, order);
+}
+
+// Opens the ladder, re-rating first if matches were logged since it was built
+static FILE* open_ladder(LadderHeader* header) {
+    FILE* file = open_ladder_file();
+    if (file && fread(header, sizeof(*header), 1, file) == 1 &&
+        header->magic == LADDER_MAGIC && header->version == LADDER_VERSION &&
+        header->match_count == (uint32_t)logged_match_count()) {
+        return file;
+    }
+
+    RatingParams params = ratings_default_params();
+    if (file) {
+        if (header->magic == LADDER_MAGIC && header->tau > 0.0) params.tau = header->tau;
+        fclose(file);
+    }
+    if (!ratings_rerate(&params)) return NULL;
+
+    file = open_ladder_file();
+    if (file && fread(header, sizeof(*header), 1, file) != 1) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+static int read_entry(FILE* file, uint32_t id, RatingEntry* entry) {
+    long offset = (long)sizeof(LadderHeader) + (long)id * (long)sizeof(RatingEntry);
+    return fseek(file, offset, SEEK_SET) == 0 && fread(entry, sizeof(*entry), 1, file) == 1;
+}
+
+int ratings_lookup(const char* name, RatingEntry* entry) {
+    LadderHeader header;
+    int id = find_player(name);
+    if (id < 0) return 0;
+
+    FILE* file = open_ladder(&header);
+    if (!file) return 0;
+    int ok = (uint32_t)id < header.player_count && read_entry(file, (uint32_t)id, entry);
+    fclose(file);
+    return ok;
+}
+
+long ratings_match_count(void) {
+    return logged_match_count();
+}
+
+// Reads the top 'max' ladder rows through the rank index
+int ratings_leaderboard(RatingEntry* entries, char (*names)[RATINGS_NAME_LEN], int max,
+                        RatingLadderInfo* info) {
+    LadderHeader header;
+    int shown = 0;
+
+    load_registry();
+    FILE* file = open_ladder(&header);
+    if (!file) return 0;
+
+    long order_offset = (long)sizeof(LadderHeader) + (long)header.player_count * (long)sizeof(RatingEntry);
+    if (fseek(file, order_offset, SEEK_SET) != 0) {
+        fclose(file);
+        return 0;
+    }
+
+    uint32_t order[RATINGS_MAX_PLAYERS];
+    uint32_t wanted = header.player_count < (uint32_t)max ? header.player_count : (uint32_t)max;
+    if (wanted > RATINGS_MAX_PLAYERS) wanted = RATINGS_MAX_PLAYERS;
+    if (fread(order, sizeof(uint32_t), wanted, file) != wanted) wanted = 0;
+
+    for (uint32_t i = 0; i < wanted; i++) {
+        if (order[i] < (uint32_t)player_count && read_entry(file, order[i], &entries[shown])) {
+            memcpy(names[shown], player_names[order[i]], RATINGS_NAME_LEN);
+            shown++;
+        }
+    }
+    fclose(file);
+
+    if (info) {
+        info->players = header.player_count;
+        info->matches = header.match_count;
+        info->tau = header.tau;
+    }
+    return shown;
+}
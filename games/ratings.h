@@ -0,0 +1,119 @@
+#ifndef RATINGS_H
+#define RATINGS_H
+
+#include <stdint.h>
+
+/*
+ * Cross-game Glicko-2 rating ladder.
+ *
+ * Match results from every rated game are appended to a binary match log.
+ * Ratings are computed by replaying the log in rating periods (one week):
+ * each period's matches are reduced into per-player accumulators, then all
+ * players who played are updated in one batch over structure-of-arrays
+ * state. The result is written to an indexed ladder file (entries by player
+ * id plus a rank index), which answers lookups and leaderboard queries.
+ *
+ * Files (shared directory, see highscores.h): ratings_players.dat and
+ * ratings_matches.dat, shared by every user, and ratings_ladder_<user>.dat,
+ * each user's copy of the ladder built from them
+ */
+
+#define RATINGS_NAME_LEN 32
+#define RATINGS_MAX_PLAYERS 1024
+#define RATINGS_PERIOD_SECONDS (7 * 24 * 60 * 60)
+
+typedef enum {
+    RATING_GAME_RPS,
+    RATING_GAME_COIN_FLIP,
+    RATING_GAME_TIC_TAC_TOE,
+    RATING_GAME_F1_REACTION,
+    RATING_GAME_BLACKJACK,
+    RATING_GAME_COUNT
+} RatingGame;
+
+// Result from player_a's point of view
+typedef enum {
+    RATING_LOSS = 0,
+    RATING_DRAW = 1,
+    RATING_WIN = 2
+} RatingResult;
+
+// One log record, 12 bytes. Periods count weeks since 2024-01-01.
+typedef struct {
+    uint32_t player_a;
+    uint32_t player_b;
+    uint16_t period;
+    uint8_t game;
+    uint8_t result;
+} RatingMatch;
+
+typedef struct {
+    double tau;                 // Volatility constraint (0.3 - 1.2)
+    double initial_rating;
+    double initial_rd;
+    double initial_volatility;
+} RatingParams;
+
+// Per-player state in structure-of-arrays form, Glicko-2 scale
+typedef struct {
+    int count;
+    double* mu;
+    double* phi;
+    double* sigma;
+    double* g;                  // g(phi) for the period being rated
+    double* v_inv;              // Sum of g^2 E (1 - E) this period
+    double* delta_sum;          // Sum of g (s - E) this period
+    uint32_t* last_period;      // Last period the player was brought up to
+    uint32_t* games;
+    uint32_t* wins;
+    uint32_t* losses;
+    uint32_t* draws;
+} RatingPool;
+
+typedef struct {
+    float rating;
+    float rd;
+    float volatility;
+    uint32_t games;
+    uint32_t wins;
+    uint32_t losses;
+    uint32_t draws;
+    uint32_t rank;              // 1 = top of the ladder, 0 = unrated
+} RatingEntry;
+
+typedef struct {
+    uint32_t players;
+    uint32_t matches;
+    double tau;
+} RatingLadderInfo;
+
+// Rating engine (no file access)
+RatingParams ratings_default_params(void);
+int ratings_pool_init(RatingPool* pool, int players, const RatingParams* params);
+void ratings_pool_free(RatingPool* pool);
+void ratings_rate_matches(RatingPool* pool, const RatingParams* params,
+                          const RatingMatch* matches, long count, uint32_t final_period);
+void ratings_pool_entry(const RatingPool* pool, int player, RatingEntry* entry);
+void ratings_rank_order(const RatingPool* pool, uint32_t* order);
+
+// Single-player Glicko-2 step on the rating scale, as in Glickman's paper
+void ratings_glicko2_update(const RatingParams* params, double* rating, double* rd,
+                            double* volatility, int opponents, const double* opp_rating,
+                            const double* opp_rd, const double* score);
+
+// Ladder service
+const char* ratings_game_name(RatingGame game);
+const char* ratings_local_player(void);
+// The local player's name as a file name part: up to 40 of [A-Za-z0-9_-],
+// anything else becomes '_', so $USER cannot reach outside the directory
+void ratings_local_file_key(char* key, int size);
+uint16_t ratings_current_period(void);
+int ratings_record_match(RatingGame game, const char* player_a, const char* player_b,
+                         RatingResult result);
+int ratings_rerate(const RatingParams* params);
+long ratings_match_count(void);
+int ratings_lookup(const char* name, RatingEntry* entry);
+int ratings_leaderboard(RatingEntry* entries, char (*names)[RATINGS_NAME_LEN], int max,
+                        RatingLadderInfo* info);
+
+#endif // RATINGS_H
@@ -1,4 +1,5 @@
 #include "games.h"
+#include "ratings.h"
 
 typedef enum {
     ROCK = 1,
@@ -91,6 +92,9 @@ void play_rock_paper_scissors(void) {
         result = determine_winner(player_choice, computer_choice);
         rounds_played++;
         
+        ratings_record_match(RATING_GAME_RPS, ratings_local_player(), "RPS Bot",
+                             result == 1 ? RATING_WIN : result == -1 ? RATING_LOSS : RATING_DRAW);
+        
         if (result == 1) {
             printf("*** You WIN this round! ***\n");
             player_score++;
@@ -0,0 +1,255 @@
+/*
+ * Retained Screen Model
+ * Part of CLI Games Pack v2.1
+ *
+ * Two character grids: the front grid mirrors what the terminal shows,
+ * the back grid holds the frame being composed. Presenting walks both
+ * row by row and writes only the runs that differ, joining runs separated
+ * by a gap shorter than the cursor move it would take to skip it.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "screen.h"
+#include "metrics.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+        #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+    #endif
+#else
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+#endif
+
+#define MERGE_GAP 6         // About the size of a cursor-move sequence
+
+static char front[SCREEN_MAX_ROWS][SCREEN_MAX_COLS];
+static char back[SCREEN_MAX_ROWS][SCREEN_MAX_COLS];
+static int front_rows, front_width;
+static int back_rows, back_width;
+static int back_row, back_col;              // Composition cursor
+static int shown_row, shown_col;            // Where the last frame left the cursor
+static int front_valid = 0;
+static int shown_terminal_rows, shown_terminal_cols;
+
+static FILE* attached_out = NULL;
+static int attached_rows, attached_cols;
+
+static char output[16384];
+static size_t output_length;
+static size_t output_total;
+
+static FILE* screen_out(void) {
+    return attached_out ? attached_out : stdout;
+}
+
+static void emit(const char* text, size_t length) {
+    if (output_length + length > sizeof(output)) {
+        fwrite(output, 1, output_length, screen_out());
+        output_length = 0;
+    }
+    memcpy(output + output_length, text, length);
+    output_length += length;
+    output_total += length;
+}
+
+static void emit_move(int row, int col) {
+    char sequence[24];
+    int length = snprintf(sequence, sizeof(sequence), "\033[%d;%dH", row + 1, col + 1);
+    emit(sequence, (size_t)length);
+}
+
+// Visible size of the terminal, or 0 when output is not an ANSI terminal
+static int terminal_size(int* rows, int* cols) {
+    if (attached_out) {
+        *rows = attached_rows;
+        *cols = attached_cols;
+        return 1;
+    }
+#ifdef _WIN32
+    static int vt_ready = -1;
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (vt_ready < 0) {
+        DWORD mode;
+        vt_ready = GetConsoleMode(console, &mode) &&
+                   SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+    if (!vt_ready || !GetConsoleScreenBufferInfo(console, &info)) return 0;
+    *rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    *cols = info.srWindow.Right - info.srWindow.Left + 1;
+    return 1;
+#else
+    struct winsize size;
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0) {
+        return 0;
+    }
+    *rows = size.ws_row;
+    *cols = size.ws_col;
+    return 1;
+#endif
+}
+
+void screen_begin(void) {
+    memset(back, ' ', sizeof(back));
+    back_rows = 1;
+    back_width = 0;
+    back_row = back_col = 0;
+}
+
+void screen_printf(const char* format, ...) {
+    char text[4096];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length >= (int)sizeof(text)) length = (int)sizeof(text) - 1;
+
+    for (int i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '\n') {
+            if (back_row < SCREEN_MAX_ROWS - 1) back_row++;
+            back_col = 0;
+            continue;
+        }
+        if (c == '\r') {
+            back_col = 0;
+            continue;
+        }
+        if (back_col < SCREEN_MAX_COLS) back[back_row][back_col] = c;
+        back_col++;
+        if (back_col > back_width) back_width = back_col;
+    }
+    if (back_row + 1 > back_rows) back_rows = back_row + 1;
+}
+
+void screen_invalidate(void) {
+    front_valid = 0;
+}
+
+void screen_attach(FILE* out, int rows, int cols) {
+    fflush(screen_out());
+    attached_out = rows > 0 ? out : NULL;
+    attached_rows = rows;
+    attached_cols = cols;
+    front_valid = 0;
+}
+
+static void repaint(int ansi) {
+#ifdef _WIN32
+    if (!ansi) {
+        fflush(stdout);
+        system("cls");          // Console without escape-sequence support
+    } else
+#endif
+    emit("\033[H\033[2J", 7);
+
+    for (int row = 0; row < back_rows; row++) {
+        int length = back_width < SCREEN_MAX_COLS ? back_width : SCREEN_MAX_COLS;
+        while (length > 0 && back[row][length - 1] == ' ') length--;
+        if (row == back_row && length < back_col) length = back_col;
+        emit(back[row], (size_t)length);
+        if (row < back_row) {
+            emit("\n", 1);
+        } else if (ansi && length != back_col) {
+            char sequence[16];
+            int n = snprintf(sequence, sizeof(sequence), "\033[%dG", back_col + 1);
+            emit(sequence, (size_t)n);
+        }
+    }
+}
+
+static void update(void) {
+    int cursor_row = shown_row, cursor_col = shown_col;
+
+    // Wipe the input echo and any message printed after the last prompt
+    emit_move(shown_row, shown_col);
+    emit("\033[J", 3);
+    if (shown_col < SCREEN_MAX_COLS) {
+        memset(front[shown_row] + shown_col, ' ', (size_t)(SCREEN_MAX_COLS - shown_col));
+    }
+    for (int row = shown_row + 1; row < SCREEN_MAX_ROWS; row++) {
+        memset(front[row], ' ', SCREEN_MAX_COLS);
+    }
+
+    int rows = back_rows > front_rows ? back_rows : front_rows;
+    int width = back_width > front_width ? back_width : front_width;
+    if (width > SCREEN_MAX_COLS) width = SCREEN_MAX_COLS;
+
+    for (int row = 0; row < rows; row++) {
+        const char* want = back[row];
+        const char* have = front[row];
+        int col = 0;
+        while (col < width) {
+            while (col < width && want[col] == have[col]) col++;
+            if (col == width) break;
+
+            // Text removed from the end of a row: erase instead of overwriting
+            int blank = col;
+            while (blank < width && want[blank] == ' ') blank++;
+            if (blank == width && width - col > 3) {
+                if (row != cursor_row || col != cursor_col) emit_move(row, col);
+                emit("\033[K", 3);
+                cursor_row = row;
+                cursor_col = col;
+                break;
+            }
+
+            // Extend the run across short stretches of unchanged cells
+            int end = col + 1, same = 0;
+            for (int scan = end; scan < width && same <= MERGE_GAP; scan++) {
+                if (want[scan] != have[scan]) {
+                    end = scan + 1;
+                    same = 0;
+                } else {
+                    same++;
+                }
+            }
+
+            if (row != cursor_row || col != cursor_col) emit_move(row, col);
+            emit(want + col, (size_t)(end - col));
+            cursor_row = row;
+            cursor_col = end;
+            col = end;
+        }
+    }
+
+    if (cursor_row != back_row || cursor_col != back_col) emit_move(back_row, back_col);
+}
+
+size_t screen_present(void) {
+    int rows = 0, cols = 0;
+    int ansi = terminal_size(&rows, &cols);
+    int fits = ansi && back_rows + SCREEN_SCRATCH_ROWS <= rows && back_width < cols;
+
+    output_length = 0;
+    output_total = 0;
+    if (fits && front_valid && rows == shown_terminal_rows && cols == shown_terminal_cols) {
+        update();
+    } else {
+        repaint(ansi);
+    }
+
+    fwrite(output, 1, output_length, screen_out());
+    fflush(screen_out());
+
+    memcpy(front, back, sizeof(front));
+    front_rows = back_rows;
+    front_width = back_width;
+    shown_row = back_row;
+    shown_col = back_col < SCREEN_MAX_COLS ? back_col : SCREEN_MAX_COLS - 1;
+    shown_terminal_rows = rows;
+    shown_terminal_cols = cols;
+    front_valid = fits;
+    metrics_observe(METRICS_FRAME_BYTES, output_total);
+    return output_total;
+}
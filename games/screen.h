@@ -0,0 +1,43 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/*
+ * Retained screen model for turn-based games and Tetris.
+ *
+ * A game composes each frame with screen_begin() and screen_printf()
+ * exactly as it would print it, then calls screen_present(). The model
+ * remembers what is already on the terminal and emits only the cells
+ * that differ, so revealing a region, moving a tile or updating a score
+ * costs bytes in proportion to what changed rather than a full repaint.
+ *
+ * The cursor is left where the composed text ends, so a frame that ends
+ * in a prompt reads input in place. Whatever the player types there, and
+ * any short message printed after it, is wiped by the next present.
+ * Anything else written to the terminal between frames (a help screen,
+ * a menu) must be followed by screen_invalidate().
+ *
+ * Frames are plain ASCII. A frame that does not fit the terminal, or
+ * output that is not a terminal, falls back to clearing and repainting.
+ */
+
+#define SCREEN_MAX_ROWS 128
+#define SCREEN_MAX_COLS 128
+#define SCREEN_SCRATCH_ROWS 3     // Rows kept free below a frame for input echo
+
+void screen_begin(void);
+void screen_printf(const char* format, ...);
+
+// Brings the terminal up to date with the composed frame; returns bytes written
+size_t screen_present(void);
+
+// Forgets what is on the terminal: the next present repaints everything
+void screen_invalidate(void);
+
+// Sends frames to out as if it were a terminal of the given size instead
+// of stdout (rows of 0 restores stdout and its real size)
+void screen_attach(FILE* out, int rows, int cols);
+
+#endif // SCREEN_H
@@ -3,6 +3,8 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include "daily.h"
+#include "screen.h"
 
 #define BOARD_SIZE 4
 #define EMPTY_TILE 0
@@ -11,12 +13,14 @@ typedef struct {
     int board[BOARD_SIZE][BOARD_SIZE];
     int empty_row, empty_col;
     int moves;
+    int optimal;                // Shortest solution when known, else 0
 } SlidingPuzzle;
 
 // Function prototypes
 void display_puzzle_board(SlidingPuzzle *puzzle);
 void display_puzzle_menu(void);
 void init_solved_board(SlidingPuzzle *puzzle);
+int load_daily_board(SlidingPuzzle *puzzle);
 void shuffle_board(SlidingPuzzle *puzzle, int difficulty);
 int is_solvable(SlidingPuzzle *puzzle);
 int move_tile(SlidingPuzzle *puzzle, char direction);
@@ -39,7 +43,7 @@ void play_sliding_puzzle() {
 
     while (1) {
         display_puzzle_menu();
-        printf("Enter your choice (1-5): ");
+        printf("Enter your choice (1-7): ");
         
         if (scanf("%d", &choice) != 1) {
             while (getchar() != '\n'); // Clear input buffer
@@ -70,20 +74,29 @@ void play_sliding_puzzle() {
                 play_game(&puzzle);
                 break;
                 
-            case 4: // Instructions
+            case 4: // Today's shared scramble
+                if (!load_daily_board(&puzzle)) {
+                    printf("\nToday's puzzle is still being prepared - try again in a moment.\n\n");
+                    break;
+                }
+                printf("\nStarting today's DAILY puzzle (solvable in %d moves)...\n", puzzle.optimal);
+                play_game(&puzzle);
+                break;
+                
+            case 5: // Instructions
                 show_instructions();
                 break;
                 
-            case 5: // Solution demo
+            case 6: // Solution demo
                 show_solution_animation();
                 break;
                 
-            case 6: // Exit
+            case 7: // Exit
                 printf("Thanks for playing 15-Puzzle! Goodbye!\n");
                 return;
                 
             default:
-                printf("Invalid choice! Please select 1-6.\n\n");
+                printf("Invalid choice! Please select 1-7.\n\n");
         }
     }
 }
@@ -95,9 +108,10 @@ void display_puzzle_menu(void) {
     printf("|  1. Play Easy   (50 shuffles)      |\n");
     printf("|  2. Play Medium (100 shuffles)     |\n");
     printf("|  3. Play Hard   (200 shuffles)     |\n");
-    printf("|  4. How to Play                     |\n");
-    printf("|  5. See Solution Demo               |\n");
-    printf("|  6. Exit                            |\n");
+    printf("|  4. Daily Challenge                 |\n");
+    printf("|  5. How to Play                     |\n");
+    printf("|  6. See Solution Demo               |\n");
+    printf("|  7. Exit                            |\n");
     printf("+---------------------------------------+\n");
 }
 
@@ -115,6 +129,27 @@ void init_solved_board(SlidingPuzzle *puzzle) {
         }
     }
     puzzle->moves = 0;
+    puzzle->optimal = 0;
+}
+
+// Everyone gets the same scramble today, with its optimal length precomputed.
+// Returns 0 while today's pack is still being made.
+int load_daily_board(SlidingPuzzle *puzzle) {
+    DailyChallenge daily;
+    if (daily_load(daily_today(), &daily) == DAILY_PENDING) return 0;
+    
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            puzzle->board[i][j] = daily.tiles[i * BOARD_SIZE + j];
+            if (puzzle->board[i][j] == EMPTY_TILE) {
+                puzzle->empty_row = i;
+                puzzle->empty_col = j;
+            }
+        }
+    }
+    puzzle->moves = 0;
+    puzzle->optimal = daily.optimal_moves;
+    return 1;
 }
 
 void shuffle_board(SlidingPuzzle *puzzle, int difficulty) {
@@ -162,29 +197,30 @@ int is_solvable(SlidingPuzzle *puzzle) {
     }
 }
 
+// Compose the board into the screen model; the caller presents it
 void display_puzzle_board(SlidingPuzzle *puzzle) {
-    printf("\n");
-    printf("     Moves: %d\n", puzzle->moves);
-    printf("   +----+----+----+----+\n");
+    screen_printf("\n");
+    screen_printf("     Moves: %d\n", puzzle->moves);
+    screen_printf("   +----+----+----+----+\n");
     
     for (int i = 0; i < BOARD_SIZE; i++) {
-        printf("   |");
+        screen_printf("   |");
         for (int j = 0; j < BOARD_SIZE; j++) {
             if (puzzle->board[i][j] == EMPTY_TILE) {
-                printf("    ");
+                screen_printf("    ");
             } else {
-                printf(" %2d ", puzzle->board[i][j]);
+                screen_printf(" %2d ", puzzle->board[i][j]);
             }
-            printf("|");
+            screen_printf("|");
         }
-        printf("\n");
+        screen_printf("\n");
         
         if (i < BOARD_SIZE - 1) {
-            printf("   +----+----+----+----+\n");
+            screen_printf("   +----+----+----+----+\n");
         }
     }
-    printf("   +----+----+----+----+\n");
-    printf("\nControls: W(up) A(left) S(down) D(right) Q(quit)\n");
+    screen_printf("   +----+----+----+----+\n");
+    screen_printf("\nControls: W(up) A(left) S(down) D(right) Q(quit)\n");
 }
 
 int move_tile(SlidingPuzzle *puzzle, char direction) {
@@ -251,34 +287,42 @@ void play_game(SlidingPuzzle *puzzle) {
         shuffle_board(puzzle, 10);
     }
     
-    printf("\nPuzzle generated! Let's solve it!\n");
+    const char* status = "Puzzle generated! Let's solve it!";
+    screen_invalidate();
     
     while (1) {
+        // Only the two tiles a move swaps and the move counter are redrawn
+        screen_begin();
+        screen_printf("\n%s\n", status);
         display_puzzle_board(puzzle);
         
         if (is_solved(puzzle)) {
+            screen_present();
             printf("\n");
             printf("🎉 CONGRATULATIONS! 🎉\n");
             printf("You solved the puzzle in %d moves!\n", puzzle->moves);
+            if (puzzle->optimal > 0) {
+                printf("The shortest solution takes %d moves%s\n", puzzle->optimal,
+                       puzzle->moves == puzzle->optimal ? " - a perfect solve!" : ".");
+            }
             printf("Press any key to continue...");
             getchar();
             return;
         }
         
-        printf("Your move: ");
+        screen_printf("Your move: ");
+        screen_present();
         input = getchar();
-        while (getchar() != '\n'); // Clear input buffer
+        if (input != '\n') {
+            while (getchar() != '\n'); // Clear input buffer
+        }
         
         if (tolower(input) == 'q') {
             printf("Game quit. Returning to menu...\n");
             return;
         }
         
-        if (!move_tile(puzzle, input)) {
-            printf("Invalid move! Use W/A/S/D to move tiles.\n");
-            printf("Press any key to continue...");
-            getchar();
-        }
+        status = move_tile(puzzle, input) ? "" : "Invalid move! Use W/A/S/D to move tiles.";
     }
 }
 
@@ -305,6 +349,8 @@ void show_instructions(void) {
     printf("  • Easy: 50 random shuffles\n");
     printf("  • Medium: 100 random shuffles\n");
     printf("  • Hard: 200 random shuffles\n");
+    printf("  • Daily: today's scramble, the same for everyone,\n");
+    printf("    with its shortest solution length shown\n");
     printf("\n");
     printf("TIPS:\n");
     printf("  • Start by getting the top row correct\n");
@@ -319,14 +365,15 @@ void show_instructions(void) {
 void show_solution_animation(void) {
     SlidingPuzzle demo;
     
-    printf("\n");
-    printf("===============================================\n");
-    printf("            SOLUTION DEMONSTRATION            \n");
-    printf("===============================================\n");
-    printf("\nThis is what a solved 15-puzzle looks like:\n");
-    
     init_solved_board(&demo);
+    screen_begin();
+    screen_printf("\n");
+    screen_printf("===============================================\n");
+    screen_printf("            SOLUTION DEMONSTRATION            \n");
+    screen_printf("===============================================\n");
+    screen_printf("\nThis is what a solved 15-puzzle looks like:\n");
     display_puzzle_board(&demo);
+    screen_present();
     
     printf("\nPress any key to return to menu...");
     getchar();
@@ -1,4 +1,6 @@
 #include "games.h"
+#include "alias_table.h"
+#include "jackpot.h"
 #ifdef _WIN32
     #include <windows.h>
     #include <conio.h>
@@ -15,8 +17,7 @@
 #define MIN_BET 1
 #define MAX_BET 25
 #define STARTING_CREDITS 100
-#define STARTING_JACKPOT 1000
-#define JACKPOT_CONTRIBUTION 0.01  // 1% of each bet goes to jackpot
+#define JACKPOT_PERCENT 1          // 1% of each bet goes to the shared jackpot
 #define REEL_POSITIONS 8
 
 // Symbol constants
@@ -30,13 +31,16 @@
 #define SYMBOL_WILD 7       // ???
 
 // Symbol probabilities (out of 100)
-static int symbol_weights[] = {25, 20, 20, 15, 10, 7, 2, 1};
+static const uint32_t symbol_weights[REEL_POSITIONS] = {25, 20, 20, 15, 10, 7, 2, 1};
+
+// Built once from symbol_weights; every reel draws from it
+static AliasTable symbol_table;
+static FastRng reel_rng;
 
 // Game state structure
 typedef struct {
     int credits;
     int current_bet;
-    int jackpot_amount;
     int total_spins;
     int total_bet;
     int total_won;
@@ -69,9 +73,11 @@ void auto_play_mode(void);
 
 // Generate three completely independent symbols
 void generate_three_symbols(int *reel1, int *reel2, int *reel3) {
-    *reel1 = rand() % 8;
-    *reel2 = rand() % 8;
-    *reel3 = rand() % 8;
+    uint8_t reels[3];
+    alias_table_sample_batch(&symbol_table, &reel_rng, reels, 3);
+    *reel1 = reels[0];
+    *reel2 = reels[1];
+    *reel3 = reels[2];
 }
 char* get_symbol_display(int symbol) {
     static char display[4];
@@ -108,23 +114,13 @@ char* get_symbol_name(int symbol) {
 
 // Generate random symbol based on weights
 int get_random_symbol(void) {
-    int random_num = rand() % 100;
-    int cumulative = 0;
-    
-    for (int i = 0; i < 8; i++) {
-        cumulative += symbol_weights[i];
-        if (random_num < cumulative) {
-            return i;
-        }
-    }
-    return SYMBOL_CHERRY; // Fallback
+    return alias_table_sample(&symbol_table, &reel_rng);
 }
 
 // Initialize game state
 void init_slot_machine(void) {
     slot_game.credits = STARTING_CREDITS;
     slot_game.current_bet = MIN_BET;
-    slot_game.jackpot_amount = STARTING_JACKPOT;
     slot_game.total_spins = 0;
     slot_game.total_bet = 0;
     slot_game.total_won = 0;
@@ -138,6 +134,14 @@ void init_slot_machine(void) {
     slot_game.last_win = 0;
     
     srand(time(NULL));
+    fast_rng_seed_from_rand(&reel_rng);
+    alias_table_build(&symbol_table, symbol_weights, REEL_POSITIONS);
+    jackpot_open();
+}
+
+// The progressive jackpot every running slot session pays into
+static int current_jackpot(void) {
+    return (int)(jackpot_amount() / 100);
 }
 
 // Display game rules
@@ -155,6 +159,7 @@ void display_slot_rules(void) {
     printf("| * Spin the reels and match symbols      |\n");
     printf("| * Win credits based on combinations     |\n");
     printf("| * Hit 3 Wilds on max bet for JACKPOT!   |\n");
+    printf("| * Every player's bets grow one jackpot  |\n");
     printf("|                                          |\n");
     printf("| CONTROLS:                                |\n");
     printf("| [S] Spin Reels     [B] Change Bet       |\n");
@@ -189,7 +194,7 @@ void display_payout_table(void) {
     printf("| One Wild:           3x bet               |\n");
     printf("|                                          |\n");
     printf("| JACKPOT: 3 Wilds on Max Bet (25)        |\n");
-    printf("| Current Jackpot: %d credits              |\n", slot_game.jackpot_amount);
+    printf("| Current Jackpot: %d credits              |\n", current_jackpot());
     printf("+==========================================+\n");
     printf("\nPress any key to continue...");
     getchar();
@@ -204,7 +209,7 @@ void display_slot_interface(void) {
     printf("| Credits: %-6d  Bet: %-2d  Last Win: %-4d |\n", 
            slot_game.credits, slot_game.current_bet, slot_game.last_win);
     printf("| Jackpot: %-6d  Spins: %-4d            |\n", 
-           slot_game.jackpot_amount, slot_game.total_spins);
+           current_jackpot(), slot_game.total_spins);
     printf("+==========================================+\n");
     printf("\n");
     printf("    REEL 1    REEL 2    REEL 3\n");
@@ -283,7 +288,7 @@ void spin_reels(void) {
     slot_game.credits -= slot_game.current_bet;
     slot_game.total_bet += slot_game.current_bet;
     slot_game.total_spins++;
-    slot_game.jackpot_amount += (int)(slot_game.current_bet * JACKPOT_CONTRIBUTION);
+    jackpot_contribute((uint32_t)(slot_game.current_bet * JACKPOT_PERCENT));   // In hundredths
     
     printf("\nSpinning the reels...\n");
     animate_spinning();
@@ -372,9 +377,8 @@ void calculate_payout(int win_type) {
         case 11: payout = slot_game.current_bet * 1000; break; // Three wilds (no jackpot)
         case 12: payout = slot_game.current_bet * 3; break;   // One wild
         case 100: // Jackpot
-            payout = slot_game.jackpot_amount;
+            payout = (int)jackpot_claim();  // Resets it for everyone
             slot_game.jackpots_hit++;
-            slot_game.jackpot_amount = STARTING_JACKPOT; // Reset jackpot
             break;
         default: payout = 0; break;
     }
@@ -412,7 +416,7 @@ void display_statistics(void) {
     printf("| Best Streak: %-3d                       |\n", slot_game.best_streak);
     printf("|                                          |\n");
     printf("| Jackpots Hit: %-2d                       |\n", slot_game.jackpots_hit);
-    printf("| Current Jackpot: %-6d                  |\n", slot_game.jackpot_amount);
+    printf("| Current Jackpot: %-6d                  |\n", current_jackpot());
     printf("+==========================================+\n");
     printf("\nPress any key to continue...");
     getchar();
@@ -441,7 +445,7 @@ void auto_play_mode(void) {
         printf("+==========================================+\n");
         printf("| Spin: %d/%-2d                             |\n", i + 1, auto_spins);
         printf("| Credits: %-6d  Bet: %-2d               |\n", slot_game.credits, slot_game.current_bet);
-        printf("| Jackpot: %-6d                          |\n", slot_game.jackpot_amount);
+        printf("| Jackpot: %-6d                          |\n", current_jackpot());
         printf("+==========================================+\n");
         
         // Show spinning message
@@ -475,7 +479,7 @@ void auto_play_mode(void) {
             printf("+==========================================+\n");
             printf("| Spin: %d/%-2d                             |\n", i + 1, auto_spins);
             printf("| Credits: %-6d  Bet: %-2d               |\n", slot_game.credits, slot_game.current_bet);
-            printf("| Jackpot: %-6d                          |\n", slot_game.jackpot_amount);
+            printf("| Jackpot: %-6d                          |\n", current_jackpot());
             printf("+==========================================+\n\n");
             printf("*** SPINNING REELS ***\n\n");
             #endif
@@ -485,7 +489,7 @@ void auto_play_mode(void) {
         slot_game.credits -= slot_game.current_bet;
         slot_game.total_bet += slot_game.current_bet;
         slot_game.total_spins++;
-        slot_game.jackpot_amount += (int)(slot_game.current_bet * JACKPOT_CONTRIBUTION);
+        jackpot_contribute((uint32_t)(slot_game.current_bet * JACKPOT_PERCENT));   // In hundredths
         
         // Generate final results using simplified independent generation
         generate_three_symbols(&slot_game.reel1, &slot_game.reel2, &slot_game.reel3);
@@ -497,7 +501,7 @@ void auto_play_mode(void) {
         printf("+==========================================+\n");
         printf("| Spin: %d/%-2d                             |\n", i + 1, auto_spins);
         printf("| Credits: %-6d  Bet: %-2d               |\n", slot_game.credits, slot_game.current_bet);
-        printf("| Jackpot: %-6d                          |\n", slot_game.jackpot_amount);
+        printf("| Jackpot: %-6d                          |\n", current_jackpot());
         printf("+==========================================+\n\n");
         
         printf("    REEL 1    REEL 2    REEL 3\n");
@@ -649,6 +653,7 @@ void play_slot_machine(void) {
             case 'q':
             case 'Q':
                 printf("\nThanks for playing! Final credits: %d\n", slot_game.credits);
+                jackpot_close();
                 return;
                 
             default:
@@ -658,6 +663,7 @@ void play_slot_machine(void) {
         }
     }
     
+    jackpot_close();
     printf("\nGame Over! You're out of credits.\n");
     printf("Better luck next time!\n");
 }
\ No newline at end of file
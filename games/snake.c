@@ -1,14 +1,18 @@
 #include "games.h"
+#include "alias_table.h"
+#include "flight_recorder.h"
+#include "terminal.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "ratings.h"
 #ifdef _WIN32
     #include <windows.h>
     #include <conio.h>
-    #define SLEEP(ms) Sleep(ms)
     #define CLEAR_SCREEN() system("cls")
 #else
     #include <unistd.h>
     #include <termios.h>
     #include <fcntl.h>
-    #define SLEEP(ms) usleep(ms * 1000)
     #define CLEAR_SCREEN() system("clear")
 #endif
 
@@ -19,6 +23,7 @@
 #define INITIAL_SPEED 200
 #define SPEED_INCREASE 15
 #define INITIAL_LENGTH 3
+#define TURN_QUEUE_SIZE 8
 
 // Direction constants
 #define DIR_UP 1
@@ -30,6 +35,11 @@
 #define FOOD_NORMAL 1
 #define FOOD_SPECIAL 2
 #define FOOD_POWERUP 3
+#define FOOD_TYPE_COUNT 3
+
+// Food odds (90% normal, 8% special, 2% powerup) and points, by type - 1
+static const uint32_t food_weights[FOOD_TYPE_COUNT] = {90, 8, 2};
+static const int food_values[FOOD_TYPE_COUNT] = {10, 50, 100};
 
 // Game structures
 typedef struct {
@@ -40,9 +50,15 @@ typedef struct {
     Position segments[MAX_SNAKE_LENGTH];
     int length;
     int direction;
-    int next_direction;  // For smooth direction changes
 } Snake;
 
+// Turns typed faster than the snake moves wait here, one applied per tick
+typedef struct {
+    int turns[TURN_QUEUE_SIZE];
+    int head;
+    int count;
+} TurnQueue;
+
 typedef struct {
     Position pos;
     int type;
@@ -52,6 +68,7 @@ typedef struct {
 
 // Global game variables
 static Snake snake;
+static TurnQueue turn_queue;
 static Food food;
 static int game_speed;
 static int score;
@@ -59,41 +76,8 @@ static int high_score;
 static int food_eaten;
 static int game_running;
 static int speed_level;
-
-// Function to check if a key is pressed (cross-platform)
-#ifdef _WIN32
-int snake_kbhit(void) {
-    return _kbhit();
-}
-
-int snake_get_key(void) {
-    return _getch();
-}
-#else
-int snake_kbhit(void) {
-    struct termios oldt, newt;
-    int oldf;
-    int ch;
-    
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-    
-    ch = getchar();
-    
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
-    
-    return (ch != EOF) ? ch : 0;
-}
-
-int snake_get_key(void) {
-    return getchar();
-}
-#endif
+static AliasTable food_table;
+static FastRng food_rng;
 
 // Function to move cursor to specific position
 void snake_goto_xy(int x, int y) {
@@ -136,7 +120,8 @@ void init_snake_game(void) {
     // Initialize snake in the center
     snake.length = INITIAL_LENGTH;
     snake.direction = DIR_RIGHT;
-    snake.next_direction = DIR_RIGHT;
+    turn_queue.head = 0;
+    turn_queue.count = 0;
     
     int start_x = GRID_WIDTH / 2;
     int start_y = GRID_HEIGHT / 2;
@@ -157,9 +142,12 @@ void init_snake_game(void) {
     food.active = 0;
     
     srand(time(NULL));
+    fast_rng_seed_from_rand(&food_rng);
+    alias_table_build(&food_table, food_weights, FOOD_TYPE_COUNT);
     
-    // Load high score (simplified - could be saved to file)
-    high_score = 500; // Default high score
+    // Best score across every player on this machine
+    high_score = (int)highscore_best(HIGHSCORE_SNAKE, 0);
+    if (high_score < 500) high_score = 500; // Default high score
 }
 
 // Check if position is occupied by snake
@@ -178,23 +166,14 @@ void spawn_food(void) {
     
     int attempts = 0;
     do {
-        food.pos.x = rand() % GRID_WIDTH;
-        food.pos.y = rand() % GRID_HEIGHT;
+        food.pos.x = (int)fast_rng_below(&food_rng, GRID_WIDTH);
+        food.pos.y = (int)fast_rng_below(&food_rng, GRID_HEIGHT);
         attempts++;
     } while (is_snake_position(food.pos.x, food.pos.y) && attempts < 100);
     
-    // Determine food type (90% normal, 8% special, 2% powerup)
-    int food_type_rand = rand() % 100;
-    if (food_type_rand < 90) {
-        food.type = FOOD_NORMAL;
-        food.value = 10;
-    } else if (food_type_rand < 98) {
-        food.type = FOOD_SPECIAL;
-        food.value = 50;
-    } else {
-        food.type = FOOD_POWERUP;
-        food.value = 100;
-    }
+    int kind = alias_table_sample(&food_table, &food_rng);
+    food.type = FOOD_NORMAL + kind;
+    food.value = food_values[kind];
     
     food.active = 1;
 }
@@ -260,103 +239,74 @@ void draw_snake_grid(void) {
     printf("Eat food (*$!) to grow and score points!\n");
 }
 
-// Handle player input
+static int opposite_direction(int direction) {
+    switch (direction) {
+        case DIR_UP: return DIR_DOWN;
+        case DIR_DOWN: return DIR_UP;
+        case DIR_LEFT: return DIR_RIGHT;
+        default: return DIR_LEFT;
+    }
+}
+
+// Queue a turn relative to the heading the snake will have once every
+// queued turn has run; reversals and repeats are dropped here so they
+// never waste a tick
+static void queue_turn(int direction) {
+    int heading = snake.direction;
+    if (turn_queue.count > 0) {
+        heading = turn_queue.turns[(turn_queue.head + turn_queue.count - 1) % TURN_QUEUE_SIZE];
+    }
+    if (direction == heading || direction == opposite_direction(heading)) return;
+    if (turn_queue.count == TURN_QUEUE_SIZE) return;   // Player is a full queue ahead
+    
+    turn_queue.turns[(turn_queue.head + turn_queue.count) % TURN_QUEUE_SIZE] = direction;
+    turn_queue.count++;
+}
+
+// Handle player input: drain every waiting key without blocking
 void handle_snake_input(void) {
-    if (snake_kbhit()) {
-        int key = snake_get_key();
+    int key;
+    
+    while ((key = terminal_read_key()) != TERM_KEY_NONE) {
+        flight_recorder_input(key);
         
         switch (key) {
             case 'w':
             case 'W':
-                if (snake.direction != DIR_DOWN) {
-                    snake.next_direction = DIR_UP;
-                }
+            case TERM_KEY_UP:
+                queue_turn(DIR_UP);
                 break;
             case 's':
             case 'S':
-                if (snake.direction != DIR_UP) {
-                    snake.next_direction = DIR_DOWN;
-                }
+            case TERM_KEY_DOWN:
+                queue_turn(DIR_DOWN);
                 break;
             case 'a':
             case 'A':
-                if (snake.direction != DIR_RIGHT) {
-                    snake.next_direction = DIR_LEFT;
-                }
+            case TERM_KEY_LEFT:
+                queue_turn(DIR_LEFT);
                 break;
             case 'd':
             case 'D':
-                if (snake.direction != DIR_LEFT) {
-                    snake.next_direction = DIR_RIGHT;
-                }
+            case TERM_KEY_RIGHT:
+                queue_turn(DIR_RIGHT);
                 break;
             case 'q':
             case 'Q':
                 game_running = 0;
                 break;
-#ifdef _WIN32
-            case 224:  // Arrow key prefix on Windows
-                key = snake_get_key();
-                switch (key) {
-                    case 72:  // Up arrow
-                        if (snake.direction != DIR_DOWN) {
-                            snake.next_direction = DIR_UP;
-                        }
-                        break;
-                    case 80:  // Down arrow
-                        if (snake.direction != DIR_UP) {
-                            snake.next_direction = DIR_DOWN;
-                        }
-                        break;
-                    case 75:  // Left arrow
-                        if (snake.direction != DIR_RIGHT) {
-                            snake.next_direction = DIR_LEFT;
-                        }
-                        break;
-                    case 77:  // Right arrow
-                        if (snake.direction != DIR_LEFT) {
-                            snake.next_direction = DIR_RIGHT;
-                        }
-                        break;
-                }
-                break;
-#else
-            case 27:  // ESC sequence for arrow keys on Unix
-                if (snake_get_key() == 91) {
-                    key = snake_get_key();
-                    switch (key) {
-                        case 65:  // Up arrow
-                            if (snake.direction != DIR_DOWN) {
-                                snake.next_direction = DIR_UP;
-                            }
-                            break;
-                        case 66:  // Down arrow
-                            if (snake.direction != DIR_UP) {
-                                snake.next_direction = DIR_DOWN;
-                            }
-                            break;
-                        case 68:  // Left arrow
-                            if (snake.direction != DIR_RIGHT) {
-                                snake.next_direction = DIR_LEFT;
-                            }
-                            break;
-                        case 67:  // Right arrow
-                            if (snake.direction != DIR_LEFT) {
-                                snake.next_direction = DIR_RIGHT;
-                            }
-                            break;
-                    }
-                }
-                break;
-#endif
         }
     }
 }
 
 // Move snake based on current direction
 void move_snake(void) {
-    // Update direction (allows for smooth direction changes)
-    snake.direction = snake.next_direction;
+    // Apply the next queued turn, if any
+    if (turn_queue.count > 0) {
+        snake.direction = turn_queue.turns[turn_queue.head];
+        turn_queue.head = (turn_queue.head + 1) % TURN_QUEUE_SIZE;
+        turn_queue.count--;
+    }
     
     // Calculate new head position
     Position new_head = snake.segments[0];
@@ -479,6 +429,12 @@ void display_snake_game_over(void) {
         printf("|                                           |\n");
     }
     
+    int rank = highscore_submit(HIGHSCORE_SNAKE, 0, ratings_local_player(), (uint32_t)score);
+    if (rank > 0) {
+        printf("| *** HALL OF FAME: #%-2d ***                 |\n", rank);
+        printf("|                                           |\n");
+    }
+    
     printf("| Thanks for playing Snake Game!            |\n");
     printf("+===========================================+\n");
 }
@@ -518,14 +474,22 @@ void play_snake(void) {
     init_snake_game();
     snake_hide_cursor();
     
-    // Main game loop
+    // Main game loop: keys are queued the moment they arrive and the snake
+    // moves on fixed deadlines, so input never delays or skips a tick
+    terminal_raw_begin();
+    flight_recorder_mark("snake: game loop");
+    uint64_t next_tick = terminal_now_us();
     while (game_running) {
+        // Handle input until the next move is due
+        while (game_running && terminal_wait_input(next_tick)) {
+            handle_snake_input();
+        }
+        if (!game_running) break;
+        uint64_t tick_start = flight_recorder_now_us();
+        
         // Spawn food if needed
         spawn_food();
         
-        // Handle input
-        handle_snake_input();
-        
         // Move snake
         move_snake();
         
@@ -534,10 +498,16 @@ void play_snake(void) {
         
         // Draw game
         draw_snake_grid();
+        uint64_t tick_us = flight_recorder_now_us() - tick_start;
+        flight_recorder_tick(tick_us);
+        metrics_observe(METRICS_TICK_US, tick_us);
         
-        // Game speed delay
-        SLEEP(game_speed);
+        // Game speed delay, measured from the deadline rather than from now
+        next_tick += (uint64_t)game_speed * 1000u;
+        uint64_t now = terminal_now_us();
+        if (next_tick < now) next_tick = now;
     }
+    terminal_raw_end();
     
     // Show cursor again and display game over
     snake_show_cursor();
@@ -12,6 +12,10 @@
 #include <string.h>
 #include <time.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "terminal.h"
+#include "bullet_vm.h"
+#include "metrics.h"
 
 // Platform-specific includes
 #ifdef _WIN32
@@ -114,6 +118,19 @@ typedef struct {
 
 #define MAX_EXPLOSIONS 10
 
+// Scripted boss for custom boss mode; its bullets live in boss_bullets
+typedef struct {
+    bool active;
+    int health;
+    int max_health;
+    int phase;          // Index into bullet_patterns, advancing as health drops
+    int flash;          // Frames left showing a hit
+    BulletVm vm;
+} Boss;
+
+#define BOSS_HEALTH 30
+#define BOSS_WIDTH 9
+
 // Game statistics
 typedef struct {
     char player_name[MAX_NAME_LENGTH];
@@ -144,6 +161,7 @@ typedef struct {
     Barrier barriers[NUM_BARRIERS];
     UFO ufo;
     Explosion explosions[MAX_EXPLOSIONS];
+    Boss boss;
     
     int score;
     int wave;
@@ -175,6 +193,10 @@ typedef struct {
 // Global game instance
 static SpaceInvadersGame game = {0};
 
+static BulletField boss_bullets;
+static BulletProgram boss_programs[8];
+static bool boss_programs_ready = false;
+
 // Function prototypes
 void space_invaders_clear_input_buffer(void);
 void space_invaders_display_header(const char* title);
@@ -182,12 +204,14 @@ void space_invaders_init_game(void);
 void space_invaders_init_aliens(void);
 void space_invaders_init_barriers(void);
 void space_invaders_init_player(void);
+bool space_invaders_init_boss(void);
 void space_invaders_handle_input(void);
 void space_invaders_update_game(void);
 void space_invaders_update_aliens(void);
 void space_invaders_update_bullets(void);
 void space_invaders_update_collisions(void);
 void space_invaders_update_ufo(void);
+void space_invaders_update_boss(void);
 void space_invaders_draw_screen(void);
 void space_invaders_draw_hud(void);
 void space_invaders_draw_aliens(void);
@@ -195,6 +219,7 @@ void space_invaders_draw_player(void);
 void space_invaders_draw_bullets(void);
 void space_invaders_draw_barriers(void);
 void space_invaders_draw_ufo(void);
+void space_invaders_draw_boss(void);
 void space_invaders_draw_explosions(void);
 void space_invaders_create_explosion(int x, int y, int type);
 void space_invaders_update_explosions(void);
@@ -299,14 +324,8 @@ void space_invaders_init_game(void) {
     game.marksman_ammo = 10;
     game.marksman_targets_hit = 0;
     game.endless_difficulty = 1;
-    
-    // Custom mode defaults
-    game.custom_alien_rows = 5;
-    game.custom_alien_cols = 11;
-    game.custom_alien_speed = 50;
-    game.custom_no_barriers = false;
-    game.custom_infinite_ammo = false;
-    game.custom_boss_mode = false;
+    game.boss.active = false;
+    boss_bullets.count = 0;
     
     space_invaders_init_player();
     space_invaders_init_aliens();
@@ -360,6 +379,37 @@ void space_invaders_init_aliens(void) {
     }
 }
 
+// Replaces the alien formation with a boss whose movement and fire come
+// from the bullet-pattern scripts, one pattern per third of its health
+bool space_invaders_init_boss(void) {
+    if (!boss_programs_ready) {
+        for (int i = 0; i < bullet_pattern_count && i < 8; i++) {
+            if (!bullet_program_compile(&boss_programs[i], bullet_patterns[i].source)) {
+                printf("Boss pattern '%s' failed to compile: %s\n", bullet_patterns[i].name, boss_programs[i].error);
+                return false;
+            }
+        }
+        boss_programs_ready = true;
+    }
+    
+    for (int row = 0; row < ALIEN_ROWS; row++) {
+        for (int col = 0; col < ALIEN_COLS; col++) {
+            game.aliens[row][col].alive = false;
+        }
+    }
+    game.aliens_remaining = 0;
+    
+    game.boss.active = true;
+    game.boss.max_health = BOSS_HEALTH;
+    game.boss.health = BOSS_HEALTH;
+    game.boss.phase = 0;
+    game.boss.flash = 0;
+    bullet_vm_start(&game.boss.vm, &boss_programs[0], SCREEN_WIDTH / 2, 6);
+    game.boss.vm.aspect = 2 << BULLET_FIX_SHIFT;     // Cells are about twice as tall as wide
+    bullet_field_init(&boss_bullets, SCREEN_WIDTH, SCREEN_HEIGHT);
+    return true;
+}
+
 void space_invaders_init_barriers(void) {
     const char barrier_template[BARRIER_HEIGHT][BARRIER_WIDTH + 1] = {
         "  ###  ",
@@ -385,21 +435,23 @@ void space_invaders_init_barriers(void) {
 
 // Input handling
 void space_invaders_handle_input(void) {
-    if (game.player.shoot_cooldown > 0) {
+    if (game.player.shoot_cooldown > 0 && game.state == STATE_PLAYING) {
         game.player.shoot_cooldown--;
     }
     
-#ifdef _WIN32
-    if (_kbhit()) {
-        char key = _getch();
-        
+    // Drain every key typed since the last frame, stopping at a pause toggle
+    // so keys typed after P wait for the paused state to read them
+    int key;
+    while ((key = terminal_read_key()) != TERM_KEY_NONE) {
         switch (key) {
             case 'a':
             case 'A':
+            case TERM_KEY_LEFT:
                 if (game.player.x > 2) game.player.x -= 2;
                 break;
             case 'd':
             case 'D':
+            case TERM_KEY_RIGHT:
                 if (game.player.x < SCREEN_WIDTH - 3) game.player.x += 2;
                 break;
             case ' ':
@@ -430,19 +482,12 @@ void space_invaders_handle_input(void) {
                     game.state = STATE_PLAYING;
                 }
                 break;
-            case 27: // Escape
+            case TERM_KEY_ESCAPE:
                 game.game_running = false;
                 break;
         }
+        if (key == 'p' || key == 'P') break;
     }
-#else
-    // Linux input handling would go here
-    // For now, simplified version
-    char input;
-    if (read(STDIN_FILENO, &input, 1) > 0) {
-        // Handle input similar to Windows version
-    }
-#endif
 }
 
 // Game update functions
@@ -451,12 +496,13 @@ void space_invaders_update_game(void) {
     
     space_invaders_update_aliens();
     space_invaders_update_bullets();
+    space_invaders_update_boss();
     space_invaders_update_explosions();
     space_invaders_update_collisions();
     space_invaders_update_ufo();
     
     // Check win/lose conditions
-    if (game.aliens_remaining == 0) {
+    if (game.aliens_remaining == 0 && !game.boss.active) {
         game.state = STATE_WAVE_CLEAR;
         game.wave++;
         space_invaders_play_sound("WAVE COMPLETE!");
@@ -709,16 +755,101 @@ void space_invaders_update_ufo(void) {
     }
 }
 
+void space_invaders_update_boss(void) {
+    if (!game.boss.active) return;
+    
+    bullet_field_step(&boss_bullets);
+    bullet_vm_step(&game.boss.vm, &boss_bullets, game.player.x + 1, game.player.y);
+    if (game.boss.flash > 0) game.boss.flash--;
+    
+    int boss_x = game.boss.vm.x >> BULLET_FIX_SHIFT;
+    int boss_y = game.boss.vm.y >> BULLET_FIX_SHIFT;
+    
+    // Player bullets vs boss
+    for (int b = 0; b < MAX_BULLETS && game.boss.active; b++) {
+        if (!game.bullets[b].active || game.bullets[b].direction != 1 ||
+            game.bullets[b].y != boss_y ||
+            game.bullets[b].x < boss_x - BOSS_WIDTH / 2 ||
+            game.bullets[b].x > boss_x + BOSS_WIDTH / 2) {
+            continue;
+        }
+        
+        game.bullets[b].active = false;
+        game.boss.health--;
+        game.boss.flash = 3;
+        game.score += 10;
+        
+        if (game.boss.health <= 0) {
+            game.boss.active = false;
+            boss_bullets.count = 0;
+            game.score += 1000;
+            space_invaders_create_explosion(boss_x - 1, boss_y, 2);
+            space_invaders_play_sound("BOSS DESTROYED!");
+            return;
+        }
+        
+        int phase = (game.boss.max_health - game.boss.health) * bullet_pattern_count / game.boss.max_health;
+        if (phase != game.boss.phase) {
+            int aspect = game.boss.vm.aspect;
+            game.boss.phase = phase;
+            bullet_vm_start(&game.boss.vm, &boss_programs[phase], boss_x, boss_y);
+            game.boss.vm.aspect = aspect;
+            space_invaders_play_sound("BOSS ENRAGED!");
+        }
+    }
+    
+    // Boss bullets vs player and barriers
+    for (int i = 0; i < boss_bullets.count; ) {
+        int x = boss_bullets.x[i] >> BULLET_FIX_SHIFT;
+        int y = boss_bullets.y[i] >> BULLET_FIX_SHIFT;
+        
+        if (game.player.alive && y == game.player.y &&
+            x >= game.player.x && x <= game.player.x + 2) {
+            bullet_field_remove(&boss_bullets, i);
+            game.player.lives--;
+            space_invaders_create_explosion(game.player.x, game.player.y, 1);
+            space_invaders_play_sound("PLAYER HIT!");
+            if (game.player.lives <= 0) {
+                game.player.alive = false;
+            }
+            continue;
+        }
+        
+        bool absorbed = false;
+        for (int bar = 0; bar < NUM_BARRIERS && !absorbed; bar++) {
+            int rel_x = x - game.barriers[bar].x;
+            int rel_y = y - game.barriers[bar].y;
+            if (rel_x >= 0 && rel_x < BARRIER_WIDTH && rel_y >= 0 && rel_y < BARRIER_HEIGHT &&
+                game.barriers[bar].shape[rel_y][rel_x] == '#') {
+                game.barriers[bar].damaged[rel_y][rel_x] = true;
+                game.barriers[bar].shape[rel_y][rel_x] = ' ';
+                absorbed = true;
+            }
+        }
+        if (absorbed) {
+            bullet_field_remove(&boss_bullets, i);
+        } else {
+            i++;
+        }
+    }
+}
+
 // Drawing functions
 void space_invaders_draw_screen(void) {
+#ifdef _WIN32
     CLEAR_SCREEN();
+#else
+    printf("\033[H\033[2J");    // Running clear(1) every frame took longer than the frame
+#endif
     space_invaders_draw_hud();
     space_invaders_draw_aliens();
     space_invaders_draw_barriers();
     space_invaders_draw_bullets();
     space_invaders_draw_player();
     space_invaders_draw_ufo();
+    space_invaders_draw_boss();
     space_invaders_draw_explosions();
+    fflush(stdout);             // The cursor-addressed tail has no newline to flush it
 }
 
 void space_invaders_draw_hud(void) {
@@ -821,6 +952,29 @@ void space_invaders_draw_ufo(void) {
     }
 }
 
+void space_invaders_draw_boss(void) {
+    if (!game.boss.active) return;
+    
+    int boss_x = game.boss.vm.x >> BULLET_FIX_SHIFT;
+    int boss_y = game.boss.vm.y >> BULLET_FIX_SHIFT;
+    printf("\033[%d;%dH", boss_y, boss_x - BOSS_WIDTH / 2);
+    printf(game.boss.flash ? "/=[XXX]=\\" : "/=[@@@]=\\");
+    
+    for (int i = 0; i < boss_bullets.count; i++) {
+        int y = boss_bullets.y[i] >> BULLET_FIX_SHIFT;
+        if (y < 1) continue;
+        printf("\033[%d;%dH*", y, boss_bullets.x[i] >> BULLET_FIX_SHIFT);
+    }
+    
+    // Health bar along the bottom row
+    int filled = game.boss.health * 20 / game.boss.max_health;
+    printf("\033[%d;1HBOSS [", SCREEN_HEIGHT);
+    for (int i = 0; i < 20; i++) {
+        printf(i < filled ? "#" : ".");
+    }
+    printf("] %s", bullet_patterns[game.boss.phase].name);
+}
+
 // Game mode functions
 void space_invaders_main_menu(void) {
     space_invaders_display_header("MAIN MENU");
@@ -1129,6 +1283,12 @@ void space_invaders_custom_mode(void) {
             break;
         case 7:
             space_invaders_init_game();
+            game.current_mode = MODE_CUSTOM;
+            if (game.custom_boss_mode && !space_invaders_init_boss()) {
+                printf("Press Enter to continue...");
+                getchar();
+                break;
+            }
             game.state = STATE_PLAYING;
             space_invaders_game_loop();
             break;
@@ -1183,13 +1343,39 @@ void space_invaders_show_statistics(void) {
 
 // Main game loop
 void space_invaders_game_loop(void) {
-    while (game.game_running && game.state == STATE_PLAYING) {
+    const uint64_t frame_us = 33000;    // ~30 FPS for smoother gameplay
+    
+    terminal_raw_begin();
+    uint64_t next_frame = terminal_now_us();
+    while (game.game_running &&
+           (game.state == STATE_PLAYING || game.state == STATE_PAUSED)) {
+        if (game.state == STATE_PAUSED) {
+            // Nothing changes while paused: show the banner once and sleep
+            // until a key arrives
+            printf("\n>>> PAUSED - Press P to continue <<<\n");
+            fflush(stdout);
+            while (game.game_running && game.state == STATE_PAUSED) {
+                if (!terminal_wait_input(TERMINAL_NO_DEADLINE)) {
+                    game.game_running = false;      // Input closed
+                    break;
+                }
+                space_invaders_handle_input();
+            }
+            next_frame = terminal_now_us();
+            continue;
+        }
+        
+        terminal_sleep_until(next_frame);
+        next_frame += frame_us;
+        uint64_t now = terminal_now_us();
+        if (next_frame < now) next_frame = now;
+        
         space_invaders_handle_input();
         space_invaders_update_game();
         space_invaders_draw_screen();
-        
-        SLEEP_MS(33); // ~30 FPS for smoother gameplay
+        metrics_observe(METRICS_TICK_US, terminal_now_us() - now);
     }
+    terminal_raw_end();
     
     if (game.state == STATE_GAME_OVER) {
         space_invaders_display_header("GAME OVER");
@@ -1240,6 +1426,14 @@ void play_space_invaders(void) {
     game.stats.endless_wave_record = 0;
     game.stats.custom_challenges_created = 0;
     
+    // Custom mode defaults (kept across games, unlike the per-game state)
+    game.custom_alien_rows = 5;
+    game.custom_alien_cols = 11;
+    game.custom_alien_speed = 50;
+    game.custom_no_barriers = false;
+    game.custom_infinite_ammo = false;
+    game.custom_boss_mode = false;
+    
     game.game_running = true;
     
     while (game.game_running) {
@@ -0,0 +1,237 @@
+/*
+ * Real-Time Terminal Input
+ * Part of CLI Games Pack v2.1
+ *
+ * Bytes are read straight from the stdin descriptor into a small pending
+ * buffer (bypassing stdio, whose buffering would hide keys from select()).
+ * An escape byte at the end of the buffer waits a few milliseconds for the
+ * rest of an arrow-key sequence before it is reported as a bare Escape.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "terminal.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/select.h>
+    #include <errno.h>
+#endif
+
+#define ESCAPE_WAIT_US 10000
+
+#ifndef _WIN32
+static struct termios saved_termios;
+static int termios_saved = 0;
+static int saved_flags = -1;
+static int raw_active = 0;
+static int input_closed = 0;
+static unsigned char pending[64];
+static int pending_head = 0;
+static int pending_count = 0;
+#endif
+
+uint64_t terminal_now_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000u +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000u / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+#endif
+}
+
+#ifdef _WIN32
+
+// The console already delivers unbuffered keys through _kbhit()/_getch()
+void terminal_raw_begin(void) {
+}
+
+void terminal_raw_end(void) {
+    while (_kbhit()) _getch();
+}
+
+// The console handle stays signalled while any record is queued, so drop
+// mouse, focus, key-up and modifier records that _kbhit() will never report
+static void drop_non_key_events(HANDLE input) {
+    INPUT_RECORD record;
+    DWORD count;
+    while (PeekConsoleInput(input, &record, 1, &count) && count == 1) {
+        if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown &&
+            (record.Event.KeyEvent.uChar.AsciiChar != 0 ||
+             (record.Event.KeyEvent.wVirtualKeyCode >= VK_LEFT && record.Event.KeyEvent.wVirtualKeyCode <= VK_DOWN))) {
+            return;
+        }
+        ReadConsoleInput(input, &record, 1, &count);
+    }
+}
+
+int terminal_wait_input(uint64_t deadline_us) {
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+    while (!_kbhit()) {
+        uint64_t now = terminal_now_us();
+        if (now >= deadline_us) return 0;
+        DWORD timeout = deadline_us == TERMINAL_NO_DEADLINE ? INFINITE : (DWORD)((deadline_us - now + 999) / 1000);
+        if (WaitForSingleObject(input, timeout) == WAIT_OBJECT_0 && !_kbhit()) {
+            drop_non_key_events(input);
+        }
+    }
+    return 1;
+}
+
+void terminal_sleep_until(uint64_t deadline_us) {
+    uint64_t now = terminal_now_us();
+    if (now < deadline_us) Sleep((DWORD)((deadline_us - now + 999) / 1000));
+}
+
+int terminal_read_key(void) {
+    if (!_kbhit()) return TERM_KEY_NONE;
+    int key = _getch();
+    if (key == 0 || key == 224) {
+        switch (_getch()) {
+            case 72: return TERM_KEY_UP;
+            case 80: return TERM_KEY_DOWN;
+            case 75: return TERM_KEY_LEFT;
+            case 77: return TERM_KEY_RIGHT;
+            default: return TERM_KEY_NONE;
+        }
+    }
+    return key;
+}
+
+#else
+
+void terminal_raw_begin(void) {
+    if (raw_active) return;
+    fflush(stdout);
+
+    termios_saved = tcgetattr(STDIN_FILENO, &saved_termios) == 0;
+    if (termios_saved) {
+        struct termios raw = saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    saved_flags = fcntl(STDIN_FILENO, F_GETFL, 0);
+    if (saved_flags >= 0) fcntl(STDIN_FILENO, F_SETFL, saved_flags | O_NONBLOCK);
+
+    pending_head = pending_count = 0;
+    input_closed = 0;
+    raw_active = 1;
+}
+
+void terminal_raw_end(void) {
+    if (!raw_active) return;
+    // TCSAFLUSH drops keys typed during the game along with the mode change
+    if (termios_saved) tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_termios);
+    if (saved_flags >= 0) fcntl(STDIN_FILENO, F_SETFL, saved_flags);
+    pending_head = pending_count = 0;
+    raw_active = 0;
+}
+
+// Returns bytes added, 0 at end of input, -1 when nothing is available yet
+static int fill_pending(void) {
+    if (pending_head > 0) {
+        memmove(pending, pending + pending_head, (size_t)pending_count);
+        pending_head = 0;
+    }
+    if (pending_count == (int)sizeof(pending)) return -1;
+
+    ssize_t got = read(STDIN_FILENO, pending + pending_count, sizeof(pending) - (size_t)pending_count);
+    if (got > 0) {
+        pending_count += (int)got;
+        return (int)got;
+    }
+    return got == 0 ? 0 : -1;
+}
+
+void terminal_sleep_until(uint64_t deadline_us) {
+    for (;;) {
+        uint64_t now = terminal_now_us();
+        if (now >= deadline_us) return;
+
+        struct timeval timeout;
+        timeout.tv_sec = (time_t)((deadline_us - now) / 1000000u);
+        timeout.tv_usec = (suseconds_t)((deadline_us - now) % 1000000u);
+        select(0, NULL, NULL, NULL, &timeout);
+    }
+}
+
+// Sleeps in select() until more bytes arrive or the deadline passes
+static int wait_for_bytes(uint64_t deadline_us) {
+    for (;;) {
+        uint64_t now = terminal_now_us();
+        if (now >= deadline_us) return 0;
+
+        if (input_closed) {
+            if (deadline_us == TERMINAL_NO_DEADLINE) return 0;
+            terminal_sleep_until(deadline_us);      // Nothing left to read; just sleep
+            return 0;
+        }
+
+        struct timeval timeout;
+        struct timeval* limit = NULL;          // Block indefinitely
+        if (deadline_us != TERMINAL_NO_DEADLINE) {
+            timeout.tv_sec = (time_t)((deadline_us - now) / 1000000u);
+            timeout.tv_usec = (suseconds_t)((deadline_us - now) % 1000000u);
+            limit = &timeout;
+        }
+
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(STDIN_FILENO, &readable);
+        int ready = select(STDIN_FILENO + 1, &readable, NULL, NULL, limit);
+        if (ready > 0) {
+            int got = fill_pending();
+            if (got > 0) return 1;
+            if (got == 0) input_closed = 1;     // Readable but empty: end of file or hangup
+        } else if (ready < 0 && errno != EINTR) {
+            input_closed = 1;
+        }
+    }
+}
+
+int terminal_wait_input(uint64_t deadline_us) {
+    if (pending_count > 0) return 1;
+    return wait_for_bytes(deadline_us);
+}
+
+static int pop_pending(void) {
+    pending_count--;
+    return pending[pending_head++];
+}
+
+int terminal_read_key(void) {
+    if (pending_count == 0 && fill_pending() <= 0) return TERM_KEY_NONE;
+
+    int key = pop_pending();
+    if (key != TERM_KEY_ESCAPE) return key;
+
+    uint64_t deadline = terminal_now_us() + ESCAPE_WAIT_US;
+    while (pending_count < 2 && wait_for_bytes(deadline)) {
+    }
+    if (pending_count >= 2 && (pending[pending_head] == '[' || pending[pending_head] == 'O')) {
+        switch (pending[pending_head + 1]) {
+            case 'A': key = TERM_KEY_UP; break;
+            case 'B': key = TERM_KEY_DOWN; break;
+            case 'C': key = TERM_KEY_RIGHT; break;
+            case 'D': key = TERM_KEY_LEFT; break;
+            default: return TERM_KEY_ESCAPE;
+        }
+        pop_pending();
+        pop_pending();
+    }
+    return key;
+}
+
+#endif
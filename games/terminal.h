@@ -0,0 +1,49 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <stdint.h>
+
+/*
+ * Real-time terminal input.
+ *
+ * terminal_raw_begin() switches stdin to non-canonical, no-echo,
+ * non-blocking mode for the length of a real-time game, so key presses
+ * arrive one byte at a time without Enter and reading never stalls the
+ * loop. terminal_raw_end() restores the saved settings and discards
+ * unread keys so they do not leak into the next menu prompt.
+ *
+ * Loops are driven by absolute deadlines on the monotonic clock:
+ * terminal_wait_input() sleeps until either a key is available or the
+ * deadline passes, so input is handled the moment it arrives and the
+ * loop never drifts by the cost of its own work. Idle states (pause
+ * screens, game-over screens) pass TERMINAL_NO_DEADLINE and sleep in the
+ * kernel until a key arrives: no timer, no redraw, no wakeups.
+ */
+
+#define TERMINAL_NO_DEADLINE UINT64_MAX
+
+enum {
+    TERM_KEY_NONE = 0,
+    TERM_KEY_ESCAPE = 27,
+    TERM_KEY_UP = 0x100,
+    TERM_KEY_DOWN,
+    TERM_KEY_RIGHT,
+    TERM_KEY_LEFT
+};
+
+void terminal_raw_begin(void);
+void terminal_raw_end(void);
+
+uint64_t terminal_now_us(void);    // Monotonic microseconds
+
+// Returns 1 as soon as input is ready, 0 once deadline_us has passed.
+// With TERMINAL_NO_DEADLINE it returns 0 only if stdin has closed.
+int terminal_wait_input(uint64_t deadline_us);
+
+// Sleeps until deadline_us, leaving any input queued for later
+void terminal_sleep_until(uint64_t deadline_us);
+
+// Next key (arrow sequences decoded to TERM_KEY_*), or TERM_KEY_NONE
+int terminal_read_key(void);
+
+#endif // TERMINAL_H
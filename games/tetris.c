@@ -0,0 +1,427 @@
+/*
+ * Tetris - Falling Blocks
+ * Part of CLI Games Pack v2.1
+ *
+ * The guideline game in a ten-wide well: pieces dealt from shuffled bags
+ * of seven, SRS rotation with wall kicks, a next-piece preview and a
+ * ghost where a hard drop would land. A grounded piece locks after half
+ * a second, or at once on a hard drop. Gravity quickens every ten lines.
+ * Watch mode hands every piece to the placement AI, with or without a
+ * look at the next piece.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "flight_recorder.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "ratings.h"
+#include "screen.h"
+#include "terminal.h"
+#include "tetris_engine.h"
+#include <math.h>
+
+#define LINES_PER_LEVEL 10
+#define MAX_LEVEL 20
+#define LOCK_DELAY_US 500000
+#define LOCK_RESETS 15                  // Moves that restart the lock delay, per piece
+#define AI_STEP_US 40000                // One turn, slide or drop, at most
+
+typedef enum { TETRIS_PLAY, TETRIS_WATCH, TETRIS_WATCH_AHEAD } TetrisMode;
+
+typedef struct {
+    TetrisMode mode;
+    TetrisBoard board;
+    TetrisPosition current;
+    int next;
+    int bag[TETRIS_PIECE_COUNT];
+    int bag_left;
+    uint32_t score;
+    uint32_t best;
+    int lines, level, pieces;
+    int running, over, paused, dirty;
+    uint64_t drop_due;
+    uint64_t lock_due;                  // 0 while the piece can still fall
+    uint64_t ai_due;
+    int lock_resets;
+    TetrisMove plan;
+    long plan_scored;
+    uint64_t plan_us;
+} TetrisGame;
+
+static TetrisGame game;
+
+static const uint32_t line_points[5] = {0, 100, 300, 500, 800};
+
+// Guideline gravity: seconds per row is (0.8 - (level - 1) * 0.007)^(level - 1)
+static uint64_t gravity_us(int level) {
+    double seconds = pow(0.8 - (level - 1) * 0.007, level - 1);
+    return seconds < 0.001 ? 1000 : (uint64_t)(seconds * 1e6);
+}
+
+// The AI keeps ahead of gravity however fast it gets
+static uint64_t ai_step_us(void) {
+    uint64_t step = gravity_us(game.level) / 4;
+    return step < AI_STEP_US ? step : AI_STEP_US;
+}
+
+static int draw_piece(void) {
+    if (game.bag_left == 0) {
+        for (int i = 0; i < TETRIS_PIECE_COUNT; i++) game.bag[i] = i;
+        for (int i = TETRIS_PIECE_COUNT - 1; i > 0; i--) {
+            int j = rand() % (i + 1);
+            int swap = game.bag[i];
+            game.bag[i] = game.bag[j];
+            game.bag[j] = swap;
+        }
+        game.bag_left = TETRIS_PIECE_COUNT;
+        flight_recorder_rng(game.bag[0] | game.bag[1] << 4 | game.bag[2] << 8);
+    }
+    return game.bag[--game.bag_left];
+}
+
+static void plan_move(void) {
+    uint64_t start = terminal_now_us();
+    int next = game.mode == TETRIS_WATCH_AHEAD ? game.next : -1;
+    game.plan_scored = tetris_ai_choose(&game.board, game.current.piece, next, &game.plan);
+    game.plan_us = terminal_now_us() - start;
+    game.ai_due = terminal_now_us() + ai_step_us();
+}
+
+static void spawn_piece(void) {
+    game.current = tetris_spawn(game.next);
+    game.next = draw_piece();
+    game.lock_due = 0;
+    game.lock_resets = 0;
+    game.drop_due = terminal_now_us() + gravity_us(game.level);
+    if (!tetris_fits(&game.board, &game.current)) {
+        game.over = 1;
+        game.running = 0;
+        return;
+    }
+    if (game.mode != TETRIS_PLAY) plan_move();
+}
+
+static void lock_piece(void) {
+    int lines = tetris_lock(&game.board, &game.current);
+    game.pieces++;
+    if (lines > 0) {
+        game.score += line_points[lines] * (uint32_t)game.level;
+        game.lines += lines;
+        game.level = 1 + game.lines / LINES_PER_LEVEL;
+        if (game.level > MAX_LEVEL) game.level = MAX_LEVEL;
+    }
+    spawn_piece();
+    game.dirty = 1;
+}
+
+static void hard_drop(void) {
+    int distance = tetris_drop_distance(&game.board, &game.current);
+    game.current.y -= distance;
+    game.score += 2u * (uint32_t)distance;
+    lock_piece();
+}
+
+// A move or turn that succeeded on the ground buys the piece more time
+static void moved(void) {
+    game.dirty = 1;
+    if (game.lock_due && game.lock_resets < LOCK_RESETS) {
+        game.lock_resets++;
+        game.lock_due = terminal_now_us() + LOCK_DELAY_US;
+    }
+}
+
+static void tetris_start(TetrisMode mode) {
+    memset(&game, 0, sizeof(game));
+    game.mode = mode;
+    game.level = 1;
+    game.running = 1;
+    game.best = highscore_best(HIGHSCORE_TETRIS, 0);
+    tetris_board_clear(&game.board);
+    game.next = draw_piece();
+    spawn_piece();
+    game.dirty = 1;
+}
+
+// One step towards the planned placement: turn, slide, then drop
+static void ai_step(void) {
+    TetrisPosition* at = &game.current;
+    int blocked;
+
+    if (at->rotation != game.plan.rotation) {
+        blocked = !tetris_rotate(&game.board, at, game.plan.rotation == 3 ? -1 : 1);
+    } else if (at->x != game.plan.x) {
+        blocked = !tetris_shift(&game.board, at, at->x < game.plan.x ? 1 : -1, 0);
+    } else {
+        blocked = 1;
+    }
+    if (blocked) {
+        hard_drop();
+    } else {
+        moved();
+    }
+}
+
+static void toggle_pause(void) {
+    uint64_t now = terminal_now_us();
+    game.paused = !game.paused;
+    if (!game.paused) {
+        game.drop_due = now + gravity_us(game.level);
+        if (game.lock_due) game.lock_due = now + LOCK_DELAY_US;
+        game.ai_due = now + ai_step_us();
+    }
+    game.dirty = 1;
+}
+
+static void handle_key(int key) {
+    switch (key) {
+        case 'a': case 'A': case TERM_KEY_LEFT:
+            if (tetris_shift(&game.board, &game.current, -1, 0)) moved();
+            break;
+        case 'd': case 'D': case TERM_KEY_RIGHT:
+            if (tetris_shift(&game.board, &game.current, 1, 0)) moved();
+            break;
+        case 'w': case 'W': case 'x': case 'X': case TERM_KEY_UP:
+            if (tetris_rotate(&game.board, &game.current, 1)) moved();
+            break;
+        case 'z': case 'Z':
+            if (tetris_rotate(&game.board, &game.current, -1)) moved();
+            break;
+        case 's': case 'S': case TERM_KEY_DOWN:
+            if (tetris_shift(&game.board, &game.current, 0, -1)) {
+                game.score++;
+                game.drop_due = terminal_now_us() + gravity_us(game.level);
+                game.dirty = 1;
+            }
+            break;
+        case ' ':
+            hard_drop();
+            break;
+        default:
+            break;
+    }
+}
+
+static void handle_tetris_input(void) {
+    int key;
+    while (game.running && (key = terminal_read_key()) != TERM_KEY_NONE) {
+        flight_recorder_input(key);
+        if (key == 'q' || key == 'Q' || key == TERM_KEY_ESCAPE) {
+            game.running = 0;
+        } else if (key == 'p' || key == 'P') {
+            toggle_pause();
+        } else if (!game.paused && game.mode == TETRIS_PLAY) {
+            handle_key(key);
+        }
+    }
+}
+
+// Gravity, the lock delay and the AI, whichever are due
+static void advance(uint64_t now) {
+    if (game.paused || !game.running) return;
+    if (game.mode != TETRIS_PLAY && now >= game.ai_due) {
+        ai_step();
+        game.ai_due = now + ai_step_us();
+    }
+    if (!game.running) return;
+    if (now >= game.drop_due) {
+        if (tetris_shift(&game.board, &game.current, 0, -1)) {
+            game.lock_due = 0;
+            game.dirty = 1;
+        } else if (!game.lock_due) {
+            game.lock_due = now + LOCK_DELAY_US;
+        }
+        game.drop_due += gravity_us(game.level);
+        if (game.drop_due < now) game.drop_due = now;
+    }
+    if (game.lock_due && now >= game.lock_due) {
+        if (tetris_drop_distance(&game.board, &game.current) == 0) {
+            lock_piece();
+        } else {
+            game.lock_due = 0;
+        }
+    }
+}
+
+static uint64_t next_deadline(void) {
+    if (game.paused) return TERMINAL_NO_DEADLINE;
+    uint64_t deadline = game.drop_due;
+    if (game.lock_due && game.lock_due < deadline) deadline = game.lock_due;
+    if (game.mode != TETRIS_PLAY && game.ai_due < deadline) deadline = game.ai_due;
+    return deadline;
+}
+
+static int piece_cell(const TetrisPosition* at, int x, int y) {
+    int col = x - at->x, row = y - at->y;
+    if (col < 0 || col > 3 || row < 0 || row > 3) return 0;
+    return (tetris_piece_row(at->piece, at->rotation, row) >> col) & 1;
+}
+
+// The side panel, one line per well row
+static void panel_line(int line, char* text, size_t size) {
+    static const char* const play_help[] = {
+        "A D / arrows  move", "W X / up  turn", "Z  turn back", "S / down  soft drop",
+        "Space  hard drop", "P  pause   Q  quit"
+    };
+    text[0] = '\0';
+    if (line == 0) {
+        snprintf(text, size, "%s", game.mode == TETRIS_PLAY ? "TETRIS" : "TETRIS - AI playing");
+    } else if (line == 2) {
+        snprintf(text, size, "Next");
+    } else if (line == 3 || line == 4) {
+        // The preview piece's top two rows, in its spawn state
+        int top = 3;
+        while (top > 0 && tetris_piece_row(game.next, 0, top) == 0) top--;
+        int row = top - (line - 3);
+        uint16_t mask = row >= 0 ? tetris_piece_row(game.next, 0, row) : 0;
+        for (int col = 0; col < 4; col++) {
+            strcat(text, (mask >> col & 1) ? "[]" : "  ");
+        }
+    } else if (line == 6) {
+        snprintf(text, size, "Score  %u", game.score);
+    } else if (line == 7) {
+        snprintf(text, size, "Lines  %d", game.lines);
+    } else if (line == 8) {
+        snprintf(text, size, "Level  %d", game.level);
+    } else if (line == 9) {
+        if (game.mode == TETRIS_PLAY) {
+            snprintf(text, size, "Best   %u", game.best > game.score ? game.best : game.score);
+        } else {
+            snprintf(text, size, "Pieces %d", game.pieces);
+        }
+    } else if (line >= 11 && line <= 16) {
+        if (game.mode == TETRIS_PLAY) {
+            snprintf(text, size, "%s", play_help[line - 11]);
+        } else if (line == 11) {
+            snprintf(text, size, "Lookahead: %s", game.mode == TETRIS_WATCH_AHEAD ? "next piece" : "none");
+        } else if (line == 12) {
+            snprintf(text, size, "Scored %ld placements", game.plan_scored);
+        } else if (line == 13) {
+            snprintf(text, size, "for this piece in %llu us", (unsigned long long)game.plan_us);
+        } else if (line == 16) {
+            snprintf(text, size, "P  pause   Q  quit");
+        }
+    } else if (line == 18) {
+        if (game.over) {
+            snprintf(text, size, "GAME OVER");
+        } else if (game.paused) {
+            snprintf(text, size, "PAUSED - P to resume");
+        }
+    }
+}
+
+// Composes the whole well; the screen model sends only the cells that
+// moved. The frame ends on the bottom border so it fits 24 rows.
+static void draw_tetris(void) {
+    char text[48];
+    int ghost_y = game.current.y - tetris_drop_distance(&game.board, &game.current);
+    TetrisPosition ghost = game.current;
+    ghost.y = ghost_y;
+    int show_piece = game.running || !game.over;
+
+    screen_begin();
+    for (int line = 0; line < TETRIS_VISIBLE; line++) {
+        int y = TETRIS_VISIBLE - 1 - line;
+        screen_printf("  |");
+        for (int x = 0; x < TETRIS_WIDTH; x++) {
+            if (tetris_cell(&game.board, x, y) || (show_piece && piece_cell(&game.current, x, y))) {
+                screen_printf("[]");
+            } else if (show_piece && game.mode == TETRIS_PLAY && piece_cell(&ghost, x, y)) {
+                screen_printf("::");
+            } else {
+                screen_printf(" .");
+            }
+        }
+        panel_line(line, text, sizeof(text));
+        screen_printf("|  %s\n", text);
+    }
+    screen_printf("  +--------------------+");
+    screen_present();
+    game.dirty = 0;
+}
+
+static void tetris_run(TetrisMode mode) {
+    tetris_start(mode);
+    screen_invalidate();
+    printf("\033[?25l");                // Hide the cursor
+    terminal_raw_begin();
+    flight_recorder_mark("tetris: game loop");
+    draw_tetris();
+    while (game.running) {
+        // Keys are handled the moment they arrive; gravity, locks and AI
+        // moves wake the loop at their own deadlines
+        uint64_t deadline = next_deadline();
+        if (terminal_wait_input(deadline)) {
+            handle_tetris_input();
+        } else if (deadline == TERMINAL_NO_DEADLINE) {
+            break;                      // stdin closed while paused
+        }
+        uint64_t tick_start = flight_recorder_now_us();
+        advance(terminal_now_us());
+        if (game.dirty) draw_tetris();
+        uint64_t tick_us = flight_recorder_now_us() - tick_start;
+        flight_recorder_tick(tick_us);
+        metrics_observe(METRICS_TICK_US, tick_us);
+    }
+    terminal_raw_end();
+    draw_tetris();
+    printf("\033[?25h\n\n");
+    screen_invalidate();
+
+    printf("%s! Score %u, %d lines, level %d, %d pieces.\n", game.over ? "Game over" : "Game ended",
+           game.score, game.lines, game.level, game.pieces);
+    if (game.mode == TETRIS_PLAY && game.score > 0) {
+        int rank = highscore_submit(HIGHSCORE_TETRIS, 0, ratings_local_player(), game.score);
+        if (rank > 0) printf("*** HALL OF FAME: #%d ***\n", rank);
+    }
+}
+
+static void tetris_instructions(void) {
+    printf("\n=== HOW TO PLAY TETRIS ===\n\n");
+    printf("Pieces fall into a well ten columns wide. Fill a row from wall to\n");
+    printf("wall and it disappears; the game ends when a new piece has no room.\n\n");
+    printf("  A D or arrows   move left and right\n");
+    printf("  W, X or up      turn clockwise (Z turns back)\n");
+    printf("  S or down       soft drop, 1 point a row\n");
+    printf("  Space           hard drop, 2 points a row\n");
+    printf("  P / Q           pause / quit\n\n");
+    printf("Clearing 1, 2, 3 or 4 rows at once scores 100, 300, 500 or 800\n");
+    printf("times the level. The level goes up every 10 rows and pieces fall\n");
+    printf("faster. A piece that lands can still slide and turn for half a\n");
+    printf("second; :: marks where it would land.\n\n");
+    printf("Watch mode lets the AI play. For each piece it tries every turn\n");
+    printf("and column and scores the stack each leaves: its height, holes,\n");
+    printf("wells and how ragged it is. With lookahead it also tries every\n");
+    printf("placement of the next piece after each one.\n");
+    printf("\nPress Enter to return...");
+    clear_input_buffer();
+}
+
+void play_tetris(void) {
+    char line[16];
+
+    while (1) {
+        printf("\n=== TETRIS ===\n");
+        printf("Best score: %u\n", highscore_best(HIGHSCORE_TETRIS, 0));
+        printf("\n1. Play\n");
+        printf("2. Watch the AI\n");
+        printf("3. Watch the AI (next-piece lookahead)\n");
+        printf("4. How to play\n");
+        printf("5. Back to main menu\n");
+        printf("\nChoice: ");
+
+        if (!fgets(line, sizeof(line), stdin)) return;
+        if (!strchr(line, '\n')) clear_input_buffer();
+        switch (atoi(line)) {
+            case 1: tetris_run(TETRIS_PLAY); break;
+            case 2: tetris_run(TETRIS_WATCH); break;
+            case 3: tetris_run(TETRIS_WATCH_AHEAD); break;
+            case 4: tetris_instructions(); break;
+            case 5: return;
+            default: printf("Invalid choice!\n"); break;
+        }
+    }
+}
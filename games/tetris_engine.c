@@ -0,0 +1,314 @@
+/*
+ * Tetris Engine
+ * Part of CLI Games Pack v2.1
+ *
+ * Row-bitmask board, SRS rotation with its kick tables, line clears and
+ * the placement AI. Every piece mask and kick offset is a constant table;
+ * nothing is computed per game.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "tetris_engine.h"
+
+#define WALL_BITS 3                     // Column 0 is bit 3
+#define FIELD_BITS 0x1FF8u              // Columns 0-9
+#define EDGE_BITS 0x1FFCu               // Bits with a neighbour to the right: walls count
+#define NO_CELL 32                      // Empty box column: never the highest landing
+
+// El-Tetris weights for Dellacherie's features
+#define WEIGHT_LANDING_HEIGHT -4.500158825082766
+#define WEIGHT_ERODED_CELLS 3.4181268101392694
+#define WEIGHT_ROW_TRANSITIONS -3.2178882868487753
+#define WEIGHT_COLUMN_TRANSITIONS -9.348695305445199
+#define WEIGHT_HOLES -7.899265427351652
+#define WEIGHT_WELLS -3.3855972247263626
+#define TOPPED_OUT -1e18
+
+const char tetris_piece_letters[TETRIS_PIECE_COUNT] = {'I', 'O', 'T', 'S', 'Z', 'J', 'L'};
+
+// Box rows from the bottom, bit 0 the box's left column, for states 0, R, 2, L
+static const uint16_t piece_rows[TETRIS_PIECE_COUNT][4][4] = {
+    {{0x0, 0x0, 0xF, 0x0}, {0x4, 0x4, 0x4, 0x4}, {0x0, 0xF, 0x0, 0x0}, {0x2, 0x2, 0x2, 0x2}},  // I
+    {{0x0, 0x0, 0x6, 0x6}, {0x0, 0x0, 0x6, 0x6}, {0x0, 0x0, 0x6, 0x6}, {0x0, 0x0, 0x6, 0x6}},  // O
+    {{0x0, 0x7, 0x2, 0x0}, {0x2, 0x6, 0x2, 0x0}, {0x2, 0x7, 0x0, 0x0}, {0x2, 0x3, 0x2, 0x0}},  // T
+    {{0x0, 0x3, 0x6, 0x0}, {0x4, 0x6, 0x2, 0x0}, {0x3, 0x6, 0x0, 0x0}, {0x2, 0x3, 0x1, 0x0}},  // S
+    {{0x0, 0x6, 0x3, 0x0}, {0x2, 0x6, 0x4, 0x0}, {0x6, 0x3, 0x0, 0x0}, {0x1, 0x3, 0x2, 0x0}},  // Z
+    {{0x0, 0x7, 0x1, 0x0}, {0x2, 0x2, 0x6, 0x0}, {0x4, 0x7, 0x0, 0x0}, {0x3, 0x2, 0x2, 0x0}},  // J
+    {{0x0, 0x7, 0x4, 0x0}, {0x6, 0x2, 0x2, 0x0}, {0x1, 0x7, 0x0, 0x0}, {0x2, 0x2, 0x3, 0x0}}   // L
+};
+
+// Lowest and highest box row holding a cell
+static const int8_t piece_extent[TETRIS_PIECE_COUNT][4][2] = {
+    {{2, 2}, {0, 3}, {1, 1}, {0, 3}},
+    {{2, 3}, {2, 3}, {2, 3}, {2, 3}},
+    {{1, 2}, {0, 2}, {0, 1}, {0, 2}},
+    {{1, 2}, {0, 2}, {0, 1}, {0, 2}},
+    {{1, 2}, {0, 2}, {0, 1}, {0, 2}},
+    {{1, 2}, {0, 2}, {0, 1}, {0, 2}},
+    {{1, 2}, {0, 2}, {0, 1}, {0, 2}}
+};
+
+// Lowest cell of each box column, for dropping onto column heights
+static const int8_t column_bottom[TETRIS_PIECE_COUNT][4][4] = {
+    {{2, 2, 2, 2}, {NO_CELL, NO_CELL, 0, NO_CELL}, {1, 1, 1, 1}, {NO_CELL, 0, NO_CELL, NO_CELL}},
+    {{NO_CELL, 2, 2, NO_CELL}, {NO_CELL, 2, 2, NO_CELL}, {NO_CELL, 2, 2, NO_CELL}, {NO_CELL, 2, 2, NO_CELL}},
+    {{1, 1, 1, NO_CELL}, {NO_CELL, 0, 1, NO_CELL}, {1, 0, 1, NO_CELL}, {1, 0, NO_CELL, NO_CELL}},
+    {{1, 1, 2, NO_CELL}, {NO_CELL, 1, 0, NO_CELL}, {0, 0, 1, NO_CELL}, {1, 0, NO_CELL, NO_CELL}},
+    {{2, 1, 1, NO_CELL}, {NO_CELL, 0, 1, NO_CELL}, {1, 0, 0, NO_CELL}, {0, 1, NO_CELL, NO_CELL}},
+    {{1, 1, 1, NO_CELL}, {NO_CELL, 0, 2, NO_CELL}, {1, 1, 0, NO_CELL}, {0, 0, NO_CELL, NO_CELL}},
+    {{1, 1, 1, NO_CELL}, {NO_CELL, 0, 0, NO_CELL}, {0, 1, 1, NO_CELL}, {2, 0, NO_CELL, NO_CELL}}
+};
+
+// Rotations that give different shapes; the rest only repeat placements
+static const int distinct_rotations[TETRIS_PIECE_COUNT] = {2, 1, 4, 2, 2, 4, 4};
+
+// SRS kick tests as (dx, dy), y up: [I table][from state][counterclockwise][test]
+static const int8_t srs_kicks[2][4][2][5][2] = {
+    {   // J, L, S, T, Z
+        {{{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}, {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},
+        {{{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}, {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},
+        {{{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}, {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}},
+        {{{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}, {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}}
+    },
+    {   // I
+        {{{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}, {{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}},
+        {{{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}, {{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}},
+        {{{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}, {{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}},
+        {{{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}, {{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}}
+    }
+};
+
+void tetris_board_clear(TetrisBoard* board) {
+    for (int row = 0; row < TETRIS_HEIGHT; row++) board->rows[row] = TETRIS_WALLS;
+}
+
+uint16_t tetris_piece_row(int piece, int rotation, int row) {
+    return piece_rows[piece][rotation & 3][row & 3];
+}
+
+int tetris_cell(const TetrisBoard* board, int x, int y) {
+    if (x < 0 || x >= TETRIS_WIDTH || y < 0 || y >= TETRIS_HEIGHT) return 0;
+    return (board->rows[y] >> (x + WALL_BITS)) & 1;
+}
+
+TetrisPosition tetris_spawn(int piece) {
+    TetrisPosition position = {piece, 0, 3, TETRIS_VISIBLE - 1 - piece_extent[piece][0][0]};
+    return position;
+}
+
+// One AND per occupied box row. A box shifted past the three wall bits
+// could only overlap a wall, so it is refused before the shift and the
+// mask always stays inside the row.
+static int fits(const uint16_t* rows, int piece, int rotation, int x, int y) {
+    const uint16_t* mask = piece_rows[piece][rotation];
+    int shift = x + WALL_BITS;
+    if (shift < 0 || shift > 12) return 0;
+    for (int i = piece_extent[piece][rotation][0]; i <= piece_extent[piece][rotation][1]; i++) {
+        int row = y + i;
+        if (row < 0) return 0;
+        if (row < TETRIS_HEIGHT && (rows[row] & ((unsigned)mask[i] << shift))) return 0;
+    }
+    return 1;
+}
+
+int tetris_fits(const TetrisBoard* board, const TetrisPosition* position) {
+    return fits(board->rows, position->piece, position->rotation, position->x, position->y);
+}
+
+int tetris_shift(const TetrisBoard* board, TetrisPosition* position, int dx, int dy) {
+    if (!fits(board->rows, position->piece, position->rotation, position->x + dx, position->y + dy)) return 0;
+    position->x += dx;
+    position->y += dy;
+    return 1;
+}
+
+int tetris_rotate(const TetrisBoard* board, TetrisPosition* position, int direction) {
+    int counterclockwise = direction < 0;
+    int to = (position->rotation + (counterclockwise ? 3 : 1)) & 3;
+    int tests = position->piece == TETRIS_O ? 1 : 5;    // O turns in place
+    const int8_t (*kicks)[2] = srs_kicks[position->piece == TETRIS_I][position->rotation][counterclockwise];
+
+    for (int test = 0; test < tests; test++) {
+        int x = position->x + kicks[test][0], y = position->y + kicks[test][1];
+        if (fits(board->rows, position->piece, to, x, y)) {
+            position->rotation = to;
+            position->x = x;
+            position->y = y;
+            return test + 1;
+        }
+    }
+    return 0;
+}
+
+int tetris_drop_distance(const TetrisBoard* board, const TetrisPosition* position) {
+    int distance = 0;
+    while (fits(board->rows, position->piece, position->rotation, position->x, position->y - distance - 1)) {
+        distance++;
+    }
+    return distance;
+}
+
+// ORs the piece in, then clears full rows from the top of the piece down
+// so the rows still to test never move. Counts the piece cells cleared.
+static int place(uint16_t* rows, int piece, int rotation, int x, int y, int* eroded) {
+    const uint16_t* mask = piece_rows[piece][rotation];
+    int low = piece_extent[piece][rotation][0], high = piece_extent[piece][rotation][1];
+    int lines = 0;
+
+    *eroded = 0;
+    for (int i = low; i <= high; i++) {
+        if (y + i >= 0 && y + i < TETRIS_HEIGHT) rows[y + i] |= (uint16_t)(mask[i] << (x + WALL_BITS));
+    }
+    for (int i = high; i >= low; i--) {
+        int row = y + i;
+        if (row < 0 || row >= TETRIS_HEIGHT || rows[row] != TETRIS_FULL) continue;
+        memmove(rows + row, rows + row + 1, (size_t)(TETRIS_HEIGHT - 1 - row) * sizeof(rows[0]));
+        rows[TETRIS_HEIGHT - 1] = TETRIS_WALLS;
+        lines++;
+        *eroded += __builtin_popcount(mask[i]);
+    }
+    return lines;
+}
+
+int tetris_lock(TetrisBoard* board, const TetrisPosition* position) {
+    int eroded;
+    return place(board->rows, position->piece, position->rotation, position->x, position->y, &eroded);
+}
+
+// Height of each column, indexed by bit so walls and the box's empty
+// columns read as 0
+static void column_heights(const uint16_t* rows, int heights[16]) {
+    unsigned seen = TETRIS_WALLS;
+
+    memset(heights, 0, 16 * sizeof(int));
+    for (int row = TETRIS_HEIGHT - 1; row >= 0 && seen != TETRIS_FULL; row--) {
+        for (unsigned fresh = rows[row] & ~seen; fresh; fresh &= fresh - 1) {
+            heights[__builtin_ctz(fresh)] = row + 1;
+        }
+        seen |= rows[row];
+    }
+}
+
+int tetris_placements(const TetrisBoard* board, int piece, TetrisMove* moves) {
+    int heights[16], count = 0;
+
+    column_heights(board->rows, heights);
+    for (int turn = 0; turn < distinct_rotations[piece]; turn++) {
+        TetrisPosition start = tetris_spawn(piece);
+        if (!tetris_fits(board, &start)) return 0;
+        int turned = 1;
+        if (turn == 3) {
+            turned = tetris_rotate(board, &start, -1);
+        } else {
+            for (int step = 0; step < turn && turned; step++) turned = tetris_rotate(board, &start, 1);
+        }
+        if (!turned) continue;
+
+        int left = start.x, right = start.x;
+        while (fits(board->rows, piece, start.rotation, left - 1, start.y)) left--;
+        while (fits(board->rows, piece, start.rotation, right + 1, start.y)) right++;
+
+        const int8_t* bottom = column_bottom[piece][start.rotation];
+        for (int x = left; x <= right; x++) {
+            const int* column = heights + x + WALL_BITS;
+            int y = column[0] - bottom[0];
+            for (int c = 1; c < 4; c++) {
+                if (column[c] - bottom[c] > y) y = column[c] - bottom[c];
+            }
+            if (y > start.y) {
+                // Tucked under an overhang already: fall from here instead
+                TetrisPosition under = {piece, start.rotation, x, start.y};
+                y = start.y - tetris_drop_distance(board, &under);
+            }
+            TetrisMove* move = &moves[count++];
+            move->rotation = start.rotation;
+            move->x = x;
+            move->y = y;
+            move->lines = 0;
+            move->score = 0.0;
+        }
+    }
+    return count;
+}
+
+// Scores what a placement itself did: how high it landed and how much of
+// it was cleared away
+static double score_move(const uint16_t* rows, int piece, TetrisMove* move, uint16_t* after) {
+    int eroded;
+
+    memcpy(after, rows, TETRIS_HEIGHT * sizeof(rows[0]));
+    move->lines = place(after, piece, move->rotation, move->x, move->y, &eroded);
+    double landing = move->y + (piece_extent[piece][move->rotation][0] +
+                                 piece_extent[piece][move->rotation][1]) / 2.0;
+    return WEIGHT_LANDING_HEIGHT * landing + WEIGHT_ERODED_CELLS * move->lines * eroded;
+}
+
+// Scores the stack left behind
+static double score_board(const uint16_t* rows) {
+    int top = TETRIS_HEIGHT;
+    while (top > 0 && rows[top - 1] == TETRIS_WALLS) top--;
+
+    int row_transitions = 2 * (TETRIS_HEIGHT - top);      // Empty rows: wall to gap, gap to wall
+    int column_transitions = 0, holes = 0, wells = 0;
+    unsigned below = TETRIS_FULL;                          // The floor
+    for (int row = 0; row < top; row++) {
+        unsigned bits = rows[row];
+        row_transitions += __builtin_popcount((bits ^ (bits >> 1)) & EDGE_BITS);
+        column_transitions += __builtin_popcount((bits ^ below) & FIELD_BITS);
+        below = bits;
+    }
+    column_transitions += __builtin_popcount((below ^ TETRIS_WALLS) & FIELD_BITS);
+
+    // Walking down: holes sit under anything filled, and each cell of a
+    // well scores its depth so far
+    unsigned covered = 0, above_wells = 0;
+    int depth[16] = {0};
+    for (int row = top - 1; row >= 0; row--) {
+        unsigned bits = rows[row];
+        holes += __builtin_popcount(~bits & covered & FIELD_BITS);
+        covered |= bits;
+        unsigned well = ~bits & (bits << 1) & (bits >> 1) & FIELD_BITS;
+        for (unsigned cells = well; cells; cells &= cells - 1) {
+            int bit = __builtin_ctz(cells);
+            depth[bit] = (above_wells >> bit & 1) ? depth[bit] + 1 : 1;
+            wells += depth[bit];
+        }
+        above_wells = well;
+    }
+
+    return WEIGHT_ROW_TRANSITIONS * row_transitions + WEIGHT_COLUMN_TRANSITIONS * column_transitions +
+           WEIGHT_HOLES * holes + WEIGHT_WELLS * wells;
+}
+
+long tetris_ai_choose(const TetrisBoard* board, int piece, int next, TetrisMove* best) {
+    TetrisMove moves[TETRIS_MAX_PLACEMENTS], follow[TETRIS_MAX_PLACEMENTS];
+    uint16_t after[TETRIS_HEIGHT], after_next[TETRIS_HEIGHT];
+    TetrisBoard next_board;
+    long scored = 0;
+
+    int count = tetris_placements(board, piece, moves);
+    for (int i = 0; i < count; i++) {
+        double score = score_move(board->rows, piece, &moves[i], after);
+        scored++;
+        if (next >= 0) {
+            memcpy(next_board.rows, after, sizeof(after));
+            int follow_count = tetris_placements(&next_board, next, follow);
+            double best_follow = TOPPED_OUT;
+            for (int j = 0; j < follow_count; j++) {
+                double follow_score = score_move(after, next, &follow[j], after_next) + score_board(after_next);
+                if (follow_score > best_follow) best_follow = follow_score;
+            }
+            scored += follow_count;
+            score += best_follow;
+        } else {
+            score += score_board(after);
+        }
+        moves[i].score = score;
+        if (i == 0 || score > best->score) *best = moves[i];
+    }
+    return count > 0 ? scored : 0;
+}
@@ -0,0 +1,100 @@
+#ifndef TETRIS_ENGINE_H
+#define TETRIS_ENGINE_H
+
+#include <stdint.h>
+
+/*
+ * Tetris board, rotation and placement search.
+ *
+ * The well is ten columns wide and every row is one uint16_t, bottom row
+ * first. Column x is bit x + 3. Bits 0-2 and 13-15 are always set, a
+ * wall on each side, so a row with every bit set is full and a piece
+ * that pokes through a side collides like it would with a block. Pieces
+ * are four row masks per rotation. A collision test shifts each mask to
+ * the piece's column and ANDs it with one board row. Clearing a line is
+ * a compare against 0xFFFF and a memmove of the rows above it.
+ *
+ * Rotation follows SRS. The four states of each piece are its spawn
+ * state turned clockwise inside a 3x3 box (4x4 for I). A rotation tries
+ * the five offsets of the JLSTZ or I kick table for that pair of states
+ * in order and takes the first that fits.
+ *
+ * The AI lists every placement reachable from the spawn point: turn,
+ * slide left or right as far as the stack allows, drop. Each placement is
+ * scored with the six features of Pierre Dellacherie's evaluation (as
+ * tuned for El-Tetris): landing height, eroded piece cells, row and
+ * column transitions, holes and wells. With the next piece known it can
+ * look one piece ahead and keep the first placement whose best follow-up
+ * scores highest.
+ */
+
+#define TETRIS_WIDTH 10
+#define TETRIS_HEIGHT 24                // Rows above the visible 20 hold new pieces
+#define TETRIS_VISIBLE 20
+#define TETRIS_WALLS 0xE007u            // An empty row
+#define TETRIS_FULL 0xFFFFu
+#define TETRIS_MAX_PLACEMENTS 48        // At most 34 for any piece
+
+typedef enum {
+    TETRIS_I,
+    TETRIS_O,
+    TETRIS_T,
+    TETRIS_S,
+    TETRIS_Z,
+    TETRIS_J,
+    TETRIS_L,
+    TETRIS_PIECE_COUNT
+} TetrisPiece;
+
+typedef struct {
+    uint16_t rows[TETRIS_HEIGHT];
+} TetrisBoard;
+
+// Where a piece is: its box's bottom-left corner and its rotation (0 is
+// the spawn state, then clockwise). x and y may be negative.
+typedef struct {
+    int piece;
+    int rotation;
+    int x, y;
+} TetrisPosition;
+
+typedef struct {
+    int rotation;
+    int x, y;
+    int lines;                          // Rows this placement clears
+    double score;
+} TetrisMove;
+
+extern const char tetris_piece_letters[TETRIS_PIECE_COUNT];
+
+void tetris_board_clear(TetrisBoard* board);
+
+// Row mask of a piece's box row (0 = bottom), columns in bits 0-3
+uint16_t tetris_piece_row(int piece, int rotation, int row);
+int tetris_cell(const TetrisBoard* board, int x, int y);
+
+// A new piece at the top of the well, in its spawn state
+TetrisPosition tetris_spawn(int piece);
+
+int tetris_fits(const TetrisBoard* board, const TetrisPosition* position);
+int tetris_shift(const TetrisBoard* board, TetrisPosition* position, int dx, int dy);
+
+// Turns the piece one step (direction 1 clockwise, -1 counterclockwise).
+// Returns which SRS test fitted (1-5), or 0 and leaves it unmoved.
+int tetris_rotate(const TetrisBoard* board, TetrisPosition* position, int direction);
+
+// Rows the piece falls in a hard drop from where it is
+int tetris_drop_distance(const TetrisBoard* board, const TetrisPosition* position);
+
+// Adds the piece to the board and clears full rows; returns rows cleared
+int tetris_lock(TetrisBoard* board, const TetrisPosition* position);
+
+// Every reachable placement of piece, unscored. Returns how many.
+int tetris_placements(const TetrisBoard* board, int piece, TetrisMove* moves);
+
+// Picks the best placement, looking one piece ahead when next is a piece
+// rather than -1. Returns the number of placements scored, or 0 when
+// the piece has nowhere to go.
+long tetris_ai_choose(const TetrisBoard* board, int piece, int next, TetrisMove* best);
+
+#endif // TETRIS_ENGINE_H
@@ -0,0 +1,636 @@
+/*
+ * Texas Hold'em - No-Limit Table vs AI
+ * Part of CLI Games Pack v2.1
+ *
+ * Features:
+ * - 1 to 5 AI opponents with different playing styles
+ * - Blinds, betting rounds, all-ins and side pots
+ * - AI decisions driven by the equity calculator in poker_eval.c
+ * - Optional equity hint for the human player
+ */
+
+#include "games.h"
+#include "cards.h"
+#include "poker_eval.h"
+
+#define HOLDEM_MAX_PLAYERS 6
+#define HOLDEM_STARTING_CHIPS 1000
+#define HOLDEM_SMALL_BLIND 10
+#define HOLDEM_BIG_BLIND 20
+#define HOLDEM_AI_SAMPLES 4000
+#define HOLDEM_HINT_SAMPLES 20000
+
+typedef enum {
+    ACTION_FOLD,
+    ACTION_CHECK_CALL,
+    ACTION_RAISE,
+    ACTION_QUIT
+} HoldemAction;
+
+typedef struct {
+    char name[16];
+    Card hole[2];
+    int chips;
+    int round_bet;      // Chips put in during the current betting round
+    int contributed;    // Chips put in during the whole hand
+    int folded;
+    int all_in;
+    int is_human;
+    int acted;          // Has acted since the last full raise this round
+    int raise_closed;   // Only a short all-in came since: call or fold
+    int out;            // Busted out of the game
+    double looseness;   // How readily the AI calls marginal hands
+    double aggression;  // How readily the AI bets and raises
+} HoldemPlayer;
+
+typedef struct {
+    HoldemPlayer players[HOLDEM_MAX_PLAYERS];
+    int player_count;
+    Deck deck;
+    Card board[5];
+    int board_count;
+    int dealer;
+    int current_bet;
+    int min_raise;
+    int show_hints;
+    int hands_played;
+    int hands_won;
+    int quit;
+} HoldemGame;
+
+static const char* holdem_ai_names[] = {"Doyle", "Vanessa", "Phil", "Annie", "Daniel"};
+static const double holdem_ai_looseness[] = {0.02, 0.08, -0.04, 0.05, 0.00};
+static const double holdem_ai_aggression[] = {0.10, 0.02, 0.15, -0.05, 0.06};
+
+void display_holdem_rules(void) {
+    printf("\n===========================================\n");
+    printf("          TEXAS HOLD'EM POKER\n");
+    printf("===========================================\n");
+    printf("Rules:\n");
+    printf("* Each player gets 2 hole cards\n");
+    printf("* 5 community cards: flop (3), turn (1), river (1)\n");
+    printf("* Best 5-card hand from your 7 cards wins\n");
+    printf("* Blinds: %d/%d, everyone starts with %d chips\n",
+           HOLDEM_SMALL_BLIND, HOLDEM_BIG_BLIND, HOLDEM_STARTING_CHIPS);
+    printf("* Last player with chips wins the table\n");
+    printf("-------------------------------------------\n");
+}
+
+static int holdem_card_index(Card card) {
+    return poker_card_index(card);
+}
+
+static int holdem_players_in_hand(const HoldemGame* game) {
+    int count = 0;
+    for (int i = 0; i < game->player_count; i++) {
+        if (!game->players[i].out && !game->players[i].folded) count++;
+    }
+    return count;
+}
+
+static int holdem_players_able_to_act(const HoldemGame* game) {
+    int count = 0;
+    for (int i = 0; i < game->player_count; i++) {
+        const HoldemPlayer* p = &game->players[i];
+        if (!p->out && !p->folded && !p->all_in) count++;
+    }
+    return count;
+}
+
+static int holdem_next_seat(const HoldemGame* game, int seat) {
+    for (int step = 1; step <= game->player_count; step++) {
+        int next = (seat + step) % game->player_count;
+        if (!game->players[next].out) return next;
+    }
+    return seat;
+}
+
+static int holdem_pot(const HoldemGame* game) {
+    int pot = 0;
+    for (int i = 0; i < game->player_count; i++) {
+        pot += game->players[i].contributed;
+    }
+    return pot;
+}
+
+static void holdem_put_chips(HoldemPlayer* player, int amount) {
+    if (amount >= player->chips) {
+        amount = player->chips;
+        player->all_in = 1;
+    }
+    player->chips -= amount;
+    player->round_bet += amount;
+    player->contributed += amount;
+}
+
+static double holdem_player_equity(const HoldemGame* game, const HoldemPlayer* player, int samples) {
+    int hole[2];
+    int board[5];
+
+    hole[0] = holdem_card_index(player->hole[0]);
+    hole[1] = holdem_card_index(player->hole[1]);
+    for (int i = 0; i < game->board_count; i++) {
+        board[i] = holdem_card_index(game->board[i]);
+    }
+
+    PokerEquity equity = poker_equity(hole, board, game->board_count,
+                                      holdem_players_in_hand(game) - 1,
+                                      samples, poker_default_threads());
+    return equity.equity;
+}
+
+static void holdem_display_table(const HoldemGame* game, int viewer) {
+    printf("\n-------------------------------------------\n");
+    printf("Board: ");
+    if (game->board_count == 0) {
+        printf("(no cards yet)");
+    }
+    for (int i = 0; i < game->board_count; i++) {
+        display_card(game->board[i]);
+        printf(" ");
+    }
+    printf("\nPot: %d chips\n\n", holdem_pot(game));
+
+    for (int i = 0; i < game->player_count; i++) {
+        const HoldemPlayer* p = &game->players[i];
+        if (p->out) continue;
+
+        printf("%c %-8s %5d chips  bet %-4d ", (i == game->dealer) ? 'D' : ' ',
+               p->name, p->chips, p->round_bet);
+        if (p->folded) {
+            printf("[folded]");
+        } else if (i == viewer) {
+            display_card(p->hole[0]);
+            printf(" ");
+            display_card(p->hole[1]);
+        } else {
+            printf("[??] [??]");
+        }
+        if (p->all_in) printf(" ALL-IN");
+        printf("\n");
+    }
+    printf("-------------------------------------------\n");
+}
+
+static HoldemAction holdem_human_action(HoldemGame* game, int seat, int* raise_to) {
+    HoldemPlayer* player = &game->players[seat];
+    int to_call = game->current_bet - player->round_bet;
+    int max_total = player->round_bet + player->chips;
+    int can_raise = max_total > game->current_bet && !player->raise_closed;
+    int choice;
+
+    holdem_display_table(game, seat);
+
+    if (game->board_count >= 3) {
+        int cards[7];
+        cards[0] = holdem_card_index(player->hole[0]);
+        cards[1] = holdem_card_index(player->hole[1]);
+        for (int i = 0; i < game->board_count; i++) {
+            cards[2 + i] = holdem_card_index(game->board[i]);
+        }
+        unsigned int value = poker_evaluate(cards, 2 + game->board_count);
+        printf("Your hand: %s\n", poker_category_name(poker_hand_category(value)));
+    }
+
+    if (game->show_hints) {
+        double equity = holdem_player_equity(game, player, HOLDEM_HINT_SAMPLES);
+        printf("Hint: %.1f%% equity vs %d opponent(s)", equity * 100, holdem_players_in_hand(game) - 1);
+        if (to_call > 0) {
+            printf(", pot odds need %.1f%%", 100.0 * to_call / (holdem_pot(game) + to_call));
+        }
+        printf("\n");
+    }
+
+    while (1) {
+        printf("\nYour options:\n");
+        printf("1. Fold\n");
+        if (to_call > 0) {
+            printf("2. Call %d%s\n", (to_call < player->chips) ? to_call : player->chips,
+                   (to_call >= player->chips) ? " (all-in)" : "");
+        } else {
+            printf("2. Check\n");
+        }
+        if (can_raise) {
+            printf("3. %s\n", (game->current_bet > 0) ? "Raise" : "Bet");
+        }
+        printf("4. Leave the table\n");
+        printf("Enter your choice: ");
+
+        if (scanf("%d", &choice) != 1) {
+            clear_input_buffer();
+            printf("Invalid action! Please try again.\n");
+            continue;
+        }
+        clear_input_buffer();
+
+        if (choice == 1) return ACTION_FOLD;
+        if (choice == 2) return ACTION_CHECK_CALL;
+        if (choice == 4) return ACTION_QUIT;
+        if (choice == 3 && can_raise) {
+            int min_total = game->current_bet + game->min_raise;
+            if (min_total > max_total) min_total = max_total;
+
+            printf("Raise to (%d-%d): ", min_total, max_total);
+            if (scanf("%d", raise_to) != 1) {
+                clear_input_buffer();
+                printf("Invalid amount!\n");
+                continue;
+            }
+            clear_input_buffer();
+
+            if (*raise_to < min_total || *raise_to > max_total) {
+                printf("Amount must be between %d and %d.\n", min_total, max_total);
+                continue;
+            }
+            return ACTION_RAISE;
+        }
+        printf("Invalid action! Please try again.\n");
+    }
+}
+
+static HoldemAction holdem_ai_action(HoldemGame* game, int seat, int* raise_to) {
+    HoldemPlayer* player = &game->players[seat];
+    int to_call = game->current_bet - player->round_bet;
+    int pot = holdem_pot(game);
+    int max_total = player->round_bet + player->chips;
+    int opponents = holdem_players_in_hand(game) - 1;
+
+    int can_raise = max_total > game->current_bet && !player->raise_closed;
+
+    double equity = holdem_player_equity(game, player, HOLDEM_AI_SAMPLES);
+    double noise = ((rand() % 1000) / 1000.0 - 0.5) * 0.08;
+    double fair_share = 1.0 / (opponents + 1);
+    double edge = equity - fair_share + noise + player->aggression;
+    double pot_odds = (to_call > 0) ? (double)to_call / (pot + to_call) : 0.0;
+
+    // Strong hands bet for value, scaled by how far ahead of a fair share we are
+    if (edge > 0.18 && can_raise) {
+        int size = (int)(pot * (0.5 + edge));
+        int target = game->current_bet + (size > game->min_raise ? size : game->min_raise);
+        if (target > max_total) target = max_total;
+        *raise_to = target;
+        return ACTION_RAISE;
+    }
+
+    // Occasional bluff when nobody has bet
+    if (to_call == 0) {
+        if (rand() % 100 < (int)(player->aggression * 100) && can_raise) {
+            *raise_to = game->current_bet + game->min_raise + pot / 3;
+            if (*raise_to > max_total) *raise_to = max_total;
+            return ACTION_RAISE;
+        }
+        return ACTION_CHECK_CALL;
+    }
+
+    if (equity + player->looseness + noise >= pot_odds) {
+        return ACTION_CHECK_CALL;
+    }
+    return ACTION_FOLD;
+}
+
+// Runs one betting round starting at 'first'. Returns 0 if the player
+// quits; they fold, and the hand is settled without them.
+static int holdem_betting_round(HoldemGame* game, int first) {
+    int remaining = holdem_players_able_to_act(game);
+    int seat = first;
+
+    while (remaining > 0 && holdem_players_in_hand(game) > 1) {
+        HoldemPlayer* player = &game->players[seat];
+
+        if (!player->out && !player->folded && !player->all_in) {
+            // A lone player with nothing to call has no decision left to make
+            if (holdem_players_able_to_act(game) == 1 && player->round_bet >= game->current_bet) {
+                break;
+            }
+
+            int raise_to = 0;
+            HoldemAction action = player->is_human
+                ? holdem_human_action(game, seat, &raise_to)
+                : holdem_ai_action(game, seat, &raise_to);
+
+            if (action == ACTION_QUIT) {
+                game->quit = 1;
+                player->folded = 1;
+                printf(">> %s leaves the table and folds.\n", player->name);
+                return 0;
+            }
+            player->acted = 1;
+
+            if (action == ACTION_FOLD) {
+                player->folded = 1;
+                printf(">> %s folds.\n", player->name);
+                remaining--;
+            } else if (action == ACTION_CHECK_CALL) {
+                int to_call = game->current_bet - player->round_bet;
+                if (to_call > 0) {
+                    holdem_put_chips(player, to_call);
+                    printf(">> %s calls %d.%s\n", player->name, to_call, player->all_in ? " (all-in)" : "");
+                } else {
+                    printf(">> %s checks.\n", player->name);
+                }
+                remaining--;
+            } else {
+                int raise_by = raise_to - game->current_bet;
+                holdem_put_chips(player, raise_to - player->round_bet);
+                if (player->round_bet > game->current_bet) {
+                    // A full raise reopens the betting. A short all-in only
+                    // has to be called: whoever already acted may not raise.
+                    int full = player->round_bet - game->current_bet >= game->min_raise;
+                    for (int i = 0; i < game->player_count; i++) {
+                        HoldemPlayer* other = &game->players[i];
+                        if (other == player) continue;
+                        if (full) {
+                            other->acted = 0;
+                            other->raise_closed = 0;
+                        } else if (other->acted) {
+                            other->raise_closed = 1;
+                        }
+                    }
+                    if (full) game->min_raise = player->round_bet - game->current_bet;
+                    game->current_bet = player->round_bet;
+                    printf(">> %s %s to %d.%s\n", player->name,
+                           (raise_to == raise_by) ? "bets" : "raises",
+                           player->round_bet, player->all_in ? " (all-in)" : "");
+                    // Everyone else still able to act must respond to the raise
+                    remaining = holdem_players_able_to_act(game) - (player->all_in ? 0 : 1);
+                } else {
+                    printf(">> %s calls %d.%s\n", player->name, player->round_bet, player->all_in ? " (all-in)" : "");
+                    remaining--;
+                }
+            }
+        }
+
+        seat = (seat + 1) % game->player_count;
+    }
+    return 1;
+}
+
+static void holdem_reset_round(HoldemGame* game) {
+    for (int i = 0; i < game->player_count; i++) {
+        game->players[i].round_bet = 0;
+        game->players[i].acted = 0;
+        game->players[i].raise_closed = 0;
+    }
+    game->current_bet = 0;
+    game->min_raise = HOLDEM_BIG_BLIND;
+}
+
+static void holdem_deal_board(HoldemGame* game, int count, const char* street) {
+    for (int i = 0; i < count; i++) {
+        game->board[game->board_count++] = deal_card(&game->deck);
+    }
+    printf("\n*** %s: ", street);
+    for (int i = 0; i < game->board_count; i++) {
+        display_card(game->board[i]);
+        printf(" ");
+    }
+    printf("***\n");
+}
+
+// Splits the pot into main and side pots and pays the best eligible hands
+static void holdem_showdown(HoldemGame* game) {
+    unsigned int values[HOLDEM_MAX_PLAYERS] = {0};
+    int remaining[HOLDEM_MAX_PLAYERS];
+    int cards[7];
+    int last_winner = -1;
+
+    for (int i = 0; i < game->board_count; i++) {
+        cards[2 + i] = holdem_card_index(game->board[i]);
+    }
+
+    printf("\n===========================================\n");
+    printf("               SHOWDOWN\n");
+    printf("===========================================\n");
+
+    for (int i = 0; i < game->player_count; i++) {
+        HoldemPlayer* p = &game->players[i];
+        remaining[i] = p->contributed;
+        if (p->out || p->folded) continue;
+
+        cards[0] = holdem_card_index(p->hole[0]);
+        cards[1] = holdem_card_index(p->hole[1]);
+        values[i] = poker_evaluate(cards, 7);
+
+        printf("%-8s ", p->name);
+        display_card(p->hole[0]);
+        printf(" ");
+        display_card(p->hole[1]);
+        printf("  %s\n", poker_category_name(poker_hand_category(values[i])));
+    }
+
+    while (1) {
+        // The next pot layer is capped by the smallest live contribution
+        int level = 0;
+        for (int i = 0; i < game->player_count; i++) {
+            const HoldemPlayer* p = &game->players[i];
+            if (!p->out && !p->folded && remaining[i] > 0 && (level == 0 || remaining[i] < level)) {
+                level = remaining[i];
+            }
+        }
+        if (level == 0) break;
+
+        int layer = 0;
+        unsigned int best = 0;
+        for (int i = 0; i < game->player_count; i++) {
+            const HoldemPlayer* p = &game->players[i];
+            if (!p->out && !p->folded && remaining[i] >= level && values[i] > best) {
+                best = values[i];
+            }
+            int take = (remaining[i] < level) ? remaining[i] : level;
+            layer += take;
+        }
+
+        int winners[HOLDEM_MAX_PLAYERS];
+        int winner_count = 0;
+        for (int step = 1; step <= game->player_count; step++) {
+            int i = (game->dealer + step) % game->player_count;
+            const HoldemPlayer* p = &game->players[i];
+            if (!p->out && !p->folded && remaining[i] >= level && values[i] == best) {
+                winners[winner_count++] = i;
+            }
+        }
+
+        for (int i = 0; i < game->player_count; i++) {
+            remaining[i] -= (remaining[i] < level) ? remaining[i] : level;
+        }
+
+        for (int w = 0; w < winner_count; w++) {
+            int share = layer / winner_count + (w < layer % winner_count ? 1 : 0);
+            game->players[winners[w]].chips += share;
+            printf("%s wins %d chips", game->players[winners[w]].name, share);
+            printf(" with %s\n", poker_category_name(poker_hand_category(best)));
+        }
+        last_winner = winners[0];
+    }
+
+    // Chips folded beyond the last live layer go to the last pot's winner
+    int leftover = 0;
+    for (int i = 0; i < game->player_count; i++) {
+        leftover += remaining[i];
+    }
+    if (leftover > 0 && last_winner >= 0) {
+        game->players[last_winner].chips += leftover;
+    }
+}
+
+static void holdem_award_uncontested(HoldemGame* game) {
+    for (int i = 0; i < game->player_count; i++) {
+        HoldemPlayer* p = &game->players[i];
+        if (!p->out && !p->folded) {
+            int pot = holdem_pot(game);
+            p->chips += pot;
+            printf("\n*** %s wins %d chips uncontested! ***\n", p->name, pot);
+            return;
+        }
+    }
+}
+
+static void holdem_play_hand(HoldemGame* game) {
+    static const char* streets[] = {"FLOP", "TURN", "RIVER"};
+    static const int street_cards[] = {3, 1, 1};
+
+    initialize_deck(&game->deck);
+    shuffle_deck(&game->deck);
+    game->board_count = 0;
+
+    for (int i = 0; i < game->player_count; i++) {
+        HoldemPlayer* p = &game->players[i];
+        p->folded = p->out;
+        p->all_in = 0;
+        p->round_bet = 0;
+        p->contributed = 0;
+    }
+    for (int card = 0; card < 2; card++) {
+        for (int i = 0; i < game->player_count; i++) {
+            if (!game->players[i].out) {
+                game->players[i].hole[card] = deal_card(&game->deck);
+            }
+        }
+    }
+
+    holdem_reset_round(game);
+
+    // Heads-up the dealer posts the small blind
+    int active = holdem_players_in_hand(game);
+    int small_blind = (active == 2) ? game->dealer : holdem_next_seat(game, game->dealer);
+    int big_blind = holdem_next_seat(game, small_blind);
+
+    holdem_put_chips(&game->players[small_blind], HOLDEM_SMALL_BLIND);
+    holdem_put_chips(&game->players[big_blind], HOLDEM_BIG_BLIND);
+    game->current_bet = HOLDEM_BIG_BLIND;
+    printf("\n%s posts small blind %d, %s posts big blind %d.\n",
+           game->players[small_blind].name, HOLDEM_SMALL_BLIND,
+           game->players[big_blind].name, HOLDEM_BIG_BLIND);
+
+    // After the player leaves, the rest of the board is dealt without
+    // betting and the pot goes to the best hand still in
+    int betting = holdem_betting_round(game, holdem_next_seat(game, big_blind));
+
+    for (int street = 0; street < 3 && holdem_players_in_hand(game) > 1; street++) {
+        holdem_reset_round(game);
+        holdem_deal_board(game, street_cards[street], streets[street]);
+        if (betting && holdem_players_able_to_act(game) > 1) {
+            betting = holdem_betting_round(game, holdem_next_seat(game, game->dealer));
+        }
+    }
+
+    if (holdem_players_in_hand(game) == 1) {
+        holdem_award_uncontested(game);
+    } else {
+        holdem_showdown(game);
+    }
+}
+
+static void display_holdem_stats(const HoldemGame* game) {
+    const HoldemPlayer* human = &game->players[0];
+
+    printf("\n===========================================\n");
+    printf("            GAME STATISTICS\n");
+    printf("===========================================\n");
+    printf("Hands Played:      %d\n", game->hands_played);
+    printf("Hands Won:         %d\n", game->hands_won);
+    printf("Final Chips:       %d\n", human->chips);
+    printf("Total Profit/Loss: %+d chips\n", human->chips - HOLDEM_STARTING_CHIPS);
+    printf("===========================================\n");
+}
+
+void play_texas_holdem(void) {
+    HoldemGame game;
+    int opponents;
+    char hint_choice;
+
+    memset(&game, 0, sizeof(game));
+    display_holdem_rules();
+    poker_eval_init();
+
+    printf("\nHow many AI opponents? (1-%d): ", HOLDEM_MAX_PLAYERS - 1);
+    if (scanf("%d", &opponents) != 1 || opponents < 1 || opponents > HOLDEM_MAX_PLAYERS - 1) {
+        opponents = 3;
+        printf("Invalid choice, playing against %d opponents.\n", opponents);
+    }
+    clear_input_buffer();
+
+    printf("Show equity hints on your turn? (y/n): ");
+    if (scanf(" %c", &hint_choice) == 1) {
+        game.show_hints = (hint_choice == 'y' || hint_choice == 'Y');
+    }
+    clear_input_buffer();
+
+    game.player_count = opponents + 1;
+    strcpy(game.players[0].name, "You");
+    game.players[0].is_human = 1;
+    game.players[0].chips = HOLDEM_STARTING_CHIPS;
+    for (int i = 1; i < game.player_count; i++) {
+        HoldemPlayer* p = &game.players[i];
+        strcpy(p->name, holdem_ai_names[i - 1]);
+        p->chips = HOLDEM_STARTING_CHIPS;
+        p->looseness = holdem_ai_looseness[i - 1];
+        p->aggression = holdem_ai_aggression[i - 1];
+    }
+    game.dealer = rand() % game.player_count;
+
+    while (!game.quit) {
+        int human_chips_before = game.players[0].chips;
+
+        printf("\n>>> New Hand <<<\n");
+        game.hands_played++;
+        holdem_play_hand(&game);
+
+        if (game.players[0].chips > human_chips_before) {
+            game.hands_won++;
+        }
+
+        int alive = 0;
+        for (int i = 0; i < game.player_count; i++) {
+            HoldemPlayer* p = &game.players[i];
+            if (!p->out && p->chips == 0) {
+                p->out = 1;
+                printf("*** %s is out of chips! ***\n", p->name);
+            }
+            if (!p->out) alive++;
+        }
+
+        if (game.quit) break;
+        if (game.players[0].out) {
+            printf("\n*** GAME OVER! You're out of chips! ***\n");
+            break;
+        }
+        if (alive == 1) {
+            printf("\n*** CONGRATULATIONS! You won the table! ***\n");
+            break;
+        }
+
+        printf("\nYou have %d chips. Play another hand? (y/n): ", game.players[0].chips);
+        char continue_game;
+        if (scanf(" %c", &continue_game) != 1 || (continue_game != 'y' && continue_game != 'Y')) {
+            clear_input_buffer();
+            break;
+        }
+        clear_input_buffer();
+
+        game.dealer = holdem_next_seat(&game, game.dealer);
+    }
+
+    display_holdem_stats(&game);
+    printf("\nThanks for playing Texas Hold'em!\n");
+}
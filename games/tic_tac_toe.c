@@ -1,4 +1,5 @@
 #include "games.h"
+#include "ratings.h"
 
 #define BOARD_SIZE 3
 #define EMPTY ' '
@@ -45,6 +46,7 @@ void display_instructions(void) {
     printf("* Take turns placing your mark\n");
     printf("* Get 3 in a row (horizontal, vertical, or diagonal) to win!\n");
     printf("* Enter row and column (1-3) to make your move\n");
+    printf("* Enter both names to play a rated game\n");
     printf("-------------------------------------------\n");
 }
 
@@ -147,20 +149,39 @@ void display_winner(char winner) {
     printf("-------------------------------------------\n");
 }
 
+// One line, cut to the ladder's name length; the rest of a long line is dropped
+static void read_player_name(const char* prompt, char* name) {
+    printf("%s", prompt);
+    if (!fgets(name, RATINGS_NAME_LEN, stdin)) {
+        name[0] = '\0';
+        return;
+    }
+    size_t length = strcspn(name, "\n");
+    if (name[length] != '\n') clear_input_buffer();
+    name[length] = '\0';
+}
+
 void play_tic_tac_toe(void) {
     TicTacToeGame game;
     char winner;
     int row, col;
     int valid_move;
+    char player_x[RATINGS_NAME_LEN], player_o[RATINGS_NAME_LEN];
     
     display_instructions();
     
+    // Ratings belong to the people, so a game is only rated with both names
+    read_player_name("\nPlayer 1 (X) name: ", player_x);
+    read_player_name("Player 2 (O) name: ", player_o);
+    int rated = player_x[0] && player_o[0] && strcmp(player_x, player_o) != 0;
+    if (!rated) printf("(Unrated: the ladder needs two different names)\n");
+    
     while (1) {
         init_board(&game);
         
         printf("\n*** New Game Started!\n");
-        printf("Player 1: X\n");
-        printf("Player 2: O\n");
+        printf("Player 1: X%s%s\n", player_x[0] ? " - " : "", player_x);
+        printf("Player 2: O%s%s\n", player_o[0] ? " - " : "", player_o);
         
         while (1) {
             display_board(&game);
@@ -181,6 +202,10 @@ void play_tic_tac_toe(void) {
             if (winner != EMPTY) {
                 display_board(&game);
                 display_winner(winner);
+                if (rated) {
+                    ratings_record_match(RATING_GAME_TIC_TAC_TOE, player_x, player_o,
+                                         winner == PLAYER_X ? RATING_WIN : RATING_LOSS);
+                }
                 break;
             }
             
@@ -188,6 +213,7 @@ void play_tic_tac_toe(void) {
             if (is_board_full(&game)) {
                 display_board(&game);
                 display_winner(EMPTY); // Tie game
+                if (rated) ratings_record_match(RATING_GAME_TIC_TAC_TOE, player_x, player_o, RATING_DRAW);
                 break;
             }
             
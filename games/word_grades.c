@@ -0,0 +1,520 @@
+/*
+ * Word Difficulty Grades
+ * Part of CLI Games Pack v2.1
+ *
+ * Layout of word_grades.idx: a 96-byte header {magic, word count, entry
+ * count, string bytes, the three buckets of each pool}, then the bucket
+ * entries (uint32 offsets into the string table, each pool's buckets in
+ * easy, medium, hard order), then the NUL-terminated words.
+ *
+ * The Hangman tree is split after its first guess: the main thread makes
+ * each word length's opening guess, and the groups it leaves are handed
+ * to the threads, largest first. Scramble signatures (the word's letters
+ * in order, five bits each) are packed into two integers so anagram
+ * classes are found by one sort.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "word_grades.h"
+#include "highscores.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#define INDEX_FILE "word_grades.idx"
+#define INDEX_MAGIC 0x31524757u             // "WGR1"
+#define SIGNATURE_CHUNK 4096
+
+typedef struct {
+    uint32_t magic;
+    uint32_t word_count;
+    uint32_t entry_count;
+    uint32_t string_bytes;
+    WordGradeBucket buckets[WORD_POOL_COUNT][WORD_GRADE_COUNT];
+    uint8_t reserved[8];
+} IndexHeader;
+
+typedef char index_header_is_96_bytes[sizeof(IndexHeader) == 96 ? 1 : -1];
+
+// A group of words that have produced the same board so far
+typedef struct {
+    uint32_t offset, count;             // Slice of the tree's items
+    uint32_t guessed;                   // Letters tried, bit 0 = A
+    uint16_t misses, guesses;
+} TreeNode;
+
+typedef struct {
+    const char* const* words;
+    const uint32_t* letters;            // Letters of each word, bit 0 = A
+    uint32_t* items;                    // Word indices, grouped by node
+    uint64_t* pairs;                    // Sort scratch, aligned with items
+    uint16_t* scores;
+    const TreeNode* nodes;
+    int node_count;
+    int* next;
+} HangmanTree;
+
+typedef struct {
+    uint64_t high, low;                 // Sorted letters, five bits each
+    uint32_t index;
+} Signature;
+
+typedef struct {
+    const char* const* words;
+    Signature* signatures;
+    int count;
+    int* next;
+} SignatureJob;
+
+static const IndexHeader* pools[WORD_POOL_COUNT];
+static IndexHeader* local_index[WORD_POOL_COUNT];
+static void* mapping;
+static size_t mapping_size;
+static int index_tried;
+
+static int default_threads(void) {
+#ifdef _WIN32
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > WORD_GRADES_MAX_THREADS) cores = WORD_GRADES_MAX_THREADS;
+    return (int)cores;
+#endif
+}
+
+// Runs worker(job) on threads threads, the calling one included
+static void run_workers(void* (*worker)(void*), void* job, int threads) {
+    if (threads <= 0) threads = default_threads();
+    if (threads > WORD_GRADES_MAX_THREADS) threads = WORD_GRADES_MAX_THREADS;
+#ifndef _WIN32
+    pthread_t handles[WORD_GRADES_MAX_THREADS];
+    int started[WORD_GRADES_MAX_THREADS] = {0};
+    for (int t = 1; t < threads; t++) {
+        started[t] = (pthread_create(&handles[t], NULL, worker, job) == 0);
+    }
+    worker(job);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(handles[t], NULL);
+    }
+#else
+    (void)threads;
+    worker(job);
+#endif
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_nodes_by_size(const void* a, const void* b) {
+    uint32_t x = ((const TreeNode*)a)->count, y = ((const TreeNode*)b)->count;
+    return (x < y) - (x > y);
+}
+
+// Plays one node: picks the guesser's letter, splits the words by where
+// it appears, and either solves each group or hands it back in deferred
+static void solve(const HangmanTree* tree, TreeNode node, TreeNode* deferred, int* deferred_count) {
+    uint32_t* items = tree->items + node.offset;
+    uint64_t* pairs = tree->pairs + node.offset;
+    int n = (int)node.count;
+
+    // One word left: the guesser knows it and names its remaining letters
+    if (n == 1) {
+        int remaining = __builtin_popcount(tree->letters[items[0]] & ~node.guessed);
+        uint32_t misses = node.misses > 2047 ? 2047 : node.misses;
+        tree->scores[items[0]] = (uint16_t)(misses << 5 | (uint32_t)(node.guesses + remaining));
+        return;
+    }
+
+    int counts[26] = {0};
+    for (int i = 0; i < n; i++) {
+        for (uint32_t bits = tree->letters[items[i]] & ~node.guessed; bits; bits &= bits - 1) {
+            counts[__builtin_ctz(bits)]++;
+        }
+    }
+    int letter = 0;
+    for (int l = 1; l < 26; l++) {
+        if (counts[l] > counts[letter]) letter = l;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const char* word = tree->words[items[i]];
+        uint32_t positions = 0;
+        for (int c = 0; word[c]; c++) {
+            if (word[c] - 'A' == letter) positions |= 1u << c;
+        }
+        pairs[i] = (uint64_t)positions << 32 | items[i];
+    }
+    qsort(pairs, (size_t)n, sizeof(uint64_t), compare_u64);
+    for (int i = 0; i < n; i++) items[i] = (uint32_t)pairs[i];
+
+    for (int start = 0; start < n;) {
+        uint32_t positions = (uint32_t)(pairs[start] >> 32);
+        int end = start + 1;
+        while (end < n && (uint32_t)(pairs[end] >> 32) == positions) end++;
+        TreeNode child = {node.offset + (uint32_t)start, (uint32_t)(end - start), node.guessed | 1u << letter,
+                          (uint16_t)(node.misses + (positions == 0)), (uint16_t)(node.guesses + 1)};
+        if (deferred) {
+            deferred[(*deferred_count)++] = child;
+        } else {
+            solve(tree, child, NULL, NULL);
+        }
+        start = end;
+    }
+}
+
+static void* hangman_worker(void* arg) {
+    HangmanTree* tree = (HangmanTree*)arg;
+    for (;;) {
+        int index = __atomic_fetch_add(tree->next, 1, __ATOMIC_RELAXED);
+        if (index >= tree->node_count) break;
+        solve(tree, tree->nodes[index], NULL, NULL);
+    }
+    return NULL;
+}
+
+void word_grades_hangman(const char* const* words, int count, int threads, uint16_t* scores) {
+    if (count <= 0) return;
+    uint32_t* letters = malloc((size_t)count * sizeof(uint32_t));
+    uint32_t* items = malloc((size_t)count * sizeof(uint32_t));
+    uint64_t* pairs = malloc((size_t)count * sizeof(uint64_t));
+    TreeNode* nodes = malloc((size_t)count * sizeof(TreeNode));
+    if (!letters || !items || !pairs || !nodes) {
+        memset(scores, 0, (size_t)count * sizeof(uint16_t));
+        goto done;
+    }
+
+    // Words only ever share a board with words of the same length
+    for (int i = 0; i < count; i++) {
+        uint32_t mask = 0;
+        size_t length = strlen(words[i]);
+        for (size_t c = 0; c < length; c++) mask |= 1u << (words[i][c] - 'A');
+        letters[i] = mask;
+        pairs[i] = (uint64_t)length << 32 | (uint32_t)i;
+    }
+    qsort(pairs, (size_t)count, sizeof(uint64_t), compare_u64);
+    for (int i = 0; i < count; i++) items[i] = (uint32_t)pairs[i];
+
+    int next = 0, node_count = 0;
+    HangmanTree tree = {words, letters, items, pairs, scores, nodes, 0, &next};
+    for (int start = 0; start < count;) {
+        uint64_t length = pairs[start] >> 32;
+        int end = start + 1;
+        while (end < count && pairs[end] >> 32 == length) end++;
+        TreeNode root = {(uint32_t)start, (uint32_t)(end - start), 0, 0, 0};
+        solve(&tree, root, nodes, &node_count);
+        start = end;
+    }
+    qsort(nodes, (size_t)node_count, sizeof(TreeNode), compare_nodes_by_size);
+    tree.node_count = node_count;
+    run_workers(hangman_worker, &tree, threads);
+
+done:
+    free(letters);
+    free(items);
+    free(pairs);
+    free(nodes);
+}
+
+static void* signature_worker(void* arg) {
+    SignatureJob* job = (SignatureJob*)arg;
+    for (;;) {
+        int first = __atomic_fetch_add(job->next, SIGNATURE_CHUNK, __ATOMIC_RELAXED);
+        if (first >= job->count) break;
+        int end = first + SIGNATURE_CHUNK < job->count ? first + SIGNATURE_CHUNK : job->count;
+        for (int i = first; i < end; i++) {
+            int counts[26] = {0};
+            for (const char* c = job->words[i]; *c; c++) counts[*c - 'A']++;
+
+            // Letter codes 1-26 in order: twelve in high, the rest in low
+            Signature* signature = &job->signatures[i];
+            signature->high = signature->low = 0;
+            signature->index = (uint32_t)i;
+            int position = 0;
+            for (int l = 0; l < 26; l++) {
+                for (int k = 0; k < counts[l]; k++, position++) {
+                    if (position < 12) {
+                        signature->high |= (uint64_t)(l + 1) << (59 - 5 * position);
+                    } else {
+                        signature->low |= (uint64_t)(l + 1) << (59 - 5 * (position - 12));
+                    }
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+static int compare_signatures(const void* a, const void* b) {
+    const Signature* x = (const Signature*)a;
+    const Signature* y = (const Signature*)b;
+    if (x->high != y->high) return x->high < y->high ? -1 : 1;
+    if (x->low != y->low) return x->low < y->low ? -1 : 1;
+    return 0;
+}
+
+void word_grades_scramble(const char* const* words, int count, int threads, uint16_t* scores) {
+    if (count <= 0) return;
+    Signature* signatures = malloc((size_t)count * sizeof(Signature));
+    if (!signatures) {
+        memset(scores, 0, (size_t)count * sizeof(uint16_t));
+        return;
+    }
+
+    int next = 0;
+    SignatureJob job = {words, signatures, count, &next};
+    run_workers(signature_worker, &job, threads);
+    qsort(signatures, (size_t)count, sizeof(Signature), compare_signatures);
+
+    for (int start = 0; start < count;) {
+        int end = start + 1;
+        while (end < count && compare_signatures(&signatures[start], &signatures[end]) == 0) end++;
+        uint32_t anagrams = (uint32_t)(end - start - 1);
+        if (anagrams > 2047) anagrams = 2047;
+        for (int i = start; i < end; i++) {
+            uint32_t index = signatures[i].index;
+            scores[index] = (uint16_t)(anagrams << 5 | (uint32_t)strlen(words[index]));
+        }
+        start = end;
+    }
+    free(signatures);
+}
+
+// Header, entries and strings in one block, as stored in the file
+static IndexHeader* build_index(const char* const* words, int count, int threads, size_t* size) {
+    uint16_t* scores[WORD_POOL_COUNT];
+    uint32_t* offsets = malloc((size_t)count * sizeof(uint32_t));
+    uint64_t* ranked = malloc((size_t)count * sizeof(uint64_t));
+    IndexHeader* index = NULL;
+
+    scores[WORD_POOL_HANGMAN] = malloc((size_t)count * sizeof(uint16_t));
+    scores[WORD_POOL_SCRAMBLE] = malloc((size_t)count * sizeof(uint16_t));
+    if (!offsets || !ranked || !scores[WORD_POOL_HANGMAN] || !scores[WORD_POOL_SCRAMBLE]) goto done;
+    word_grades_hangman(words, count, threads, scores[WORD_POOL_HANGMAN]);
+    word_grades_scramble(words, count, threads, scores[WORD_POOL_SCRAMBLE]);
+
+    uint32_t string_bytes = 0, entry_count = 0;
+    for (int i = 0; i < count; i++) {
+        size_t length = strlen(words[i]);
+        offsets[i] = string_bytes;
+        string_bytes += (uint32_t)length + 1;
+        entry_count += 1 + (length <= WORD_GRADES_SCRAMBLE_MAX_LENGTH);
+    }
+    *size = sizeof(IndexHeader) + entry_count * sizeof(uint32_t) + string_bytes;
+    index = calloc(1, *size);
+    if (!index) goto done;
+    index->magic = INDEX_MAGIC;
+    index->word_count = (uint32_t)count;
+    index->entry_count = entry_count;
+    index->string_bytes = string_bytes;
+    uint32_t* entries = (uint32_t*)(index + 1);
+    char* strings = (char*)(entries + entry_count);
+    for (int i = 0; i < count; i++) memcpy(strings + offsets[i], words[i], strlen(words[i]) + 1);
+
+    // Each pool ranked by score (ties in list order) and cut into thirds
+    uint32_t next_entry = 0;
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) {
+        int members = 0;
+        for (int i = 0; i < count; i++) {
+            if (pool == WORD_POOL_SCRAMBLE && strlen(words[i]) > WORD_GRADES_SCRAMBLE_MAX_LENGTH) continue;
+            ranked[members++] = (uint64_t)scores[pool][i] << 32 | (uint32_t)i;
+        }
+        qsort(ranked, (size_t)members, sizeof(uint64_t), compare_u64);
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) {
+            int first = members * grade / WORD_GRADE_COUNT;
+            int end = members * (grade + 1) / WORD_GRADE_COUNT;
+            WordGradeBucket* bucket = &index->buckets[pool][grade];
+            bucket->first = next_entry;
+            bucket->count = (uint32_t)(end - first);
+            bucket->min_score = end > first ? (uint16_t)(ranked[first] >> 32) : 0;
+            bucket->max_score = end > first ? (uint16_t)(ranked[end - 1] >> 32) : 0;
+            for (int r = first; r < end; r++) entries[next_entry++] = offsets[(uint32_t)ranked[r]];
+        }
+    }
+
+done:
+    free(offsets);
+    free(ranked);
+    free(scores[WORD_POOL_HANGMAN]);
+    free(scores[WORD_POOL_SCRAMBLE]);
+    return index;
+}
+
+int word_grades_path(char* path, int size) {
+    return highscore_shared_path(INDEX_FILE, path, size);
+}
+
+int word_grades_write(const char* path, const char* const* words, int count, int threads) {
+    char temp_path[600];
+    size_t size;
+
+    if (count <= 0) return 0;
+#ifndef _WIN32
+    const char* dir = highscore_shared_dir();
+    if (strncmp(path, dir, strlen(dir)) == 0 && !highscore_make_shared_dir()) return 0;
+#endif
+
+    IndexHeader* index = build_index(words, count, threads, &size);
+    if (!index) return 0;
+#ifndef _WIN32
+    int fd = highscore_create_temp(path, temp_path, sizeof(temp_path));
+    if (fd < 0) {
+        free(index);
+        return 0;
+    }
+    FILE* file = fdopen(fd, "wb");
+    if (!file) close(fd);
+#else
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", path, (long)getpid());
+    FILE* file = fopen(temp_path, "wb");
+#endif
+    int ok = file != NULL && fwrite(index, 1, size, file) == size;
+    if (file) ok = fclose(file) == 0 && ok;
+    free(index);
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    word_grades_close();                        // Pick up the new index on next open
+    return 1;
+}
+
+// A word the games can copy: A-Z only and short enough for the pool's buffer
+static int word_valid(const char* word, size_t room, int max_length) {
+    int length = 0;
+    for (; (size_t)length < room && word[length] != '\0'; length++) {
+        if (word[length] < 'A' || word[length] > 'Z' || length == max_length) return 0;
+    }
+    return length > 0 && (size_t)length < room;
+}
+
+// Every bucket, entry and word must land inside the file and fit the
+// game that picks it before it is trusted
+static int index_valid(const IndexHeader* index, size_t size) {
+    if (size < sizeof(IndexHeader) || index->magic != INDEX_MAGIC ||
+        size != sizeof(IndexHeader) + (size_t)index->entry_count * sizeof(uint32_t) + index->string_bytes ||
+        index->string_bytes == 0) {
+        return 0;
+    }
+    const uint32_t* entries = (const uint32_t*)(index + 1);
+    const char* strings = (const char*)(entries + index->entry_count);
+    if (strings[index->string_bytes - 1] != '\0') return 0;
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) {
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) {
+            const WordGradeBucket* bucket = &index->buckets[pool][grade];
+            if (bucket->first > index->entry_count || bucket->count > index->entry_count - bucket->first) return 0;
+        }
+    }
+    for (uint32_t i = 0; i < index->entry_count; i++) {
+        if (entries[i] >= index->string_bytes) return 0;
+    }
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) {
+        int max_length = pool == WORD_POOL_HANGMAN ? WORD_GRADES_MAX_LENGTH : WORD_GRADES_SCRAMBLE_MAX_LENGTH;
+        for (int grade = 0; grade < WORD_GRADE_COUNT; grade++) {
+            const WordGradeBucket* bucket = &index->buckets[pool][grade];
+            for (uint32_t i = bucket->first; i < bucket->first + bucket->count; i++) {
+                if (!word_valid(strings + entries[i], index->string_bytes - entries[i], max_length)) return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void load_index(void) {
+    char path[512];
+    if (!word_grades_path(path, sizeof(path))) return;
+#ifndef _WIN32
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(IndexHeader)) {
+        close(fd);
+        return;
+    }
+    void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return;
+    if (!index_valid((const IndexHeader*)mapped, (size_t)st.st_size)) {
+        munmap(mapped, (size_t)st.st_size);
+        return;
+    }
+    mapping = mapped;
+    mapping_size = (size_t)st.st_size;
+#else
+    FILE* file = fopen(path, "rb");
+    if (!file) return;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = size > 0 ? malloc((size_t)size) : NULL;
+    int ok = data && fread(data, 1, (size_t)size, file) == (size_t)size &&
+             index_valid((const IndexHeader*)data, (size_t)size);
+    fclose(file);
+    if (!ok) {
+        free(data);
+        return;
+    }
+    mapping = data;
+    mapping_size = (size_t)size;
+#endif
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) pools[pool] = (const IndexHeader*)mapping;
+}
+
+int word_grades_open(WordPool pool, const char* const* fallback, int fallback_count) {
+    if (!index_tried) {
+        index_tried = 1;
+        load_index();
+    }
+    if (!pools[pool] && fallback_count > 0) {
+        size_t size;
+        local_index[pool] = build_index(fallback, fallback_count, 1, &size);
+        pools[pool] = local_index[pool];
+    }
+    return pools[pool] != NULL && pools[pool] == mapping;
+}
+
+void word_grades_close(void) {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_size);
+#else
+    free(mapping);
+#endif
+    for (int pool = 0; pool < WORD_POOL_COUNT; pool++) {
+        free(local_index[pool]);
+        local_index[pool] = NULL;
+        pools[pool] = NULL;
+    }
+    mapping = NULL;
+    mapping_size = 0;
+    index_tried = 0;
+}
+
+const WordGradeBucket* word_grades_bucket(WordPool pool, WordGrade grade) {
+    return pools[pool] ? &pools[pool]->buckets[pool][grade] : NULL;
+}
+
+const char* word_grades_pick(WordPool pool, WordGrade grade, uint32_t random) {
+    const IndexHeader* index = pools[pool];
+    if (!index || index->buckets[pool][grade].count == 0) return NULL;
+    const WordGradeBucket* bucket = &index->buckets[pool][grade];
+    const uint32_t* entries = (const uint32_t*)(index + 1);
+    const char* strings = (const char*)(entries + index->entry_count);
+    return strings + entries[bucket->first + random % bucket->count];
+}
+
+const char* word_grades_name(WordGrade grade) {
+    static const char* const names[WORD_GRADE_COUNT] = {"Easy", "Medium", "Hard"};
+    return names[grade];
+}
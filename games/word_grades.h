@@ -0,0 +1,73 @@
+#ifndef WORD_GRADES_H
+#define WORD_GRADES_H
+
+#include <stdint.h>
+
+/*
+ * Difficulty grades for the Hangman and Word Scramble word pools.
+ *
+ * Hangman words are graded by playing them against a simulated guesser
+ * that knows the whole dictionary: it always guesses the letter found in
+ * the most words still consistent with the board. The guesser is
+ * deterministic, so words that have produced the same board so far share
+ * every earlier step. The whole dictionary is therefore played as one
+ * decision tree per word length, and each word costs about one visit per
+ * guess. A word's score is the guesser's misses, then its total guesses.
+ *
+ * Scramble words are graded by anagram ambiguity: how many other
+ * dictionary words use exactly the same letters, then by length.
+ *
+ * An offline batch job (make grades) grades a dictionary on every core
+ * and writes a compact index to the shared directory: each pool sorted
+ * by score and cut into thirds, stored as offsets into one string table.
+ * At play time, picking an easy, medium or hard word is one random index
+ * into the mapped bucket. Without an index, a game grades its own
+ * built-in list when it first asks for a level.
+ */
+
+#define WORD_GRADES_MAX_LENGTH 19           // Longest Hangman word
+#define WORD_GRADES_SCRAMBLE_MAX_LENGTH 14  // Longest Word Scramble word
+#define WORD_GRADES_MAX_THREADS 64
+
+// A Hangman score packs the guesser's misses above its guess count
+#define WORD_GRADES_MISSES(score) ((score) >> 5)
+
+typedef enum {
+    WORD_POOL_HANGMAN,
+    WORD_POOL_SCRAMBLE,
+    WORD_POOL_COUNT
+} WordPool;
+
+typedef enum {
+    WORD_GRADE_EASY,
+    WORD_GRADE_MEDIUM,
+    WORD_GRADE_HARD,
+    WORD_GRADE_COUNT
+} WordGrade;
+
+typedef struct {
+    uint32_t first;                     // First entry of the bucket
+    uint32_t count;
+    uint16_t min_score, max_score;
+} WordGradeBucket;
+
+// Scores for uppercase A-Z words, in the order given. The words must be
+// distinct; each one is graded against all the others.
+void word_grades_hangman(const char* const* words, int count, int threads, uint16_t* scores);
+void word_grades_scramble(const char* const* words, int count, int threads, uint16_t* scores);
+
+// Grades words (threads <= 0: one per core) and writes the index to path
+int word_grades_write(const char* path, const char* const* words, int count, int threads);
+int word_grades_path(char* path, int size);
+
+// Maps the index from the shared directory, or grades fallback (the
+// game's built-in list) when there is none. Returns 1 for the index.
+int word_grades_open(WordPool pool, const char* const* fallback, int fallback_count);
+void word_grades_close(void);
+
+// O(1): the word at random % bucket size; NULL if the pool is not open
+const char* word_grades_pick(WordPool pool, WordGrade grade, uint32_t random);
+const WordGradeBucket* word_grades_bucket(WordPool pool, WordGrade grade);
+const char* word_grades_name(WordGrade grade);
+
+#endif // WORD_GRADES_H
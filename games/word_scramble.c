@@ -1,4 +1,6 @@
 #include "games.h"
+#include "daily.h"
+#include "word_grades.h"
 
 #define MAX_WORD_LENGTH 15
 #define MAX_SCRAMBLED_LENGTH 20
@@ -25,14 +27,19 @@ const char* scramble_words[] = {
 
 const int SCRAMBLE_WORD_COUNT = sizeof(scramble_words) / sizeof(scramble_words[0]);
 
-void scramble_word(const char* original, char* scrambled) {
+// Draws from the daily stream when one is given, otherwise from rand()
+static int pick(uint64_t* stream, int bound) {
+    return stream ? daily_below(stream, bound) : rand() % bound;
+}
+
+void scramble_word(const char* original, char* scrambled, uint64_t* stream) {
     int len = strlen(original);
     strcpy(scrambled, original);
     
     // Simple scrambling algorithm - swap letters randomly
     for (int i = 0; i < len * 2; i++) {
-        int pos1 = rand() % len;
-        int pos2 = rand() % len;
+        int pos1 = pick(stream, len);
+        int pos2 = pick(stream, len);
         
         // Swap characters
         char temp = scrambled[pos1];
@@ -43,8 +50,8 @@ void scramble_word(const char* original, char* scrambled) {
     // Make sure the scrambled word is different from original
     int attempts = 0;
     while (strcmp(scrambled, original) == 0 && attempts < 10) {
-        int pos1 = rand() % len;
-        int pos2 = rand() % len;
+        int pos1 = pick(stream, len);
+        int pos2 = pick(stream, len);
         if (pos1 != pos2) {
             char temp = scrambled[pos1];
             scrambled[pos1] = scrambled[pos2];
@@ -61,7 +68,9 @@ void display_scramble_rules(void) {
     printf("How to play:\n");
     printf("* I'll show you a scrambled word\n");
     printf("* Unscramble it to find the original word\n");
-    printf("* All words are computer/technology related\n");
+    printf("* Random and daily words are computer/technology related\n");
+    printf("* Easy, medium and hard words are graded by how many\n");
+    printf("  other words share their letters\n");
     printf("* You have 3 attempts per word\n");
     printf("* Type 'hint' for a clue!\n");
     printf("-------------------------------------------\n");
@@ -81,7 +90,13 @@ void give_hint(const char* word) {
     } else if (strstr(word, "KEYBOARD") || strstr(word, "MONITOR") || strstr(word, "PRINTER")) {
         printf("Category: Computer peripheral\n");
     } else {
-        printf("Category: Technology\n");
+        // Graded words may come from the whole dictionary
+        for (int i = 0; i < SCRAMBLE_WORD_COUNT; i++) {
+            if (strcmp(word, scramble_words[i]) == 0) {
+                printf("Category: Technology\n");
+                break;
+            }
+        }
     }
 }
 
@@ -97,18 +112,33 @@ int check_guess(const char* guess, const char* original) {
     return strcmp(upper_guess, original) == 0;
 }
 
-void play_single_scramble(WordScrambleGame* game) {
-    // Select random word
-    int word_index = rand() % SCRAMBLE_WORD_COUNT;
-    strcpy(game->original_word, scramble_words[word_index]);
+// A daily round uses today's word and scramble, the same for everyone;
+// otherwise grade >= 0 picks a word of that difficulty
+void play_single_scramble(WordScrambleGame* game, int daily, int grade) {
+    uint64_t stream = daily_seed(DAILY_WORD_SCRAMBLE, daily_today());
+    uint64_t* source = daily ? &stream : NULL;
+    
+    // Select the word
+    const char* word = NULL;
+    if (!daily && grade >= 0) {
+        word = word_grades_pick(WORD_POOL_SCRAMBLE, (WordGrade)grade, (uint32_t)rand());
+    }
+    if (word == NULL) {
+        word = scramble_words[pick(source, SCRAMBLE_WORD_COUNT)];
+    }
+    snprintf(game->original_word, sizeof(game->original_word), "%s", word);
     
     // Scramble the word
-    scramble_word(game->original_word, game->scrambled_word);
+    scramble_word(game->original_word, game->scrambled_word, source);
     
     game->attempts = 0;
     game->max_attempts = 3;
     
-    printf("\n>>> New Word Scramble! <<<\n");
+    if (!daily && grade >= 0) {
+        printf("\n>>> New %s Word Scramble! <<<\n", word_grades_name((WordGrade)grade));
+    } else {
+        printf("\n>>> New %s Scramble! <<<\n", daily ? "Daily Word" : "Word");
+    }
     printf("Scrambled word: %s\n", game->scrambled_word);
     printf("You have %d attempts to unscramble it.\n", game->max_attempts);
     printf("(Type 'hint' for a clue, 'quit' to return to menu)\n");
@@ -167,11 +197,22 @@ void play_word_scramble(void) {
     WordScrambleGame game;
     int total_score = 0;
     int games_played = 0;
+    char line[16];
     
     display_scramble_rules();
+    printf("Press Enter for a random word, E/M/H for an easy, medium or hard one,\n");
+    printf("or D for today's daily word: ");
+    char choice = fgets(line, sizeof(line), stdin) ? (char)toupper((unsigned char)line[0]) : '\n';
+    int daily = choice == 'D';
+    int grade = choice == 'E' ? WORD_GRADE_EASY : choice == 'M' ? WORD_GRADE_MEDIUM :
+                choice == 'H' ? WORD_GRADE_HARD : -1;
+    if (grade >= 0) {
+        word_grades_open(WORD_POOL_SCRAMBLE, (const char* const*)scramble_words, SCRAMBLE_WORD_COUNT);
+    }
     
     while (1) {
-        play_single_scramble(&game);
+        play_single_scramble(&game, daily, grade);
+        daily = 0;
         
         if (game.attempts <= game.max_attempts && 
             check_guess(game.player_guess, game.original_word)) {
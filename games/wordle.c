@@ -0,0 +1,280 @@
+/*
+ * Wordle - Five-Letter Word Guessing
+ * Part of CLI Games Pack v2.1
+ *
+ * Six tries to find a hidden five-letter word. Each guess is marked
+ * letter by letter: [A] right letter in the right spot, (A) in the word
+ * but elsewhere, and a lowercase letter for one the word lacks. Hard mode
+ * makes every revealed hint binding on later guesses. Typing ? asks the
+ * solver for the guesses that narrow the field the most.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "screen.h"
+#include "wordle_solver.h"
+
+#define HINT_COUNT 5
+
+typedef enum { WORDLE_NORMAL, WORDLE_HARD, WORDLE_WATCH } WordleMode;
+
+typedef struct {
+    WordleMode mode;
+    int answer;
+    WordleTurn turns[WORDLE_MAX_TURNS];
+    int turn_count;
+    uint16_t candidates[WORDLE_WORD_COUNT];
+    int candidate_count;
+    int letter_state[26];               // Best mark seen per letter, -1 if unused
+    char status[160];
+    char hints[HINT_COUNT * 24 + 64];
+} WordleGame;
+
+static WordleGame game;
+
+static void wordle_start(WordleMode mode) {
+    memset(&game, 0, sizeof(game));
+    game.mode = mode;
+    game.answer = rand() % WORDLE_WORD_COUNT;
+    for (int i = 0; i < WORDLE_WORD_COUNT; i++) game.candidates[i] = (uint16_t)i;
+    game.candidate_count = WORDLE_WORD_COUNT;
+    for (int letter = 0; letter < 26; letter++) game.letter_state[letter] = -1;
+}
+
+static void wordle_apply(const uint8_t* matrix, int guess) {
+    int code = matrix[(size_t)guess * WORDLE_WORD_COUNT + game.answer];
+    game.turns[game.turn_count].guess = guess;
+    game.turns[game.turn_count].code = code;
+    game.turn_count++;
+    game.candidate_count = wordle_filter(matrix, game.candidates, game.candidate_count, guess, code);
+    for (int i = 0; i < WORDLE_LENGTH; i++) {
+        int letter = wordle_words[guess][i] - 'A';
+        int mark = wordle_code_digit(code, i);
+        if (mark > game.letter_state[letter]) game.letter_state[letter] = mark;
+    }
+    game.hints[0] = '\0';
+}
+
+static void wordle_cell(char letter, int mark) {
+    if (mark == WORDLE_GREEN) {
+        screen_printf("[%c]", letter);
+    } else if (mark == WORDLE_YELLOW) {
+        screen_printf("(%c)", letter);
+    } else {
+        screen_printf(" %c ", tolower((unsigned char)letter));
+    }
+}
+
+static void wordle_draw(void) {
+    static const char* const keyboard[3] = {"QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"};
+    static const char* const titles[3] = {"WORDLE", "WORDLE - HARD MODE", "WORDLE - SOLVER AT WORK"};
+
+    screen_begin();
+    screen_printf("\n=== %s ===\n\n", titles[game.mode]);
+    screen_printf("   +-----------------+\n");
+    for (int row = 0; row < WORDLE_MAX_TURNS; row++) {
+        screen_printf("   | ");
+        for (int i = 0; i < WORDLE_LENGTH; i++) {
+            if (row < game.turn_count) {
+                wordle_cell(wordle_words[game.turns[row].guess][i], wordle_code_digit(game.turns[row].code, i));
+            } else {
+                screen_printf(" _ ");
+            }
+        }
+        screen_printf(" |\n");
+    }
+    screen_printf("   +-----------------+\n\n");
+
+    for (int row = 0; row < 3; row++) {
+        screen_printf("%*s", 2 + row * 2, "");
+        for (const char* key = keyboard[row]; *key; key++) {
+            int mark = game.letter_state[*key - 'A'];
+            if (mark < 0) {
+                screen_printf(" %c ", *key);
+            } else {
+                wordle_cell(*key, mark);
+            }
+        }
+        screen_printf("\n");
+    }
+    screen_printf("\n[A] right spot  (A) wrong spot  a not in the word\n");
+    screen_printf("\n%s\n", game.hints);
+    screen_printf("%s\n", game.status);
+}
+
+static void wordle_hint(const uint8_t* matrix) {
+    WordleSuggestion best[HINT_COUNT];
+    WordleHardRules rules;
+    int length;
+
+    if (game.mode == WORDLE_HARD) wordle_hard_rules(&rules, game.turns, game.turn_count);
+    int shown = wordle_suggest(matrix, game.candidates, game.candidate_count,
+                               game.mode == WORDLE_HARD ? &rules : NULL, best, HINT_COUNT);
+
+    length = snprintf(game.hints, sizeof(game.hints), "%d word%s possible. Best:", game.candidate_count,
+                      game.candidate_count == 1 ? "" : "s");
+    for (int i = 0; i < shown && length < (int)sizeof(game.hints); i++) {
+        length += snprintf(game.hints + length, sizeof(game.hints) - (size_t)length, " %s %.2f%s",
+                           wordle_words[best[i].word], best[i].bits, best[i].candidate ? "*" : "");
+    }
+    if (length < (int)sizeof(game.hints)) {
+        snprintf(game.hints + length, sizeof(game.hints) - (size_t)length, "\n(bits of information, * could be the answer)");
+    }
+}
+
+// Reads one guess; returns its index, -1 to keep asking, -2 to quit
+static int wordle_read_guess(const uint8_t* matrix) {
+    char line[64];
+    char word[WORDLE_LENGTH + 1];
+    int length = 0;
+
+    screen_printf("Guess %d/%d (? for hints, Q to quit): ", game.turn_count + 1, WORDLE_MAX_TURNS);
+    screen_present();
+    if (!fgets(line, sizeof(line), stdin)) return -2;
+    if (!strchr(line, '\n')) clear_input_buffer();
+
+    for (char* c = line; *c && *c != '\n'; c++) {
+        if (isspace((unsigned char)*c)) continue;
+        if (length == WORDLE_LENGTH) {
+            length++;
+            break;
+        }
+        word[length++] = (char)toupper((unsigned char)*c);
+    }
+    word[length < WORDLE_LENGTH ? length : WORDLE_LENGTH] = '\0';
+
+    if (length == 1 && word[0] == 'Q') return -2;
+    if (length == 1 && word[0] == '?') {
+        wordle_hint(matrix);
+        game.status[0] = '\0';
+        return -1;
+    }
+    if (length != WORDLE_LENGTH) {
+        snprintf(game.status, sizeof(game.status), "Guesses are five letters long.");
+        return -1;
+    }
+    int guess = wordle_find(word);
+    if (guess < 0) {
+        snprintf(game.status, sizeof(game.status), "%s is not in the word list.", word);
+        return -1;
+    }
+    if (game.mode == WORDLE_HARD) {
+        WordleHardRules rules;
+        char reason[64];
+        wordle_hard_rules(&rules, game.turns, game.turn_count);
+        if (!wordle_hard_allows(&rules, word, reason, sizeof(reason))) {
+            snprintf(game.status, sizeof(game.status), "Hard mode: %s.", reason);
+            return -1;
+        }
+    }
+    game.status[0] = '\0';
+    return guess;
+}
+
+static void wordle_finish(void) {
+    int won = game.turn_count > 0 && game.turns[game.turn_count - 1].code == WORDLE_ALL_GREEN;
+
+    if (won) {
+        snprintf(game.status, sizeof(game.status), "%s in %d/%d!", game.mode == WORDLE_WATCH ? "Solved" : "You got it",
+                 game.turn_count, WORDLE_MAX_TURNS);
+    } else {
+        snprintf(game.status, sizeof(game.status), "Out of guesses. The word was %s.", wordle_words[game.answer]);
+    }
+    wordle_draw();
+    screen_printf("Press Enter to continue...");
+    screen_present();
+    clear_input_buffer();
+}
+
+static void wordle_play(const uint8_t* matrix, WordleMode mode) {
+    wordle_start(mode);
+    screen_invalidate();
+
+    while (game.turn_count < WORDLE_MAX_TURNS &&
+           (game.turn_count == 0 || game.turns[game.turn_count - 1].code != WORDLE_ALL_GREEN)) {
+        wordle_draw();
+        int guess = wordle_read_guess(matrix);
+        if (guess == -2) {
+            printf("The word was %s.\n", wordle_words[game.answer]);
+            return;
+        }
+        if (guess >= 0) wordle_apply(matrix, guess);
+    }
+    wordle_finish();
+}
+
+static void wordle_watch(const uint8_t* matrix) {
+    WordleSuggestion best;
+
+    wordle_start(WORDLE_WATCH);
+    screen_invalidate();
+
+    while (game.turn_count < WORDLE_MAX_TURNS &&
+           (game.turn_count == 0 || game.turns[game.turn_count - 1].code != WORDLE_ALL_GREEN)) {
+        wordle_suggest(matrix, game.candidates, game.candidate_count, NULL, &best, 1);
+        snprintf(game.status, sizeof(game.status), "%d word%s possible. Next guess: %s (%.2f bits expected)",
+                 game.candidate_count, game.candidate_count == 1 ? "" : "s", wordle_words[best.word], best.bits);
+        wordle_draw();
+        screen_printf("Press Enter to play it, Q to stop: ");
+        screen_present();
+
+        char line[16];
+        if (!fgets(line, sizeof(line), stdin) || toupper((unsigned char)line[0]) == 'Q') return;
+        if (!strchr(line, '\n')) clear_input_buffer();
+        wordle_apply(matrix, best.word);
+    }
+    wordle_finish();
+}
+
+static void wordle_instructions(void) {
+    printf("\n=== HOW TO PLAY WORDLE ===\n\n");
+    printf("Find the hidden five-letter word in six guesses.\n");
+    printf("Every guess must be a word from the list. After each guess:\n");
+    printf("  [A]  A is in the word, in that spot\n");
+    printf("  (A)  A is in the word, but in another spot\n");
+    printf("   a   A is not in the word (or not that many times)\n\n");
+    printf("Hard mode: green letters must stay in place and yellow letters\n");
+    printf("must be reused in every later guess.\n\n");
+    printf("Type ? during a game for the solver's best guesses. Each shows\n");
+    printf("how many bits of information it is expected to reveal: every\n");
+    printf("bit halves the number of words still possible on average.\n");
+    printf("\nPress Enter to return...");
+    clear_input_buffer();
+}
+
+void play_wordle(void) {
+    char line[16];
+
+    printf("\nPreparing the word tables...\n");
+    const uint8_t* matrix = wordle_matrix_open(0);
+
+    while (1) {
+        printf("\n=== WORDLE ===\n");
+        printf("%d words. ", WORDLE_WORD_COUNT);
+        switch (wordle_matrix_source()) {
+            case WORDLE_MATRIX_MAPPED: printf("Feedback table loaded from the shared cache.\n"); break;
+            case WORDLE_MATRIX_BUILT: printf("Feedback table built and cached.\n"); break;
+            default: printf("Feedback table built in memory.\n"); break;
+        }
+        printf("\n1. Play\n");
+        printf("2. Play (hard mode)\n");
+        printf("3. Watch the solver\n");
+        printf("4. How to play\n");
+        printf("5. Back to main menu\n");
+        printf("\nChoice: ");
+
+        if (!fgets(line, sizeof(line), stdin)) return;
+        if (!strchr(line, '\n')) clear_input_buffer();
+        switch (atoi(line)) {
+            case 1: wordle_play(matrix, WORDLE_NORMAL); break;
+            case 2: wordle_play(matrix, WORDLE_HARD); break;
+            case 3: wordle_watch(matrix); break;
+            case 4: wordle_instructions(); break;
+            case 5: return;
+            default: printf("Invalid choice!\n"); break;
+        }
+    }
+}
@@ -0,0 +1,560 @@
+/*
+ * Wordle Feedback Matrix and Solver
+ * Part of CLI Games Pack v2.1
+ *
+ * Layout of wordle_feedback.mat: a 16-byte header (magic, word count and a
+ * hash of the word list, so a changed list is never read with a stale
+ * table) followed by the matrix, one row of answer codes per guess. The
+ * file is written to a per-process temp name and renamed into place, so
+ * two players building at once never see each other's partial table.
+ *
+ * Suggesting: for each guess, its row is gathered over the surviving
+ * candidate indices into four interleaved histograms (consecutive
+ * increments land in different tables, so they do not wait on each
+ * other), which are then summed bin by bin into the entropy. Counts only
+ * ever reach the candidate total, so c*log2(c) comes from a table.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "highscores.h"
+#include "wordle_solver.h"
+#include <math.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <errno.h>
+#endif
+
+#define MATRIX_MAGIC 0x31544D57u        // "WMT1"
+#define MATRIX_FILE "wordle_feedback.mat"
+#define MATRIX_CELLS ((size_t)WORDLE_WORD_COUNT * WORDLE_WORD_COUNT)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t words;
+    uint32_t list_hash;
+    uint32_t reserved;
+} MatrixHeader;
+
+typedef struct {
+    uint8_t* matrix;
+    int first_row, end_row;
+} BuildJob;
+
+const char wordle_words[WORDLE_WORD_COUNT][WORDLE_LENGTH + 1] = {
+    "ABBEY", "ABOUT", "ABOVE", "ABUSE", "ACORN", "ACTOR", "ACUTE", "ADMIT", "ADOPT", "ADORE",
+    "ADULT", "AFTER", "AGAIN", "AGENT", "AGILE", "AGREE", "AHEAD", "AISLE", "ALARM", "ALBUM",
+    "ALERT", "ALGAE", "ALIEN", "ALIKE", "ALIVE", "ALLEY", "ALLOW", "ALOFT", "ALONE", "ALONG",
+    "ALTER", "AMBER", "AMBLE", "AMONG", "AMPLE", "ANGEL", "ANGER", "ANGLE", "ANGRY", "ANKLE",
+    "ANNEX", "APART", "APPLE", "APPLY", "APRON", "ARBOR", "ARDOR", "ARENA", "ARGUE", "ARISE",
+    "ARMOR", "AROMA", "ARRAY", "ARROW", "ASHEN", "ASIDE", "ASPEN", "ASSET", "ATLAS", "ATTIC",
+    "AUDIO", "AUDIT", "AVERT", "AVOID", "AWARD", "AWARE", "AWFUL", "AXIOM", "AZURE", "BACON",
+    "BADGE", "BADLY", "BAGEL", "BAGGY", "BAKER", "BALMY", "BANJO", "BARGE", "BARON", "BASES",
+    "BASIC", "BASIL", "BASIS", "BASTE", "BATCH", "BATHE", "BATON", "BEACH", "BEADY", "BEARD",
+    "BEAST", "BEEFY", "BEGAN", "BEGIN", "BEGUN", "BEIGE", "BEING", "BELLY", "BELOW", "BENCH",
+    "BENTO", "BERET", "BERRY", "BIBLE", "BICEP", "BINGO", "BIRCH", "BIRTH", "BISON", "BLACK",
+    "BLADE", "BLAME", "BLAND", "BLANK", "BLARE", "BLAST", "BLAZE", "BLEAK", "BLEAT", "BLESS",
+    "BLIMP", "BLIND", "BLINK", "BLISS", "BLOAT", "BLOCK", "BLOKE", "BLOND", "BLOOD", "BLOOM",
+    "BLOWN", "BLUFF", "BLUNT", "BLURB", "BLURT", "BLUSH", "BOARD", "BOAST", "BONUS", "BOOST",
+    "BOOTH", "BORAX", "BOSOM", "BOSSY", "BOTCH", "BOUND", "BOWEL", "BOXER", "BRACE", "BRAID",
+    "BRAIN", "BRAKE", "BRAND", "BRASH", "BRASS", "BRAVE", "BRAVO", "BRAWL", "BRAWN", "BREAD",
+    "BREAK", "BREED", "BRIAR", "BRIBE", "BRICK", "BRIDE", "BRIEF", "BRINE", "BRING", "BRINK",
+    "BRISK", "BROAD", "BROIL", "BROKE", "BROOD", "BROOK", "BROOM", "BROTH", "BROWN", "BRUNT",
+    "BRUSH", "BRUTE", "BUDDY", "BUDGE", "BUGGY", "BUGLE", "BUILD", "BUILT", "BULGE", "BULKY",
+    "BULLY", "BUNCH", "BUNNY", "BURLY", "BURNT", "BURST", "BUSHY", "BUYER", "CABIN", "CABLE",
+    "CACAO", "CADET", "CAMEL", "CAMEO", "CANAL", "CANDY", "CANOE", "CAPER", "CARGO", "CAROL",
+    "CARRY", "CARVE", "CASTE", "CATCH", "CATER", "CAUSE", "CEDAR", "CHAIN", "CHAIR", "CHALK",
+    "CHAMP", "CHANT", "CHAOS", "CHARM", "CHART", "CHASE", "CHASM", "CHEAP", "CHECK", "CHEEK",
+    "CHEER", "CHESS", "CHEST", "CHICK", "CHIDE", "CHIEF", "CHILD", "CHILI", "CHILL", "CHIME",
+    "CHIRP", "CHOIR", "CHOKE", "CHORD", "CHORE", "CHOSE", "CHUNK", "CHURN", "CIDER", "CIGAR",
+    "CINCH", "CIRCA", "CIVIC", "CIVIL", "CLAIM", "CLAMP", "CLANG", "CLANK", "CLASH", "CLASP",
+    "CLASS", "CLAWS", "CLEAN", "CLEAR", "CLEFT", "CLERK", "CLICK", "CLIFF", "CLIMB", "CLING",
+    "CLOAK", "CLOCK", "CLONE", "CLOSE", "CLOTH", "CLOUD", "CLOUT", "CLOVE", "CLOWN", "CLUCK",
+    "CLUMP", "CLUNG", "COACH", "COAST", "CORAL", "COUCH", "COUGH", "COULD", "COUNT", "COURT",
+    "COVER", "CRAFT", "CRANE", "CRANK", "CRASH", "CRATE", "CRAVE", "CRAWL", "CRAZE", "CRAZY",
+    "CREAK", "CREAM", "CREEK", "CREEP", "CREPE", "CREST", "CRIME", "CRISP", "CROAK", "CROOK",
+    "CROSS", "CROWD", "CROWN", "CRUMB", "CRUSH", "CRUST", "CRYPT", "CUBIC", "CURLY", "CURRY",
+    "CURVE", "CUSHY", "CYCLE", "CYNIC", "DAILY", "DAISY", "DANCE", "DANDY", "DATED", "DEALT",
+    "DEATH", "DEBUT", "DECAL", "DECAY", "DECOY", "DECRY", "DEITY", "DELAY", "DELTA", "DELVE",
+    "DEMON", "DENIM", "DENSE", "DEPOT", "DEPTH", "DERBY", "DETER", "DETOX", "DEVIL", "DIARY",
+    "DIGIT", "DINER", "DINGY", "DIRTY", "DISCO", "DITCH", "DITTO", "DIVER", "DIZZY", "DODGE",
+    "DOGMA", "DOING", "DOLLY", "DONOR", "DONUT", "DOUBT", "DOUGH", "DOWDY", "DOWEL", "DOZEN",
+    "DRAFT", "DRAIN", "DRAKE", "DRAMA", "DRAPE", "DRAWL", "DRAWN", "DREAD", "DREAM", "DRESS",
+    "DRIED", "DRIER", "DRIFT", "DRILL", "DRINK", "DRIVE", "DROLL", "DRONE", "DROOL", "DROOP",
+    "DROSS", "DROVE", "DROWN", "DRUID", "DRYER", "DULLY", "DUMMY", "DUNCE", "DUSKY", "DUSTY",
+    "DWARF", "DWELL", "DYING", "EAGER", "EAGLE", "EARLY", "EARTH", "EASEL", "EATEN", "EBONY",
+    "EDICT", "EERIE", "EIGHT", "EJECT", "ELBOW", "ELDER", "ELECT", "ELEGY", "ELITE", "ELOPE",
+    "ELUDE", "EMAIL", "EMBED", "EMBER", "EMCEE", "EMPTY", "ENDOW", "ENEMY", "ENJOY", "ENTER",
+    "ENTRY", "ENVOY", "EPOCH", "EQUAL", "EQUIP", "ERASE", "ERODE", "ERROR", "ERUPT", "ESSAY",
+    "ETHER", "ETHIC", "EVADE", "EVENT", "EVERY", "EVOKE", "EXACT", "EXALT", "EXCEL", "EXERT",
+    "EXILE", "EXIST", "EXPEL", "EXTOL", "EXTRA", "FABLE", "FACET", "FAIRY", "FAITH", "FALSE",
+    "FANCY", "FARCE", "FAULT", "FAUNA", "FEAST", "FEIGN", "FELLA", "FELON", "FEMUR", "FENCE",
+    "FERAL", "FERRY", "FETCH", "FEVER", "FEWER", "FIBER", "FIELD", "FIEND", "FIERY", "FIFTH",
+    "FIFTY", "FIGHT", "FINAL", "FINCH", "FIRST", "FIXED", "FLAIL", "FLAIR", "FLAKE", "FLAME",
+    "FLANK", "FLARE", "FLASH", "FLASK", "FLEET", "FLING", "FLINT", "FLIRT", "FLOAT", "FLOCK",
+    "FLOOD", "FLOOR", "FLORA", "FLOUR", "FLOUT", "FLOWN", "FLUFF", "FLUID", "FLUKE", "FLUNG",
+    "FLUSH", "FLUTE", "FOAMY", "FOCAL", "FOCUS", "FOGGY", "FOLLY", "FORAY", "FORCE", "FORGE",
+    "FORGO", "FORTE", "FORTH", "FORTY", "FORUM", "FOUND", "FOYER", "FRAIL", "FRAME", "FRANK",
+    "FRAUD", "FREAK", "FRESH", "FRILL", "FRISK", "FROCK", "FROND", "FRONT", "FROST", "FROTH",
+    "FROWN", "FROZE", "FRUIT", "FUDGE", "FULLY", "FUNGI", "FUNKY", "FUNNY", "FURRY", "FUSSY",
+    "FUZZY", "GAILY", "GAMER", "GAMUT", "GAUGE", "GAUNT", "GAUZE", "GAVEL", "GAWKY", "GEESE",
+    "GENIE", "GENRE", "GHOST", "GHOUL", "GIANT", "GIDDY", "GIRTH", "GIVEN", "GLAND", "GLARE",
+    "GLASS", "GLEAM", "GLEAN", "GLIDE", "GLINT", "GLOAT", "GLOBE", "GLOOM", "GLORY", "GLOSS",
+    "GLOVE", "GLYPH", "GNASH", "GNOME", "GODLY", "GOING", "GOLEM", "GOOSE", "GORGE", "GOUGE",
+    "GOURD", "GOWNS", "GRACE", "GRADE", "GRAIL", "GRAIN", "GRAND", "GRANT", "GRAPE", "GRAPH",
+    "GRASP", "GRASS", "GRATE", "GRAVE", "GRAVY", "GRAZE", "GREAT", "GREED", "GREEN", "GREET",
+    "GRIEF", "GRILL", "GRIME", "GRIMY", "GRIND", "GRIPE", "GROAN", "GROIN", "GROOM", "GROPE",
+    "GROSS", "GROUP", "GROUT", "GROWL", "GROWN", "GRUEL", "GRUFF", "GRUNT", "GUARD", "GUAVA",
+    "GUESS", "GUEST", "GUIDE", "GUILD", "GUILE", "GUILT", "GUISE", "GULCH", "GULLY", "GUMBO",
+    "GUMMY", "GUPPY", "GUSTO", "GUSTY", "HABIT", "HAIRY", "HALVE", "HANDY", "HAPPY", "HAREM",
+    "HARSH", "HASTE", "HASTY", "HATCH", "HAUNT", "HAVEN", "HAVOC", "HAZEL", "HEADY", "HEART",
+    "HEAVY", "HEIST", "HELIX", "HELLO", "HENCE", "HERON", "HINGE", "HIPPO", "HITCH", "HOARD",
+    "HOBBY", "HOIST", "HOLLY", "HOMER", "HONEY", "HONOR", "HORDE", "HORSE", "HOTEL", "HOUND",
+    "HOUSE", "HOVER", "HOWDY", "HUMAN", "HUMID", "HUMOR", "HUMPH", "HUNCH", "HUNKY", "HURRY",
+    "HUSKY", "HYENA", "ICILY", "ICING", "IDEAL", "IDIOM", "IDIOT", "IDYLL", "IGLOO", "IMAGE",
+    "IMPLY", "INANE", "INBOX", "INCUR", "INDEX", "INEPT", "INERT", "INFER", "INGOT", "INLAY",
+    "INLET", "INNER", "INPUT", "IONIC", "IRATE", "IRONY", "ISLET", "ISSUE", "ITCHY", "IVORY",
+    "JAUNT", "JAZZY", "JELLY", "JERKY", "JETTY", "JEWEL", "JIFFY", "JOINT", "JOLLY", "JOUST",
+    "JUDGE", "JUICE", "JUICY", "JUMBO", "JUMPY", "JUROR", "KAYAK", "KEBAB", "KHAKI", "KIOSK",
+    "KITTY", "KNACK", "KNEAD", "KNEEL", "KNELT", "KNIFE", "KNOCK", "KNOLL", "KNOWN", "KOALA",
+    "KRILL", "LABEL", "LANCE", "LANKY", "LAPEL", "LAPSE", "LARGE", "LARVA", "LASER", "LASSO",
+    "LATCH", "LATER", "LATHE", "LATTE", "LAUGH", "LAYER", "LEAFY", "LEAKY", "LEAPT", "LEARN",
+    "LEASE", "LEAST", "LEAVE", "LEDGE", "LEECH", "LEGAL", "LEGGY", "LEMON", "LEMUR", "LEVEL",
+    "LIBEL", "LIGHT", "LILAC", "LIMBO", "LIMIT", "LINEN", "LINER", "LINGO", "LINKS", "LIPID",
+    "LIVER", "LIVES", "LLAMA", "LOBBY", "LOCAL", "LODGE", "LOFTY", "LOGIC", "LOOPY", "LOOSE",
+    "LORRY", "LOUSY", "LOVER", "LOWER", "LOWLY", "LOYAL", "LUCID", "LUCKY", "LUMEN", "LUMPY",
+    "LUNAR", "LUNCH", "LUNGE", "LURCH", "LURID", "LUSTY", "LYING", "LYRIC", "MACAW", "MACHO",
+    "MADAM", "MAFIA", "MAGIC", "MAJOR", "MAKER", "MAMBO", "MANGO", "MANGY", "MANIA", "MANIC",
+    "MANOR", "MAPLE", "MARCH", "MARSH", "MASON", "MATCH", "MATEY", "MAUVE", "MAXIM", "MAYBE",
+    "MAYOR", "MEALY", "MEANT", "MEATY", "MEDAL", "MEDIA", "MEDIC", "MELEE", "MELON", "MERCY",
+    "MERGE", "MERIT", "MERRY", "MESSY", "METAL", "METRO", "MIDST", "MIGHT", "MIMIC", "MINCE",
+    "MINER", "MINOR", "MINTY", "MINUS", "MIRTH", "MISER", "MIXED", "MOCHA", "MODEL", "MODEM",
+    "MOGUL", "MOIST", "MOLAR", "MOLDY", "MONEY", "MONKS", "MONTH", "MOOSE", "MORAL", "MORPH",
+    "MOSSY", "MOTEL", "MOTIF", "MOTOR", "MOTTO", "MOULT", "MOUND", "MOUNT", "MOURN", "MOUSE",
+    "MOUSY", "MOUTH", "MOVER", "MOVIE", "MOWER", "MUCKY", "MUDDY", "MULCH", "MUMMY", "MUNCH",
+    "MURAL", "MURKY", "MUSHY", "MUSIC", "MUSTY", "NAIVE", "NANNY", "NASAL", "NASTY", "NATAL",
+    "NAVAL", "NAVEL", "NEEDS", "NEEDY", "NERDY", "NERVE", "NEVER", "NEWER", "NEWLY", "NICER",
+    "NICHE", "NIECE", "NIGHT", "NINJA", "NINTH", "NOBLE", "NOISE", "NOMAD", "NOOSE", "NORTH",
+    "NOTCH", "NOTED", "NOVEL", "NUDGE", "NURSE", "NUTTY", "NYLON", "NYMPH", "OAKEN", "OASIS",
+    "OCCUR", "OCEAN", "OCTET", "ODDER", "OFFAL", "OFFER", "OFTEN", "OLIVE", "OMEGA", "ONION",
+    "ONSET", "OPERA", "OPIUM", "OPTIC", "ORBIT", "ORDER", "ORGAN", "OTHER", "OTTER", "OUGHT",
+    "OUTDO", "OUTER", "OVARY", "OVERT", "OWNER", "OXIDE", "OZONE", "PADDY", "PAGAN", "PAINT",
+    "PANEL", "PANSY", "PAPAL", "PAPER", "PARKA", "PARRY", "PARTY", "PASTA", "PASTE", "PATCH",
+    "PATIO", "PATTY", "PAUSE", "PAYEE", "PEACE", "PEACH", "PEARL", "PECAN", "PEDAL", "PENAL",
+    "PENCE", "PENNY", "PERCH", "PERIL", "PERKY", "PESKY", "PETAL", "PETTY", "PHASE", "PHONE",
+    "PHONY", "PHOTO", "PIANO", "PICKY", "PIECE", "PIETY", "PIGGY", "PILOT", "PINCH", "PINEY",
+    "PINKY", "PIOUS", "PIPER", "PIQUE", "PITCH", "PIXEL", "PIXIE", "PIZZA", "PLACE", "PLAID",
+    "PLAIN", "PLANE", "PLANK", "PLANT", "PLATE", "PLAZA", "PLEAD", "PLEAT", "PLUCK", "PLUMB",
+    "PLUME", "PLUMP", "PLUNK", "PLUSH", "POACH", "POINT", "POKER", "POLAR", "POLKA", "POPPY",
+    "PORCH", "POSER", "POSSE", "POUCH", "POULT", "POUND", "POUTY", "POWER", "PRANK", "PRAWN",
+    "PREEN", "PRESS", "PRICE", "PRICK", "PRIDE", "PRIME", "PRIMO", "PRINT", "PRIOR", "PRISM",
+    "PRIVY", "PRIZE", "PROBE", "PRONE", "PRONG", "PROOF", "PROSE", "PROUD", "PROVE", "PROWL",
+    "PROXY", "PRUDE", "PRUNE", "PSALM", "PUDGY", "PUFFY", "PULPY", "PULSE", "PUNCH", "PUPIL",
+    "PUPPY", "PUREE", "PURGE", "PURSE", "PUSHY", "PUTTY", "QUACK", "QUAIL", "QUAKE", "QUALM",
+    "QUART", "QUASH", "QUASI", "QUEEN", "QUERY", "QUEST", "QUEUE", "QUICK", "QUIET", "QUILL",
+    "QUILT", "QUIRK", "QUITE", "QUOTA", "QUOTE", "RABBI", "RABID", "RACER", "RADAR", "RADII",
+    "RADIO", "RAINY", "RAISE", "RALLY", "RAMEN", "RANCH", "RANGE", "RAPID", "RARER", "RASPY",
+    "RATIO", "RAVEN", "RAYON", "RAZOR", "REACH", "READY", "REALM", "REBAR", "REBEL", "REBUS",
+    "RECAP", "RECUR", "REEDY", "REFER", "REGAL", "REHAB", "REIGN", "RELAX", "RELAY", "RELIC",
+    "REMIT", "RENAL", "RENEW", "REPAY", "REPEL", "REPLY", "RERUN", "RESET", "RESIN", "RETCH",
+    "RETRO", "RETRY", "REUSE", "REVEL", "RHINO", "RHYME", "RIDER", "RIDGE", "RIFLE", "RIGHT",
+    "RIGID", "RIGOR", "RINSE", "RIPEN", "RIPER", "RISEN", "RISER", "RISKY", "RIVAL", "RIVER",
+    "RIVET", "ROACH", "ROAST", "ROBIN", "ROBOT", "ROCKY", "RODEO", "ROGUE", "ROOMY", "ROOST",
+    "ROTOR", "ROUGE", "ROUGH", "ROUND", "ROUTE", "ROWDY", "ROWER", "ROYAL", "RUDDY", "RUDER",
+    "RUGBY", "RULER", "RUMBA", "RUMOR", "RUPEE", "RURAL", "RUSTY", "SADLY", "SAINT", "SALAD",
+    "SALON", "SALSA", "SALTY", "SALVE", "SALVO", "SANDY", "SANER", "SAPPY", "SASSY", "SATIN",
+    "SATYR", "SAUCE", "SAUCY", "SAUNA", "SAUTE", "SAVOR", "SAVVY", "SCALD", "SCALE", "SCALP",
+    "SCALY", "SCAMP", "SCANT", "SCARE", "SCARF", "SCARY", "SCENE", "SCOFF", "SCOLD", "SCONE",
+    "SCOOP", "SCOPE", "SCORE", "SCORN", "SCOUR", "SCOUT", "SCOWL", "SCRAM", "SCRAP", "SCRUB",
+    "SCRUM", "SEDAN", "SEEDY", "SEGUE", "SEIZE", "SENSE", "SEPIA", "SERUM", "SERVE", "SETUP",
+    "SEVEN", "SEVER", "SEWER", "SHACK", "SHADE", "SHADY", "SHAFT", "SHAKE", "SHAKY", "SHALL",
+    "SHAME", "SHANK", "SHAPE", "SHARD", "SHARE", "SHARP", "SHAVE", "SHAWL", "SHEAR", "SHEEN",
+    "SHEEP", "SHEER", "SHEET", "SHELF", "SHELL", "SHIED", "SHIFT", "SHINE", "SHINY", "SHIRE",
+    "SHIRK", "SHIRT", "SHOAL", "SHOCK", "SHONE", "SHOOK", "SHOOT", "SHORT", "SHOUT", "SHOVE",
+    "SHOWN", "SHOWY", "SHREW", "SHRUB", "SHRUG", "SHUCK", "SHUNT", "SHUSH", "SHYLY", "SIEGE",
+    "SIEVE", "SIGHT", "SIGMA", "SILKY", "SILLY", "SINCE", "SINGE", "SIREN", "SIXTH", "SIXTY",
+    "SIZED", "SKATE", "SKIER", "SKIFF", "SKILL", "SKIMP", "SKIRT", "SKULK", "SKULL", "SKUNK",
+    "SLACK", "SLAIN", "SLANG", "SLANT", "SLASH", "SLATE", "SLAVE", "SLEEK", "SLEEP", "SLEET",
+    "SLEPT", "SLICE", "SLICK", "SLIDE", "SLIME", "SLIMY", "SLING", "SLINK", "SLOOP", "SLOPE",
+    "SLOSH", "SLOTH", "SLUMP", "SLUNG", "SLUNK", "SLURP", "SLUSH", "SLYLY", "SMACK", "SMALL",
+    "SMART", "SMASH", "SMEAR", "SMELL", "SMELT", "SMILE", "SMIRK", "SMITE", "SMOCK", "SMOKE",
+    "SMOKY", "SNACK", "SNAIL", "SNAKE", "SNAKY", "SNARE", "SNARL", "SNEAK", "SNEER", "SNIDE",
+    "SNIFF", "SNIPE", "SNOOP", "SNORE", "SNORT", "SNOUT", "SNOWY", "SNUCK", "SNUFF", "SOAPY",
+    "SOBER", "SOGGY", "SOLAR", "SOLID", "SOLVE", "SONAR", "SONIC", "SOOTY", "SORRY", "SOUND",
+    "SOUPY", "SOUTH", "SPACE", "SPADE", "SPANK", "SPARE", "SPASM", "SPAWN", "SPEAK", "SPEAR",
+    "SPECK", "SPEED", "SPELL", "SPEND", "SPENT", "SPICE", "SPICY", "SPIED", "SPIEL", "SPIKE",
+    "SPIKY", "SPILL", "SPINE", "SPINY", "SPIRE", "SPITE", "SPLAT", "SPLIT", "SPOIL", "SPOKE",
+    "SPOOF", "SPOOK", "SPOOL", "SPOON", "SPORE", "SPORT", "SPOUT", "SPRAY", "SPREE", "SPRIG",
+    "SPUNK", "SPURN", "SPURT", "SQUAD", "SQUAT", "SQUIB", "STACK", "STAFF", "STAGE", "STAID",
+    "STAIN", "STAIR", "STAKE", "STALE", "STALK", "STALL", "STAMP", "STAND", "STANK", "STARE",
+    "STARK", "START", "STASH", "STATE", "STAVE", "STEAD", "STEAK", "STEAL", "STEAM", "STEED",
+    "STEEL", "STEEP", "STEER", "STERN", "STICK", "STIFF", "STILL", "STING", "STINK", "STINT",
+    "STOCK", "STOIC", "STOKE", "STOLE", "STOMP", "STONE", "STONY", "STOOD", "STOOL", "STOOP",
+    "STORE", "STORK", "STORM", "STORY", "STOUT", "STOVE", "STRAP", "STRAW", "STRAY", "STRIP",
+    "STRUT", "STUCK", "STUDY", "STUFF", "STUMP", "STUNG", "STUNK", "STUNT", "STYLE", "SUAVE",
+    "SUGAR", "SUITE", "SULKY", "SULLY", "SUMAC", "SUNNY", "SUPER", "SURER", "SURGE", "SURLY",
+    "SUSHI", "SWAMI", "SWAMP", "SWARM", "SWASH", "SWATH", "SWEAR", "SWEAT", "SWEEP", "SWEET",
+    "SWELL", "SWEPT", "SWIFT", "SWILL", "SWINE", "SWING", "SWIRL", "SWISH", "SWOON", "SWOOP",
+    "SWORD", "SWORE", "SWORN", "SWUNG", "SYNOD", "SYRUP", "TABBY", "TABLE", "TABOO", "TACIT",
+    "TACKY", "TAFFY", "TAINT", "TAKEN", "TALLY", "TALON", "TAMER", "TANGO", "TANGY", "TAPER",
+    "TAPIR", "TARDY", "TAROT", "TASTE", "TASTY", "TATTY", "TAUNT", "TAWNY", "TAXES", "TEACH",
+    "TEARY", "TEASE", "TEETH", "TEMPO", "TENET", "TENOR", "TENSE", "TENTH", "TEPID", "THANK",
+    "THEFT", "THEIR", "THEME", "THERE", "THESE", "THICK", "THIEF", "THIGH", "THING", "THINK",
+    "THIRD", "THONG", "THORN", "THOSE", "THREE", "THREW", "THROW", "THUMB", "THUMP", "THYME",
+    "TIARA", "TIBIA", "TIDAL", "TIGER", "TIGHT", "TILDE", "TIMER", "TIMES", "TIMID", "TIPSY",
+    "TIRED", "TITAN", "TITLE", "TOAST", "TODAY", "TODDY", "TOKEN", "TONIC", "TOOTH", "TOPAZ",
+    "TOPIC", "TORCH", "TORSO", "TOTAL", "TOTEM", "TOUCH", "TOUGH", "TOWER", "TOXIC", "TRACE",
+    "TRACK", "TRADE", "TRAIL", "TRAIN", "TRAIT", "TRAMP", "TRASH", "TRAWL", "TREAD", "TREAT",
+    "TREND", "TRIAD", "TRIAL", "TRIBE", "TRICE", "TRICK", "TRIED", "TRIES", "TRITE", "TROLL",
+    "TROOP", "TROPE", "TROUT", "TROVE", "TRUCE", "TRUCK", "TRULY", "TRUST", "TRUTH", "TUBER",
+    "TULIP", "TUMMY", "TUNIC", "TURBO", "TUTOR", "TWANG", "TWEAK", "TWEED", "TWEET", "TWICE",
+    "TWINE", "TWIRL", "TWIST", "UDDER", "ULCER", "ULTRA", "UMBRA", "UNCLE", "UNCUT", "UNDER",
+    "UNDID", "UNDUE", "UNFED", "UNFIT", "UNIFY", "UNION", "UNITY", "UNLIT", "UNMET", "UNTIE",
+    "UNTIL", "UNWED", "UNZIP", "UPPER", "UPSET", "URBAN", "USAGE", "USHER", "USUAL", "USURP",
+    "UTTER", "VAGUE", "VALET", "VALID", "VALOR", "VALUE", "VALVE", "VAPOR", "VAULT", "VAUNT",
+    "VEGAN", "VENOM", "VENUE", "VERGE", "VERSE", "VERSO", "VIDEO", "VIGIL", "VIGOR", "VILLA",
+    "VINYL", "VIOLA", "VIPER", "VIRUS", "VISIT", "VISOR", "VISTA", "VITAL", "VIVID", "VIXEN",
+    "VOCAL", "VODKA", "VOGUE", "VOICE", "VOILA", "VOMIT", "VOTER", "VOUCH", "VOWEL", "WACKY",
+    "WAFER", "WAGER", "WAGON", "WAIST", "WALTZ", "WARTY", "WASTE", "WATCH", "WATER", "WAVER",
+    "WAXEN", "WEARY", "WEAVE", "WEDGE", "WEEDY", "WEIGH", "WEIRD", "WENCH", "WHACK", "WHALE",
+    "WHARF", "WHEAT", "WHEEL", "WHELP", "WHERE", "WHICH", "WHIFF", "WHILE", "WHINE", "WHINY",
+    "WHIRL", "WHISK", "WHITE", "WHOLE", "WHOSE", "WIDEN", "WIDOW", "WIDTH", "WIELD", "WIGHT",
+    "WIMPY", "WINCE", "WINCH", "WINDY", "WISER", "WISPY", "WITCH", "WITTY", "WOKEN", "WOMAN",
+    "WOMEN", "WOODY", "WOOER", "WOOLY", "WOOZY", "WORDY", "WORLD", "WORRY", "WORSE", "WORST",
+    "WORTH", "WOULD", "WOUND", "WRACK", "WRATH", "WREAK", "WRECK", "WREST", "WRING", "WRIST",
+    "WRITE", "WRONG", "WROTE", "YACHT", "YEARN", "YEAST", "YIELD", "YODEL", "YOUNG", "YOUTH",
+    "ZEBRA", "ZESTY", "ZONAL",
+};
+
+// Fails to compile when WORDLE_WORD_COUNT and the list disagree
+typedef char wordle_word_count_matches[sizeof(wordle_words) / sizeof(wordle_words[0]) == WORDLE_WORD_COUNT ? 1 : -1];
+
+static const uint8_t* matrix;
+static WordleMatrixSource matrix_source = WORDLE_MATRIX_NONE;
+static void* mapping;
+static size_t mapping_size;
+static uint8_t local_matrix[MATRIX_CELLS];
+static float entropy_terms[WORDLE_WORD_COUNT + 1];     // c * log2(c)
+
+int wordle_feedback(const char* guess, const char* answer) {
+    int spare[26] = {0};
+    int digits[WORDLE_LENGTH];
+
+    // Greens first, so a repeated letter is only yellow while the answer
+    // still has an unmatched copy of it
+    for (int i = 0; i < WORDLE_LENGTH; i++) {
+        if (guess[i] == answer[i]) {
+            digits[i] = WORDLE_GREEN;
+        } else {
+            digits[i] = WORDLE_GRAY;
+            spare[answer[i] - 'A']++;
+        }
+    }
+    int code = 0;
+    for (int i = 0; i < WORDLE_LENGTH; i++) {
+        if (digits[i] == WORDLE_GRAY && spare[guess[i] - 'A'] > 0) {
+            digits[i] = WORDLE_YELLOW;
+            spare[guess[i] - 'A']--;
+        }
+    }
+    for (int i = WORDLE_LENGTH - 1; i >= 0; i--) code = code * 3 + digits[i];
+    return code;
+}
+
+int wordle_find(const char* word) {
+    int low = 0, high = WORDLE_WORD_COUNT - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        int order = strcmp(word, wordle_words[middle]);
+        if (order == 0) return middle;
+        if (order < 0) {
+            high = middle - 1;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return -1;
+}
+
+static uint32_t word_list_hash(void) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < WORDLE_WORD_COUNT; i++) {
+        for (int j = 0; j < WORDLE_LENGTH; j++) {
+            hash = (hash ^ (uint8_t)wordle_words[i][j]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+static int default_threads(void) {
+#ifdef _WIN32
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > WORDLE_MAX_THREADS) cores = WORDLE_MAX_THREADS;
+    return (int)cores;
+#endif
+}
+
+static void* build_worker(void* arg) {
+    BuildJob* job = (BuildJob*)arg;
+    for (int guess = job->first_row; guess < job->end_row; guess++) {
+        uint8_t* row = job->matrix + (size_t)guess * WORDLE_WORD_COUNT;
+        for (int answer = 0; answer < WORDLE_WORD_COUNT; answer++) {
+            row[answer] = (uint8_t)wordle_feedback(wordle_words[guess], wordle_words[answer]);
+        }
+    }
+    return NULL;
+}
+
+void wordle_matrix_build(uint8_t* out, int threads) {
+    BuildJob jobs[WORDLE_MAX_THREADS];
+
+    if (threads <= 0) threads = default_threads();
+    if (threads > WORDLE_MAX_THREADS) threads = WORDLE_MAX_THREADS;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].matrix = out;
+        jobs[t].first_row = WORDLE_WORD_COUNT * t / threads;
+        jobs[t].end_row = WORDLE_WORD_COUNT * (t + 1) / threads;
+    }
+
+#ifndef _WIN32
+    pthread_t handles[WORDLE_MAX_THREADS];
+    int started[WORDLE_MAX_THREADS] = {0};
+    for (int t = 1; t < threads; t++) {
+        started[t] = (pthread_create(&handles[t], NULL, build_worker, &jobs[t]) == 0);
+        if (!started[t]) build_worker(&jobs[t]);
+    }
+    build_worker(&jobs[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(handles[t], NULL);
+    }
+#else
+    for (int t = 0; t < threads; t++) {
+        build_worker(&jobs[t]);
+    }
+#endif
+}
+
+#ifndef _WIN32
+static const uint8_t* map_cached_matrix(const char* path) {
+    MatrixHeader header;
+    struct stat st;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0 || st.st_size != (off_t)(sizeof(header) + MATRIX_CELLS) ||
+        read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        header.magic != MATRIX_MAGIC || header.words != WORDLE_WORD_COUNT ||
+        header.list_hash != word_list_hash()) {
+        close(fd);
+        return NULL;
+    }
+    void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return NULL;
+    mapping = mapped;
+    mapping_size = (size_t)st.st_size;
+    return (const uint8_t*)mapped + sizeof(header);
+}
+
+static int save_matrix(const char* path, int threads) {
+    MatrixHeader header = {MATRIX_MAGIC, WORDLE_WORD_COUNT, word_list_hash(), 0};
+    size_t size = sizeof(header) + MATRIX_CELLS;
+    char temp_path[600];
+
+    if (!highscore_make_shared_dir()) return 0;
+
+    // Built straight into the file's pages: nothing is copied afterwards
+    int fd = highscore_create_temp(path, temp_path, sizeof(temp_path));
+    if (fd < 0) return 0;
+    fchmod(fd, 0644);
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        remove(temp_path);
+        return 0;
+    }
+    wordle_matrix_build((uint8_t*)mapped + sizeof(header), threads);
+    memcpy(mapped, &header, sizeof(header));    // Header last: a torn build never validates
+    int ok = munmap(mapped, size) == 0;
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    return 1;
+}
+#endif
+
+const uint8_t* wordle_matrix_open(int threads) {
+    if (matrix) return matrix;
+
+#ifndef _WIN32
+    char path[512];
+    if (highscore_shared_path(MATRIX_FILE, path, sizeof(path))) {
+        matrix = map_cached_matrix(path);
+        if (matrix) {
+            matrix_source = WORDLE_MATRIX_MAPPED;
+            return matrix;
+        }
+        if (save_matrix(path, threads)) {
+            matrix = map_cached_matrix(path);
+            if (matrix) {
+                matrix_source = WORDLE_MATRIX_BUILT;
+                return matrix;
+            }
+        }
+    }
+#endif
+
+    wordle_matrix_build(local_matrix, threads);
+    matrix = local_matrix;
+    matrix_source = WORDLE_MATRIX_LOCAL;
+    return matrix;
+}
+
+WordleMatrixSource wordle_matrix_source(void) {
+    return matrix_source;
+}
+
+void wordle_matrix_close(void) {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_size);
+#endif
+    mapping = NULL;
+    mapping_size = 0;
+    matrix = NULL;
+    matrix_source = WORDLE_MATRIX_NONE;
+}
+
+int wordle_filter(const uint8_t* table, uint16_t* candidates, int count, int guess, int code) {
+    const uint8_t* row = table + (size_t)guess * WORDLE_WORD_COUNT;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        uint16_t answer = candidates[i];
+        candidates[kept] = answer;
+        kept += row[answer] == code;
+    }
+    return kept;
+}
+
+void wordle_hard_rules(WordleHardRules* rules, const WordleTurn* turns, int turn_count) {
+    memset(rules, 0, sizeof(*rules));
+    for (int t = 0; t < turn_count; t++) {
+        const char* word = wordle_words[turns[t].guess];
+        uint8_t revealed[26] = {0};
+        for (int i = 0; i < WORDLE_LENGTH; i++) {
+            int digit = wordle_code_digit(turns[t].code, i);
+            if (digit == WORDLE_GREEN) rules->fixed[i] = word[i];
+            if (digit != WORDLE_GRAY) revealed[word[i] - 'A']++;
+        }
+        for (int letter = 0; letter < 26; letter++) {
+            if (revealed[letter] > rules->min_count[letter]) rules->min_count[letter] = revealed[letter];
+        }
+    }
+}
+
+int wordle_hard_allows(const WordleHardRules* rules, const char* word, char* reason, size_t reason_size) {
+    static const char* const ordinals[WORDLE_LENGTH] = {"1st", "2nd", "3rd", "4th", "5th"};
+    uint8_t counts[26] = {0};
+
+    for (int i = 0; i < WORDLE_LENGTH; i++) {
+        if (rules->fixed[i] && word[i] != rules->fixed[i]) {
+            if (reason) snprintf(reason, reason_size, "%s letter must be %c", ordinals[i], rules->fixed[i]);
+            return 0;
+        }
+        counts[word[i] - 'A']++;
+    }
+    for (int letter = 0; letter < 26; letter++) {
+        if (counts[letter] < rules->min_count[letter]) {
+            if (reason) {
+                if (rules->min_count[letter] > 1) {
+                    snprintf(reason, reason_size, "Guess must contain %d %c's", rules->min_count[letter], 'A' + letter);
+                } else {
+                    snprintf(reason, reason_size, "Guess must contain %c", 'A' + letter);
+                }
+            }
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Expected information of one guess: log2(n) - sum(c * log2(c)) / n
+static double guess_bits(const uint8_t* row, const uint16_t* candidates, int count) {
+    uint16_t histogram[4][WORDLE_CODES];
+    int i = 0;
+
+    memset(histogram, 0, sizeof(histogram));
+    for (; i + 4 <= count; i += 4) {
+        histogram[0][row[candidates[i]]]++;
+        histogram[1][row[candidates[i + 1]]]++;
+        histogram[2][row[candidates[i + 2]]]++;
+        histogram[3][row[candidates[i + 3]]]++;
+    }
+    for (; i < count; i++) histogram[0][row[candidates[i]]]++;
+
+    float sum = 0;
+    for (int code = 0; code < WORDLE_CODES; code++) {
+        sum += entropy_terms[histogram[0][code] + histogram[1][code] + histogram[2][code] + histogram[3][code]];
+    }
+    return log2((double)count) - sum / count;
+}
+
+static int ranks_above(const WordleSuggestion* a, const WordleSuggestion* b) {
+    if (a->bits > b->bits + 1e-6) return 1;
+    if (a->bits < b->bits - 1e-6) return 0;
+    if (a->candidate != b->candidate) return a->candidate;   // Might win outright
+    return a->word < b->word;
+}
+
+int wordle_suggest(const uint8_t* table, const uint16_t* candidates, int count,
+                   const WordleHardRules* hard, WordleSuggestion* out, int max_out) {
+    static uint8_t is_candidate[WORDLE_WORD_COUNT];
+    int found = 0;
+
+    if (count <= 0 || max_out <= 0) return 0;
+    if (entropy_terms[2] == 0) {
+        for (int c = 2; c <= WORDLE_WORD_COUNT; c++) entropy_terms[c] = (float)(c * log2((double)c));
+    }
+
+    // With one or two left, guessing a candidate is never worse
+    if (count <= 2) {
+        for (int i = 0; i < count && found < max_out; i++) {
+            WordleSuggestion pick = {candidates[i], count == 2 ? 1.0 : 0.0, 1};
+            out[found++] = pick;
+        }
+        return found;
+    }
+
+    memset(is_candidate, 0, sizeof(is_candidate));
+    for (int i = 0; i < count; i++) is_candidate[candidates[i]] = 1;
+
+    for (int guess = 0; guess < WORDLE_WORD_COUNT; guess++) {
+        if (hard && !wordle_hard_allows(hard, wordle_words[guess], NULL, 0)) continue;
+
+        WordleSuggestion scored;
+        scored.word = guess;
+        scored.candidate = is_candidate[guess];
+        scored.bits = guess_bits(table + (size_t)guess * WORDLE_WORD_COUNT, candidates, count);
+
+        // Insertion into the short best-first list
+        int slot = found < max_out ? found++ : max_out;
+        while (slot > 0 && ranks_above(&scored, &out[slot - 1])) {
+            if (slot < max_out) out[slot] = out[slot - 1];
+            slot--;
+        }
+        if (slot < max_out) out[slot] = scored;
+    }
+    return found;
+}
@@ -0,0 +1,93 @@
+#ifndef WORDLE_SOLVER_H
+#define WORDLE_SOLVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Five-letter word feedback and an information-maximising guess solver.
+ *
+ * The feedback for a guess against an answer is five digits, one per
+ * letter (0 gray, 1 yellow, 2 green), packed base 3 with the first letter
+ * in the lowest digit: 243 codes, so one fits in a byte. The feedback of
+ * every guess against every answer is precomputed once into a matrix of
+ * WORDLE_WORD_COUNT rows (guesses) by WORDLE_WORD_COUNT columns (answers).
+ * The matrix is built by several threads and cached in the shared
+ * directory, where later runs map it read-only instead of rebuilding it.
+ *
+ * With the matrix, scoring a guess is a histogram of its row over the
+ * answers still possible, and the expected information of the guess is
+ * the entropy of that histogram. A suggestion scores every word that way.
+ */
+
+#define WORDLE_LENGTH 5
+#define WORDLE_CODES 243                // 3^5 feedback patterns
+#define WORDLE_ALL_GREEN 242
+#define WORDLE_WORD_COUNT 1813
+#define WORDLE_MAX_TURNS 6
+#define WORDLE_MAX_THREADS 16
+
+#define WORDLE_GRAY 0
+#define WORDLE_YELLOW 1
+#define WORDLE_GREEN 2
+
+typedef enum {
+    WORDLE_MATRIX_NONE,
+    WORDLE_MATRIX_MAPPED,               // Loaded from the shared cache
+    WORDLE_MATRIX_BUILT,                // Built now and saved to the cache
+    WORDLE_MATRIX_LOCAL                 // Built now; the cache could not be written
+} WordleMatrixSource;
+
+typedef struct {
+    int guess;                          // Word index
+    int code;                           // Feedback it received
+} WordleTurn;
+
+// What earlier feedback forces every later guess to use in hard mode
+typedef struct {
+    char fixed[WORDLE_LENGTH];          // Green letters, 0 where still open
+    uint8_t min_count[26];              // Revealed letters and how many of each
+} WordleHardRules;
+
+typedef struct {
+    int word;
+    double bits;                        // Expected information in bits
+    int candidate;                      // Could still be the answer
+} WordleSuggestion;
+
+// Sorted, uppercase, NUL-terminated
+extern const char wordle_words[WORDLE_WORD_COUNT][WORDLE_LENGTH + 1];
+
+int wordle_feedback(const char* guess, const char* answer);
+
+static inline int wordle_code_digit(int code, int position) {
+    while (position-- > 0) code /= 3;
+    return code % 3;
+}
+
+// Index of an uppercase word in the list, or -1
+int wordle_find(const char* word);
+
+// Fills a caller-owned WORDLE_WORD_COUNT^2 matrix using up to threads workers
+void wordle_matrix_build(uint8_t* matrix, int threads);
+
+// Maps the cached matrix, building and caching it first when it is missing
+// or stale; threads <= 0 uses every online core. Never returns NULL.
+const uint8_t* wordle_matrix_open(int threads);
+WordleMatrixSource wordle_matrix_source(void);
+void wordle_matrix_close(void);
+
+// Keeps the candidates whose feedback for guess is code; returns the new count
+int wordle_filter(const uint8_t* matrix, uint16_t* candidates, int count, int guess, int code);
+
+void wordle_hard_rules(WordleHardRules* rules, const WordleTurn* turns, int turn_count);
+
+// Returns 1 when word obeys the rules; otherwise describes why in reason
+int wordle_hard_allows(const WordleHardRules* rules, const char* word, char* reason, size_t reason_size);
+
+// Scores every allowed guess against the candidates and writes the best
+// ones, most informative first, to out; returns how many were written
+int wordle_suggest(const uint8_t* matrix, const uint16_t* candidates, int count,
+                   const WordleHardRules* hard, WordleSuggestion* out, int max_out);
+
+#endif // WORDLE_SOLVER_H
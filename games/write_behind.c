@@ -0,0 +1,729 @@
+/*
+ * Write-Behind Persistence
+ * Part of CLI Games Pack v2.1
+ *
+ * A batch is everything taken from the queue in one go. It is grouped
+ * into files by path and kind, and the writer opens each one (replaces
+ * open a temp file). The ring then runs in rounds, each holding as many
+ * file chains as fit in the submission queue. A file too long for one
+ * round continues in the next, without its fdatasync until the last. A
+ * round is submitted and reaped in full before the next one starts,
+ * which keeps the appends to a file in order.
+ *
+ * Whatever the ring did not finish (an error, a short write, a cancelled
+ * link, or no ring at all) is then written in order with pwrite and
+ * synced by the writer thread. A file the ring had trouble with gets
+ * nothing more from the ring in that batch, so nothing overtakes the
+ * part still missing.
+ *
+ * A file's save time is observed here, from the start of its batch until
+ * it is synced (and renamed, for a replace), not when the game queued it.
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "highscores.h"
+#include "metrics.h"
+#include "terminal.h"
+#include "write_behind.h"
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <sys/syscall.h>
+        #include <linux/io_uring.h>
+        #ifdef __NR_io_uring_setup
+            #define HAVE_IO_URING 1
+        #endif
+    #endif
+#endif
+
+#define WRITE_BEHIND_PATH 512
+#define RING_ENTRIES 64
+
+typedef enum {
+    KIND_REPLACE,
+    KIND_APPEND
+} WriteKind;
+
+#ifndef _WIN32
+
+typedef struct WriteItem {
+    struct WriteItem* next;
+    WriteKind kind;
+    int slot;                           // Staging slot, or -1 for a malloc'd copy
+    int file;                           // Index of its file in the batch
+    uint8_t* data;
+    size_t length;
+    size_t written;
+    char path[WRITE_BEHIND_PATH];
+} WriteItem;
+
+typedef struct {
+    WriteKind kind;
+    const char* path;
+    char temp_path[WRITE_BEHIND_PATH + 32];
+    int fd;
+    WriteItem** items;
+    int count, capacity;
+    int cursor;                         // Items handed to the ring so far
+    int ring_done;                      // Every item and the fdatasync are queued
+    int ring_failed;                    // The rest is left to pwrite
+    int ring_synced;
+} WriteFile;
+
+typedef enum {
+    BACKEND_NONE,                       // Not started
+    BACKEND_RING,
+    BACKEND_THREAD,
+    BACKEND_SYNC
+} Backend;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t idle = PTHREAD_COND_INITIALIZER;
+static pthread_t writer;
+static Backend backend = BACKEND_NONE;
+static WriteItem* queue_head;
+static WriteItem* queue_tail;
+static int batch_running, stopping, flush_waiters;
+static uint8_t* arena;
+static int free_slots[WRITE_BEHIND_SLOTS];
+static int free_count;
+static WriteBehindStats totals;
+static int atfork_installed;
+
+#ifdef HAVE_IO_URING
+
+typedef struct {
+    int fd;
+    unsigned entries;
+    unsigned tail;                      // Ours; published to sq_tail on submit
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_ring;
+    void* cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+    int registered;                     // The arena is registered as buffer 0
+} Ring;
+
+static Ring ring = {.fd = -1};
+static int ring_broken;
+
+static void ring_close(void) {
+    if (ring.fd < 0) return;
+    if (ring.sqes) munmap(ring.sqes, ring.sqes_size);
+    if (ring.cq_ring && ring.cq_ring != ring.sq_ring) munmap(ring.cq_ring, ring.cq_ring_size);
+    if (ring.sq_ring) munmap(ring.sq_ring, ring.sq_ring_size);
+    close(ring.fd);
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = -1;
+}
+
+static int ring_open(void) {
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = (int)syscall(__NR_io_uring_setup, RING_ENTRIES, &params);
+    if (ring.fd < 0) return 0;
+
+    ring.entries = params.sq_entries;
+    ring.sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring.cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    int single_mmap = 0;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap && ring.cq_ring_size > ring.sq_ring_size) ring.sq_ring_size = ring.cq_ring_size;
+
+    ring.sq_ring = mmap(NULL, ring.sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd,
+                        IORING_OFF_SQ_RING);
+    if (ring.sq_ring == MAP_FAILED) ring.sq_ring = NULL;
+    ring.cq_ring = single_mmap ? ring.sq_ring :
+                   mmap(NULL, ring.cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd,
+                        IORING_OFF_CQ_RING);
+    if (ring.cq_ring == MAP_FAILED) ring.cq_ring = NULL;
+    ring.sqes = mmap(NULL, ring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd,
+                     IORING_OFF_SQES);
+    if (ring.sqes == MAP_FAILED) ring.sqes = NULL;
+    if (!ring.sq_ring || !ring.cq_ring || !ring.sqes) {
+        ring_close();
+        return 0;
+    }
+
+    uint8_t* sq = ring.sq_ring;
+    uint8_t* cq = ring.cq_ring;
+    ring.sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring.sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring.sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring.sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring.cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring.cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring.cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring.cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    ring.tail = *ring.sq_tail;
+
+    // Pinned memory counts against RLIMIT_MEMLOCK; plain writes work without it
+    struct iovec buffer = {arena, WRITE_BEHIND_SLOTS * WRITE_BEHIND_SLOT_BYTES};
+    ring.registered = arena && syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS, &buffer, 1) == 0;
+    return 1;
+}
+
+static struct io_uring_sqe* ring_next_sqe(void) {
+    unsigned index = ring.tail & *ring.sq_mask;
+    struct io_uring_sqe* sqe = &ring.sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring.sq_array[index] = index;
+    ring.tail++;
+    return sqe;
+}
+
+static void ring_complete(const struct io_uring_cqe* cqe, WriteFile* files, WriteBehindStats* delta) {
+    if (cqe->user_data & 1) {
+        WriteFile* file = &files[cqe->user_data >> 1];
+        if (cqe->res == 0) {
+            file->ring_synced = 1;
+            delta->syncs++;
+        }
+        return;
+    }
+
+    WriteItem* item = (WriteItem*)(uintptr_t)cqe->user_data;
+    if (cqe->res > 0) item->written = (size_t)cqe->res;
+    if (cqe->res >= 0 && (size_t)cqe->res == item->length) {
+        delta->ring_writes++;
+        if (item->slot >= 0 && ring.registered) delta->fixed_writes++;
+    } else {
+        files[item->file].ring_failed = 1;
+    }
+}
+
+// Submits the queued entries and reaps exactly as many completions
+static int ring_run(unsigned count, WriteFile* files, WriteBehindStats* delta) {
+    unsigned to_submit = count, reaped = 0;
+
+    __atomic_store_n(ring.sq_tail, ring.tail, __ATOMIC_RELEASE);
+    while (reaped < count) {
+        long entered = syscall(__NR_io_uring_enter, ring.fd, to_submit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (entered < 0 && errno != EINTR) return 0;
+        if (entered > 0) to_submit -= (unsigned)entered < to_submit ? (unsigned)entered : to_submit;
+
+        unsigned head = *ring.cq_head;
+        unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            ring_complete(&ring.cqes[head & *ring.cq_mask], files, delta);
+            head++;
+            reaped++;
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+    return 1;
+}
+
+static void ring_write_files(WriteFile* files, int file_count, WriteBehindStats* delta) {
+    for (;;) {
+        unsigned queued = 0;
+        for (int f = 0; f < file_count; f++) {
+            WriteFile* file = &files[f];
+            if (file->fd < 0 || file->ring_done || file->ring_failed) continue;
+            unsigned room = ring.entries - queued;
+            if (room < 2) break;
+
+            int take = file->count - file->cursor;
+            int finish = 1;
+            if ((unsigned)take + 1 > room) {
+                take = (int)room;
+                finish = 0;
+            }
+            for (int k = 0; k < take; k++) {
+                WriteItem* item = file->items[file->cursor + k];
+                struct io_uring_sqe* sqe = ring_next_sqe();
+                if (item->slot >= 0 && ring.registered) {
+                    sqe->opcode = IORING_OP_WRITE_FIXED;
+                    sqe->buf_index = 0;
+                } else {
+                    sqe->opcode = IORING_OP_WRITE;
+                }
+                sqe->fd = file->fd;
+                sqe->addr = (uint64_t)(uintptr_t)item->data;
+                sqe->len = (uint32_t)item->length;
+                sqe->off = 0;           // Replaces have one item; appends use O_APPEND
+                sqe->user_data = (uint64_t)(uintptr_t)item;
+                if (k < take - 1 || finish) sqe->flags = IOSQE_IO_LINK;
+            }
+            file->cursor += take;
+            queued += (unsigned)take;
+            if (finish) {
+                struct io_uring_sqe* sqe = ring_next_sqe();
+                sqe->opcode = IORING_OP_FSYNC;
+                sqe->fd = file->fd;
+                sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+                sqe->user_data = (uint64_t)f << 1 | 1;
+                file->ring_done = 1;
+                queued++;
+            }
+        }
+        if (queued == 0) return;
+        if (!ring_run(queued, files, delta)) {
+            // The ring is broken: pwrite finishes this batch and the writer goes on without it
+            for (int f = 0; f < file_count; f++) files[f].ring_failed = 1;
+            ring_close();
+            ring_broken = 1;
+            return;
+        }
+    }
+}
+
+#endif // HAVE_IO_URING
+
+static WriteFile* file_for(WriteFile** files, int* count, int* capacity, const WriteItem* item) {
+    for (int f = 0; f < *count; f++) {
+        if ((*files)[f].kind == item->kind && strcmp((*files)[f].path, item->path) == 0) return &(*files)[f];
+    }
+    if (*count == *capacity) {
+        int grown_capacity = *capacity ? *capacity * 2 : 8;
+        WriteFile* grown = realloc(*files, (size_t)grown_capacity * sizeof(WriteFile));
+        if (!grown) return NULL;
+        *files = grown;
+        *capacity = grown_capacity;
+    }
+    WriteFile* file = &(*files)[(*count)++];
+    memset(file, 0, sizeof(*file));
+    file->kind = item->kind;
+    file->path = item->path;
+    file->fd = -1;
+    return file;
+}
+
+static int add_item(WriteFile* file, WriteItem* item) {
+    if (file->count == file->capacity) {
+        int grown_capacity = file->capacity ? file->capacity * 2 : 4;
+        WriteItem** grown = realloc(file->items, (size_t)grown_capacity * sizeof(WriteItem*));
+        if (!grown) return 0;
+        file->items = grown;
+        file->capacity = grown_capacity;
+    }
+    file->items[file->count++] = item;
+    return 1;
+}
+
+static int write_rest(const WriteFile* file, WriteItem* item) {
+    while (item->written < item->length) {
+        const uint8_t* from = item->data + item->written;
+        size_t left = item->length - item->written;
+        ssize_t wrote = file->kind == KIND_REPLACE ? pwrite(file->fd, from, left, (off_t)item->written) :
+                                                     write(file->fd, from, left);
+        if (wrote < 0 && errno == EINTR) continue;
+        if (wrote <= 0) return 0;
+        item->written += (size_t)wrote;
+    }
+    return 1;
+}
+
+static void sync_directory(const char* path, WriteBehindStats* delta) {
+    char dir[WRITE_BEHIND_PATH];
+    const char* slash = strrchr(path, '/');
+    if (!slash) {
+        snprintf(dir, sizeof(dir), ".");
+    } else {
+        snprintf(dir, sizeof(dir), "%.*s", (int)(slash - path) > 0 ? (int)(slash - path) : 1, path);
+    }
+    int fd = open(dir, O_RDONLY);
+    if (fd < 0) return;
+    if (fsync(fd) == 0) delta->syncs++;
+    close(fd);
+}
+
+static int same_directory(const char* a, const char* b) {
+    const char* slash_a = strrchr(a, '/');
+    const char* slash_b = strrchr(b, '/');
+    size_t length_a = slash_a ? (size_t)(slash_a - a) : 0;
+    size_t length_b = slash_b ? (size_t)(slash_b - b) : 0;
+    return length_a == length_b && strncmp(a, b, length_a) == 0;
+}
+
+static void process_batch(WriteItem* batch, WriteBehindStats* delta) {
+    WriteFile* files = NULL;
+    int file_count = 0, capacity = 0;
+    uint64_t start = terminal_now_us();
+
+    for (WriteItem* item = batch; item; item = item->next) {
+        WriteFile* file = file_for(&files, &file_count, &capacity, item);
+        item->file = file ? (int)(file - files) : -1;
+        if (!file) {
+            delta->failures++;
+        } else if (item->kind == KIND_REPLACE && file->count > 0) {
+            file->items[0] = item;      // Only the newest contents get written
+            delta->coalesced++;
+        } else if (!add_item(file, item)) {
+            delta->failures++;
+        }
+    }
+
+    for (int f = 0; f < file_count; f++) {
+        WriteFile* file = &files[f];
+        if (file->kind == KIND_REPLACE) {
+            file->fd = highscore_create_temp(file->path, file->temp_path, sizeof(file->temp_path));
+        } else {
+            file->fd = open(file->path, O_WRONLY | O_CREAT | O_APPEND | O_NOFOLLOW | O_CLOEXEC, 0644);
+        }
+    }
+
+#ifdef HAVE_IO_URING
+    if (backend == BACKEND_RING) ring_write_files(files, file_count, delta);
+#endif
+
+    for (int f = 0; f < file_count; f++) {
+        WriteFile* file = &files[f];
+        int ok = file->fd >= 0, wrote = 0;
+        for (int i = 0; ok && i < file->count; i++) {
+            if (file->items[i]->written < file->items[i]->length) {
+                ok = write_rest(file, file->items[i]);
+                wrote = 1;
+                delta->direct_writes++;
+            }
+        }
+        if (ok && (wrote || !file->ring_synced)) {
+            ok = fsync(file->fd) == 0;
+            delta->syncs++;
+        }
+        if (file->fd >= 0) ok = close(file->fd) == 0 && ok;
+        for (int i = 0; ok && i < file->count; i++) delta->bytes += file->items[i]->length;
+
+        if (file->kind == KIND_REPLACE) {
+            if (ok && rename(file->temp_path, file->path) == 0) {
+                // One directory sync per directory, after its last rename
+                int last = 1;
+                for (int g = f + 1; g < file_count && last; g++) {
+                    last = !(files[g].kind == KIND_REPLACE && same_directory(files[g].path, file->path));
+                }
+                if (last) sync_directory(file->path, delta);
+            } else {
+                if (file->fd >= 0) remove(file->temp_path);
+                ok = 0;
+            }
+        }
+        if (ok) {
+            metrics_observe(METRICS_STATS_WRITE_US, terminal_now_us() - start);
+        } else {
+            delta->failures++;
+        }
+        free(file->items);
+    }
+    free(files);
+}
+
+static void add_stats(const WriteBehindStats* delta) {
+    totals.coalesced += delta->coalesced;
+    totals.ring_writes += delta->ring_writes;
+    totals.fixed_writes += delta->fixed_writes;
+    totals.direct_writes += delta->direct_writes;
+    totals.syncs += delta->syncs;
+    totals.failures += delta->failures;
+    totals.bytes += delta->bytes;
+    totals.batches++;
+}
+
+// Frees the items and returns how many staging slots they held, in slots
+static int free_items(WriteItem* items, int* slots) {
+    int count = 0;
+    while (items) {
+        WriteItem* next = items->next;
+        if (items->slot >= 0) {
+            slots[count++] = items->slot;
+        } else {
+            free(items->data);
+        }
+        free(items);
+        items = next;
+    }
+    return count;
+}
+
+static void* writer_main(void* unused) {
+    (void)unused;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!queue_head && !stopping) pthread_cond_wait(&wake, &lock);
+        if (!queue_head) break;         // Stopping, and nothing left
+
+        // Writes landing within the window share the batch and its syncs
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += WRITE_BEHIND_GATHER_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!stopping && flush_waiters == 0 && pthread_cond_timedwait(&wake, &lock, &deadline) != ETIMEDOUT) {
+        }
+
+        WriteItem* batch = queue_head;
+        queue_head = queue_tail = NULL;
+        batch_running = 1;
+        pthread_mutex_unlock(&lock);
+
+        WriteBehindStats delta;
+        int slots[WRITE_BEHIND_SLOTS];
+        memset(&delta, 0, sizeof(delta));
+        process_batch(batch, &delta);
+        int slot_count = free_items(batch, slots);
+
+        pthread_mutex_lock(&lock);
+        add_stats(&delta);
+        while (slot_count > 0) free_slots[free_count++] = slots[--slot_count];
+#ifdef HAVE_IO_URING
+        if (ring_broken) backend = BACKEND_THREAD;
+#endif
+        batch_running = 0;
+        pthread_cond_broadcast(&idle);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+// The writer and the ring stay with the parent; a child starts its own
+static void forget_writer_in_child(void) {
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&wake, NULL);
+    pthread_cond_init(&idle, NULL);
+    queue_head = queue_tail = NULL;
+    batch_running = stopping = flush_waiters = 0;
+    free_count = 0;
+    for (int i = WRITE_BEHIND_SLOTS - 1; arena && i >= 0; i--) free_slots[free_count++] = i;
+#ifdef HAVE_IO_URING
+    ring_close();
+#endif
+    backend = BACKEND_NONE;
+}
+
+// Under the lock
+static void start_writer(void) {
+    const char* mode = getenv("CLI_GAMES_WRITE_BEHIND");
+
+    backend = BACKEND_SYNC;
+    if (mode && strcmp(mode, "sync") == 0) return;
+    if (!atfork_installed) {
+        pthread_atfork(NULL, NULL, forget_writer_in_child);
+        atfork_installed = 1;
+    }
+    if (!arena) {
+        void* mapped = mmap(NULL, WRITE_BEHIND_SLOTS * WRITE_BEHIND_SLOT_BYTES, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped != MAP_FAILED) {
+            arena = mapped;
+            for (int i = WRITE_BEHIND_SLOTS - 1; i >= 0; i--) free_slots[free_count++] = i;
+        }
+    }
+
+    metrics_open();                     // Before the writer thread can race to it
+
+    int use_ring = 0;
+#ifdef HAVE_IO_URING
+    use_ring = !(mode && strcmp(mode, "thread") == 0) && ring_open();
+#endif
+
+    // Signals stay with the game thread, as for the metrics exporter
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    int started = pthread_create(&writer, NULL, writer_main, NULL) == 0;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    if (started) {
+        backend = use_ring ? BACKEND_RING : BACKEND_THREAD;
+        return;
+    }
+#ifdef HAVE_IO_URING
+    ring_close();
+#endif
+}
+
+static int submit(WriteKind kind, const char* path, const WriteBehindPart* parts, int count) {
+    size_t length = 0;
+    for (int i = 0; i < count; i++) length += parts[i].length;
+    if (strlen(path) >= WRITE_BEHIND_PATH) return 0;
+    WriteItem* item = malloc(sizeof(*item));
+    if (!item) return 0;
+    memset(item, 0, offsetof(WriteItem, path));
+    memcpy(item->path, path, strlen(path) + 1);
+    item->kind = kind;
+    item->length = length;
+
+    pthread_mutex_lock(&lock);
+    if (backend == BACKEND_NONE) start_writer();
+    Backend mode = backend;
+    item->slot = mode != BACKEND_SYNC && length <= WRITE_BEHIND_SLOT_BYTES && free_count > 0 ?
+                 free_slots[--free_count] : -1;
+    totals.submitted++;
+    pthread_mutex_unlock(&lock);
+
+    item->data = item->slot >= 0 ? arena + (size_t)item->slot * WRITE_BEHIND_SLOT_BYTES : malloc(length ? length : 1);
+    if (!item->data) {
+        free(item);
+        return 0;
+    }
+    size_t offset = 0;
+    for (int i = 0; i < count; i++) {
+        if (parts[i].length) memcpy(item->data + offset, parts[i].data, parts[i].length);
+        offset += parts[i].length;
+    }
+
+    if (mode == BACKEND_SYNC) {
+        WriteBehindStats delta;
+        memset(&delta, 0, sizeof(delta));
+        process_batch(item, &delta);
+        free(item->data);               // Never a slot without the writer
+        free(item);
+        pthread_mutex_lock(&lock);
+        add_stats(&delta);
+        pthread_mutex_unlock(&lock);
+        return delta.failures == 0;
+    }
+
+    pthread_mutex_lock(&lock);
+    if (queue_tail) {
+        queue_tail->next = item;
+    } else {
+        queue_head = item;
+    }
+    queue_tail = item;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    return 1;
+}
+
+int write_behind_replacev(const char* path, const WriteBehindPart* parts, int count) {
+    return submit(KIND_REPLACE, path, parts, count);
+}
+
+int write_behind_appendv(const char* path, const WriteBehindPart* parts, int count) {
+    return submit(KIND_APPEND, path, parts, count);
+}
+
+void write_behind_flush(void) {
+    pthread_mutex_lock(&lock);
+    flush_waiters++;
+    pthread_cond_signal(&wake);
+    while (queue_head || batch_running) pthread_cond_wait(&idle, &lock);
+    flush_waiters--;
+    pthread_mutex_unlock(&lock);
+}
+
+void write_behind_shutdown(void) {
+    pthread_mutex_lock(&lock);
+    if (backend == BACKEND_RING || backend == BACKEND_THREAD) {
+        stopping = 1;
+        pthread_cond_signal(&wake);
+        pthread_mutex_unlock(&lock);
+        pthread_join(writer, NULL);     // It leaves once the queue is empty
+        pthread_mutex_lock(&lock);
+        stopping = 0;
+#ifdef HAVE_IO_URING
+        ring_close();
+#endif
+    }
+    backend = BACKEND_NONE;
+    pthread_mutex_unlock(&lock);
+}
+
+const char* write_behind_backend(void) {
+    pthread_mutex_lock(&lock);
+    if (backend == BACKEND_NONE) start_writer();
+    Backend mode = backend;
+    pthread_mutex_unlock(&lock);
+    return mode == BACKEND_RING ? "io_uring" : mode == BACKEND_THREAD ? "thread" : "sync";
+}
+
+void write_behind_stats(WriteBehindStats* stats) {
+    pthread_mutex_lock(&lock);
+    *stats = totals;
+    pthread_mutex_unlock(&lock);
+}
+
+#else
+
+static WriteBehindStats totals;
+
+static int write_parts(const char* path, const char* mode, const WriteBehindPart* parts, int count) {
+    FILE* file = fopen(path, mode);
+    if (!file) return 0;
+    int ok = 1;
+    for (int i = 0; ok && i < count; i++) {
+        ok = fwrite(parts[i].data, 1, parts[i].length, file) == parts[i].length;
+        totals.bytes += parts[i].length;
+    }
+    ok = fclose(file) == 0 && ok;
+    totals.direct_writes++;
+    if (!ok) totals.failures++;
+    return ok;
+}
+
+int write_behind_replacev(const char* path, const WriteBehindPart* parts, int count) {
+    char temp_path[WRITE_BEHIND_PATH + 32];
+    uint64_t start = terminal_now_us();
+
+    totals.submitted++;
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    if (!write_parts(temp_path, "wb", parts, count)) {
+        remove(temp_path);
+        return 0;
+    }
+    remove(path);
+    if (rename(temp_path, path) != 0) return 0;
+    metrics_observe(METRICS_STATS_WRITE_US, terminal_now_us() - start);
+    return 1;
+}
+
+int write_behind_appendv(const char* path, const WriteBehindPart* parts, int count) {
+    uint64_t start = terminal_now_us();
+    totals.submitted++;
+    if (!write_parts(path, "ab", parts, count)) return 0;
+    metrics_observe(METRICS_STATS_WRITE_US, terminal_now_us() - start);
+    return 1;
+}
+
+void write_behind_flush(void) {
+}
+
+void write_behind_shutdown(void) {
+}
+
+const char* write_behind_backend(void) {
+    return "sync";
+}
+
+void write_behind_stats(WriteBehindStats* stats) {
+    *stats = totals;
+}
+
+#endif
+
+int write_behind_replace(const char* path, const void* data, size_t length) {
+    WriteBehindPart part = {data, length};
+    return write_behind_replacev(path, &part, 1);
+}
+
+int write_behind_append(const char* path, const void* data, size_t length) {
+    WriteBehindPart part = {data, length};
+    return write_behind_appendv(path, &part, 1);
+}
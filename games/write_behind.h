@@ -0,0 +1,73 @@
+#ifndef WRITE_BEHIND_H
+#define WRITE_BEHIND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Write-behind persistence for stats, logs and recordings.
+ *
+ * The game thread hands over bytes and carries on. They are copied into a
+ * staging slot (a malloc'd buffer when they do not fit) and queued, so
+ * the caller's buffer is free again on return. One writer thread puts
+ * them on disk. A frame never waits on the disk, however slow or remote
+ * the home directory is.
+ *
+ * On Linux the writer drives an io_uring whose staging slots are
+ * registered buffers. Everything queued during a short gather window is
+ * one batch and goes in one submission. Each file gets one linked chain
+ * of writes followed by a single fdatasync, however many writes it got.
+ * Without io_uring (an old kernel, a seccomp filter, another system) the
+ * writer thread does the same with pwrite and fsync. It also finishes
+ * anything the ring cut short.
+ *
+ * A replace goes to a temp file that is renamed over the target once it
+ * is synced, so readers see the old contents or the new. Queued replaces
+ * of one path collapse to the latest. Appends to one path keep their
+ * order and are written with O_APPEND, so whole records from several
+ * players interleave. The directory of each renamed file is synced once
+ * per batch.
+ *
+ * CLI_GAMES_WRITE_BEHIND=thread skips io_uring; =sync writes in the
+ * calling thread, as Windows always does.
+ */
+
+#define WRITE_BEHIND_SLOTS 64
+#define WRITE_BEHIND_SLOT_BYTES 4096
+#define WRITE_BEHIND_GATHER_MS 20       // Writes this close together share a batch
+
+typedef struct {
+    const void* data;
+    size_t length;
+} WriteBehindPart;
+
+typedef struct {
+    uint64_t submitted;                 // Replaces and appends handed over
+    uint64_t coalesced;                 // Replaces dropped for a newer one
+    uint64_t batches;
+    uint64_t ring_writes;               // Completed through io_uring
+    uint64_t fixed_writes;              // ... from a registered buffer
+    uint64_t direct_writes;             // Written by the writer thread itself
+    uint64_t syncs;                     // fdatasync/fsync calls, files and directories
+    uint64_t failures;
+    uint64_t bytes;
+} WriteBehindStats;
+
+// Queue the parts, in order, as the new contents of path or as one
+// record at its end. Returns 0 only when nothing could be queued.
+int write_behind_replacev(const char* path, const WriteBehindPart* parts, int count);
+int write_behind_appendv(const char* path, const WriteBehindPart* parts, int count);
+int write_behind_replace(const char* path, const void* data, size_t length);
+int write_behind_append(const char* path, const void* data, size_t length);
+
+// Blocks until everything queued so far is on disk. For exits, not frames
+void write_behind_flush(void);
+
+// Flushes, then stops the writer; the next write starts it again
+void write_behind_shutdown(void);
+
+// "io_uring", "thread" or "sync": what the next write will use
+const char* write_behind_backend(void);
+void write_behind_stats(WriteBehindStats* stats);
+
+#endif // WRITE_BEHIND_H
@@ -19,6 +19,10 @@
 #include <time.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <stdarg.h>
+#include "daily.h"
+#include "screen.h"
+#include "yahtzee_odds.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -92,11 +96,20 @@ const int category_points[NUM_CATEGORIES] = {
 // Global game instance
 YahtzeeGame game;
 
+// A daily game rolls from today's shared stream instead of rand()
+static bool daily_dice;
+static uint64_t dice_stream;
+
+// Message panel shown under the turn actions until the next command
+static char status_text[2048];
+static size_t status_length;
+
 // Function Declarations
 void yahtzee_init_game(void);
 void yahtzee_display_header(void);
 void yahtzee_display_dice(void);
 void yahtzee_display_scorecard(void);
+void yahtzee_display_odds(void);
 void yahtzee_roll_dice(void);
 void yahtzee_select_dice(void);
 void yahtzee_score_turn(void);
@@ -117,6 +130,12 @@ bool has_of_kind(int count);
 int sum_all_dice(void);
 void yahtzee_analyze_dice_and_suggest(void);
 
+// Turn screen
+void yahtzee_status(const char* format, ...);
+void yahtzee_status_clear(void);
+void yahtzee_present_turn(const char* prompt);
+char yahtzee_read_choice(void);
+
 // Initialize new game
 void yahtzee_init_game(void) {
     // Reset dice
@@ -144,24 +163,24 @@ void yahtzee_init_game(void) {
 
 // Display game header with round info
 void yahtzee_display_header(void) {
-    printf("\n");
-    printf("================================================================================\n");
-    printf("||    Y   Y   AA   H   H  TTTTT  ZZZZ  EEEEE  EEEEE    ||   DICE MASTER   ||\n");
-    printf("||     Y Y   A  A  H   H    T      Z   E      E        ||                 ||\n");
-    printf("||      Y    AAAA  HHHHH    T     Z    EEEE   EEEE     ||  Round %2d / 13   ||\n", game.current_round);
-    printf("||      Y    A  A  H   H    T    Z     E      E        ||  Rolls Left: %d  ||\n", game.rolls_left);
-    printf("||      Y    A  A  H   H    T   ZZZZ  EEEEE  EEEEE    ||  Score: %4d    ||\n", game.scorecard.grand_total);
-    printf("================================================================================\n");
+    screen_printf("\n");
+    screen_printf("================================================================================\n");
+    screen_printf("||    Y   Y   AA   H   H  TTTTT  ZZZZ  EEEEE  EEEEE    ||   DICE MASTER   ||\n");
+    screen_printf("||     Y Y   A  A  H   H    T      Z   E      E        ||                 ||\n");
+    screen_printf("||      Y    AAAA  HHHHH    T     Z    EEEE   EEEE     ||  Round %2d / 13   ||\n", game.current_round);
+    screen_printf("||      Y    A  A  H   H    T    Z     E      E        ||  Rolls Left: %d  ||\n", game.rolls_left);
+    screen_printf("||      Y    A  A  H   H    T   ZZZZ  EEEEE  EEEEE    ||  Score: %4d    ||\n", game.scorecard.grand_total);
+    screen_printf("================================================================================\n");
     
     // Show progress bar
-    printf("Progress: [");
+    screen_printf("Progress: [");
     for (int i = 1; i <= 13; i++) {
-        if (i <= game.current_round - 1) printf("#");
-        else if (i == game.current_round) printf(">");
-        else printf("-");
+        if (i <= game.current_round - 1) screen_printf("#");
+        else if (i == game.current_round) screen_printf(">");
+        else screen_printf("-");
     }
-    printf("] %d%%\n", (game.current_round - 1) * 100 / 13);
-    printf("================================================================================\n");
+    screen_printf("] %d%%\n", (game.current_round - 1) * 100 / 13);
+    screen_printf("================================================================================\n");
 }
 
 // ASCII art for dice faces
@@ -180,54 +199,87 @@ char* yahtzee_dice_art(int value) {
 
 // Display current dice with enhanced visual formatting
 void yahtzee_display_dice(void) {
-    printf("\n+======================== CURRENT DICE ========================+\n");
-    printf("|                                                          |\n");
+    screen_printf("\n+======================== CURRENT DICE ========================+\n");
+    screen_printf("|                                                          |\n");
     
     // Show dice values with ASCII art
-    printf("|   ");
+    screen_printf("|   ");
     for (int i = 0; i < NUM_DICE; i++) {
         if (game.dice.keep[i]) {
-            printf("[%d]KEEP", game.dice.values[i]);
+            screen_printf("[%d]KEEP", game.dice.values[i]);
         } else {
-            printf(" [%d]   ", game.dice.values[i]);
+            screen_printf(" [%d]   ", game.dice.values[i]);
         }
-        if (i < NUM_DICE - 1) printf("  ");
+        if (i < NUM_DICE - 1) screen_printf("  ");
     }
-    printf("   |\n");
+    screen_printf("   |\n");
     
     // Show visual indicators
-    printf("|   ");
+    screen_printf("|   ");
     for (int i = 0; i < NUM_DICE; i++) {
         if (game.dice.keep[i]) {
-            printf(" ^^^^ ");
+            screen_printf(" ^^^^ ");
         } else {
-            printf("  --  ");
+            screen_printf("  --  ");
         }
-        if (i < NUM_DICE - 1) printf("  ");
+        if (i < NUM_DICE - 1) screen_printf("  ");
     }
-    printf("   |\n");
+    screen_printf("   |\n");
     
     // Show dice positions
-    printf("|    1      2      3      4      5                        |\n");
-    printf("|                                                          |\n");
+    screen_printf("|    1      2      3      4      5                        |\n");
+    screen_printf("|                                                          |\n");
     
     // Calculate and show total
     int total = 0;
     for (int i = 0; i < NUM_DICE; i++) {
         total += game.dice.values[i];
     }
-    printf("|  Total Value: %2d    Kept: %d dice    Free: %d dice      |\n", 
+    screen_printf("|  Total Value: %2d    Kept: %d dice    Free: %d dice      |\n", 
            total, 
            game.dice.keep[0] + game.dice.keep[1] + game.dice.keep[2] + game.dice.keep[3] + game.dice.keep[4],
            5 - (game.dice.keep[0] + game.dice.keep[1] + game.dice.keep[2] + game.dice.keep[3] + game.dice.keep[4]));
-    printf("+===========================================================+\n");
+    screen_printf("+===========================================================+\n");
+}
+
+// Live chance of completing each open category by the end of the turn,
+// rolling the dice not kept now and keeping as well as possible after
+void yahtzee_display_odds(void) {
+    double odds[YAHTZEE_ODDS_CATEGORIES];
+    char cells[NUM_CATEGORIES][8];
+    unsigned keep_mask = 0;
+    
+    if (!yahtzee_odds_init()) return;
+    for (int i = 0; i < NUM_DICE; i++) {
+        if (game.dice.keep[i]) keep_mask |= 1u << i;
+    }
+    yahtzee_odds_panel(game.dice.values, keep_mask, game.rolls_left, odds);
+    for (int i = 0; i < NUM_CATEGORIES; i++) {
+        if (game.scorecard.used[i]) {
+            snprintf(cells[i], sizeof(cells[i]), "    --");
+        } else {
+            snprintf(cells[i], sizeof(cells[i]), "%5.1f%%", odds[i] * 100.0);
+        }
+    }
+    
+    screen_printf("\n+============ ODDS BY END OF TURN (keeping these) ============+\n");
+    for (int row = 0; row < 7; row++) {
+        int lower = row + THREE_OF_KIND;
+        if (row < 6) {
+            screen_printf("|  %-12s %s    ", yahtzee_odds_label(row), cells[row]);
+        } else {
+            screen_printf("|%25s", "");
+        }
+        screen_printf("|  %-12s %s              |\n", yahtzee_odds_label(lower), cells[lower]);
+    }
+    screen_printf("+=============================================================+\n");
 }
 
 // Enhanced scorecard display with visual indicators
 void yahtzee_display_scorecard(void) {
-    printf("\n+========================= SCORECARD =========================+\n");
-    printf("| UPPER SECTION                   | LOWER SECTION            |\n");
-    printf("|=================================|==========================|\n");
+    screen_printf("\n+========================= SCORECARD =========================+\n");
+    screen_printf("| UPPER SECTION                   | LOWER SECTION            |\n");
+    screen_printf("|=================================|==========================|\n");
     
     // Calculate upper section progress for bonus
     int upper_progress = 0;
@@ -241,72 +293,145 @@ void yahtzee_display_scorecard(void) {
     for (int i = 0; i < 6; i++) {
         // Upper section with visual indicators
         char status_char = game.scorecard.used[i] ? '*' : ' ';
-        printf("| %c%d. %-11s ", status_char, i + 1, category_names[i]);
+        screen_printf("| %c%d. %-11s ", status_char, i + 1, category_names[i]);
         if (game.scorecard.used[i]) {
-            printf("%3d     |", game.scorecard.scores[i]);
+            screen_printf("%3d     |", game.scorecard.scores[i]);
         } else {
-            printf("---     |");
+            screen_printf("---     |");
         }
         
         // Lower section
         int lower_idx = i + 6;
         if (lower_idx < NUM_CATEGORIES) {
             char lower_status = game.scorecard.used[lower_idx] ? '*' : ' ';
-            printf(" %c%d. %-11s ", lower_status, lower_idx + 1, category_names[lower_idx]);
+            screen_printf(" %c%d. %-11s ", lower_status, lower_idx + 1, category_names[lower_idx]);
             if (game.scorecard.used[lower_idx]) {
-                printf("%3d  |\n", game.scorecard.scores[lower_idx]);
+                screen_printf("%3d  |\n", game.scorecard.scores[lower_idx]);
             } else {
-                printf("---  |\n");
+                screen_printf("---  |\n");
             }
         } else {
-            printf("                          |\n");
+            screen_printf("                          |\n");
         }
     }
     
     // Show 13th category (Chance) separately
-    printf("|                                 |");
+    screen_printf("|                                 |");
     char chance_status = game.scorecard.used[12] ? '*' : ' ';
-    printf(" %c13. %-11s ", chance_status, category_names[12]);
+    screen_printf(" %c13. %-11s ", chance_status, category_names[12]);
     if (game.scorecard.used[12]) {
-        printf("%3d  |\n", game.scorecard.scores[12]);
+        screen_printf("%3d  |\n", game.scorecard.scores[12]);
     } else {
-        printf("---  |\n");
+        screen_printf("---  |\n");
     }
     
-    printf("|=================================|==========================|\n");
+    screen_printf("|=================================|==========================|\n");
     
     // Enhanced totals section with progress indicators
-    printf("| Upper Total:      %3d           | Lower Total:     %3d     |\n", 
+    screen_printf("| Upper Total:      %3d           | Lower Total:     %3d     |\n", 
            game.scorecard.upper_total, game.scorecard.lower_total);
     
     // Upper bonus progress
     if (game.scorecard.upper_bonus > 0) {
-        printf("| Upper Bonus:      %3d  [EARNED] |", game.scorecard.upper_bonus);
+        screen_printf("| Upper Bonus:      %3d  [EARNED] |", game.scorecard.upper_bonus);
     } else {
         int needed = UPPER_BONUS_THRESHOLD - upper_progress;
         if (needed <= 0) {
-            printf("| Upper Bonus:       35  [READY!] |");
+            screen_printf("| Upper Bonus:       35  [READY!] |");
         } else {
-            printf("| Upper Bonus:     (need %2d more) |", needed);
+            screen_printf("| Upper Bonus:     (need %2d more) |", needed);
         }
     }
     
-    printf(" Yahtzee Bonuses: %3d     |\n", game.scorecard.yahtzee_bonuses * YAHTZEE_BONUS);
+    screen_printf(" Yahtzee Bonuses: %3d     |\n", game.scorecard.yahtzee_bonuses * YAHTZEE_BONUS);
     
-    printf("|                                 |                          |\n");
-    printf("|       GRAND TOTAL: %4d         |   [* = completed]        |\n", 
+    screen_printf("|                                 |                          |\n");
+    screen_printf("|       GRAND TOTAL: %4d         |   [* = completed]        |\n", 
            game.scorecard.grand_total);
-    printf("+===========================================================+\n");
+    screen_printf("+===========================================================+\n");
     
     // Show completion progress
     int completed_categories = 0;
     for (int i = 0; i < NUM_CATEGORIES; i++) {
         if (game.scorecard.used[i]) completed_categories++;
     }
-    printf("Categories completed: %d/13 (%.0f%%)\n", 
+    screen_printf("Categories completed: %d/13 (%.0f%%)\n", 
            completed_categories, (completed_categories * 100.0) / 13);
 }
 
+// Append a line or two to the message panel
+void yahtzee_status(const char* format, ...) {
+    va_list args;
+    
+    va_start(args, format);
+    int written = vsnprintf(status_text + status_length, sizeof(status_text) - status_length, format, args);
+    va_end(args);
+    if (written > 0) {
+        status_length += (size_t)written;
+        if (status_length >= sizeof(status_text)) status_length = sizeof(status_text) - 1;
+    }
+}
+
+void yahtzee_status_clear(void) {
+    status_length = 0;
+    status_text[0] = '\0';
+}
+
+// Compose the whole turn screen around the message panel and present it.
+// Between commands usually only the dice, a few scorecard cells and the
+// panel change, and only those reach the terminal.
+void yahtzee_present_turn(const char* prompt) {
+    screen_begin();
+    yahtzee_display_header();
+    yahtzee_display_scorecard();
+    yahtzee_display_dice();
+    
+    if (game.rolls_left > 0) {
+        // Odds need dice on the table; before the first roll there are none
+        if (game.rolls_left < MAX_ROLLS) yahtzee_display_odds();
+        
+        // Show intelligent analysis
+        yahtzee_analyze_dice_and_suggest();
+        
+        screen_printf("\n+============= TURN ACTIONS =============+\n");
+        screen_printf("|                                        |\n");
+        screen_printf("|  [R] Roll dice     [K] Keep/select     |\n");
+        screen_printf("|  [1-5] Keep or release one die         |\n");
+        screen_printf("|  [P] Preview scores [S] Strategy       |\n");
+        screen_printf("|  [H] Help & Rules   [Q] Quit game      |\n");
+        screen_printf("|                                        |\n");
+        screen_printf("+========================================+\n");
+    } else {
+        screen_printf("\n*** SCORING REQUIRED ***\n");
+        screen_printf("No rolls left - you must choose a scoring category!\n");
+        screen_printf("\n+==================== SCORING MENU ====================+\n");
+        screen_printf("|  Choose how to score your dice:                       |\n");
+        screen_printf("|                                                        |\n");
+        screen_printf("|  Commands:                                             |\n");
+        screen_printf("|   1-13  - Select scoring category                      |\n");
+        screen_printf("|   'p'   - Preview all potential scores                |\n");
+        screen_printf("|   'b'   - Show best scoring recommendations            |\n");
+        screen_printf("|   'h'   - Show help and strategy                      |\n");
+        screen_printf("|                                                        |\n");
+        screen_printf("+========================================================+\n");
+    }
+    
+    screen_printf("%s", status_text);
+    screen_printf("\n%s", prompt);
+    screen_present();
+}
+
+// Read one line and return its first character ('q' once input ends)
+char yahtzee_read_choice(void) {
+    char line[32];
+    if (fgets(line, sizeof(line), stdin) == NULL) return 'q';
+    if (strchr(line, '\n') == NULL) {
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF);
+    }
+    return line[0];
+}
+
 // Animate dice rolling with enhanced visual feedback
 void yahtzee_animate_roll(void) {
     const char* roll_frames[] = {
@@ -323,6 +448,7 @@ void yahtzee_animate_roll(void) {
         "Rolling   [#####]"
     };
     
+    // Drawn on the row under the prompt, which the next frame wipes
     printf("\n");
     for (int frame = 0; frame < 11; frame++) {
         printf("\r%s", roll_frames[frame]);
@@ -330,7 +456,8 @@ void yahtzee_animate_roll(void) {
         SLEEP_MS(120);
     }
     
-    printf("\r>> DICE ROLLED! <<           \n");
+    printf("\r>> DICE ROLLED! <<           ");
+    fflush(stdout);
     
     // Show some excitement based on what was rolled
     int total = 0;
@@ -339,19 +466,19 @@ void yahtzee_animate_roll(void) {
     }
     
     if (total >= 25) {
-        printf("   *** EXCELLENT ROLL! ***\n");
+        yahtzee_status("   *** EXCELLENT ROLL! ***\n");
     } else if (total >= 20) {
-        printf("   ** Good roll! **\n");
+        yahtzee_status("   ** Good roll! **\n");
     } else {
-        printf("   * Roll complete *\n");
+        yahtzee_status("   * Roll complete *\n");
     }
 }
 
 // Enhanced dice rolling with sound effects and anticipation
 void yahtzee_roll_dice(void) {
     if (game.rolls_left <= 0) {
-        printf("\n*** NO ROLLS REMAINING! ***\n");
-        printf("You must choose a scoring category to continue.\n");
+        yahtzee_status("\n*** NO ROLLS REMAINING! ***\n");
+        yahtzee_status("You must choose a scoring category to continue.\n");
         return;
     }
     
@@ -362,28 +489,21 @@ void yahtzee_roll_dice(void) {
     }
     
     if (dice_to_roll == 0) {
-        printf("\n*** ALL DICE ARE KEPT! ***\n");
-        printf("All your dice are marked for keeping. Choose a scoring category.\n");
+        yahtzee_status("\n*** ALL DICE ARE KEPT! ***\n");
+        yahtzee_status("All your dice are marked for keeping. Choose a scoring category.\n");
         return;
     }
     
-    printf("\n+=============== ROLLING %d DICE ===============+\n", dice_to_roll);
-    printf("|  Get ready for the roll...                  |\n");
-    printf("+=============================================+\n");
-    
-    // Sound effects simulation
-    printf("\n*shake shake shake*\n");
-    SLEEP_MS(300);
-    
-    yahtzee_animate_roll();
-    
-    // Roll the dice
+    // Roll the dice; the verdict on them is written during the animation
     for (int i = 0; i < NUM_DICE; i++) {
         if (!game.dice.keep[i]) {
-            game.dice.values[i] = (rand() % 6) + 1;
+            game.dice.values[i] = (daily_dice ? daily_below(&dice_stream, 6) : rand() % 6) + 1;
         }
     }
     
+    yahtzee_status("\n>> Rolled %d dice!\n", dice_to_roll);
+    yahtzee_animate_roll();
+    
     game.rolls_left--;
     
     // Analyze the roll for excitement
@@ -413,52 +533,54 @@ void yahtzee_roll_dice(void) {
     
     // Excitement based on roll quality
     if (has_yahtzee) {
-        printf("\n\n*** Y A H T Z E E ! ! ! ***\n");
-        printf("*** INCREDIBLE! ALL FIVE DICE MATCH! ***\n");
-        printf("*clap clap clap* *cheering sounds*\n\n");
+        yahtzee_status("\n\n*** Y A H T Z E E ! ! ! ***\n");
+        yahtzee_status("*** INCREDIBLE! ALL FIVE DICE MATCH! ***\n");
+        yahtzee_status("*clap clap clap* *cheering sounds*\n\n");
     } else if (has_four_kind) {
-        printf("\n** FOUR OF A KIND! **\n");
-        printf("*excited cheering*\n\n");
+        yahtzee_status("\n** FOUR OF A KIND! **\n");
+        yahtzee_status("*excited cheering*\n\n");
     } else if (has_full_house_potential) {
-        printf("\n** FULL HOUSE! **\n");
-        printf("*applause*\n\n");
+        yahtzee_status("\n** FULL HOUSE! **\n");
+        yahtzee_status("*applause*\n\n");
     } else if (has_straight(5)) {
-        printf("\n** LARGE STRAIGHT! **\n");
-        printf("*whistling sounds*\n\n");
+        yahtzee_status("\n** LARGE STRAIGHT! **\n");
+        yahtzee_status("*whistling sounds*\n\n");
     } else if (has_straight(4)) {
-        printf("\n* Small Straight! *\n");
-        printf("*nice roll sounds*\n\n");
+        yahtzee_status("\n* Small Straight! *\n");
+        yahtzee_status("*nice roll sounds*\n\n");
     }
     
-    printf("Rolls remaining: %d\n", game.rolls_left);
+    yahtzee_status("Rolls remaining: %d\n", game.rolls_left);
     
     if (game.rolls_left == 0) {
-        printf("\n>>> FINAL ROLL! Time to score these dice. <<<\n");
+        yahtzee_status("\n>>> FINAL ROLL! Time to score these dice. <<<\n");
     }
 }
 
 // Enhanced dice selection with better UX
 void yahtzee_select_dice(void) {
     if (game.rolls_left == 0) {
-        printf("\n*** NO ROLLS LEFT! You must choose a scoring category. ***\n");
+        yahtzee_status("\n*** NO ROLLS LEFT! You must choose a scoring category. ***\n");
         return;
     }
     
-    printf("\n+================== DICE SELECTION ==================+\n");
-    printf("|  Select dice to KEEP for your next roll:            |\n");
-    printf("|                                                      |\n");
-    printf("|  Examples:                                           |\n");
-    printf("|   '13'    - Keep dice 1 and 3                       |\n");
-    printf("|   '245'   - Keep dice 2, 4, and 5                   |\n");
-    printf("|   'all'   - Keep all dice (end turn)                |\n");
-    printf("|   'none'  - Keep no dice (reroll all)               |\n");
-    printf("|   'c'     - Cancel and continue with current keeps  |\n");
-    printf("|                                                      |\n");
-    printf("+======================================================+\n");
-    printf("\nYour choice: ");
+    yahtzee_status_clear();
+    yahtzee_status("\n+================== DICE SELECTION ==================+\n");
+    yahtzee_status("|  Select dice to KEEP for your next roll:            |\n");
+    yahtzee_status("|                                                      |\n");
+    yahtzee_status("|  Examples:                                           |\n");
+    yahtzee_status("|   '13'    - Keep dice 1 and 3                       |\n");
+    yahtzee_status("|   '245'   - Keep dice 2, 4, and 5                   |\n");
+    yahtzee_status("|   'all'   - Keep all dice (end turn)                |\n");
+    yahtzee_status("|   'none'  - Keep no dice (reroll all)               |\n");
+    yahtzee_status("|   'c'     - Cancel and continue with current keeps  |\n");
+    yahtzee_status("|                                                      |\n");
+    yahtzee_status("+======================================================+\n");
+    yahtzee_present_turn("Your choice: ");
+    yahtzee_status_clear();
     
     char input[20];
-    fgets(input, sizeof(input), stdin);
+    if (fgets(input, sizeof(input), stdin) == NULL) return;
     
     // Remove newline
     for (int i = 0; input[i]; i++) {
@@ -470,7 +592,7 @@ void yahtzee_select_dice(void) {
         for (int i = 0; i < NUM_DICE; i++) {
             game.dice.keep[i] = true;
         }
-        printf(">> All dice marked for keeping!\n");
+        yahtzee_status(">> All dice marked for keeping!\n");
         return;
     }
     
@@ -478,12 +600,12 @@ void yahtzee_select_dice(void) {
         for (int i = 0; i < NUM_DICE; i++) {
             game.dice.keep[i] = false;
         }
-        printf(">> All dice will be rerolled!\n");
+        yahtzee_status(">> All dice will be rerolled!\n");
         return;
     }
     
     if (strcmp(input, "c") == 0 || strcmp(input, "C") == 0 || strcmp(input, "cancel") == 0) {
-        printf(">> Selection cancelled. Current keeps unchanged.\n");
+        yahtzee_status(">> Selection cancelled. Current keeps unchanged.\n");
         return;
     }
     
@@ -505,16 +627,16 @@ void yahtzee_select_dice(void) {
     }
     
     if (kept_count == 0) {
-        printf(">> No valid dice selected. All dice will be rerolled.\n");
+        yahtzee_status(">> No valid dice selected. All dice will be rerolled.\n");
     } else {
-        printf(">> %d dice marked for keeping!\n", kept_count);
-        printf("   Kept dice: ");
+        yahtzee_status(">> %d dice marked for keeping!\n", kept_count);
+        yahtzee_status("   Kept dice: ");
         for (int i = 0; i < NUM_DICE; i++) {
             if (game.dice.keep[i]) {
-                printf("[%d] ", game.dice.values[i]);
+                yahtzee_status("[%d] ", game.dice.values[i]);
             }
         }
-        printf("\n");
+        yahtzee_status("\n");
     }
 }
 
@@ -575,7 +697,7 @@ int sum_all_dice(void) {
 
 // Intelligent dice analysis and suggestions
 void yahtzee_analyze_dice_and_suggest(void) {
-    printf("\n+================ DICE ANALYSIS ================+\n");
+    screen_printf("\n+================ DICE ANALYSIS ================+\n");
     
     // Count each value
     int counts[7] = {0};
@@ -593,63 +715,63 @@ void yahtzee_analyze_dice_and_suggest(void) {
         if (counts[i] >= 4) { has_four = true; four_value = i; }
     }
     
-    printf("|  Current dice combination analysis:            |\n");
-    printf("|                                                |\n");
+    screen_printf("|  Current dice combination analysis:            |\n");
+    screen_printf("|                                                |\n");
     
     if (has_four) {
-        printf("|  >>> FOUR OF A KIND! Keep all %ds! <<<        |\n", four_value);
-        printf("|  This is an excellent result!                 |\n");
+        screen_printf("|  >>> FOUR OF A KIND! Keep all %ds! <<<        |\n", four_value);
+        screen_printf("|  This is an excellent result!                 |\n");
     } else if (has_three && has_pair) {
-        printf("|  >>> FULL HOUSE! Keep all dice! <<<           |\n");
-        printf("|  This scores 25 points guaranteed!            |\n");
+        screen_printf("|  >>> FULL HOUSE! Keep all dice! <<<           |\n");
+        screen_printf("|  This scores 25 points guaranteed!            |\n");
     } else if (has_three) {
-        printf("|  >> Three %ds - consider keeping them        |\n", three_value);
-        printf("|  Good chance for four-of-a-kind or full house |\n");
+        screen_printf("|  >> Three %ds - consider keeping them        |\n", three_value);
+        screen_printf("|  Good chance for four-of-a-kind or full house |\n");
     } else if (has_straight(4)) {
-        printf("|  >> Four in a row - you have a straight!      |\n");
-        printf("|  Keep the straight dice for guaranteed points |\n");
+        screen_printf("|  >> Four in a row - you have a straight!      |\n");
+        screen_printf("|  Keep the straight dice for guaranteed points |\n");
     } else if (has_pair) {
-        printf("|  > Pair of %ds found                          |\n", pair_value);
-        printf("|  Consider keeping for potential full house    |\n");
+        screen_printf("|  > Pair of %ds found                          |\n", pair_value);
+        screen_printf("|  Consider keeping for potential full house    |\n");
     } else {
-        printf("|  No obvious patterns - aim for high values    |\n");
-        printf("|  or keep dice that could form straights       |\n");
+        screen_printf("|  No obvious patterns - aim for high values    |\n");
+        screen_printf("|  or keep dice that could form straights       |\n");
     }
     
     // Suggest optimal keeping strategy
-    printf("|                                                |\n");
-    printf("|  SMART KEEPING SUGGESTION:                     |\n");
+    screen_printf("|                                                |\n");
+    screen_printf("|  SMART KEEPING SUGGESTION:                     |\n");
     
     if (has_four) {
-        printf("|  Keep all %ds (positions: ", four_value);
+        screen_printf("|  Keep all %ds (positions: ", four_value);
         for (int i = 0; i < NUM_DICE; i++) {
-            if (game.dice.values[i] == four_value) printf("%d ", i+1);
+            if (game.dice.values[i] == four_value) screen_printf("%d ", i+1);
         }
-        printf(")              |\n");
+        screen_printf(")              |\n");
     } else if (has_three && has_pair) {
-        printf("|  Keep ALL dice - you have a full house!       |\n");
+        screen_printf("|  Keep ALL dice - you have a full house!       |\n");
     } else if (has_three) {
-        printf("|  Keep the three %ds (positions: ", three_value);
+        screen_printf("|  Keep the three %ds (positions: ", three_value);
         for (int i = 0; i < NUM_DICE; i++) {
-            if (game.dice.values[i] == three_value) printf("%d ", i+1);
+            if (game.dice.values[i] == three_value) screen_printf("%d ", i+1);
         }
-        printf(")            |\n");
+        screen_printf(")            |\n");
     } else {
         // Find highest values to suggest
-        printf("|  Consider keeping highest values: ");
+        screen_printf("|  Consider keeping highest values: ");
         int high_count = 0;
         for (int val = 6; val >= 1 && high_count < 3; val--) {
             for (int i = 0; i < NUM_DICE; i++) {
                 if (game.dice.values[i] == val && high_count < 3) {
-                    printf("%d ", i+1);
+                    screen_printf("%d ", i+1);
                     high_count++;
                 }
             }
         }
-        printf("         |\n");
+        screen_printf("         |\n");
     }
     
-    printf("+================================================+\n");
+    screen_printf("+================================================+\n");
 }
 
 // Calculate score for a category
@@ -720,7 +842,7 @@ void yahtzee_apply_score(YahtzeeCategory category, int score) {
     } else if (score > 0 && yahtzee_calculate_score(YAHTZEE_CAT) == 50 && game.scorecard.used[YAHTZEE_CAT] && game.scorecard.scores[YAHTZEE_CAT] > 0) {
         // Subsequent Yahtzees
         game.scorecard.yahtzee_bonuses++;
-        printf(">> YAHTZEE BONUS! +%d points!\n", YAHTZEE_BONUS);
+        yahtzee_status(">> YAHTZEE BONUS! +%d points!\n", YAHTZEE_BONUS);
     }
 }
 
@@ -752,143 +874,132 @@ void yahtzee_calculate_totals(void) {
 
 // Enhanced turn scoring with smart suggestions
 void yahtzee_score_turn(void) {
-    printf("\n+==================== SCORING MENU ====================+\n");
-    printf("|  Choose how to score your dice:                       |\n");
-    printf("|                                                        |\n");
-    printf("|  Commands:                                             |\n");
-    printf("|   1-13  - Select scoring category                      |\n");
-    printf("|   'p'   - Preview all potential scores                |\n");
-    printf("|   'b'   - Show best scoring recommendations            |\n");
-    printf("|   'h'   - Show help and strategy                      |\n");
-    printf("|                                                        |\n");
-    printf("+========================================================+\n");
-    printf("\nYour choice: ");
-    
-    char input[10];
-    fgets(input, sizeof(input), stdin);
-    
-    // Handle special commands
-    if (input[0] == 'p' || input[0] == 'P') {
-        printf("\n+=== POTENTIAL SCORES PREVIEW ===========================+\n");
-        int best_score = 0;
-        int best_category = -1;
+    // The scoring menu is part of the turn screen; previews and errors
+    // appear in the message panel until a category is chosen
+    while (true) {
+        yahtzee_present_turn("Your choice: ");
+        yahtzee_status_clear();
         
-        for (int i = 0; i < NUM_CATEGORIES; i++) {
-            if (yahtzee_is_valid_category(i)) {
-                int potential = yahtzee_calculate_score(i);
-                char indicator = ' ';
-                if (potential > best_score) {
-                    best_score = potential;
-                    best_category = i;
-                    indicator = '*';
-                }
-                printf("| %c %2d. %-15s : %3d points %-10s |\n", 
-                       indicator, i + 1, category_names[i], potential, 
-                       (potential == 0) ? "(miss)" : "");
-            }
-        }
-        printf("+======================================================+\n");
-        if (best_category >= 0) {
-            printf(">> BEST OPTION: %s (%d points) - marked with *\n", 
-                   category_names[best_category], best_score);
+        char input[10];
+        if (fgets(input, sizeof(input), stdin) == NULL) {
+            game.game_over = true;
+            return;
         }
-        printf("\nPress Enter to continue...");
-        getchar();
-        yahtzee_score_turn(); // Ask again
-        return;
-    }
-    
-    if (input[0] == 'b' || input[0] == 'B') {
-        // Show intelligent recommendations
-        printf("\n+=== SMART RECOMMENDATIONS ===========================+\n");
-        int recommendations[3][2]; // [rank][category, score]
-        int rec_count = 0;
         
-        // Find top 3 scoring options
-        for (int rank = 0; rank < 3; rank++) {
-            int best_score = -1;
-            int best_cat = -1;
+        // Handle special commands
+        if (input[0] == 'p' || input[0] == 'P') {
+            yahtzee_status("\n+=== POTENTIAL SCORES PREVIEW ===========================+\n");
+            int best_score = 0;
+            int best_category = -1;
             
             for (int i = 0; i < NUM_CATEGORIES; i++) {
                 if (yahtzee_is_valid_category(i)) {
-                    int score = yahtzee_calculate_score(i);
-                    bool already_recommended = false;
-                    
-                    for (int j = 0; j < rec_count; j++) {
-                        if (recommendations[j][0] == i) {
-                            already_recommended = true;
-                            break;
-                        }
+                    int potential = yahtzee_calculate_score(i);
+                    char indicator = ' ';
+                    if (potential > best_score) {
+                        best_score = potential;
+                        best_category = i;
+                        indicator = '*';
                     }
-                    
-                    if (!already_recommended && score > best_score) {
-                        best_score = score;
-                        best_cat = i;
+                    yahtzee_status("| %c %2d. %-15s : %3d points %-10s |\n", 
+                           indicator, i + 1, category_names[i], potential, 
+                           (potential == 0) ? "(miss)" : "");
+                }
+            }
+            yahtzee_status("+======================================================+\n");
+            if (best_category >= 0) {
+                yahtzee_status(">> BEST OPTION: %s (%d points) - marked with *\n", 
+                       category_names[best_category], best_score);
+            }
+            continue;
+        }
+        
+        if (input[0] == 'b' || input[0] == 'B') {
+            // Show intelligent recommendations
+            yahtzee_status("\n+=== SMART RECOMMENDATIONS ===========================+\n");
+            int recommendations[3][2]; // [rank][category, score]
+            int rec_count = 0;
+            
+            // Find top 3 scoring options
+            for (int rank = 0; rank < 3; rank++) {
+                int best_score = -1;
+                int best_cat = -1;
+                
+                for (int i = 0; i < NUM_CATEGORIES; i++) {
+                    if (yahtzee_is_valid_category(i)) {
+                        int score = yahtzee_calculate_score(i);
+                        bool already_recommended = false;
+                        
+                        for (int j = 0; j < rec_count; j++) {
+                            if (recommendations[j][0] == i) {
+                                already_recommended = true;
+                                break;
+                            }
+                        }
+                        
+                        if (!already_recommended && score > best_score) {
+                            best_score = score;
+                            best_cat = i;
+                        }
                     }
                 }
+                
+                if (best_cat >= 0) {
+                    recommendations[rec_count][0] = best_cat;
+                    recommendations[rec_count][1] = best_score;
+                    rec_count++;
+                }
             }
             
-            if (best_cat >= 0) {
-                recommendations[rec_count][0] = best_cat;
-                recommendations[rec_count][1] = best_score;
-                rec_count++;
+            for (int i = 0; i < rec_count; i++) {
+                yahtzee_status("| %d. %-15s : %3d points - %s\n", 
+                       i + 1, 
+                       category_names[recommendations[i][0]], 
+                       recommendations[i][1],
+                       (i == 0) ? "BEST CHOICE" : 
+                       (i == 1) ? "Good backup" : "Alternative");
             }
+            yahtzee_status("+===================================================+\n");
+            continue;
         }
         
-        for (int i = 0; i < rec_count; i++) {
-            printf("| %d. %-15s : %3d points - %s\n", 
-                   i + 1, 
-                   category_names[recommendations[i][0]], 
-                   recommendations[i][1],
-                   (i == 0) ? "BEST CHOICE" : 
-                   (i == 1) ? "Good backup" : "Alternative");
+        if (input[0] == 'h' || input[0] == 'H') {
+            yahtzee_show_strategy();
+            screen_invalidate();
+            continue;
         }
-        printf("+===================================================+\n");
-        printf("\nPress Enter to continue...");
-        getchar();
-        yahtzee_score_turn(); // Ask again
-        return;
-    }
-    
-    if (input[0] == 'h' || input[0] == 'H') {
-        yahtzee_show_strategy();
-        yahtzee_score_turn(); // Ask again
-        return;
-    }
-    
-    int choice = atoi(input);
-    
-    if (choice < 1 || choice > NUM_CATEGORIES) {
-        printf("\n*** Invalid choice! Please select 1-13 or use commands. ***\n");
-        SLEEP_MS(1500);
-        yahtzee_score_turn();
-        return;
-    }
-    
-    YahtzeeCategory category = choice - 1;
-    
-    if (!yahtzee_is_valid_category(category)) {
-        printf("\n*** Category '%s' already used! Choose another. ***\n", 
-               category_names[category]);
-        SLEEP_MS(1500);
-        yahtzee_score_turn();
+        
+        int choice = atoi(input);
+        
+        if (choice < 1 || choice > NUM_CATEGORIES) {
+            yahtzee_status("\n*** Invalid choice! Please select 1-13 or use commands. ***\n");
+            continue;
+        }
+        
+        YahtzeeCategory category = choice - 1;
+        
+        if (!yahtzee_is_valid_category(category)) {
+            yahtzee_status("\n*** Category '%s' already used! Choose another. ***\n", 
+                   category_names[category]);
+            continue;
+        }
+        
+        int score = yahtzee_calculate_score(category);
+        yahtzee_apply_score(category, score);
+        
+        yahtzee_status("\n+======== SCORING COMPLETE ========+\n");
+        yahtzee_status("| Category: %-15s      |\n", category_names[category]);
+        yahtzee_status("| Points:   %3d                 |\n", score);
+        if (score == 0) {
+            yahtzee_status("| Result:   MISS                |\n");
+        } else if (score >= 25) {
+            yahtzee_status("| Result:   EXCELLENT!          |\n");
+        } else {
+            yahtzee_status("| Result:   SCORED              |\n");
+        }
+        yahtzee_status("+===================================+\n");
         return;
     }
-    
-    int score = yahtzee_calculate_score(category);
-    yahtzee_apply_score(category, score);
-    
-    printf("\n+======== SCORING COMPLETE ========+\n");
-    printf("| Category: %-15s      |\n", category_names[category]);
-    printf("| Points:   %3d                 |\n", score);
-    if (score == 0) {
-        printf("| Result:   MISS                |\n");
-    } else if (score >= 25) {
-        printf("| Result:   EXCELLENT!          |\n");
-    } else {
-        printf("| Result:   SCORED              |\n");
-    }
-    printf("+===================================+\n");
 }
 
 // Show game rules
@@ -903,6 +1014,8 @@ void yahtzee_show_rules(void) {
     printf("   * Each turn: Roll up to 3 times, keeping dice between rolls\n");
     printf("   * After rolling, choose a scoring category (must use each category once)\n");
     printf("   * Game lasts 13 rounds (one for each category)\n");
+    printf("   * Type 1-5 to keep or release a die; the odds panel shows the exact\n");
+    printf("     chance of completing each open category by the end of the turn\n");
     printf("\n>> SCORING CATEGORIES:\n");
     printf("   UPPER SECTION (sum of matching dice):\n");
     printf("   * Ones, Twos, Threes, Fours, Fives, Sixes\n");
@@ -953,39 +1066,40 @@ void yahtzee_show_strategy(void) {
 
 // Display final results
 void yahtzee_final_results(void) {
-    CLEAR_SCREEN();
     yahtzee_calculate_totals();
     
-    printf("+==============================================================================+\n");
-    printf("|                            ** FINAL RESULTS **                              |\n");
-    printf("+==============================================================================+\n");
+    screen_begin();
+    screen_printf("+==============================================================================+\n");
+    screen_printf("|                            ** FINAL RESULTS **                              |\n");
+    screen_printf("+==============================================================================+\n");
     
     yahtzee_display_scorecard();
     
-    printf("\n>> GAME SUMMARY:\n");
-    printf("   * Upper Section: %d points", game.scorecard.upper_total);
+    screen_printf("\n>> GAME SUMMARY:\n");
+    screen_printf("   * Upper Section: %d points", game.scorecard.upper_total);
     if (game.scorecard.upper_bonus > 0) {
-        printf(" + %d bonus = %d", game.scorecard.upper_bonus, game.scorecard.upper_total + game.scorecard.upper_bonus);
+        screen_printf(" + %d bonus = %d", game.scorecard.upper_bonus, game.scorecard.upper_total + game.scorecard.upper_bonus);
     }
-    printf("\n   * Lower Section: %d points", game.scorecard.lower_total);
+    screen_printf("\n   * Lower Section: %d points", game.scorecard.lower_total);
     if (game.scorecard.yahtzee_bonuses > 0) {
-        printf("\n   * Yahtzee Bonuses: %d x %d = %d points", 
+        screen_printf("\n   * Yahtzee Bonuses: %d x %d = %d points", 
                game.scorecard.yahtzee_bonuses, YAHTZEE_BONUS, game.scorecard.yahtzee_bonuses * YAHTZEE_BONUS);
     }
-    printf("\n\n>> FINAL SCORE: %d POINTS\n", game.scorecard.grand_total);
+    screen_printf("\n\n>> FINAL SCORE: %d POINTS\n", game.scorecard.grand_total);
     
     // Score evaluation
     if (game.scorecard.grand_total >= 400) {
-        printf("** EXCELLENT! You're a Yahtzee master!\n");
+        screen_printf("** EXCELLENT! You're a Yahtzee master!\n");
     } else if (game.scorecard.grand_total >= 300) {
-        printf("** GREAT JOB! Very solid gameplay!\n");
+        screen_printf("** GREAT JOB! Very solid gameplay!\n");
     } else if (game.scorecard.grand_total >= 200) {
-        printf("** GOOD SCORE! Keep practicing!\n");
+        screen_printf("** GOOD SCORE! Keep practicing!\n");
     } else {
-        printf("** Nice try! Yahtzee takes practice to master.\n");
+        screen_printf("** Nice try! Yahtzee takes practice to master.\n");
     }
     
-    printf("\nPress any key to return to main menu...");
+    screen_printf("\nPress any key to return to main menu...");
+    screen_present();
     GETCH();
 }
 
@@ -998,10 +1112,10 @@ void yahtzee_game(void) {
     printf("|                       ** Welcome to YAHTZEE! **                             |\n");
     printf("+==============================================================================+\n");
     printf("\n>> Ready to play the classic dice game?\n");
-    printf("\n[R] Play Game  [H] Rules  [S] Strategy  [Q] Quit\n");
+    printf("\n[R] Play Game  [D] Daily Dice  [H] Rules  [S] Strategy  [Q] Quit\n");
     printf("Choose: ");
     
-    char choice = GETCH();
+    char choice = yahtzee_read_choice();
     choice = tolower(choice);
     
     switch (choice) {
@@ -1016,85 +1130,74 @@ void yahtzee_game(void) {
         case 'q':
             return;
         case 'r':
+        case 'd':
             break;
         default:
             yahtzee_game();
             return;
     }
     
+    // Daily dice: everyone rolls the same sequence of values today
+    daily_dice = (choice == 'd');
+    dice_stream = daily_seed(DAILY_YAHTZEE, daily_today());
+    
     // Initialize and start game
     yahtzee_init_game();
+    yahtzee_status_clear();
+    screen_invalidate();
     
     // Main game loop
     while (!game.game_over) {
-        CLEAR_SCREEN();
-        yahtzee_display_header();
-        yahtzee_display_scorecard();
-        yahtzee_display_dice();
-        
         if (game.rolls_left > 0) {
-            // Show intelligent analysis
-            yahtzee_analyze_dice_and_suggest();
-            
-            printf("\n+============= TURN ACTIONS =============+\n");
-            printf("|                                        |\n");
-            printf("|  [R] Roll dice     [K] Keep/select     |\n");
-            printf("|  [P] Preview scores [S] Strategy       |\n");
-            printf("|  [H] Help & Rules   [Q] Quit game      |\n");
-            printf("|                                        |\n");
-            printf("+========================================+\n");
-            printf("\nWhat would you like to do? ");
-            
-            char action = GETCH();
-            action = tolower(action);
-            
-            printf("\n"); // Add line after input
+            yahtzee_present_turn("What would you like to do? ");
+            char action = tolower(yahtzee_read_choice());
+            yahtzee_status_clear();
             
             switch (action) {
                 case 'r':
                     yahtzee_roll_dice();
-                    if (game.rolls_left > 0) {
-                        printf("\nPress any key to continue...");
-                        GETCH();
-                    }
                     break;
                 case 'k':
                     yahtzee_select_dice();
-                    printf("\nPress any key to continue...");
-                    GETCH();
                     break;
+                case '1': case '2': case '3': case '4': case '5': {
+                    // One die at a time, so the odds panel follows each toggle
+                    int die = action - '1';
+                    game.dice.keep[die] = !game.dice.keep[die];
+                    yahtzee_status(">> Die %d [%d] %s\n", die + 1, game.dice.values[die],
+                                   game.dice.keep[die] ? "kept" : "released");
+                    break;
+                }
                 case 'p':
                     // Quick preview without full menu
-                    printf("\n=== QUICK SCORE PREVIEW ===\n");
+                    yahtzee_status("\n=== QUICK SCORE PREVIEW ===\n");
                     for (int i = 0; i < NUM_CATEGORIES && i < 6; i++) {
                         if (yahtzee_is_valid_category(i)) {
-                            printf("%d. %-12s: %3d pts\n", i+1, category_names[i], yahtzee_calculate_score(i));
+                            yahtzee_status("%d. %-12s: %3d pts\n", i+1, category_names[i], yahtzee_calculate_score(i));
                         }
                     }
-                    printf("... (use scoring menu for full list)\n");
-                    printf("\nPress any key to continue...");
-                    GETCH();
+                    yahtzee_status("... (use scoring menu for full list)\n");
                     break;
                 case 's':
                     yahtzee_show_strategy();
+                    screen_invalidate();
                     break;
                 case 'h':
                     yahtzee_show_rules();
+                    screen_invalidate();
                     break;
                 case 'q':
                     printf("\n>>> Thanks for playing Yahtzee! <<<\n");
                     printf("Your final score would have been: %d points\n", game.scorecard.grand_total);
                     return;
                 default:
-                    printf("Invalid choice '%c'! Try again.\n", action);
-                    SLEEP_MS(1000);
+                    yahtzee_status("\nInvalid choice '%c'! Try again.\n", isprint((unsigned char)action) ? action : '?');
                     break;
             }
         } else {
             // Must score this turn
-            printf("\n*** SCORING REQUIRED ***\n");
-            printf("No rolls left - you must choose a scoring category!\n");
             yahtzee_score_turn();
+            if (game.game_over) return;      // Input ended
             yahtzee_calculate_totals();
             
             // Reset for next round
@@ -1108,14 +1211,12 @@ void yahtzee_game(void) {
             if (game.current_round > NUM_ROUNDS) {
                 game.game_over = true;
             } else {
-                printf("\n+========================================+\n");
-                printf("| Round %2d complete! Moving to round %2d  |\n", 
+                yahtzee_status("\n+========================================+\n");
+                yahtzee_status("| Round %2d complete! Moving to round %2d  |\n", 
                        game.current_round - 1, game.current_round);
-                printf("| Current total: %4d points            |\n", 
+                yahtzee_status("| Current total: %4d points            |\n", 
                        game.scorecard.grand_total);
-                printf("+========================================+\n");
-                printf("\nPress any key for next round...");
-                GETCH();
+                yahtzee_status("+========================================+\n");
             }
         }
     }
@@ -0,0 +1,260 @@
+/*
+ * Yahtzee Category Odds
+ * Part of CLI Games Pack v2.1
+ *
+ * Hands are numbered in lexicographic order of their sorted values. A
+ * hand's key adds 6^(face - 1) per die, so the key of a kept part plus
+ * the key of a reroll is the key of the hand they make; one table maps
+ * keys back to hand numbers. The rerolls of n dice are listed once as
+ * (key, ways) pairs, and row s of pattern p is the kept part of s joined
+ * with each of them.
+ *
+ * Each pattern's matrix takes C(rerolled + 5, 5) entries per hand: 1,683
+ * per hand over all 32 patterns, 424,116 in all, one byte for the next
+ * hand and one for its ways (at most 5! = 120).
+ */
+
+#ifndef _WIN32
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "games.h"
+#include "yahtzee_odds.h"
+
+#define KEY_SPACE 46656          // 6^6: five dice, each face counted in base 6
+#define MAX_REROLLS 252
+
+static const uint32_t face_keys[7] = {0, 1, 6, 36, 216, 1296, 7776};
+static const uint32_t reroll_totals[YAHTZEE_ODDS_DICE + 1] = {1, 6, 36, 216, 1296, 7776};
+
+static const char* const labels[YAHTZEE_ODDS_CATEGORIES] = {
+    "3+ 1s", "3+ 2s", "3+ 3s", "3+ 4s", "3+ 5s", "3+ 6s",
+    "3 of a Kind", "4 of a Kind", "Full House", "Sm. Straight",
+    "Lg. Straight", "YAHTZEE", "Chance 23+"
+};
+
+static int ready;
+static uint8_t hand_values[YAHTZEE_ODDS_HANDS][YAHTZEE_ODDS_DICE];
+static uint8_t hand_of_key[KEY_SPACE];
+
+// Rerolls of n dice as multisets, with the ordered rolls that give each
+static uint16_t reroll_keys[YAHTZEE_ODDS_DICE + 1][MAX_REROLLS];
+static uint8_t reroll_ways[YAHTZEE_ODDS_DICE + 1][MAX_REROLLS];
+static int reroll_counts[YAHTZEE_ODDS_DICE + 1];
+
+// The 32 matrices, row after row
+static uint32_t row_start[YAHTZEE_ODDS_PATTERNS][YAHTZEE_ODDS_HANDS + 1];
+static uint8_t* row_next;
+static uint8_t* row_ways;
+
+// best[r][hand][category]: chance of completing with r rolls still to come
+static double best[YAHTZEE_ODDS_MAX_ROLLS][YAHTZEE_ODDS_HANDS][YAHTZEE_ODDS_CATEGORIES];
+
+static uint32_t key_of(const int* values, int count) {
+    uint32_t key = 0;
+    for (int i = 0; i < count; i++) key += face_keys[values[i]];
+    return key;
+}
+
+// Nondecreasing runs of dice from face first on, in lexicographic order
+static void list_hands(int* values, int depth, int first, int* count) {
+    if (depth == YAHTZEE_ODDS_DICE) {
+        for (int i = 0; i < YAHTZEE_ODDS_DICE; i++) hand_values[*count][i] = (uint8_t)values[i];
+        hand_of_key[key_of(values, YAHTZEE_ODDS_DICE)] = (uint8_t)*count;
+        (*count)++;
+        return;
+    }
+    for (int face = first; face <= 6; face++) {
+        values[depth] = face;
+        list_hands(values, depth + 1, face, count);
+    }
+}
+
+static void list_rerolls(int dice, int* values, int depth, int first) {
+    if (depth == dice) {
+        // Ways to roll this multiset in order: dice! / (repeats! ...)
+        static const int factorial[6] = {1, 1, 2, 6, 24, 120};
+        int ways = factorial[dice];
+        for (int i = 0, run = 1; i < dice; i++, run++) {
+            if (i + 1 == dice || values[i + 1] != values[i]) {
+                ways /= factorial[run];
+                run = 0;
+            }
+        }
+        int index = reroll_counts[dice]++;
+        reroll_keys[dice][index] = (uint16_t)key_of(values, dice);
+        reroll_ways[dice][index] = (uint8_t)ways;
+        return;
+    }
+    for (int face = first; face <= 6; face++) {
+        values[depth] = face;
+        list_rerolls(dice, values, depth + 1, face);
+    }
+}
+
+int yahtzee_odds_target(int category, const int values[YAHTZEE_ODDS_DICE]) {
+    int counts[7] = {0};
+    int most = 0, sum = 0;
+    for (int i = 0; i < YAHTZEE_ODDS_DICE; i++) {
+        counts[values[i]]++;
+        sum += values[i];
+    }
+    for (int face = 1; face <= 6; face++) {
+        if (counts[face] > most) most = counts[face];
+    }
+
+    if (category < 6) return counts[category + 1] >= 3;
+    switch (category) {
+        case 6: return most >= 3;
+        case 7: return most >= 4;
+        case 8: {
+            // As the scorecard counts it: exactly three and exactly two
+            int three = 0, two = 0;
+            for (int face = 1; face <= 6; face++) {
+                three |= counts[face] == 3;
+                two |= counts[face] == 2;
+            }
+            return three && two;
+        }
+        case 9:
+        case 10: {
+            int needed = category == 9 ? 4 : 5, run = 0;
+            for (int face = 1; face <= 6; face++) {
+                run = counts[face] ? run + 1 : 0;
+                if (run >= needed) return 1;
+            }
+            return 0;
+        }
+        case 11: return most == 5;
+        case 12: return sum >= 23;
+    }
+    return 0;
+}
+
+// Sparse row times a column block of best[], scaled to a probability
+static void row_product(int pattern, int hand, double (*vectors)[YAHTZEE_ODDS_CATEGORIES],
+                        double out[YAHTZEE_ODDS_CATEGORIES]) {
+    double sums[YAHTZEE_ODDS_CATEGORIES] = {0};
+    int rerolled = YAHTZEE_ODDS_DICE - __builtin_popcount((unsigned)pattern);
+
+    for (uint32_t k = row_start[pattern][hand]; k < row_start[pattern][hand + 1]; k++) {
+        const double* next = vectors[row_next[k]];
+        double ways = row_ways[k];
+        for (int c = 0; c < YAHTZEE_ODDS_CATEGORIES; c++) sums[c] += ways * next[c];
+    }
+    for (int c = 0; c < YAHTZEE_ODDS_CATEGORIES; c++) out[c] = sums[c] / reroll_totals[rerolled];
+}
+
+int yahtzee_odds_init(void) {
+    int values[YAHTZEE_ODDS_DICE];
+    int hands = 0;
+
+    if (ready) return 1;
+
+    memset(hand_of_key, 0xFF, sizeof(hand_of_key));
+    list_hands(values, 0, 1, &hands);
+    for (int dice = 0; dice <= YAHTZEE_ODDS_DICE; dice++) {
+        reroll_counts[dice] = 0;
+        list_rerolls(dice, values, 0, 1);
+    }
+
+    uint32_t entries = 0;
+    for (int pattern = 0; pattern < YAHTZEE_ODDS_PATTERNS; pattern++) {
+        entries += (uint32_t)(YAHTZEE_ODDS_HANDS *
+                              reroll_counts[YAHTZEE_ODDS_DICE - __builtin_popcount((unsigned)pattern)]);
+    }
+    uint8_t* next = malloc(entries);
+    uint8_t* ways = malloc(entries);
+    if (!next || !ways) {
+        free(next);
+        free(ways);
+        return 0;
+    }
+
+    uint32_t k = 0;
+    for (int pattern = 0; pattern < YAHTZEE_ODDS_PATTERNS; pattern++) {
+        int rerolled = YAHTZEE_ODDS_DICE - __builtin_popcount((unsigned)pattern);
+        for (int hand = 0; hand < YAHTZEE_ODDS_HANDS; hand++) {
+            uint32_t kept = 0;
+            for (int i = 0; i < YAHTZEE_ODDS_DICE; i++) {
+                if (pattern >> i & 1) kept += face_keys[hand_values[hand][i]];
+            }
+            row_start[pattern][hand] = k;
+            for (int r = 0; r < reroll_counts[rerolled]; r++, k++) {
+                next[k] = hand_of_key[kept + reroll_keys[rerolled][r]];
+                ways[k] = reroll_ways[rerolled][r];
+            }
+        }
+        row_start[pattern][YAHTZEE_ODDS_HANDS] = k;
+    }
+    row_next = next;
+    row_ways = ways;
+
+    // With no roll to come a hand either completes a category or not;
+    // each earlier roll keeps whatever pattern does best for it
+    for (int hand = 0; hand < YAHTZEE_ODDS_HANDS; hand++) {
+        int dice[YAHTZEE_ODDS_DICE];
+        for (int i = 0; i < YAHTZEE_ODDS_DICE; i++) dice[i] = hand_values[hand][i];
+        for (int c = 0; c < YAHTZEE_ODDS_CATEGORIES; c++) best[0][hand][c] = yahtzee_odds_target(c, dice);
+    }
+    for (int rolls = 1; rolls < YAHTZEE_ODDS_MAX_ROLLS; rolls++) {
+        for (int hand = 0; hand < YAHTZEE_ODDS_HANDS; hand++) {
+            double top[YAHTZEE_ODDS_CATEGORIES], product[YAHTZEE_ODDS_CATEGORIES];
+            memcpy(top, best[rolls - 1][hand], sizeof(top));      // Keeping everything
+            for (int pattern = 0; pattern < YAHTZEE_ODDS_PATTERNS - 1; pattern++) {
+                row_product(pattern, hand, best[rolls - 1], product);
+                for (int c = 0; c < YAHTZEE_ODDS_CATEGORIES; c++) {
+                    if (product[c] > top[c]) top[c] = product[c];
+                }
+            }
+            memcpy(best[rolls][hand], top, sizeof(top));
+        }
+    }
+
+    ready = 1;
+    return 1;
+}
+
+int yahtzee_odds_hand(const int values[YAHTZEE_ODDS_DICE]) {
+    return hand_of_key[key_of(values, YAHTZEE_ODDS_DICE)];
+}
+
+void yahtzee_odds_panel(const int values[YAHTZEE_ODDS_DICE], unsigned keep_mask, int rolls_left,
+                        double odds[YAHTZEE_ODDS_CATEGORIES]) {
+    if (rolls_left <= 0 || (keep_mask & 0x1F) == 0x1F) {
+        for (int c = 0; c < YAHTZEE_ODDS_CATEGORIES; c++) odds[c] = yahtzee_odds_target(c, values);
+        return;
+    }
+    if (rolls_left > YAHTZEE_ODDS_MAX_ROLLS) rolls_left = YAHTZEE_ODDS_MAX_ROLLS;
+
+    // The keep as a pattern over the hand's sorted positions: the kept
+    // dice of each face take that face's first positions
+    int counts[7] = {0}, kept[7] = {0};
+    for (int i = 0; i < YAHTZEE_ODDS_DICE; i++) {
+        counts[values[i]]++;
+        kept[values[i]] += keep_mask >> i & 1;
+    }
+    int pattern = 0, position = 0;
+    for (int face = 1; face <= 6; face++) {
+        pattern |= ((1 << kept[face]) - 1) << position;
+        position += counts[face];
+    }
+
+    row_product(pattern, yahtzee_odds_hand(values), best[rolls_left - 1], odds);
+}
+
+double yahtzee_odds_best(int category, int hand, int rolls_after) {
+    return best[rolls_after][hand][category];
+}
+
+int yahtzee_odds_row(int pattern, int hand, const uint8_t** next, const uint8_t** ways, uint32_t* total) {
+    uint32_t first = row_start[pattern][hand];
+    *next = row_next + first;
+    *ways = row_ways + first;
+    *total = reroll_totals[YAHTZEE_ODDS_DICE - __builtin_popcount((unsigned)pattern)];
+    return (int)(row_start[pattern][hand + 1] - first);
+}
+
+const char* yahtzee_odds_label(int category) {
+    return labels[category];
+}
@@ -0,0 +1,63 @@
+#ifndef YAHTZEE_ODDS_H
+#define YAHTZEE_ODDS_H
+
+#include <stdint.h>
+
+/*
+ * Exact category odds for Yahtzee.
+ *
+ * Five dice make one of 252 hands (sorted multisets). A keep pattern
+ * says which of the hand's sorted positions stay on the table, so each of
+ * the 32 patterns is a 252x252 transition matrix: row s holds the
+ * distribution of hands after rerolling the rest of hand s. The matrices
+ * are sparse (1,683 nonzeros per hand over all patterns), so each is kept
+ * as rows of (next hand, ways) with 6^rerolled ways in total.
+ *
+ * For every category, a target vector marks the hands that complete it.
+ * One roll before the end, the best chance from each hand is the largest
+ * matrix-vector product over the patterns; two rolls before, the same
+ * products are taken against that vector. Those vectors are built once.
+ * The live odds for the player's own keep are then one sparse row times
+ * the vector for the rolls that will be left, for each open category:
+ * a few thousand multiply-adds per keep toggle.
+ */
+
+#define YAHTZEE_ODDS_DICE 5
+#define YAHTZEE_ODDS_HANDS 252
+#define YAHTZEE_ODDS_PATTERNS 32
+#define YAHTZEE_ODDS_MAX_ROLLS 3
+
+// Categories in scorecard order; see yahtzee_odds_target for what
+// completing each one means
+#define YAHTZEE_ODDS_CATEGORIES 13
+
+// Builds the matrices and target vectors on first use. Returns 0 when
+// out of memory.
+int yahtzee_odds_init(void);
+
+// Index of the hand holding these five values (1-6, any order)
+int yahtzee_odds_hand(const int values[YAHTZEE_ODDS_DICE]);
+
+// Whether the five dice complete a category: three or more of the face
+// for Ones-Sixes (par for the upper bonus), a scoring hand for the lower
+// section, and 23 or more for Chance
+int yahtzee_odds_target(int category, const int values[YAHTZEE_ODDS_DICE]);
+
+// Chance of completing each category by the end of the turn when the
+// dice not in keep_mask (bit i: die i stays) are rolled now and the
+// remaining rolls are kept for that category as well as possible. With
+// no rolls left the odds are 0 or 1 for the dice as they are.
+void yahtzee_odds_panel(const int values[YAHTZEE_ODDS_DICE], unsigned keep_mask, int rolls_left,
+                        double odds[YAHTZEE_ODDS_CATEGORIES]);
+
+// Best chance from a hand with rolls still to come (0 to MAX_ROLLS - 1)
+double yahtzee_odds_best(int category, int hand, int rolls_after);
+
+// Row of a pattern's transition matrix: next hands and their ways out
+// of 6^rerolled. Returns the number of entries.
+int yahtzee_odds_row(int pattern, int hand, const uint8_t** next, const uint8_t** ways, uint32_t* total);
+
+// Short label for the panel ("3+ 1s", "Lg. Straight", "Chance 23+")
+const char* yahtzee_odds_label(int category);
+
+#endif // YAHTZEE_ODDS_H
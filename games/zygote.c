@@ -0,0 +1,381 @@
+/*
+ * Zygote Launcher
+ * Part of CLI Games Pack v2.1
+ *
+ * One connection per session. The launch sends a ZygoteRequest with its
+ * three standard descriptors attached. The forked session answers with
+ * its pid, and sends its exit status when it ends. A pid of 0 means the
+ * zygote refused the launch. A connection that closes without a status
+ * means the session was killed.
+ *
+ * Both ends check the other's uid. The shared directory is world-writable,
+ * so a socket planted there by another user must never get this user's
+ * terminal.
+ */
+
+#ifndef _WIN32
+    #define _GNU_SOURCE
+#endif
+
+#include "games.h"
+#include "highscores.h"
+#include "zygote.h"
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <stdint.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+#endif
+
+#define ZYGOTE_MAGIC 0x31475A43u        // "CZG1"
+#define ZYGOTE_BACKLOG 64
+#define REQUEST_TIMEOUT_SECONDS 2       // A launch sends its request right after connecting
+
+#ifndef _WIN32
+
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+    int64_t modified;
+} ExecutableId;
+
+typedef struct {
+    uint32_t magic;
+    ExecutableId executable;
+    char term[64];
+    char cwd[1024];
+} ZygoteRequest;
+
+static volatile sig_atomic_t session_pid;
+
+static int executable_id(ExecutableId* id) {
+    struct stat st;
+
+    memset(id, 0, sizeof(*id));
+    if (stat("/proc/self/exe", &st) != 0) return 0;
+    id->device = (uint64_t)st.st_dev;
+    id->inode = (uint64_t)st.st_ino;
+    id->modified = (int64_t)st.st_mtime;
+    return 1;
+}
+
+int zygote_socket_path(char* path, int size) {
+    char file_name[64];
+    struct sockaddr_un address;
+
+    snprintf(file_name, sizeof(file_name), "zygote-%ld.sock", (long)getuid());
+    return highscore_shared_path(file_name, path, size) && strlen(path) < sizeof(address.sun_path);
+}
+
+static int peer_is_me(int fd) {
+#ifdef SO_PEERCRED
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 && credentials.uid == getuid();
+#else
+    (void)fd;
+    return 1;                           // The socket is mode 0600 and the directory sticky
+#endif
+}
+
+// zygote_socket_path has checked that path fits
+static void socket_address(struct sockaddr_un* address, const char* path) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    memcpy(address->sun_path, path, strlen(path) + 1);
+}
+
+static int connect_to(const char* path) {
+    struct sockaddr_un address;
+
+    socket_address(&address, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int send_all(int fd, const void* data, size_t size) {
+    const char* bytes = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return 0;
+        bytes += sent;
+        size -= (size_t)sent;
+    }
+    return 1;
+}
+
+static int receive_int(int fd, int32_t* value) {
+    char* bytes = (char*)value;
+    size_t have = 0;
+    while (have < sizeof(*value)) {
+        ssize_t got = recv(fd, bytes + have, sizeof(*value) - have, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return 0;
+        have += (size_t)got;
+    }
+    return 1;
+}
+
+// Reads the request and its descriptors; on failure none are left open
+static int receive_request(int fd, ZygoteRequest* request, int fds[3]) {
+    union {
+        struct cmsghdr header;
+        char space[CMSG_SPACE(3 * sizeof(int))];
+    } control;
+    struct iovec part = {request, sizeof(*request)};
+    struct msghdr message;
+
+    memset(&message, 0, sizeof(message));
+    memset(&control, 0, sizeof(control));
+    message.msg_iov = &part;
+    message.msg_iovlen = 1;
+    message.msg_control = control.space;
+    message.msg_controllen = sizeof(control.space);
+
+    ssize_t got = recvmsg(fd, &message, MSG_WAITALL);
+    int received = 0;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+        int count = (int)((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        for (int i = 0; i < count; i++) {
+            int passed;
+            memcpy(&passed, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            if (received < 3) {
+                fds[received++] = passed;
+            } else {
+                close(passed);
+            }
+        }
+    }
+
+    if (got == (ssize_t)sizeof(*request) && received == 3 && !(message.msg_flags & MSG_CTRUNC)) {
+        request->term[sizeof(request->term) - 1] = '\0';
+        request->cwd[sizeof(request->cwd) - 1] = '\0';
+        return 1;
+    }
+    for (int i = 0; i < received; i++) close(fds[i]);
+    return 0;
+}
+
+static void run_child(int listener, int client, const ZygoteRequest* request, int fds[3], ZygoteSession session) {
+    close(listener);
+    signal(SIGCHLD, SIG_DFL);
+    signal(SIGHUP, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);           // The server ignores it; a game dies on a closed terminal
+    for (int i = 0; i < 3; i++) dup2(fds[i], i);
+    for (int i = 0; i < 3; i++) {
+        if (fds[i] > STDERR_FILENO) close(fds[i]);
+    }
+
+    // Out of the zygote's session, so its terminal checks never apply
+    setsid();
+    if (request->term[0]) {
+        setenv("TERM", request->term, 1);
+    } else {
+        unsetenv("TERM");
+    }
+    if (request->cwd[0]) chdir(request->cwd);      // Else stays put; every shared path is absolute
+
+    // A cold session dies with its terminal's hangup; this one has no
+    // controlling terminal, so it hangs up with the launch instead. The
+    // launch never writes again: the socket turning readable means it is gone.
+    fcntl(client, F_SETOWN, getpid());
+#ifdef F_SETSIG
+    fcntl(client, F_SETSIG, SIGHUP);
+#endif
+    fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_ASYNC);
+    struct pollfd gone = {client, POLLIN, 0};
+    if (poll(&gone, 1, 0) != 0) _exit(1);
+
+    int32_t pid = (int32_t)getpid();
+    if (!send_all(client, &pid, sizeof(pid))) _exit(1);
+    int32_t status = session();
+    fflush(NULL);
+    send_all(client, &status, sizeof(status));
+    _exit(status);
+}
+
+static void serve_one(int listener, int client, const ExecutableId* self, ZygoteSession session) {
+    struct timeval timeout = {REQUEST_TIMEOUT_SECONDS, 0};
+    ZygoteRequest request;
+    int fds[3];
+
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (!peer_is_me(client) || !receive_request(client, &request, fds)) return;
+
+    int32_t refused = 0;
+    if (request.magic != ZYGOTE_MAGIC || memcmp(&request.executable, self, sizeof(*self)) != 0) {
+        send_all(client, &refused, sizeof(refused));
+    } else {
+        fflush(NULL);
+        pid_t pid = fork();
+        if (pid == 0) run_child(listener, client, &request, fds, session);
+        if (pid < 0) send_all(client, &refused, sizeof(refused));
+    }
+    for (int i = 0; i < 3; i++) close(fds[i]);
+}
+
+int zygote_serve(ZygoteSession session) {
+    char path[512];
+    struct sockaddr_un address;
+    ExecutableId self;
+
+    if (!executable_id(&self) || !zygote_socket_path(path, sizeof(path))) {
+        fprintf(stderr, "zygote: no executable id or socket path\n");
+        return 1;
+    }
+    highscore_make_shared_dir();
+
+    int running = connect_to(path);
+    if (running >= 0) {
+        close(running);
+        fprintf(stderr, "zygote: already serving on %s\n", path);
+        return 1;
+    }
+    unlink(path);                       // Left behind by a zygote that was killed
+
+    socket_address(&address, path);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    mode_t old_mask = umask(077);
+    int bound = listener >= 0 && bind(listener, (struct sockaddr*)&address, sizeof(address)) == 0;
+    umask(old_mask);
+    if (!bound || listen(listener, ZYGOTE_BACKLOG) != 0) {
+        fprintf(stderr, "zygote: cannot listen on %s\n", path);
+        if (listener >= 0) close(listener);
+        return 1;
+    }
+
+    // Sessions are reaped by the kernel; the terminal that started us may go away
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGHUP, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+    int null_fd = open("/dev/null", O_RDONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        if (null_fd != STDIN_FILENO) close(null_fd);
+    }
+    fprintf(stderr, "zygote: serving sessions on %s (pid %ld)\n", path, (long)getpid());
+
+    for (;;) {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("zygote: accept");
+            close(listener);
+            unlink(path);
+            return 1;
+        }
+        serve_one(listener, client, &self, session);
+        close(client);
+    }
+}
+
+static void forward_signal(int sig) {
+    if (session_pid > 0) kill((pid_t)session_pid, sig);
+}
+
+// The session has no controlling terminal, so Ctrl+Z has to stop it by hand
+static void suspend_session(int sig) {
+    (void)sig;
+    if (session_pid > 0) kill((pid_t)session_pid, SIGSTOP);
+    kill(getpid(), SIGSTOP);
+    if (session_pid > 0) kill((pid_t)session_pid, SIGCONT);     // Resumed by fg
+}
+
+int zygote_attach(int* status) {
+    static const int forwarded[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT, SIGWINCH};
+    int fds[3] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+    union {
+        struct cmsghdr header;
+        char space[CMSG_SPACE(sizeof(fds))];
+    } control;
+    char path[512];
+    ZygoteRequest request;
+    struct msghdr message;
+    struct sigaction action;
+
+    const char* mode = getenv("CLI_GAMES_ZYGOTE");
+    if (mode && strcmp(mode, "0") == 0) return 0;
+    memset(&request, 0, sizeof(request));
+    if (!executable_id(&request.executable) || !zygote_socket_path(path, sizeof(path))) return 0;
+
+    int fd = connect_to(path);
+    if (fd < 0) return 0;
+    if (!peer_is_me(fd)) {
+        close(fd);
+        return 0;
+    }
+
+    request.magic = ZYGOTE_MAGIC;
+    const char* term = getenv("TERM");
+    if (term) snprintf(request.term, sizeof(request.term), "%s", term);
+    if (!getcwd(request.cwd, sizeof(request.cwd))) request.cwd[0] = '\0';
+
+    struct iovec part = {&request, sizeof(request)};
+    memset(&message, 0, sizeof(message));
+    memset(&control, 0, sizeof(control));
+    message.msg_iov = &part;
+    message.msg_iovlen = 1;
+    message.msg_control = control.space;
+    message.msg_controllen = sizeof(control.space);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    int32_t pid = 0;
+    if (sendmsg(fd, &message, MSG_NOSIGNAL) != (ssize_t)sizeof(request) || !receive_int(fd, &pid) || pid <= 0) {
+        close(fd);
+        return 0;                       // Refused (another build) or gone: start cold
+    }
+
+    // From here the session owns the terminal; this process only relays
+    session_pid = pid;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = forward_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < sizeof(forwarded) / sizeof(forwarded[0]); i++) {
+        sigaction(forwarded[i], &action, NULL);
+    }
+    action.sa_handler = suspend_session;
+    sigaction(SIGTSTP, &action, NULL);
+
+    int32_t result;
+    *status = receive_int(fd, &result) ? (int)result : 1;
+    close(fd);
+    return 1;
+}
+
+#else
+
+int zygote_socket_path(char* path, int size) {
+    (void)path;
+    (void)size;
+    return 0;
+}
+
+int zygote_serve(ZygoteSession session) {
+    (void)session;
+    fprintf(stderr, "zygote: not available on Windows\n");
+    return 1;
+}
+
+int zygote_attach(int* status) {
+    (void)status;
+    return 0;
+}
+
+#endif
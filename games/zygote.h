@@ -0,0 +1,34 @@
+#ifndef ZYGOTE_H
+#define ZYGOTE_H
+
+/*
+ * Pre-forked session launcher.
+ *
+ * `cli-games --zygote` builds the read-only tables that sessions would
+ * otherwise each build for themselves (poker evaluator, Yahtzee odds,
+ * Wordle feedback matrix, word grade index). It then waits on a per-user
+ * Unix socket in the shared directory. A plain launch connects and passes
+ * its terminal (stdin, stdout and stderr as SCM_RIGHTS). The zygote forks
+ * a session that goes straight to the main menu, sharing those tables
+ * copy-on-write with every other session. The launching process stays
+ * only to forward signals and to exit with the session's status.
+ *
+ * Sessions are served only to the same executable (device, inode and
+ * modification time). After a rebuild, an old zygote turns launches away
+ * and they start cold. So does every launch when no zygote is running,
+ * with CLI_GAMES_ZYGOTE=0, and on Windows.
+ */
+
+typedef int (*ZygoteSession)(void);
+
+// <shared dir>/zygote-<uid>.sock; returns 0 when it does not fit
+int zygote_socket_path(char* path, int size);
+
+// Serves sessions until killed; returns nonzero only when it cannot start
+int zygote_serve(ZygoteSession session);
+
+// Runs this launch as a session of a running zygote and returns 1 with
+// its exit status, or returns 0 when the launch should start cold
+int zygote_attach(int* status);
+
+#endif // ZYGOTE_H
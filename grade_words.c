@@ -0,0 +1,88 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "games/word_grades.h"
+
+// Batch job for the word difficulty grades: reads a dictionary (one word
+// per line), grades every word for Hangman and Word Scramble on every
+// core and writes the index the games pick from in the shared directory.
+// Proper nouns, words with anything but letters, and words shorter than
+// four or longer than Hangman allows are left out.
+//
+//   ./grade_words [dictionary] [threads]     (make grades: /usr/share/dict/words)
+
+static int compare_words(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+int main(int argc, char** argv) {
+    const char* dictionary = argc > 1 ? argv[1] : "/usr/share/dict/words";
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    char path[512], line[256];
+    struct timespec start, end;
+
+    if (!word_grades_path(path, sizeof(path))) {
+        fprintf(stderr, "usage: %s [dictionary] [threads]\n", argv[0]);
+        return 1;
+    }
+    FILE* file = fopen(dictionary, "r");
+    if (!file) {
+        fprintf(stderr, "could not open %s (usage: %s [dictionary] [threads])\n", dictionary, argv[0]);
+        return 1;
+    }
+
+    int capacity = 1 << 16, count = 0;
+    char** words = malloc((size_t)capacity * sizeof(char*));
+    while (words && fgets(line, sizeof(line), file)) {
+        size_t length = strcspn(line, "\r\n");
+        line[length] = '\0';
+        if (length < 4 || length > WORD_GRADES_MAX_LENGTH || isupper((unsigned char)line[0])) continue;
+        int letters = 1;
+        for (size_t i = 0; i < length && letters; i++) {
+            letters = isalpha((unsigned char)line[i]) != 0;
+            line[i] = (char)toupper((unsigned char)line[i]);
+        }
+        if (!letters) continue;
+        if (count == capacity) {
+            char** grown = realloc(words, (size_t)(capacity *= 2) * sizeof(char*));
+            if (!grown) break;
+            words = grown;
+        }
+        words[count] = malloc(length + 1);
+        if (!words[count]) break;
+        memcpy(words[count++], line, length + 1);
+    }
+    fclose(file);
+    if (!words || count == 0) {
+        fprintf(stderr, "no usable words in %s\n", dictionary);
+        return 1;
+    }
+
+    // Graded words must be distinct
+    qsort(words, (size_t)count, sizeof(char*), compare_words);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique > 0 && strcmp(words[i], words[unique - 1]) == 0) {
+            free(words[i]);
+        } else {
+            words[unique++] = words[i];
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ok = word_grades_write(path, (const char* const*)words, unique, threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    for (int i = 0; i < unique; i++) free(words[i]);
+    free(words);
+    if (!ok) {
+        fprintf(stderr, "could not write %s\n", path);
+        return 1;
+    }
+    printf("%d words from %s graded and written to %s in %.2f s\n", unique, dictionary, path,
+           (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+    return 0;
+}
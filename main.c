@@ -1,4 +1,13 @@
 #include "games/games.h"
+#include "games/daily.h"
+#include "games/flight_recorder.h"
+#include "games/metrics.h"
+#include "games/poker_eval.h"
+#include "games/word_grades.h"
+#include "games/wordle_solver.h"
+#include "games/yahtzee_odds.h"
+#include "games/write_behind.h"
+#include "games/zygote.h"
 
 void display_menu(void) {
     printf("\n+==========================================+\n");
@@ -27,10 +36,14 @@ void display_menu(void) {
     printf("| 19. Russian Roulette                     |\n");
     printf("| 20. 15-Puzzle (Sliding Puzzle)           |\n");
     printf("| 21. Yahtzee (Dice Game)                  |\n");
-    printf("| 22. Exit                                 |\n");
+    printf("| 22. Texas Hold'em (vs AI)                |\n");
+    printf("| 23. Rating Ladder (All Games)            |\n");
+    printf("| 24. Wordle (with Solver)                 |\n");
+    printf("| 25. Tetris (with AI)                     |\n");
+    printf("| 26. Exit                                 |\n");
     printf("|                                          |\n");
     printf("+==========================================+\n");
-    printf("\nPlease enter your choice (1-22): ");
+    printf("\nPlease enter your choice (1-26): ");
 }
 
 void clear_input_buffer(void) {
@@ -73,13 +86,23 @@ int games_kbhit(void) {
 #endif
 }
 
-int main(void) {
+// One player's visit, from the welcome to Exit; cold or forked from a zygote
+static int run_session(void) {
     int choice;
     int running = 1;
     
     // Seed random number generator
     srand((unsigned int)time(NULL));
     
+    // Crash dumps + terminal restore on fatal signals
+    flight_recorder_install();
+    
+    // Prometheus export, when $CLI_GAMES_METRICS names a socket or file
+    metrics_export_start();
+    
+    // Daily challenges come from a pack; renew it in the background if due
+    daily_prepare();
+    
     printf("Welcome to CLI Games Pack!\n");
     printf("Developed with <3 in C\n");
     
@@ -87,13 +110,19 @@ int main(void) {
         display_menu();
         
         if (scanf("%d", &choice) != 1) {
-            printf("\nInvalid input! Please enter a number between 1-21.\n");
+            printf("\nInvalid input! Please enter a number between 1-26.\n");
             clear_input_buffer();
             pause_and_continue();
             continue;
         }
         
         clear_input_buffer(); // Clear remaining input
+        flight_recorder_mark("main menu choice");
+        flight_recorder_input(choice);
+        
+        // Menu numbers are the metric game ids plus one
+        int tracked = choice >= 1 && choice <= METRICS_TETRIS + 1;
+        if (tracked) metrics_session_begin((MetricsGame)(choice - 1));
         
         switch (choice) {
             case 1:
@@ -223,16 +252,66 @@ int main(void) {
                 break;
                 
             case 22:
+                printf("\n>>> Starting Texas Hold'em...\n");
+                play_texas_holdem();
+                pause_and_continue();
+                break;
+                
+            case 23:
+                printf("\n>>> Opening Rating Ladder...\n");
+                show_rating_ladder();
+                pause_and_continue();
+                break;
+                
+            case 24:
+                printf("\n>>> Starting Wordle...\n");
+                play_wordle();
+                pause_and_continue();
+                break;
+                
+            case 25:
+                printf("\n>>> Starting Tetris...\n");
+                play_tetris();
+                pause_and_continue();
+                break;
+                
+            case 26:
                 printf("\n>>> Thanks for playing! Goodbye!\n");
                 running = 0;
                 break;
                 
             default:
-                printf("\nInvalid choice! Please select a number between 1-22.\n");
+                printf("\nInvalid choice! Please select a number between 1-26.\n");
                 pause_and_continue();
                 break;
         }
+        if (tracked) metrics_session_end((MetricsGame)(choice - 1));
     }
     
+    metrics_export_stop();
+    write_behind_shutdown();            // Saves still queued reach the disk
+    metrics_close();                    // After the writer's last observation
     return 0;
 }
+
+// Read-only tables a zygote builds once for every session it forks. Per-
+// process state (metrics, jackpot, high score mapping) is left to each
+// session; games open these the same way and find them ready.
+static void preload_shared_tables(void) {
+    poker_eval_init();
+    yahtzee_odds_init();
+    wordle_matrix_open(0);
+    word_grades_open(WORD_POOL_HANGMAN, NULL, 0);
+    word_grades_open(WORD_POOL_SCRAMBLE, NULL, 0);
+}
+
+int main(int argc, char* argv[]) {
+    int status;
+
+    if (argc > 1 && strcmp(argv[1], "--zygote") == 0) {
+        preload_shared_tables();
+        return zygote_serve(run_session);
+    }
+    if (zygote_attach(&status)) return status;
+    return run_session();
+}
@@ -0,0 +1,136 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "games/alias_table.h"
+
+// Statistical test for the alias tables. For each distribution the games
+// use (weights copied from the game sources) plus some edge cases, the
+// table's exact probabilities must match the weights, and a batch of
+// samples must pass a chi-square goodness-of-fit test at p = 0.001.
+// Zero-weight outcomes must never be drawn.
+
+#define SAMPLES 4000000
+#define CHI_SQUARE_Z 3.09      // One-sided p = 0.001
+
+typedef struct {
+    const char* name;
+    uint32_t weights[ALIAS_MAX_OUTCOMES];
+    int count;
+} Distribution;
+
+static uint8_t samples[SAMPLES];
+
+// Wilson-Hilferty approximation of the chi-square critical value
+static double chi_square_critical(int df) {
+    double k = 2.0 / (9.0 * df);
+    double root = 1.0 - k + CHI_SQUARE_Z * sqrt(k);
+    return df * root * root * root;
+}
+
+static int check_distribution(const Distribution* dist, uint64_t seed) {
+    AliasTable table;
+    FastRng rng;
+    long long counts[ALIAS_MAX_OUTCOMES] = {0};
+    uint64_t total = 0;
+    double worst_error = 0.0, chi_square = 0.0;
+    int df = -1, zero_hits = 0;
+
+    if (!alias_table_build(&table, dist->weights, dist->count)) {
+        printf("%-24s build FAILED\n", dist->name);
+        return 0;
+    }
+    for (int i = 0; i < dist->count; i++) total += dist->weights[i];
+
+    for (int i = 0; i < dist->count; i++) {
+        double expected = (double)dist->weights[i] / (double)total;
+        double error = fabs(alias_table_probability(&table, i) - expected);
+        if (error > worst_error) worst_error = error;
+    }
+
+    fast_rng_seed(&rng, seed);
+    alias_table_sample_batch(&table, &rng, samples, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) counts[samples[i]]++;
+
+    for (int i = 0; i < dist->count; i++) {
+        double expected = (double)SAMPLES * dist->weights[i] / (double)total;
+        if (dist->weights[i] == 0) {
+            zero_hits += counts[i] != 0;
+            continue;
+        }
+        chi_square += (counts[i] - expected) * (counts[i] - expected) / expected;
+        df++;
+    }
+
+    double critical = df > 0 ? chi_square_critical(df) : 0.0;
+    int ok = worst_error < 1e-9 && zero_hits == 0 && chi_square <= critical;
+    printf("%-24s k=%-2d  max |p-w| %.1e  chi2 %8.2f / %8.2f (df %2d)  %s\n",
+           dist->name, dist->count, worst_error, chi_square, critical, df, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// The single-draw path must agree with the batch path for the same seed
+static int check_single_matches_batch(void) {
+    static const uint32_t weights[8] = {25, 20, 20, 15, 10, 7, 2, 1};
+    AliasTable table;
+    FastRng a, b;
+    uint8_t batch[1000];
+
+    alias_table_build(&table, weights, 8);
+    fast_rng_seed(&a, 99);
+    fast_rng_seed(&b, 99);
+    alias_table_sample_batch(&table, &a, batch, 1000);
+    for (int i = 0; i < 1000; i++) {
+        if (alias_table_sample(&table, &b) != batch[i]) {
+            printf("single/batch mismatch at %d FAILED\n", i);
+            return 0;
+        }
+    }
+    printf("%-24s ok\n", "single == batch");
+    return 1;
+}
+
+static int check_rejects_bad_input(void) {
+    uint32_t zeros[4] = {0, 0, 0, 0};
+    uint32_t many[ALIAS_MAX_OUTCOMES + 1] = {0};
+    AliasTable table;
+    int ok = !alias_table_build(&table, zeros, 4) && !alias_table_build(&table, zeros, 0) &&
+             !alias_table_build(&table, many, ALIAS_MAX_OUTCOMES + 1);
+    printf("%-24s %s\n", "rejects bad weights", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(void) {
+    static Distribution dists[] = {
+        {"slot machine symbols", {25, 20, 20, 15, 10, 7, 2, 1}, 8},
+        {"snake food types", {90, 8, 2}, 3},
+        {"flappy gap rows (11)", {1, 2, 3, 4, 5, 6, 5, 4, 3, 2, 1}, 11},
+        {"flappy gap rows (8)", {1, 2, 3, 4, 4, 3, 2, 1}, 8},
+        {"dino tier 0", {1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 12},
+        {"dino tier 1", {1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0}, 12},
+        {"dino tier 2", {1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0}, 12},
+        {"dino tier 3", {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}, 12},
+        {"single outcome", {7}, 1},
+        {"huge weights", {4000000000u, 1, 3000000000u, 0, 12345}, 5},
+        {"64 random weights", {0}, ALIAS_MAX_OUTCOMES},
+    };
+    int count = (int)(sizeof(dists) / sizeof(dists[0]));
+    int failures = 0;
+
+    FastRng fill;
+    fast_rng_seed(&fill, 2024);
+    for (int i = 0; i < ALIAS_MAX_OUTCOMES; i++) {
+        dists[count - 1].weights[i] = 1 + fast_rng_below(&fill, 1000);
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!check_distribution(&dists[i], 0x5EED0000u + (uint64_t)i)) failures++;
+    }
+    if (!check_single_matches_batch()) failures++;
+    if (!check_rejects_bad_input()) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "games/ghost_trace.h"
+
+// Records an hour-long synthetic Dino Runner marathon (60 ticks a second,
+// the game's jump physics, random jumps and ducks), saves it, maps it back
+// and replays it tick by tick: every tick must match, and the whole trace
+// must stay in the kilobyte range. Also checks large row jumps, replay
+// that skips ticks, and that damaged files are refused.
+
+#define TICKS (60 * 60 * 60)
+#define MAX_HOUR_BYTES (100 * 1024)
+#define GROUND_ROW 15
+
+enum { RUNNING, JUMPING, DUCKING, DEAD };
+
+static GhostRecorder recorder;
+static signed char rows[TICKS + 1];
+static unsigned char states[TICKS + 1];
+static unsigned long long rng_state = 0x9E3779B97F4A7C15ull;
+
+static unsigned int next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 32);
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-48s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// Same integration as dino_runner_update_dino: jump at -6, gravity 0.6
+static void simulate(void) {
+    float y = GROUND_ROW, velocity = 0;
+    int state = RUNNING, next_action = 60, duck_left = 0;
+
+    rows[0] = GROUND_ROW;
+    states[0] = RUNNING;
+    for (int tick = 1; tick <= TICKS; tick++) {
+        if (tick == TICKS) {
+            state = DEAD;
+        } else if (state == JUMPING) {
+            velocity += 0.6f;
+            if (velocity > 6.0f) velocity = 6.0f;
+            y += velocity;
+            if (y >= GROUND_ROW) {
+                y = GROUND_ROW;
+                state = RUNNING;
+            }
+        } else if (state == DUCKING && --duck_left == 0) {
+            state = RUNNING;
+        } else if (state == RUNNING && --next_action == 0) {
+            if (next_random() % 4 == 0) {
+                state = DUCKING;
+                duck_left = 12;
+            } else {
+                state = JUMPING;
+                velocity = -6.0f;
+            }
+            next_action = 45 + (int)(next_random() % 100);
+        }
+        rows[tick] = (signed char)(int)y;
+        states[tick] = (unsigned char)state;
+    }
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-ghost-XXXXXX";
+    char path[256], broken[256];
+    GhostPlayer player;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    snprintf(path, sizeof(path), "%s/hour.trace", dir);
+    snprintf(broken, sizeof(broken), "%s/broken.trace", dir);
+
+    simulate();
+    ghost_recorder_begin(&recorder, rows[0], states[0]);
+    for (int tick = 1; tick <= TICKS; tick++) ghost_recorder_tick(&recorder, (uint32_t)tick, rows[tick], states[tick]);
+    int saved = ghost_recorder_save(&recorder, path, 4321, TICKS);
+
+    printf("One-hour run: %d ticks, %u trace bytes (%.1f bytes/minute)\n",
+           TICKS, recorder.length, recorder.length / 60.0);
+    failures += check("trace saved", saved && !recorder.truncated);
+    failures += check("an hour fits in 100 KB", recorder.length < MAX_HOUR_BYTES);
+
+    int opened = ghost_player_open(&player, path);
+    int mismatches = 0;
+    for (int tick = 0; opened && tick <= TICKS; tick++) {
+        ghost_player_advance(&player, (uint32_t)tick);
+        if (player.row != rows[tick] || player.state != states[tick]) mismatches++;
+    }
+    failures += check("mapped trace opens with its score and length",
+                      opened && player.score == 4321 && player.ticks == TICKS);
+    failures += check("every tick replays exactly", opened && mismatches == 0);
+
+    // Frame drops: advancing several ticks at once lands on the same state
+    mismatches = 0;
+    if (opened) {
+        ghost_player_rewind(&player);
+        for (int tick = 0; tick <= TICKS; tick += 1 + (int)(next_random() % 7)) {
+            ghost_player_advance(&player, (uint32_t)tick);
+            if (player.row != rows[tick] || player.state != states[tick]) mismatches++;
+        }
+        ghost_player_close(&player);
+    }
+    failures += check("skipping ticks replays exactly", opened && mismatches == 0);
+
+    // Row changes wider than one change byte holds
+    ghost_recorder_begin(&recorder, 0, RUNNING);
+    ghost_recorder_tick(&recorder, 5, 70, JUMPING);
+    ghost_recorder_tick(&recorder, 6, -50, DUCKING);
+    ghost_recorder_tick(&recorder, 100000, -50, DEAD);
+    saved = ghost_recorder_save(&recorder, path, 1, 100000);
+    opened = saved && ghost_player_open(&player, path);
+    int wide_ok = opened;
+    if (opened) {
+        ghost_player_advance(&player, 4);
+        wide_ok = wide_ok && player.row == 0 && player.state == RUNNING;
+        ghost_player_advance(&player, 5);
+        wide_ok = wide_ok && player.row == 70 && player.state == JUMPING;
+        ghost_player_advance(&player, 99999);
+        wide_ok = wide_ok && player.row == -50 && player.state == DUCKING;
+        ghost_player_advance(&player, 100000);
+        wide_ok = wide_ok && player.state == DEAD;
+        ghost_player_close(&player);
+    }
+    failures += check("large row jumps and long gaps round-trip", wide_ok);
+
+    // A truncated copy and a file of junk are both refused
+    FILE* source = fopen(path, "rb");
+    FILE* target = fopen(broken, "wb");
+    unsigned char bytes[64];
+    size_t length = source ? fread(bytes, 1, sizeof(bytes), source) : 0;
+    if (target) {
+        fwrite(bytes, 1, length > 2 ? length - 2 : 0, target);
+        fclose(target);
+    }
+    if (source) fclose(source);
+    failures += check("truncated trace refused", !ghost_player_open(&player, broken));
+    target = fopen(broken, "wb");
+    if (target) {
+        fputs("not a trace file, just some text", target);
+        fclose(target);
+    }
+    failures += check("foreign file refused", !ghost_player_open(&player, broken));
+
+    remove(path);
+    remove(broken);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
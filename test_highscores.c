@@ -0,0 +1,138 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "games/highscores.h"
+
+// Stress test for the shared high-score table: 64 processes submit scores
+// to the same slot at once while the parent keeps reading snapshots. Every
+// snapshot must be sorted and never lose ground (entries only improve), and
+// the final table must equal the true top K of everything submitted.
+
+#define PROCESSES 64
+#define SUBMITS_PER_PROCESS 20000
+#define TEST_MODE 3
+
+static uint32_t process_score(unsigned int* state) {
+    *state = *state * 1103515245u + 12345u;
+    return ((*state >> 8) % 5000000u) + 1;
+}
+
+static int compare_desc(const void* a, const void* b) {
+    uint32_t sa = *(const uint32_t*)a, sb = *(const uint32_t*)b;
+    return sa < sb ? 1 : sa > sb ? -1 : 0;
+}
+
+static double seconds_since(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-test-XXXXXX";
+    pid_t pids[PROCESSES];
+    struct timespec start;
+    int failures = 0;
+
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int p = 0; p < PROCESSES; p++) {
+        pids[p] = fork();
+        if (pids[p] == 0) {
+            char name[HIGHSCORE_NAME_LEN];
+            unsigned int state = (unsigned int)p + 1;
+            snprintf(name, sizeof(name), "proc%02d", p);
+            if (!highscore_open()) _exit(2);
+            for (int i = 0; i < SUBMITS_PER_PROCESS; i++) {
+                highscore_submit(HIGHSCORE_STRESS_TEST, TEST_MODE, name, process_score(&state));
+            }
+            _exit(0);
+        } else if (pids[p] < 0) {
+            perror("fork");
+            return 1;
+        }
+    }
+
+    // Concurrent reader: snapshots must be sorted and monotone
+    if (!highscore_open()) {
+        printf("Shared table could not be mapped\n");
+        failures++;
+    }
+    HighScoreEntry entries[HIGHSCORE_TOP_K];
+    uint32_t last_best = 0, last_floor = 0;
+    long snapshots = 0;
+    int running = PROCESSES;
+    while (running > 0) {
+        int count = highscore_read(HIGHSCORE_STRESS_TEST, TEST_MODE, entries);
+        for (int i = 1; i < count; i++) {
+            if (entries[i].score > entries[i - 1].score) {
+                printf("Unsorted snapshot\n");
+                failures++;
+            }
+        }
+        if (count > 0) {
+            uint32_t floor = count == HIGHSCORE_TOP_K ? entries[count - 1].score : 0;
+            if (entries[0].score < last_best || floor < last_floor) {
+                printf("Snapshot went backwards: best %u < %u or floor %u < %u\n",
+                       entries[0].score, last_best, floor, last_floor);
+                failures++;
+            }
+            last_best = entries[0].score;
+            last_floor = floor;
+        }
+        snapshots++;
+
+        int status;
+        pid_t done;
+        while ((done = waitpid(-1, &status, WNOHANG)) > 0) {
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                printf("Submitter %d failed\n", (int)done);
+                failures++;
+            }
+            running--;
+        }
+    }
+    double elapsed = seconds_since(start);
+    long total = (long)PROCESSES * SUBMITS_PER_PROCESS;
+    printf("Submits:           %ld from %d processes in %.2f s (%.1f k/s)\n",
+           total, PROCESSES, elapsed, total / elapsed / 1e3);
+    printf("Reader snapshots:  %ld\n", snapshots);
+
+    // Expected top K from every process's score stream
+    uint32_t* all = malloc((size_t)total * sizeof(uint32_t));
+    for (int p = 0; p < PROCESSES; p++) {
+        unsigned int state = (unsigned int)p + 1;
+        for (int i = 0; i < SUBMITS_PER_PROCESS; i++) {
+            all[(long)p * SUBMITS_PER_PROCESS + i] = process_score(&state);
+        }
+    }
+    qsort(all, (size_t)total, sizeof(uint32_t), compare_desc);
+
+    int count = highscore_read(HIGHSCORE_STRESS_TEST, TEST_MODE, entries);
+    if (count != HIGHSCORE_TOP_K) failures++;
+    for (int i = 0; i < count; i++) {
+        int ok = entries[i].score == all[i] && strncmp(entries[i].name, "proc", 4) == 0;
+        printf("  %2d. %-8s %8u %s\n", i + 1, entries[i].name, entries[i].score, ok ? "ok" : "MISMATCH");
+        if (!ok) failures++;
+    }
+    if (highscore_best(HIGHSCORE_STRESS_TEST, TEST_MODE + 1) != 0) failures++;
+    free(all);
+
+    char path[512];
+    highscore_close();
+    if (highscore_shared_path("highscores.tbl", path, sizeof(path))) unlink(path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Drives the real cli-games binary through a pseudo-terminal into states
+// where nothing changes on screen (the main menu, a paused Flappy Bird,
+// a paused Dino Runner) and counts how often the process is scheduled
+// there: voluntary plus involuntary context switches from /proc over a
+// measurement window. An idle state must sleep in the kernel until a key
+// arrives, so the rate has to be near zero. A running game is measured
+// the same way as a control, to show the counter sees a polling loop.
+
+#define WINDOW_MS 2000
+#define MAX_IDLE_RATE 1.0       // Wakeups per second
+#define MIN_RUNNING_RATE 20.0
+
+static char output[1 << 20];
+
+static int elapsed_ms(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+}
+
+// Keeps the pty drained so the game never blocks on a full output buffer
+static void pump(int master, int ms) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        int elapsed = elapsed_ms(start);
+        if (elapsed >= ms) return;
+
+        struct pollfd pfd = {master, POLLIN, 0};
+        if (poll(&pfd, 1, ms - elapsed) <= 0) continue;
+        if (read(master, output, sizeof(output)) <= 0) return;
+    }
+}
+
+static long context_switches(pid_t pid) {
+    char path[64], line[256];
+    long total = 0;
+
+    snprintf(path, sizeof(path), "/proc/%d/status", (int)pid);
+    FILE* status = fopen(path, "r");
+    if (!status) return -1;
+    while (fgets(line, sizeof(line), status)) {
+        long count;
+        if (sscanf(line, "voluntary_ctxt_switches: %ld", &count) == 1 ||
+            sscanf(line, "nonvoluntary_ctxt_switches: %ld", &count) == 1) {
+            total += count;
+        }
+    }
+    fclose(status);
+    return total;
+}
+
+// Starts cli-games, types each step with a pause after it, then returns
+// the wakeup rate over the measurement window (or -1 on failure)
+static double measure(const char* const* steps) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        return -1;
+    }
+
+    pid_t child = fork();
+    if (child == 0) {
+        setsid();
+        int slave = open(ptsname(master), O_RDWR);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        close(master);
+        execl("./cli-games", "cli-games", (char*)NULL);
+        _exit(127);
+    }
+
+    pump(master, 400);
+    for (int i = 0; steps[i]; i++) {
+        if (write(master, steps[i], strlen(steps[i])) < 0) perror("write");
+        pump(master, 300);
+    }
+    pump(master, 200);                  // Let the last screen settle
+
+    long before = context_switches(child);
+    pump(master, WINDOW_MS);
+    long after = context_switches(child);
+
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    close(master);
+
+    if (before < 0 || after < 0) return -1;
+    return (after - before) * 1000.0 / WINDOW_MS;
+}
+
+int main(void) {
+    static const char* const menu[] = {NULL};
+    static const char* const flappy_paused[] = {"17\n", "1\n", "\np", NULL};
+    static const char* const dino_paused[] = {"18\n", "1\n", "\n", "\033", NULL};
+    static const char* const dino_running[] = {"18\n", "1\n", "\n", NULL};
+    static const struct {
+        const char* name;
+        const char* const* steps;
+        int idle;
+    } cases[] = {
+        {"Main menu",            menu,          1},
+        {"Flappy Bird paused",   flappy_paused, 1},
+        {"Dino Runner paused",   dino_paused,   1},
+        {"Dino Runner running",  dino_running,  0},
+    };
+    char dir[] = "/tmp/cli-games-idle-XXXXXX";
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    setenv("TERM", "xterm", 1);
+
+    printf("Wakeups per second over %d ms\n", WINDOW_MS);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        double rate = measure(cases[i].steps);
+        int ok = rate >= 0 && (cases[i].idle ? rate <= MAX_IDLE_RATE : rate >= MIN_RUNNING_RATE);
+        printf("  %-22s %7.1f  (%s %.0f) %s\n", cases[i].name, rate,
+               cases[i].idle ? "max" : "min",
+               cases[i].idle ? MAX_IDLE_RATE : MIN_RUNNING_RATE, ok ? "ok" : "FAIL");
+        if (!ok) failures++;
+    }
+
+    char command[128];
+    snprintf(command, sizeof(command), "rm -rf %s", dir);
+    if (system(command) != 0) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "games/metrics.h"
+
+// Threads and forked processes record into the shared shards at once;
+// the rendered totals must add up exactly. Then the Prometheus text is
+// checked (bucket bounds, cumulative counts, a crashed process's open
+// session left out), scraped from the Unix socket and read back from the
+// exported file. Last, the cost of one recording.
+
+#define THREADS 8
+#define OBSERVATIONS_PER_THREAD 200000
+#define PROCESSES 4
+#define OBSERVATIONS_PER_PROCESS 100000
+#define TIMED_OBSERVATIONS 10000000
+
+static char text[32768];
+
+static int check(const char* label, int ok) {
+    printf("  %-56s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// The value of the sample named exactly by series, or -1
+static long long sample(const char* body, const char* series) {
+    size_t length = strlen(series);
+    for (const char* line = body; line && *line; line = strchr(line, '\n') ? strchr(line, '\n') + 1 : NULL) {
+        if (strncmp(line, series, length) == 0 && line[length] == ' ') return atoll(line + length + 1);
+    }
+    return -1;
+}
+
+static void* hammer(void* arg) {
+    (void)arg;
+    metrics_session_begin(METRICS_SNAKE);
+    for (int i = 0; i < OBSERVATIONS_PER_THREAD; i++) metrics_observe(METRICS_TICK_US, (uint64_t)(i % 5000));
+    metrics_session_end(METRICS_SNAKE);
+    return NULL;
+}
+
+static int scrape(const char* path, char* out, size_t size) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        if (fd >= 0) close(fd);
+        return 0;
+    }
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    if (write(fd, request, sizeof(request) - 1) < 0) {
+        close(fd);
+        return 0;
+    }
+    size_t length = 0;
+    ssize_t n;
+    while (length < size - 1 && (n = read(fd, out + length, size - 1 - length)) > 0) length += (size_t)n;
+    out[length] = '\0';
+    close(fd);
+    return (int)length;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-test-XXXXXX";
+    char path[600], target[620], series[160];
+    pthread_t threads[THREADS];
+    int failures = 0;
+
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    failures += check("shards mapped from the shared directory", metrics_open() == 1);
+
+    metrics_session_begin(METRICS_SNAKE);
+    for (int p = 0; p < PROCESSES; p++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            // Starts a session and dies without ending it
+            metrics_session_begin(METRICS_SNAKE);
+            for (int i = 0; i < OBSERVATIONS_PER_PROCESS; i++) metrics_observe(METRICS_STATS_WRITE_US, 3);
+            _exit(0);
+        } else if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+    }
+    for (int t = 0; t < THREADS; t++) pthread_create(&threads[t], NULL, hammer, NULL);
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    for (int p = 0; p < PROCESSES; p++) wait(NULL);
+
+    for (uint64_t value = 0; value <= 5; value++) metrics_observe(METRICS_FRAME_BYTES, value);
+    metrics_observe(METRICS_FRAME_BYTES, (uint64_t)1 << 40);
+
+    size_t length = metrics_render(text, sizeof(text));
+    failures += check("rendering fits the buffer", length < sizeof(text));
+
+    long long per_thread_sum = 0;
+    for (int i = 0; i < OBSERVATIONS_PER_THREAD; i++) per_thread_sum += i % 5000;
+    failures += check("every thread's tick was counted",
+                      sample(text, "cli_games_tick_duration_microseconds_count") == (long long)THREADS * OBSERVATIONS_PER_THREAD);
+    failures += check("tick sum adds up across shards",
+                      sample(text, "cli_games_tick_duration_microseconds_sum") == THREADS * per_thread_sum);
+    failures += check("every process's writes were counted",
+                      sample(text, "cli_games_stats_write_microseconds_count") == (long long)PROCESSES * OBSERVATIONS_PER_PROCESS);
+    failures += check("sessions counted from threads and processes",
+                      sample(text, "cli_games_sessions_total{game=\"snake\"}") == 1 + PROCESSES + THREADS);
+    failures += check("dead processes' open sessions are not active",
+                      sample(text, "cli_games_active_sessions{game=\"snake\"}") == 1);
+    failures += check("other games stay at zero",
+                      sample(text, "cli_games_active_sessions{game=\"wordle\"}") == 0);
+
+    // 0,1 | 2 | 3,4 | 5 | 2^40 falls past the last bound
+    failures += check("bucket bounds are inclusive powers of two",
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"1\"}") == 2 &&
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"2\"}") == 3 &&
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"4\"}") == 5 &&
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"8\"}") == 6 &&
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"4194304\"}") == 6 &&
+                      sample(text, "cli_games_frame_bytes_bucket{le=\"+Inf\"}") == 7 &&
+                      sample(text, "cli_games_frame_bytes_count") == 7);
+    int monotonic = 1;
+    long long previous = 0;
+    for (int bucket = 0; bucket < METRICS_BUCKETS - 1; bucket++) {
+        snprintf(series, sizeof(series), "cli_games_tick_duration_microseconds_bucket{le=\"%llu\"}", 1ull << bucket);
+        long long value = sample(text, series);
+        if (value < previous) monotonic = 0;
+        previous = value;
+    }
+    failures += check("buckets are cumulative", monotonic);
+    failures += check("histograms are typed for Prometheus",
+                      strstr(text, "# TYPE cli_games_tick_duration_microseconds histogram\n") != NULL);
+
+    // Served over a Unix socket
+    snprintf(path, sizeof(path), "%s/metrics.sock", dir);
+    snprintf(target, sizeof(target), "unix:%s", path);
+    setenv("CLI_GAMES_METRICS", target, 1);
+    failures += check("socket exporter started", metrics_export_start() == 1);
+    metrics_observe(METRICS_INPUT_LATENCY_US, 100);
+    int scraped = scrape(path, text, sizeof(text));
+    char* body = strstr(text, "\r\n\r\n");
+    failures += check("scrape answered with HTTP 200", scraped > 0 && strncmp(text, "HTTP/1.0 200 OK", 15) == 0 && body);
+    failures += check("scrape sees live values",
+                      body && sample(body + 4, "cli_games_input_latency_microseconds_count") == 1);
+    failures += check("a second scrape is served too", scrape(path, text, sizeof(text)) > 0);
+    metrics_export_stop();
+    failures += check("socket removed on stop", access(path, F_OK) != 0);
+
+    // Written to a plain file
+    snprintf(path, sizeof(path), "%s/metrics.prom", dir);
+    setenv("CLI_GAMES_METRICS", path, 1);
+    setenv("CLI_GAMES_METRICS_INTERVAL", "20", 1);
+    failures += check("file exporter started", metrics_export_start() == 1);
+    metrics_observe(METRICS_INPUT_LATENCY_US, 100);
+    usleep(100000);
+    metrics_export_stop();
+    FILE* file = fopen(path, "rb");
+    length = file ? fread(text, 1, sizeof(text) - 1, file) : 0;
+    text[length] = '\0';
+    if (file) fclose(file);
+    failures += check("exported file holds the latest values",
+                      sample(text, "cli_games_input_latency_microseconds_count") == 2);
+    unlink(path);
+
+    // The cost of one recording on an already claimed shard
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < TIMED_OBSERVATIONS; i++) metrics_observe(METRICS_TICK_US, (uint64_t)i & 1023);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / TIMED_OBSERVATIONS;
+    printf("  %.1f ns per observation (two relaxed atomic adds)\n", ns);
+
+    metrics_session_end(METRICS_SNAKE);
+    metrics_close();
+    snprintf(path, sizeof(path), "%s/metrics.shards", dir);
+    unlink(path);
+    rmdir(dir);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,260 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+
+// Plays expert Minesweeper, 2048 and Tetris in the real cli-games binary
+// through a 50x100 pseudo-terminal and feeds everything it writes to a
+// small VT emulator. Each move must cost a small fraction of a full frame,
+// and after a run of incremental moves the emulated screen must match the
+// full repaint of the same state that follows a trip to the help page.
+
+#define ROWS 50
+#define COLS 100
+
+static char screen[ROWS][COLS + 1];     // Rows stay NUL-terminated
+static int cursor_row, cursor_col;
+static size_t bytes_seen;
+
+static void clear_cells(int row, int from_col, int to_row) {
+    for (int r = row; r <= to_row && r < ROWS; r++) {
+        int start = r == row ? from_col : 0;
+        if (start < COLS) memset(screen[r] + start, ' ', (size_t)(COLS - start));
+    }
+}
+
+static void new_line(void) {
+    if (++cursor_row == ROWS) {
+        memmove(screen[0], screen[1], sizeof(screen) - sizeof(screen[0]));
+        memset(screen[ROWS - 1], ' ', COLS);
+        cursor_row = ROWS - 1;
+    }
+}
+
+// Understands the sequences the games emit: cursor moves, erases, clears
+static void emulate(const unsigned char* data, size_t length) {
+    static int state = 0;       // 0 text, 1 after ESC, 2 inside CSI
+    static int params[4], count;
+
+    bytes_seen += length;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = data[i];
+        if (state == 1) {
+            state = c == '[' ? 2 : 0;
+            count = 0;
+            params[0] = 0;
+            continue;
+        }
+        if (state == 2) {
+            if (c >= '0' && c <= '9') {
+                params[count] = params[count] * 10 + (c - '0');
+            } else if (c == ';') {
+                if (count < 3) params[++count] = 0;
+            } else if (c != '?') {
+                int first = params[0];
+                state = 0;
+                switch (c) {
+                    case 'H':
+                        cursor_row = (first ? first : 1) - 1;
+                        cursor_col = (count > 0 && params[1] ? params[1] : 1) - 1;
+                        break;
+                    case 'G': cursor_col = (first ? first : 1) - 1; break;
+                    case 'A': cursor_row -= first ? first : 1; break;
+                    case 'K': clear_cells(cursor_row, cursor_col, cursor_row); break;
+                    case 'J':
+                        if (first == 0) clear_cells(cursor_row, cursor_col, ROWS - 1);
+                        else if (first == 2) clear_cells(0, 0, ROWS - 1);
+                        break;
+                    default: break;
+                }
+                if (cursor_row < 0) cursor_row = 0;
+            }
+            continue;
+        }
+        if (c == 033) {
+            state = 1;
+        } else if (c == '\n') {
+            new_line();
+        } else if (c == '\r') {
+            cursor_col = 0;
+        } else if (c == '\b') {
+            if (cursor_col > 0) cursor_col--;
+        } else if (c >= ' ') {
+            if (cursor_col == COLS) {
+                cursor_col = 0;
+                new_line();
+            }
+            screen[cursor_row][cursor_col++] = (char)c;
+        }
+    }
+}
+
+static void pump(int master, int ms) {
+    struct timespec start, now;
+    unsigned char buffer[65536];
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int elapsed = (int)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+        if (elapsed >= ms) return;
+
+        struct pollfd pfd = {master, POLLIN, 0};
+        if (poll(&pfd, 1, ms - elapsed) <= 0) continue;
+        ssize_t got = read(master, buffer, sizeof(buffer));
+        if (got <= 0) return;
+        emulate(buffer, (size_t)got);
+    }
+}
+
+// Types one command and returns how many bytes the game answered with
+static size_t play(int master, const char* keys) {
+    size_t before = bytes_seen;
+    if (write(master, keys, strlen(keys)) < 0) perror("write");
+    pump(master, 300);
+    return bytes_seen - before;
+}
+
+static pid_t launch(int* master_out) {
+    struct winsize size = {ROWS, COLS, 0, 0};
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        exit(1);
+    }
+    ioctl(master, TIOCSWINSZ, &size);
+
+    for (int row = 0; row < ROWS; row++) memset(screen[row], ' ', COLS);
+    cursor_row = cursor_col = 0;
+
+    pid_t child = fork();
+    if (child == 0) {
+        setsid();
+        int slave = open(ptsname(master), O_RDWR);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        close(master);
+        execl("./cli-games", "cli-games", (char*)NULL);
+        _exit(127);
+    }
+    *master_out = master;
+    pump(master, 400);
+    return child;
+}
+
+static void finish(pid_t child, int master) {
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    close(master);
+}
+
+// Finds a hidden Minesweeper cell on the emulated screen ("F A1" form)
+static int hidden_cell(char* command, size_t size) {
+    for (int row = 0; row < ROWS; row++) {
+        int number;
+        if (sscanf(screen[row], "%2d |", &number) != 1 || screen[row][3] != '|') continue;
+        for (int col = 0; col < 30; col++) {
+            if (screen[row][4 + col * 2] == '.') {
+                snprintf(command, size, "F %c%d\n", 'A' + col, number);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int check(const char* label, int ok) {
+    printf("  %-44s %s\n", label, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    char dir[] = "/tmp/cli-games-redraw-XXXXXX";
+    static char before[ROWS][COLS + 1];
+    char command[16];
+    int master, failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    setenv("TERM", "xterm", 1);
+
+    // Minesweeper, expert board (30x16)
+    pid_t child = launch(&master);
+    play(master, "13\n");
+    size_t full = play(master, "3\n");
+    size_t reveal = play(master, "R O8\n");
+    int have_hidden = hidden_cell(command, sizeof(command));
+    size_t flag = have_hidden ? play(master, command) : 0;
+    size_t unflag = have_hidden ? play(master, command) : 0;
+    memcpy(before, screen, sizeof(screen));
+
+    play(master, "H\n");                // Help page, then a full repaint
+    play(master, "\n");
+    int mismatched_rows = 0;
+    for (int row = 0; row < ROWS; row++) {
+        if (memcmp(before[row], screen[row], COLS) != 0 &&
+            strstr(before[row], "Time:") == NULL) {
+            mismatched_rows++;
+        }
+    }
+    finish(child, master);
+
+    printf("Minesweeper expert (bytes written)\n");
+    printf("  full frame %zu, first reveal %zu, flag %zu, unflag %zu\n", full, reveal, flag, unflag);
+    failures += check("hidden cell left to flag", have_hidden);
+    failures += check("flag costs under 10% of a full frame", flag > 0 && flag * 10 < full);
+    failures += check("unflag costs under 10% of a full frame", unflag > 0 && unflag * 10 < full);
+    failures += check("incremental screen matches a full repaint", mismatched_rows == 0);
+
+    // 2048: each move touches a few tiles and the score
+    child = launch(&master);
+    play(master, "10\n");
+    full = play(master, "\n");
+    size_t moves = 0, worst = 0;
+    const char* keys[] = {"a\n", "w\n", "d\n", "s\n", "a\n", "w\n"};
+    for (int i = 0; i < 6; i++) {
+        size_t cost = play(master, keys[i]);
+        moves += cost;
+        if (cost > worst) worst = cost;
+    }
+    finish(child, master);
+
+    printf("2048 (bytes written)\n");
+    printf("  full frame %zu, average move %zu, worst move %zu\n", full, moves / 6, worst);
+    failures += check("every move costs under half a full frame", worst > 0 && worst * 2 < full);
+
+    // Tetris: a slide or turn redraws the piece's cells, not the well
+    child = launch(&master);
+    play(master, "25\n");
+    full = play(master, "1\n");
+    moves = 0;
+    worst = 0;
+    const char* tetris_keys[] = {"a", "a", "w", "d", "z", "s"};
+    for (int i = 0; i < 6; i++) {
+        size_t cost = play(master, tetris_keys[i]);
+        moves += cost;
+        if (cost > worst) worst = cost;
+    }
+    finish(child, master);
+
+    printf("Tetris (bytes written)\n");
+    printf("  full frame %zu, average move %zu, worst move %zu\n", full, moves / 6, worst);
+    failures += check("each Tetris move under a fifth of a frame", worst > 0 && worst * 5 < full);
+
+    char cleanup[128];
+    snprintf(cleanup, sizeof(cleanup), "rm -rf %s", dir);
+    if (system(cleanup) != 0) failures++;
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
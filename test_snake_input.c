@@ -0,0 +1,164 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Drives the real cli-games binary through a pseudo-terminal and replays
+// rapid key bursts into Snake: two turns typed inside one tick, arrow-key
+// escape sequences, repeated keys and a reversal. The head position is
+// read back from every rendered frame, and the sequence of directions the
+// snake actually took must contain every accepted turn, in order, one tick
+// apart. Frames must keep coming while no key is pressed.
+
+#define GRID_WIDTH 25
+#define GRID_HEIGHT 20
+#define BURST_GAP_MS 700        // About 3.5 ticks at the starting speed
+
+static char output[4 << 20];
+static size_t output_length = 0;
+
+static void pump(int master, int ms) {
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int elapsed = (int)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+        if (elapsed >= ms) return;
+
+        struct pollfd pfd = {master, POLLIN, 0};
+        if (poll(&pfd, 1, ms - elapsed) <= 0) continue;
+        ssize_t got = read(master, output + output_length, sizeof(output) - 1 - output_length);
+        if (got <= 0) return;
+        output_length += (size_t)got;
+    }
+}
+
+static void send_keys(int master, const char* keys) {
+    if (write(master, keys, strlen(keys)) < 0) perror("write");
+}
+
+// Finds every rendered grid after 'from' and appends its head position
+static int collect_heads(size_t from, int* xs, int* ys, int max) {
+    char border[GRID_WIDTH + 3];
+    int count = 0;
+
+    border[0] = '+';
+    memset(border + 1, '-', GRID_WIDTH);
+    border[GRID_WIDTH + 1] = '+';
+    border[GRID_WIDTH + 2] = '\0';
+
+    output[output_length] = '\0';
+    const char* cursor = output + from;
+    while (count < max && (cursor = strstr(cursor, border)) != NULL) {
+        const char* row = strchr(cursor, '\n');
+        int head_x = -1, head_y = -1, rows = 0;
+        for (; row && rows < GRID_HEIGHT; rows++) {
+            row++;
+            if (*row != '|') break;
+            const char* at = memchr(row, '@', GRID_WIDTH + 1);
+            if (at) {
+                head_x = (int)(at - row) - 1;
+                head_y = rows;
+            }
+            row = strchr(row, '\n');
+        }
+        if (rows == GRID_HEIGHT && head_x >= 0) {
+            xs[count] = head_x;
+            ys[count] = head_y;
+            count++;
+        }
+        cursor += sizeof(border) - 1;
+    }
+    return count;
+}
+
+int main(void) {
+    static const char* bursts[] = {
+        "wa",               // Up then left inside one tick: a U-turn combo
+        "sd",               // Down then right
+        "\033[A\033[D",     // The same as arrow-key escape sequences
+        "wwwd",             // Repeats are dropped, the turn after them is kept
+        "a",                // Reversal while heading right: ignored
+        "sa",
+    };
+    const char* expected = "RULDRULURDL";
+    char dir[] = "/tmp/cli-games-snake-XXXXXX";
+    int failures = 0;
+
+    if (!mkdtemp(dir)) return 1;
+    setenv("CLI_GAMES_SHARED_DIR", dir, 1);
+    setenv("TERM", "xterm", 1);
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        return 1;
+    }
+
+    pid_t child = fork();
+    if (child == 0) {
+        setsid();
+        int slave = open(ptsname(master), O_RDWR);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        close(master);
+        execl("./cli-games", "cli-games", (char*)NULL);
+        _exit(127);
+    }
+
+    pump(master, 400);
+    send_keys(master, "11\n");          // Snake
+    pump(master, 300);
+    send_keys(master, "\n");            // Rules screen
+    size_t game_start = output_length;
+
+    pump(master, BURST_GAP_MS);         // Idle: the snake must keep moving
+    int xs[512], ys[512];
+    int idle_frames = collect_heads(game_start, xs, ys, 512);
+
+    for (size_t i = 0; i < sizeof(bursts) / sizeof(bursts[0]); i++) {
+        send_keys(master, bursts[i]);
+        pump(master, BURST_GAP_MS);
+    }
+    send_keys(master, "q");
+    pump(master, 300);
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    close(master);
+
+    int frames = collect_heads(game_start, xs, ys, 512);
+    char taken[512];
+    int turns = 0, bad_steps = 0;
+    for (int i = 1; i < frames; i++) {
+        int dx = xs[i] - xs[i - 1], dy = ys[i] - ys[i - 1];
+        char step = dx == 1 && dy == 0 ? 'R' : dx == -1 && dy == 0 ? 'L' :
+                    dx == 0 && dy == -1 ? 'U' : dx == 0 && dy == 1 ? 'D' : '?';
+        if (step == '?') {
+            bad_steps++;
+            continue;
+        }
+        if (turns == 0 || taken[turns - 1] != step) taken[turns++] = step;
+    }
+    taken[turns] = '\0';
+
+    printf("Frames while idle: %d\n", idle_frames);
+    printf("Frames rendered:   %d\n", frames);
+    printf("Directions taken:  %s\n", taken);
+    printf("Expected:          %s\n", expected);
+
+    if (idle_frames < 2) failures++;
+    if (bad_steps > 0 || strcmp(taken, expected) != 0) failures++;
+
+    rmdir(dir);
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "games/mine_log.h"
+
+// Replays a Minesweeper click log without a terminal and reports which
+// games check out, with the best verified time and 3BV/s per preset.
+//
+//   ./verify_minesweeper [log]        (default: your log in the shared directory)
+
+// 0-2 for the classic square presets, or -1. Daily boards never count,
+// as in the game.
+static int preset_index(const MineLogGame* game) {
+    if (game->topology != GRID_SQUARE || game->daily) return -1;
+    if (game->width == 9 && game->height == 9 && game->mine_count == 10) return 0;
+    if (game->width == 16 && game->height == 16 && game->mine_count == 40) return 1;
+    if (game->width == 30 && game->height == 16 && game->mine_count == 99) return 2;
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    static const char* names[3] = {"Beginner", "Intermediate", "Expert"};
+    static MineLogVerifier verifier;
+    char path[512];
+    uint32_t best_ms[3] = {0};
+    double best_rate[3] = {0};
+    int records = 0, valid = 0, won = 0;
+
+    if (argc > 1) {
+        snprintf(path, sizeof(path), "%s", argv[1]);
+    } else if (!mine_log_path(path, sizeof(path))) {
+        fprintf(stderr, "usage: %s [log]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "could not open %s\n", path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = malloc(size > 0 ? (size_t)size : 1);
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        fprintf(stderr, "could not read %s\n", path);
+        fclose(file);
+        free(data);
+        return 1;
+    }
+    fclose(file);
+
+    MineLogGame game;
+    size_t at = 0;
+    while (at < (size_t)size) {
+        size_t length = mine_log_verify(&verifier, data + at, (size_t)size - at, &game);
+        if (length == 0) break;
+        at += length;
+        records++;
+        if (!game.valid) {
+            printf("game %d: does not replay to its claimed result\n", records);
+            continue;
+        }
+        valid++;
+        if (!game.won) continue;
+        won++;
+
+        int i = preset_index(&game);
+        if (i >= 0) {
+            double rate = game.elapsed_ms ? game.bv * 1000.0 / game.elapsed_ms : 0;
+            if (best_ms[i] == 0 || game.elapsed_ms < best_ms[i]) best_ms[i] = game.elapsed_ms;
+            if (rate > best_rate[i]) best_rate[i] = rate;
+        }
+    }
+
+    printf("%s: %d games, %d verified, %d won\n", path, records, valid, won);
+    if (at < (size_t)size) printf("the last %zu bytes are not a complete game\n", (size_t)size - at);
+    for (int i = 0; i < 3; i++) {
+        if (best_ms[i] == 0) continue;
+        printf("  %-13s best %02u:%02u.%03u  best 3BV/s %.2f\n", names[i], (unsigned)(best_ms[i] / 60000),
+               (unsigned)(best_ms[i] / 1000 % 60), (unsigned)(best_ms[i] % 1000), best_rate[i]);
+    }
+    free(data);
+    return valid == records ? 0 : 2;
+}